@@ -14,7 +14,14 @@ layout(binding = 0) uniform  UniformBuffer {
 } ubo;
 
 
-struct ImDrawVert   { float x, y, z; float u, v; float nx, ny, nz;  float tx, ty, tz, tw;};
+//Vertex layout of the mesh file, set by IndirectRenderer from the mesh file header (see VertexQuantization.hpp)
+layout(constant_id = 0) const bool lv_packedVertices = false;
+layout(constant_id = 1) const bool lv_halfPositions = false;
+layout(constant_id = 2) const int lv_octahedralBits = 10;
+
+const uint lv_fp32VertexSizeInWords = 12;
+const uint lv_packedVertexSizeInWords = 4;
+
 
 struct DrawData {
 	uint mesh;
@@ -23,26 +30,57 @@ struct DrawData {
 	uint indexOffset;
 	uint vertexOffset;
 	uint transformIndex;
-	uint m_padding2;
-	uint m_padding3;
+	float posOffsetX, posOffsetY, posOffsetZ;
+	float posScaleX, posScaleY, posScaleZ;
+	uint indexSize;
+	uint padding0, padding1, padding2;
 };
 
 
-layout(binding = 1) readonly buffer SBO    { ImDrawVert data[]; } sbo;
+layout(binding = 1) readonly buffer SBO    { uint   data[]; } sbo;
 layout(binding = 2) readonly buffer IBO    { uint   data[]; } ibo;
 layout(binding = 3) readonly buffer DrawBO { DrawData data[]; } drawDataBuffer;
 
 
 
 
+
+//16 bit indices are packed two to a word, the index offset of such a mesh counts 16 bit indices
+uint FetchIndex(DrawData l_dd)
+{
+	uint lv_position = l_dd.indexOffset + gl_VertexIndex;
+
+	if (2 != l_dd.indexSize) {
+		return ibo.data[lv_position];
+	}
+
+	return bitfieldExtract(ibo.data[lv_position >> 1], int(lv_position & 1) * 16, 16);
+}
+
+vec3 FetchPosition(uint l_vertexIndex, DrawData l_dd)
+{
+	if (false == lv_packedVertices) {
+		uint lv_base = l_vertexIndex * lv_fp32VertexSizeInWords;
+		return uintBitsToFloat(uvec3(sbo.data[lv_base], sbo.data[lv_base + 1], sbo.data[lv_base + 2]));
+	}
+
+	uint lv_base = l_vertexIndex * lv_packedVertexSizeInWords;
+	uint lv_word0 = sbo.data[lv_base];
+	uint lv_word1 = sbo.data[lv_base + 1];
+
+	vec3 lv_position = (true == lv_halfPositions)
+		? vec3(unpackHalf2x16(lv_word0), unpackHalf2x16(lv_word1).x)
+		: vec3(unpackSnorm2x16(lv_word0), unpackSnorm2x16(lv_word1).x);
+
+	return vec3(l_dd.posOffsetX, l_dd.posOffsetY, l_dd.posOffsetZ) + vec3(l_dd.posScaleX, l_dd.posScaleY, l_dd.posScaleZ) * lv_position;
+}
+
+
 void main()
 {
 	DrawData dd = drawDataBuffer.data[gl_BaseInstance];
 
-	uint refIdx = dd.indexOffset + gl_VertexIndex;
-	ImDrawVert v = sbo.data[ibo.data[refIdx] + dd.vertexOffset];
-
-	vec4 lv_worldPos = vec4(v.x, v.y, v.z, 1.0);
+	vec4 lv_worldPos = vec4(FetchPosition(FetchIndex(dd) + dd.vertexOffset, dd), 1.0);
 
 	lv_world = lv_worldPos;
 
@@ -73,7 +73,17 @@ uint m_enableDeferred;
 
 layout(binding = 5) readonly buffer MaterialDataBuffer { MaterialData matData[]; } lv_matDataBuffer;
 
-layout(binding = 6) uniform sampler2D lv_textures[256];
+//Bindless heap, the material map indices are heap slots
+layout(set = 1, binding = 0) uniform texture2D lv_bindlessTextures[];
+layout(set = 1, binding = 1) uniform sampler lv_bindlessSamplers[];
+
+layout(push_constant) uniform BindlessIndices { uint m_samplerIndex; } lv_bindlessIndices;
+
+vec4 SampleBindlessTexture(int l_textureIndex, vec2 l_uv)
+{
+	return texture(sampler2D(lv_bindlessTextures[nonuniformEXT(l_textureIndex)],
+		lv_bindlessSamplers[lv_bindlessIndices.m_samplerIndex]), l_uv);
+}
 
 
 
@@ -89,15 +99,15 @@ void main()
 	vec3 lv_normalSample = lv_n;
 
 	if(0 != (lv_matData.m_flags & lv_normalMapIncluded)) {
-		lv_normalSample = texture(lv_textures[nonuniformEXT(lv_matData.m_normalMap)], uvw.xy).xyz;
+		lv_normalSample = SampleBindlessTexture(lv_matData.m_normalMap, uvw.xy).xyz;
 	}
 
 	if(0 != (lv_matData.m_flags & lv_albedoMapIncluded)) {
-		lv_albedo = texture(lv_textures[nonuniformEXT(lv_matData.m_albedoMap)], uvw.xy);
+		lv_albedo = SampleBindlessTexture(lv_matData.m_albedoMap, uvw.xy);
 	}
 
 	if(0 != (lv_matData.m_flags & lv_metallicRoughnessMapIncluded)) {
-		lv_metallic = texture(lv_textures[nonuniformEXT(lv_matData.m_metallicMap)], uvw.xy);
+		lv_metallic = SampleBindlessTexture(lv_matData.m_metallicMap, uvw.xy);
 	}
 
 
@@ -7,7 +7,6 @@ layout(location = 3) out vec4 lv_worldPos;
 layout(location = 4) out vec4 lv_tangent;
 
 
-struct ImDrawVert   { float x, y, z; float u, v; float nx, ny, nz;  float tx, ty, tz, tw;};
 struct DrawData {
 	uint mesh;
 	uint material;
@@ -15,11 +14,21 @@ struct DrawData {
 	uint indexOffset;
 	uint vertexOffset;
 	uint transformIndex;
-	uint m_padding2;
-	uint m_padding3;
+	float posOffsetX, posOffsetY, posOffsetZ;
+	float posScaleX, posScaleY, posScaleZ;
+	uint indexSize;
+	uint padding0, padding1, padding2;
 };
 struct MaterialData { uint tex2D; };
 
+//Vertex layout of the mesh file, set by IndirectRenderer from the mesh file header (see VertexQuantization.hpp)
+layout(constant_id = 0) const bool lv_packedVertices = false;
+layout(constant_id = 1) const bool lv_halfPositions = false;
+layout(constant_id = 2) const int lv_octahedralBits = 10;
+
+const uint lv_fp32VertexSizeInWords = 12;
+const uint lv_packedVertexSizeInWords = 4;
+
 
 layout(binding = 0) uniform  UniformBuffer { 
 
@@ -39,24 +48,87 @@ uint m_enableDeferred;
 
 
 
-layout(binding = 1) readonly buffer SBO    { ImDrawVert data[]; } sbo;
+layout(binding = 1) readonly buffer SBO    { uint   data[]; } sbo;
 layout(binding = 2) readonly buffer IBO    { uint   data[]; } ibo;
 layout(binding = 3) readonly buffer DrawBO { DrawData data[]; } drawDataBuffer;
 layout(binding = 4) readonly buffer Transformations {mat4 ModelMatrices[];} modelTransformations;
 
+
+float DecodeOctahedralComponent(uint l_word, int l_offset)
+{
+	float lv_value = float(bitfieldExtract(int(l_word), l_offset, lv_octahedralBits));
+	return max(lv_value / float((1 << (lv_octahedralBits - 1)) - 1), -1.0);
+}
+
+vec3 DecodeOctahedral(vec2 l_octahedral)
+{
+	vec3 lv_n = vec3(l_octahedral, 1.0 - abs(l_octahedral.x) - abs(l_octahedral.y));
+	float lv_fold = max(-lv_n.z, 0.0);
+
+	lv_n.x += (lv_n.x >= 0.0) ? -lv_fold : lv_fold;
+	lv_n.y += (lv_n.y >= 0.0) ? -lv_fold : lv_fold;
+
+	return normalize(lv_n);
+}
+
+//16 bit indices are packed two to a word, the index offset of such a mesh counts 16 bit indices
+uint FetchIndex(DrawData l_dd)
+{
+	uint lv_position = l_dd.indexOffset + gl_VertexIndex;
+
+	if (2 != l_dd.indexSize) {
+		return ibo.data[lv_position];
+	}
+
+	return bitfieldExtract(ibo.data[lv_position >> 1], int(lv_position & 1) * 16, 16);
+}
+
+vec3 FetchPosition(uint l_vertexIndex, DrawData l_dd)
+{
+	if (false == lv_packedVertices) {
+		uint lv_base = l_vertexIndex * lv_fp32VertexSizeInWords;
+		return uintBitsToFloat(uvec3(sbo.data[lv_base], sbo.data[lv_base + 1], sbo.data[lv_base + 2]));
+	}
+
+	uint lv_base = l_vertexIndex * lv_packedVertexSizeInWords;
+	uint lv_word0 = sbo.data[lv_base];
+	uint lv_word1 = sbo.data[lv_base + 1];
+
+	vec3 lv_position = (true == lv_halfPositions)
+		? vec3(unpackHalf2x16(lv_word0), unpackHalf2x16(lv_word1).x)
+		: vec3(unpackSnorm2x16(lv_word0), unpackSnorm2x16(lv_word1).x);
+
+	return vec3(l_dd.posOffsetX, l_dd.posOffsetY, l_dd.posOffsetZ) + vec3(l_dd.posScaleX, l_dd.posScaleY, l_dd.posScaleZ) * lv_position;
+}
+
 void main()
 {
 	DrawData dd = drawDataBuffer.data[gl_BaseInstance];
 
-	uint refIdx = dd.indexOffset + gl_VertexIndex;
-	ImDrawVert v = sbo.data[ibo.data[refIdx] + dd.vertexOffset];
+	uint lv_vertexIndex = FetchIndex(dd) + dd.vertexOffset;
 
-	uvw = vec3(-v.u, -v.v, 1.f);
-	lv_matIndex = dd.material;
-	lv_worldPos = vec4(v.x, v.y, v.z, 1.0);
+	vec2 lv_uv;
+
+	if (false == lv_packedVertices) {
+		uint lv_base = lv_vertexIndex * lv_fp32VertexSizeInWords;
 
-	lv_normal = vec3(v.nx, v.ny, v.nz);
-	lv_tangent = vec4(v.tx, v.ty, v.tz, v.tw);
+		lv_uv = uintBitsToFloat(uvec2(sbo.data[lv_base + 3], sbo.data[lv_base + 4]));
+		lv_normal = uintBitsToFloat(uvec3(sbo.data[lv_base + 5], sbo.data[lv_base + 6], sbo.data[lv_base + 7]));
+		lv_tangent = uintBitsToFloat(uvec4(sbo.data[lv_base + 8], sbo.data[lv_base + 9], sbo.data[lv_base + 10], sbo.data[lv_base + 11]));
+	}
+	else {
+		uint lv_base = lv_vertexIndex * lv_packedVertexSizeInWords;
+		uint lv_word1 = sbo.data[lv_base + 1];
+		uint lv_word3 = sbo.data[lv_base + 3];
+
+		lv_uv = unpackHalf2x16(sbo.data[lv_base + 2]);
+		lv_normal = DecodeOctahedral(vec2(DecodeOctahedralComponent(lv_word3, 0), DecodeOctahedralComponent(lv_word3, 10)));
+		lv_tangent = vec4(DecodeOctahedral(vec2(DecodeOctahedralComponent(lv_word3, 20), DecodeOctahedralComponent(lv_word1, 16))), 1.0);
+	}
+
+	uvw = vec3(-lv_uv.x, -lv_uv.y, 1.f);
+	lv_matIndex = dd.material;
+	lv_worldPos = vec4(FetchPosition(lv_vertexIndex, dd), 1.0);
 
 //	mat4 xfrm(1.0); // = transpose(drawDataBuffer.data[gl_BaseInstance].xfrm);
 
@@ -0,0 +1,195 @@
+#include "TestFramework.hpp"
+#include "ConcurrentSlotArray.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+namespace Tests
+{
+
+	namespace
+	{
+		//Small chunks, so the threads keep racing to publish new ones
+		using SlotArray = RenderCore::ConcurrentSlotArray<uint64_t, 4, 4096>;
+
+		constexpr uint32_t lv_totalNumThreads = 8;
+		constexpr uint32_t lv_totalNumPushesPerThread = 4096;
+
+
+		uint64_t ValueOf(uint32_t l_threadIndex, uint32_t l_pushIndex)
+		{
+			return ((uint64_t)l_threadIndex << 32) | l_pushIndex;
+		}
+
+
+		template<typename t_function>
+		void RunOnThreads(uint32_t l_totalNumThreads, const t_function& l_function)
+		{
+			std::vector<std::thread> lv_workers{};
+			lv_workers.reserve(l_totalNumThreads);
+
+			for (uint32_t i = 0; i < l_totalNumThreads; ++i) {
+				lv_workers.emplace_back(l_function, i);
+			}
+
+			for (auto& l_worker : lv_workers) {
+				l_worker.join();
+			}
+		}
+
+
+		void PushFromThreads(SlotArray& l_slotArray, std::vector<std::vector<SlotArray::Slot>>& l_slots)
+		{
+			l_slots.assign(lv_totalNumThreads, std::vector<SlotArray::Slot>(lv_totalNumPushesPerThread));
+
+			RunOnThreads(lv_totalNumThreads, [&l_slotArray, &l_slots](uint32_t l_threadIndex)
+				{
+					for (uint32_t i = 0; i < lv_totalNumPushesPerThread; ++i) {
+						l_slots[l_threadIndex][i] = l_slotArray.Push(ValueOf(l_threadIndex, i));
+					}
+				});
+		}
+
+
+		void TestConcurrentPush()
+		{
+			SlotArray lv_slotArray{};
+			std::vector<std::vector<SlotArray::Slot>> lv_slots{};
+
+			PushFromThreads(lv_slotArray, lv_slots);
+
+			TEST_CHECK(lv_totalNumThreads * lv_totalNumPushesPerThread == lv_slotArray.GetSize());
+
+			//Every push got its own slot and kept its value
+			std::vector<bool> lv_usedIndices(lv_slotArray.GetSize(), false);
+			uint32_t lv_totalNumDuplicates{ 0 };
+			uint32_t lv_totalNumWrongValues{ 0 };
+			uint32_t lv_totalNumInvalidSlots{ 0 };
+
+			for (uint32_t i = 0; i < lv_totalNumThreads; ++i) {
+				for (uint32_t j = 0; j < lv_totalNumPushesPerThread; ++j) {
+
+					const auto lv_slot = lv_slots[i][j];
+
+					if (lv_slot.m_index >= lv_usedIndices.size() || true == lv_usedIndices[lv_slot.m_index]) {
+						++lv_totalNumDuplicates;
+						continue;
+					}
+
+					lv_usedIndices[lv_slot.m_index] = true;
+					lv_totalNumWrongValues += (ValueOf(i, j) != lv_slotArray[lv_slot.m_index]) ? 1 : 0;
+					lv_totalNumInvalidSlots += (false == lv_slotArray.IsValid(lv_slot.m_index, lv_slot.m_generation)) ? 1 : 0;
+				}
+			}
+
+			TEST_CHECK(0 == lv_totalNumDuplicates);
+			TEST_CHECK(0 == lv_totalNumWrongValues);
+			TEST_CHECK(0 == lv_totalNumInvalidSlots);
+
+			//A default constructed handle never points at a live slot
+			TEST_CHECK(false == lv_slotArray.IsValid(lv_slots[0][0].m_index, 0));
+		}
+
+
+		void TestConcurrentReleaseAndReuse()
+		{
+			SlotArray lv_slotArray{};
+			std::vector<std::vector<SlotArray::Slot>> lv_slots{};
+
+			PushFromThreads(lv_slotArray, lv_slots);
+
+			//The first half of the threads release and refill their slots, the second half keep validating theirs
+			//and the released ones at the same time, the way RetrieveGpuBuffer() does during loading
+			constexpr uint32_t lv_totalNumWriterThreads = lv_totalNumThreads / 2;
+
+			std::vector<std::vector<SlotArray::Slot>> lv_newSlots(lv_totalNumWriterThreads,
+				std::vector<SlotArray::Slot>(lv_totalNumPushesPerThread));
+			std::atomic<uint32_t> lv_totalNumLostSlots{ 0 };
+			std::atomic<uint32_t> lv_totalNumRevivedSlots{ 0 };
+
+			RunOnThreads(lv_totalNumThreads, [&lv_slotArray, &lv_slots, &lv_newSlots, &lv_totalNumLostSlots,
+				&lv_totalNumRevivedSlots](uint32_t l_threadIndex)
+				{
+					if (l_threadIndex < lv_totalNumWriterThreads) {
+
+						for (const auto& l_slot : lv_slots[l_threadIndex]) {
+							lv_slotArray.Release(l_slot.m_index);
+						}
+
+						for (uint32_t i = 0; i < lv_totalNumPushesPerThread; ++i) {
+							lv_newSlots[l_threadIndex][i] = lv_slotArray.Push(ValueOf(l_threadIndex + lv_totalNumThreads, i));
+						}
+
+						return;
+					}
+
+					const auto& lv_releasedSlots = lv_slots[l_threadIndex - lv_totalNumWriterThreads];
+
+					for (uint32_t i = 0; i < lv_totalNumPushesPerThread; ++i) {
+
+						const auto lv_slot = lv_slots[l_threadIndex][i];
+
+						if (false == lv_slotArray.IsValid(lv_slot.m_index, lv_slot.m_generation)) {
+							++lv_totalNumLostSlots;
+						}
+
+						//Either outcome is fine while the writer is busy, but generations only grow,
+						//so a handle that went stale never becomes valid again
+						const auto lv_releasedSlot = lv_releasedSlots[i];
+						const bool lv_validBefore = lv_slotArray.IsValid(lv_releasedSlot.m_index, lv_releasedSlot.m_generation);
+						const bool lv_validAfter = lv_slotArray.IsValid(lv_releasedSlot.m_index, lv_releasedSlot.m_generation);
+
+						if (false == lv_validBefore && true == lv_validAfter) {
+							++lv_totalNumRevivedSlots;
+						}
+					}
+				});
+
+			TEST_CHECK(0 == lv_totalNumLostSlots.load());
+			TEST_CHECK(0 == lv_totalNumRevivedSlots.load());
+
+			//Every push found a released slot, so nothing new was claimed
+			TEST_CHECK(lv_totalNumThreads * lv_totalNumPushesPerThread == lv_slotArray.GetSize());
+
+			uint32_t lv_totalNumStaleHandles{ 0 };
+			uint32_t lv_totalNumWrongValues{ 0 };
+			std::vector<bool> lv_usedIndices(lv_slotArray.GetSize(), false);
+			uint32_t lv_totalNumDuplicates{ 0 };
+
+			for (uint32_t i = 0; i < lv_totalNumWriterThreads; ++i) {
+				for (uint32_t j = 0; j < lv_totalNumPushesPerThread; ++j) {
+
+					const auto lv_oldSlot = lv_slots[i][j];
+					lv_totalNumStaleHandles += (true == lv_slotArray.IsValid(lv_oldSlot.m_index, lv_oldSlot.m_generation)) ? 1 : 0;
+
+					const auto lv_newSlot = lv_newSlots[i][j];
+					lv_totalNumWrongValues += (ValueOf(i + lv_totalNumThreads, j) != lv_slotArray[lv_newSlot.m_index]) ? 1 : 0;
+					lv_totalNumStaleHandles += (false == lv_slotArray.IsValid(lv_newSlot.m_index, lv_newSlot.m_generation)) ? 1 : 0;
+
+					lv_totalNumDuplicates += (true == lv_usedIndices[lv_newSlot.m_index]) ? 1 : 0;
+					lv_usedIndices[lv_newSlot.m_index] = true;
+				}
+			}
+
+			for (uint32_t i = lv_totalNumWriterThreads; i < lv_totalNumThreads; ++i) {
+				for (const auto& l_slot : lv_slots[i]) {
+					lv_totalNumDuplicates += (true == lv_usedIndices[l_slot.m_index]) ? 1 : 0;
+					lv_usedIndices[l_slot.m_index] = true;
+				}
+			}
+
+			TEST_CHECK(0 == lv_totalNumStaleHandles);
+			TEST_CHECK(0 == lv_totalNumWrongValues);
+			TEST_CHECK(0 == lv_totalNumDuplicates);
+		}
+	}
+
+
+	void RunConcurrentSlotArrayTests()
+	{
+		TestConcurrentPush();
+		TestConcurrentReleaseAndReuse();
+	}
+
+}
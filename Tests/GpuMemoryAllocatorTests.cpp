@@ -0,0 +1,237 @@
+#include "TestFramework.hpp"
+#include "GpuMemoryAllocator.hpp"
+#include <array>
+#include <vector>
+
+
+namespace Tests
+{
+
+	namespace
+	{
+		using RenderCore::TlsfRangeAllocator;
+		using RenderCore::TlsfDrainCandidate;
+		using RenderCore::TlsfDrainPlacement;
+
+		constexpr VkDeviceSize lv_granule = TlsfRangeAllocator::m_granuleInBytes;
+
+
+		void TestAllocate()
+		{
+			TlsfRangeAllocator lv_ranges{ 256 * lv_granule };
+
+			VkDeviceSize lv_offset{};
+			uint32_t lv_rangeHandle{};
+
+			//Sizes are rounded up to whole granules
+			TEST_CHECK(true == lv_ranges.Allocate(1000, 1, lv_offset, lv_rangeHandle));
+			TEST_CHECK(0 == lv_offset);
+			TEST_CHECK(4 * lv_granule == lv_ranges.GetUsedBytes());
+
+			TEST_CHECK(true == lv_ranges.Allocate(lv_granule, 16 * lv_granule, lv_offset, lv_rangeHandle));
+			TEST_CHECK(16 * lv_granule == lv_offset);
+			TEST_CHECK(5 * lv_granule == lv_ranges.GetUsedBytes());
+			TEST_CHECK(2 == lv_ranges.GetTotalNumAllocations());
+
+			TEST_CHECK(false == lv_ranges.Allocate(lv_ranges.GetCapacity(), 1, lv_offset, lv_rangeHandle));
+
+			//The padding in front of the aligned range went back to the free lists, so every granule is still usable
+			std::vector<bool> lv_usedGranules(256, false);
+			lv_usedGranules[0] = lv_usedGranules[1] = lv_usedGranules[2] = lv_usedGranules[3] = lv_usedGranules[16] = true;
+
+			bool lv_overlaps{ false };
+			uint32_t lv_totalNumFillAllocations{ 0 };
+
+			while (true == lv_ranges.Allocate(lv_granule, 1, lv_offset, lv_rangeHandle)) {
+				lv_overlaps = lv_overlaps || lv_usedGranules[lv_offset / lv_granule];
+				lv_usedGranules[lv_offset / lv_granule] = true;
+				++lv_totalNumFillAllocations;
+			}
+
+			TEST_CHECK(false == lv_overlaps);
+			TEST_CHECK(251 == lv_totalNumFillAllocations);
+			TEST_CHECK(lv_ranges.GetCapacity() == lv_ranges.GetUsedBytes());
+			TEST_CHECK(0 == lv_ranges.GetLargestFreeRange());
+		}
+
+
+		void TestFreeAndCoalescing()
+		{
+			TlsfRangeAllocator lv_ranges{ 16 * lv_granule };
+
+			std::array<VkDeviceSize, 4> lv_offsets{};
+			std::array<uint32_t, 4> lv_rangeHandles{};
+
+			for (uint32_t i = 0; i < 4; ++i) {
+				TEST_CHECK(true == lv_ranges.Allocate(4 * lv_granule, 1, lv_offsets[i], lv_rangeHandles[i]));
+				TEST_CHECK(i * 4 * lv_granule == lv_offsets[i]);
+			}
+
+			VkDeviceSize lv_offset{};
+			uint32_t lv_rangeHandle{};
+
+			TEST_CHECK(false == lv_ranges.Allocate(lv_granule, 1, lv_offset, lv_rangeHandle));
+
+			//Two free ranges that are not neighbours stay apart
+			lv_ranges.Free(lv_rangeHandles[1]);
+			lv_ranges.Free(lv_rangeHandles[3]);
+
+			TEST_CHECK(4 * lv_granule == lv_ranges.GetLargestFreeRange());
+			TEST_CHECK(false == lv_ranges.Allocate(8 * lv_granule, 1, lv_offset, lv_rangeHandle));
+
+			//Freeing the range between them merges all three
+			lv_ranges.Free(lv_rangeHandles[2]);
+
+			TEST_CHECK(12 * lv_granule == lv_ranges.GetLargestFreeRange());
+			TEST_CHECK(true == lv_ranges.Allocate(12 * lv_granule, 1, lv_offset, lv_rangeHandle));
+			TEST_CHECK(4 * lv_granule == lv_offset);
+
+			lv_ranges.Free(lv_rangeHandle);
+			lv_ranges.Free(lv_rangeHandles[0]);
+
+			TEST_CHECK(true == lv_ranges.IsEmpty());
+			TEST_CHECK(0 == lv_ranges.GetUsedBytes());
+			TEST_CHECK(lv_ranges.GetCapacity() == lv_ranges.GetLargestFreeRange());
+			TEST_CHECK(true == lv_ranges.Allocate(lv_ranges.GetCapacity(), 1, lv_offset, lv_rangeHandle));
+			TEST_CHECK(0 == lv_offset);
+		}
+
+
+		void TestAllocateAt()
+		{
+			TlsfRangeAllocator lv_ranges{ 64 * lv_granule };
+
+			std::array<uint32_t, 3> lv_rangeHandles{};
+
+			//Packing a nearly full allocator back to back, the way the geometry heap compaction does
+			TEST_CHECK(true == lv_ranges.AllocateAt(0, 20 * lv_granule, lv_rangeHandles[0]));
+			TEST_CHECK(true == lv_ranges.AllocateAt(20 * lv_granule, 40 * lv_granule - 100, lv_rangeHandles[1]));
+
+			//Allocate() over-asks by the alignment and rounds up to a size class, so the last 4 granules stay out of its reach
+			VkDeviceSize lv_offset{};
+			uint32_t lv_rangeHandle{};
+			TEST_CHECK(false == lv_ranges.Allocate(4 * lv_granule, 4 * lv_granule, lv_offset, lv_rangeHandle));
+			TEST_CHECK(true == lv_ranges.AllocateAt(60 * lv_granule, 4 * lv_granule, lv_rangeHandles[2]));
+
+			TEST_CHECK(lv_ranges.GetCapacity() == lv_ranges.GetUsedBytes());
+			TEST_CHECK(3 == lv_ranges.GetTotalNumAllocations());
+
+			//Used, partially used, unaligned and out of bounds placements are refused
+			lv_ranges.Free(lv_rangeHandles[1]);
+
+			TEST_CHECK(false == lv_ranges.AllocateAt(0, lv_granule, lv_rangeHandle));
+			TEST_CHECK(false == lv_ranges.AllocateAt(50 * lv_granule, 11 * lv_granule, lv_rangeHandle));
+			TEST_CHECK(false == lv_ranges.AllocateAt(30 * lv_granule + 1, lv_granule, lv_rangeHandle));
+			TEST_CHECK(false == lv_ranges.AllocateAt(64 * lv_granule, lv_granule, lv_rangeHandle));
+
+			//A placement in the middle of a free range leaves both sides usable
+			TEST_CHECK(true == lv_ranges.AllocateAt(30 * lv_granule, 10 * lv_granule, lv_rangeHandle));
+			TEST_CHECK(20 * lv_granule == lv_ranges.GetLargestFreeRange());
+			TEST_CHECK(true == lv_ranges.AllocateAt(20 * lv_granule, 10 * lv_granule, lv_rangeHandles[1]));
+			TEST_CHECK(true == lv_ranges.AllocateAt(40 * lv_granule, 20 * lv_granule, lv_rangeHandles[0]));
+			TEST_CHECK(lv_ranges.GetCapacity() == lv_ranges.GetUsedBytes());
+
+			//Freed placements coalesce like any other range
+			lv_ranges.Free(lv_rangeHandles[1]);
+			lv_ranges.Free(lv_rangeHandle);
+			TEST_CHECK(20 * lv_granule == lv_ranges.GetLargestFreeRange());
+			TEST_CHECK(true == lv_ranges.AllocateAt(20 * lv_granule, 20 * lv_granule, lv_rangeHandle));
+		}
+
+
+		void TestDefragmentationPlanning()
+		{
+			std::array<TlsfRangeAllocator, 2> lv_blocks{ TlsfRangeAllocator{ 16 * lv_granule }, TlsfRangeAllocator{ 16 * lv_granule } };
+			const std::array<TlsfRangeAllocator*, 2> lv_blockPointers{ &lv_blocks[0], &lv_blocks[1] };
+
+			const std::array<TlsfDrainCandidate, 5> lv_candidates{ {
+				{ .m_blockIndex = 0, .m_sizeInBytes = 4 * lv_granule, .m_alignment = 1 },
+				{ .m_blockIndex = 0, .m_sizeInBytes = 4 * lv_granule, .m_alignment = 1 },
+				{ .m_blockIndex = 0, .m_sizeInBytes = 4 * lv_granule, .m_alignment = 1 },
+				{ .m_blockIndex = 1, .m_sizeInBytes = 2 * lv_granule, .m_alignment = 1 },
+				{ .m_blockIndex = 1, .m_sizeInBytes = lv_granule, .m_alignment = 1 }
+			} };
+
+			std::array<uint32_t, 5> lv_rangeHandles{};
+
+			for (uint32_t i = 0; i < (uint32_t)lv_candidates.size(); ++i) {
+				VkDeviceSize lv_offset{};
+				TEST_CHECK(true == lv_blocks[lv_candidates[i].m_blockIndex].Allocate(lv_candidates[i].m_sizeInBytes,
+					lv_candidates[i].m_alignment, lv_offset, lv_rangeHandles[i]));
+			}
+
+			//Block 1 is the least occupied one, both of its ranges fit into the last quarter of block 0
+			const auto lv_placements = RenderCore::PlanBlockDrain(lv_blockPointers, lv_candidates);
+
+			TEST_CHECK(2 == lv_placements.size());
+
+			if (2 == lv_placements.size()) {
+				TEST_CHECK(3 == lv_placements[0].m_candidateIndex);
+				TEST_CHECK(0 == lv_placements[0].m_blockIndex);
+				TEST_CHECK(12 * lv_granule == lv_placements[0].m_offset);
+				TEST_CHECK(4 == lv_placements[1].m_candidateIndex);
+				TEST_CHECK(0 == lv_placements[1].m_blockIndex);
+				TEST_CHECK(14 * lv_granule == lv_placements[1].m_offset);
+			}
+
+			//The destinations are reserved by the plan, the caller frees the sources once the data is copied
+			TEST_CHECK(5 == lv_blocks[0].GetTotalNumAllocations());
+			TEST_CHECK(15 * lv_granule == lv_blocks[0].GetUsedBytes());
+
+			lv_blocks[1].Free(lv_rangeHandles[3]);
+			lv_blocks[1].Free(lv_rangeHandles[4]);
+			TEST_CHECK(true == lv_blocks[1].IsEmpty());
+		}
+
+
+		void TestDefragmentationPlanningLimits()
+		{
+			std::array<TlsfRangeAllocator, 2> lv_blocks{ TlsfRangeAllocator{ 16 * lv_granule }, TlsfRangeAllocator{ 16 * lv_granule } };
+
+			VkDeviceSize lv_offset{};
+			uint32_t lv_rangeHandle{};
+
+			TEST_CHECK(true == lv_blocks[0].Allocate(12 * lv_granule, 1, lv_offset, lv_rangeHandle));
+			TEST_CHECK(true == lv_blocks[1].Allocate(2 * lv_granule, 1, lv_offset, lv_rangeHandle));
+			TEST_CHECK(true == lv_blocks[1].Allocate(2 * lv_granule, 8 * lv_granule, lv_offset, lv_rangeHandle));
+
+			//A released block is neither a source nor a destination, one live block leaves nothing to drain into
+			const std::array<TlsfRangeAllocator*, 2> lv_oneLiveBlock{ &lv_blocks[0], nullptr };
+			const std::array<TlsfDrainCandidate, 1> lv_blockZeroCandidate{ {
+				{ .m_blockIndex = 0, .m_sizeInBytes = 12 * lv_granule, .m_alignment = 1 } } };
+
+			TEST_CHECK(true == RenderCore::PlanBlockDrain(lv_oneLiveBlock, lv_blockZeroCandidate).empty());
+			TEST_CHECK(1 == lv_blocks[0].GetTotalNumAllocations());
+
+			//Block 0 has room for 4 granules at offsets 12 to 15, the second candidate needs an 8 granule alignment
+			//it cannot get there, so only the first one moves and the other stays in block 1
+			const std::array<TlsfRangeAllocator*, 2> lv_blockPointers{ &lv_blocks[0], &lv_blocks[1] };
+			const std::array<TlsfDrainCandidate, 2> lv_candidates{ {
+				{ .m_blockIndex = 1, .m_sizeInBytes = 2 * lv_granule, .m_alignment = 1 },
+				{ .m_blockIndex = 1, .m_sizeInBytes = 2 * lv_granule, .m_alignment = 8 * lv_granule }
+			} };
+
+			const auto lv_placements = RenderCore::PlanBlockDrain(lv_blockPointers, lv_candidates);
+
+			TEST_CHECK(1 == lv_placements.size());
+
+			if (1 == lv_placements.size()) {
+				TEST_CHECK(0 == lv_placements[0].m_candidateIndex);
+				TEST_CHECK(12 * lv_granule == lv_placements[0].m_offset);
+			}
+
+			TEST_CHECK(14 * lv_granule == lv_blocks[0].GetUsedBytes());
+		}
+	}
+
+
+	void RunGpuMemoryAllocatorTests()
+	{
+		TestAllocate();
+		TestFreeAndCoalescing();
+		TestAllocateAt();
+		TestDefragmentationPlanning();
+		TestDefragmentationPlanningLimits();
+	}
+
+}
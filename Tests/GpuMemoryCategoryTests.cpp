@@ -0,0 +1,292 @@
+#include "TestFramework.hpp"
+#include "TestVulkanDevice.hpp"
+#include "FrameGraphResourceParsing.hpp"
+#include "VulkanResourceManager.hpp"
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
+
+
+namespace Tests
+{
+
+	namespace
+	{
+		using RenderCore::GpuMemoryCategory;
+		using RenderCore::GpuMemoryCategoryStats;
+		using RenderCore::GpuMemoryCategoryTracker;
+		using VulkanEngine::FrameGraphResourceInfo;
+
+		constexpr uint32_t lv_totalNumSwapchainImages = 3;
+		constexpr size_t lv_totalNumCategories = (size_t)GpuMemoryCategory::m_count;
+
+
+		//A texture the frame graph creates once per swapchain image
+		struct FrameGraphTexture
+		{
+			std::string m_name;
+			FrameGraphResourceInfo m_info;
+		};
+
+
+		//RendererTests runs from Tests/ inside Visual Studio and from the repository root otherwise
+		bool ParseFrameGraphJson(rapidjson::Document& l_document)
+		{
+			for (const char* l_path : { "../InitFiles/JSON Files/frameGraph.json", "InitFiles/JSON Files/frameGraph.json" }) {
+
+				std::ifstream lv_graphJSONFile(l_path);
+
+				if (true == lv_graphJSONFile.is_open()) {
+					rapidjson::IStreamWrapper lv_isw(lv_graphJSONFile);
+					return false == l_document.ParseStream(lv_isw).IsError();
+				}
+			}
+
+			return false;
+		}
+
+
+		//Same selection as FrameGraph::CreateRenderpassAndFramebuffers: the inputs of the graphic passes that do not
+		//render to a cubemap, are created on the GPU and are not the depth attachment become color textures
+		std::vector<FrameGraphTexture> CollectFrameGraphTextures(const rapidjson::Document& l_document)
+		{
+			std::vector<FrameGraphTexture> lv_textures{};
+
+			for (const auto& l_renderPass : l_document["RenderPasses"].GetArray()) {
+
+				if (0 != strcmp(l_renderPass["Pipeline"].GetString(), "GRAPHIC") ||
+					0 != strcmp(l_renderPass["RenderToCubemap"].GetString(), "FALSE")) {
+					continue;
+				}
+
+				for (const auto& l_input : l_renderPass["Input"].GetArray()) {
+
+					FrameGraphTexture lv_texture{ .m_name = l_input["Name"].GetString(),
+						.m_info = VulkanEngine::ParseFrameGraphInputInfo(l_input) };
+
+					if (true == lv_texture.m_info.m_createOnGPU && false == VulkanEngine::IsFrameGraphDepthResource(lv_texture.m_name)) {
+						lv_textures.push_back(lv_texture);
+					}
+				}
+			}
+
+			return lv_textures;
+		}
+
+
+		//Size of an image with the VkImageCreateInfo that CreateTexture hands to CreateSubAllocatedImage,
+		//which is what the tracker is charged with, padding and mip chain included
+		VkDeviceSize QueryTextureSize(VkDevice l_device, const FrameGraphResourceInfo& l_info)
+		{
+			const VkImageCreateInfo lv_imageCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+				.pNext = nullptr,
+				.flags = 0,
+				.imageType = VK_IMAGE_TYPE_2D,
+				.format = l_info.m_format,
+				.extent = VkExtent3D {.width = VulkanEngine::lv_frameGraphTextureExtent,
+					.height = VulkanEngine::lv_frameGraphTextureExtent, .depth = 1 },
+				.mipLevels = l_info.m_mipLevels,
+				.arrayLayers = 1,
+				.samples = VK_SAMPLE_COUNT_1_BIT,
+				.tiling = VK_IMAGE_TILING_OPTIMAL,
+				.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+					| VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT,
+				.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+				.queueFamilyIndexCount = 0,
+				.pQueueFamilyIndices = nullptr,
+				.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+			};
+
+			VkImage lv_image{ VK_NULL_HANDLE };
+
+			if (VK_SUCCESS != vkCreateImage(l_device, &lv_imageCreateInfo, nullptr, &lv_image)) {
+				return 0;
+			}
+
+			VkMemoryRequirements lv_memoryRequirements{};
+			vkGetImageMemoryRequirements(l_device, lv_image, &lv_memoryRequirements);
+			vkDestroyImage(l_device, lv_image, nullptr);
+
+			return lv_memoryRequirements.size;
+		}
+
+
+		void TestStringToCategory()
+		{
+			TEST_CHECK(GpuMemoryCategory::m_gbuffer == RenderCore::StringToGpuMemoryCategory("GBUFFER"));
+			TEST_CHECK(GpuMemoryCategory::m_bloom == RenderCore::StringToGpuMemoryCategory("BLOOM"));
+			TEST_CHECK(GpuMemoryCategory::m_shadows == RenderCore::StringToGpuMemoryCategory("SHADOWS"));
+			TEST_CHECK(GpuMemoryCategory::m_textures == RenderCore::StringToGpuMemoryCategory("TEXTURES"));
+			TEST_CHECK(GpuMemoryCategory::m_other == RenderCore::StringToGpuMemoryCategory("OTHER"));
+
+			//Unknown names fall back to render targets instead of failing the frame graph load
+			TEST_CHECK(GpuMemoryCategory::m_renderTargets == RenderCore::StringToGpuMemoryCategory("gbuffer"));
+			TEST_CHECK(GpuMemoryCategory::m_renderTargets == RenderCore::StringToGpuMemoryCategory(""));
+		}
+
+
+		void TestFrameGraphTextureInfos()
+		{
+			rapidjson::Document lv_document{};
+			TEST_CHECK(true == ParseFrameGraphJson(lv_document));
+
+			if (false == lv_document.IsObject()) {
+				return;
+			}
+
+			const auto lv_textures = CollectFrameGraphTextures(lv_document);
+			TEST_CHECK(false == lv_textures.empty());
+
+			uint32_t lv_totalNumBloomTextures{ 0 };
+
+			for (const auto& l_texture : lv_textures) {
+
+				//A format the parser does not know would make CreateTexture fail
+				TEST_CHECK(VK_FORMAT_UNDEFINED != l_texture.m_info.m_format);
+
+				if ("DeferredLightningColorTexture" == l_texture.m_name) {
+					++lv_totalNumBloomTextures;
+
+					TEST_CHECK(6 == l_texture.m_info.m_mipLevels);
+					TEST_CHECK(GpuMemoryCategory::m_bloom == l_texture.m_info.m_memoryCategory);
+					TEST_CHECK(VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE == l_texture.m_info.m_addressMode);
+					TEST_CHECK(VK_FORMAT_R16G16B16A16_SFLOAT == l_texture.m_info.m_format);
+				}
+
+				if (0 == l_texture.m_name.compare(0, 7, "GBuffer")) {
+					TEST_CHECK(GpuMemoryCategory::m_gbuffer == l_texture.m_info.m_memoryCategory);
+					TEST_CHECK(1 == l_texture.m_info.m_mipLevels);
+				}
+			}
+
+			TEST_CHECK(1 == lv_totalNumBloomTextures);
+		}
+
+
+		//Creates the textures of frameGraph.json through VulkanResourceManager the way the frame graph does and checks
+		//that every category grew by the memory requirements of its images
+		void TestFrameGraphBreakdown()
+		{
+			rapidjson::Document lv_document{};
+
+			if (false == ParseFrameGraphJson(lv_document)) {
+				return;
+			}
+
+			const auto lv_textures = CollectFrameGraphTextures(lv_document);
+
+			TestVulkanDevice lv_testDevice{};
+
+			if (false == CreateTestVulkanDevice(lv_testDevice, lv_totalNumSwapchainImages)) {
+				return;
+			}
+
+			{
+				const std::string lv_pipelineCacheFilePath{
+					(std::filesystem::temp_directory_path() / "RendererTestsPipelineCache.bin").string() };
+
+				RenderCore::VulkanResourceManager lv_resourceManager{ lv_testDevice.m_vkDev, 4U * 1024U * 1024U,
+					lv_pipelineCacheFilePath, 64U * 1024U, 1024U * 1024U, 1024U * 1024U };
+
+				//The depth textures and the point light cubemap are created with the resource manager
+				std::array<GpuMemoryCategoryStats, lv_totalNumCategories> lv_statsBefore{};
+				for (size_t i = 0; i < lv_totalNumCategories; ++i) {
+					lv_statsBefore[i] = lv_resourceManager.GetMemoryCategoryStats((GpuMemoryCategory)i);
+				}
+
+				std::array<GpuMemoryCategoryStats, lv_totalNumCategories> lv_expectedStats{};
+				VkDeviceSize lv_bloomTextureSize{ 0 };
+
+				for (uint32_t i = 0; i < lv_totalNumSwapchainImages; ++i) {
+					for (const auto& l_texture : lv_textures) {
+
+						const std::string lv_textureName{ l_texture.m_name + " " + std::to_string(i) };
+
+						lv_resourceManager.CreateTexture(lv_testDevice.m_vkDev.m_maxAnisotropy, lv_textureName.c_str(),
+							l_texture.m_info.m_format, VulkanEngine::lv_frameGraphTextureExtent, VulkanEngine::lv_frameGraphTextureExtent,
+							l_texture.m_info.m_mipLevels, VK_FILTER_LINEAR, VK_FILTER_LINEAR, l_texture.m_info.m_addressMode,
+							l_texture.m_info.m_memoryCategory);
+
+						const VkDeviceSize lv_textureSize = QueryTextureSize(lv_testDevice.m_vkDev.m_device, l_texture.m_info);
+						auto& lv_expected = lv_expectedStats[(size_t)l_texture.m_info.m_memoryCategory];
+
+						++lv_expected.m_totalNumAllocations;
+						lv_expected.m_totalBytes += lv_textureSize;
+
+						if (GpuMemoryCategory::m_bloom == l_texture.m_info.m_memoryCategory) {
+							lv_bloomTextureSize = lv_textureSize;
+						}
+					}
+				}
+
+				for (size_t i = 0; i < lv_totalNumCategories; ++i) {
+					const auto lv_statsAfter = lv_resourceManager.GetMemoryCategoryStats((GpuMemoryCategory)i);
+
+					TEST_CHECK(lv_expectedStats[i].m_totalNumAllocations ==
+						lv_statsAfter.m_totalNumAllocations - lv_statsBefore[i].m_totalNumAllocations);
+					TEST_CHECK(lv_expectedStats[i].m_totalBytes == lv_statsAfter.m_totalBytes - lv_statsBefore[i].m_totalBytes);
+				}
+
+				//The mip chain of the bloom texture is charged on top of its first level
+				constexpr VkDeviceSize lv_rgba16FirstLevelSize =
+					8ULL * VulkanEngine::lv_frameGraphTextureExtent * VulkanEngine::lv_frameGraphTextureExtent;
+				TEST_CHECK(lv_rgba16FirstLevelSize < lv_bloomTextureSize);
+				TEST_CHECK(0 < lv_expectedStats[(size_t)GpuMemoryCategory::m_gbuffer].m_totalNumAllocations);
+				TEST_CHECK(0 < lv_expectedStats[(size_t)GpuMemoryCategory::m_renderTargets].m_totalNumAllocations);
+			}
+
+			DestroyTestVulkanDevice(lv_testDevice);
+		}
+
+
+		void TestReleaseKeepsPeak()
+		{
+			constexpr VkDeviceSize lv_bloomTextureSize = 16ULL * 1024ULL * 1024ULL;
+			constexpr VkDeviceSize lv_gbufferTextureSize = 8ULL * 1024ULL * 1024ULL;
+
+			GpuMemoryCategoryTracker lv_tracker{};
+
+			for (uint32_t i = 0; i < lv_totalNumSwapchainImages; ++i) {
+				lv_tracker.Track(GpuMemoryCategory::m_bloom, lv_bloomTextureSize);
+				lv_tracker.Track(GpuMemoryCategory::m_gbuffer, lv_gbufferTextureSize);
+			}
+
+			const VkDeviceSize lv_bloomBytes = lv_tracker.GetStats(GpuMemoryCategory::m_bloom).m_totalBytes;
+			const VkDeviceSize lv_totalBytes = lv_tracker.GetTotalBytes();
+
+			TEST_CHECK(lv_totalNumSwapchainImages * lv_bloomTextureSize == lv_bloomBytes);
+			TEST_CHECK(lv_totalNumSwapchainImages * (lv_bloomTextureSize + lv_gbufferTextureSize) == lv_totalBytes);
+
+			for (uint32_t i = 0; i < lv_totalNumSwapchainImages; ++i) {
+				lv_tracker.Untrack(GpuMemoryCategory::m_bloom, lv_bloomTextureSize);
+			}
+
+			const auto lv_bloom = lv_tracker.GetStats(GpuMemoryCategory::m_bloom);
+			TEST_CHECK(0 == lv_bloom.m_totalNumAllocations);
+			TEST_CHECK(0 == lv_bloom.m_totalBytes);
+			TEST_CHECK(lv_bloomBytes == lv_bloom.m_peakBytes);
+			TEST_CHECK(lv_totalBytes - lv_bloomBytes == lv_tracker.GetTotalBytes());
+
+			//Recreating the chain at a smaller size leaves the peak where it was
+			lv_tracker.Track(GpuMemoryCategory::m_bloom, lv_bloomTextureSize / 4);
+			TEST_CHECK(lv_bloomTextureSize / 4 == lv_tracker.GetStats(GpuMemoryCategory::m_bloom).m_totalBytes);
+			TEST_CHECK(lv_bloomBytes == lv_tracker.GetStats(GpuMemoryCategory::m_bloom).m_peakBytes);
+		}
+	}
+
+
+	void RunGpuMemoryCategoryTests()
+	{
+		TestStringToCategory();
+		TestFrameGraphTextureInfos();
+		TestFrameGraphBreakdown();
+		TestReleaseKeepsPeak();
+	}
+
+}
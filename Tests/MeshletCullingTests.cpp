@@ -0,0 +1,184 @@
+#include "TestFramework.hpp"
+#include "MeshletCulling.hpp"
+#include <array>
+#include <cmath>
+#include <glm/ext.hpp>
+
+
+namespace Tests
+{
+
+	namespace
+	{
+		using MeshConverter::Meshlet;
+		using RenderCore::InstanceData;
+		using RenderCore::MeshletRange;
+
+		//The camera of IndirectRenderer, at the origin looking down -z, so x is bounded by |z| * tan(30)
+		const glm::vec3 lv_cameraPosition{ 0.f, 0.f, 0.f };
+
+		glm::mat4 CreateViewProjection()
+		{
+			const glm::mat4 lv_projection = glm::perspective(glm::radians(60.f), 1.f, 0.1f, 100.f);
+			const glm::mat4 lv_view = glm::lookAt(lv_cameraPosition, glm::vec3{ 0.f, 0.f, -1.f }, glm::vec3{ 0.f, 1.f, 0.f });
+
+			return lv_projection * lv_view;
+		}
+
+
+		Meshlet CreateMeshlet(const glm::vec3& l_center, float l_radius, const glm::vec3& l_coneAxis, float l_coneCutoff,
+			uint32_t l_meshletIndex)
+		{
+			Meshlet lv_meshlet{};
+
+			lv_meshlet.m_center[0] = l_center.x;
+			lv_meshlet.m_center[1] = l_center.y;
+			lv_meshlet.m_center[2] = l_center.z;
+			lv_meshlet.m_radius = l_radius;
+
+			lv_meshlet.m_coneAxis[0] = l_coneAxis.x;
+			lv_meshlet.m_coneAxis[1] = l_coneAxis.y;
+			lv_meshlet.m_coneAxis[2] = l_coneAxis.z;
+			lv_meshlet.m_coneCutoff = l_coneCutoff;
+
+			//Tells the draws apart
+			lv_meshlet.m_firstIndex = 100 * l_meshletIndex;
+			lv_meshlet.m_totalNumIndices = 3 * (l_meshletIndex + 1);
+
+			return lv_meshlet;
+		}
+
+
+		//Mesh 0 LOD 0 owns meshlets 0 to 4, mesh 1 LOD 1 owns meshlets 5 and 6
+		const std::array<Meshlet, 7> lv_meshlets{
+			//In front of the camera
+			CreateMeshlet({ 0.f, 0.f, -10.f }, 1.f, { 0.f, 0.f, 0.f }, 1.f, 0),
+			//Behind the near plane
+			CreateMeshlet({ 0.f, 0.f, 10.f }, 1.f, { 0.f, 0.f, 0.f }, 1.f, 1),
+			//Past the far plane
+			CreateMeshlet({ 0.f, 0.f, -200.f }, 1.f, { 0.f, 0.f, 0.f }, 1.f, 2),
+			//Far to the right of the right plane
+			CreateMeshlet({ 30.f, 0.f, -10.f }, 1.f, { 0.f, 0.f, 0.f }, 1.f, 3),
+			//Center outside of the right plane by 0.63, the radius reaches back in
+			CreateMeshlet({ 6.5f, 0.f, -10.f }, 1.f, { 0.f, 0.f, 0.f }, 1.f, 4),
+			//Every triangle faces away from the camera, 10 >= 0.5 * 10 + 1
+			CreateMeshlet({ 0.f, 0.f, -10.f }, 1.f, { 0.f, 0.f, -1.f }, 0.5f, 5),
+			//Same cone turned towards the camera
+			CreateMeshlet({ 0.f, 0.f, -10.f }, 1.f, { 0.f, 0.f, 1.f }, 0.5f, 6)
+		};
+
+
+		std::array<MeshletRange, 2 * MeshConverter::lv_maxLODCount> CreateMeshletRanges()
+		{
+			std::array<MeshletRange, 2 * MeshConverter::lv_maxLODCount> lv_ranges{};
+
+			lv_ranges[0] = MeshletRange{ .m_firstMeshlet = 0, .m_totalNumMeshlets = 5 };
+			lv_ranges[MeshConverter::lv_maxLODCount + 1] = MeshletRange{ .m_firstMeshlet = 5, .m_totalNumMeshlets = 2 };
+
+			return lv_ranges;
+		}
+
+
+		//Instance 2 uses the same LOD as instance 0, but the instance culling already dropped it
+		const std::array<InstanceData, 3> lv_instances{ {
+			{ .m_meshIndex = 0, .m_lod = 0 },
+			{ .m_meshIndex = 1, .m_lod = 1 },
+			{ .m_meshIndex = 0, .m_lod = 0 }
+		} };
+
+		const std::array<VkDrawIndirectCommand, 3> lv_instanceDraws{ {
+			{ .vertexCount = 0, .instanceCount = 1 },
+			{ .vertexCount = 0, .instanceCount = 1 },
+			{ .vertexCount = 0, .instanceCount = 0 }
+		} };
+
+
+		bool IsDrawOf(const VkDrawIndirectCommand& l_draw, uint32_t l_meshletIndex, uint32_t l_instanceIndex)
+		{
+			return lv_meshlets[l_meshletIndex].m_totalNumIndices == l_draw.vertexCount && 1 == l_draw.instanceCount &&
+				lv_meshlets[l_meshletIndex].m_firstIndex == l_draw.firstVertex && l_instanceIndex == l_draw.firstInstance;
+		}
+
+
+		void TestCullingView()
+		{
+			const auto lv_view = RenderCore::CreateMeshletCullingView(CreateViewProjection(), lv_cameraPosition, true);
+
+			//The spheres are tested against true distances
+			for (const auto& l_plane : lv_view.m_frustumPlanes) {
+				TEST_CHECK(std::abs(glm::length(glm::vec3{ l_plane }) - 1.f) < 1e-4f);
+			}
+
+			TEST_CHECK(1.f == lv_view.m_cameraPosition.w);
+			TEST_CHECK(1U == lv_view.m_enableConeCulling);
+			TEST_CHECK(0U == RenderCore::CreateMeshletCullingView(CreateViewProjection(), lv_cameraPosition, false).m_enableConeCulling);
+		}
+
+
+		void TestFrustumAndConeCulling()
+		{
+			const auto lv_view = RenderCore::CreateMeshletCullingView(CreateViewProjection(), lv_cameraPosition, true);
+			const auto lv_ranges = CreateMeshletRanges();
+			std::array<VkDrawIndirectCommand, lv_meshlets.size()> lv_draws{};
+
+			const uint32_t lv_totalNumDraws = RenderCore::CullMeshlets(lv_view, lv_instances, lv_instanceDraws,
+				lv_ranges, lv_meshlets, lv_draws);
+
+			TEST_CHECK(3 == lv_totalNumDraws);
+
+			if (3 == lv_totalNumDraws) {
+				TEST_CHECK(true == IsDrawOf(lv_draws[0], 0, 0));
+				TEST_CHECK(true == IsDrawOf(lv_draws[1], 4, 0));
+				TEST_CHECK(true == IsDrawOf(lv_draws[2], 6, 1));
+			}
+		}
+
+
+		void TestConeCullingDisabled()
+		{
+			const auto lv_view = RenderCore::CreateMeshletCullingView(CreateViewProjection(), lv_cameraPosition, false);
+			const auto lv_ranges = CreateMeshletRanges();
+			std::array<VkDrawIndirectCommand, lv_meshlets.size()> lv_draws{};
+
+			const uint32_t lv_totalNumDraws = RenderCore::CullMeshlets(lv_view, lv_instances, lv_instanceDraws,
+				lv_ranges, lv_meshlets, lv_draws);
+
+			//The back facing meshlet comes back, the frustum still drops the other three
+			TEST_CHECK(4 == lv_totalNumDraws);
+
+			if (4 == lv_totalNumDraws) {
+				TEST_CHECK(true == IsDrawOf(lv_draws[0], 0, 0));
+				TEST_CHECK(true == IsDrawOf(lv_draws[1], 4, 0));
+				TEST_CHECK(true == IsDrawOf(lv_draws[2], 5, 1));
+				TEST_CHECK(true == IsDrawOf(lv_draws[3], 6, 1));
+			}
+		}
+
+
+		void TestDrawCapacity()
+		{
+			const auto lv_view = RenderCore::CreateMeshletCullingView(CreateViewProjection(), lv_cameraPosition, true);
+			const auto lv_ranges = CreateMeshletRanges();
+			std::array<VkDrawIndirectCommand, 3> lv_draws{};
+
+			//Surviving meshlets past the end of the draw buffer are dropped, the ones before them are kept
+			const uint32_t lv_totalNumDraws = RenderCore::CullMeshlets(lv_view, lv_instances, lv_instanceDraws,
+				lv_ranges, lv_meshlets, std::span<VkDrawIndirectCommand>{ lv_draws.data(), 2 });
+
+			TEST_CHECK(2 == lv_totalNumDraws);
+			TEST_CHECK(true == IsDrawOf(lv_draws[0], 0, 0));
+			TEST_CHECK(true == IsDrawOf(lv_draws[1], 4, 0));
+			TEST_CHECK(0 == lv_draws[2].instanceCount);
+		}
+	}
+
+
+	void RunMeshletCullingTests()
+	{
+		TestCullingView();
+		TestFrustumAndConeCulling();
+		TestConeCullingDisabled();
+		TestDrawCapacity();
+	}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+
+
+#include <cinttypes>
+#include <cstdio>
+
+
+
+namespace Tests
+{
+
+	struct TestResults
+	{
+		uint32_t m_totalNumChecks{ 0 };
+		uint32_t m_totalNumFailures{ 0 };
+	};
+
+	TestResults& GetTestResults();
+
+
+	//Every suite lives in its own translation unit, TestMain.cpp runs them one after the other
+	void RunGpuMemoryAllocatorTests();
+	void RunGpuMemoryCategoryTests();
+	void RunConcurrentSlotArrayTests();
+	void RunMeshletCullingTests();
+	void RunVulkanResourceManagerTests();
+
+}
+
+
+//Records the outcome and keeps going, so one run reports every failing check
+#define TEST_CHECK(l_condition)																		\
+		{																							\
+			++Tests::GetTestResults().m_totalNumChecks;												\
+			if (false == (l_condition)) {															\
+				++Tests::GetTestResults().m_totalNumFailures;										\
+				printf("  Check failed: %s\n  At file: %s \n  At line number: %d\n",				\
+			#l_condition, __FILE__, __LINE__);														\
+			}																						\
+		}
@@ -0,0 +1,45 @@
+#include "TestFramework.hpp"
+#include <array>
+#include <utility>
+
+
+namespace Tests
+{
+
+	TestResults& GetTestResults()
+	{
+		static TestResults lv_results{};
+		return lv_results;
+	}
+
+}
+
+
+
+//Tests of the renderer. The checks that need a device run on any Vulkan 1.3 implementation, lavapipe included,
+//and are skipped with a message when there is none. Returns 0 when every check passed, so the executable can gate a build.
+int main()
+{
+	using namespace Tests;
+
+	const std::array<std::pair<const char*, void(*)()>, 5> lv_suites{ {
+		{ "GpuMemoryAllocator", &RunGpuMemoryAllocatorTests },
+		{ "GpuMemoryCategories", &RunGpuMemoryCategoryTests },
+		{ "ConcurrentSlotArray", &RunConcurrentSlotArrayTests },
+		{ "MeshletCulling", &RunMeshletCullingTests },
+		{ "VulkanResourceManager", &RunVulkanResourceManagerTests }
+	} };
+
+	for (const auto& l_suite : lv_suites) {
+		const uint32_t lv_totalNumFailuresBefore = GetTestResults().m_totalNumFailures;
+
+		printf("Running %s tests...\n", l_suite.first);
+		l_suite.second();
+		printf("%s: %u failed checks\n\n", l_suite.first, GetTestResults().m_totalNumFailures - lv_totalNumFailuresBefore);
+	}
+
+	printf("%u of %u checks passed.\n", GetTestResults().m_totalNumChecks - GetTestResults().m_totalNumFailures,
+		GetTestResults().m_totalNumChecks);
+
+	return (0U == GetTestResults().m_totalNumFailures) ? 0 : 1;
+}
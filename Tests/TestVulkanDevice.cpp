@@ -0,0 +1,289 @@
+#include "TestVulkanDevice.hpp"
+#include <cstdio>
+#include <vector>
+
+
+namespace Tests
+{
+
+	namespace
+	{
+		constexpr uint32_t lv_totalCmdBuffersFromEachPool = 30;
+
+
+		bool CreateHeadlessInstance(VkInstance& l_instance)
+		{
+			//Every resource of VulkanResourceManager is named through vkSetDebugUtilsObjectNameEXT
+			const char* lv_extensions[] = { VK_EXT_DEBUG_UTILS_EXTENSION_NAME };
+
+			const VkApplicationInfo lv_appInfo{
+				.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+				.pNext = nullptr,
+				.pApplicationName = "RendererTests",
+				.applicationVersion = VK_MAKE_API_VERSION(0, 1, 3, 0),
+				.pEngineName = "No Engine",
+				.engineVersion = VK_MAKE_API_VERSION(0, 1, 3, 0),
+				.apiVersion = VK_MAKE_API_VERSION(0, 1, 3, 0)
+			};
+
+			const VkInstanceCreateInfo lv_createInfo{
+				.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+				.pNext = nullptr,
+				.flags = 0,
+				.pApplicationInfo = &lv_appInfo,
+				.enabledLayerCount = 0,
+				.ppEnabledLayerNames = nullptr,
+				.enabledExtensionCount = 1,
+				.ppEnabledExtensionNames = lv_extensions
+			};
+
+			if (VK_SUCCESS != vkCreateInstance(&lv_createInfo, nullptr, &l_instance)) {
+				return false;
+			}
+
+			volkLoadInstance(l_instance);
+			return true;
+		}
+
+
+		uint32_t FindMainFamily(VkPhysicalDevice l_physicalDevice)
+		{
+			constexpr VkQueueFlags lv_mainFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+
+			uint32_t lv_totalNumFamilies{ 0 };
+			vkGetPhysicalDeviceQueueFamilyProperties(l_physicalDevice, &lv_totalNumFamilies, nullptr);
+
+			std::vector<VkQueueFamilyProperties> lv_families(lv_totalNumFamilies);
+			vkGetPhysicalDeviceQueueFamilyProperties(l_physicalDevice, &lv_totalNumFamilies, lv_families.data());
+
+			for (uint32_t i = 0; i < lv_totalNumFamilies; ++i) {
+				if (0 < lv_families[i].queueCount && lv_mainFlags == (lv_families[i].queueFlags & lv_mainFlags)) {
+					return i;
+				}
+			}
+
+			return UINT32_MAX;
+		}
+
+
+		//Same features as initVulkanRenderDevice3, without the swapchain and the shader stages nothing here records
+		bool CreateHeadlessDevice(VkPhysicalDevice l_physicalDevice, uint32_t l_mainFamily, VkDevice& l_device)
+		{
+			VkPhysicalDeviceVulkan12Features lv_vk12Features{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+				.drawIndirectCount = VK_TRUE,
+				.descriptorIndexing = VK_TRUE,
+				.shaderSampledImageArrayNonUniformIndexing = VK_TRUE,
+				.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE,
+				.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE,
+				.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE,
+				.descriptorBindingUpdateUnusedWhilePending = VK_TRUE,
+				.descriptorBindingPartiallyBound = VK_TRUE,
+				.descriptorBindingVariableDescriptorCount = VK_TRUE,
+				.runtimeDescriptorArray = VK_TRUE,
+				.timelineSemaphore = VK_TRUE,
+			};
+
+			VkPhysicalDeviceVulkan11Features lv_vk11Features{};
+			lv_vk11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+			lv_vk11Features.pNext = &lv_vk12Features;
+			lv_vk11Features.shaderDrawParameters = VK_TRUE;
+
+			const VkPhysicalDeviceFeatures2 lv_deviceFeatures2{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+				.pNext = &lv_vk11Features,
+				.features = VkPhysicalDeviceFeatures{
+					.multiDrawIndirect = VK_TRUE,
+					.drawIndirectFirstInstance = VK_TRUE,
+					.fillModeNonSolid = VK_TRUE,
+					.samplerAnisotropy = VK_TRUE,
+					.shaderSampledImageArrayDynamicIndexing = VK_TRUE,
+					.shaderInt64 = VK_TRUE
+				}
+			};
+
+			std::vector<const char*> lv_extensions{};
+			if (true == isDeviceExtensionSupported(l_physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+				lv_extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+			}
+
+			const float lv_queuePriority{ 0.f };
+			const VkDeviceQueueCreateInfo lv_queueCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+				.pNext = nullptr,
+				.flags = 0,
+				.queueFamilyIndex = l_mainFamily,
+				.queueCount = 1,
+				.pQueuePriorities = &lv_queuePriority
+			};
+
+			const VkDeviceCreateInfo lv_createInfo{
+				.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+				.pNext = &lv_deviceFeatures2,
+				.flags = 0,
+				.queueCreateInfoCount = 1,
+				.pQueueCreateInfos = &lv_queueCreateInfo,
+				.enabledLayerCount = 0,
+				.ppEnabledLayerNames = nullptr,
+				.enabledExtensionCount = (uint32_t)lv_extensions.size(),
+				.ppEnabledExtensionNames = lv_extensions.data(),
+				.pEnabledFeatures = nullptr
+			};
+
+			return VK_SUCCESS == vkCreateDevice(l_physicalDevice, &lv_createInfo, nullptr, &l_device);
+		}
+
+
+		bool CreateCommandPools(VulkanRenderDevice& l_vkDev, uint32_t l_totalNumFramesInFlight)
+		{
+			l_vkDev.m_mainCommandPool1.resize(l_totalNumFramesInFlight, VK_NULL_HANDLE);
+			l_vkDev.m_mainCommandPool2.resize(l_totalNumFramesInFlight, VK_NULL_HANDLE);
+			l_vkDev.m_mainCommandBuffer1.resize(lv_totalCmdBuffersFromEachPool * l_totalNumFramesInFlight);
+			l_vkDev.m_mainCommandBuffers2.resize(lv_totalCmdBuffersFromEachPool * l_totalNumFramesInFlight);
+			l_vkDev.m_totalNumCmdBuffersLeft1.assign(l_totalNumFramesInFlight, lv_totalCmdBuffersFromEachPool);
+			l_vkDev.m_totalNumCmdBufferLeft2.assign(l_totalNumFramesInFlight, lv_totalCmdBuffersFromEachPool);
+
+			const VkCommandPoolCreateInfo lv_poolCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+				.pNext = nullptr,
+				.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+				.queueFamilyIndex = l_vkDev.m_mainFamily
+			};
+
+			for (uint32_t i = 0; i < l_totalNumFramesInFlight; ++i) {
+
+				if (VK_SUCCESS != vkCreateCommandPool(l_vkDev.m_device, &lv_poolCreateInfo, nullptr, &l_vkDev.m_mainCommandPool1[i]) ||
+					VK_SUCCESS != vkCreateCommandPool(l_vkDev.m_device, &lv_poolCreateInfo, nullptr, &l_vkDev.m_mainCommandPool2[i])) {
+					return false;
+				}
+
+				VkCommandBufferAllocateInfo lv_allocateInfo{
+					.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+					.pNext = nullptr,
+					.commandPool = l_vkDev.m_mainCommandPool1[i],
+					.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+					.commandBufferCount = lv_totalCmdBuffersFromEachPool
+				};
+
+				if (VK_SUCCESS != vkAllocateCommandBuffers(l_vkDev.m_device, &lv_allocateInfo,
+					&l_vkDev.m_mainCommandBuffer1[lv_totalCmdBuffersFromEachPool * i])) {
+					return false;
+				}
+
+				lv_allocateInfo.commandPool = l_vkDev.m_mainCommandPool2[i];
+
+				if (VK_SUCCESS != vkAllocateCommandBuffers(l_vkDev.m_device, &lv_allocateInfo,
+					&l_vkDev.m_mainCommandBuffers2[lv_totalCmdBuffersFromEachPool * i])) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+
+	bool CreateTestVulkanDevice(TestVulkanDevice& l_device, uint32_t l_totalNumFramesInFlight)
+	{
+		auto& lv_vkDev = l_device.m_vkDev;
+
+		if (VK_SUCCESS != volkInitialize()) {
+			printf("  No Vulkan loader, skipping the checks that need a device.\n");
+			return false;
+		}
+
+		if (false == CreateHeadlessInstance(l_device.m_instance.instance)) {
+			printf("  Could not create a Vulkan 1.3 instance with %s, skipping the checks that need a device.\n",
+				VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+			return false;
+		}
+
+		uint32_t lv_totalNumPhysicalDevices{ 0 };
+		vkEnumeratePhysicalDevices(l_device.m_instance.instance, &lv_totalNumPhysicalDevices, nullptr);
+
+		std::vector<VkPhysicalDevice> lv_physicalDevices(lv_totalNumPhysicalDevices);
+		vkEnumeratePhysicalDevices(l_device.m_instance.instance, &lv_totalNumPhysicalDevices, lv_physicalDevices.data());
+
+		for (auto l_physicalDevice : lv_physicalDevices) {
+
+			VkPhysicalDeviceProperties lv_deviceProperties{};
+			vkGetPhysicalDeviceProperties(l_physicalDevice, &lv_deviceProperties);
+
+			const uint32_t lv_mainFamily = FindMainFamily(l_physicalDevice);
+
+			if (VK_API_VERSION_1_3 > lv_deviceProperties.apiVersion || UINT32_MAX == lv_mainFamily) {
+				continue;
+			}
+
+			if (true == CreateHeadlessDevice(l_physicalDevice, lv_mainFamily, lv_vkDev.m_device)) {
+				printf("  Running on %s.\n", lv_deviceProperties.deviceName);
+
+				lv_vkDev.m_physicalDevice = l_physicalDevice;
+				lv_vkDev.m_mainFamily = lv_mainFamily;
+				lv_vkDev.m_computeTransferFamily = lv_mainFamily;
+				lv_vkDev.m_maxAnisotropy = lv_deviceProperties.limits.maxSamplerAnisotropy;
+				break;
+			}
+		}
+
+		if (VK_NULL_HANDLE == lv_vkDev.m_device) {
+			printf("  No Vulkan 1.3 device with the features of the renderer, skipping the checks that need a device.\n");
+			vkDestroyInstance(l_device.m_instance.instance, nullptr);
+			l_device.m_instance.instance = VK_NULL_HANDLE;
+			return false;
+		}
+
+		lv_vkDev.m_memoryBudgetSupported = isDeviceExtensionSupported(lv_vkDev.m_physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+		lv_vkDev.m_framebufferWidth = 1024;
+		lv_vkDev.m_framebufferHeight = 1024;
+
+		vkGetDeviceQueue(lv_vkDev.m_device, lv_vkDev.m_mainFamily, 0, &lv_vkDev.m_mainQueue1);
+		lv_vkDev.m_mainQueue2 = lv_vkDev.m_mainQueue1;
+
+		lv_vkDev.m_swapchainImages.assign(l_totalNumFramesInFlight, VK_NULL_HANDLE);
+		lv_vkDev.m_swapchainImageViews.assign(l_totalNumFramesInFlight, VK_NULL_HANDLE);
+
+		if (VK_SUCCESS != createSemaphore(lv_vkDev.m_device, &lv_vkDev.m_timelineSemaphore, true) ||
+			VK_SUCCESS != createSemaphore(lv_vkDev.m_device, &lv_vkDev.m_binarySemaphore, false) ||
+			false == CreateCommandPools(lv_vkDev, l_totalNumFramesInFlight)) {
+			printf("  Could not create the semaphores and command pools of the test device, skipping the checks that need a device.\n");
+			DestroyTestVulkanDevice(l_device);
+			return false;
+		}
+
+		lv_vkDev.m_useCompute = true;
+
+		return true;
+	}
+
+
+	void DestroyTestVulkanDevice(TestVulkanDevice& l_device)
+	{
+		auto& lv_vkDev = l_device.m_vkDev;
+
+		if (VK_NULL_HANDLE != lv_vkDev.m_device) {
+
+			vkDeviceWaitIdle(lv_vkDev.m_device);
+
+			for (auto l_commandPool : lv_vkDev.m_mainCommandPool1) {
+				vkDestroyCommandPool(lv_vkDev.m_device, l_commandPool, nullptr);
+			}
+
+			for (auto l_commandPool : lv_vkDev.m_mainCommandPool2) {
+				vkDestroyCommandPool(lv_vkDev.m_device, l_commandPool, nullptr);
+			}
+
+			vkDestroySemaphore(lv_vkDev.m_device, lv_vkDev.m_timelineSemaphore, nullptr);
+			vkDestroySemaphore(lv_vkDev.m_device, lv_vkDev.m_binarySemaphore, nullptr);
+
+			vkDestroyDevice(lv_vkDev.m_device, nullptr);
+		}
+
+		if (VK_NULL_HANDLE != l_device.m_instance.instance) {
+			vkDestroyInstance(l_device.m_instance.instance, nullptr);
+		}
+
+		l_device = TestVulkanDevice{};
+	}
+
+}
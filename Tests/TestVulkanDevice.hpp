@@ -0,0 +1,28 @@
+#pragma once
+
+
+
+#include "UtilsVulkan.h"
+#include <cinttypes>
+
+
+
+namespace Tests
+{
+
+	//Headless stand-in for the device VulkanEngineCore creates, enough to construct a VulkanResourceManager on.
+	//There is no surface or swapchain, the swapchain images are null handles that only set the number of frames in flight.
+	struct TestVulkanDevice
+	{
+		VulkanInstance m_instance{};
+		VulkanRenderDevice m_vkDev{};
+	};
+
+
+	//Picks the first Vulkan 1.3 device with the features initVulkanRenderDevice3 enables, lavapipe is enough.
+	//Returns false after printing why when there is none, the suites that need a device skip their checks then.
+	bool CreateTestVulkanDevice(TestVulkanDevice& l_device, uint32_t l_totalNumFramesInFlight);
+
+	void DestroyTestVulkanDevice(TestVulkanDevice& l_device);
+
+}
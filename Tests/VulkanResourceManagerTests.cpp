@@ -0,0 +1,391 @@
+#include "TestFramework.hpp"
+#include "TestVulkanDevice.hpp"
+#include "VulkanResourceManager.hpp"
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace Tests
+{
+
+	namespace
+	{
+		using RenderCore::BufferHandle;
+		using RenderCore::GpuMemoryCategory;
+		using RenderCore::GpuMemoryCategoryStats;
+		using RenderCore::TextureHandle;
+		using RenderCore::VulkanResourceManager;
+
+		constexpr uint32_t lv_totalNumSwapchainImages = 3;
+		constexpr uint32_t lv_totalNumThreads = 4;
+		constexpr uint32_t lv_totalNumBuffersPerThread = 16;
+		constexpr uint32_t lv_totalNumTexturesPerThread = 4;
+		constexpr uint32_t lv_totalNumWordsPerBuffer = 64;
+		constexpr VkDeviceSize lv_bufferSize = lv_totalNumWordsPerBuffer * sizeof(uint32_t);
+
+		//Storage usage is what gives the buffers a bindless slot, the transfer bits let the test read them back
+		constexpr VkBufferUsageFlags lv_bufferUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+
+		//What one loader thread created in one round
+		struct ThreadResources
+		{
+			std::vector<BufferHandle> m_buffers{};
+			std::vector<std::string> m_bufferNames{};
+			std::vector<TextureHandle> m_textures{};
+			std::vector<std::string> m_textureNames{};
+		};
+
+
+		template<typename t_function>
+		void RunOnThreads(uint32_t l_totalNumThreads, const t_function& l_function)
+		{
+			std::vector<std::thread> lv_workers{};
+			lv_workers.reserve(l_totalNumThreads);
+
+			for (uint32_t i = 0; i < l_totalNumThreads; ++i) {
+				lv_workers.emplace_back(l_function, i);
+			}
+
+			for (auto& l_worker : lv_workers) {
+				l_worker.join();
+			}
+		}
+
+
+		std::string ResourceName(const char* l_prefix, uint32_t l_round, uint32_t l_threadIndex, uint32_t l_index)
+		{
+			return std::string{ l_prefix } + " " + std::to_string(l_round) + " " + std::to_string(l_threadIndex) +
+				" " + std::to_string(l_index);
+		}
+
+
+		//Every word of every buffer differs, so a copy that landed in the wrong buffer is caught
+		uint32_t WordOf(uint32_t l_round, uint32_t l_threadIndex, uint32_t l_bufferIndex, uint32_t l_wordIndex)
+		{
+			return (l_round << 28) | (l_threadIndex << 20) | (l_bufferIndex << 8) | l_wordIndex;
+		}
+
+
+		//RendererTests runs from Tests/ inside Visual Studio and from the repository root otherwise.
+		//Empty when the image is not there, the threads then only create buffers and render targets.
+		std::string FindTestImage()
+		{
+			for (const char* l_path : { "../Media/FullScreenDebugTiledDeferred2.png", "Media/FullScreenDebugTiledDeferred2.png" }) {
+				if (true == std::filesystem::exists(l_path)) {
+					return l_path;
+				}
+			}
+
+			return {};
+		}
+
+
+		//Creation, uploads and name registration from several threads at once, which is what the loader threads do.
+		//TEST_CHECK is not thread safe, so the threads only count what went wrong.
+		void CreateFromThreads(VulkanResourceManager& l_resourceManager, float l_maxAnisotropy, uint32_t l_round,
+			const std::string& l_imagePath, std::vector<ThreadResources>& l_resources)
+		{
+			l_resources.assign(lv_totalNumThreads, ThreadResources{});
+			std::atomic<uint32_t> lv_totalNumFailedLookups{ 0 };
+
+			RunOnThreads(lv_totalNumThreads, [&](uint32_t l_threadIndex)
+				{
+					auto& lv_resources = l_resources[l_threadIndex];
+					std::vector<uint32_t> lv_words(lv_totalNumWordsPerBuffer);
+
+					for (uint32_t i = 0; i < lv_totalNumBuffersPerThread; ++i) {
+
+						lv_resources.m_bufferNames.push_back(ResourceName("Buffer", l_round, l_threadIndex, i));
+
+						const BufferHandle lv_handle = l_resourceManager.CreateBufferWithHandle(lv_bufferSize, lv_bufferUsage,
+							VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, lv_resources.m_bufferNames.back().c_str(), GpuMemoryCategory::m_other);
+						lv_resources.m_buffers.push_back(lv_handle);
+
+						for (uint32_t j = 0; j < lv_totalNumWordsPerBuffer; ++j) {
+							lv_words[j] = WordOf(l_round, l_threadIndex, i, j);
+						}
+
+						//Recorded into the staging ring under m_mainQueueMutex while the other threads do the same
+						l_resourceManager.CopyDataToLocalBuffer(lv_handle, 0, lv_words.data(), lv_bufferSize);
+
+						if (lv_handle.m_index != l_resourceManager.RetrieveGpuResourceMetaData(lv_resources.m_bufferNames.back()).m_resourceHandle) {
+							++lv_totalNumFailedLookups;
+						}
+					}
+
+					for (uint32_t i = 0; i < lv_totalNumTexturesPerThread; ++i) {
+
+						lv_resources.m_textureNames.push_back(ResourceName("Texture", l_round, l_threadIndex, i));
+
+						//The layout transition is a single time command on the main queue
+						const TextureHandle lv_handle = l_resourceManager.CreateTexture(l_maxAnisotropy,
+							lv_resources.m_textureNames.back().c_str(), VK_FORMAT_R8G8B8A8_UNORM, 16, 16, 1,
+							VK_FILTER_LINEAR, VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_REPEAT, GpuMemoryCategory::m_other);
+
+						l_resourceManager.AddGpuResource(lv_resources.m_textureNames.back().c_str(), lv_handle);
+						lv_resources.m_textures.push_back(lv_handle);
+					}
+
+					if (false == l_imagePath.empty()) {
+						lv_resources.m_textureNames.push_back(ResourceName("Loaded", l_round, l_threadIndex, 0));
+
+						const TextureHandle lv_handle = l_resourceManager.LoadTexture2DWithHandle(l_imagePath);
+
+						l_resourceManager.AddGpuResource(lv_resources.m_textureNames.back().c_str(), lv_handle);
+						lv_resources.m_textures.push_back(lv_handle);
+					}
+
+					//Names the other threads registered are looked up while they are still being added
+					for (uint32_t i = 0; i < (uint32_t)lv_resources.m_textures.size(); ++i) {
+						if (lv_resources.m_textures[i].m_index !=
+							l_resourceManager.RetrieveGpuResourceMetaData(lv_resources.m_textureNames[i]).m_resourceHandle) {
+							++lv_totalNumFailedLookups;
+						}
+					}
+				});
+
+			TEST_CHECK(0 == lv_totalNumFailedLookups.load());
+
+			std::lock_guard lv_lock{ l_resourceManager.GetMainQueueMutex() };
+			l_resourceManager.GetStagingRing().FlushAndWait();
+		}
+
+
+		//Every live buffer and texture has its own resource slot and its own bindless slot
+		void CheckSlots(VulkanResourceManager& l_resourceManager, const std::vector<BufferHandle>& l_buffers,
+			const std::vector<TextureHandle>& l_textures)
+		{
+			std::set<uint32_t> lv_bufferIndices{};
+			std::set<uint32_t> lv_bufferSlots{};
+			std::set<uint32_t> lv_textureIndices{};
+			std::set<uint32_t> lv_textureSlots{};
+
+			for (const auto& l_handle : l_buffers) {
+				const uint32_t lv_slot = l_resourceManager.GetBindlessBufferSlot(l_handle);
+
+				TEST_CHECK(UINT32_MAX != lv_slot);
+				lv_bufferIndices.insert(l_handle.m_index);
+				lv_bufferSlots.insert(lv_slot);
+			}
+
+			for (const auto& l_handle : l_textures) {
+				const uint32_t lv_slot = l_resourceManager.GetBindlessTextureSlot(l_handle);
+
+				TEST_CHECK(UINT32_MAX != lv_slot);
+				lv_textureIndices.insert(l_handle.m_index);
+				lv_textureSlots.insert(lv_slot);
+			}
+
+			TEST_CHECK(l_buffers.size() == lv_bufferIndices.size());
+			TEST_CHECK(l_buffers.size() == lv_bufferSlots.size());
+			TEST_CHECK(l_textures.size() == lv_textureIndices.size());
+			TEST_CHECK(l_textures.size() == lv_textureSlots.size());
+		}
+
+
+		//Reads every buffer back through a host visible copy and compares it with what its thread uploaded
+		void CheckBufferContents(VulkanResourceManager& l_resourceManager, const std::vector<ThreadResources>& l_resources,
+			uint32_t l_round, const std::vector<bool>& l_alive)
+		{
+			const BufferHandle lv_readbackHandle = l_resourceManager.CreateBufferWithHandle(lv_bufferSize,
+				VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+				"Readback", GpuMemoryCategory::m_staging);
+
+			uint32_t lv_totalNumWrongBuffers{ 0 };
+			std::vector<uint32_t> lv_expectedWords(lv_totalNumWordsPerBuffer);
+
+			for (uint32_t i = 0; i < lv_totalNumThreads; ++i) {
+				for (uint32_t j = 0; j < lv_totalNumBuffersPerThread; ++j) {
+
+					if (false == l_alive[i * lv_totalNumBuffersPerThread + j]) {
+						continue;
+					}
+
+					l_resourceManager.CopyBufferRegionsAndWait(l_resources[i].m_buffers[j], lv_readbackHandle,
+						{ VkBufferCopy{.srcOffset = 0, .dstOffset = 0, .size = lv_bufferSize } });
+
+					for (uint32_t k = 0; k < lv_totalNumWordsPerBuffer; ++k) {
+						lv_expectedWords[k] = WordOf(l_round, i, j, k);
+					}
+
+					if (0 != memcmp(lv_expectedWords.data(), l_resourceManager.RetrieveGpuBuffer(lv_readbackHandle).ptr, lv_bufferSize)) {
+						++lv_totalNumWrongBuffers;
+					}
+				}
+			}
+
+			TEST_CHECK(0 == lv_totalNumWrongBuffers);
+
+			l_resourceManager.DestroyBuffer(lv_readbackHandle);
+		}
+
+
+		void TestConcurrentCreationAndDestruction()
+		{
+			TestVulkanDevice lv_testDevice{};
+
+			if (false == CreateTestVulkanDevice(lv_testDevice, lv_totalNumSwapchainImages)) {
+				return;
+			}
+
+			{
+				const std::string lv_pipelineCacheFilePath{
+					(std::filesystem::temp_directory_path() / "RendererTestsPipelineCache.bin").string() };
+
+				VulkanResourceManager lv_resourceManager{ lv_testDevice.m_vkDev, 4U * 1024U * 1024U,
+					lv_pipelineCacheFilePath, 64U * 1024U, 1024U * 1024U, 1024U * 1024U };
+
+				const float lv_maxAnisotropy = lv_testDevice.m_vkDev.m_maxAnisotropy;
+				const std::string lv_imagePath = FindTestImage();
+				const uint32_t lv_totalNumTexturesPerRound = lv_totalNumThreads *
+					(lv_totalNumTexturesPerThread + (true == lv_imagePath.empty() ? 0 : 1));
+				constexpr uint32_t lv_totalNumBuffersPerRound = lv_totalNumThreads * lv_totalNumBuffersPerThread;
+
+				TEST_CHECK(lv_totalNumBuffersPerRound < lv_resourceManager.GetBindlessHeap().GetStorageBufferCapacity());
+				TEST_CHECK(lv_totalNumTexturesPerRound < lv_resourceManager.GetBindlessHeap().GetTextureCapacity());
+
+				const GpuMemoryCategoryStats lv_otherBefore = lv_resourceManager.GetMemoryCategoryStats(GpuMemoryCategory::m_other);
+				const GpuMemoryCategoryStats lv_texturesBefore = lv_resourceManager.GetMemoryCategoryStats(GpuMemoryCategory::m_textures);
+				const GpuMemoryCategoryStats lv_stagingBefore = lv_resourceManager.GetMemoryCategoryStats(GpuMemoryCategory::m_staging);
+
+				std::vector<ThreadResources> lv_firstRound{};
+				CreateFromThreads(lv_resourceManager, lv_maxAnisotropy, 0, lv_imagePath, lv_firstRound);
+
+				std::vector<BufferHandle> lv_liveBuffers{};
+				std::vector<TextureHandle> lv_liveTextures{};
+
+				for (const auto& l_resources : lv_firstRound) {
+					lv_liveBuffers.insert(lv_liveBuffers.end(), l_resources.m_buffers.cbegin(), l_resources.m_buffers.cend());
+					lv_liveTextures.insert(lv_liveTextures.end(), l_resources.m_textures.cbegin(), l_resources.m_textures.cend());
+				}
+
+				CheckSlots(lv_resourceManager, lv_liveBuffers, lv_liveTextures);
+
+				TEST_CHECK(lv_totalNumBuffersPerRound + lv_totalNumThreads * lv_totalNumTexturesPerThread ==
+					lv_resourceManager.GetMemoryCategoryStats(GpuMemoryCategory::m_other).m_totalNumAllocations -
+					lv_otherBefore.m_totalNumAllocations);
+
+				if (false == lv_imagePath.empty()) {
+					TEST_CHECK(lv_totalNumThreads == lv_resourceManager.GetMemoryCategoryStats(GpuMemoryCategory::m_textures).m_totalNumAllocations -
+						lv_texturesBefore.m_totalNumAllocations);
+				}
+
+				std::vector<bool> lv_firstRoundAlive(lv_totalNumBuffersPerRound, true);
+				CheckBufferContents(lv_resourceManager, lv_firstRound, 0, lv_firstRoundAlive);
+				lv_resourceManager.FlushRetiredResources();
+
+				//Every other buffer and texture of the first round goes away on the main thread
+				std::vector<BufferHandle> lv_destroyedBuffers{};
+				std::vector<TextureHandle> lv_destroyedTextures{};
+				lv_liveBuffers.clear();
+				lv_liveTextures.clear();
+
+				for (uint32_t i = 0; i < lv_totalNumThreads; ++i) {
+					const auto& lv_resources = lv_firstRound[i];
+
+					for (uint32_t j = 0; j < lv_totalNumBuffersPerThread; ++j) {
+						if (1 == j % 2) {
+							lv_resourceManager.DestroyBuffer(lv_resources.m_buffers[j]);
+							lv_destroyedBuffers.push_back(lv_resources.m_buffers[j]);
+							lv_firstRoundAlive[i * lv_totalNumBuffersPerThread + j] = false;
+
+							//The name is forgotten and the bindless slot detached right away
+							TEST_CHECK(UINT32_MAX == lv_resourceManager.RetrieveGpuResourceMetaData(lv_resources.m_bufferNames[j]).m_resourceHandle);
+							TEST_CHECK(UINT32_MAX == lv_resourceManager.GetBindlessHeap().GetStorageBufferSlot(lv_resources.m_buffers[j].m_index));
+						}
+						else {
+							lv_liveBuffers.push_back(lv_resources.m_buffers[j]);
+						}
+					}
+
+					for (uint32_t j = 0; j < (uint32_t)lv_resources.m_textures.size(); ++j) {
+						if (1 == j % 2) {
+							lv_resourceManager.DestroyTexture(lv_resources.m_textures[j]);
+							lv_destroyedTextures.push_back(lv_resources.m_textures[j]);
+
+							TEST_CHECK(UINT32_MAX == lv_resourceManager.RetrieveGpuResourceMetaData(lv_resources.m_textureNames[j]).m_resourceHandle);
+							TEST_CHECK(UINT32_MAX == lv_resourceManager.GetBindlessHeap().GetTextureSlot(lv_resources.m_textures[j].m_index));
+						}
+						else {
+							lv_liveTextures.push_back(lv_resources.m_textures[j]);
+						}
+					}
+				}
+
+				TEST_CHECK(lv_destroyedBuffers.size() + lv_destroyedTextures.size() == lv_resourceManager.GetTotalNumPendingDestructions());
+
+				//Waits for the device and hands the bindless slots back
+				lv_resourceManager.FlushRetiredResources();
+				TEST_CHECK(0 == lv_resourceManager.GetTotalNumPendingDestructions());
+
+				//The second round reuses the released resource and bindless slots while the survivors stay untouched
+				std::vector<ThreadResources> lv_secondRound{};
+				CreateFromThreads(lv_resourceManager, lv_maxAnisotropy, 1, {}, lv_secondRound);
+
+				uint32_t lv_totalNumReusedBufferSlots{ 0 };
+
+				for (const auto& l_resources : lv_secondRound) {
+					lv_liveBuffers.insert(lv_liveBuffers.end(), l_resources.m_buffers.cbegin(), l_resources.m_buffers.cend());
+					lv_liveTextures.insert(lv_liveTextures.end(), l_resources.m_textures.cbegin(), l_resources.m_textures.cend());
+
+					for (const auto& l_handle : l_resources.m_buffers) {
+						for (const auto& l_destroyedHandle : lv_destroyedBuffers) {
+							if (l_destroyedHandle.m_index == l_handle.m_index) {
+								++lv_totalNumReusedBufferSlots;
+
+								//A stale handle never compares equal to the one that reuses its slot
+								TEST_CHECK(l_destroyedHandle.m_generation != l_handle.m_generation);
+							}
+						}
+					}
+				}
+
+				TEST_CHECK(lv_destroyedBuffers.size() == lv_totalNumReusedBufferSlots);
+
+				CheckSlots(lv_resourceManager, lv_liveBuffers, lv_liveTextures);
+
+				std::vector<bool> lv_secondRoundAlive(lv_totalNumBuffersPerRound, true);
+				CheckBufferContents(lv_resourceManager, lv_firstRound, 0, lv_firstRoundAlive);
+				CheckBufferContents(lv_resourceManager, lv_secondRound, 1, lv_secondRoundAlive);
+
+				for (const auto& l_handle : lv_liveBuffers) {
+					lv_resourceManager.DestroyBuffer(l_handle);
+				}
+
+				for (const auto& l_handle : lv_liveTextures) {
+					lv_resourceManager.DestroyTexture(l_handle);
+				}
+
+				lv_resourceManager.FlushRetiredResources();
+
+				//Everything the threads and the readbacks allocated was given back
+				const GpuMemoryCategoryStats lv_otherAfter = lv_resourceManager.GetMemoryCategoryStats(GpuMemoryCategory::m_other);
+				const GpuMemoryCategoryStats lv_texturesAfter = lv_resourceManager.GetMemoryCategoryStats(GpuMemoryCategory::m_textures);
+				const GpuMemoryCategoryStats lv_stagingAfter = lv_resourceManager.GetMemoryCategoryStats(GpuMemoryCategory::m_staging);
+
+				TEST_CHECK(lv_otherBefore.m_totalNumAllocations == lv_otherAfter.m_totalNumAllocations);
+				TEST_CHECK(lv_otherBefore.m_totalBytes == lv_otherAfter.m_totalBytes);
+				TEST_CHECK(lv_texturesBefore.m_totalNumAllocations == lv_texturesAfter.m_totalNumAllocations);
+				TEST_CHECK(lv_texturesBefore.m_totalBytes == lv_texturesAfter.m_totalBytes);
+				TEST_CHECK(lv_stagingBefore.m_totalNumAllocations == lv_stagingAfter.m_totalNumAllocations);
+				TEST_CHECK(lv_stagingBefore.m_totalBytes == lv_stagingAfter.m_totalBytes);
+			}
+
+			DestroyTestVulkanDevice(lv_testDevice);
+		}
+	}
+
+
+	void RunVulkanResourceManagerTests()
+	{
+		TestConcurrentCreationAndDestruction();
+	}
+
+}
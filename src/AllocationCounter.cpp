@@ -0,0 +1,54 @@
+
+
+#include "AllocationCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+
+#if defined (_DEBUG)
+
+namespace
+{
+	std::atomic<uint64_t> gv_totalNumAllocations{ 0 };
+
+	void* CountedAllocation(size_t l_size)
+	{
+		gv_totalNumAllocations.fetch_add(1, std::memory_order_relaxed);
+
+		void* lv_ptr = malloc(0 == l_size ? 1 : l_size);
+
+		if (nullptr == lv_ptr) {
+			throw std::bad_alloc{};
+		}
+
+		return lv_ptr;
+	}
+}
+
+
+void* operator new(size_t l_size) { return CountedAllocation(l_size); }
+void* operator new[](size_t l_size) { return CountedAllocation(l_size); }
+void operator delete(void* l_ptr) noexcept { free(l_ptr); }
+void operator delete[](void* l_ptr) noexcept { free(l_ptr); }
+void operator delete(void* l_ptr, size_t) noexcept { free(l_ptr); }
+void operator delete[](void* l_ptr, size_t) noexcept { free(l_ptr); }
+
+#endif
+
+
+namespace VulkanEngine
+{
+	namespace AllocationCounter
+	{
+		uint64_t GetTotalNumAllocations()
+		{
+#if defined (_DEBUG)
+			return gv_totalNumAllocations.load(std::memory_order_relaxed);
+#else
+			return 0;
+#endif
+		}
+	}
+}
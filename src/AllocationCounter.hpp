@@ -0,0 +1,18 @@
+#pragma once
+
+
+
+#include <cinttypes>
+
+
+
+namespace VulkanEngine
+{
+	//Debug-only counter of the calls made to the global operator new. The frame loop samples it
+	//around UpdateRenderers()/CreateFrame() to catch heap allocations creeping back into the
+	//steady-state frame. In release builds the counter is compiled out and always returns zero.
+	namespace AllocationCounter
+	{
+		uint64_t GetTotalNumAllocations();
+	}
+}
@@ -0,0 +1,335 @@
+
+
+
+
+#include "BindlessDescriptorHeap.hpp"
+#include "ErrorCheck.hpp"
+#include <algorithm>
+#include <array>
+
+
+namespace RenderCore
+{
+
+	BindlessDescriptorHeap::BindlessDescriptorHeap(VulkanRenderDevice& l_renderDevice, SamplerCache& l_samplerCache)
+		:m_renderDevice(l_renderDevice)
+	{
+		using namespace ErrorCheck;
+
+		constexpr uint32_t lv_preferredTextureCapacity = 4096;
+		constexpr uint32_t lv_preferredStorageBufferCapacity = 1024;
+
+		VkPhysicalDeviceDescriptorIndexingProperties lv_indexingProperties{};
+		lv_indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+
+		VkPhysicalDeviceProperties2 lv_deviceProperties{};
+		lv_deviceProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		lv_deviceProperties.pNext = &lv_indexingProperties;
+
+		vkGetPhysicalDeviceProperties2(m_renderDevice.m_physicalDevice, &lv_deviceProperties);
+
+		//Every binding is visible to all stages, so the per stage limits apply to the whole array
+		m_textureSlots.m_capacity = std::min({ lv_preferredTextureCapacity,
+			lv_indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+			lv_indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages });
+		m_storageBufferSlots.m_capacity = std::min({ lv_preferredStorageBufferCapacity,
+			lv_indexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers,
+			lv_indexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers });
+
+		//Same create infos as the textures of VulkanResourceManager, so the cache hands back the very samplers they hold.
+		//Index 0 is the sampler of every LoadTexture2D texture.
+		for (const auto l_addressMode : { VK_SAMPLER_ADDRESS_MODE_REPEAT, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+			VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER }) {
+
+			const VkSampler lv_sampler = l_samplerCache.Acquire(textureSamplerCreateInfo(VK_LOD_CLAMP_NONE,
+				1.f, VK_FILTER_LINEAR, VK_FILTER_LINEAR, l_addressMode));
+
+			m_samplerIndices.emplace(lv_sampler, (uint32_t)m_immutableSamplers.size());
+			m_immutableSamplers.push_back(lv_sampler);
+		}
+
+		const std::array<VkDescriptorSetLayoutBinding, 3> lv_bindings{
+			VkDescriptorSetLayoutBinding{.binding = m_textureBinding, .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+				.descriptorCount = m_textureSlots.m_capacity, .stageFlags = VK_SHADER_STAGE_ALL, .pImmutableSamplers = nullptr},
+			VkDescriptorSetLayoutBinding{.binding = m_samplerBinding, .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
+				.descriptorCount = (uint32_t)m_immutableSamplers.size(), .stageFlags = VK_SHADER_STAGE_ALL,
+				.pImmutableSamplers = m_immutableSamplers.data()},
+			VkDescriptorSetLayoutBinding{.binding = m_storageBufferBinding, .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+				.descriptorCount = m_storageBufferSlots.m_capacity, .stageFlags = VK_SHADER_STAGE_ALL, .pImmutableSamplers = nullptr}
+		};
+
+		const VkDescriptorBindingFlags lv_flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+			VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+		//Immutable samplers are never written, the sampler binding needs none of the update after bind flags
+		const std::array<VkDescriptorBindingFlags, 3> lv_bindingFlags{ lv_flags, 0, lv_flags };
+
+		const VkDescriptorSetLayoutBindingFlagsCreateInfo lv_bindingFlagsCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+			.pNext = nullptr,
+			.bindingCount = (uint32_t)lv_bindingFlags.size(),
+			.pBindingFlags = lv_bindingFlags.data()
+		};
+
+		const VkDescriptorSetLayoutCreateInfo lv_layoutCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+			.pNext = &lv_bindingFlagsCreateInfo,
+			.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+			.bindingCount = (uint32_t)lv_bindings.size(),
+			.pBindings = lv_bindings.data()
+		};
+
+		VULKAN_CHECK(vkCreateDescriptorSetLayout(m_renderDevice.m_device, &lv_layoutCreateInfo, nullptr, &m_descriptorSetLayout));
+
+
+		const std::array<VkDescriptorPoolSize, 3> lv_poolSizes{
+			VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, .descriptorCount = m_textureSlots.m_capacity},
+			VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_SAMPLER, .descriptorCount = (uint32_t)m_immutableSamplers.size()},
+			VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .descriptorCount = m_storageBufferSlots.m_capacity}
+		};
+
+		const VkDescriptorPoolCreateInfo lv_poolCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+			.maxSets = 1,
+			.poolSizeCount = (uint32_t)lv_poolSizes.size(),
+			.pPoolSizes = lv_poolSizes.data()
+		};
+
+		VULKAN_CHECK(vkCreateDescriptorPool(m_renderDevice.m_device, &lv_poolCreateInfo, nullptr, &m_descriptorPool));
+
+
+		const VkDescriptorSetAllocateInfo lv_allocateInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+			.pNext = nullptr,
+			.descriptorPool = m_descriptorPool,
+			.descriptorSetCount = 1,
+			.pSetLayouts = &m_descriptorSetLayout
+		};
+
+		VULKAN_CHECK(vkAllocateDescriptorSets(m_renderDevice.m_device, &lv_allocateInfo, &m_descriptorSet));
+
+
+		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
+		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(m_descriptorSet);
+		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_DESCRIPTOR_SET;
+		lv_objectNameInfo.pNext = nullptr;
+		lv_objectNameInfo.pObjectName = " Bindless-Descriptor-Set ";
+		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+
+		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+
+		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(m_descriptorSetLayout);
+		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT;
+		lv_objectNameInfo.pObjectName = " Bindless-Descriptor-Set-Layout ";
+
+		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+
+		m_pendingWrites.reserve(512);
+		m_descriptorWrites.reserve(512);
+	}
+
+
+	BindlessDescriptorHeap::~BindlessDescriptorHeap()
+	{
+		vkDestroyDescriptorPool(m_renderDevice.m_device, m_descriptorPool, nullptr);
+		vkDestroyDescriptorSetLayout(m_renderDevice.m_device, m_descriptorSetLayout, nullptr);
+	}
+
+
+	uint32_t BindlessDescriptorHeap::WriteTexture(uint32_t l_textureIndex, VkImageView l_imageView, VkImageLayout l_imageLayout)
+	{
+		using namespace ErrorCheck;
+
+		std::lock_guard lv_lock{ m_pendingWritesMutex };
+
+		const uint32_t lv_slot = AcquireSlot(m_textureSlots, l_textureIndex);
+
+		if (UINT32_MAX == lv_slot) {
+			PRINT_EXIT("\nAll texture slots of the bindless descriptor heap are in use.\n");
+		}
+
+		m_pendingWrites.push_back(PendingWrite{ .m_binding = m_textureBinding, .m_slot = lv_slot,
+			.m_descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+			.m_imageInfo = VkDescriptorImageInfo{.sampler = VK_NULL_HANDLE, .imageView = l_imageView, .imageLayout = l_imageLayout } });
+
+		return lv_slot;
+	}
+
+
+	uint32_t BindlessDescriptorHeap::WriteStorageBuffer(uint32_t l_bufferIndex, VkBuffer l_buffer)
+	{
+		using namespace ErrorCheck;
+
+		std::lock_guard lv_lock{ m_pendingWritesMutex };
+
+		const uint32_t lv_slot = AcquireSlot(m_storageBufferSlots, l_bufferIndex);
+
+		if (UINT32_MAX == lv_slot) {
+			PRINT_EXIT("\nAll storage buffer slots of the bindless descriptor heap are in use.\n");
+		}
+
+		m_pendingWrites.push_back(PendingWrite{ .m_binding = m_storageBufferBinding, .m_slot = lv_slot,
+			.m_descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			.m_bufferInfo = VkDescriptorBufferInfo{.buffer = l_buffer, .offset = 0, .range = VK_WHOLE_SIZE } });
+
+		return lv_slot;
+	}
+
+
+	uint32_t BindlessDescriptorHeap::GetTextureSlot(uint32_t l_textureIndex)
+	{
+		std::lock_guard lv_lock{ m_pendingWritesMutex };
+		return FindSlot(m_textureSlots, l_textureIndex);
+	}
+
+	uint32_t BindlessDescriptorHeap::GetStorageBufferSlot(uint32_t l_bufferIndex)
+	{
+		std::lock_guard lv_lock{ m_pendingWritesMutex };
+		return FindSlot(m_storageBufferSlots, l_bufferIndex);
+	}
+
+
+	uint32_t BindlessDescriptorHeap::DetachTexture(uint32_t l_textureIndex)
+	{
+		std::lock_guard lv_lock{ m_pendingWritesMutex };
+		return DetachSlot(m_textureSlots, l_textureIndex);
+	}
+
+	uint32_t BindlessDescriptorHeap::DetachStorageBuffer(uint32_t l_bufferIndex)
+	{
+		std::lock_guard lv_lock{ m_pendingWritesMutex };
+		return DetachSlot(m_storageBufferSlots, l_bufferIndex);
+	}
+
+
+	void BindlessDescriptorHeap::FreeTextureSlot(uint32_t l_slot)
+	{
+		std::lock_guard lv_lock{ m_pendingWritesMutex };
+		m_textureSlots.m_freeSlots.push_back(l_slot);
+	}
+
+	void BindlessDescriptorHeap::FreeStorageBufferSlot(uint32_t l_slot)
+	{
+		std::lock_guard lv_lock{ m_pendingWritesMutex };
+		m_storageBufferSlots.m_freeSlots.push_back(l_slot);
+	}
+
+
+	uint32_t BindlessDescriptorHeap::AcquireSlot(SlotAllocator& l_slotAllocator, uint32_t l_resourceIndex)
+	{
+		if (l_slotAllocator.m_resourceSlots.size() <= l_resourceIndex) {
+			l_slotAllocator.m_resourceSlots.resize(l_resourceIndex + 1, UINT32_MAX);
+		}
+
+		auto& lv_slot = l_slotAllocator.m_resourceSlots[l_resourceIndex];
+
+		if (UINT32_MAX != lv_slot) {
+			return lv_slot;
+		}
+
+		if (false == l_slotAllocator.m_freeSlots.empty()) {
+			lv_slot = l_slotAllocator.m_freeSlots.back();
+			l_slotAllocator.m_freeSlots.pop_back();
+			return lv_slot;
+		}
+
+		if (l_slotAllocator.m_capacity <= l_slotAllocator.m_totalNumSlotsHandedOut) {
+			return UINT32_MAX;
+		}
+
+		lv_slot = l_slotAllocator.m_totalNumSlotsHandedOut++;
+		return lv_slot;
+	}
+
+
+	uint32_t BindlessDescriptorHeap::FindSlot(const SlotAllocator& l_slotAllocator, uint32_t l_resourceIndex) const
+	{
+		return (l_slotAllocator.m_resourceSlots.size() > l_resourceIndex) ? l_slotAllocator.m_resourceSlots[l_resourceIndex] : UINT32_MAX;
+	}
+
+
+	uint32_t BindlessDescriptorHeap::DetachSlot(SlotAllocator& l_slotAllocator, uint32_t l_resourceIndex)
+	{
+		const uint32_t lv_slot = FindSlot(l_slotAllocator, l_resourceIndex);
+
+		if (UINT32_MAX != lv_slot) {
+			l_slotAllocator.m_resourceSlots[l_resourceIndex] = UINT32_MAX;
+		}
+
+		return lv_slot;
+	}
+
+
+	uint32_t BindlessDescriptorHeap::GetSamplerIndex(VkSampler l_sampler) const
+	{
+		auto lv_result = m_samplerIndices.find(l_sampler);
+		return (m_samplerIndices.end() != lv_result) ? lv_result->second : UINT32_MAX;
+	}
+
+
+	void BindlessDescriptorHeap::FlushPendingWrites()
+	{
+		std::lock_guard lv_lock{ m_pendingWritesMutex };
+
+		if (true == m_pendingWrites.empty()) {
+			return;
+		}
+
+		m_descriptorWrites.clear();
+
+		//Later writes to the same slot win, vkUpdateDescriptorSets applies them in order
+		for (auto& l_pendingWrite : m_pendingWrites) {
+
+			const bool lv_isBuffer = (VK_DESCRIPTOR_TYPE_STORAGE_BUFFER == l_pendingWrite.m_descriptorType);
+
+			m_descriptorWrites.push_back(VkWriteDescriptorSet{
+				.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+				.pNext = nullptr,
+				.dstSet = m_descriptorSet,
+				.dstBinding = l_pendingWrite.m_binding,
+				.dstArrayElement = l_pendingWrite.m_slot,
+				.descriptorCount = 1,
+				.descriptorType = l_pendingWrite.m_descriptorType,
+				.pImageInfo = (true == lv_isBuffer) ? nullptr : &l_pendingWrite.m_imageInfo,
+				.pBufferInfo = (true == lv_isBuffer) ? &l_pendingWrite.m_bufferInfo : nullptr,
+				.pTexelBufferView = nullptr });
+		}
+
+		vkUpdateDescriptorSets(m_renderDevice.m_device, (uint32_t)m_descriptorWrites.size(),
+			m_descriptorWrites.data(), 0, nullptr);
+
+		m_pendingWrites.clear();
+	}
+
+
+	void BindlessDescriptorHeap::Bind(VkCommandBuffer l_commandBuffer, VkPipelineBindPoint l_bindPoint,
+		VkPipelineLayout l_pipelineLayout, uint32_t l_setIndex) const
+	{
+		vkCmdBindDescriptorSets(l_commandBuffer, l_bindPoint, l_pipelineLayout, l_setIndex, 1,
+			&m_descriptorSet, 0, nullptr);
+	}
+
+
+	VkDescriptorSetLayout BindlessDescriptorHeap::GetDescriptorSetLayout() const
+	{
+		return m_descriptorSetLayout;
+	}
+
+
+	uint32_t BindlessDescriptorHeap::GetTextureCapacity() const
+	{
+		return m_textureSlots.m_capacity;
+	}
+
+	uint32_t BindlessDescriptorHeap::GetStorageBufferCapacity() const
+	{
+		return m_storageBufferSlots.m_capacity;
+	}
+
+	uint32_t BindlessDescriptorHeap::GetTotalNumSamplers() const
+	{
+		return (uint32_t)m_immutableSamplers.size();
+	}
+
+}
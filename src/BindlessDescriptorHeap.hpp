@@ -0,0 +1,120 @@
+#pragma once
+
+
+
+#include "UtilsVulkan.h"
+#include "SamplerCache.hpp"
+#include <cinttypes>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+
+namespace RenderCore
+{
+
+	//One update-after-bind descriptor set shared by every renderer. Sampled images and storage buffers get a heap
+	//slot of their own on their first write, taken from a free list, so the capacity bounds the number of live
+	//descriptors rather than the range of resource handles. Shaders index the heap with these slots, see
+	//VulkanResourceManager::GetBindlessTextureSlot()/GetBindlessBufferSlot().
+	//The sampler binding is a fixed table of SamplerCache samplers baked into the layout as immutable samplers,
+	//shaders address it with the index GetSamplerIndex() returns.
+	//Writes are only queued; FlushPendingWrites() applies all of them with a single vkUpdateDescriptorSets per frame.
+	//Queueing writes is thread safe, resources can be created from loader threads.
+	class BindlessDescriptorHeap final
+	{
+	public:
+
+		static constexpr uint32_t m_textureBinding = 0;
+		static constexpr uint32_t m_samplerBinding = 1;
+		static constexpr uint32_t m_storageBufferBinding = 2;
+
+		//The immutable samplers are acquired from l_samplerCache, which has to outlive the heap
+		BindlessDescriptorHeap(VulkanRenderDevice& l_renderDevice, SamplerCache& l_samplerCache);
+		~BindlessDescriptorHeap();
+
+		BindlessDescriptorHeap(const BindlessDescriptorHeap&) = delete;
+		BindlessDescriptorHeap& operator=(const BindlessDescriptorHeap&) = delete;
+
+		//l_textureIndex/l_bufferIndex is the slot of the resource in VulkanResourceManager. The first write takes a heap
+		//slot for it, later writes (e.g. after defragmentation moved a buffer) overwrite that same heap slot.
+		//Returns the heap slot.
+		uint32_t WriteTexture(uint32_t l_textureIndex, VkImageView l_imageView, VkImageLayout l_imageLayout);
+		uint32_t WriteStorageBuffer(uint32_t l_bufferIndex, VkBuffer l_buffer);
+
+		//UINT32_MAX when the resource was never written into the heap
+		uint32_t GetTextureSlot(uint32_t l_textureIndex);
+		uint32_t GetStorageBufferSlot(uint32_t l_bufferIndex);
+
+		//Detaches the heap slot from a destroyed resource. The slot may only be handed out again once no frame in
+		//flight reads it anymore (UPDATE_UNUSED_WHILE_PENDING), so it goes back through FreeTextureSlot()/
+		//FreeStorageBufferSlot() when the deferred destruction of VulkanResourceManager releases the resource.
+		uint32_t DetachTexture(uint32_t l_textureIndex);
+		uint32_t DetachStorageBuffer(uint32_t l_bufferIndex);
+
+		void FreeTextureSlot(uint32_t l_slot);
+		void FreeStorageBufferSlot(uint32_t l_slot);
+
+		//UINT32_MAX when l_sampler is not part of the immutable sampler table
+		uint32_t GetSamplerIndex(VkSampler l_sampler) const;
+
+		void FlushPendingWrites();
+
+		void Bind(VkCommandBuffer l_commandBuffer, VkPipelineBindPoint l_bindPoint,
+			VkPipelineLayout l_pipelineLayout, uint32_t l_setIndex) const;
+
+		VkDescriptorSetLayout GetDescriptorSetLayout() const;
+
+		uint32_t GetTextureCapacity() const;
+		uint32_t GetStorageBufferCapacity() const;
+		uint32_t GetTotalNumSamplers() const;
+
+	private:
+
+		//Heap slots of one binding and the resource each of them belongs to
+		struct SlotAllocator
+		{
+			uint32_t m_capacity{ 0 };
+			uint32_t m_totalNumSlotsHandedOut{ 0 };
+			std::vector<uint32_t> m_freeSlots{};
+
+			//Indexed by the resource slot in VulkanResourceManager, UINT32_MAX where there is no heap slot
+			std::vector<uint32_t> m_resourceSlots{};
+		};
+
+		//m_pendingWritesMutex has to be held. AcquireSlot() returns UINT32_MAX when every slot is in use.
+		uint32_t AcquireSlot(SlotAllocator& l_slotAllocator, uint32_t l_resourceIndex);
+		uint32_t FindSlot(const SlotAllocator& l_slotAllocator, uint32_t l_resourceIndex) const;
+		uint32_t DetachSlot(SlotAllocator& l_slotAllocator, uint32_t l_resourceIndex);
+
+		struct PendingWrite
+		{
+			uint32_t m_binding{ 0 };
+			uint32_t m_slot{ 0 };
+			VkDescriptorType m_descriptorType{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE };
+			VkDescriptorImageInfo m_imageInfo{};
+			VkDescriptorBufferInfo m_bufferInfo{};
+		};
+
+
+		VulkanRenderDevice& m_renderDevice;
+
+		VkDescriptorPool m_descriptorPool{ VK_NULL_HANDLE };
+		VkDescriptorSetLayout m_descriptorSetLayout{ VK_NULL_HANDLE };
+		VkDescriptorSet m_descriptorSet{ VK_NULL_HANDLE };
+
+		//Pointed to by the layout, stays unchanged after construction
+		std::vector<VkSampler> m_immutableSamplers{};
+		std::unordered_map<VkSampler, uint32_t> m_samplerIndices{};
+
+		SlotAllocator m_textureSlots{};
+		SlotAllocator m_storageBufferSlots{};
+
+		std::mutex m_pendingWritesMutex{};
+
+		std::vector<PendingWrite> m_pendingWrites{};
+		std::vector<VkWriteDescriptorSet> m_descriptorWrites{};
+	};
+
+}
@@ -62,8 +62,8 @@ namespace RenderCore
 		lv_pipeInfo.m_totalNumColorAttach = lv_node->m_outputResourcesHandles.size();
 
 
-		m_graphicsPipeline = lv_vkResManager.CreateGraphicsPipeline(m_renderPass, m_pipelineLayout
-			, { l_vtxShader, l_fragShader }, "GraphicsPipelineBloomBlendBlurAndScene", lv_pipeInfo);
+		lv_vkResManager.RequestGraphicsPipeline(m_renderPass, m_pipelineLayout
+			, { l_vtxShader, l_fragShader }, "GraphicsPipelineBloomBlendBlurAndScene", lv_pipeInfo, m_graphicsPipeline);
 	}
 
 	void BloomBlendBlurAndSceneRenderer::FillCommandBuffer(VkCommandBuffer l_cmdBuffer,
@@ -93,54 +93,15 @@ namespace RenderCore
 
 	void BloomBlendBlurAndSceneRenderer::UpdateDescriptorSets()
 	{
-		auto& lv_vkResManager = m_vulkanRenderContext.GetResourceManager();
-		auto lv_totalNumSwapchains = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
-
-		std::vector<VkDescriptorImageInfo> lv_imageInfos{};
-		lv_imageInfos.resize(lv_totalNumSwapchains * 2);
-
-		for (size_t i = 0, j = 0; i < lv_imageInfos.size(); i+=2, ++j) {
-
-			lv_imageInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i].imageView = m_deferredLightnintOutputTextures[j]->image.imageView0;
-			lv_imageInfos[i].sampler = m_deferredLightnintOutputTextures[j]->sampler;
+		for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
 
-			lv_imageInfos[i+1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i+1].imageView = m_gaussianBlurredTextures[j]->image.imageView0;
-			lv_imageInfos[i+1].sampler = m_gaussianBlurredTextures[j]->sampler;
+			WriteImageDescriptor(i, 0, { m_deferredLightnintOutputTextures[i]->sampler,
+				m_deferredLightnintOutputTextures[i]->image.imageView0, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+			WriteImageDescriptor(i, 1, { m_gaussianBlurredTextures[i]->sampler,
+				m_gaussianBlurredTextures[i]->image.imageView0, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
 		}
 
-		std::vector<VkWriteDescriptorSet> lv_writes{};
-		lv_writes.resize(lv_totalNumSwapchains*2);
-
-		for (size_t i = 0, j = 0; i < lv_writes.size(); i += 2, ++j) {
-
-			lv_writes[i].descriptorCount = 1;
-			lv_writes[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i].dstArrayElement = 0;
-			lv_writes[i].dstBinding = 0;
-			lv_writes[i].dstSet = m_descriptorSets[j];
-			lv_writes[i].pBufferInfo = nullptr;
-			lv_writes[i].pImageInfo = &lv_imageInfos[i];
-			lv_writes[i].pNext = nullptr;
-			lv_writes[i].pTexelBufferView = nullptr;
-			lv_writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i+1].descriptorCount = 1;
-			lv_writes[i+1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i+1].dstArrayElement = 0;
-			lv_writes[i+1].dstBinding = 1;
-			lv_writes[i+1].dstSet = m_descriptorSets[j];
-			lv_writes[i+1].pBufferInfo = nullptr;
-			lv_writes[i+1].pImageInfo = &lv_imageInfos[i+1];
-			lv_writes[i+1].pNext = nullptr;
-			lv_writes[i+1].pTexelBufferView = nullptr;
-			lv_writes[i+1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-		}
-
-		vkUpdateDescriptorSets(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device, lv_writes.size(), lv_writes.data(), 0, nullptr);
-
+		FlushDescriptorWrites();
 	}
 
 }
\ No newline at end of file
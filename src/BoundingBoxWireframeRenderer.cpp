@@ -56,20 +56,8 @@ namespace RenderCore
 		m_depthTextureHandles.resize(lv_totalNumSwapchains);
 		m_swapchainHandles.resize(lv_totalNumSwapchains);
 		for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
-			auto lv_formattedArg = std::make_format_args(i);
-
-			std::string lv_formattedString = "Depth {}";
-			auto depthMeta = lv_vkResManager.RetrieveGpuResourceMetaData(std::vformat(lv_formattedString, lv_formattedArg));
-			if (depthMeta.m_resourceHandle == UINT32_MAX) {
-				printf("Depth texture was not found. Exitting....");
-				exit(-1);
-			}
-
-			m_depthTextureHandles[i] = depthMeta.m_resourceHandle;
-
-			lv_formattedString = "Swapchain {}";
-			auto lv_swapchainMeta = lv_vkResManager.RetrieveGpuResourceMetaData(std::vformat(lv_formattedString, lv_formattedArg));
-			m_swapchainHandles[i] = lv_swapchainMeta.m_resourceHandle;
+			m_depthTextureHandles[i] = lv_vkResManager.RetrieveGpuTextureHandle("Depth", (uint32_t)i);
+			m_swapchainHandles[i] = lv_vkResManager.RetrieveGpuTextureHandle("Swapchain", (uint32_t)i);
 		}
 
 		auto lv_totalNumWireframeObjects = m_boundingBoxVertices.size() / 32;
@@ -148,11 +136,11 @@ namespace RenderCore
 
 		lv_pipelineInfo.m_enableWireframe = true;
 
-		m_graphicsPipeline = lv_vkResManager.CreateGraphicsPipeline(m_renderPass, m_pipelineLayout,
+		lv_vkResManager.RequestGraphicsPipeline(m_renderPass, m_pipelineLayout,
 			{ l_vertexShaderPath, l_fragmentShaderPath }, "BoundingBoxWireframeRendererPipeline",
-			lv_pipelineInfo);
-
+			lv_pipelineInfo, m_graphicsPipeline, true);
 
+		//Only drawn once the node is enabled for debugging, the pipeline is created then
 		lv_node->m_enabled = false;
 
 	}
@@ -248,6 +236,7 @@ namespace RenderCore
 			lv_depthTexture.Layout, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
 		lv_depthTexture.Layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
+		m_vulkanRenderContext.GetResourceManager().CreateDeferredPipeline(m_graphicsPipeline);
 		BeginRenderPass(m_renderPass, lv_framebuffer, l_cmdBuffer, l_currentSwapchainIndex, 1);
 		for (size_t i = 0; i < lv_totalNumBoxes; ++i) {
 			vkCmdDrawIndexed(l_cmdBuffer, m_boundingBoxIndices.size(), 1, 0, 8 * i, 0);
@@ -329,12 +318,8 @@ namespace RenderCore
 			VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
 			"BoundingBoxIndexBuffer");
 
-		lv_vkResManager.CopyDataToLocalBuffer(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_mainQueue2,
-			m_vulkanRenderContext.GetContextCreator().m_vkDev.m_mainCommandBuffer1[0], m_vertexBufferGpuHandle,
-			m_boundingBoxVertices.data());
-		lv_vkResManager.CopyDataToLocalBuffer(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_mainQueue2,
-			m_vulkanRenderContext.GetContextCreator().m_vkDev.m_mainCommandBuffer1[0], m_indexBufferGpuHandle,
-			m_boundingBoxIndices.data());
+		lv_vkResManager.CopyDataToLocalBuffer(m_vertexBufferGpuHandle, m_boundingBoxVertices.data());
+		lv_vkResManager.CopyDataToLocalBuffer(m_indexBufferGpuHandle, m_boundingBoxIndices.data());
 
 	}
 
@@ -342,48 +327,18 @@ namespace RenderCore
 	void BoundingBoxWireframeRenderer::UpdateDescriptorSets()
 	{
 		auto& lv_vkResManager = m_vulkanRenderContext.GetResourceManager();
-		auto lv_totalNumSwapchains = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
 
-		std::vector<VkDescriptorBufferInfo> lv_bufferInfos;
-		lv_bufferInfos.resize(2*lv_totalNumSwapchains);
-		for (size_t i = 0, j = 0; i < lv_bufferInfos.size(); i+=2, ++j) {
-			auto& lv_uniformBuffer = lv_vkResManager.RetrieveGpuBuffer(m_uniformBufferHandles[j]);
-			lv_bufferInfos[i].buffer = lv_uniformBuffer.buffer;
-			lv_bufferInfos[i].offset = 0;
-			lv_bufferInfos[i].range = lv_uniformBuffer.size;
-
-			auto& lv_colorIndicesBuffer = lv_vkResManager.RetrieveGpuBuffer(m_colorIndicesOfWireframesGpuHandle);
-			lv_bufferInfos[i + 1].buffer = lv_colorIndicesBuffer.buffer;
-			lv_bufferInfos[i + 1].offset = 0;
-			lv_bufferInfos[i + 1].range = lv_colorIndicesBuffer.size;
-		}
+		auto& lv_colorIndicesBuffer = lv_vkResManager.RetrieveGpuBuffer(m_colorIndicesOfWireframesGpuHandle);
+		const VkDescriptorBufferInfo lv_colorIndicesBufferInfo{ lv_colorIndicesBuffer.buffer, 0, lv_colorIndicesBuffer.size };
+
+		for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
 
-		std::vector<VkWriteDescriptorSet> lv_writes{};
-		lv_writes.resize(lv_bufferInfos.size());
-
-		for (size_t i = 0, j = 0; i < lv_writes.size() && j < lv_totalNumSwapchains; i+=2, ++j) {
-			lv_writes[i].descriptorCount = 1;
-			lv_writes[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			lv_writes[i].dstArrayElement = 0;
-			lv_writes[i].dstBinding = 0;
-			lv_writes[i].dstSet = 0;
-			lv_writes[i].pBufferInfo = &lv_bufferInfos[i];
-			lv_writes[i].dstSet = m_descriptorSets[j];
-			lv_writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-
-			lv_writes[i+1].descriptorCount = 1;
-			lv_writes[i+1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-			lv_writes[i+1].dstArrayElement = 0;
-			lv_writes[i+1].dstBinding = 1;
-			lv_writes[i+1].dstSet = 0;
-			lv_writes[i+1].pBufferInfo = &lv_bufferInfos[i+1];
-			lv_writes[i+1].dstSet = m_descriptorSets[j];
-			lv_writes[i+1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			auto& lv_uniformBuffer = lv_vkResManager.RetrieveGpuBuffer(m_uniformBufferHandles[i]);
+
+			WriteBufferDescriptor(i, 0, { lv_uniformBuffer.buffer, 0, lv_uniformBuffer.size });
+			WriteBufferDescriptor(i, 1, lv_colorIndicesBufferInfo);
 		}
 
-		vkUpdateDescriptorSets(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device,
-			lv_writes.size(), lv_writes.data(), 0, nullptr);
-		
+		FlushDescriptorWrites();
 	}
 }
\ No newline at end of file
@@ -64,15 +64,15 @@ namespace RenderCore
 
 		std::vector<float> m_boundingBoxVertices{};
 		std::vector<uint16_t> m_boundingBoxIndices{};
-		uint32_t m_vertexBufferGpuHandle;
-		uint32_t m_indexBufferGpuHandle;
-		uint32_t m_debugViewFrustumIndexGpuHandle;
-		uint32_t m_debugViewFrustumVertexGpuHandle;
-		uint32_t m_colorIndicesOfWireframesGpuHandle;
+		BufferHandle m_vertexBufferGpuHandle;
+		BufferHandle m_indexBufferGpuHandle;
+		BufferHandle m_debugViewFrustumIndexGpuHandle;
+		BufferHandle m_debugViewFrustumVertexGpuHandle;
+		BufferHandle m_colorIndicesOfWireframesGpuHandle;
 		std::vector<uint32_t> m_colorIndicesOfWireframes;
-		std::vector<uint32_t> m_uniformBufferHandles;
-		std::vector<uint32_t> m_depthTextureHandles;
-		std::vector<uint32_t> m_swapchainHandles;
+		std::vector<BufferHandle> m_uniformBufferHandles;
+		std::vector<TextureHandle> m_depthTextureHandles;
+		std::vector<TextureHandle> m_swapchainHandles;
 		DebugViewFrustum m_debugViewFrustum;
 		
 	};
@@ -46,43 +46,20 @@ namespace RenderCore
 		lv_pipeInfo.m_totalNumColorAttach = lv_node->m_outputResourcesHandles.size();
 
 
-		m_graphicsPipeline = lv_vkResManager.CreateGraphicsPipeline(m_renderPass, m_pipelineLayout
-			, { l_vtxShader, l_fragmentShader }, "GraphicsPipelineBoxBlurRenderer", lv_pipeInfo);
+		lv_vkResManager.RequestGraphicsPipeline(m_renderPass, m_pipelineLayout
+			, { l_vtxShader, l_fragmentShader }, "GraphicsPipelineBoxBlurRenderer", lv_pipeInfo, m_graphicsPipeline);
 
 	}
 
 
 	void BoxBlurRenderer::UpdateDescriptorSets()
 	{
-		auto lv_totalNumSwapchains = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
-
-		std::vector<VkDescriptorImageInfo> lv_imageDescriptors{};
-		lv_imageDescriptors.resize(lv_totalNumSwapchains);
-
-		for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
-			lv_imageDescriptors[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageDescriptors[i].imageView = m_ssaoTextures[i]->image.imageView0;
-			lv_imageDescriptors[i].sampler = m_ssaoTextures[i]->sampler;
-		}
-
-
-		std::vector<VkWriteDescriptorSet> lv_writes{};
-		lv_writes.resize(lv_totalNumSwapchains);
-
-		for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
-			lv_writes[i].descriptorCount = 1;
-			lv_writes[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i].dstArrayElement = 0;
-			lv_writes[i].dstBinding = 0;
-			lv_writes[i].dstSet = m_descriptorSets[i];
-			lv_writes[i].pBufferInfo = nullptr;
-			lv_writes[i].pImageInfo = &lv_imageDescriptors[i];
-			lv_writes[i].pNext = nullptr;
-			lv_writes[i].pTexelBufferView = nullptr;
-			lv_writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
+			WriteImageDescriptor(i, 0, { m_ssaoTextures[i]->sampler, m_ssaoTextures[i]->image.imageView0,
+				VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
 		}
 
-		vkUpdateDescriptorSets(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device, lv_writes.size() , lv_writes.data(), 0, nullptr);
+		FlushDescriptorWrites();
 	}
 
 	void BoxBlurRenderer::UpdateBuffers(const uint32_t l_currentSwapchainIndex,
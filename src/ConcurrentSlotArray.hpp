@@ -0,0 +1,181 @@
+#pragma once
+
+
+
+#include "ErrorCheck.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+
+namespace RenderCore
+{
+
+	//Generational slot storage that worker threads can push into concurrently.
+	//Slots live in fixed size chunks that are never moved, so references to an element stay valid for the
+	//lifetime of the array. A fresh slot is claimed with a single fetch_add and a missing chunk is published
+	//with a compare exchange, only the reuse of released slots goes through a mutex.
+	//An element can be read through the slot Push() returned from any thread; walking the whole array
+	//(GetSize()) is only allowed while no Push() is in flight.
+	template<typename T, uint32_t t_chunkSizeLog2 = 8, uint32_t t_maxNumChunks = 1024>
+	class ConcurrentSlotArray final
+	{
+	public:
+
+		struct Slot
+		{
+			uint32_t m_index{ UINT32_MAX };
+			uint32_t m_generation{ 0 };
+		};
+
+		ConcurrentSlotArray() = default;
+
+		~ConcurrentSlotArray()
+		{
+			for (auto& l_chunk : m_chunks) {
+				delete l_chunk.load(std::memory_order_acquire);
+			}
+		}
+
+		ConcurrentSlotArray(const ConcurrentSlotArray&) = delete;
+		ConcurrentSlotArray& operator=(const ConcurrentSlotArray&) = delete;
+
+		Slot Push(const T& l_value)
+		{
+			using namespace ErrorCheck;
+
+			uint32_t lv_index{ UINT32_MAX };
+
+			{
+				std::lock_guard lv_lock{ m_freeSlotsMutex };
+
+				if (false == m_freeSlots.empty()) {
+					lv_index = m_freeSlots.back();
+					m_freeSlots.pop_back();
+				}
+			}
+
+			if (UINT32_MAX == lv_index) {
+				lv_index = m_size.fetch_add(1U, std::memory_order_acq_rel);
+
+				if (m_capacity <= lv_index) {
+					PRINT_EXIT("\nConcurrent slot array ran out of chunks.\n");
+				}
+			}
+
+			Chunk& lv_chunk = AcquireChunk(lv_index >> t_chunkSizeLog2);
+			const uint32_t lv_element = lv_index & m_chunkMask;
+
+			lv_chunk.m_values[lv_element] = l_value;
+
+			//Fresh slots start at generation 1 so that a default constructed handle is never valid.
+			//Only the thread that claimed the slot writes its generation here, IsValid() may read it at any time.
+			uint32_t lv_generation = lv_chunk.m_generations[lv_element].load(std::memory_order_acquire);
+
+			if (0U == lv_generation) {
+				lv_generation = 1U;
+				lv_chunk.m_generations[lv_element].store(lv_generation, std::memory_order_release);
+			}
+
+			return Slot{ .m_index = lv_index, .m_generation = lv_generation };
+		}
+
+		//Bumps the generation of the slot and hands it back to Push(). The caller keeps whatever it copied out.
+		void Release(uint32_t l_index)
+		{
+			Chunk& lv_chunk = GetChunk(l_index);
+			const uint32_t lv_element = l_index & m_chunkMask;
+
+			lv_chunk.m_values[lv_element] = T{};
+			lv_chunk.m_generations[lv_element].fetch_add(1U, std::memory_order_acq_rel);
+
+			std::lock_guard lv_lock{ m_freeSlotsMutex };
+			m_freeSlots.push_back(l_index);
+		}
+
+		bool IsValid(uint32_t l_index, uint32_t l_generation) const
+		{
+			if (GetSize() <= l_index) {
+				return false;
+			}
+
+			//The slot may be claimed by a Push() that has not published its chunk yet
+			const Chunk* lv_chunk = m_chunks[l_index >> t_chunkSizeLog2].load(std::memory_order_acquire);
+
+			return nullptr != lv_chunk &&
+				l_generation == lv_chunk->m_generations[l_index & m_chunkMask].load(std::memory_order_acquire);
+		}
+
+		uint32_t GetGeneration(uint32_t l_index) const
+		{
+			return GetChunk(l_index).m_generations[l_index & m_chunkMask].load(std::memory_order_acquire);
+		}
+
+		T& operator[](uint32_t l_index)
+		{
+			return GetChunk(l_index).m_values[l_index & m_chunkMask];
+		}
+
+		const T& operator[](uint32_t l_index) const
+		{
+			return GetChunk(l_index).m_values[l_index & m_chunkMask];
+		}
+
+		//Number of slots ever claimed, released ones included
+		uint32_t GetSize() const
+		{
+			return std::min(m_size.load(std::memory_order_acquire), m_capacity);
+		}
+
+	private:
+
+		static constexpr uint32_t m_chunkSize = 1U << t_chunkSizeLog2;
+		static constexpr uint32_t m_chunkMask = m_chunkSize - 1U;
+		static constexpr uint32_t m_capacity = m_chunkSize * t_maxNumChunks;
+
+		struct Chunk
+		{
+			std::array<T, m_chunkSize> m_values{};
+
+			//Atomic since IsValid() reads them while Release() bumps them from another thread
+			std::array<std::atomic<uint32_t>, m_chunkSize> m_generations{};
+		};
+
+		Chunk& AcquireChunk(uint32_t l_chunkIndex)
+		{
+			Chunk* lv_chunk = m_chunks[l_chunkIndex].load(std::memory_order_acquire);
+
+			if (nullptr != lv_chunk) {
+				return *lv_chunk;
+			}
+
+			//Several threads may race for the same chunk, the losers throw theirs away
+			auto lv_newChunk = std::make_unique<Chunk>();
+
+			if (true == m_chunks[l_chunkIndex].compare_exchange_strong(lv_chunk, lv_newChunk.get(),
+				std::memory_order_acq_rel, std::memory_order_acquire)) {
+				return *lv_newChunk.release();
+			}
+
+			return *lv_chunk;
+		}
+
+		Chunk& GetChunk(uint32_t l_index) const
+		{
+			return *m_chunks[l_index >> t_chunkSizeLog2].load(std::memory_order_acquire);
+		}
+
+
+		std::array<std::atomic<Chunk*>, t_maxNumChunks> m_chunks{};
+		std::atomic<uint32_t> m_size{ 0 };
+
+		std::mutex m_freeSlotsMutex{};
+		std::vector<uint32_t> m_freeSlots{};
+	};
+
+}
@@ -79,11 +79,7 @@ namespace RenderCore
 		
 		m_colorOutputTextures.resize(lv_totalNumSwapchains);
 
-		auto lv_depthMapLightMeta = lv_vkResManager.RetrieveGpuResourceMetaData("DepthMapPointLight");
-
-		assert(lv_depthMapLightMeta.m_resourceHandle != std::numeric_limits<uint32_t>::max());
-
-		m_depthMapLightGpuHandle = lv_depthMapLightMeta.m_resourceHandle;
+		m_depthMapLightGpuHandle = lv_vkResManager.RetrieveGpuTextureHandle("DepthMapPointLight");
 
 		for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
 			m_colorOutputTextures[i] = &lv_vkResManager.RetrieveGpuTexture("DeferredLightningColorTexture", i);
@@ -109,8 +105,8 @@ namespace RenderCore
 		lv_pipeInfo.m_totalNumColorAttach = lv_node->m_outputResourcesHandles.size();
 		
 
-		m_graphicsPipeline = lv_vkResManager.CreateGraphicsPipeline(m_renderPass, m_pipelineLayout
-			, {l_vtxShader, l_fragShader},"GraphicsPipelineDeferredLightning", lv_pipeInfo);
+		lv_vkResManager.RequestGraphicsPipeline(m_renderPass, m_pipelineLayout
+			, {l_vtxShader, l_fragShader},"GraphicsPipelineDeferredLightning", lv_pipeInfo, m_graphicsPipeline);
 	}
 
 
@@ -123,227 +119,41 @@ namespace RenderCore
 	void DeferredLightningRenderer::UpdateDescriptorSets()
 	{
 		auto& lv_vkResManager = m_vulkanRenderContext.GetResourceManager();
-		auto lv_totalNumSwapchains = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
-
-		std::array<VkDescriptorBufferInfo, 3> lv_bufferInfos{};
-		std::vector<VkDescriptorImageInfo> lv_imageInfos{};
-		lv_imageInfos.resize(lv_totalNumSwapchains * 9);
-
 
 		auto& lv_lightBufferGpu = lv_vkResManager.RetrieveGpuBuffer(m_lightBufferGpuHandle);
 		auto& lv_uniformBufferGpu = lv_vkResManager.RetrieveGpuBuffer(m_uniformBufferGpuHandle);
-		auto lv_uniformBufferSunMeta = lv_vkResManager.RetrieveGpuResourceMetaData("UniformBufferLightMatricesDepthMap");
-		auto* lv_uniformBufferSunGpu = &lv_vkResManager.RetrieveGpuBuffer(lv_uniformBufferSunMeta.m_resourceHandle);
-
-		lv_bufferInfos[0].buffer = lv_uniformBufferGpu.buffer;
-		lv_bufferInfos[0].offset = 0;
-		lv_bufferInfos[0].range = VK_WHOLE_SIZE;
-
-		lv_bufferInfos[1].buffer = lv_lightBufferGpu.buffer;
-		lv_bufferInfos[1].offset = 0;
-		lv_bufferInfos[1].range = VK_WHOLE_SIZE;
-
-		lv_bufferInfos[2].buffer = lv_uniformBufferSunGpu->buffer;
-		lv_bufferInfos[2].offset = 0;
-		lv_bufferInfos[2].range = VK_WHOLE_SIZE;
-
-
-		auto lv_depthMapLightCubeMeta = lv_vkResManager.RetrieveGpuResourceMetaData("DepthMapPointLight");
-		assert(std::numeric_limits<uint32_t>::max() != lv_depthMapLightCubeMeta.m_resourceHandle);
-		auto& lv_depthMapLightGpu = lv_vkResManager.RetrieveGpuTexture(lv_depthMapLightCubeMeta.m_resourceHandle);
-		for (size_t i = 0, j = 0; i < lv_imageInfos.size(); i+=9, ++j) {
-			
-			auto& lv_gbufferPosGpu = lv_vkResManager.RetrieveGpuTexture("GBufferPosition", j);
-			auto& lv_gbufferNormalGpu = lv_vkResManager.RetrieveGpuTexture("GBufferNormal", j);
-			auto& lv_gbufferAlbedoSpec = lv_vkResManager.RetrieveGpuTexture("GBufferAlbedoSpec", j);
-			auto& lv_gbufferTangent = lv_vkResManager.RetrieveGpuTexture("GBufferTangent", j);
-			auto& lv_gbufferNormalVertexGpu = lv_vkResManager.RetrieveGpuTexture("GBufferNormalVertex", j);
-			auto& lv_occlusionGpu = lv_vkResManager.RetrieveGpuTexture("BoxBlurTexture", j);
-			auto& lv_gbufferMetallicGpu = lv_vkResManager.RetrieveGpuTexture("GBufferMetallic", j);
-			auto& lv_depth = lv_vkResManager.RetrieveGpuTexture("Depth", j);
-
-			lv_imageInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i].imageView = lv_gbufferPosGpu.image.imageView0;
-			lv_imageInfos[i].sampler = lv_gbufferPosGpu.sampler;
-
-			lv_imageInfos[i + 1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 1].imageView = lv_gbufferNormalGpu.image.imageView0;
-			lv_imageInfos[i + 1].sampler = lv_gbufferNormalGpu.sampler;
-
-			lv_imageInfos[i + 2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 2].imageView = lv_gbufferAlbedoSpec.image.imageView0;
-			lv_imageInfos[i + 2].sampler = lv_gbufferAlbedoSpec.sampler;
-
-			lv_imageInfos[i + 3].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 3].imageView = lv_gbufferTangent.image.imageView0;
-			lv_imageInfos[i + 3].sampler = lv_gbufferTangent.sampler;
-
-			lv_imageInfos[i + 4].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 4].imageView = lv_gbufferNormalVertexGpu.image.imageView0;
-			lv_imageInfos[i + 4].sampler = lv_gbufferNormalVertexGpu.sampler;
-
-			lv_imageInfos[i + 5].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 5].imageView = lv_occlusionGpu.image.imageView0;
-			lv_imageInfos[i + 5].sampler = lv_occlusionGpu.sampler;
-
-			lv_imageInfos[i + 6].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 6].imageView = lv_gbufferMetallicGpu.image.imageView0;
-			lv_imageInfos[i + 6].sampler = lv_gbufferMetallicGpu.sampler;
-
-			lv_imageInfos[i + 7].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 7].imageView = lv_depthMapLightGpu.image.cubemapImageView;
-			lv_imageInfos[i + 7].sampler = lv_depthMapLightGpu.sampler;
-
-			lv_imageInfos[i + 8].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 8].imageView = lv_depth.image.imageView0;
-			lv_imageInfos[i + 8].sampler = lv_depth.sampler;
+		auto lv_uniformBufferSunHandle = lv_vkResManager.RetrieveGpuBufferHandle("UniformBufferLightMatricesDepthMap");
+		auto& lv_uniformBufferSunGpu = lv_vkResManager.RetrieveGpuBuffer(lv_uniformBufferSunHandle);
+		auto& lv_depthMapLightGpu = lv_vkResManager.RetrieveGpuTexture(m_depthMapLightGpuHandle);
 
-		}
+		const VkDescriptorBufferInfo lv_uniformBufferInfo{ lv_uniformBufferGpu.buffer, 0, VK_WHOLE_SIZE };
+		const VkDescriptorBufferInfo lv_lightBufferInfo{ lv_lightBufferGpu.buffer, 0, VK_WHOLE_SIZE };
+		const VkDescriptorBufferInfo lv_uniformBufferSunInfo{ lv_uniformBufferSunGpu.buffer, 0, VK_WHOLE_SIZE };
+
+		//Inputs of binding 2 to 8 in binding order, every swapchain image has its own copy of them
+		constexpr std::array<const char*, 7> lv_gbufferInputNames{ "GBufferPosition", "GBufferNormal", "GBufferAlbedoSpec",
+			"GBufferTangent", "GBufferNormalVertex", "BoxBlurTexture", "GBufferMetallic" };
+
+		for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
+
+			WriteBufferDescriptor(i, 0, lv_uniformBufferInfo);
+			WriteBufferDescriptor(i, 1, lv_lightBufferInfo);
+
+			for (uint32_t j = 0; j < (uint32_t)lv_gbufferInputNames.size(); ++j) {
+				auto& lv_inputGpu = lv_vkResManager.RetrieveGpuTexture(lv_gbufferInputNames[j], (uint32_t)i);
+				WriteImageDescriptor(i, 2 + j, { lv_inputGpu.sampler, lv_inputGpu.image.imageView0,
+					VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+			}
+
+			auto& lv_depth = lv_vkResManager.RetrieveGpuTexture("Depth", (uint32_t)i);
 
-		std::vector<VkWriteDescriptorSet> lv_writes;
-		lv_writes.resize(lv_totalNumSwapchains*lv_bufferInfos.size() + lv_imageInfos.size());
-
-
-		for (size_t i = 0, j = 0; i < lv_writes.size(); i += 12, ++j) {
-
-			lv_writes[i].descriptorCount = 1;
-			lv_writes[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER ;
-			lv_writes[i].dstArrayElement = 0;
-			lv_writes[i].dstBinding = 0;
-			lv_writes[i].dstSet = m_descriptorSets[j];
-			lv_writes[i].pBufferInfo = &lv_bufferInfos[0];
-			lv_writes[i].pImageInfo = nullptr;
-			lv_writes[i].pNext = nullptr;
-			lv_writes[i].pTexelBufferView = nullptr;
-			lv_writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i+1].descriptorCount = 1;
-			lv_writes[i+1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-			lv_writes[i+1].dstArrayElement = 0;
-			lv_writes[i+1].dstBinding = 1;
-			lv_writes[i+1].dstSet = m_descriptorSets[j];
-			lv_writes[i+1].pBufferInfo = &lv_bufferInfos[1];
-			lv_writes[i+1].pImageInfo = nullptr;
-			lv_writes[i+1].pNext = nullptr;
-			lv_writes[i+1].pTexelBufferView = nullptr;
-			lv_writes[i+1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-
-
-			lv_writes[i+2].descriptorCount = 1;
-			lv_writes[i+2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i+2].dstArrayElement = 0;
-			lv_writes[i+2].dstBinding = 2;
-			lv_writes[i+2].dstSet = m_descriptorSets[j];
-			lv_writes[i+2].pBufferInfo = nullptr;
-			lv_writes[i+2].pImageInfo = &lv_imageInfos[9*j];
-			lv_writes[i+2].pNext = nullptr;
-			lv_writes[i+2].pTexelBufferView = nullptr;
-			lv_writes[i+2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 3].descriptorCount = 1;
-			lv_writes[i + 3].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 3].dstArrayElement = 0;
-			lv_writes[i + 3].dstBinding = 3;
-			lv_writes[i + 3].dstSet = m_descriptorSets[j];
-			lv_writes[i + 3].pBufferInfo = nullptr;
-			lv_writes[i + 3].pImageInfo = &lv_imageInfos[9 * j + 1];
-			lv_writes[i + 3].pNext = nullptr;
-			lv_writes[i + 3].pTexelBufferView = nullptr;
-			lv_writes[i + 3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 4].descriptorCount = 1;
-			lv_writes[i + 4].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 4].dstArrayElement = 0;
-			lv_writes[i + 4].dstBinding = 4;
-			lv_writes[i + 4].dstSet = m_descriptorSets[j];
-			lv_writes[i + 4].pBufferInfo = nullptr;
-			lv_writes[i + 4].pImageInfo = &lv_imageInfos[9 * j + 2];
-			lv_writes[i + 4].pNext = nullptr;
-			lv_writes[i + 4].pTexelBufferView = nullptr;
-			lv_writes[i + 4].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 5].descriptorCount = 1;
-			lv_writes[i + 5].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 5].dstArrayElement = 0;
-			lv_writes[i + 5].dstBinding = 5;
-			lv_writes[i + 5].dstSet = m_descriptorSets[j];
-			lv_writes[i + 5].pBufferInfo = nullptr;
-			lv_writes[i + 5].pImageInfo = &lv_imageInfos[9 * j + 3];
-			lv_writes[i + 5].pNext = nullptr;
-			lv_writes[i + 5].pTexelBufferView = nullptr;
-			lv_writes[i + 5].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 6].descriptorCount = 1;
-			lv_writes[i + 6].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 6].dstArrayElement = 0;
-			lv_writes[i + 6].dstBinding = 6;
-			lv_writes[i + 6].dstSet = m_descriptorSets[j];
-			lv_writes[i + 6].pBufferInfo = nullptr;
-			lv_writes[i + 6].pImageInfo = &lv_imageInfos[9 * j + 4];
-			lv_writes[i + 6].pNext = nullptr;
-			lv_writes[i + 6].pTexelBufferView = nullptr;
-			lv_writes[i + 6].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 7].descriptorCount = 1;
-			lv_writes[i + 7].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 7].dstArrayElement = 0;
-			lv_writes[i + 7].dstBinding = 7;
-			lv_writes[i + 7].dstSet = m_descriptorSets[j];
-			lv_writes[i + 7].pBufferInfo = nullptr;
-			lv_writes[i + 7].pImageInfo = &lv_imageInfos[9 * j + 5];
-			lv_writes[i + 7].pNext = nullptr;
-			lv_writes[i + 7].pTexelBufferView = nullptr;
-			lv_writes[i + 7].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 8].descriptorCount = 1;
-			lv_writes[i + 8].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 8].dstArrayElement = 0;
-			lv_writes[i + 8].dstBinding = 8;
-			lv_writes[i + 8].dstSet = m_descriptorSets[j];
-			lv_writes[i + 8].pBufferInfo = nullptr;
-			lv_writes[i + 8].pImageInfo = &lv_imageInfos[9 * j + 6];
-			lv_writes[i + 8].pNext = nullptr;
-			lv_writes[i + 8].pTexelBufferView = nullptr;
-			lv_writes[i + 8].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 9].descriptorCount = 1;
-			lv_writes[i + 9].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 9].dstArrayElement = 0;
-			lv_writes[i + 9].dstBinding = 9;
-			lv_writes[i + 9].dstSet = m_descriptorSets[j];
-			lv_writes[i + 9].pBufferInfo = nullptr;
-			lv_writes[i + 9].pImageInfo = &lv_imageInfos[9 * j + 7];
-			lv_writes[i + 9].pNext = nullptr;
-			lv_writes[i + 9].pTexelBufferView = nullptr;
-			lv_writes[i + 9].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-
-			lv_writes[i + 10].descriptorCount = 1;
-			lv_writes[i + 10].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			lv_writes[i + 10].dstArrayElement = 0;
-			lv_writes[i + 10].dstBinding = 10;
-			lv_writes[i + 10].dstSet = m_descriptorSets[j];
-			lv_writes[i + 10].pBufferInfo = &lv_bufferInfos[2];
-			lv_writes[i + 10].pImageInfo = nullptr;
-			lv_writes[i + 10].pNext = nullptr;
-			lv_writes[i + 10].pTexelBufferView = nullptr;
-			lv_writes[i + 10].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 11].descriptorCount = 1;
-			lv_writes[i + 11].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 11].dstArrayElement = 0;
-			lv_writes[i + 11].dstBinding = 11;
-			lv_writes[i + 11].dstSet = m_descriptorSets[j];
-			lv_writes[i + 11].pBufferInfo = nullptr;
-			lv_writes[i + 11].pImageInfo = &lv_imageInfos[9 * j + 8];
-			lv_writes[i + 11].pNext = nullptr;
-			lv_writes[i + 11].pTexelBufferView = nullptr;
-			lv_writes[i + 11].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			WriteImageDescriptor(i, 9, { lv_depthMapLightGpu.sampler, lv_depthMapLightGpu.image.cubemapImageView,
+				VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+			WriteBufferDescriptor(i, 10, lv_uniformBufferSunInfo);
+			WriteImageDescriptor(i, 11, { lv_depth.sampler, lv_depth.image.imageView0, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
 		}
 
-		vkUpdateDescriptorSets(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device
-			, lv_writes.size(), lv_writes.data(), 0, nullptr);
+		FlushDescriptorWrites();
 	}
 
 
@@ -368,14 +178,7 @@ namespace RenderCore
 	{
 		auto& lv_vkResManager = m_vulkanRenderContext.GetResourceManager();
 
-		auto& lv_gbufferTangentGpu = lv_vkResManager.RetrieveGpuTexture("GBufferTangent", l_currentSwapchainIndex);
-		auto& lv_gbufferPosGpu = lv_vkResManager.RetrieveGpuTexture("GBufferPosition", l_currentSwapchainIndex);
-		auto& lv_gbufferNormalGpu = lv_vkResManager.RetrieveGpuTexture("GBufferNormal", l_currentSwapchainIndex);
-		auto& lv_gbufferAlbedoSpecGpu = lv_vkResManager.RetrieveGpuTexture("GBufferAlbedoSpec", l_currentSwapchainIndex);
-		auto& lv_gbufferNormalVertexGpu = lv_vkResManager.RetrieveGpuTexture("GBufferNormalVertex", l_currentSwapchainIndex);
 		auto lv_framebuffer = lv_vkResManager.RetrieveGpuFramebuffer(m_framebufferHandles[l_currentSwapchainIndex]);
-		auto& lv_depth = lv_vkResManager.RetrieveGpuTexture("Depth", l_currentSwapchainIndex);
-		auto& lv_metallicGpu = lv_vkResManager.RetrieveGpuTexture("GBufferMetallic", l_currentSwapchainIndex);
 
 		
 
@@ -72,11 +72,11 @@ namespace RenderCore
 
 	private:
 
-		uint32_t m_uniformBufferGpuHandle;
-		uint32_t m_lightBufferGpuHandle;
-		uint32_t m_vertexBufferGpuHandle;
-		uint32_t m_indicesBufferGpuHandle;
-		uint32_t m_depthMapLightGpuHandle;
+		BufferHandle m_uniformBufferGpuHandle;
+		BufferHandle m_lightBufferGpuHandle;
+		BufferHandle m_vertexBufferGpuHandle;
+		BufferHandle m_indicesBufferGpuHandle;
+		TextureHandle m_depthMapLightGpuHandle;
 		std::vector<VulkanTexture*> m_colorOutputTextures;
 		float m_lightIntensity{ 12000.f };
 	};
@@ -25,6 +25,7 @@ namespace RenderCore
 		auto lv_totalNumSwapchains = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
 		auto& lv_frameGraph = m_vulkanRenderContext.GetFrameGraph();
 		auto* lv_indirectRenderer = (IndirectRenderer*)lv_frameGraph.RetrieveNode("IndirectGbuffer")->m_renderer;
+		m_indirectRenderer = lv_indirectRenderer;
 
 
 		//float lv_aspect = (float)m_vulkanRenderContext.GetContextCreator().m_vkDev.m_framebufferWidth / (float)m_vulkanRenderContext.GetContextCreator().m_vkDev.m_framebufferHeight;
@@ -47,9 +48,9 @@ namespace RenderCore
 																		 , "UniformBufferLightMatricesDepthMap");
 
 
-		auto lv_depthMapMeta = lv_vkResManager.RetrieveGpuResourceMetaData("DepthMapPointLight");
+		auto lv_depthMapHandle = lv_vkResManager.RetrieveGpuTextureHandle("DepthMapPointLight");
 
-		m_depthMapGpuTextures.push_back(&lv_vkResManager.RetrieveGpuTexture(lv_depthMapMeta.m_resourceHandle));
+		m_depthMapGpuTextures.push_back(&lv_vkResManager.RetrieveGpuTexture(lv_depthMapHandle));
 		m_instanceBuffersGpu.resize(lv_totalNumSwapchains);
 		for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
 			m_instanceBuffersGpu[i] = &lv_vkResManager.RetrieveGpuBuffer("Instance-Buffer-Indirect", i);
@@ -58,29 +59,19 @@ namespace RenderCore
 
 
 		auto& lv_outputInstanceData = lv_indirectRenderer->GetInstanceData();
-		auto& lv_meshes = lv_indirectRenderer->GetMeshData();
 
 		auto lv_indirectBufferMeta = lv_vkResManager.RetrieveGpuResourceMetaData("indirectBufferDepthMapLight");
 
 		bool lv_indirectBufferCreatedBefore = (lv_indirectBufferMeta.m_resourceHandle != std::numeric_limits<uint32_t>::max());
 
-		m_indirectBufferGpuHandle = true == lv_indirectBufferCreatedBefore ? lv_indirectBufferMeta.m_resourceHandle
+		m_indirectBufferGpuHandle = true == lv_indirectBufferCreatedBefore ? lv_vkResManager.RetrieveGpuBufferHandle("indirectBufferDepthMapLight")
 									: lv_vkResManager.CreateBufferWithHandle(sizeof(VkDrawIndirectCommand) * lv_outputInstanceData.size()
 										, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
 										, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
 										, "indirectBufferDepthMapLight");
 
 		if (false == lv_indirectBufferCreatedBefore) {
-			auto& lv_indirectBuffer = lv_vkResManager.RetrieveGpuBuffer(m_indirectBufferGpuHandle);
-			VkDrawIndirectCommand* lv_drawStructure = (VkDrawIndirectCommand*)lv_indirectBuffer.ptr;
-			for (uint32_t i = 0; i < lv_outputInstanceData.size(); ++i) {
-				auto j = lv_outputInstanceData[i].m_meshIndex;
-				lv_drawStructure[i].vertexCount = lv_meshes[j].CalculateLODNumberOfIndices(lv_outputInstanceData[i].m_lod);
-				lv_drawStructure[i].firstInstance = i;
-				lv_drawStructure[i].firstVertex = 0U;
-				lv_drawStructure[i].instanceCount = 1;
-
-			}
+			UpdateIndirectBuffer();
 		}
 
 
@@ -89,10 +80,8 @@ namespace RenderCore
 		memcpy(lv_uniformBufferGpu.ptr, &m_uniformBufferCpu, sizeof(UniformBufferLight));
 
 
-		auto lv_indicesVerticesMetaData = lv_vkResManager.RetrieveGpuResourceMetaData(" Vertex-Buffer-Indirect ");
-
-		assert(std::numeric_limits<float>::max() != lv_indicesVerticesMetaData.m_resourceHandle);
-		m_indicesVerticesGpuBufferHandle = lv_indicesVerticesMetaData.m_resourceHandle;
+		m_verticesGpuBufferHandle = lv_vkResManager.GetGeometryHeap().GetVertexBufferHandle();
+		m_indicesGpuBufferHandle = lv_vkResManager.GetGeometryHeap().GetIndexBufferHandle();
 
 		GeneratePipelineFromSpirvBinaries(l_spvFile);
 		SetRenderPassAndFrameBuffer(l_rendererName);
@@ -100,6 +89,7 @@ namespace RenderCore
 		UpdateDescriptorSets();
 
 		auto* lv_node = lv_frameGraph.RetrieveNode(l_rendererName);
+		m_frameGraphNode = lv_node;
 		lv_frameGraph.IncrementNumNodesPerCmdBuffer(1);
 
 		VulkanResourceManager::PipelineInfo lv_pipeInfo{};
@@ -111,20 +101,18 @@ namespace RenderCore
 		lv_pipeInfo.m_useBlending = false;
 		lv_pipeInfo.m_useDepth = true;
 		lv_pipeInfo.m_totalNumColorAttach = lv_node->m_outputResourcesHandles.size()-1;
+		lv_pipeInfo.m_specializationConstants = m_indirectRenderer->GetVertexFormatConstants();
 
 		std::string lv_pipelineName{ "GraphicsPipeline" };
 		lv_pipelineName += l_rendererName;
-		m_graphicsPipeline = lv_vkResManager.CreateGraphicsPipeline(m_renderPass, m_pipelineLayout
-			, { l_vtxShader, l_fragShader }, lv_pipelineName.c_str(), lv_pipeInfo);
+		lv_vkResManager.RequestGraphicsPipeline(m_renderPass, m_pipelineLayout
+			, { l_vtxShader, l_fragShader }, lv_pipelineName.c_str(), lv_pipeInfo, m_graphicsPipeline);
 	}
 
 	void DepthMapLightRenderer::FillCommandBuffer(VkCommandBuffer l_cmdBuffer,
 		uint32_t l_currentSwapchainIndex)
 	{
 		auto& lv_vkResManager = m_vulkanRenderContext.GetResourceManager();
-		auto& lv_frameGraph = m_vulkanRenderContext.GetFrameGraph();
-
-		auto* lv_currentNode = lv_frameGraph.RetrieveNode(m_rendererName);
 
 
 		auto* lv_currDepthMapTex = m_depthMapGpuTextures[0];
@@ -177,9 +165,10 @@ namespace RenderCore
 
 
 
+		UpdateIndirectBuffer();
+
 		auto& lv_indirectBuffer = lv_vkResManager.RetrieveGpuBuffer(m_indirectBufferGpuHandle);
-		auto* lv_indirectRenderer = (IndirectRenderer*)lv_frameGraph.RetrieveNode("IndirectGbuffer")->m_renderer;
-		auto lv_totalNumInstances = lv_indirectRenderer->GetInstanceData().size();
+		auto lv_totalNumInstances = m_indirectRenderer->GetInstanceData().size();
 
 
 		
@@ -215,7 +204,7 @@ namespace RenderCore
 
 		}
 
-		lv_currentNode->m_enabled = false;
+		m_frameGraphNode->m_enabled = false;
 
 	}
 
@@ -256,89 +245,43 @@ namespace RenderCore
 	}
 
 
-	void DepthMapLightRenderer::UpdateDescriptorSets()
+	void DepthMapLightRenderer::UpdateIndirectBuffer()
 	{
-		auto& lv_vkResManager = m_vulkanRenderContext.GetResourceManager();
-		auto lv_totalNumSwapchains = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
-		auto& lv_frameGraph = m_vulkanRenderContext.GetFrameGraph();
-		auto* lv_indirectRenderer = (IndirectRenderer*)lv_frameGraph.RetrieveNode("IndirectGbuffer")->m_renderer;
-
-		auto lv_vertexBufferSize = lv_indirectRenderer->GetVertexBufferSize();
-
-		std::vector<VkDescriptorBufferInfo> lv_bufferInfo;
-		lv_bufferInfo.resize(lv_totalNumSwapchains*(4));
-
-		for (size_t i = 0, j = 0; i < lv_bufferInfo.size(); i += 4, ++j) {
-
-			lv_bufferInfo[i].buffer = lv_vkResManager.RetrieveGpuBuffer(m_uniformBufferGpuHandle).buffer;
-			lv_bufferInfo[i].offset = 0;
-			lv_bufferInfo[i].range = VK_WHOLE_SIZE;
+		auto& lv_outputInstanceData = m_indirectRenderer->GetInstanceData();
+		auto& lv_meshes = m_indirectRenderer->GetMeshData();
+
+		auto& lv_indirectBuffer = m_vulkanRenderContext.GetResourceManager().RetrieveGpuBuffer(m_indirectBufferGpuHandle);
+		VkDrawIndirectCommand* lv_drawStructure = (VkDrawIndirectCommand*)lv_indirectBuffer.ptr;
+		for (uint32_t i = 0; i < lv_outputInstanceData.size(); ++i) {
+			auto j = lv_outputInstanceData[i].m_meshIndex;
+			lv_drawStructure[i].vertexCount = lv_meshes[j].CalculateLODNumberOfIndices(lv_outputInstanceData[i].m_lod);
+			lv_drawStructure[i].firstInstance = i;
+			lv_drawStructure[i].firstVertex = 0U;
+			lv_drawStructure[i].instanceCount = 1;
+		}
+	}
 
-			lv_bufferInfo[i + 1].buffer = lv_vkResManager.RetrieveGpuBuffer(m_indicesVerticesGpuBufferHandle).buffer;
-			lv_bufferInfo[i + 1].offset = 0;
-			lv_bufferInfo[i + 1].range = lv_vertexBufferSize;
 
-			lv_bufferInfo[i + 2].buffer = lv_vkResManager.RetrieveGpuBuffer(m_indicesVerticesGpuBufferHandle).buffer;
-			lv_bufferInfo[i + 2].offset = lv_vertexBufferSize;
-			lv_bufferInfo[i + 2].range = lv_vkResManager.RetrieveGpuBuffer(m_indicesVerticesGpuBufferHandle).size - lv_vertexBufferSize;
+	void DepthMapLightRenderer::UpdateDescriptorSets()
+	{
+		auto& lv_vkResManager = m_vulkanRenderContext.GetResourceManager();
 
-			lv_bufferInfo[i + 3].buffer = m_instanceBuffersGpu[j]->buffer;
-			lv_bufferInfo[i + 3].offset = 0;
-			lv_bufferInfo[i + 3].range = VK_WHOLE_SIZE;
+		const VkDescriptorBufferInfo lv_uniformBufferInfo{ lv_vkResManager.RetrieveGpuBuffer(m_uniformBufferGpuHandle).buffer,
+			0, VK_WHOLE_SIZE };
+		const VkDescriptorBufferInfo lv_verticesBufferInfo{ lv_vkResManager.RetrieveGpuBuffer(m_verticesGpuBufferHandle).buffer,
+			0, VK_WHOLE_SIZE };
+		const VkDescriptorBufferInfo lv_indicesBufferInfo{ lv_vkResManager.RetrieveGpuBuffer(m_indicesGpuBufferHandle).buffer,
+			0, VK_WHOLE_SIZE };
 
-		}
+		for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
 
-		std::vector<VkWriteDescriptorSet> lv_writes{};
-		lv_writes.resize(4 * lv_totalNumSwapchains);
-
-		for (size_t i = 0, j = 0; i < lv_writes.size(); i += 4, ++j) {
-
-			lv_writes[i].descriptorCount = 1;
-			lv_writes[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			lv_writes[i].dstArrayElement = 0;
-			lv_writes[i].dstBinding = 0;
-			lv_writes[i].dstSet = m_descriptorSets[j];
-			lv_writes[i].pBufferInfo = &lv_bufferInfo[i];
-			lv_writes[i].pImageInfo = nullptr;
-			lv_writes[i].pNext = nullptr;
-			lv_writes[i].pTexelBufferView = nullptr;
-			lv_writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 1].descriptorCount = 1;
-			lv_writes[i + 1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-			lv_writes[i + 1].dstArrayElement = 0;
-			lv_writes[i + 1].dstBinding = 1;
-			lv_writes[i + 1].dstSet = m_descriptorSets[j];
-			lv_writes[i + 1].pBufferInfo = &lv_bufferInfo[i + 1];
-			lv_writes[i + 1].pImageInfo = nullptr;
-			lv_writes[i + 1].pNext = nullptr;
-			lv_writes[i + 1].pTexelBufferView = nullptr;
-			lv_writes[i + 1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 2].descriptorCount = 1;
-			lv_writes[i + 2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-			lv_writes[i + 2].dstArrayElement = 0;
-			lv_writes[i + 2].dstBinding = 2;
-			lv_writes[i + 2].dstSet = m_descriptorSets[j];
-			lv_writes[i + 2].pBufferInfo = &lv_bufferInfo[i + 2];
-			lv_writes[i + 2].pImageInfo = nullptr;
-			lv_writes[i + 2].pNext = nullptr;
-			lv_writes[i + 2].pTexelBufferView = nullptr;
-			lv_writes[i + 2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 3].descriptorCount = 1;
-			lv_writes[i + 3].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-			lv_writes[i + 3].dstArrayElement = 0;
-			lv_writes[i + 3].dstBinding = 3;
-			lv_writes[i + 3].dstSet = m_descriptorSets[j];
-			lv_writes[i + 3].pBufferInfo = &lv_bufferInfo[i + 3];
-			lv_writes[i + 3].pImageInfo = nullptr;
-			lv_writes[i + 3].pNext = nullptr;
-			lv_writes[i + 3].pTexelBufferView = nullptr;
-			lv_writes[i + 3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			WriteBufferDescriptor(i, 0, lv_uniformBufferInfo);
+			WriteBufferDescriptor(i, 1, lv_verticesBufferInfo);
+			WriteBufferDescriptor(i, 2, lv_indicesBufferInfo);
+			WriteBufferDescriptor(i, 3, { m_instanceBuffersGpu[i]->buffer, 0, VK_WHOLE_SIZE });
 		}
 
-		vkUpdateDescriptorSets(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device, lv_writes.size(), lv_writes.data(), 0, nullptr);
+		FlushDescriptorWrites();
 	}
 
 }
\ No newline at end of file
@@ -9,6 +9,8 @@
 
 namespace RenderCore
 {
+	class IndirectRenderer;
+
 	class DepthMapLightRenderer : public Renderbase
 	{
 		struct UniformBufferLight
@@ -37,13 +39,20 @@ namespace RenderCore
 
 
 	private:
+
+		//Index counts have to follow the LOD the camera picked for every instance, the instance buffer is shared
+		void UpdateIndirectBuffer();
+
 		UniformBufferLight m_uniformBufferCpu;
-		uint32_t m_uniformBufferGpuHandle;
+		BufferHandle m_uniformBufferGpuHandle;
 		std::vector<VulkanTexture*> m_depthMapGpuTextures;
-		uint32_t m_indicesVerticesGpuBufferHandle;
+		BufferHandle m_verticesGpuBufferHandle;
+		BufferHandle m_indicesGpuBufferHandle;
 		std::vector<VulkanBuffer*> m_instanceBuffersGpu;
-		uint32_t m_indirectBufferGpuHandle;
+		BufferHandle m_indirectBufferGpuHandle;
 		std::string m_rendererName{};
+		VulkanEngine::FrameGraphNode* m_frameGraphNode{};
+		IndirectRenderer* m_indirectRenderer{};
 		int m_cubemapFace{ -1 };
 	};
 }
\ No newline at end of file
@@ -55,7 +55,7 @@ namespace RenderCore
 		const uint32_t m_totalNumMipLevels{6};
 		const uint32_t m_mipLevelToRenderTo;
 		
-		VulkanBuffer* m_uniformBufferGpu;
+		UniformBuffer m_uniformCpu{};
 
 	};
 }
\ No newline at end of file
@@ -66,6 +66,7 @@ namespace VulkanEngine
                 FrameGraphNode& lv_node = m_nodes[i];
                 lv_node.m_nodeNames = lv_document["RenderPasses"][i]["Name"].GetString();
                 lv_node.m_nodeIndex = (uint32_t)i;
+                m_nodeNamesToHandles.emplace(lv_node.m_nodeNames, (uint32_t)i);
             }
 
 
@@ -93,40 +94,38 @@ namespace VulkanEngine
 
                     lv_node.m_cubemapFace = lv_renderPass["CubemapFace"].GetInt();
 
+                    if (true == lv_renderPass.HasMember("SpecializationConstants")) {
+
+                        for (auto& l_constant : lv_renderPass["SpecializationConstants"].GetArray()) {
+
+                            const uint32_t lv_constantID = l_constant["ConstantID"].GetUint();
+                            auto& lv_value = l_constant["Value"];
+
+                            if (true == lv_value.IsBool()) {
+                                lv_node.m_specializationConstants.Set(lv_constantID, lv_value.GetBool());
+                            }
+                            else if (true == lv_value.IsUint()) {
+                                lv_node.m_specializationConstants.Set(lv_constantID, lv_value.GetUint());
+                            }
+                            else if (true == lv_value.IsInt()) {
+                                lv_node.m_specializationConstants.Set(lv_constantID, (int32_t)lv_value.GetInt());
+                            }
+                            else {
+                                lv_node.m_specializationConstants.Set(lv_constantID, lv_value.GetFloat());
+                            }
+                        }
+                    }
+
                     for (size_t j = 0; j < lv_renderPass["Output"].Size(); ++j, ++lv_resourceIndex) {
 
                         lv_node.m_outputResourcesHandles[j] = lv_resourceIndex;
 
                         FrameGraphResource lv_outputResource;
-                        FrameGraphResourceInfo lv_outputInfo;
                         auto& lv_outputResources = lv_renderPass["Output"][j];
 
                         lv_outputResource.m_resourceName = lv_outputResources["Name"].GetString();
-                        
-                        const char* lv_createOnGPUString = lv_outputResources["CreateResourceOnGPU"].GetString();
-
-                        if (strcmp(lv_createOnGPUString, "FALSE") == 0) {
-                            lv_outputInfo.m_createOnGPU = false;
-                        }
-                        else {
-                            lv_outputInfo.m_createOnGPU = true;
-                        }
-
                         lv_outputResource.m_nodeThatOwnsThisResourceHandle = i;
-
-                        lv_outputInfo.m_storeOp = StringToStoreOp(lv_outputResources["TextureInfo"][0]["StoreOp"].GetString());
-                        lv_outputInfo.m_imageLayout = StringToVkImageLayout(lv_outputResources["TextureInfo"][0]["ImageLayout"].GetString());
-
-
-                        if (lv_outputInfo.m_createOnGPU == true) {
-                            lv_outputInfo.m_depth = lv_outputResources["TextureInfo"][0]["Resolution"][2].GetUint();
-                            lv_outputInfo.m_height = lv_outputResources["TextureInfo"][0]["Resolution"][1].GetUint();
-                            lv_outputInfo.m_width = lv_outputResources["TextureInfo"][0]["Resolution"][0].GetUint();
-                            lv_outputInfo.m_format = StringToVkFormat(lv_outputResources["TextureInfo"][0]["Format"].GetString());
-                        }
-                        
-
-                        lv_outputResource.m_Info = lv_outputInfo;
+                        lv_outputResource.m_Info = ParseFrameGraphOutputInfo(lv_outputResources);
 
                         m_frameGraphResources.push_back(lv_outputResource);
                         m_frameGraphResourcesHandles.push_back(lv_resourceIndex);
@@ -138,48 +137,27 @@ namespace VulkanEngine
                         lv_node.m_inputResourcesHandles[j] = lv_resourceIndex;
 
                         FrameGraphResource lv_inputResource;
-                        FrameGraphResourceInfo lv_inputInfo;
                         auto& lv_inputResources = lv_renderPass["Input"][j];
 
                         lv_inputResource.m_resourceName = lv_inputResources["Name"].GetString();
-
-                        const char* lv_createOnGPUString = lv_inputResources["CreateResourceOnGPU"].GetString();
-
-                        if (strcmp(lv_createOnGPUString, "FALSE") == 0) {
-                            lv_inputInfo.m_createOnGPU = false;
-                        }
-                        else {
-                            lv_inputInfo.m_createOnGPU = true;
-                        }
-
-
-                        if (true == lv_inputResources["TextureInfo"][0].HasMember("MipLevel")) {
-                            lv_inputInfo.m_mipLevels = (uint32_t)lv_inputResources["TextureInfo"][0]["MipLevel"].GetInt();
-                        }
-
-                        if (true == lv_inputResources["TextureInfo"][0].HasMember("SamplerMode")) {
-                            lv_inputInfo.m_addressMode = StringToVkSamplerAddressMode(lv_inputResources["TextureInfo"][0]["SamplerMode"].GetString());
-                        }
-
-
                         lv_inputResource.m_nodeThatOwnsThisResourceHandle = i;
+                        lv_inputResource.m_Info = ParseFrameGraphInputInfo(lv_inputResources);
 
-                        lv_inputInfo.m_loadOp = StringToLoadOp(lv_inputResources["TextureInfo"][0]["LoadOp"].GetString());
-                        lv_inputInfo.m_imageLayout = StringToVkImageLayout(lv_inputResources["TextureInfo"][0]["ImageLayout"].GetString());
-
+                        m_frameGraphResources.push_back(lv_inputResource);
+                        m_frameGraphResourcesHandles.push_back(lv_resourceIndex);
+                    }
 
-                        if (lv_inputInfo.m_createOnGPU == true) {
-                            lv_inputInfo.m_depth = lv_inputResources["TextureInfo"][0]["Resolution"][2].GetUint();
-                            lv_inputInfo.m_height = lv_inputResources["TextureInfo"][0]["Resolution"][1].GetUint();
-                            lv_inputInfo.m_width = lv_inputResources["TextureInfo"][0]["Resolution"][0].GetUint();
-                            lv_inputInfo.m_format = StringToVkFormat(lv_inputResources["TextureInfo"][0]["Format"].GetString());
-                        }
 
+                    for (auto l_inputResourceHandle : lv_node.m_inputResourcesHandles) {
 
-                        lv_inputResource.m_Info = lv_inputInfo;
+                        auto& lv_inputResource = m_frameGraphResources[l_inputResourceHandle];
 
-                        m_frameGraphResources.push_back(lv_inputResource);
-                        m_frameGraphResourcesHandles.push_back(lv_resourceIndex);
+                        for (auto l_outputResourceHandle : lv_node.m_outputResourcesHandles) {
+                            if (m_frameGraphResources[l_outputResourceHandle].m_resourceName == lv_inputResource.m_resourceName) {
+                                lv_inputResource.m_correspondingOutputResourceHandle = l_outputResourceHandle;
+                                break;
+                            }
+                        }
                     }
 
 
@@ -268,13 +246,13 @@ namespace VulkanEngine
 
     FrameGraphNode* FrameGraph::RetrieveNode(const std::string& l_nodeName)
     {
-        for (auto& l_node : m_nodes) {
-            if (l_nodeName == l_node.m_nodeNames) {
-                return &l_node;
-            }
+        auto lv_iterator = m_nodeNamesToHandles.find(l_nodeName);
+
+        if (m_nodeNamesToHandles.end() == lv_iterator) {
+            return nullptr;
         }
 
-        return nullptr;
+        return &m_nodes[lv_iterator->second];
     }
 
 
@@ -295,7 +273,7 @@ namespace VulkanEngine
                 for (size_t i = 0; i < lv_node.m_inputResourcesHandles.size(); ++i) {
                     auto& lv_inputResource = m_frameGraphResources[lv_node.m_inputResourcesHandles[i]];
 
-                    if (lv_inputResource.m_resourceName.substr(0, 5) == "Depth") {
+                    if (true == IsFrameGraphDepthResource(lv_inputResource.m_resourceName)) {
                         lv_depthResourceHandle.emplace(i);
                         break;
                     }
@@ -312,22 +290,14 @@ namespace VulkanEngine
 
                 std::vector<VkAttachmentDescription> lv_attachmentDescriptions;
                 std::vector<VkAttachmentReference> lv_attachmentReferences;
-                std::vector<const char*> lv_attachmentNames;
                 std::vector<uint8_t> lv_attachmentBits;
-                std::vector<uint32_t> lv_framebufferTexturesHandles;
 
                 for (auto l_inputResourceHandle : lv_node.m_inputResourcesHandles) {
 
                     auto& lv_inputResource = m_frameGraphResources[l_inputResourceHandle];
                     FrameGraphResource lv_correspondingOutputResource;
-                    for (auto l_outputResourceHandle : lv_node.m_outputResourcesHandles) {
-
-                        auto& lv_outputResource = m_frameGraphResources[l_outputResourceHandle];
-
-                        if (strcmp(lv_outputResource.m_resourceName.c_str(), lv_inputResource.m_resourceName.c_str()) == 0) {
-                            lv_correspondingOutputResource = lv_outputResource;
-                            break;
-                        }
+                    if (UINT32_MAX != lv_inputResource.m_correspondingOutputResourceHandle) {
+                        lv_correspondingOutputResource = m_frameGraphResources[lv_inputResource.m_correspondingOutputResourceHandle];
                     }
                     bool lv_depthTestName = (lv_inputResource.m_resourceName == "Depth");
                     bool lv_swapchainTestName = (lv_inputResource.m_resourceName == "Swapchain");
@@ -335,16 +305,13 @@ namespace VulkanEngine
                     VulkanTexture lv_depth, lv_swapchain, lv_depthMapPointLight;
 
                     if (lv_depthTestName == true) {
-                        auto lv_depthMeta = lv_vkResManager.RetrieveGpuResourceMetaData("Depth 0");
-                        lv_depth = lv_vkResManager.RetrieveGpuTexture(lv_depthMeta.m_resourceHandle);
+                        lv_depth = lv_vkResManager.RetrieveGpuTexture("Depth", 0);
                     }
                     if (lv_swapchainTestName == true) {
-                        auto lv_swapchainMeta = lv_vkResManager.RetrieveGpuResourceMetaData("Swapchain 0");
-                        lv_swapchain = lv_vkResManager.RetrieveGpuTexture(lv_swapchainMeta.m_resourceHandle);
+                        lv_swapchain = lv_vkResManager.RetrieveGpuTexture("Swapchain", 0);
                     }
                     if (lv_depthMapPointLightTestName == true) {
-                        auto lv_depthMapPointMeta = lv_vkResManager.RetrieveGpuResourceMetaData("DepthMapPointLight");
-                        lv_depthMapPointLight = lv_vkResManager.RetrieveGpuTexture(lv_depthMapPointMeta.m_resourceHandle);
+                        lv_depthMapPointLight = lv_vkResManager.RetrieveGpuTexture(lv_vkResManager.RetrieveGpuTextureHandle("DepthMapPointLight"));
 
                         lv_inputResource.m_Info.m_format = lv_depthMapPointLight.format;
                         lv_inputResource.m_Info.m_depth = lv_depthMapPointLight.depth;
@@ -363,7 +330,7 @@ namespace VulkanEngine
                             lv_inputRes = &lv_vkResManager.RetrieveGpuTexture(lv_inputResource.m_resourceName, 0);
                         }
                         else {
-                            lv_inputRes = &lv_vkResManager.RetrieveGpuTexture(lv_inputResMeta.m_resourceHandle);
+                            lv_inputRes = &lv_vkResManager.RetrieveGpuTexture(lv_vkResManager.RetrieveGpuTextureHandle(lv_inputResource.m_resourceName));
                         }
 
                         lv_inputResource.m_Info.m_format = lv_inputRes->format;
@@ -378,8 +345,6 @@ namespace VulkanEngine
                         lv_attachmentBits.push_back(1);
                     }
 
-                    lv_attachmentNames.push_back(lv_inputResource.m_resourceName.c_str());
-
                     VkAttachmentDescription lv_attachmentDescription{};
                     lv_attachmentDescription.format = lv_depthTestName ?  lv_depth.format :  lv_swapchainTestName ? lv_swapchain.format :lv_inputResource.m_Info.m_format;
                     lv_attachmentDescription.flags = 0;
@@ -431,7 +396,7 @@ namespace VulkanEngine
                 VULKAN_CHECK(vkCreateRenderPass(m_vkRenderContext.GetContextCreator().m_vkDev.m_device, &lv_renderpassCreateInfo,
                     nullptr, &lv_node.m_renderpass));
 
-                lv_vkResManager.AddVulkanRenderpass(lv_node.m_renderpass);
+                lv_vkResManager.AddVulkanRenderpass(lv_node.m_renderpass, lv_renderpassCreateInfo);
 
                 RenderCore::VulkanResourceManager::RenderPass lv_renderpass;
                 lv_renderpass.m_renderpass = lv_node.m_renderpass;
@@ -446,17 +411,17 @@ namespace VulkanEngine
 
                     lv_node.m_frameBufferHandles.reserve(lv_totalNumSwapchains);
 
-                    auto lv_cubemapMeta = lv_vkResManager.RetrieveGpuResourceMetaData(lv_attachmentNames[0]);
-
-                    assert(lv_cubemapMeta.m_resourceHandle != std::numeric_limits<uint32_t>::max());
+                    auto& lv_cubemapResource = m_frameGraphResources[lv_node.m_inputResourcesHandles[0]];
+                    auto lv_cubemapHandle = lv_vkResManager.RetrieveGpuTextureHandle(lv_cubemapResource.m_resourceName);
+                    lv_cubemapResource.m_textureHandles.assign(1, lv_cubemapHandle);
                     
                     std::string lv_formattedString{};
                     for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
 
-                        lv_formattedString = lv_attachmentNames[0] + std::to_string(i) +" {}";
+                        lv_formattedString = lv_cubemapResource.m_resourceName + std::to_string(i) +" {}";
                         auto lv_formattedArgs = std::make_format_args(lv_node.m_cubemapFace);
 
-                        lv_node.m_frameBufferHandles.push_back(lv_vkResManager.CreateFrameBufferCubemapFace(lv_renderpass, lv_cubemapMeta.m_resourceHandle, lv_node.m_cubemapFace, std::vformat(lv_formattedString, lv_formattedArgs).c_str()));
+                        lv_node.m_frameBufferHandles.push_back(lv_vkResManager.CreateFrameBufferCubemapFace(lv_renderpass, lv_cubemapHandle, lv_node.m_cubemapFace, std::vformat(lv_formattedString, lv_formattedArgs).c_str()));
 
                         
                     }
@@ -467,41 +432,31 @@ namespace VulkanEngine
                 //, but it doesnt matter since there arent that many renderpasses for this project to begin with.
                 else {
 
-                    lv_framebufferTexturesHandles.reserve(lv_totalNumSwapchains * lv_attachmentNames.size());
-
-                    for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
-                        for (size_t j = 0; j < lv_attachmentNames.size(); ++j) {
-
-                            std::string lv_formattedString{ lv_attachmentNames[j] };
-
-                            for (auto l_inputResHandle : lv_node.m_inputResourcesHandles) {
+                    for (size_t j = 0; j < lv_node.m_inputResourcesHandles.size(); ++j) {
 
-                                auto& lv_inputRes = m_frameGraphResources[l_inputResHandle];
+                        auto& lv_inputRes = m_frameGraphResources[lv_node.m_inputResourcesHandles[j]];
+                        lv_inputRes.m_textureHandles.clear();
+                        lv_inputRes.m_textureHandles.reserve(lv_totalNumSwapchains);
 
-                                if (lv_inputRes.m_resourceName != lv_formattedString) { continue; }
+                        const std::string lv_formattedString{ lv_inputRes.m_resourceName + " {}" };
 
+                        for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
 
-                                lv_formattedString = lv_formattedString + " {}";
-                                auto lv_formattedArgs = std::make_format_args(i);
+                            auto lv_formattedArgs = std::make_format_args(i);
+                            const std::string lv_textureName = std::vformat(lv_formattedString, lv_formattedArgs);
 
-                                if (lv_attachmentBits[j] == 0) {
-                                    auto lv_textureMetaData = lv_vkResManager.RetrieveGpuResourceMetaData(std::vformat(lv_formattedString, lv_formattedArgs).c_str());
-                                    if (UINT32_MAX == lv_textureMetaData.m_resourceHandle) {
-                                        std::cout << "Texture meta data has invalid handle. Exitting...." << std::endl;
-                                        exit(-1);
-                                    }
-                                    lv_framebufferTexturesHandles.push_back(lv_textureMetaData.m_resourceHandle);
+                            if (lv_attachmentBits[j] == 0) {
+                                lv_inputRes.m_textureHandles.push_back(lv_vkResManager.RetrieveGpuTextureHandle(lv_textureName));
+                            }
+                            else {
+                                if (false == IsFrameGraphDepthResource(lv_inputRes.m_resourceName)) {
+                                    lv_inputRes.m_textureHandles.push_back(lv_vkResManager.CreateTexture(m_vkRenderContext.GetContextCreator().m_vkDev.m_maxAnisotropy, lv_textureName.c_str(),
+                                        lv_attachmentDescriptions[j].format, lv_frameGraphTextureExtent, lv_frameGraphTextureExtent, lv_inputRes.m_Info.m_mipLevels, VK_FILTER_LINEAR, VK_FILTER_LINEAR, lv_inputRes.m_Info.m_addressMode, lv_inputRes.m_Info.m_memoryCategory));
+                                    lv_vkResManager.AddGpuResource(lv_textureName.c_str(), lv_inputRes.m_textureHandles.back());
                                 }
                                 else {
-                                    if (std::string{ lv_attachmentNames[j] }.substr(0, 5) != "Depth") {
-                                        lv_framebufferTexturesHandles.push_back(lv_vkResManager.CreateTexture(m_vkRenderContext.GetContextCreator().m_vkDev.m_maxAnisotropy, std::vformat(lv_formattedString, lv_formattedArgs).c_str(),
-                                            lv_attachmentDescriptions[j].format, 1024, 1024,lv_inputRes.m_Info.m_mipLevels, VK_FILTER_LINEAR, VK_FILTER_LINEAR, lv_inputRes.m_Info.m_addressMode));
-                                        lv_vkResManager.AddGpuResource(std::vformat(lv_formattedString, lv_formattedArgs).c_str(), lv_framebufferTexturesHandles.back(), RenderCore::VulkanResourceManager::VulkanDataType::m_texture);
-                                    }
-                                    else {
-                                        lv_framebufferTexturesHandles.push_back(lv_vkResManager.CreateDepthTextureWithHandle(std::vformat(lv_formattedString, lv_formattedArgs).c_str()));
-                                        lv_vkResManager.AddGpuResource(std::vformat(lv_formattedString, lv_formattedArgs).c_str(), lv_framebufferTexturesHandles.back(), RenderCore::VulkanResourceManager::VulkanDataType::m_texture);
-                                    }
+                                    lv_inputRes.m_textureHandles.push_back(lv_vkResManager.CreateDepthTextureWithHandle(lv_textureName.c_str(), lv_inputRes.m_Info.m_memoryCategory));
+                                    lv_vkResManager.AddGpuResource(lv_textureName.c_str(), lv_inputRes.m_textureHandles.back());
                                 }
                             }
                         }
@@ -511,10 +466,10 @@ namespace VulkanEngine
 
                     for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
 
-                        std::vector<uint32_t> lv_textureHandles{};
-                        lv_textureHandles.reserve(lv_attachmentNames.size());
-                        for (size_t j = i * lv_attachmentNames.size(); j < (i + 1) * lv_attachmentNames.size(); ++j) {
-                            lv_textureHandles.push_back(lv_framebufferTexturesHandles[j]);
+                        std::vector<RenderCore::TextureHandle> lv_textureHandles{};
+                        lv_textureHandles.reserve(lv_node.m_inputResourcesHandles.size());
+                        for (auto l_inputResHandle : lv_node.m_inputResourcesHandles) {
+                            lv_textureHandles.push_back(m_frameGraphResources[l_inputResHandle].m_textureHandles[i]);
                         }
 
                         std::string lv_formattedString{ lv_node.m_nodeNames + "Framebuffer {}" };
@@ -536,78 +491,6 @@ namespace VulkanEngine
     }
 
 
-    VkAttachmentStoreOp FrameGraph::StringToStoreOp(const char* l_op)
-    {
-        if (strcmp(l_op, "VK_ATTACHMENT_STORE_OP_STORE") == 0) {
-            return VK_ATTACHMENT_STORE_OP_STORE;
-        }
-        else if (strcmp(l_op, "VK_ATTACHMENT_STORE_OP_DONT_CARE") == 0) {
-            return VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        }
-
-        return VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    }
-    VkImageLayout FrameGraph::StringToVkImageLayout(const char* l_op)
-    {
-        if (strcmp(l_op, "VK_IMAGE_LAYOUT_UNDEFINED") == 0) {
-            return VK_IMAGE_LAYOUT_UNDEFINED;
-        }
-        else if (strcmp(l_op, "VK_IMAGE_LAYOUT_GENERAL") == 0) {
-            return VK_IMAGE_LAYOUT_GENERAL;
-
-        }
-        else if (strcmp(l_op, "VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL") == 0) {
-            return VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-        }
-        else if (strcmp(l_op, "VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL") == 0) {
-            return VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-        }
-        else if (strcmp(l_op, "VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL") == 0) {
-            return VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-
-        }
-        else if (strcmp(l_op, "VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL") == 0) {
-            return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        }
-        else if (strcmp(l_op, "VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL") == 0) {
-            return VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-
-        }
-        else if (strcmp(l_op, "VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL") == 0) {
-            return VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-
-        }
-        else if (strcmp(l_op, "VK_IMAGE_LAYOUT_PRESENT_SRC_KHR") == 0) {
-            return VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-        }
-        return VK_IMAGE_LAYOUT_UNDEFINED;
-
-    }
-
-
-
-    VkSamplerAddressMode FrameGraph::StringToVkSamplerAddressMode(const char* l_samplerMode)
-    {
-        if (strcmp(l_samplerMode, "VK_SAMPLER_ADDRESS_MODE_REPEAT") == true) {
-            return VK_SAMPLER_ADDRESS_MODE_REPEAT;
-        }
-        else if (strcmp(l_samplerMode, "VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT") == true) {
-            return VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
-        }
-        else if (strcmp(l_samplerMode, "VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE") == true) {
-            return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
-        }
-        else if (strcmp(l_samplerMode, "VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER") == true) {
-            return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
-        }
-
-        return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
-    }
-
-
 
     void FrameGraphNode::UpdateBuffers(const uint32_t l_currentSwapchainIndex,
         const VulkanEngine::CameraStructure& l_cameraStructure)
@@ -672,6 +555,9 @@ namespace VulkanEngine
             .pSignalSemaphores = &m_vkRenderContext.GetContextCreator().m_vkDev.m_binarySemaphore
         };
 
+        //Loader threads submit uploads on the same queue
+        std::lock_guard lv_lock{ m_vkRenderContext.GetResourceManager().GetMainQueueMutex() };
+
         VK_CHECK(vkQueueSubmit(m_vkRenderContext.GetContextCreator().m_vkDev.m_mainQueue1, 1, &si, nullptr));
 
         const VkPresentInfoKHR pi =
@@ -770,772 +656,48 @@ namespace VulkanEngine
     }
 
 
-    void FrameGraph::IncrementNumNodesPerCmdBuffer(uint32_t l_cmdBufferIndex)
+    void FrameGraph::BenchmarkDescriptorUpdates(uint32_t l_totalNumRounds)
     {
-        assert(m_totalNumNodesPerCmdBuffer.size() > l_cmdBufferIndex);
-
-        ++m_totalNumNodesPerCmdBuffer[l_cmdBufferIndex];
-    }
+        RenderCore::DescriptorUpdateTimings lv_totalTimings{};
 
+        for (auto& l_node : m_nodes) {
 
-    VkFormat FrameGraph::StringToVkFormat(const char* format) {
+            if (nullptr == l_node.m_renderer) {
+                continue;
+            }
 
-        if (strcmp(format, "VK_FORMAT_R4G4_UNORM_PACK8") == 0) {
-            return VK_FORMAT_R4G4_UNORM_PACK8;
-        }
-        if (strcmp(format, "VK_FORMAT_R4G4B4A4_UNORM_PACK16") == 0) {
-            return VK_FORMAT_R4G4B4A4_UNORM_PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_B4G4R4A4_UNORM_PACK16") == 0) {
-            return VK_FORMAT_B4G4R4A4_UNORM_PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_R5G6B5_UNORM_PACK16") == 0) {
-            return VK_FORMAT_R5G6B5_UNORM_PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_B5G6R5_UNORM_PACK16") == 0) {
-            return VK_FORMAT_B5G6R5_UNORM_PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_R5G5B5A1_UNORM_PACK16") == 0) {
-            return VK_FORMAT_R5G5B5A1_UNORM_PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_B5G5R5A1_UNORM_PACK16") == 0) {
-            return VK_FORMAT_B5G5R5A1_UNORM_PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_A1R5G5B5_UNORM_PACK16") == 0) {
-            return VK_FORMAT_A1R5G5B5_UNORM_PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_R8_UNORM") == 0) {
-            return VK_FORMAT_R8_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R8_SNORM") == 0) {
-            return VK_FORMAT_R8_SNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R8_USCALED") == 0) {
-            return VK_FORMAT_R8_USCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R8_SSCALED") == 0) {
-            return VK_FORMAT_R8_SSCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R8_UINT") == 0) {
-            return VK_FORMAT_R8_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R8_SINT") == 0) {
-            return VK_FORMAT_R8_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R8_SRGB") == 0) {
-            return VK_FORMAT_R8_SRGB;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8_UNORM") == 0) {
-            return VK_FORMAT_R8G8_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8_SNORM") == 0) {
-            return VK_FORMAT_R8G8_SNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8_USCALED") == 0) {
-            return VK_FORMAT_R8G8_USCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8_SSCALED") == 0) {
-            return VK_FORMAT_R8G8_SSCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8_UINT") == 0) {
-            return VK_FORMAT_R8G8_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8_SINT") == 0) {
-            return VK_FORMAT_R8G8_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8_SRGB") == 0) {
-            return VK_FORMAT_R8G8_SRGB;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8_UNORM") == 0) {
-            return VK_FORMAT_R8G8B8_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8_SNORM") == 0) {
-            return VK_FORMAT_R8G8B8_SNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8_USCALED") == 0) {
-            return VK_FORMAT_R8G8B8_USCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8_SSCALED") == 0) {
-            return VK_FORMAT_R8G8B8_SSCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8_UINT") == 0) {
-            return VK_FORMAT_R8G8B8_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8_SINT") == 0) {
-            return VK_FORMAT_R8G8B8_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8_SRGB") == 0) {
-            return VK_FORMAT_R8G8B8_SRGB;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8_UNORM") == 0) {
-            return VK_FORMAT_B8G8R8_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8_SNORM") == 0) {
-            return VK_FORMAT_B8G8R8_SNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8_USCALED") == 0) {
-            return VK_FORMAT_B8G8R8_USCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8_SSCALED") == 0) {
-            return VK_FORMAT_B8G8R8_SSCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8_UINT") == 0) {
-            return VK_FORMAT_B8G8R8_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8_SINT") == 0) {
-            return VK_FORMAT_B8G8R8_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8_SRGB") == 0) {
-            return VK_FORMAT_B8G8R8_SRGB;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8A8_UNORM") == 0) {
-            return VK_FORMAT_R8G8B8A8_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8A8_SNORM") == 0) {
-            return VK_FORMAT_R8G8B8A8_SNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8A8_USCALED") == 0) {
-            return VK_FORMAT_R8G8B8A8_USCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8A8_SSCALED") == 0) {
-            return VK_FORMAT_R8G8B8A8_SSCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8A8_UINT") == 0) {
-            return VK_FORMAT_R8G8B8A8_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8A8_SINT") == 0) {
-            return VK_FORMAT_R8G8B8A8_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R8G8B8A8_SRGB") == 0) {
-            return VK_FORMAT_R8G8B8A8_SRGB;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8A8_UNORM") == 0) {
-            return VK_FORMAT_B8G8R8A8_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8A8_SNORM") == 0) {
-            return VK_FORMAT_B8G8R8A8_SNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8A8_USCALED") == 0) {
-            return VK_FORMAT_B8G8R8A8_USCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8A8_SSCALED") == 0) {
-            return VK_FORMAT_B8G8R8A8_SSCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8A8_UINT") == 0) {
-            return VK_FORMAT_B8G8R8A8_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8A8_SINT") == 0) {
-            return VK_FORMAT_B8G8R8A8_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8A8_SRGB") == 0) {
-            return VK_FORMAT_B8G8R8A8_SRGB;
-        }
-        if (strcmp(format, "VK_FORMAT_A8B8G8R8_UNORM_PACK32") == 0) {
-            return VK_FORMAT_A8B8G8R8_UNORM_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A8B8G8R8_SNORM_PACK32") == 0) {
-            return VK_FORMAT_A8B8G8R8_SNORM_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A8B8G8R8_USCALED_PACK32") == 0) {
-            return VK_FORMAT_A8B8G8R8_USCALED_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A8B8G8R8_SSCALED_PACK32") == 0) {
-            return VK_FORMAT_A8B8G8R8_SSCALED_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A8B8G8R8_UINT_PACK32") == 0) {
-            return VK_FORMAT_A8B8G8R8_UINT_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A8B8G8R8_SINT_PACK32") == 0) {
-            return VK_FORMAT_A8B8G8R8_SINT_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A8B8G8R8_SRGB_PACK32") == 0) {
-            return VK_FORMAT_A8B8G8R8_SRGB_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A2R10G10B10_UNORM_PACK32") == 0) {
-            return VK_FORMAT_A2R10G10B10_UNORM_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A2R10G10B10_SNORM_PACK32") == 0) {
-            return VK_FORMAT_A2R10G10B10_SNORM_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A2R10G10B10_USCALED_PACK32") == 0) {
-            return VK_FORMAT_A2R10G10B10_USCALED_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A2R10G10B10_SSCALED_PACK32") == 0) {
-            return VK_FORMAT_A2R10G10B10_SSCALED_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A2R10G10B10_UINT_PACK32") == 0) {
-            return VK_FORMAT_A2R10G10B10_UINT_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A2R10G10B10_SINT_PACK32") == 0) {
-            return VK_FORMAT_A2R10G10B10_SINT_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A2B10G10R10_UNORM_PACK32") == 0) {
-            return VK_FORMAT_A2B10G10R10_UNORM_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A2B10G10R10_SNORM_PACK32") == 0) {
-            return VK_FORMAT_A2B10G10R10_SNORM_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A2B10G10R10_USCALED_PACK32") == 0) {
-            return VK_FORMAT_A2B10G10R10_USCALED_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A2B10G10R10_SSCALED_PACK32") == 0) {
-            return VK_FORMAT_A2B10G10R10_SSCALED_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A2B10G10R10_UINT_PACK32") == 0) {
-            return VK_FORMAT_A2B10G10R10_UINT_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_A2B10G10R10_SINT_PACK32") == 0) {
-            return VK_FORMAT_A2B10G10R10_SINT_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_R16_UNORM") == 0) {
-            return VK_FORMAT_R16_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R16_SNORM") == 0) {
-            return VK_FORMAT_R16_SNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R16_USCALED") == 0) {
-            return VK_FORMAT_R16_USCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R16_SSCALED") == 0) {
-            return VK_FORMAT_R16_SSCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R16_UINT") == 0) {
-            return VK_FORMAT_R16_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R16_SINT") == 0) {
-            return VK_FORMAT_R16_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R16_SFLOAT") == 0) {
-            return VK_FORMAT_R16_SFLOAT;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16_UNORM") == 0) {
-            return VK_FORMAT_R16G16_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16_SNORM") == 0) {
-            return VK_FORMAT_R16G16_SNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16_USCALED") == 0) {
-            return VK_FORMAT_R16G16_USCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16_SSCALED") == 0) {
-            return VK_FORMAT_R16G16_SSCALED;
+            const auto lv_timings = l_node.m_renderer->BenchmarkDescriptorUpdates(l_totalNumRounds);
+            lv_totalTimings.m_totalNumSetUpdates += lv_timings.m_totalNumSetUpdates;
+            lv_totalTimings.m_templateMilliseconds += lv_timings.m_templateMilliseconds;
+            lv_totalTimings.m_writeMilliseconds += lv_timings.m_writeMilliseconds;
         }
-        if (strcmp(format, "VK_FORMAT_R16G16_UINT") == 0) {
-            return VK_FORMAT_R16G16_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16_SINT") == 0) {
-            return VK_FORMAT_R16G16_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16_SFLOAT") == 0) {
-            return VK_FORMAT_R16G16_SFLOAT;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16_UNORM") == 0) {
-            return VK_FORMAT_R16G16B16_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16_SNORM") == 0) {
-            return VK_FORMAT_R16G16B16_SNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16_USCALED") == 0) {
-            return VK_FORMAT_R16G16B16_USCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16_SSCALED") == 0) {
-            return VK_FORMAT_R16G16B16_SSCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16_UINT") == 0) {
-            return VK_FORMAT_R16G16B16_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16_SINT") == 0) {
-            return VK_FORMAT_R16G16B16_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16_SFLOAT") == 0) {
-            return VK_FORMAT_R16G16B16_SFLOAT;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16A16_UNORM") == 0) {
-            return VK_FORMAT_R16G16B16A16_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16A16_SNORM") == 0) {
-            return VK_FORMAT_R16G16B16A16_SNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16A16_USCALED") == 0) {
-            return VK_FORMAT_R16G16B16A16_USCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16A16_SSCALED") == 0) {
-            return VK_FORMAT_R16G16B16A16_SSCALED;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16A16_UINT") == 0) {
-            return VK_FORMAT_R16G16B16A16_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16A16_SINT") == 0) {
-            return VK_FORMAT_R16G16B16A16_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R16G16B16A16_SFLOAT") == 0) {
-            return VK_FORMAT_R16G16B16A16_SFLOAT;
-        }
-        if (strcmp(format, "VK_FORMAT_R32_UINT") == 0) {
-            return VK_FORMAT_R32_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R32_SINT") == 0) {
-            return VK_FORMAT_R32_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R32_SFLOAT") == 0) {
-            return VK_FORMAT_R32_SFLOAT;
-        }
-        if (strcmp(format, "VK_FORMAT_R32G32_UINT") == 0) {
-            return VK_FORMAT_R32G32_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R32G32_SINT") == 0) {
-            return VK_FORMAT_R32G32_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R32G32_SFLOAT") == 0) {
-            return VK_FORMAT_R32G32_SFLOAT;
-        }
-        if (strcmp(format, "VK_FORMAT_R32G32B32_UINT") == 0) {
-            return VK_FORMAT_R32G32B32_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R32G32B32_SINT") == 0) {
-            return VK_FORMAT_R32G32B32_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R32G32B32_SFLOAT") == 0) {
-            return VK_FORMAT_R32G32B32_SFLOAT;
-        }
-        if (strcmp(format, "VK_FORMAT_R32G32B32A32_UINT") == 0) {
-            return VK_FORMAT_R32G32B32A32_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R32G32B32A32_SINT") == 0) {
-            return VK_FORMAT_R32G32B32A32_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R32G32B32A32_SFLOAT") == 0) {
-            return VK_FORMAT_R32G32B32A32_SFLOAT;
-        }
-        if (strcmp(format, "VK_FORMAT_R64_UINT") == 0) {
-            return VK_FORMAT_R64_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R64_SINT") == 0) {
-            return VK_FORMAT_R64_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R64_SFLOAT") == 0) {
-            return VK_FORMAT_R64_SFLOAT;
-        }
-        if (strcmp(format, "VK_FORMAT_R64G64_UINT") == 0) {
-            return VK_FORMAT_R64G64_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R64G64_SINT") == 0) {
-            return VK_FORMAT_R64G64_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R64G64_SFLOAT") == 0) {
-            return VK_FORMAT_R64G64_SFLOAT;
-        }
-        if (strcmp(format, "VK_FORMAT_R64G64B64_UINT") == 0) {
-            return VK_FORMAT_R64G64B64_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R64G64B64_SINT") == 0) {
-            return VK_FORMAT_R64G64B64_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R64G64B64_SFLOAT") == 0) {
-            return VK_FORMAT_R64G64B64_SFLOAT;
-        }
-        if (strcmp(format, "VK_FORMAT_R64G64B64A64_UINT") == 0) {
-            return VK_FORMAT_R64G64B64A64_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R64G64B64A64_SINT") == 0) {
-            return VK_FORMAT_R64G64B64A64_SINT;
-        }
-        if (strcmp(format, "VK_FORMAT_R64G64B64A64_SFLOAT") == 0) {
-            return VK_FORMAT_R64G64B64A64_SFLOAT;
-        }
-        if (strcmp(format, "VK_FORMAT_B10G11R11_UFLOAT_PACK32") == 0) {
-            return VK_FORMAT_B10G11R11_UFLOAT_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_E5B9G9R9_UFLOAT_PACK32") == 0) {
-            return VK_FORMAT_E5B9G9R9_UFLOAT_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_D16_UNORM") == 0) {
-            return VK_FORMAT_D16_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_X8_D24_UNORM_PACK32") == 0) {
-            return VK_FORMAT_X8_D24_UNORM_PACK32;
-        }
-        if (strcmp(format, "VK_FORMAT_D32_SFLOAT") == 0) {
-            return VK_FORMAT_D32_SFLOAT;
-        }
-        if (strcmp(format, "VK_FORMAT_S8_UINT") == 0) {
-            return VK_FORMAT_S8_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_D16_UNORM_S8_UINT") == 0) {
-            return VK_FORMAT_D16_UNORM_S8_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_D24_UNORM_S8_UINT") == 0) {
-            return VK_FORMAT_D24_UNORM_S8_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_D32_SFLOAT_S8_UINT") == 0) {
-            return VK_FORMAT_D32_SFLOAT_S8_UINT;
-        }
-        if (strcmp(format, "VK_FORMAT_BC1_RGB_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC1_RGB_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC1_RGBA_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC1_RGBA_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC2_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_BC2_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC2_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_BC2_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC3_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_BC3_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC3_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_BC3_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC4_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_BC4_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC4_SNORM_BLOCK") == 0) {
-            return VK_FORMAT_BC4_SNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC5_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_BC5_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC5_SNORM_BLOCK") == 0) {
-            return VK_FORMAT_BC5_SNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC6H_UFLOAT_BLOCK") == 0) {
-            return VK_FORMAT_BC6H_UFLOAT_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC6H_SFLOAT_BLOCK") == 0) {
-            return VK_FORMAT_BC6H_SFLOAT_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC7_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_BC7_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_BC7_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_BC7_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_EAC_R11_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_EAC_R11_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_EAC_R11_SNORM_BLOCK") == 0) {
-            return VK_FORMAT_EAC_R11_SNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_EAC_R11G11_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_EAC_R11G11_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_EAC_R11G11_SNORM_BLOCK") == 0) {
-            return VK_FORMAT_EAC_R11G11_SNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_4x4_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_4x4_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_4x4_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_5x4_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_5x4_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_5x4_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_5x4_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_5x5_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_5x5_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_5x5_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_5x5_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_6x5_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_6x5_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_6x5_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_6x5_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_6x6_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_6x6_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_6x6_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_6x6_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_8x5_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_8x5_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_8x5_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_8x5_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_8x6_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_8x6_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_8x6_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_8x6_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_8x8_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_8x8_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_8x8_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_8x8_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_10x5_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_10x5_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_10x5_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_10x5_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_10x6_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_10x6_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_10x6_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_10x6_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_10x8_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_10x8_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_10x8_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_10x8_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_10x10_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_10x10_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_10x10_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_10x10_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_12x10_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_12x10_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_12x10_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_12x10_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_12x12_UNORM_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_12x12_UNORM_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_12x12_SRGB_BLOCK") == 0) {
-            return VK_FORMAT_ASTC_12x12_SRGB_BLOCK;
-        }
-        if (strcmp(format, "VK_FORMAT_G8B8G8R8_422_UNORM") == 0) {
-            return VK_FORMAT_G8B8G8R8_422_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_B8G8R8G8_422_UNORM") == 0) {
-            return VK_FORMAT_B8G8R8G8_422_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM") == 0) {
-            return VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_G8_B8R8_2PLANE_420_UNORM") == 0) {
-            return VK_FORMAT_G8_B8R8_2PLANE_420_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_G8_B8_R8_3PLANE_422_UNORM") == 0) {
-            return VK_FORMAT_G8_B8_R8_3PLANE_422_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_G8_B8R8_2PLANE_422_UNORM") == 0) {
-            return VK_FORMAT_G8_B8R8_2PLANE_422_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_G8_B8_R8_3PLANE_444_UNORM") == 0) {
-            return VK_FORMAT_G8_B8_R8_3PLANE_444_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_R10X6_UNORM_PACK16") == 0) {
-            return VK_FORMAT_R10X6_UNORM_PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_R10X6G10X6_UNORM_2PACK16") == 0) {
-            return VK_FORMAT_R10X6G10X6_UNORM_2PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_R10X6G10X6B10X6A10X6_UNORM_4PACK16") == 0) {
-            return VK_FORMAT_R10X6G10X6B10X6A10X6_UNORM_4PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_G10X6B10X6G10X6R10X6_422_UNORM_4PACK16") == 0) {
-            return VK_FORMAT_G10X6B10X6G10X6R10X6_422_UNORM_4PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_B10X6G10X6R10X6G10X6_422_UNORM_4PACK16") == 0) {
-            return VK_FORMAT_B10X6G10X6R10X6G10X6_422_UNORM_4PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_420_UNORM_3PACK16") == 0) {
-            return VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_420_UNORM_3PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16") == 0) {
-            return VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_422_UNORM_3PACK16") == 0) {
-            return VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_422_UNORM_3PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_G10X6_B10X6R10X6_2PLANE_422_UNORM_3PACK16") == 0) {
-            return VK_FORMAT_G10X6_B10X6R10X6_2PLANE_422_UNORM_3PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_444_UNORM_3PACK16") == 0) {
-            return VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_444_UNORM_3PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_R12X4_UNORM_PACK16") == 0) {
-            return VK_FORMAT_R12X4_UNORM_PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_R12X4G12X4_UNORM_2PACK16") == 0) {
-            return VK_FORMAT_R12X4G12X4_UNORM_2PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_R12X4G12X4B12X4A12X4_UNORM_4PACK16") == 0) {
-            return VK_FORMAT_R12X4G12X4B12X4A12X4_UNORM_4PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_G12X4B12X4G12X4R12X4_422_UNORM_4PACK16") == 0) {
-            return VK_FORMAT_G12X4B12X4G12X4R12X4_422_UNORM_4PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_B12X4G12X4R12X4G12X4_422_UNORM_4PACK16") == 0) {
-            return VK_FORMAT_B12X4G12X4R12X4G12X4_422_UNORM_4PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_420_UNORM_3PACK16") == 0) {
-            return VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_420_UNORM_3PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_G12X4_B12X4R12X4_2PLANE_420_UNORM_3PACK16") == 0) {
-            return VK_FORMAT_G12X4_B12X4R12X4_2PLANE_420_UNORM_3PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_422_UNORM_3PACK16") == 0) {
-            return VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_422_UNORM_3PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16") == 0) {
-            return VK_FORMAT_G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_444_UNORM_3PACK16") == 0) {
-            return VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_444_UNORM_3PACK16;
-        }
-        if (strcmp(format, "VK_FORMAT_G16B16G16R16_422_UNORM") == 0) {
-            return VK_FORMAT_G16B16G16R16_422_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_B16G16R16G16_422_UNORM") == 0) {
-            return VK_FORMAT_B16G16R16G16_422_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_G16_B16_R16_3PLANE_420_UNORM") == 0) {
-            return VK_FORMAT_G16_B16_R16_3PLANE_420_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_G16_B16R16_2PLANE_420_UNORM") == 0) {
-            return VK_FORMAT_G16_B16R16_2PLANE_420_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_G16_B16_R16_3PLANE_422_UNORM") == 0) {
-            return VK_FORMAT_G16_B16_R16_3PLANE_422_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_G16_B16R16_2PLANE_422_UNORM") == 0) {
-            return VK_FORMAT_G16_B16R16_2PLANE_422_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_G16_B16_R16_3PLANE_444_UNORM") == 0) {
-            return VK_FORMAT_G16_B16_R16_3PLANE_444_UNORM;
-        }
-        if (strcmp(format, "VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG") == 0) {
-            return VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG;
-        }
-        if (strcmp(format, "VK_FORMAT_PVRTC1_4BPP_UNORM_BLOCK_IMG") == 0) {
-            return VK_FORMAT_PVRTC1_4BPP_UNORM_BLOCK_IMG;
-        }
-        if (strcmp(format, "VK_FORMAT_PVRTC2_2BPP_UNORM_BLOCK_IMG") == 0) {
-            return VK_FORMAT_PVRTC2_2BPP_UNORM_BLOCK_IMG;
-        }
-        if (strcmp(format, "VK_FORMAT_PVRTC2_4BPP_UNORM_BLOCK_IMG") == 0) {
-            return VK_FORMAT_PVRTC2_4BPP_UNORM_BLOCK_IMG;
-        }
-        if (strcmp(format, "VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG") == 0) {
-            return VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG;
-        }
-        if (strcmp(format, "VK_FORMAT_PVRTC1_4BPP_SRGB_BLOCK_IMG") == 0) {
-            return VK_FORMAT_PVRTC1_4BPP_SRGB_BLOCK_IMG;
-        }
-        if (strcmp(format, "VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG") == 0) {
-            return VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG;
-        }
-        if (strcmp(format, "VK_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG") == 0) {
-            return VK_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_4x4_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_4x4_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_5x4_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_5x4_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_5x5_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_5x5_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_6x5_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_6x5_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_6x6_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_6x6_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_8x5_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_8x5_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_8x6_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_8x6_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_8x8_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_8x8_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_10x5_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_10x5_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_10x6_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_10x6_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_10x8_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_10x8_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_10x10_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_10x10_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_12x10_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_12x10_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_ASTC_12x12_SFLOAT_BLOCK_EXT") == 0) {
-            return VK_FORMAT_ASTC_12x12_SFLOAT_BLOCK_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_G8_B8R8_2PLANE_444_UNORM_EXT") == 0) {
-            return VK_FORMAT_G8_B8R8_2PLANE_444_UNORM_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_G10X6_B10X6R10X6_2PLANE_444_UNORM_3PACK16_EXT") == 0) {
-            return VK_FORMAT_G10X6_B10X6R10X6_2PLANE_444_UNORM_3PACK16_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_G12X4_B12X4R12X4_2PLANE_444_UNORM_3PACK16_EXT") == 0) {
-            return VK_FORMAT_G12X4_B12X4R12X4_2PLANE_444_UNORM_3PACK16_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_G16_B16R16_2PLANE_444_UNORM_EXT") == 0) {
-            return VK_FORMAT_G16_B16R16_2PLANE_444_UNORM_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_A4R4G4B4_UNORM_PACK16_EXT") == 0) {
-            return VK_FORMAT_A4R4G4B4_UNORM_PACK16_EXT;
-        }
-        if (strcmp(format, "VK_FORMAT_A4B4G4R4_UNORM_PACK16_EXT") == 0) {
-            return VK_FORMAT_A4B4G4R4_UNORM_PACK16_EXT;
+
+        if (0 == lv_totalTimings.m_totalNumSetUpdates) {
+            return;
         }
 
-        return VK_FORMAT_UNDEFINED;
+        printf("\n%u descriptor set updates of %zu frame graph nodes:\n", lv_totalTimings.m_totalNumSetUpdates, m_nodes.size());
+        printf("  update templates:       %10.2f ms\n", lv_totalTimings.m_templateMilliseconds);
+        printf("  vkUpdateDescriptorSets: %10.2f ms (%.2fx)\n", lv_totalTimings.m_writeMilliseconds,
+            lv_totalTimings.m_writeMilliseconds / lv_totalTimings.m_templateMilliseconds);
     }
 
-    VkAttachmentLoadOp FrameGraph::StringToLoadOp(const char* l_op)
+
+    void FrameGraph::UpdateDescriptorSets()
     {
-        if (strcmp(l_op, "VK_ATTACHMENT_LOAD_OP_LOAD") == 0) {
-            return VK_ATTACHMENT_LOAD_OP_LOAD;
-        }
-        if (strcmp(l_op, "VK_ATTACHMENT_LOAD_OP_CLEAR") == 0) {
-            return VK_ATTACHMENT_LOAD_OP_CLEAR;
-        }
-        if (strcmp(l_op, "VK_ATTACHMENT_LOAD_OP_DONT_CARE") == 0) {
-            return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        for (auto& l_node : m_nodes) {
+            if (nullptr != l_node.m_renderer) {
+                l_node.m_renderer->UpdateDescriptorSets();
+            }
         }
-        
+    }
+
 
-        return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    void FrameGraph::IncrementNumNodesPerCmdBuffer(uint32_t l_cmdBufferIndex)
+    {
+        assert(m_totalNumNodesPerCmdBuffer.size() > l_cmdBufferIndex);
+
+        ++m_totalNumNodesPerCmdBuffer[l_cmdBufferIndex];
     }
 
 }
\ No newline at end of file
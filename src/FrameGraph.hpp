@@ -7,6 +7,10 @@
 #include <vector>
 #include <unordered_map>
 #include "volk.h"
+#include "GpuMemoryAllocator.hpp"
+#include "FrameGraphResourceParsing.hpp"
+#include "GpuResourceHandles.hpp"
+#include "SpecializationConstants.hpp"
 
 
 
@@ -24,35 +28,20 @@ namespace VulkanEngine
 
 
 
-	struct FrameGraphResourceInfo
-	{
-		bool m_createOnGPU = false;
-
-		uint32_t	m_width = 0;
-        uint32_t	m_height = 0;
-        uint32_t	m_depth = 0;
-		uint32_t	m_mipLevels = 1;
-
-		VkSamplerAddressMode m_addressMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
-
-        VkFormat	m_format = VK_FORMAT_UNDEFINED;
-        VkImageUsageFlags	m_flags = 0;
-
-		VkImageLayout m_imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-
-		VkAttachmentLoadOp	m_loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-		VkAttachmentStoreOp m_storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-
-		uint32_t	m_textureHandle = UINT32_MAX;
-	};
-
-
-
+	//The name is only the key of the resource in the frame graph json and in the name registry of
+	//VulkanResourceManager, the renderers look their attachments up there by "<name> <swapchain index>".
+	//It is resolved into handles once when the render passes are built, nothing after that goes through it.
 	struct FrameGraphResource
 	{
 		std::string m_resourceName;
 		FrameGraphResourceInfo m_Info;
 		uint32_t m_nodeThatOwnsThisResourceHandle;
+
+		//Output resource of the same node that this input is written back to, UINT32_MAX if there is none
+		uint32_t m_correspondingOutputResourceHandle = UINT32_MAX;
+
+		//Texture backing this attachment for every swapchain image, a cubemap face target only has one
+		std::vector<RenderCore::TextureHandle> m_textureHandles;
 	};
 
 
@@ -73,6 +62,9 @@ namespace VulkanEngine
 		std::vector<uint32_t> m_outputResourcesHandles;
 		std::vector<uint32_t> m_targetNodesHandles;
 
+		//Optional "SpecializationConstants" of the node, its renderer merges them over the defaults of its shader permutation
+		RenderCore::SpecializationConstants m_specializationConstants{};
+
 		std::string m_nodeNames;
 		std::string m_pipelineType;
 		uint32_t m_nodeIndex;
@@ -117,21 +109,21 @@ namespace VulkanEngine
 
 		void EnableAllNodes();
 
-	protected:
+		//Times the descriptor updates of every renderer of the graph with and without update templates and prints the totals
+		void BenchmarkDescriptorUpdates(uint32_t l_totalNumRounds);
 
-		VkFormat StringToVkFormat(const char* format);
-		VkAttachmentLoadOp StringToLoadOp(const char* l_op);
+		//Rewrites the descriptor sets of every renderer of the graph, for when the resources behind them were recreated
+		void UpdateDescriptorSets();
 
-		void CreateRenderpassAndFramebuffers(const uint32_t l_nodeHandle);
+	protected:
 
-		VkAttachmentStoreOp StringToStoreOp(const char* l_op);
-		VkImageLayout StringToVkImageLayout(const char* l_op);
-		VkSamplerAddressMode StringToVkSamplerAddressMode(const char* l_samplerMode);
+		void CreateRenderpassAndFramebuffers(const uint32_t l_nodeHandle);
 
 	private:
 
 		VulkanRenderContext& m_vkRenderContext;
 		std::vector<FrameGraphNode> m_nodes;
+		std::unordered_map<std::string, uint32_t> m_nodeNamesToHandles;
 		std::vector<FrameGraphResource> m_frameGraphResources;
 		std::vector<uint32_t> m_frameGraphResourcesHandles;
 		std::vector<uint32_t> m_nodeHandles;
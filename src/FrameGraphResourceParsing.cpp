@@ -0,0 +1,918 @@
+
+
+
+#include "FrameGraphResourceParsing.hpp"
+#include <rapidjson/document.h>
+#include <cstring>
+
+
+namespace VulkanEngine
+{
+
+	namespace
+	{
+		bool ParseCreateOnGPU(const rapidjson::Value& l_resource)
+		{
+			return 0 != strcmp(l_resource["CreateResourceOnGPU"].GetString(), "FALSE");
+		}
+
+
+		void ParseResolutionAndFormat(const rapidjson::Value& l_textureInfo, FrameGraphResourceInfo& l_info)
+		{
+			l_info.m_depth = l_textureInfo["Resolution"][2].GetUint();
+			l_info.m_height = l_textureInfo["Resolution"][1].GetUint();
+			l_info.m_width = l_textureInfo["Resolution"][0].GetUint();
+			l_info.m_format = StringToVkFormat(l_textureInfo["Format"].GetString());
+		}
+	}
+
+
+	FrameGraphResourceInfo ParseFrameGraphInputInfo(const rapidjson::Value& l_resource)
+	{
+		FrameGraphResourceInfo lv_inputInfo{};
+		const auto& lv_textureInfo = l_resource["TextureInfo"][0];
+
+		lv_inputInfo.m_createOnGPU = ParseCreateOnGPU(l_resource);
+
+		if (true == lv_textureInfo.HasMember("MipLevel")) {
+			lv_inputInfo.m_mipLevels = (uint32_t)lv_textureInfo["MipLevel"].GetInt();
+		}
+
+		if (true == lv_textureInfo.HasMember("SamplerMode")) {
+			lv_inputInfo.m_addressMode = StringToVkSamplerAddressMode(lv_textureInfo["SamplerMode"].GetString());
+		}
+
+		if (true == lv_textureInfo.HasMember("MemoryCategory")) {
+			lv_inputInfo.m_memoryCategory = RenderCore::StringToGpuMemoryCategory(lv_textureInfo["MemoryCategory"].GetString());
+		}
+
+		lv_inputInfo.m_loadOp = StringToLoadOp(lv_textureInfo["LoadOp"].GetString());
+		lv_inputInfo.m_imageLayout = StringToVkImageLayout(lv_textureInfo["ImageLayout"].GetString());
+
+		if (true == lv_inputInfo.m_createOnGPU) {
+			ParseResolutionAndFormat(lv_textureInfo, lv_inputInfo);
+		}
+
+		return lv_inputInfo;
+	}
+
+
+	FrameGraphResourceInfo ParseFrameGraphOutputInfo(const rapidjson::Value& l_resource)
+	{
+		FrameGraphResourceInfo lv_outputInfo{};
+		const auto& lv_textureInfo = l_resource["TextureInfo"][0];
+
+		lv_outputInfo.m_createOnGPU = ParseCreateOnGPU(l_resource);
+
+		lv_outputInfo.m_storeOp = StringToStoreOp(lv_textureInfo["StoreOp"].GetString());
+		lv_outputInfo.m_imageLayout = StringToVkImageLayout(lv_textureInfo["ImageLayout"].GetString());
+
+		if (true == lv_outputInfo.m_createOnGPU) {
+			ParseResolutionAndFormat(lv_textureInfo, lv_outputInfo);
+		}
+
+		return lv_outputInfo;
+	}
+
+
+	bool IsFrameGraphDepthResource(const std::string& l_resourceName)
+	{
+		return l_resourceName.substr(0, 5) == "Depth";
+	}
+
+
+	VkFormat StringToVkFormat(const char* format) {
+
+		if (strcmp(format, "VK_FORMAT_R4G4_UNORM_PACK8") == 0) {
+			return VK_FORMAT_R4G4_UNORM_PACK8;
+		}
+		if (strcmp(format, "VK_FORMAT_R4G4B4A4_UNORM_PACK16") == 0) {
+			return VK_FORMAT_R4G4B4A4_UNORM_PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_B4G4R4A4_UNORM_PACK16") == 0) {
+			return VK_FORMAT_B4G4R4A4_UNORM_PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_R5G6B5_UNORM_PACK16") == 0) {
+			return VK_FORMAT_R5G6B5_UNORM_PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_B5G6R5_UNORM_PACK16") == 0) {
+			return VK_FORMAT_B5G6R5_UNORM_PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_R5G5B5A1_UNORM_PACK16") == 0) {
+			return VK_FORMAT_R5G5B5A1_UNORM_PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_B5G5R5A1_UNORM_PACK16") == 0) {
+			return VK_FORMAT_B5G5R5A1_UNORM_PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_A1R5G5B5_UNORM_PACK16") == 0) {
+			return VK_FORMAT_A1R5G5B5_UNORM_PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_R8_UNORM") == 0) {
+			return VK_FORMAT_R8_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R8_SNORM") == 0) {
+			return VK_FORMAT_R8_SNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R8_USCALED") == 0) {
+			return VK_FORMAT_R8_USCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R8_SSCALED") == 0) {
+			return VK_FORMAT_R8_SSCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R8_UINT") == 0) {
+			return VK_FORMAT_R8_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R8_SINT") == 0) {
+			return VK_FORMAT_R8_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R8_SRGB") == 0) {
+			return VK_FORMAT_R8_SRGB;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8_UNORM") == 0) {
+			return VK_FORMAT_R8G8_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8_SNORM") == 0) {
+			return VK_FORMAT_R8G8_SNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8_USCALED") == 0) {
+			return VK_FORMAT_R8G8_USCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8_SSCALED") == 0) {
+			return VK_FORMAT_R8G8_SSCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8_UINT") == 0) {
+			return VK_FORMAT_R8G8_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8_SINT") == 0) {
+			return VK_FORMAT_R8G8_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8_SRGB") == 0) {
+			return VK_FORMAT_R8G8_SRGB;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8_UNORM") == 0) {
+			return VK_FORMAT_R8G8B8_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8_SNORM") == 0) {
+			return VK_FORMAT_R8G8B8_SNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8_USCALED") == 0) {
+			return VK_FORMAT_R8G8B8_USCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8_SSCALED") == 0) {
+			return VK_FORMAT_R8G8B8_SSCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8_UINT") == 0) {
+			return VK_FORMAT_R8G8B8_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8_SINT") == 0) {
+			return VK_FORMAT_R8G8B8_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8_SRGB") == 0) {
+			return VK_FORMAT_R8G8B8_SRGB;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8_UNORM") == 0) {
+			return VK_FORMAT_B8G8R8_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8_SNORM") == 0) {
+			return VK_FORMAT_B8G8R8_SNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8_USCALED") == 0) {
+			return VK_FORMAT_B8G8R8_USCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8_SSCALED") == 0) {
+			return VK_FORMAT_B8G8R8_SSCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8_UINT") == 0) {
+			return VK_FORMAT_B8G8R8_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8_SINT") == 0) {
+			return VK_FORMAT_B8G8R8_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8_SRGB") == 0) {
+			return VK_FORMAT_B8G8R8_SRGB;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8A8_UNORM") == 0) {
+			return VK_FORMAT_R8G8B8A8_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8A8_SNORM") == 0) {
+			return VK_FORMAT_R8G8B8A8_SNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8A8_USCALED") == 0) {
+			return VK_FORMAT_R8G8B8A8_USCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8A8_SSCALED") == 0) {
+			return VK_FORMAT_R8G8B8A8_SSCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8A8_UINT") == 0) {
+			return VK_FORMAT_R8G8B8A8_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8A8_SINT") == 0) {
+			return VK_FORMAT_R8G8B8A8_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R8G8B8A8_SRGB") == 0) {
+			return VK_FORMAT_R8G8B8A8_SRGB;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8A8_UNORM") == 0) {
+			return VK_FORMAT_B8G8R8A8_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8A8_SNORM") == 0) {
+			return VK_FORMAT_B8G8R8A8_SNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8A8_USCALED") == 0) {
+			return VK_FORMAT_B8G8R8A8_USCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8A8_SSCALED") == 0) {
+			return VK_FORMAT_B8G8R8A8_SSCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8A8_UINT") == 0) {
+			return VK_FORMAT_B8G8R8A8_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8A8_SINT") == 0) {
+			return VK_FORMAT_B8G8R8A8_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8A8_SRGB") == 0) {
+			return VK_FORMAT_B8G8R8A8_SRGB;
+		}
+		if (strcmp(format, "VK_FORMAT_A8B8G8R8_UNORM_PACK32") == 0) {
+			return VK_FORMAT_A8B8G8R8_UNORM_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A8B8G8R8_SNORM_PACK32") == 0) {
+			return VK_FORMAT_A8B8G8R8_SNORM_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A8B8G8R8_USCALED_PACK32") == 0) {
+			return VK_FORMAT_A8B8G8R8_USCALED_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A8B8G8R8_SSCALED_PACK32") == 0) {
+			return VK_FORMAT_A8B8G8R8_SSCALED_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A8B8G8R8_UINT_PACK32") == 0) {
+			return VK_FORMAT_A8B8G8R8_UINT_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A8B8G8R8_SINT_PACK32") == 0) {
+			return VK_FORMAT_A8B8G8R8_SINT_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A8B8G8R8_SRGB_PACK32") == 0) {
+			return VK_FORMAT_A8B8G8R8_SRGB_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A2R10G10B10_UNORM_PACK32") == 0) {
+			return VK_FORMAT_A2R10G10B10_UNORM_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A2R10G10B10_SNORM_PACK32") == 0) {
+			return VK_FORMAT_A2R10G10B10_SNORM_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A2R10G10B10_USCALED_PACK32") == 0) {
+			return VK_FORMAT_A2R10G10B10_USCALED_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A2R10G10B10_SSCALED_PACK32") == 0) {
+			return VK_FORMAT_A2R10G10B10_SSCALED_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A2R10G10B10_UINT_PACK32") == 0) {
+			return VK_FORMAT_A2R10G10B10_UINT_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A2R10G10B10_SINT_PACK32") == 0) {
+			return VK_FORMAT_A2R10G10B10_SINT_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A2B10G10R10_UNORM_PACK32") == 0) {
+			return VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A2B10G10R10_SNORM_PACK32") == 0) {
+			return VK_FORMAT_A2B10G10R10_SNORM_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A2B10G10R10_USCALED_PACK32") == 0) {
+			return VK_FORMAT_A2B10G10R10_USCALED_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A2B10G10R10_SSCALED_PACK32") == 0) {
+			return VK_FORMAT_A2B10G10R10_SSCALED_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A2B10G10R10_UINT_PACK32") == 0) {
+			return VK_FORMAT_A2B10G10R10_UINT_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_A2B10G10R10_SINT_PACK32") == 0) {
+			return VK_FORMAT_A2B10G10R10_SINT_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_R16_UNORM") == 0) {
+			return VK_FORMAT_R16_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R16_SNORM") == 0) {
+			return VK_FORMAT_R16_SNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R16_USCALED") == 0) {
+			return VK_FORMAT_R16_USCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R16_SSCALED") == 0) {
+			return VK_FORMAT_R16_SSCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R16_UINT") == 0) {
+			return VK_FORMAT_R16_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R16_SINT") == 0) {
+			return VK_FORMAT_R16_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R16_SFLOAT") == 0) {
+			return VK_FORMAT_R16_SFLOAT;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16_UNORM") == 0) {
+			return VK_FORMAT_R16G16_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16_SNORM") == 0) {
+			return VK_FORMAT_R16G16_SNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16_USCALED") == 0) {
+			return VK_FORMAT_R16G16_USCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16_SSCALED") == 0) {
+			return VK_FORMAT_R16G16_SSCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16_UINT") == 0) {
+			return VK_FORMAT_R16G16_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16_SINT") == 0) {
+			return VK_FORMAT_R16G16_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16_SFLOAT") == 0) {
+			return VK_FORMAT_R16G16_SFLOAT;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16_UNORM") == 0) {
+			return VK_FORMAT_R16G16B16_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16_SNORM") == 0) {
+			return VK_FORMAT_R16G16B16_SNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16_USCALED") == 0) {
+			return VK_FORMAT_R16G16B16_USCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16_SSCALED") == 0) {
+			return VK_FORMAT_R16G16B16_SSCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16_UINT") == 0) {
+			return VK_FORMAT_R16G16B16_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16_SINT") == 0) {
+			return VK_FORMAT_R16G16B16_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16_SFLOAT") == 0) {
+			return VK_FORMAT_R16G16B16_SFLOAT;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16A16_UNORM") == 0) {
+			return VK_FORMAT_R16G16B16A16_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16A16_SNORM") == 0) {
+			return VK_FORMAT_R16G16B16A16_SNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16A16_USCALED") == 0) {
+			return VK_FORMAT_R16G16B16A16_USCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16A16_SSCALED") == 0) {
+			return VK_FORMAT_R16G16B16A16_SSCALED;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16A16_UINT") == 0) {
+			return VK_FORMAT_R16G16B16A16_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16A16_SINT") == 0) {
+			return VK_FORMAT_R16G16B16A16_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R16G16B16A16_SFLOAT") == 0) {
+			return VK_FORMAT_R16G16B16A16_SFLOAT;
+		}
+		if (strcmp(format, "VK_FORMAT_R32_UINT") == 0) {
+			return VK_FORMAT_R32_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R32_SINT") == 0) {
+			return VK_FORMAT_R32_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R32_SFLOAT") == 0) {
+			return VK_FORMAT_R32_SFLOAT;
+		}
+		if (strcmp(format, "VK_FORMAT_R32G32_UINT") == 0) {
+			return VK_FORMAT_R32G32_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R32G32_SINT") == 0) {
+			return VK_FORMAT_R32G32_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R32G32_SFLOAT") == 0) {
+			return VK_FORMAT_R32G32_SFLOAT;
+		}
+		if (strcmp(format, "VK_FORMAT_R32G32B32_UINT") == 0) {
+			return VK_FORMAT_R32G32B32_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R32G32B32_SINT") == 0) {
+			return VK_FORMAT_R32G32B32_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R32G32B32_SFLOAT") == 0) {
+			return VK_FORMAT_R32G32B32_SFLOAT;
+		}
+		if (strcmp(format, "VK_FORMAT_R32G32B32A32_UINT") == 0) {
+			return VK_FORMAT_R32G32B32A32_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R32G32B32A32_SINT") == 0) {
+			return VK_FORMAT_R32G32B32A32_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R32G32B32A32_SFLOAT") == 0) {
+			return VK_FORMAT_R32G32B32A32_SFLOAT;
+		}
+		if (strcmp(format, "VK_FORMAT_R64_UINT") == 0) {
+			return VK_FORMAT_R64_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R64_SINT") == 0) {
+			return VK_FORMAT_R64_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R64_SFLOAT") == 0) {
+			return VK_FORMAT_R64_SFLOAT;
+		}
+		if (strcmp(format, "VK_FORMAT_R64G64_UINT") == 0) {
+			return VK_FORMAT_R64G64_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R64G64_SINT") == 0) {
+			return VK_FORMAT_R64G64_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R64G64_SFLOAT") == 0) {
+			return VK_FORMAT_R64G64_SFLOAT;
+		}
+		if (strcmp(format, "VK_FORMAT_R64G64B64_UINT") == 0) {
+			return VK_FORMAT_R64G64B64_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R64G64B64_SINT") == 0) {
+			return VK_FORMAT_R64G64B64_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R64G64B64_SFLOAT") == 0) {
+			return VK_FORMAT_R64G64B64_SFLOAT;
+		}
+		if (strcmp(format, "VK_FORMAT_R64G64B64A64_UINT") == 0) {
+			return VK_FORMAT_R64G64B64A64_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R64G64B64A64_SINT") == 0) {
+			return VK_FORMAT_R64G64B64A64_SINT;
+		}
+		if (strcmp(format, "VK_FORMAT_R64G64B64A64_SFLOAT") == 0) {
+			return VK_FORMAT_R64G64B64A64_SFLOAT;
+		}
+		if (strcmp(format, "VK_FORMAT_B10G11R11_UFLOAT_PACK32") == 0) {
+			return VK_FORMAT_B10G11R11_UFLOAT_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_E5B9G9R9_UFLOAT_PACK32") == 0) {
+			return VK_FORMAT_E5B9G9R9_UFLOAT_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_D16_UNORM") == 0) {
+			return VK_FORMAT_D16_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_X8_D24_UNORM_PACK32") == 0) {
+			return VK_FORMAT_X8_D24_UNORM_PACK32;
+		}
+		if (strcmp(format, "VK_FORMAT_D32_SFLOAT") == 0) {
+			return VK_FORMAT_D32_SFLOAT;
+		}
+		if (strcmp(format, "VK_FORMAT_S8_UINT") == 0) {
+			return VK_FORMAT_S8_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_D16_UNORM_S8_UINT") == 0) {
+			return VK_FORMAT_D16_UNORM_S8_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_D24_UNORM_S8_UINT") == 0) {
+			return VK_FORMAT_D24_UNORM_S8_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_D32_SFLOAT_S8_UINT") == 0) {
+			return VK_FORMAT_D32_SFLOAT_S8_UINT;
+		}
+		if (strcmp(format, "VK_FORMAT_BC1_RGB_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC1_RGB_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC1_RGBA_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC1_RGBA_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC2_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_BC2_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC2_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_BC2_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC3_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_BC3_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC3_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_BC3_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC4_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_BC4_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC4_SNORM_BLOCK") == 0) {
+			return VK_FORMAT_BC4_SNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC5_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_BC5_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC5_SNORM_BLOCK") == 0) {
+			return VK_FORMAT_BC5_SNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC6H_UFLOAT_BLOCK") == 0) {
+			return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC6H_SFLOAT_BLOCK") == 0) {
+			return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC7_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_BC7_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_BC7_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_BC7_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_EAC_R11_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_EAC_R11_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_EAC_R11_SNORM_BLOCK") == 0) {
+			return VK_FORMAT_EAC_R11_SNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_EAC_R11G11_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_EAC_R11G11_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_EAC_R11G11_SNORM_BLOCK") == 0) {
+			return VK_FORMAT_EAC_R11G11_SNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_4x4_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_4x4_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_4x4_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_5x4_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_5x4_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_5x4_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_5x4_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_5x5_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_5x5_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_5x5_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_5x5_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_6x5_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_6x5_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_6x5_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_6x5_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_6x6_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_6x6_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_6x6_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_6x6_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_8x5_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_8x5_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_8x5_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_8x5_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_8x6_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_8x6_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_8x6_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_8x6_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_8x8_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_8x8_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_8x8_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_8x8_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_10x5_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_10x5_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_10x5_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_10x5_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_10x6_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_10x6_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_10x6_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_10x6_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_10x8_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_10x8_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_10x8_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_10x8_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_10x10_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_10x10_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_10x10_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_10x10_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_12x10_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_12x10_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_12x10_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_12x10_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_12x12_UNORM_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_12x12_UNORM_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_12x12_SRGB_BLOCK") == 0) {
+			return VK_FORMAT_ASTC_12x12_SRGB_BLOCK;
+		}
+		if (strcmp(format, "VK_FORMAT_G8B8G8R8_422_UNORM") == 0) {
+			return VK_FORMAT_G8B8G8R8_422_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_B8G8R8G8_422_UNORM") == 0) {
+			return VK_FORMAT_B8G8R8G8_422_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM") == 0) {
+			return VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_G8_B8R8_2PLANE_420_UNORM") == 0) {
+			return VK_FORMAT_G8_B8R8_2PLANE_420_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_G8_B8_R8_3PLANE_422_UNORM") == 0) {
+			return VK_FORMAT_G8_B8_R8_3PLANE_422_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_G8_B8R8_2PLANE_422_UNORM") == 0) {
+			return VK_FORMAT_G8_B8R8_2PLANE_422_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_G8_B8_R8_3PLANE_444_UNORM") == 0) {
+			return VK_FORMAT_G8_B8_R8_3PLANE_444_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_R10X6_UNORM_PACK16") == 0) {
+			return VK_FORMAT_R10X6_UNORM_PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_R10X6G10X6_UNORM_2PACK16") == 0) {
+			return VK_FORMAT_R10X6G10X6_UNORM_2PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_R10X6G10X6B10X6A10X6_UNORM_4PACK16") == 0) {
+			return VK_FORMAT_R10X6G10X6B10X6A10X6_UNORM_4PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_G10X6B10X6G10X6R10X6_422_UNORM_4PACK16") == 0) {
+			return VK_FORMAT_G10X6B10X6G10X6R10X6_422_UNORM_4PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_B10X6G10X6R10X6G10X6_422_UNORM_4PACK16") == 0) {
+			return VK_FORMAT_B10X6G10X6R10X6G10X6_422_UNORM_4PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_420_UNORM_3PACK16") == 0) {
+			return VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_420_UNORM_3PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16") == 0) {
+			return VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_422_UNORM_3PACK16") == 0) {
+			return VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_422_UNORM_3PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_G10X6_B10X6R10X6_2PLANE_422_UNORM_3PACK16") == 0) {
+			return VK_FORMAT_G10X6_B10X6R10X6_2PLANE_422_UNORM_3PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_444_UNORM_3PACK16") == 0) {
+			return VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_444_UNORM_3PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_R12X4_UNORM_PACK16") == 0) {
+			return VK_FORMAT_R12X4_UNORM_PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_R12X4G12X4_UNORM_2PACK16") == 0) {
+			return VK_FORMAT_R12X4G12X4_UNORM_2PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_R12X4G12X4B12X4A12X4_UNORM_4PACK16") == 0) {
+			return VK_FORMAT_R12X4G12X4B12X4A12X4_UNORM_4PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_G12X4B12X4G12X4R12X4_422_UNORM_4PACK16") == 0) {
+			return VK_FORMAT_G12X4B12X4G12X4R12X4_422_UNORM_4PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_B12X4G12X4R12X4G12X4_422_UNORM_4PACK16") == 0) {
+			return VK_FORMAT_B12X4G12X4R12X4G12X4_422_UNORM_4PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_420_UNORM_3PACK16") == 0) {
+			return VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_420_UNORM_3PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_G12X4_B12X4R12X4_2PLANE_420_UNORM_3PACK16") == 0) {
+			return VK_FORMAT_G12X4_B12X4R12X4_2PLANE_420_UNORM_3PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_422_UNORM_3PACK16") == 0) {
+			return VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_422_UNORM_3PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16") == 0) {
+			return VK_FORMAT_G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_444_UNORM_3PACK16") == 0) {
+			return VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_444_UNORM_3PACK16;
+		}
+		if (strcmp(format, "VK_FORMAT_G16B16G16R16_422_UNORM") == 0) {
+			return VK_FORMAT_G16B16G16R16_422_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_B16G16R16G16_422_UNORM") == 0) {
+			return VK_FORMAT_B16G16R16G16_422_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_G16_B16_R16_3PLANE_420_UNORM") == 0) {
+			return VK_FORMAT_G16_B16_R16_3PLANE_420_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_G16_B16R16_2PLANE_420_UNORM") == 0) {
+			return VK_FORMAT_G16_B16R16_2PLANE_420_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_G16_B16_R16_3PLANE_422_UNORM") == 0) {
+			return VK_FORMAT_G16_B16_R16_3PLANE_422_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_G16_B16R16_2PLANE_422_UNORM") == 0) {
+			return VK_FORMAT_G16_B16R16_2PLANE_422_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_G16_B16_R16_3PLANE_444_UNORM") == 0) {
+			return VK_FORMAT_G16_B16_R16_3PLANE_444_UNORM;
+		}
+		if (strcmp(format, "VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG") == 0) {
+			return VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG;
+		}
+		if (strcmp(format, "VK_FORMAT_PVRTC1_4BPP_UNORM_BLOCK_IMG") == 0) {
+			return VK_FORMAT_PVRTC1_4BPP_UNORM_BLOCK_IMG;
+		}
+		if (strcmp(format, "VK_FORMAT_PVRTC2_2BPP_UNORM_BLOCK_IMG") == 0) {
+			return VK_FORMAT_PVRTC2_2BPP_UNORM_BLOCK_IMG;
+		}
+		if (strcmp(format, "VK_FORMAT_PVRTC2_4BPP_UNORM_BLOCK_IMG") == 0) {
+			return VK_FORMAT_PVRTC2_4BPP_UNORM_BLOCK_IMG;
+		}
+		if (strcmp(format, "VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG") == 0) {
+			return VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG;
+		}
+		if (strcmp(format, "VK_FORMAT_PVRTC1_4BPP_SRGB_BLOCK_IMG") == 0) {
+			return VK_FORMAT_PVRTC1_4BPP_SRGB_BLOCK_IMG;
+		}
+		if (strcmp(format, "VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG") == 0) {
+			return VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG;
+		}
+		if (strcmp(format, "VK_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG") == 0) {
+			return VK_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_4x4_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_4x4_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_5x4_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_5x4_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_5x5_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_5x5_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_6x5_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_6x5_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_6x6_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_6x6_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_8x5_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_8x5_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_8x6_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_8x6_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_8x8_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_8x8_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_10x5_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_10x5_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_10x6_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_10x6_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_10x8_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_10x8_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_10x10_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_10x10_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_12x10_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_12x10_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_ASTC_12x12_SFLOAT_BLOCK_EXT") == 0) {
+			return VK_FORMAT_ASTC_12x12_SFLOAT_BLOCK_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_G8_B8R8_2PLANE_444_UNORM_EXT") == 0) {
+			return VK_FORMAT_G8_B8R8_2PLANE_444_UNORM_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_G10X6_B10X6R10X6_2PLANE_444_UNORM_3PACK16_EXT") == 0) {
+			return VK_FORMAT_G10X6_B10X6R10X6_2PLANE_444_UNORM_3PACK16_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_G12X4_B12X4R12X4_2PLANE_444_UNORM_3PACK16_EXT") == 0) {
+			return VK_FORMAT_G12X4_B12X4R12X4_2PLANE_444_UNORM_3PACK16_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_G16_B16R16_2PLANE_444_UNORM_EXT") == 0) {
+			return VK_FORMAT_G16_B16R16_2PLANE_444_UNORM_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_A4R4G4B4_UNORM_PACK16_EXT") == 0) {
+			return VK_FORMAT_A4R4G4B4_UNORM_PACK16_EXT;
+		}
+		if (strcmp(format, "VK_FORMAT_A4B4G4R4_UNORM_PACK16_EXT") == 0) {
+			return VK_FORMAT_A4B4G4R4_UNORM_PACK16_EXT;
+		}
+
+		return VK_FORMAT_UNDEFINED;
+	}
+
+
+	VkAttachmentLoadOp StringToLoadOp(const char* l_op)
+	{
+		if (strcmp(l_op, "VK_ATTACHMENT_LOAD_OP_LOAD") == 0) {
+			return VK_ATTACHMENT_LOAD_OP_LOAD;
+		}
+		if (strcmp(l_op, "VK_ATTACHMENT_LOAD_OP_CLEAR") == 0) {
+			return VK_ATTACHMENT_LOAD_OP_CLEAR;
+		}
+		if (strcmp(l_op, "VK_ATTACHMENT_LOAD_OP_DONT_CARE") == 0) {
+			return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		}
+		
+
+		return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	}
+
+
+	VkAttachmentStoreOp StringToStoreOp(const char* l_op)
+	{
+		if (strcmp(l_op, "VK_ATTACHMENT_STORE_OP_STORE") == 0) {
+			return VK_ATTACHMENT_STORE_OP_STORE;
+		}
+		else if (strcmp(l_op, "VK_ATTACHMENT_STORE_OP_DONT_CARE") == 0) {
+			return VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		}
+
+		return VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	}
+
+
+	VkImageLayout StringToVkImageLayout(const char* l_op)
+	{
+		if (strcmp(l_op, "VK_IMAGE_LAYOUT_UNDEFINED") == 0) {
+			return VK_IMAGE_LAYOUT_UNDEFINED;
+		}
+		else if (strcmp(l_op, "VK_IMAGE_LAYOUT_GENERAL") == 0) {
+			return VK_IMAGE_LAYOUT_GENERAL;
+
+		}
+		else if (strcmp(l_op, "VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL") == 0) {
+			return VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+		}
+		else if (strcmp(l_op, "VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL") == 0) {
+			return VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+		}
+		else if (strcmp(l_op, "VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL") == 0) {
+			return VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+		}
+		else if (strcmp(l_op, "VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL") == 0) {
+			return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		}
+		else if (strcmp(l_op, "VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL") == 0) {
+			return VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+		}
+		else if (strcmp(l_op, "VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL") == 0) {
+			return VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+
+		}
+		else if (strcmp(l_op, "VK_IMAGE_LAYOUT_PRESENT_SRC_KHR") == 0) {
+			return VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		}
+		return VK_IMAGE_LAYOUT_UNDEFINED;
+
+	}
+
+
+	VkSamplerAddressMode StringToVkSamplerAddressMode(const char* l_samplerMode)
+	{
+		if (strcmp(l_samplerMode, "VK_SAMPLER_ADDRESS_MODE_REPEAT") == 0) {
+			return VK_SAMPLER_ADDRESS_MODE_REPEAT;
+		}
+		else if (strcmp(l_samplerMode, "VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT") == 0) {
+			return VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+		}
+		else if (strcmp(l_samplerMode, "VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE") == 0) {
+			return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		}
+		else if (strcmp(l_samplerMode, "VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER") == 0) {
+			return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+		}
+
+		return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+	}
+
+}
\ No newline at end of file
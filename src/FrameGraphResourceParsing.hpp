@@ -0,0 +1,57 @@
+#pragma once
+
+
+
+#include <cinttypes>
+#include <string>
+#include <rapidjson/fwd.h>
+#include "volk.h"
+#include "GpuMemoryAllocator.hpp"
+
+
+
+namespace VulkanEngine
+{
+
+	//Every texture the frame graph creates on the GPU is this wide and high, "Resolution" of the json is not used for it
+	constexpr uint32_t lv_frameGraphTextureExtent = 1024;
+
+
+	struct FrameGraphResourceInfo
+	{
+		bool m_createOnGPU = false;
+
+		uint32_t	m_width = 0;
+		uint32_t	m_height = 0;
+		uint32_t	m_depth = 0;
+		uint32_t	m_mipLevels = 1;
+
+		VkSamplerAddressMode m_addressMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+
+		RenderCore::GpuMemoryCategory m_memoryCategory = RenderCore::GpuMemoryCategory::m_renderTargets;
+
+		VkFormat	m_format = VK_FORMAT_UNDEFINED;
+		VkImageUsageFlags	m_flags = 0;
+
+		VkImageLayout m_imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+		VkAttachmentLoadOp	m_loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		VkAttachmentStoreOp m_storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	};
+
+
+	//Parse one element of the "Input" or "Output" array of a render pass of the frame graph json.
+	//Nothing in here touches Vulkan, so the tests read the json through the same code as the frame graph.
+	FrameGraphResourceInfo ParseFrameGraphInputInfo(const rapidjson::Value& l_resource);
+	FrameGraphResourceInfo ParseFrameGraphOutputInfo(const rapidjson::Value& l_resource);
+
+	//Inputs whose name starts with "Depth" become the depth attachment of their render pass
+	bool IsFrameGraphDepthResource(const std::string& l_resourceName);
+
+	VkFormat StringToVkFormat(const char* format);
+	VkAttachmentLoadOp StringToLoadOp(const char* l_op);
+	VkAttachmentStoreOp StringToStoreOp(const char* l_op);
+	VkImageLayout StringToVkImageLayout(const char* l_op);
+	VkSamplerAddressMode StringToVkSamplerAddressMode(const char* l_samplerMode);
+
+}
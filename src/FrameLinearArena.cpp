@@ -0,0 +1,50 @@
+
+
+
+#include "FrameLinearArena.hpp"
+#include "ErrorCheck.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+
+namespace VulkanEngine
+{
+
+	FrameLinearArena::FrameLinearArena(size_t l_capacityInBytes)
+	{
+		m_memory.resize(l_capacityInBytes);
+	}
+
+
+	void* FrameLinearArena::Allocate(size_t l_sizeInBytes, size_t l_alignment)
+	{
+		using namespace ErrorCheck;
+
+		//The mask below rounds up correctly only for powers of two
+		if (0 == l_alignment || 0 != (l_alignment & (l_alignment - 1))) {
+			PRINT_EXIT("\nFrame linear arena alignment has to be a power of two.\n");
+		}
+
+		const size_t lv_alignedOffset = (m_offset + l_alignment - 1) & ~(l_alignment - 1);
+
+		if (lv_alignedOffset + l_sizeInBytes > m_memory.size()) {
+			PRINT_EXIT("\nFrame linear arena ran out of memory. Increase its capacity.\n");
+		}
+
+		m_offset = lv_alignedOffset + l_sizeInBytes;
+		m_peakOffset = std::max(m_peakOffset, m_offset);
+
+		return m_memory.data() + lv_alignedOffset;
+	}
+
+
+	void FrameLinearArena::Reset()
+	{
+		m_offset = 0;
+	}
+
+
+	size_t FrameLinearArena::GetCapacity() const { return m_memory.size(); }
+	size_t FrameLinearArena::GetUsedBytes() const { return m_offset; }
+	size_t FrameLinearArena::GetPeakUsedBytes() const { return m_peakOffset; }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+
+
+#include <cinttypes>
+#include <cstddef>
+#include <vector>
+
+
+
+namespace VulkanEngine
+{
+
+	//Bump allocator for transient data that only has to live during the recording of one frame
+	//(clear values, barrier lists, pointer lists...). The backing memory is allocated once at startup
+	//and is rewound by Reset() at the start of every frame, so the steady-state frame loop does not hit the heap.
+	class FrameLinearArena
+	{
+	public:
+
+		explicit FrameLinearArena(size_t l_capacityInBytes = 64 * 1024);
+
+		void* Allocate(size_t l_sizeInBytes, size_t l_alignment = alignof(std::max_align_t));
+
+		template<typename T>
+		T* Allocate(size_t l_totalNumElements)
+		{
+			return static_cast<T*>(Allocate(sizeof(T) * l_totalNumElements, alignof(T)));
+		}
+
+		void Reset();
+
+		size_t GetCapacity() const;
+		size_t GetUsedBytes() const;
+		size_t GetPeakUsedBytes() const;
+
+	private:
+
+		std::vector<uint8_t> m_memory;
+		size_t m_offset{ 0 };
+		size_t m_peakOffset{ 0 };
+	};
+
+}
@@ -3,7 +3,12 @@
 
 #include "GeometryConverter.hpp"
 #include "meshoptimizer.h"
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
 
 namespace MeshConverter
 {
@@ -25,11 +30,19 @@ namespace MeshConverter
 		const std::string& l_instanceDataFile,
 		bool l_includeTextureCoordinates,
 		bool l_includeNormals,
-		bool l_tangents)
+		bool l_tangents,
+		const VertexQuantizationSettings& l_vertexQuantization,
+		bool l_compressMeshData,
+		uint32_t l_totalNumThreads,
+		bool l_benchmarkThreads,
+		const MeshMergingSettings& l_meshMerging)
 	{
 		m_meshes.clear();
 		m_indexBuffer.clear();
+		m_meshlets.clear();
 		m_vertexBuffer.clear();
+		m_packedVertexBuffer.clear();
+		m_vertexFormat = VertexFormat::m_fp32;
 		m_outputInstanceData.clear();
 		m_boundingBoxes.clear();
 		m_includeNormals = l_includeNormals;
@@ -38,6 +51,7 @@ namespace MeshConverter
 		m_totalNumIndicesScene = 0;
 		m_totalNumVerticesScene = 0;
 		m_assimpScene = nullptr;
+		m_sourceMeshes.clear();
 		m_sceneConverter.reset();
 		
 
@@ -78,36 +92,51 @@ namespace MeshConverter
 		}
 
 
-		CalculateTotalNumVerticesAndIndicesOfScene(lv_scene);
+		//Positions are scaled by 0.05 in ConvertMesh(), the cell size of the merging is given after that scale
+		m_meshMerger.MergeScene(lv_scene, m_sceneConverter.value(), l_meshMerging, 0.05f, m_sourceMeshes);
+
+		if (true == l_meshMerging.m_enabled) {
+			m_meshMerger.PrintReport();
+		}
+
+		CalculateTotalNumVerticesAndIndicesOfScene();
 
 		uint32_t lv_numElementsVertexBuffer = 3;
 		if (true == m_includeTextureCoordinates) { lv_numElementsVertexBuffer += 2; }
 		if (true == m_includeNormals) { lv_numElementsVertexBuffer += 3; }
 		if (true == m_includeTangents) { lv_numElementsVertexBuffer += 4; }
 
-		m_meshes.reserve(lv_scene->mNumMeshes);
-		m_vertexBuffer.resize(m_totalNumVerticesScene * lv_numElementsVertexBuffer);
-		m_indexBuffer.resize(m_totalNumIndicesScene);
-		m_boundingBoxes.resize(lv_scene->mNumMeshes);
+		m_vertexStrideInBytes = lv_numElementsVertexBuffer * sizeof(float);
 
-		uint32_t lv_vertexOffset{};
-		uint32_t lv_indexOffset{};
-		for (uint32_t i = 0; i < lv_scene->mNumMeshes; ++i) {
-			ConvertMesh(lv_scene->mMeshes[i], lv_vertexOffset, lv_indexOffset);
-			CalculateBoundingBox(i, m_boundingBoxes[i], lv_scene->mMeshes[i]);
-			lv_vertexOffset += lv_scene->mMeshes[i]->mNumVertices*lv_numElementsVertexBuffer;
-			lv_indexOffset += lv_scene->mMeshes[i]->mNumFaces * 3 * lv_maxLODCount-1;
+		if (true == l_benchmarkThreads) {
+			BenchmarkConvertMeshes(l_totalNumThreads);
+		}
+		else {
+			const double lv_milliseconds = ConvertMeshes(l_totalNumThreads);
+			PrintMeshConversionReport();
+			printf("\nConverted %u meshes in %.2f ms.\n", (uint32_t)m_sourceMeshes.size(), lv_milliseconds);
 		}
 
 
 
 
+		if (true == l_vertexQuantization.m_enabled) {
+			QuantizeVertices(l_vertexQuantization);
+		}
+
+
 		MeshFileHeader lv_fileHeader{};
-		lv_fileHeader.m_magicValue = 0X12345678;
+		lv_fileHeader.m_magicValue = lv_meshFileMagicValue;
 		lv_fileHeader.m_lodDataSize = m_totalNumIndicesScene * sizeof(unsigned int);
-		lv_fileHeader.m_meshCount = lv_scene->mNumMeshes;
-		lv_fileHeader.m_vertexDataSize = m_totalNumVerticesScene * lv_numElementsVertexBuffer * sizeof(float);
+		lv_fileHeader.m_meshCount = (uint32_t)m_sourceMeshes.size();
+		lv_fileHeader.m_vertexDataSize = m_totalNumVerticesScene * m_vertexStrideInBytes;
 		lv_fileHeader.m_startBlockOffset = (uint32_t)(sizeof(MeshFileHeader) + sizeof(Mesh)*m_meshes.size());
+		lv_fileHeader.m_vertexFormat = m_vertexFormat;
+		lv_fileHeader.m_vertexStrideInBytes = m_vertexStrideInBytes;
+		lv_fileHeader.m_positionEncoding = l_vertexQuantization.m_positionEncoding;
+		lv_fileHeader.m_octahedralBits = l_vertexQuantization.m_octahedralBits;
+		lv_fileHeader.m_compression = (true == l_compressMeshData) ? MeshDataCompression::m_meshoptCodecs : MeshDataCompression::m_none;
+		lv_fileHeader.m_meshletCount = (uint32_t)m_meshlets.size();
 
 		SaveDataToMeshFileHeader(l_meshFileHeaders, lv_fileHeader);
 		printf("\n\nMesh data was successfully generated and saved.\n\n");
@@ -125,6 +154,19 @@ namespace MeshConverter
 	void GeometryConverter::SaveDataToMeshFileHeader(const std::string& l_meshFileHeader, 
 		MeshFileHeader& l_meshFileHeaderStructure)
 	{
+		const std::span<const uint8_t> lv_vertexData = (VertexFormat::m_packed == m_vertexFormat)
+			? std::span<const uint8_t>{ (const uint8_t*)m_packedVertexBuffer.data(), m_packedVertexBuffer.size() * sizeof(uint32_t) }
+			: std::span<const uint8_t>{ (const uint8_t*)m_vertexBuffer.data(), m_vertexBuffer.size() * sizeof(float) };
+
+		std::vector<CompressedStream> lv_compressedStreams{};
+		std::vector<uint8_t> lv_compressedData{};
+
+		if (MeshDataCompression::m_meshoptCodecs == l_meshFileHeaderStructure.m_compression) {
+			lv_compressedData = CompressMeshData(lv_vertexData, lv_compressedStreams);
+			l_meshFileHeaderStructure.m_compressedDataSize =
+				(uint32_t)(lv_compressedStreams.size() * sizeof(CompressedStream) + lv_compressedData.size());
+		}
+
 		FILE* lv_meshFileHeader = fopen(l_meshFileHeader.c_str(), "wb");
 
 		if (nullptr == lv_meshFileHeader) {
@@ -134,33 +176,311 @@ namespace MeshConverter
 
 		fwrite(&l_meshFileHeaderStructure, sizeof(MeshFileHeader), 1, lv_meshFileHeader);
 		fwrite(m_meshes.data(), sizeof(Mesh), m_meshes.size(), lv_meshFileHeader);
-		fwrite(m_vertexBuffer.data(), sizeof(float), m_vertexBuffer.size(), lv_meshFileHeader);
-		fwrite(m_indexBuffer.data(), sizeof(unsigned int), m_indexBuffer.size(), lv_meshFileHeader);
+
+		if (MeshDataCompression::m_meshoptCodecs == l_meshFileHeaderStructure.m_compression) {
+			fwrite(lv_compressedStreams.data(), sizeof(CompressedStream), lv_compressedStreams.size(), lv_meshFileHeader);
+			fwrite(lv_compressedData.data(), 1, lv_compressedData.size(), lv_meshFileHeader);
+		}
+		else {
+			fwrite(lv_vertexData.data(), 1, lv_vertexData.size(), lv_meshFileHeader);
+			fwrite(m_indexBuffer.data(), sizeof(unsigned int), m_indexBuffer.size(), lv_meshFileHeader);
+		}
+
+		fwrite(m_meshlets.data(), sizeof(Meshlet), m_meshlets.size(), lv_meshFileHeader);
+
 		fclose(lv_meshFileHeader);
 	}
 
 
-	void GeometryConverter::CalculateTotalNumVerticesAndIndicesOfScene(const aiScene* l_scene)
+	std::vector<uint8_t> GeometryConverter::CompressMeshData(std::span<const uint8_t> l_vertexData,
+		std::vector<CompressedStream>& l_streams)
+	{
+		const auto lv_start = std::chrono::steady_clock::now();
+
+		auto lv_compressedData = EncodeMeshData(m_meshes, l_vertexData, m_vertexStrideInBytes, m_indexBuffer, l_streams);
+
+		const double lv_encodeMilliseconds =
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lv_start).count();
+
+		uint64_t lv_compressedVertexBytes{};
+		uint64_t lv_rawVertexBytes{};
+		uint64_t lv_rawIndexBytes{};
+
+		for (uint32_t i = 0; i < (uint32_t)m_meshes.size(); ++i) {
+			lv_compressedVertexBytes += l_streams[i * lv_compressedStreamsPerMesh].m_sizeInBytes;
+			lv_rawVertexBytes += (uint64_t)m_meshes[i].m_vertexCount * m_vertexStrideInBytes;
+
+			for (uint32_t j = 0; j < m_meshes[i].m_lodCount; ++j) {
+				lv_rawIndexBytes += m_meshes[i].CalculateLODSize(j);
+			}
+		}
+
+		const uint64_t lv_compressedIndexBytes = lv_compressedData.size() - lv_compressedVertexBytes;
+		constexpr double lv_bytesPerMB = 1024. * 1024.;
+
+		printf("\nMesh data compressed in %.2f ms:\n", lv_encodeMilliseconds);
+		printf("  Vertices: %.2f -> %.2f MB (%.2fx)\n", lv_rawVertexBytes / lv_bytesPerMB, lv_compressedVertexBytes / lv_bytesPerMB,
+			(0U == lv_compressedVertexBytes) ? 1. : (double)lv_rawVertexBytes / (double)lv_compressedVertexBytes);
+		printf("  Indices:  %.2f -> %.2f MB (%.2fx)\n", lv_rawIndexBytes / lv_bytesPerMB, lv_compressedIndexBytes / lv_bytesPerMB,
+			(0U == lv_compressedIndexBytes) ? 1. : (double)lv_rawIndexBytes / (double)lv_compressedIndexBytes);
+
+		//Decoding into fresh buffers both checks the round trip and measures what the renderer will see on load
+		std::vector<uint8_t> lv_decodedVertices(l_vertexData.size());
+		std::vector<uint32_t> lv_decodedIndices(m_indexBuffer.size());
+		MeshDecodeStats lv_decodeStats{};
+
+		bool lv_roundTripFailed = (false == DecodeMeshData(m_meshes, m_vertexStrideInBytes, l_streams, lv_compressedData,
+			lv_decodedVertices, lv_decodedIndices, 0U, lv_decodeStats)) ||
+			0 != memcmp(lv_decodedVertices.data(), l_vertexData.data(), l_vertexData.size());
+
+		//The index codec may rotate the corners of a triangle, the winding stays the same
+		for (uint32_t i = 0; i < (uint32_t)m_meshes.size() && false == lv_roundTripFailed; ++i) {
+			for (uint32_t j = 0; j < m_meshes[i].m_lodCount; ++j) {
+
+				const Mesh& lv_mesh = m_meshes[i];
+				const uint32_t lv_totalNumIndices = lv_mesh.CalculateLODNumberOfIndices(j);
+
+				for (uint32_t k = 0; k + 2 < lv_totalNumIndices; k += 3) {
+					const uint32_t lv_original[3]{ lv_mesh.ReadLODIndex(m_indexBuffer.data(), j, k),
+						lv_mesh.ReadLODIndex(m_indexBuffer.data(), j, k + 1), lv_mesh.ReadLODIndex(m_indexBuffer.data(), j, k + 2) };
+					const uint32_t lv_decoded[3]{ lv_mesh.ReadLODIndex(lv_decodedIndices.data(), j, k),
+						lv_mesh.ReadLODIndex(lv_decodedIndices.data(), j, k + 1), lv_mesh.ReadLODIndex(lv_decodedIndices.data(), j, k + 2) };
+
+					bool lv_sameTriangle{ false };
+
+					for (uint32_t r = 0; r < 3; ++r) {
+						lv_sameTriangle = lv_sameTriangle || (lv_original[0] == lv_decoded[r] &&
+							lv_original[1] == lv_decoded[(r + 1) % 3] && lv_original[2] == lv_decoded[(r + 2) % 3]);
+					}
+
+					lv_roundTripFailed = lv_roundTripFailed || (false == lv_sameTriangle);
+				}
+			}
+		}
+
+		if (true == lv_roundTripFailed) {
+			printf("Compressed mesh data does not decode back to the original data.\n");
+			exit(EXIT_FAILURE);
+		}
+
+		PrintDecodeStats(lv_decodeStats);
+
+		return lv_compressedData;
+	}
+
+
+	double GeometryConverter::ConvertMeshes(uint32_t l_totalNumThreads)
 	{
-		uint32_t lv_totalNumMeshes{l_scene->mNumMeshes};
+		const uint32_t lv_totalNumMeshes = (uint32_t)m_sourceMeshes.size();
+		const uint32_t lv_numElementsVertexBuffer = m_vertexStrideInBytes / sizeof(float);
+
+		if (0U == l_totalNumThreads) {
+			l_totalNumThreads = std::max(1U, std::thread::hardware_concurrency());
+		}
+		l_totalNumThreads = std::max(1U, std::min(l_totalNumThreads, lv_totalNumMeshes));
 
+		//Index ranges of the LODs leave gaps, they have to hold the same bytes on every run
+		m_meshes.assign(lv_totalNumMeshes, Mesh{});
+		m_meshlets.clear();
+		m_vertexBuffer.assign((size_t)m_totalNumVerticesScene * lv_numElementsVertexBuffer, 0.f);
+		m_indexBuffer.assign(m_totalNumIndicesScene, 0U);
+		m_boundingBoxes.assign(lv_totalNumMeshes, BoundingBox{});
+
+		std::vector<uint32_t> lv_vertexOffsets(lv_totalNumMeshes);
+		std::vector<uint32_t> lv_indexOffsets(lv_totalNumMeshes);
+		std::vector<std::vector<Meshlet>> lv_meshletsOfMeshes(lv_totalNumMeshes);
+
+		uint32_t lv_vertexOffset{};
+		uint32_t lv_indexOffset{};
 		for (uint32_t i = 0; i < lv_totalNumMeshes; ++i) {
-			m_totalNumVerticesScene += l_scene->mMeshes[i]->mNumVertices;
-			m_totalNumIndicesScene += l_scene->mMeshes[i]->mNumFaces * 3 * lv_maxLODCount-1;
+			lv_vertexOffsets[i] = lv_vertexOffset;
+			lv_indexOffsets[i] = lv_indexOffset;
+			lv_vertexOffset += m_sourceMeshes[i]->mNumVertices*lv_numElementsVertexBuffer;
+			lv_indexOffset += m_sourceMeshes[i]->mNumFaces * 3 * lv_maxLODCount-1;
 		}
 
+		std::atomic<uint32_t> lv_nextMeshIndex{ 0 };
+
+		//Meshes differ a lot in size, threads keep taking the next one instead of a fixed share
+		const auto lv_convertMeshes = [&]()
+			{
+				for (uint32_t i = lv_nextMeshIndex++; i < lv_totalNumMeshes; i = lv_nextMeshIndex++) {
+					ConvertMesh(m_sourceMeshes[i], lv_vertexOffsets[i], lv_indexOffsets[i], m_meshes[i], lv_meshletsOfMeshes[i]);
+					CalculateBoundingBox(i, m_boundingBoxes[i], m_sourceMeshes[i]);
+				}
+			};
+
+		const auto lv_start = std::chrono::steady_clock::now();
+
+		std::vector<std::thread> lv_workers{};
+		lv_workers.reserve(l_totalNumThreads - 1);
+
+		for (uint32_t i = 1; i < l_totalNumThreads; ++i) {
+			lv_workers.emplace_back(lv_convertMeshes);
+		}
+
+		lv_convertMeshes();
+
+		for (auto& l_worker : lv_workers) {
+			l_worker.join();
+		}
+
+		//Appending in mesh order keeps the meshlet buffer the same as a serial conversion
+		for (uint32_t i = 0; i < lv_totalNumMeshes; ++i) {
+			const uint32_t lv_firstMeshlet = (uint32_t)m_meshlets.size();
+
+			for (uint32_t j = 0; j <= m_meshes[i].m_lodCount; ++j) {
+				m_meshes[i].m_lodMeshletOffsets[j] += lv_firstMeshlet;
+			}
+
+			m_meshlets.insert(m_meshlets.end(), lv_meshletsOfMeshes[i].begin(), lv_meshletsOfMeshes[i].end());
+		}
+
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lv_start).count();
+	}
+
+
+	void GeometryConverter::BenchmarkConvertMeshes(uint32_t l_maxNumThreads)
+	{
+		if (0U == l_maxNumThreads) {
+			l_maxNumThreads = std::max(1U, std::thread::hardware_concurrency());
+		}
+
+		std::vector<double> lv_milliseconds(l_maxNumThreads);
+
+		lv_milliseconds[0] = ConvertMeshes(1U);
+
+		const std::vector<Mesh> lv_serialMeshes = m_meshes;
+		const std::vector<float> lv_serialVertices = m_vertexBuffer;
+		const std::vector<unsigned int> lv_serialIndices = m_indexBuffer;
+		const std::vector<Meshlet> lv_serialMeshlets = m_meshlets;
+
+		for (uint32_t i = 2; i <= l_maxNumThreads; ++i) {
+			lv_milliseconds[i - 1] = ConvertMeshes(i);
+
+			const bool lv_identical = 0 == memcmp(m_meshes.data(), lv_serialMeshes.data(), m_meshes.size() * sizeof(Mesh)) &&
+				0 == memcmp(m_vertexBuffer.data(), lv_serialVertices.data(), m_vertexBuffer.size() * sizeof(float)) &&
+				0 == memcmp(m_indexBuffer.data(), lv_serialIndices.data(), m_indexBuffer.size() * sizeof(unsigned int)) &&
+				m_meshlets.size() == lv_serialMeshlets.size() &&
+				0 == memcmp(m_meshlets.data(), lv_serialMeshlets.data(), m_meshlets.size() * sizeof(Meshlet));
+
+			if (false == lv_identical) {
+				printf("Mesh conversion on %u threads differs from the conversion on one thread.\n", i);
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		PrintMeshConversionReport();
+
+		printf("\nConversion times of %u meshes:\n", (uint32_t)m_sourceMeshes.size());
+		for (uint32_t i = 1; i <= l_maxNumThreads; ++i) {
+			printf("  %2u threads: %10.2f ms (%.2fx)\n", i, lv_milliseconds[i - 1], lv_milliseconds[0] / lv_milliseconds[i - 1]);
+		}
 	}
 
 
+	void GeometryConverter::PrintMeshConversionReport() const
+	{
+		uint32_t lv_totalNum16BitMeshes{};
+		uint64_t lv_indexBytes{};
+		uint64_t lv_32BitIndexBytes{};
+
+		for (uint32_t i = 0; i < (uint32_t)m_meshes.size(); ++i) {
+
+			const auto& lv_mesh = m_meshes[i];
+			const uint32_t lv_lodBytes = lv_mesh.m_lodOffsets[lv_mesh.m_lodCount] - lv_mesh.m_lodOffsets[0];
+
+			lv_totalNum16BitMeshes += (sizeof(uint16_t) == lv_mesh.m_indexSizeInBytes) ? 1U : 0U;
+			lv_indexBytes += lv_lodBytes;
+			lv_32BitIndexBytes += lv_lodBytes / lv_mesh.m_indexSizeInBytes * sizeof(uint32_t);
+
+			printf("\n----------------------\n");
+			printf("\nConverted mesh %s\n\n", m_sourceMeshes[i]->mName.C_Str());
+			printf("First index: %u, %u bit indices\n", (uint32_t)(lv_mesh.m_lodOffsets[0] / lv_mesh.m_indexSizeInBytes),
+				lv_mesh.m_indexSizeInBytes * 8U);
+
+			for (uint32_t j = 0; j < lv_mesh.m_lodCount; ++j) {
+				printf("LOD %u: %u indices, error %f\n", j, lv_mesh.CalculateLODNumberOfIndices(j), lv_mesh.m_lodErrors[j]);
+			}
+
+			printf("Meshlets of all LODs: %u\n", lv_mesh.m_lodMeshletOffsets[lv_mesh.m_lodCount] - lv_mesh.m_lodMeshletOffsets[0]);
+		}
+
+		printf("Total num of indices of the scene: %u\n", m_totalNumIndicesScene);
+		printf("%u of %u meshes use 16 bit indices, indices of all LODs take %.2f MB instead of %.2f MB.\n\n",
+			lv_totalNum16BitMeshes, (uint32_t)m_meshes.size(), lv_indexBytes / (1024. * 1024.), lv_32BitIndexBytes / (1024. * 1024.));
+	}
+
+
+	void GeometryConverter::CalculateTotalNumVerticesAndIndicesOfScene()
+	{
+		uint32_t lv_totalNumMeshes{(uint32_t)m_sourceMeshes.size()};
+
+		for (uint32_t i = 0; i < lv_totalNumMeshes; ++i) {
+			m_totalNumVerticesScene += m_sourceMeshes[i]->mNumVertices;
+			m_totalNumIndicesScene += m_sourceMeshes[i]->mNumFaces * 3 * lv_maxLODCount-1;
+		}
+
+	}
+
+
+
+	void GeometryConverter::QuantizeVertices(const VertexQuantizationSettings& l_vertexQuantization)
+	{
+		//The packed layout has a fixed set of attributes
+		if (false == (m_includeTextureCoordinates && m_includeNormals && m_includeTangents)) {
+			printf("Vertex quantization needs texture coordinates, normals and tangents.\n");
+			exit(EXIT_FAILURE);
+		}
+
+		VertexQuantizer lv_quantizer{ l_vertexQuantization };
+
+		m_packedVertexBuffer.resize(m_totalNumVerticesScene * lv_packedVertexSizeInWords);
+
+		uint32_t lv_packedVertexOffset{};
+
+		for (auto& l_mesh : m_meshes) {
+
+			const std::span<const float> lv_meshVertices{ m_vertexBuffer.data() + l_mesh.m_streamOffsets[0] / sizeof(float),
+				l_mesh.m_vertexCount * lv_fp32VertexSizeInFloats };
+			const std::span<uint32_t> lv_packedVertices{ m_packedVertexBuffer.data() + lv_packedVertexOffset,
+				l_mesh.m_vertexCount * lv_packedVertexSizeInWords };
+
+			lv_quantizer.QuantizeMesh(lv_meshVertices, l_mesh, lv_packedVertices);
+
+			//All attributes live in one interleaved stream now
+			const uint32_t lv_indicesSizeInBytes = l_mesh.m_meshSize - l_mesh.m_vertexCount * m_vertexStrideInBytes;
+
+			l_mesh.m_streamCount = 1;
+			l_mesh.m_streamOffsets[0] = lv_packedVertexOffset * sizeof(uint32_t);
+			l_mesh.m_streamElementSizes[0] = lv_packedVertexSizeInWords * sizeof(uint32_t);
+			l_mesh.m_meshSize = l_mesh.m_vertexCount * lv_packedVertexSizeInWords * sizeof(uint32_t) + lv_indicesSizeInBytes;
+
+			lv_packedVertexOffset += l_mesh.m_vertexCount * lv_packedVertexSizeInWords;
+		}
+
+		lv_quantizer.PrintErrorReport();
+
+		//LODs were generated from the fp32 positions, nothing needs them past this point
+		m_vertexBuffer = std::vector<float>{};
+		m_vertexFormat = VertexFormat::m_packed;
+		m_vertexStrideInBytes = lv_packedVertexSizeInWords * sizeof(uint32_t);
+	}
+
 
 	void GeometryConverter::GenerateMeshLODs(std::span<unsigned int> l_originalIndices,
 		std::span<float> l_meshVertices,
 		uint32_t l_totalNumStreams,
-		std::array<std::vector<unsigned int>, lv_maxLODCount-1>& l_lods)
+		std::array<std::vector<unsigned int>, lv_maxLODCount-1>& l_lods,
+		std::array<float, lv_maxLODCount-1>& l_lodErrors)
 	{
 		std::vector<unsigned int> lv_tempIndices{};
 		uint32_t lv_lodCount{};
 
+		//meshopt reports errors relative to the mesh extents
+		const float lv_errorScale = meshopt_simplifyScale(l_meshVertices.data(), l_meshVertices.size() / l_totalNumStreams,
+			sizeof(float) * l_totalNumStreams);
+
 		lv_tempIndices.resize(l_originalIndices.size());
 		for (uint32_t i = 0; i < lv_tempIndices.size(); ++i) {
 			lv_tempIndices[i] = l_originalIndices[i];
@@ -169,24 +489,30 @@ namespace MeshConverter
 		
 
 		l_lods[0] = lv_tempIndices;
+		l_lodErrors[0] = 0.f;
 		++lv_lodCount;
 
 
 		while (lv_lodCount < lv_maxLODCount-1) {
 
+			float lv_error{};
+
 			auto lv_numReducedIndices = meshopt_simplify(lv_tempIndices.data(), lv_tempIndices.data()
 				, lv_tempIndices.size(), l_meshVertices.data(), l_meshVertices.size()/ l_totalNumStreams,
-				sizeof(float)*l_totalNumStreams, lv_tempIndices.size() * 0.5, 0, nullptr);
+				sizeof(float)*l_totalNumStreams, lv_tempIndices.size() * 0.5, 0, &lv_error);
 
 
 			if (lv_numReducedIndices * 1.1f > lv_tempIndices.size()) {
 
 				lv_numReducedIndices = meshopt_simplifySloppy(lv_tempIndices.data(), lv_tempIndices.data()
 					, lv_tempIndices.size(), l_meshVertices.data(), l_meshVertices.size() / l_totalNumStreams,
-					sizeof(float) * l_totalNumStreams, lv_tempIndices.size() * 0.5, 0, nullptr);
+					sizeof(float) * l_totalNumStreams, lv_tempIndices.size() * 0.5, 0, &lv_error);
 
 			}
 
+			//Every LOD is simplified from the previous one, so the errors add up
+			l_lodErrors[lv_lodCount] = l_lodErrors[lv_lodCount - 1] + lv_error * lv_errorScale;
+
 
 			lv_tempIndices.resize(lv_numReducedIndices);
 
@@ -205,13 +531,63 @@ namespace MeshConverter
 	}
 
 
-	void GeometryConverter::ConvertMesh(const aiMesh* l_mesh, uint32_t& l_vertexOffset,
-		uint32_t& l_indexOffset)
+	void GeometryConverter::GenerateMeshlets(std::span<unsigned int> l_lodIndices, std::span<const float> l_meshVertices,
+		uint32_t l_totalNumStreams, std::vector<Meshlet>& l_meshlets)
 	{
+		//Trades a little meshlet size for tighter normal cones, which is what the backface test lives on
+		constexpr float lv_coneWeight{ 0.25f };
+
+		const size_t lv_totalNumVertices = l_meshVertices.size() / l_totalNumStreams;
+		const size_t lv_vertexStride = sizeof(float) * l_totalNumStreams;
+		const size_t lv_maxNumMeshlets = meshopt_buildMeshletsBound(l_lodIndices.size(), lv_maxMeshletVertices, lv_maxMeshletTriangles);
+
+		std::vector<meshopt_Meshlet> lv_meshlets(lv_maxNumMeshlets);
+		std::vector<unsigned int> lv_meshletVertices(lv_maxNumMeshlets * lv_maxMeshletVertices);
+		std::vector<unsigned char> lv_meshletTriangles(lv_maxNumMeshlets * lv_maxMeshletTriangles * 3);
+
+		lv_meshlets.resize(meshopt_buildMeshlets(lv_meshlets.data(), lv_meshletVertices.data(), lv_meshletTriangles.data(),
+			l_lodIndices.data(), l_lodIndices.size(), l_meshVertices.data(), lv_totalNumVertices, lv_vertexStride,
+			lv_maxMeshletVertices, lv_maxMeshletTriangles, lv_coneWeight));
+
+		uint32_t lv_firstIndex{};
+
+		for (const auto& l_meshlet : lv_meshlets) {
+
+			const meshopt_Bounds lv_bounds = meshopt_computeMeshletBounds(lv_meshletVertices.data() + l_meshlet.vertex_offset,
+				lv_meshletTriangles.data() + l_meshlet.triangle_offset, l_meshlet.triangle_count,
+				l_meshVertices.data(), lv_totalNumVertices, lv_vertexStride);
 
-		printf("\n----------------------\n");
-		printf("\nConverting mesh %s\n\n", l_mesh->mName.C_Str());
+			Meshlet lv_meshlet{};
+			lv_meshlet.m_radius = lv_bounds.radius;
+			lv_meshlet.m_coneCutoff = lv_bounds.cone_cutoff;
+			lv_meshlet.m_firstIndex = lv_firstIndex;
+			lv_meshlet.m_totalNumIndices = l_meshlet.triangle_count * 3;
 
+			for (uint32_t i = 0; i < 3; ++i) {
+				lv_meshlet.m_center[i] = lv_bounds.center[i];
+				lv_meshlet.m_coneAxis[i] = lv_bounds.cone_axis[i];
+			}
+
+			//Micro indices back to mesh local ones, so a meshlet is drawn as a plain run of the LOD
+			for (uint32_t i = 0; i < lv_meshlet.m_totalNumIndices; ++i) {
+				l_lodIndices[lv_firstIndex + i] =
+					lv_meshletVertices[l_meshlet.vertex_offset + lv_meshletTriangles[l_meshlet.triangle_offset + i]];
+			}
+
+			lv_firstIndex += lv_meshlet.m_totalNumIndices;
+			l_meshlets.push_back(lv_meshlet);
+		}
+
+		if (lv_firstIndex != (uint32_t)l_lodIndices.size()) {
+			printf("Meshlets do not cover every triangle of the LOD.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+
+	void GeometryConverter::ConvertMesh(const aiMesh* l_mesh, uint32_t l_vertexOffset,
+		uint32_t l_indexOffset, Mesh& l_outputMesh, std::vector<Meshlet>& l_meshlets)
+	{
 		uint32_t lv_numIndices = l_mesh->mNumFaces * 3;
 		uint32_t lv_numElementsVertexBuffer = 3;
 		uint32_t lv_streamCount = 1;
@@ -340,7 +716,6 @@ namespace MeshConverter
 		}
 
 		uint32_t lv_realNumIndices{};
-		printf("\nl_indexOffset: %d\n", l_indexOffset);
 		for (uint32_t i = 0, j = 0; i < l_mesh->mNumFaces && j < l_mesh->mNumFaces*3; ++i, j+=3) {
 
 			if (l_mesh->mFaces[i].mNumIndices == 3) {
@@ -356,26 +731,43 @@ namespace MeshConverter
 		std::span<unsigned int> lv_meshIndices{&m_indexBuffer[l_indexOffset], lv_realNumIndices};
 		std::span<float> lv_meshVertices{&m_vertexBuffer[l_vertexOffset], l_mesh->mNumVertices*lv_numElementsVertexBuffer};
 		std::array<std::vector<unsigned int>, lv_maxLODCount-1> lv_meshLOD{};
+		std::array<float, lv_maxLODCount-1> lv_lodErrors{};
 
-		GenerateMeshLODs(lv_meshIndices, lv_meshVertices, lv_numElementsVertexBuffer, lv_meshLOD);
+		GenerateMeshLODs(lv_meshIndices, lv_meshVertices, lv_numElementsVertexBuffer, lv_meshLOD, lv_lodErrors);
 
 
 		uint32_t lv_indexCount{l_indexOffset + lv_realNumIndices};
 		for (uint32_t j = 1; j < lv_maxLODCount - 1; ++j) {
-			printf("LOD size: %u\n", (uint32_t)lv_meshLOD[j].size());
 			for (uint32_t i = 0; i < lv_meshLOD[j].size(); ++i) {
 				m_indexBuffer[lv_indexCount + i] = (lv_meshLOD[j][i]);
 			}
 			lv_indexCount += lv_meshLOD[j].size();
 		}
 
-		printf("\nLOD of this mesh was processed and copied successfully.\n");
-		printf("Total num of indices of the scene: %u\n\n", m_totalNumIndicesScene);
-
-
 		Mesh lv_mesh{};
 		lv_mesh.m_lodCount = lv_maxLODCount-1;
 
+		for (uint32_t i = 0; i < lv_mesh.m_lodCount; ++i) {
+			lv_mesh.m_lodErrors[i] = lv_lodErrors[i];
+		}
+
+		//Centered on the box of the positions, the radius reaches the farthest vertex
+		{
+			const glm::vec3 lv_center = 0.025f * glm::vec3{ l_mesh->mAABB.mMin.x + l_mesh->mAABB.mMax.x,
+				l_mesh->mAABB.mMin.y + l_mesh->mAABB.mMax.y, l_mesh->mAABB.mMin.z + l_mesh->mAABB.mMax.z };
+			float lv_radius{};
+
+			for (uint32_t i = 0; i < l_mesh->mNumVertices; ++i) {
+				const float* lv_position = lv_meshVertices.data() + i * lv_numElementsVertexBuffer;
+				lv_radius = std::max(lv_radius, glm::length(glm::vec3{ lv_position[0], lv_position[1], lv_position[2] } - lv_center));
+			}
+
+			lv_mesh.m_boundingSphere[0] = lv_center.x;
+			lv_mesh.m_boundingSphere[1] = lv_center.y;
+			lv_mesh.m_boundingSphere[2] = lv_center.z;
+			lv_mesh.m_boundingSphere[3] = lv_radius;
+		}
+
 		uint32_t lv_lodOffset{ l_indexOffset * sizeof(unsigned int) };
 		for (uint32_t i = 0; i < lv_maxLODCount; ++i) {
 			if (i < lv_maxLODCount - 1) {
@@ -387,7 +779,60 @@ namespace MeshConverter
 			}
 		}
 
-		lv_mesh.m_meshSize = (uint32_t)(sizeof(float) * lv_numElementsVertexBuffer * l_mesh->mNumVertices + lv_numIndices*sizeof(unsigned int));
+		for (uint32_t i = 0; i < lv_mesh.m_lodCount; ++i) {
+			lv_mesh.m_lodMeshletOffsets[i] = (uint32_t)l_meshlets.size();
+
+			const std::span<unsigned int> lv_lodIndices{ m_indexBuffer.data() + lv_mesh.m_lodOffsets[i] / sizeof(unsigned int),
+				lv_mesh.CalculateLODNumberOfIndices(i) };
+
+			GenerateMeshlets(lv_lodIndices, lv_meshVertices, lv_numElementsVertexBuffer, l_meshlets);
+		}
+
+		lv_mesh.m_lodMeshletOffsets[lv_mesh.m_lodCount] = (uint32_t)l_meshlets.size();
+
+		const uint32_t lv_firstIndex = lv_mesh.m_lodOffsets[0] / sizeof(unsigned int);
+		const uint32_t lv_totalNumIndicesOfLods = (lv_mesh.m_lodOffsets[lv_mesh.m_lodCount] - lv_mesh.m_lodOffsets[0]) / sizeof(unsigned int);
+
+		//Vertices follow their first use in LOD 0, which every coarser LOD is a subset of. Vertices LOD 0 does not
+		//reference go behind the others, so the vertex count and the vertex offsets of the scene stay the same.
+		{
+			std::vector<unsigned int> lv_remap(l_mesh->mNumVertices);
+
+			uint32_t lv_totalNumRemappedVertices = (uint32_t)meshopt_optimizeVertexFetchRemap(lv_remap.data(),
+				m_indexBuffer.data() + lv_firstIndex, lv_mesh.CalculateLODNumberOfIndices(0), l_mesh->mNumVertices);
+
+			for (auto& l_remap : lv_remap) {
+				if (~0U == l_remap) {
+					l_remap = lv_totalNumRemappedVertices++;
+				}
+			}
+
+			meshopt_remapVertexBuffer(lv_meshVertices.data(), lv_meshVertices.data(), l_mesh->mNumVertices,
+				sizeof(float) * lv_numElementsVertexBuffer, lv_remap.data());
+			meshopt_remapIndexBuffer(m_indexBuffer.data() + lv_firstIndex, m_indexBuffer.data() + lv_firstIndex,
+				lv_totalNumIndicesOfLods, lv_remap.data());
+		}
+
+		//Repacks every LOD as 16 bit indices from the start of the mesh's range and clears the rest of what the 32 bit ones took
+		if (l_mesh->mNumVertices <= 65536U) {
+			const std::vector<unsigned int> lv_wideIndices(m_indexBuffer.begin() + lv_firstIndex,
+				m_indexBuffer.begin() + lv_firstIndex + lv_totalNumIndicesOfLods);
+			uint16_t* lv_narrowIndices = (uint16_t*)(m_indexBuffer.data() + lv_firstIndex);
+
+			for (uint32_t i = 0; i < lv_totalNumIndicesOfLods; ++i) {
+				lv_narrowIndices[i] = (uint16_t)lv_wideIndices[i];
+			}
+
+			memset(lv_narrowIndices + lv_totalNumIndicesOfLods, 0, lv_totalNumIndicesOfLods * sizeof(uint16_t));
+
+			for (uint32_t i = 1; i < lv_maxLODCount; ++i) {
+				lv_mesh.m_lodOffsets[i] = lv_mesh.m_lodOffsets[0] + (lv_mesh.m_lodOffsets[i] - lv_mesh.m_lodOffsets[0]) / 2;
+			}
+
+			lv_mesh.m_indexSizeInBytes = sizeof(uint16_t);
+		}
+
+		lv_mesh.m_meshSize = (uint32_t)(sizeof(float) * lv_numElementsVertexBuffer * l_mesh->mNumVertices + lv_numIndices*lv_mesh.m_indexSizeInBytes);
 		lv_mesh.m_streamCount = lv_streamCount;
 		lv_mesh.m_streamElementSizes[0] = 3 * sizeof(float);
 		lv_mesh.m_streamOffsets[0] = l_vertexOffset*sizeof(float);
@@ -417,7 +862,7 @@ namespace MeshConverter
 		}
 
 
-		m_meshes.emplace_back(lv_mesh);
+		l_outputMesh = lv_mesh;
 
 		
 
@@ -464,11 +909,17 @@ namespace MeshConverter
 
 		for (uint32_t i = 0; i < m_outputInstanceData.size(); ++i) {
 			InstanceData lv_instanceData{};
-			lv_instanceData.m_materialIndex = m_assimpScene->mMeshes[i]->mMaterialIndex;
+			lv_instanceData.m_materialIndex = m_sourceMeshes[i]->mMaterialIndex;
 			lv_instanceData.m_lod = 0;
-			lv_instanceData.m_indexBufferIndex = m_meshes[i].m_lodOffsets[0]/sizeof(unsigned int);
+			lv_instanceData.m_indexBufferIndex = m_meshes[i].m_lodOffsets[0]/m_meshes[i].m_indexSizeInBytes;
+			lv_instanceData.m_indexSizeInBytes = m_meshes[i].m_indexSizeInBytes;
 			lv_instanceData.m_meshIndex = i;
-			lv_instanceData.m_vertexBufferIndex = m_meshes[i].m_streamOffsets[0] / (12*sizeof(float));
+			lv_instanceData.m_vertexBufferIndex = m_meshes[i].m_streamOffsets[0] / m_vertexStrideInBytes;
+
+			for (uint32_t j = 0; j < 3; ++j) {
+				lv_instanceData.m_positionOffset[j] = m_meshes[i].m_positionOffset[j];
+				lv_instanceData.m_positionScale[j] = m_meshes[i].m_positionScale[j];
+			}
 
 
 			for (auto& l_nodeMeshTuple : m_sceneConverter.value().GetScene().m_meshes) {
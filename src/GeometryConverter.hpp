@@ -4,6 +4,9 @@
 #include "Mesh.hpp"
 #include "MeshFileHeader.hpp"
 #include "InstanceData.hpp"
+#include "VertexQuantization.hpp"
+#include "MeshCompression.hpp"
+#include "MeshMerging.hpp"
 #include <vector>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -38,7 +41,12 @@ namespace MeshConverter
 			const std::string& l_instanceDataFile,
 			bool l_includeTextureCoordinates,
 			bool l_includeNormals,
-			bool l_tangents);
+			bool l_tangents,
+			const VertexQuantizationSettings& l_vertexQuantization = {},
+			bool l_compressMeshData = false,
+			uint32_t l_totalNumThreads = 0U,
+			bool l_benchmarkThreads = false,
+			const MeshMergingSettings& l_meshMerging = {});
 
 
 		const aiScene* GetCurrentaiScene() const { return m_assimpScene; }
@@ -52,16 +60,38 @@ namespace MeshConverter
 
 		void GenerateMeshLODs(std::span<unsigned int> l_originalIndices, std::span<float> l_meshVertices, 
 			uint32_t l_totalNumStreams,
-			std::array<std::vector<unsigned int>, lv_maxLODCount-1>& l_lods);
+			std::array<std::vector<unsigned int>, lv_maxLODCount-1>& l_lods,
+			std::array<float, lv_maxLODCount-1>& l_lodErrors);
 
-		void ConvertMesh(const aiMesh* l_mesh, uint32_t& l_vertexOffset, 
-			uint32_t& l_indexOffset);
+		//Splits one LOD into meshlets and rewrites its indices in meshlet order, the index count stays the same
+		void GenerateMeshlets(std::span<unsigned int> l_lodIndices, std::span<const float> l_meshVertices,
+			uint32_t l_totalNumStreams, std::vector<Meshlet>& l_meshlets);
 
-		void CalculateTotalNumVerticesAndIndicesOfScene(const aiScene* l_scene);
+		//Only touches the vertex and index ranges at the given offsets, so meshes can be converted concurrently.
+		//Meshlet offsets of l_outputMesh index into l_meshlets until ConvertMeshes() appends them.
+		void ConvertMesh(const aiMesh* l_mesh, uint32_t l_vertexOffset,
+			uint32_t l_indexOffset, Mesh& l_outputMesh, std::vector<Meshlet>& l_meshlets);
+
+		//Converts every source mesh on l_totalNumThreads threads (0 uses the hardware concurrency),
+		//the output does not depend on the number of threads. Returns the time it took in milliseconds.
+		double ConvertMeshes(uint32_t l_totalNumThreads);
+
+		//Converts the meshes once per thread count and prints the times, exits if any output differs
+		void BenchmarkConvertMeshes(uint32_t l_maxNumThreads);
+
+		void PrintMeshConversionReport() const;
+
+		void CalculateTotalNumVerticesAndIndicesOfScene();
+
+		//Replaces the fp32 vertices of every mesh with the packed layout of VertexQuantizer
+		void QuantizeVertices(const VertexQuantizationSettings& l_vertexQuantization);
 
 		void SaveDataToMeshFileHeader(const std::string& l_meshFileHeader, 
 			MeshFileHeader& l_meshFileHeaderStructure);
 
+		//Encodes the vertex and index streams, prints the compression ratios and checks that they decode back
+		std::vector<uint8_t> CompressMeshData(std::span<const uint8_t> l_vertexData, std::vector<CompressedStream>& l_streams);
+
 		void SaveBoundingBoxData(const std::string& l_boundingBoxFile);
 
 		void GenerateInstanceDataFile_TextureCoordNormalsTangents(const std::string& l_instanceDataFile);
@@ -70,7 +100,11 @@ namespace MeshConverter
 
 		std::vector<Mesh> m_meshes{};
 		std::vector<float> m_vertexBuffer{};
+		std::vector<uint32_t> m_packedVertexBuffer{};
+		VertexFormat m_vertexFormat{ VertexFormat::m_fp32 };
+		uint32_t m_vertexStrideInBytes{};
 		std::vector<unsigned int> m_indexBuffer{};
+		std::vector<Meshlet> m_meshlets{};
 		std::vector<BoundingBox> m_boundingBoxes{};
 		std::vector<RenderCore::InstanceData> m_outputInstanceData{};
 		bool m_includeTextureCoordinates{false};
@@ -79,6 +113,11 @@ namespace MeshConverter
 		uint32_t m_totalNumVerticesScene{};
 		uint32_t m_totalNumIndicesScene{};
 		const aiScene* m_assimpScene;
+
+		//Meshes of the assimp scene that were not merged followed by the batches of m_meshMerger,
+		//the output meshes and instances are indexed like this list
+		std::vector<const aiMesh*> m_sourceMeshes{};
+		MeshMerger m_meshMerger{};
 		Assimp::Importer m_importer;
 		std::optional<SceneConverter::SceneConverter> m_sceneConverter;
 	};
@@ -0,0 +1,383 @@
+
+
+
+
+#include "GeometryHeap.hpp"
+#include "VulkanResourceManager.hpp"
+#include "ErrorCheck.hpp"
+#include <algorithm>
+#include <numeric>
+
+
+namespace RenderCore
+{
+
+	GeometryHeap::GeometryHeap(VulkanRenderDevice& l_renderDevice, VulkanResourceManager& l_resourceManager,
+		VkDeviceSize l_vertexCapacityInBytes, VkDeviceSize l_indexCapacityInBytes, uint32_t l_totalNumFramesInFlight)
+		:m_renderDevice(l_renderDevice), m_resourceManager(l_resourceManager),
+		m_vertexRanges(l_vertexCapacityInBytes), m_indexRanges(l_indexCapacityInBytes),
+		m_totalNumFramesInFlight(std::max(l_totalNumFramesInFlight, 1U))
+	{
+		m_vertexBufferHandle = m_resourceManager.CreateBufferWithHandle(m_vertexRanges.GetCapacity(),
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, " Geometry-Heap-Vertices ",
+			GpuMemoryCategory::m_geometry);
+
+		m_indexBufferHandle = m_resourceManager.CreateBufferWithHandle(m_indexRanges.GetCapacity(),
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, " Geometry-Heap-Indices ",
+			GpuMemoryCategory::m_geometry);
+
+		m_meshes.reserve(256);
+		m_meshGenerations.reserve(256);
+		m_retiredRanges.reserve(256);
+	}
+
+
+	VkDeviceSize GeometryHeap::CalculateRangeAlignment(uint32_t l_elementSizeInBytes)
+	{
+		return std::lcm((VkDeviceSize)l_elementSizeInBytes, TlsfRangeAllocator::m_granuleInBytes);
+	}
+
+
+	GeometryHandle GeometryHeap::AddMesh(const void* l_vertices, uint32_t l_totalNumVertices, uint32_t l_vertexStrideInBytes,
+		std::span<const std::span<const uint8_t>> l_lodIndices, uint32_t l_indexSizeInBytes)
+	{
+		using namespace ErrorCheck;
+
+		if (0 == l_totalNumVertices || 0 == l_vertexStrideInBytes || MeshConverter::lv_maxLODCount < l_lodIndices.size()) {
+			PRINT_EXIT("\nGeometry heap was handed a mesh without vertices or with too many LODs.\n");
+		}
+
+		if (sizeof(uint16_t) != l_indexSizeInBytes && sizeof(uint32_t) != l_indexSizeInBytes) {
+			PRINT_EXIT("\nGeometry heap only stores 16 and 32 bit indices.\n");
+		}
+
+		MeshSlot lv_slot{};
+		lv_slot.m_lodRangeHandles.fill(m_nullRange);
+
+		VkDeviceSize lv_vertexOffset{ 0 };
+		const VkDeviceSize lv_vertexSize = (VkDeviceSize)l_totalNumVertices * l_vertexStrideInBytes;
+
+		if (false == m_vertexRanges.Allocate(lv_vertexSize, CalculateRangeAlignment(l_vertexStrideInBytes),
+			lv_vertexOffset, lv_slot.m_vertexRangeHandle)) {
+			return GeometryHandle{};
+		}
+
+		std::array<VkDeviceSize, MeshConverter::lv_maxLODCount> lv_lodOffsets{};
+
+		for (uint32_t i = 0; i < (uint32_t)l_lodIndices.size(); ++i) {
+
+			//Empty LODs do not take a range, they draw nothing
+			if (true == l_lodIndices[i].empty()) {
+				continue;
+			}
+
+			if (false == m_indexRanges.Allocate(l_lodIndices[i].size_bytes(), CalculateRangeAlignment(l_indexSizeInBytes),
+				lv_lodOffsets[i], lv_slot.m_lodRangeHandles[i])) {
+
+				//Nothing was uploaded yet, so the ranges taken so far go straight back
+				m_vertexRanges.Free(lv_slot.m_vertexRangeHandle);
+
+				for (uint32_t j = 0; j < i; ++j) {
+					if (m_nullRange != lv_slot.m_lodRangeHandles[j]) {
+						m_indexRanges.Free(lv_slot.m_lodRangeHandles[j]);
+					}
+				}
+
+				return GeometryHandle{};
+			}
+		}
+
+		auto& lv_mesh = lv_slot.m_mesh;
+		lv_mesh.m_vertexOffset = (uint32_t)(lv_vertexOffset / l_vertexStrideInBytes);
+		lv_mesh.m_totalNumVertices = l_totalNumVertices;
+		lv_mesh.m_vertexStrideInBytes = l_vertexStrideInBytes;
+		lv_mesh.m_indexSizeInBytes = l_indexSizeInBytes;
+		lv_mesh.m_lodCount = (uint32_t)l_lodIndices.size();
+
+		m_resourceManager.CopyDataToLocalBuffer(m_vertexBufferHandle, lv_vertexOffset, l_vertices, lv_vertexSize);
+
+		for (uint32_t i = 0; i < lv_mesh.m_lodCount; ++i) {
+
+			lv_mesh.m_lodIndexOffsets[i] = (uint32_t)(lv_lodOffsets[i] / l_indexSizeInBytes);
+			lv_mesh.m_lodNumIndices[i] = (uint32_t)(l_lodIndices[i].size() / l_indexSizeInBytes);
+
+			if (m_nullRange != lv_slot.m_lodRangeHandles[i]) {
+				m_resourceManager.CopyDataToLocalBuffer(m_indexBufferHandle, lv_lodOffsets[i],
+					l_lodIndices[i].data(), l_lodIndices[i].size_bytes());
+			}
+		}
+
+		uint32_t lv_slotIndex{ 0 };
+
+		if (false == m_freeMeshSlots.empty()) {
+			lv_slotIndex = m_freeMeshSlots.back();
+			m_freeMeshSlots.pop_back();
+			m_meshes[lv_slotIndex] = lv_slot;
+		}
+		else {
+			lv_slotIndex = (uint32_t)m_meshes.size();
+			m_meshes.push_back(lv_slot);
+			m_meshGenerations.push_back(1U);
+		}
+
+		++m_totalNumMeshes;
+
+		return GeometryHandle{ .m_index = lv_slotIndex, .m_generation = m_meshGenerations[lv_slotIndex] };
+	}
+
+
+	void GeometryHeap::FreeMesh(const GeometryHandle l_handle)
+	{
+		using namespace ErrorCheck;
+
+		if (false == IsValid(l_handle)) {
+			PRINT_EXIT("\nAttempted to free a stale geometry heap handle.\n");
+		}
+
+		auto& lv_slot = m_meshes[l_handle.m_index];
+
+		m_retiredRanges.push_back(RetiredRange{ .m_rangeHandle = lv_slot.m_vertexRangeHandle,
+			.m_vertexRange = true, .m_frameNumber = m_frameNumber });
+
+		for (uint32_t i = 0; i < lv_slot.m_mesh.m_lodCount; ++i) {
+			if (m_nullRange != lv_slot.m_lodRangeHandles[i]) {
+				m_retiredRanges.push_back(RetiredRange{ .m_rangeHandle = lv_slot.m_lodRangeHandles[i],
+					.m_vertexRange = false, .m_frameNumber = m_frameNumber });
+			}
+		}
+
+		lv_slot = MeshSlot{};
+		++m_meshGenerations[l_handle.m_index];
+		m_freeMeshSlots.push_back(l_handle.m_index);
+
+		--m_totalNumMeshes;
+	}
+
+
+	bool GeometryHeap::IsValid(const GeometryHandle l_handle) const
+	{
+		return l_handle.m_index < (uint32_t)m_meshes.size() && l_handle.m_generation == m_meshGenerations[l_handle.m_index];
+	}
+
+
+	const GeometryHeapMesh& GeometryHeap::GetMesh(const GeometryHandle l_handle) const
+	{
+		using namespace ErrorCheck;
+
+		if (false == IsValid(l_handle)) {
+			PRINT_EXIT("\nStale geometry heap handle.\n");
+		}
+
+		return m_meshes[l_handle.m_index].m_mesh;
+	}
+
+
+	void GeometryHeap::ReleaseRange(const RetiredRange& l_retiredRange)
+	{
+		if (true == l_retiredRange.m_vertexRange) {
+			m_vertexRanges.Free(l_retiredRange.m_rangeHandle);
+		}
+		else {
+			m_indexRanges.Free(l_retiredRange.m_rangeHandle);
+		}
+	}
+
+
+	void GeometryHeap::CollectRetiredRanges()
+	{
+		++m_frameNumber;
+
+		std::erase_if(m_retiredRanges, [this](const RetiredRange& l_retiredRange)
+			{
+				if (l_retiredRange.m_frameNumber + m_totalNumFramesInFlight > m_frameNumber) {
+					return false;
+				}
+
+				ReleaseRange(l_retiredRange);
+				return true;
+			});
+	}
+
+
+	void GeometryHeap::CompactBuffer(BufferHandle l_bufferHandle, TlsfRangeAllocator& l_rangeAllocator, bool l_vertexBuffer)
+	{
+		using namespace ErrorCheck;
+
+		struct LiveRange
+		{
+			uint32_t m_slotIndex{ 0 };
+
+			//LOD of the index range, unused for vertex ranges
+			uint32_t m_lod{ 0 };
+
+			VkDeviceSize m_offset{ 0 };
+			VkDeviceSize m_sizeInBytes{ 0 };
+			uint32_t m_elementSizeInBytes{ 0 };
+		};
+
+		std::vector<LiveRange> lv_liveRanges{};
+
+		for (uint32_t i = 0; i < (uint32_t)m_meshes.size(); ++i) {
+
+			const auto& lv_slot = m_meshes[i];
+
+			if (m_nullRange == lv_slot.m_vertexRangeHandle) {
+				continue;
+			}
+
+			const auto& lv_mesh = lv_slot.m_mesh;
+
+			if (true == l_vertexBuffer) {
+				lv_liveRanges.push_back(LiveRange{ .m_slotIndex = i, .m_lod = 0,
+					.m_offset = (VkDeviceSize)lv_mesh.m_vertexOffset * lv_mesh.m_vertexStrideInBytes,
+					.m_sizeInBytes = (VkDeviceSize)lv_mesh.m_totalNumVertices * lv_mesh.m_vertexStrideInBytes,
+					.m_elementSizeInBytes = lv_mesh.m_vertexStrideInBytes });
+				continue;
+			}
+
+			for (uint32_t j = 0; j < lv_mesh.m_lodCount; ++j) {
+				if (m_nullRange != lv_slot.m_lodRangeHandles[j]) {
+					lv_liveRanges.push_back(LiveRange{ .m_slotIndex = i, .m_lod = j,
+						.m_offset = (VkDeviceSize)lv_mesh.m_lodIndexOffsets[j] * lv_mesh.m_indexSizeInBytes,
+						.m_sizeInBytes = (VkDeviceSize)lv_mesh.m_lodNumIndices[j] * lv_mesh.m_indexSizeInBytes,
+						.m_elementSizeInBytes = lv_mesh.m_indexSizeInBytes });
+				}
+			}
+		}
+
+		//Keeping the order of the buffer means every range only ever moves towards the front
+		std::sort(lv_liveRanges.begin(), lv_liveRanges.end(),
+			[](const LiveRange& l_a, const LiveRange& l_b) { return l_a.m_offset < l_b.m_offset; });
+
+		l_rangeAllocator.Reset(l_rangeAllocator.GetCapacity());
+
+		std::vector<VkBufferCopy> lv_gatherCopies{};
+		lv_gatherCopies.reserve(lv_liveRanges.size());
+		VkDeviceSize lv_packedSize{ 0 };
+
+		for (const auto& l_liveRange : lv_liveRanges) {
+
+			auto& lv_slot = m_meshes[l_liveRange.m_slotIndex];
+
+			//Bump placement instead of Allocate(), which over-asks by the alignment and rounds up to a size class,
+			//so it can fail on the nearly full heap this runs on. Every range lands at or before its old offset,
+			//the packed extent never exceeds what fitted before
+			const VkDeviceSize lv_alignment = CalculateRangeAlignment(l_liveRange.m_elementSizeInBytes);
+			const VkDeviceSize lv_newOffset = ((lv_packedSize + lv_alignment - 1) / lv_alignment) * lv_alignment;
+			uint32_t lv_newRangeHandle{ m_nullRange };
+
+			if (false == l_rangeAllocator.AllocateAt(lv_newOffset, l_liveRange.m_sizeInBytes, lv_newRangeHandle)) {
+				PRINT_EXIT("\nGeometry heap compaction could not place a live range in the packed layout.\n");
+			}
+
+			lv_gatherCopies.push_back(VkBufferCopy{ .srcOffset = l_liveRange.m_offset, .dstOffset = lv_newOffset,
+				.size = l_liveRange.m_sizeInBytes });
+			lv_packedSize = lv_newOffset + l_liveRange.m_sizeInBytes;
+
+			if (true == l_vertexBuffer) {
+				lv_slot.m_vertexRangeHandle = lv_newRangeHandle;
+				lv_slot.m_mesh.m_vertexOffset = (uint32_t)(lv_newOffset / l_liveRange.m_elementSizeInBytes);
+			}
+			else {
+				lv_slot.m_lodRangeHandles[l_liveRange.m_lod] = lv_newRangeHandle;
+				lv_slot.m_mesh.m_lodIndexOffsets[l_liveRange.m_lod] = (uint32_t)(lv_newOffset / l_liveRange.m_elementSizeInBytes);
+			}
+		}
+
+		if (true == lv_gatherCopies.empty()) {
+			return;
+		}
+
+		//Source and destination ranges of one buffer may overlap, which vkCmdCopyBuffer does not allow,
+		//so the packed layout is built in a scratch buffer and copied back in one go
+		const BufferHandle lv_scratchBufferHandle = m_resourceManager.CreateBufferWithHandle(lv_packedSize,
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, " Geometry-Heap-Compaction-Scratch ",
+			GpuMemoryCategory::m_geometry);
+
+		m_resourceManager.CopyBufferRegionsAndWait(l_bufferHandle, lv_scratchBufferHandle, lv_gatherCopies);
+		m_resourceManager.CopyBufferRegionsAndWait(lv_scratchBufferHandle, l_bufferHandle,
+			{ VkBufferCopy{ .srcOffset = 0, .dstOffset = 0, .size = lv_packedSize } });
+
+		m_resourceManager.DestroyBuffer(lv_scratchBufferHandle);
+	}
+
+
+	void GeometryHeap::Compact()
+	{
+		using namespace ErrorCheck;
+
+		const auto lv_statsBefore = GetStats();
+
+		//Retired ranges may still be read by frames in flight until the device is idle, after that they are just holes
+		{
+			std::lock_guard lv_lock{ m_resourceManager.GetMainQueueMutex() };
+			VULKAN_CHECK(vkDeviceWaitIdle(m_renderDevice.m_device));
+		}
+		m_retiredRanges.clear();
+
+		CompactBuffer(m_vertexBufferHandle, m_vertexRanges, true);
+		CompactBuffer(m_indexBufferHandle, m_indexRanges, false);
+
+		++m_layoutVersion;
+
+		const auto lv_statsAfter = GetStats();
+
+		printf("\nGeometry heap compacted: largest free vertex range %.2f -> %.2f MB, largest free index range %.2f -> %.2f MB.\n",
+			lv_statsBefore.m_vertexLargestFreeRange / (1024.0 * 1024.0), lv_statsAfter.m_vertexLargestFreeRange / (1024.0 * 1024.0),
+			lv_statsBefore.m_indexLargestFreeRange / (1024.0 * 1024.0), lv_statsAfter.m_indexLargestFreeRange / (1024.0 * 1024.0));
+	}
+
+
+	BufferHandle GeometryHeap::GetVertexBufferHandle() const { return m_vertexBufferHandle; }
+	BufferHandle GeometryHeap::GetIndexBufferHandle() const { return m_indexBufferHandle; }
+	uint32_t GeometryHeap::GetLayoutVersion() const { return m_layoutVersion; }
+
+
+	GeometryHeapStats GeometryHeap::GetStats() const
+	{
+		const auto lv_fragmentation = [](const TlsfRangeAllocator& l_rangeAllocator)
+			{
+				const VkDeviceSize lv_freeBytes = l_rangeAllocator.GetCapacity() - l_rangeAllocator.GetUsedBytes();
+
+				return (0 == lv_freeBytes) ? 0.f :
+					1.f - (float)((double)l_rangeAllocator.GetLargestFreeRange() / (double)lv_freeBytes);
+			};
+
+		GeometryHeapStats lv_stats{};
+
+		lv_stats.m_vertexCapacityBytes = m_vertexRanges.GetCapacity();
+		lv_stats.m_vertexUsedBytes = m_vertexRanges.GetUsedBytes();
+		lv_stats.m_vertexLargestFreeRange = m_vertexRanges.GetLargestFreeRange();
+		lv_stats.m_vertexFragmentation = lv_fragmentation(m_vertexRanges);
+
+		lv_stats.m_indexCapacityBytes = m_indexRanges.GetCapacity();
+		lv_stats.m_indexUsedBytes = m_indexRanges.GetUsedBytes();
+		lv_stats.m_indexLargestFreeRange = m_indexRanges.GetLargestFreeRange();
+		lv_stats.m_indexFragmentation = lv_fragmentation(m_indexRanges);
+
+		lv_stats.m_totalNumMeshes = m_totalNumMeshes;
+		lv_stats.m_totalNumRetiredRanges = (uint32_t)m_retiredRanges.size();
+		lv_stats.m_totalNumCompactions = m_layoutVersion;
+
+		return lv_stats;
+	}
+
+
+	void GeometryHeap::PrintStats() const
+	{
+		constexpr double lv_bytesToMegaBytes = 1.0 / (1024.0 * 1024.0);
+
+		const auto lv_stats = GetStats();
+
+		printf("\n******** Geometry heap ********\n");
+		printf("Meshes : %u, %u ranges waiting for their frames to retire, %u compactions\n",
+			lv_stats.m_totalNumMeshes, lv_stats.m_totalNumRetiredRanges, lv_stats.m_totalNumCompactions);
+		printf("Vertices : %.2f of %.2f MB used, largest free range %.2f MB, fragmentation %.1f%%\n",
+			lv_stats.m_vertexUsedBytes * lv_bytesToMegaBytes, lv_stats.m_vertexCapacityBytes * lv_bytesToMegaBytes,
+			lv_stats.m_vertexLargestFreeRange * lv_bytesToMegaBytes, 100.f * lv_stats.m_vertexFragmentation);
+		printf("Indices : %.2f of %.2f MB used, largest free range %.2f MB, fragmentation %.1f%%\n",
+			lv_stats.m_indexUsedBytes * lv_bytesToMegaBytes, lv_stats.m_indexCapacityBytes * lv_bytesToMegaBytes,
+			lv_stats.m_indexLargestFreeRange * lv_bytesToMegaBytes, 100.f * lv_stats.m_indexFragmentation);
+	}
+
+}
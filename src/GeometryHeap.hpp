@@ -0,0 +1,153 @@
+#pragma once
+
+
+
+#include "UtilsVulkan.h"
+#include "GpuMemoryAllocator.hpp"
+#include "GpuResourceHandles.hpp"
+#include "Mesh.hpp"
+#include <array>
+#include <cinttypes>
+#include <span>
+#include <vector>
+
+
+
+namespace RenderCore
+{
+	class VulkanResourceManager;
+
+
+	struct GeometryHandleTag {};
+	using GeometryHandle = GpuResourceHandle<GeometryHandleTag>;
+
+
+	//Where a mesh currently lives inside the heap. Offsets are in elements, the vertex offset in vertices of the
+	//mesh's own stride and the index offsets in indices of the mesh's own index size, which is what InstanceData
+	//and the shaders expect. They only change when the heap is compacted.
+	struct GeometryHeapMesh
+	{
+		uint32_t m_vertexOffset{ 0 };
+		uint32_t m_totalNumVertices{ 0 };
+		uint32_t m_vertexStrideInBytes{ 0 };
+		uint32_t m_indexSizeInBytes{ sizeof(uint32_t) };
+
+		uint32_t m_lodCount{ 0 };
+		std::array<uint32_t, MeshConverter::lv_maxLODCount> m_lodIndexOffsets{};
+		std::array<uint32_t, MeshConverter::lv_maxLODCount> m_lodNumIndices{};
+	};
+
+
+	struct GeometryHeapStats
+	{
+		VkDeviceSize m_vertexCapacityBytes{ 0 };
+		VkDeviceSize m_vertexUsedBytes{ 0 };
+		VkDeviceSize m_vertexLargestFreeRange{ 0 };
+
+		VkDeviceSize m_indexCapacityBytes{ 0 };
+		VkDeviceSize m_indexUsedBytes{ 0 };
+		VkDeviceSize m_indexLargestFreeRange{ 0 };
+
+		uint32_t m_totalNumMeshes{ 0 };
+		uint32_t m_totalNumRetiredRanges{ 0 };
+		uint32_t m_totalNumCompactions{ 0 };
+
+		//Share of the free bytes that is not part of the largest free range, 0 means a single free range
+		float m_vertexFragmentation{ 0.f };
+		float m_indexFragmentation{ 0.f };
+	};
+
+
+	//Device local vertex and index storage buffers that meshes are sub-allocated from, one vertex range per mesh
+	//and one index range per LOD, so that content can be streamed in and out without re-uploading the rest.
+	//Freed ranges are only handed back to the allocators once the frames in flight that may still read them have
+	//retired (CollectRetiredRanges() runs with VulkanResourceManager::CollectRetiredResources()).
+	//Compact() packs the live ranges at the front of both buffers, the buffers themselves never change.
+	//Not thread safe, meshes are added and freed from the main thread.
+	class GeometryHeap final
+	{
+	public:
+
+		GeometryHeap(VulkanRenderDevice& l_renderDevice, VulkanResourceManager& l_resourceManager, VkDeviceSize l_vertexCapacityInBytes,
+			VkDeviceSize l_indexCapacityInBytes, uint32_t l_totalNumFramesInFlight);
+
+		GeometryHeap(const GeometryHeap&) = delete;
+		GeometryHeap& operator=(const GeometryHeap&) = delete;
+
+		//Records the uploads into the staging ring. l_lodIndices holds the bytes of the mesh local indices of every LOD,
+		//which are 16 or 32 bit as l_indexSizeInBytes says.
+		//Returns an invalid handle when either buffer has no free range big enough, Compact() may make room.
+		GeometryHandle AddMesh(const void* l_vertices, uint32_t l_totalNumVertices, uint32_t l_vertexStrideInBytes,
+			std::span<const std::span<const uint8_t>> l_lodIndices, uint32_t l_indexSizeInBytes);
+
+		//The ranges stay readable by the frames in flight, the handle is invalid right away
+		void FreeMesh(const GeometryHandle l_handle);
+
+		bool IsValid(const GeometryHandle l_handle) const;
+		const GeometryHeapMesh& GetMesh(const GeometryHandle l_handle) const;
+
+		void CollectRetiredRanges();
+
+		//Waits for the device to go idle, then moves every live range to the front of its buffer through a scratch
+		//buffer. Offsets returned by GetMesh() change, so whatever caches them (instance data) has to re-read them.
+		void Compact();
+
+		BufferHandle GetVertexBufferHandle() const;
+		BufferHandle GetIndexBufferHandle() const;
+
+		//Bumped by Compact(), lets users of GetMesh() notice that their cached offsets went stale
+		uint32_t GetLayoutVersion() const;
+
+		GeometryHeapStats GetStats() const;
+		void PrintStats() const;
+
+	private:
+
+		static constexpr uint32_t m_nullRange = UINT32_MAX;
+
+		struct MeshSlot
+		{
+			GeometryHeapMesh m_mesh{};
+
+			uint32_t m_vertexRangeHandle{ m_nullRange };
+			std::array<uint32_t, MeshConverter::lv_maxLODCount> m_lodRangeHandles{};
+		};
+
+		struct RetiredRange
+		{
+			uint32_t m_rangeHandle{ m_nullRange };
+			bool m_vertexRange{ false };
+
+			//Frame number at the time the mesh was freed
+			uint64_t m_frameNumber{ 0 };
+		};
+
+		//Ranges are aligned to whole elements as well as to the granule of the range allocator
+		static VkDeviceSize CalculateRangeAlignment(uint32_t l_elementSizeInBytes);
+
+		void ReleaseRange(const RetiredRange& l_retiredRange);
+		void CompactBuffer(BufferHandle l_bufferHandle, TlsfRangeAllocator& l_rangeAllocator, bool l_vertexBuffer);
+
+
+		VulkanRenderDevice& m_renderDevice;
+		VulkanResourceManager& m_resourceManager;
+
+		BufferHandle m_vertexBufferHandle{};
+		BufferHandle m_indexBufferHandle{};
+
+		TlsfRangeAllocator m_vertexRanges{};
+		TlsfRangeAllocator m_indexRanges{};
+
+		std::vector<MeshSlot> m_meshes{};
+		std::vector<uint32_t> m_meshGenerations{};
+		std::vector<uint32_t> m_freeMeshSlots{};
+		uint32_t m_totalNumMeshes{ 0 };
+
+		std::vector<RetiredRange> m_retiredRanges{};
+		uint32_t m_totalNumFramesInFlight{ 0 };
+		uint64_t m_frameNumber{ 0 };
+
+		uint32_t m_layoutVersion{ 0 };
+	};
+
+}
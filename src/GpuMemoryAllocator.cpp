@@ -0,0 +1,956 @@
+
+
+
+
+#include "GpuMemoryAllocator.hpp"
+#include "ErrorCheck.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace RenderCore
+{
+
+	TlsfRangeAllocator::TlsfRangeAllocator(VkDeviceSize l_capacityInBytes)
+	{
+		Reset(l_capacityInBytes);
+	}
+
+
+	void TlsfRangeAllocator::Reset(VkDeviceSize l_capacityInBytes)
+	{
+		m_ranges.clear();
+		m_unusedRangeHandles.clear();
+
+		m_flBitmap = 0;
+		m_slBitmaps.fill(0);
+		for (auto& l_freeList : m_freeLists) {
+			l_freeList.fill(m_nullRange);
+		}
+
+		m_capacityInBytes = (l_capacityInBytes / m_granuleInBytes) * m_granuleInBytes;
+		m_usedBytes = 0;
+		m_totalNumAllocations = 0;
+
+		if (0 == m_capacityInBytes) {
+			return;
+		}
+
+		m_ranges.reserve(256);
+
+		const uint32_t lv_rangeHandle = CreateRange();
+		m_ranges[lv_rangeHandle].m_offsetInGranules = 0;
+		m_ranges[lv_rangeHandle].m_sizeInGranules = m_capacityInBytes / m_granuleInBytes;
+
+		InsertFreeRange(lv_rangeHandle);
+	}
+
+
+	void TlsfRangeAllocator::MappingInsert(uint64_t l_sizeInGranules, uint32_t& l_fl, uint32_t& l_sl)
+	{
+		if (l_sizeInGranules < m_slCount) {
+			l_fl = 0;
+			l_sl = (uint32_t)l_sizeInGranules;
+			return;
+		}
+
+		const uint32_t lv_mostSignificantBit = (uint32_t)std::bit_width(l_sizeInGranules) - 1;
+		l_fl = lv_mostSignificantBit - m_slLog2 + 1;
+		l_sl = (uint32_t)(l_sizeInGranules >> (lv_mostSignificantBit - m_slLog2)) - m_slCount;
+	}
+
+
+	void TlsfRangeAllocator::MappingSearch(uint64_t l_sizeInGranules, uint32_t& l_fl, uint32_t& l_sl)
+	{
+		//Round up to the next size class so that any range of the class found is big enough
+		if (l_sizeInGranules >= m_slCount) {
+			const uint32_t lv_mostSignificantBit = (uint32_t)std::bit_width(l_sizeInGranules) - 1;
+			l_sizeInGranules += (1ULL << (lv_mostSignificantBit - m_slLog2)) - 1;
+		}
+
+		MappingInsert(l_sizeInGranules, l_fl, l_sl);
+	}
+
+
+	uint32_t TlsfRangeAllocator::CreateRange()
+	{
+		if (false == m_unusedRangeHandles.empty()) {
+			const uint32_t lv_rangeHandle = m_unusedRangeHandles.back();
+			m_unusedRangeHandles.pop_back();
+			m_ranges[lv_rangeHandle] = Range{};
+			return lv_rangeHandle;
+		}
+
+		m_ranges.emplace_back();
+		return (uint32_t)m_ranges.size() - 1;
+	}
+
+
+	void TlsfRangeAllocator::ReleaseRange(uint32_t l_rangeHandle)
+	{
+		m_unusedRangeHandles.push_back(l_rangeHandle);
+	}
+
+
+	void TlsfRangeAllocator::InsertFreeRange(uint32_t l_rangeHandle)
+	{
+		uint32_t lv_fl{}, lv_sl{};
+		MappingInsert(m_ranges[l_rangeHandle].m_sizeInGranules, lv_fl, lv_sl);
+
+		auto& lv_range = m_ranges[l_rangeHandle];
+		const uint32_t lv_head = m_freeLists[lv_fl][lv_sl];
+
+		lv_range.m_isFree = true;
+		lv_range.m_prevFree = m_nullRange;
+		lv_range.m_nextFree = lv_head;
+
+		if (m_nullRange != lv_head) {
+			m_ranges[lv_head].m_prevFree = l_rangeHandle;
+		}
+
+		m_freeLists[lv_fl][lv_sl] = l_rangeHandle;
+		m_slBitmaps[lv_fl] |= (1U << lv_sl);
+		m_flBitmap |= (1ULL << lv_fl);
+	}
+
+
+	void TlsfRangeAllocator::RemoveFreeRange(uint32_t l_rangeHandle)
+	{
+		uint32_t lv_fl{}, lv_sl{};
+		MappingInsert(m_ranges[l_rangeHandle].m_sizeInGranules, lv_fl, lv_sl);
+
+		auto& lv_range = m_ranges[l_rangeHandle];
+
+		if (m_nullRange != lv_range.m_prevFree) {
+			m_ranges[lv_range.m_prevFree].m_nextFree = lv_range.m_nextFree;
+		}
+		if (m_nullRange != lv_range.m_nextFree) {
+			m_ranges[lv_range.m_nextFree].m_prevFree = lv_range.m_prevFree;
+		}
+
+		if (l_rangeHandle == m_freeLists[lv_fl][lv_sl]) {
+			m_freeLists[lv_fl][lv_sl] = lv_range.m_nextFree;
+
+			if (m_nullRange == lv_range.m_nextFree) {
+				m_slBitmaps[lv_fl] &= ~(1U << lv_sl);
+
+				if (0 == m_slBitmaps[lv_fl]) {
+					m_flBitmap &= ~(1ULL << lv_fl);
+				}
+			}
+		}
+
+		lv_range.m_prevFree = m_nullRange;
+		lv_range.m_nextFree = m_nullRange;
+	}
+
+
+	uint32_t TlsfRangeAllocator::FindSuitableFreeRange(uint64_t l_sizeInGranules)
+	{
+		uint32_t lv_fl{}, lv_sl{};
+		MappingSearch(l_sizeInGranules, lv_fl, lv_sl);
+
+		if (lv_fl >= m_flCount) {
+			return m_nullRange;
+		}
+
+		uint32_t lv_slMap = m_slBitmaps[lv_fl] & (~0U << lv_sl);
+
+		if (0 == lv_slMap) {
+			const uint64_t lv_flMap = (lv_fl + 1 < 64) ? (m_flBitmap & (~0ULL << (lv_fl + 1))) : 0;
+
+			if (0 == lv_flMap) {
+				return m_nullRange;
+			}
+
+			lv_fl = (uint32_t)std::countr_zero(lv_flMap);
+			lv_slMap = m_slBitmaps[lv_fl];
+		}
+
+		lv_sl = (uint32_t)std::countr_zero(lv_slMap);
+
+		return m_freeLists[lv_fl][lv_sl];
+	}
+
+
+	uint32_t TlsfRangeAllocator::FindFreeRangeContaining(uint64_t l_offsetInGranules, uint64_t l_sizeInGranules) const
+	{
+		//Only free ranges can take the placement, so walking the non empty free lists is enough
+		for (uint64_t lv_flMap = m_flBitmap; 0 != lv_flMap; lv_flMap &= lv_flMap - 1) {
+
+			const uint32_t lv_fl = (uint32_t)std::countr_zero(lv_flMap);
+
+			for (uint32_t lv_slMap = m_slBitmaps[lv_fl]; 0 != lv_slMap; lv_slMap &= lv_slMap - 1) {
+
+				const uint32_t lv_sl = (uint32_t)std::countr_zero(lv_slMap);
+
+				for (uint32_t lv_rangeHandle = m_freeLists[lv_fl][lv_sl]; m_nullRange != lv_rangeHandle;
+					lv_rangeHandle = m_ranges[lv_rangeHandle].m_nextFree) {
+
+					const auto& lv_range = m_ranges[lv_rangeHandle];
+
+					if (lv_range.m_offsetInGranules <= l_offsetInGranules &&
+						l_offsetInGranules + l_sizeInGranules <= lv_range.m_offsetInGranules + lv_range.m_sizeInGranules) {
+						return lv_rangeHandle;
+					}
+				}
+			}
+		}
+
+		return m_nullRange;
+	}
+
+
+	uint32_t TlsfRangeAllocator::SplitRange(uint32_t l_rangeHandle, uint64_t l_sizeInGranules)
+	{
+		const uint32_t lv_remainderHandle = CreateRange();
+
+		auto& lv_range = m_ranges[l_rangeHandle];
+		auto& lv_remainder = m_ranges[lv_remainderHandle];
+
+		lv_remainder.m_offsetInGranules = lv_range.m_offsetInGranules + l_sizeInGranules;
+		lv_remainder.m_sizeInGranules = lv_range.m_sizeInGranules - l_sizeInGranules;
+		lv_remainder.m_prevPhysical = l_rangeHandle;
+		lv_remainder.m_nextPhysical = lv_range.m_nextPhysical;
+
+		if (m_nullRange != lv_range.m_nextPhysical) {
+			m_ranges[lv_range.m_nextPhysical].m_prevPhysical = lv_remainderHandle;
+		}
+
+		lv_range.m_sizeInGranules = l_sizeInGranules;
+		lv_range.m_nextPhysical = lv_remainderHandle;
+
+		return lv_remainderHandle;
+	}
+
+
+	void TlsfRangeAllocator::MergeWithNext(uint32_t l_rangeHandle)
+	{
+		auto& lv_range = m_ranges[l_rangeHandle];
+		const uint32_t lv_nextHandle = lv_range.m_nextPhysical;
+		const auto& lv_next = m_ranges[lv_nextHandle];
+
+		lv_range.m_sizeInGranules += lv_next.m_sizeInGranules;
+		lv_range.m_nextPhysical = lv_next.m_nextPhysical;
+
+		if (m_nullRange != lv_next.m_nextPhysical) {
+			m_ranges[lv_next.m_nextPhysical].m_prevPhysical = l_rangeHandle;
+		}
+
+		ReleaseRange(lv_nextHandle);
+	}
+
+
+	bool TlsfRangeAllocator::Allocate(VkDeviceSize l_sizeInBytes, VkDeviceSize l_alignment,
+		VkDeviceSize& l_offset, uint32_t& l_rangeHandle)
+	{
+		const uint64_t lv_sizeInGranules = std::max<uint64_t>(1, (l_sizeInBytes + m_granuleInBytes - 1) / m_granuleInBytes);
+		const uint64_t lv_alignmentInGranules = std::max<uint64_t>(1, l_alignment / m_granuleInBytes);
+
+		//Over-ask by the worst case padding so that the aligned start is guaranteed to fit in the range found
+		uint32_t lv_rangeHandle = FindSuitableFreeRange(lv_sizeInGranules + lv_alignmentInGranules - 1);
+
+		if (m_nullRange == lv_rangeHandle) {
+			return false;
+		}
+
+		RemoveFreeRange(lv_rangeHandle);
+
+		const uint64_t lv_offset = m_ranges[lv_rangeHandle].m_offsetInGranules;
+		const uint64_t lv_alignedOffset = ((lv_offset + lv_alignmentInGranules - 1) / lv_alignmentInGranules) * lv_alignmentInGranules;
+
+		if (lv_alignedOffset != lv_offset) {
+			const uint32_t lv_alignedHandle = SplitRange(lv_rangeHandle, lv_alignedOffset - lv_offset);
+			InsertFreeRange(lv_rangeHandle);
+			lv_rangeHandle = lv_alignedHandle;
+		}
+
+		if (m_ranges[lv_rangeHandle].m_sizeInGranules > lv_sizeInGranules) {
+			const uint32_t lv_tailHandle = SplitRange(lv_rangeHandle, lv_sizeInGranules);
+			InsertFreeRange(lv_tailHandle);
+		}
+
+		m_ranges[lv_rangeHandle].m_isFree = false;
+
+		m_usedBytes += lv_sizeInGranules * m_granuleInBytes;
+		++m_totalNumAllocations;
+
+		l_offset = lv_alignedOffset * m_granuleInBytes;
+		l_rangeHandle = lv_rangeHandle;
+
+		return true;
+	}
+
+
+	bool TlsfRangeAllocator::AllocateAt(VkDeviceSize l_offset, VkDeviceSize l_sizeInBytes, uint32_t& l_rangeHandle)
+	{
+		if (0 != l_offset % m_granuleInBytes) {
+			return false;
+		}
+
+		const uint64_t lv_offsetInGranules = l_offset / m_granuleInBytes;
+		const uint64_t lv_sizeInGranules = std::max<uint64_t>(1, (l_sizeInBytes + m_granuleInBytes - 1) / m_granuleInBytes);
+
+		uint32_t lv_rangeHandle = FindFreeRangeContaining(lv_offsetInGranules, lv_sizeInGranules);
+
+		if (m_nullRange == lv_rangeHandle) {
+			return false;
+		}
+
+		RemoveFreeRange(lv_rangeHandle);
+
+		const uint64_t lv_rangeOffset = m_ranges[lv_rangeHandle].m_offsetInGranules;
+
+		if (lv_offsetInGranules != lv_rangeOffset) {
+			const uint32_t lv_placedHandle = SplitRange(lv_rangeHandle, lv_offsetInGranules - lv_rangeOffset);
+			InsertFreeRange(lv_rangeHandle);
+			lv_rangeHandle = lv_placedHandle;
+		}
+
+		if (m_ranges[lv_rangeHandle].m_sizeInGranules > lv_sizeInGranules) {
+			const uint32_t lv_tailHandle = SplitRange(lv_rangeHandle, lv_sizeInGranules);
+			InsertFreeRange(lv_tailHandle);
+		}
+
+		m_ranges[lv_rangeHandle].m_isFree = false;
+
+		m_usedBytes += lv_sizeInGranules * m_granuleInBytes;
+		++m_totalNumAllocations;
+
+		l_rangeHandle = lv_rangeHandle;
+
+		return true;
+	}
+
+
+	void TlsfRangeAllocator::Free(uint32_t l_rangeHandle)
+	{
+		using namespace ErrorCheck;
+
+		if (l_rangeHandle >= m_ranges.size() || true == m_ranges[l_rangeHandle].m_isFree) {
+			PRINT_EXIT("\nAttempted to free an invalid or already freed memory range.\n");
+		}
+
+		m_usedBytes -= m_ranges[l_rangeHandle].m_sizeInGranules * m_granuleInBytes;
+		--m_totalNumAllocations;
+
+		const uint32_t lv_nextHandle = m_ranges[l_rangeHandle].m_nextPhysical;
+		if (m_nullRange != lv_nextHandle && true == m_ranges[lv_nextHandle].m_isFree) {
+			RemoveFreeRange(lv_nextHandle);
+			MergeWithNext(l_rangeHandle);
+		}
+
+		const uint32_t lv_prevHandle = m_ranges[l_rangeHandle].m_prevPhysical;
+		if (m_nullRange != lv_prevHandle && true == m_ranges[lv_prevHandle].m_isFree) {
+			RemoveFreeRange(lv_prevHandle);
+			MergeWithNext(lv_prevHandle);
+			l_rangeHandle = lv_prevHandle;
+		}
+
+		InsertFreeRange(l_rangeHandle);
+	}
+
+
+	VkDeviceSize TlsfRangeAllocator::GetCapacity() const { return m_capacityInBytes; }
+	VkDeviceSize TlsfRangeAllocator::GetUsedBytes() const { return m_usedBytes; }
+	uint32_t TlsfRangeAllocator::GetTotalNumAllocations() const { return m_totalNumAllocations; }
+	bool TlsfRangeAllocator::IsEmpty() const { return 0 == m_totalNumAllocations; }
+
+
+	VkDeviceSize TlsfRangeAllocator::GetLargestFreeRange() const
+	{
+		if (0 == m_flBitmap) {
+			return 0;
+		}
+
+		//Only the highest non empty size class can hold the largest range, but its ranges are not sorted
+		const uint32_t lv_fl = 63U - (uint32_t)std::countl_zero(m_flBitmap);
+		const uint32_t lv_sl = 31U - (uint32_t)std::countl_zero(m_slBitmaps[lv_fl]);
+
+		uint64_t lv_largestSizeInGranules{ 0 };
+		for (uint32_t lv_rangeHandle = m_freeLists[lv_fl][lv_sl]; m_nullRange != lv_rangeHandle;
+			lv_rangeHandle = m_ranges[lv_rangeHandle].m_nextFree) {
+			lv_largestSizeInGranules = std::max(lv_largestSizeInGranules, m_ranges[lv_rangeHandle].m_sizeInGranules);
+		}
+
+		return lv_largestSizeInGranules * m_granuleInBytes;
+	}
+
+
+	std::vector<TlsfDrainPlacement> PlanBlockDrain(std::span<TlsfRangeAllocator* const> l_blocks,
+		std::span<const TlsfDrainCandidate> l_candidates)
+	{
+		std::vector<TlsfDrainPlacement> lv_placements{};
+
+		uint32_t lv_totalNumLiveBlocks{ 0 };
+		uint32_t lv_sourceBlockIndex{ UINT32_MAX };
+		VkDeviceSize lv_sourceUsedBytes{ UINT64_MAX };
+
+		for (uint32_t i = 0; i < (uint32_t)l_blocks.size(); ++i) {
+
+			if (nullptr == l_blocks[i]) {
+				continue;
+			}
+
+			++lv_totalNumLiveBlocks;
+
+			if (false == l_blocks[i]->IsEmpty() && l_blocks[i]->GetUsedBytes() < lv_sourceUsedBytes) {
+				lv_sourceUsedBytes = l_blocks[i]->GetUsedBytes();
+				lv_sourceBlockIndex = i;
+			}
+		}
+
+		if (lv_totalNumLiveBlocks < 2 || UINT32_MAX == lv_sourceBlockIndex) {
+			return lv_placements;
+		}
+
+		//Never grows the pool, a candidate that fits nowhere else simply stays where it is
+		for (uint32_t i = 0; i < (uint32_t)l_candidates.size(); ++i) {
+
+			if (lv_sourceBlockIndex != l_candidates[i].m_blockIndex) {
+				continue;
+			}
+
+			for (uint32_t j = 0; j < (uint32_t)l_blocks.size(); ++j) {
+
+				TlsfDrainPlacement lv_placement{ .m_candidateIndex = i, .m_blockIndex = j };
+
+				if (lv_sourceBlockIndex != j && nullptr != l_blocks[j] &&
+					true == l_blocks[j]->Allocate(l_candidates[i].m_sizeInBytes, l_candidates[i].m_alignment,
+						lv_placement.m_offset, lv_placement.m_rangeHandle)) {
+					lv_placements.push_back(lv_placement);
+					break;
+				}
+			}
+		}
+
+		return lv_placements;
+	}
+
+
+
+
+
+
+	GpuMemoryAllocator::GpuMemoryAllocator(VulkanRenderDevice& l_renderDevice)
+		:m_renderDevice(l_renderDevice)
+	{
+		vkGetPhysicalDeviceMemoryProperties(m_renderDevice.m_physicalDevice, &m_memoryProperties);
+
+		VkPhysicalDeviceProperties lv_deviceProperties{};
+		vkGetPhysicalDeviceProperties(m_renderDevice.m_physicalDevice, &lv_deviceProperties);
+		m_maxMemoryAllocationCount = lv_deviceProperties.limits.maxMemoryAllocationCount;
+
+		constexpr uint32_t lv_totalNumTilings = (uint32_t)GpuResourceTiling::m_count;
+
+		m_pools.resize(m_memoryProperties.memoryTypeCount * lv_totalNumTilings);
+
+		for (uint32_t i = 0; i < (uint32_t)m_pools.size(); ++i) {
+			m_pools[i].m_memoryTypeIndex = i / lv_totalNumTilings;
+			m_pools[i].m_blockSize = ComputePreferredBlockSize(m_pools[i].m_memoryTypeIndex);
+		}
+	}
+
+
+	GpuMemoryAllocator::~GpuMemoryAllocator()
+	{
+		for (auto& l_pool : m_pools) {
+			for (auto& l_block : l_pool.m_blocks) {
+				if (VK_NULL_HANDLE != l_block.m_memory) {
+					vkFreeMemory(m_renderDevice.m_device, l_block.m_memory, nullptr);
+				}
+			}
+		}
+	}
+
+
+	uint32_t GpuMemoryAllocator::FindMemoryTypeIndex(uint32_t l_memoryTypeBits,
+		VkMemoryPropertyFlags l_memoryProperties) const
+	{
+		for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; ++i) {
+			if ((0 != (l_memoryTypeBits & (1U << i))) &&
+				(l_memoryProperties == (m_memoryProperties.memoryTypes[i].propertyFlags & l_memoryProperties))) {
+				return i;
+			}
+		}
+
+		return UINT32_MAX;
+	}
+
+
+	VkDeviceSize GpuMemoryAllocator::ComputePreferredBlockSize(uint32_t l_memoryTypeIndex) const
+	{
+		constexpr VkDeviceSize lv_deviceLocalBlockSize = 64ULL * 1024ULL * 1024ULL;
+		constexpr VkDeviceSize lv_hostVisibleBlockSize = 16ULL * 1024ULL * 1024ULL;
+		constexpr VkDeviceSize lv_smallHeapSize = 1024ULL * 1024ULL * 1024ULL;
+
+		const auto& lv_memoryType = m_memoryProperties.memoryTypes[l_memoryTypeIndex];
+		const VkDeviceSize lv_heapSize = m_memoryProperties.memoryHeaps[lv_memoryType.heapIndex].size;
+
+		VkDeviceSize lv_blockSize = (0 != (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT & lv_memoryType.propertyFlags)) ?
+			lv_hostVisibleBlockSize : lv_deviceLocalBlockSize;
+
+		//Small heaps (e.g. the 256 MB device local + host visible heap without resizable BAR)
+		//should not be eaten up by a couple of mostly empty blocks
+		if (lv_heapSize <= lv_smallHeapSize) {
+			lv_blockSize = std::min(lv_blockSize, lv_heapSize / 8);
+		}
+
+		return std::max<VkDeviceSize>(TlsfRangeAllocator::m_granuleInBytes,
+			(lv_blockSize / TlsfRangeAllocator::m_granuleInBytes) * TlsfRangeAllocator::m_granuleInBytes);
+	}
+
+
+	VkDeviceMemory GpuMemoryAllocator::AllocateDeviceMemory(uint32_t l_memoryTypeIndex, VkDeviceSize l_size,
+		const void* l_pNext, void** l_mappedData)
+	{
+		using namespace ErrorCheck;
+
+		const VkMemoryAllocateInfo lv_allocateInfo{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+			.pNext = l_pNext,
+			.allocationSize = l_size,
+			.memoryTypeIndex = l_memoryTypeIndex
+		};
+
+		VkDeviceMemory lv_memory{ VK_NULL_HANDLE };
+		if (VK_SUCCESS != vkAllocateMemory(m_renderDevice.m_device, &lv_allocateInfo, nullptr, &lv_memory)) {
+			return VK_NULL_HANDLE;
+		}
+
+		++m_totalNumDeviceMemoryObjects;
+		m_allocatedBytesPerHeap[m_memoryProperties.memoryTypes[l_memoryTypeIndex].heapIndex] += l_size;
+
+		*l_mappedData = nullptr;
+		if (0 != (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT & m_memoryProperties.memoryTypes[l_memoryTypeIndex].propertyFlags)) {
+			VULKAN_CHECK(vkMapMemory(m_renderDevice.m_device, lv_memory, 0, VK_WHOLE_SIZE, 0, l_mappedData));
+		}
+
+		return lv_memory;
+	}
+
+
+	void GpuMemoryAllocator::FreeDeviceMemory(VkDeviceMemory l_memory, uint32_t l_memoryTypeIndex, VkDeviceSize l_size)
+	{
+		vkFreeMemory(m_renderDevice.m_device, l_memory, nullptr);
+
+		--m_totalNumDeviceMemoryObjects;
+		m_allocatedBytesPerHeap[m_memoryProperties.memoryTypes[l_memoryTypeIndex].heapIndex] -= l_size;
+	}
+
+
+	bool GpuMemoryAllocator::AllocateFromBlock(uint32_t l_poolIndex, uint32_t l_blockIndex, VkDeviceSize l_size,
+		VkDeviceSize l_alignment, GpuMemoryAllocation& l_allocation)
+	{
+		auto& lv_pool = m_pools[l_poolIndex];
+		auto& lv_block = lv_pool.m_blocks[l_blockIndex];
+
+		VkDeviceSize lv_offset{};
+		uint32_t lv_rangeHandle{};
+
+		if (false == lv_block.m_ranges.Allocate(l_size, l_alignment, lv_offset, lv_rangeHandle)) {
+			return false;
+		}
+
+		FillBlockAllocation(l_poolIndex, l_blockIndex, l_size, l_alignment, lv_offset, lv_rangeHandle, l_allocation);
+
+		return true;
+	}
+
+
+	void GpuMemoryAllocator::FillBlockAllocation(uint32_t l_poolIndex, uint32_t l_blockIndex, VkDeviceSize l_size,
+		VkDeviceSize l_alignment, VkDeviceSize l_offset, uint32_t l_rangeHandle, GpuMemoryAllocation& l_allocation) const
+	{
+		const auto& lv_pool = m_pools[l_poolIndex];
+		const auto& lv_block = lv_pool.m_blocks[l_blockIndex];
+
+		l_allocation.m_memory = lv_block.m_memory;
+		l_allocation.m_offset = l_offset;
+		l_allocation.m_size = l_size;
+		l_allocation.m_alignment = l_alignment;
+		l_allocation.m_mappedData = (nullptr != lv_block.m_mappedData) ?
+			static_cast<uint8_t*>(lv_block.m_mappedData) + l_offset : nullptr;
+		l_allocation.m_memoryTypeIndex = lv_pool.m_memoryTypeIndex;
+		l_allocation.m_poolIndex = l_poolIndex;
+		l_allocation.m_blockIndex = l_blockIndex;
+		l_allocation.m_rangeHandle = l_rangeHandle;
+	}
+
+
+	bool GpuMemoryAllocator::AllocateFromPool(uint32_t l_poolIndex, VkDeviceSize l_size, VkDeviceSize l_alignment,
+		uint32_t l_excludedBlockIndex, bool l_allowNewBlock, GpuMemoryAllocation& l_allocation)
+	{
+		auto& lv_pool = m_pools[l_poolIndex];
+		uint32_t lv_unusedBlockIndex{ UINT32_MAX };
+
+		for (uint32_t i = 0; i < (uint32_t)lv_pool.m_blocks.size(); ++i) {
+
+			if (VK_NULL_HANDLE == lv_pool.m_blocks[i].m_memory) {
+				lv_unusedBlockIndex = std::min(lv_unusedBlockIndex, i);
+				continue;
+			}
+
+			if (l_excludedBlockIndex != i && true == AllocateFromBlock(l_poolIndex, i, l_size, l_alignment, l_allocation)) {
+				return true;
+			}
+		}
+
+		if (false == l_allowNewBlock) {
+			return false;
+		}
+
+		if (UINT32_MAX == lv_unusedBlockIndex) {
+			lv_pool.m_blocks.emplace_back();
+			lv_unusedBlockIndex = (uint32_t)lv_pool.m_blocks.size() - 1;
+		}
+
+		auto& lv_block = lv_pool.m_blocks[lv_unusedBlockIndex];
+
+		lv_block.m_memory = AllocateDeviceMemory(lv_pool.m_memoryTypeIndex, lv_pool.m_blockSize,
+			nullptr, &lv_block.m_mappedData);
+
+		if (VK_NULL_HANDLE == lv_block.m_memory) {
+			return false;
+		}
+
+		lv_block.m_ranges.Reset(lv_pool.m_blockSize);
+
+		return AllocateFromBlock(l_poolIndex, lv_unusedBlockIndex, l_size, l_alignment, l_allocation);
+	}
+
+
+	GpuMemoryAllocation GpuMemoryAllocator::AllocateDedicated(uint32_t l_memoryTypeIndex, VkDeviceSize l_size,
+		VkBuffer l_dedicatedBuffer, VkImage l_dedicatedImage)
+	{
+		using namespace ErrorCheck;
+
+		const VkMemoryDedicatedAllocateInfo lv_dedicatedInfo{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO,
+			.pNext = nullptr,
+			.image = l_dedicatedImage,
+			.buffer = l_dedicatedBuffer
+		};
+
+		const bool lv_hasDedicatedResource = (VK_NULL_HANDLE != l_dedicatedBuffer) || (VK_NULL_HANDLE != l_dedicatedImage);
+
+		GpuMemoryAllocation lv_allocation{};
+		lv_allocation.m_memory = AllocateDeviceMemory(l_memoryTypeIndex, l_size,
+			(true == lv_hasDedicatedResource) ? &lv_dedicatedInfo : nullptr, &lv_allocation.m_mappedData);
+
+		if (VK_NULL_HANDLE == lv_allocation.m_memory) {
+			PRINT_EXIT("\nFailed to allocate dedicated device memory.\n");
+		}
+
+		lv_allocation.m_offset = 0;
+		lv_allocation.m_size = l_size;
+		lv_allocation.m_memoryTypeIndex = l_memoryTypeIndex;
+
+		++m_totalNumDedicatedAllocations;
+		m_totalDedicatedBytes += l_size;
+
+		return lv_allocation;
+	}
+
+
+	GpuMemoryAllocation GpuMemoryAllocator::Allocate(const VkMemoryRequirements& l_memoryRequirements,
+		VkMemoryPropertyFlags l_memoryProperties, GpuResourceTiling l_tiling,
+		bool l_preferDedicated,
+		VkBuffer l_dedicatedBuffer, VkImage l_dedicatedImage)
+	{
+		using namespace ErrorCheck;
+
+		std::lock_guard lv_lock{ m_mutex };
+
+		const uint32_t lv_memoryTypeIndex = FindMemoryTypeIndex(l_memoryRequirements.memoryTypeBits, l_memoryProperties);
+
+		if (UINT32_MAX == lv_memoryTypeIndex) {
+			PRINT_EXIT("\nFailed to find a suitable memory type for the allocation.\n");
+		}
+
+		const uint32_t lv_poolIndex = lv_memoryTypeIndex * (uint32_t)GpuResourceTiling::m_count + (uint32_t)l_tiling;
+
+		if (true == l_preferDedicated || l_memoryRequirements.size > m_pools[lv_poolIndex].m_blockSize / 2) {
+			return AllocateDedicated(lv_memoryTypeIndex, l_memoryRequirements.size, l_dedicatedBuffer, l_dedicatedImage);
+		}
+
+		GpuMemoryAllocation lv_allocation{};
+		if (false == AllocateFromPool(lv_poolIndex, l_memoryRequirements.size, l_memoryRequirements.alignment,
+			UINT32_MAX, true, lv_allocation)) {
+			//Could not grow the pool by a full block, the heap may still have room for this one resource
+			return AllocateDedicated(lv_memoryTypeIndex, l_memoryRequirements.size, l_dedicatedBuffer, l_dedicatedImage);
+		}
+
+		return lv_allocation;
+	}
+
+
+	void GpuMemoryAllocator::Free(GpuMemoryAllocation& l_allocation)
+	{
+		std::lock_guard lv_lock{ m_mutex };
+
+		if (false == l_allocation.IsValid()) {
+			return;
+		}
+
+		if (true == l_allocation.IsDedicated()) {
+			FreeDeviceMemory(l_allocation.m_memory, l_allocation.m_memoryTypeIndex, l_allocation.m_size);
+
+			--m_totalNumDedicatedAllocations;
+			m_totalDedicatedBytes -= l_allocation.m_size;
+		}
+		else {
+			m_pools[l_allocation.m_poolIndex].m_blocks[l_allocation.m_blockIndex].m_ranges.Free(l_allocation.m_rangeHandle);
+		}
+
+		l_allocation = GpuMemoryAllocation{};
+	}
+
+
+	std::vector<GpuDefragmentationMove> GpuMemoryAllocator::PlanDefragmentation(
+		const std::vector<GpuMemoryAllocation>& l_allocations)
+	{
+		std::lock_guard lv_lock{ m_mutex };
+
+		std::vector<GpuDefragmentationMove> lv_moves{};
+
+		for (uint32_t lv_poolIndex = 0; lv_poolIndex < (uint32_t)m_pools.size(); ++lv_poolIndex) {
+
+			auto& lv_pool = m_pools[lv_poolIndex];
+
+			std::vector<TlsfRangeAllocator*> lv_blocks(lv_pool.m_blocks.size(), nullptr);
+			for (uint32_t i = 0; i < (uint32_t)lv_pool.m_blocks.size(); ++i) {
+				if (VK_NULL_HANDLE != lv_pool.m_blocks[i].m_memory) {
+					lv_blocks[i] = &lv_pool.m_blocks[i].m_ranges;
+				}
+			}
+
+			std::vector<TlsfDrainCandidate> lv_candidates{};
+			std::vector<uint32_t> lv_allocationIndices{};
+
+			for (uint32_t i = 0; i < (uint32_t)l_allocations.size(); ++i) {
+				if (lv_poolIndex == l_allocations[i].m_poolIndex) {
+					lv_candidates.push_back(TlsfDrainCandidate{ .m_blockIndex = l_allocations[i].m_blockIndex,
+						.m_sizeInBytes = l_allocations[i].m_size, .m_alignment = l_allocations[i].m_alignment });
+					lv_allocationIndices.push_back(i);
+				}
+			}
+
+			for (const auto& l_placement : PlanBlockDrain(lv_blocks, lv_candidates)) {
+				const auto& lv_candidate = lv_candidates[l_placement.m_candidateIndex];
+
+				GpuDefragmentationMove lv_move{};
+				lv_move.m_allocationIndex = lv_allocationIndices[l_placement.m_candidateIndex];
+
+				FillBlockAllocation(lv_poolIndex, l_placement.m_blockIndex, lv_candidate.m_sizeInBytes, lv_candidate.m_alignment,
+					l_placement.m_offset, l_placement.m_rangeHandle, lv_move.m_dstAllocation);
+
+				lv_moves.push_back(lv_move);
+			}
+		}
+
+		return lv_moves;
+	}
+
+
+	uint32_t GpuMemoryAllocator::ReleaseEmptyBlocks()
+	{
+		std::lock_guard lv_lock{ m_mutex };
+
+		uint32_t lv_totalNumReleasedBlocks{ 0 };
+
+		for (auto& l_pool : m_pools) {
+			for (auto& l_block : l_pool.m_blocks) {
+				if (VK_NULL_HANDLE != l_block.m_memory && true == l_block.m_ranges.IsEmpty()) {
+					FreeDeviceMemory(l_block.m_memory, l_pool.m_memoryTypeIndex, l_block.m_ranges.GetCapacity());
+
+					l_block.m_memory = VK_NULL_HANDLE;
+					l_block.m_mappedData = nullptr;
+					l_block.m_ranges.Reset(0);
+
+					++lv_totalNumReleasedBlocks;
+				}
+			}
+		}
+
+		return lv_totalNumReleasedBlocks;
+	}
+
+
+	GpuMemoryStats GpuMemoryAllocator::GetStats() const
+	{
+		std::lock_guard lv_lock{ m_mutex };
+
+		GpuMemoryStats lv_stats{};
+
+		lv_stats.m_totalNumDeviceMemoryObjects = m_totalNumDeviceMemoryObjects;
+		lv_stats.m_totalNumDedicatedAllocations = m_totalNumDedicatedAllocations;
+		lv_stats.m_totalDedicatedBytes = m_totalDedicatedBytes;
+
+		for (const auto& l_pool : m_pools) {
+			for (const auto& l_block : l_pool.m_blocks) {
+
+				if (VK_NULL_HANDLE == l_block.m_memory) {
+					continue;
+				}
+
+				++lv_stats.m_totalNumBlocks;
+				lv_stats.m_totalNumSubAllocations += l_block.m_ranges.GetTotalNumAllocations();
+				lv_stats.m_totalBlockBytes += l_block.m_ranges.GetCapacity();
+				lv_stats.m_totalSubAllocatedBytes += l_block.m_ranges.GetUsedBytes();
+				lv_stats.m_largestFreeRange = std::max(lv_stats.m_largestFreeRange, l_block.m_ranges.GetLargestFreeRange());
+			}
+		}
+
+		return lv_stats;
+	}
+
+
+	void GpuMemoryAllocator::PrintStats() const
+	{
+		constexpr double lv_bytesToMegaBytes = 1.0 / (1024.0 * 1024.0);
+
+		const auto lv_stats = GetStats();
+
+		printf("\n******** Gpu memory allocator ********\n");
+		printf("VkDeviceMemory objects : %u (maxMemoryAllocationCount %llu)\n",
+			lv_stats.m_totalNumDeviceMemoryObjects, (unsigned long long)m_maxMemoryAllocationCount);
+		printf("Blocks : %u, %.2f MB reserved, %.2f MB used by %u sub-allocations\n",
+			lv_stats.m_totalNumBlocks, lv_stats.m_totalBlockBytes * lv_bytesToMegaBytes,
+			lv_stats.m_totalSubAllocatedBytes * lv_bytesToMegaBytes, lv_stats.m_totalNumSubAllocations);
+		printf("Largest free range : %.2f MB\n", lv_stats.m_largestFreeRange * lv_bytesToMegaBytes);
+		printf("Dedicated allocations : %u, %.2f MB\n",
+			lv_stats.m_totalNumDedicatedAllocations, lv_stats.m_totalDedicatedBytes * lv_bytesToMegaBytes);
+	}
+
+
+	std::vector<GpuMemoryHeapBudget> GpuMemoryAllocator::GetHeapBudgets() const
+	{
+		std::lock_guard lv_lock{ m_mutex };
+
+		std::vector<GpuMemoryHeapBudget> lv_heapBudgets(m_memoryProperties.memoryHeapCount);
+
+		VkPhysicalDeviceMemoryBudgetPropertiesEXT lv_budgetProperties{};
+		lv_budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+		if (true == IsMemoryBudgetSupported()) {
+			VkPhysicalDeviceMemoryProperties2 lv_memoryProperties2{};
+			lv_memoryProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+			lv_memoryProperties2.pNext = &lv_budgetProperties;
+
+			vkGetPhysicalDeviceMemoryProperties2(m_renderDevice.m_physicalDevice, &lv_memoryProperties2);
+		}
+
+		for (uint32_t i = 0; i < m_memoryProperties.memoryHeapCount; ++i) {
+
+			auto& lv_heapBudget = lv_heapBudgets[i];
+			lv_heapBudget.m_heapSize = m_memoryProperties.memoryHeaps[i].size;
+			lv_heapBudget.m_deviceLocal = 0 != (VK_MEMORY_HEAP_DEVICE_LOCAL_BIT & m_memoryProperties.memoryHeaps[i].flags);
+
+			if (true == IsMemoryBudgetSupported()) {
+				lv_heapBudget.m_budget = lv_budgetProperties.heapBudget[i];
+				lv_heapBudget.m_usage = lv_budgetProperties.heapUsage[i];
+			}
+			else {
+				lv_heapBudget.m_budget = lv_heapBudget.m_heapSize;
+				lv_heapBudget.m_usage = m_allocatedBytesPerHeap[i];
+			}
+		}
+
+		return lv_heapBudgets;
+	}
+
+
+	bool GpuMemoryAllocator::IsMemoryBudgetSupported() const
+	{
+		return m_renderDevice.m_memoryBudgetSupported;
+	}
+
+
+
+	const char* GpuMemoryCategoryToString(GpuMemoryCategory l_category)
+	{
+		switch (l_category) {
+		case GpuMemoryCategory::m_gbuffer:
+			return "GBuffer";
+		case GpuMemoryCategory::m_bloom:
+			return "Bloom";
+		case GpuMemoryCategory::m_shadows:
+			return "Shadows";
+		case GpuMemoryCategory::m_textures:
+			return "Textures";
+		case GpuMemoryCategory::m_geometry:
+			return "Geometry";
+		case GpuMemoryCategory::m_staging:
+			return "Staging";
+		case GpuMemoryCategory::m_uniforms:
+			return "Uniforms";
+		case GpuMemoryCategory::m_renderTargets:
+			return "RenderTargets";
+		default:
+			return "Other";
+		}
+	}
+
+
+	GpuMemoryCategory StringToGpuMemoryCategory(const char* l_memoryCategory)
+	{
+		if (0 == strcmp(l_memoryCategory, "GBUFFER")) {
+			return GpuMemoryCategory::m_gbuffer;
+		}
+		else if (0 == strcmp(l_memoryCategory, "BLOOM")) {
+			return GpuMemoryCategory::m_bloom;
+		}
+		else if (0 == strcmp(l_memoryCategory, "SHADOWS")) {
+			return GpuMemoryCategory::m_shadows;
+		}
+		else if (0 == strcmp(l_memoryCategory, "TEXTURES")) {
+			return GpuMemoryCategory::m_textures;
+		}
+		else if (0 == strcmp(l_memoryCategory, "OTHER")) {
+			return GpuMemoryCategory::m_other;
+		}
+
+		return GpuMemoryCategory::m_renderTargets;
+	}
+
+
+
+	void GpuMemoryCategoryTracker::Track(GpuMemoryCategory l_memoryCategory, VkDeviceSize l_sizeInBytes)
+	{
+		auto& lv_categoryStats = m_stats.at((size_t)l_memoryCategory);
+
+		++lv_categoryStats.m_totalNumAllocations;
+		lv_categoryStats.m_totalBytes += l_sizeInBytes;
+		lv_categoryStats.m_peakBytes = std::max(lv_categoryStats.m_peakBytes, lv_categoryStats.m_totalBytes);
+	}
+
+
+	void GpuMemoryCategoryTracker::Untrack(GpuMemoryCategory l_memoryCategory, VkDeviceSize l_sizeInBytes)
+	{
+		auto& lv_categoryStats = m_stats.at((size_t)l_memoryCategory);
+
+		--lv_categoryStats.m_totalNumAllocations;
+		lv_categoryStats.m_totalBytes -= l_sizeInBytes;
+	}
+
+
+	GpuMemoryCategoryStats GpuMemoryCategoryTracker::GetStats(GpuMemoryCategory l_memoryCategory) const
+	{
+		return m_stats.at((size_t)l_memoryCategory);
+	}
+
+
+	VkDeviceSize GpuMemoryCategoryTracker::GetTotalBytes() const
+	{
+		VkDeviceSize lv_totalBytes{ 0 };
+
+		for (const auto& l_categoryStats : m_stats) {
+			lv_totalBytes += l_categoryStats.m_totalBytes;
+		}
+
+		return lv_totalBytes;
+	}
+
+}
@@ -0,0 +1,322 @@
+#pragma once
+
+
+
+#include "UtilsVulkan.h"
+#include <array>
+#include <cinttypes>
+#include <mutex>
+#include <span>
+#include <vector>
+
+
+
+namespace RenderCore
+{
+
+	//Buffers and linear images must not share a VkDeviceMemory block with optimal tiled images unless
+	//bufferImageGranularity is respected, so every memory type gets one pool per kind of resource.
+	enum class GpuResourceTiling : uint32_t
+	{
+		m_linear = 0,
+		m_optimal = 1,
+		m_count = 2
+	};
+
+
+	//What an allocation is used for, so that memory can be broken down per feature rather than per memory type
+	enum class GpuMemoryCategory : uint32_t
+	{
+		m_gbuffer = 0,
+		m_bloom = 1,
+		m_shadows = 2,
+		m_textures = 3,
+		m_geometry = 4,
+		m_staging = 5,
+		m_uniforms = 6,
+		m_renderTargets = 7,
+		m_other = 8,
+		m_count = 9
+	};
+
+	const char* GpuMemoryCategoryToString(GpuMemoryCategory l_category);
+
+	//Parses the "MemoryCategory" of a frame graph texture, anything unknown counts as a render target
+	GpuMemoryCategory StringToGpuMemoryCategory(const char* l_memoryCategory);
+
+
+	struct GpuMemoryCategoryStats
+	{
+		uint32_t m_totalNumAllocations{ 0 };
+		VkDeviceSize m_totalBytes{ 0 };
+		VkDeviceSize m_peakBytes{ 0 };
+	};
+
+
+	//Per category totals of the live allocations. It does no locking, the owner serializes the calls.
+	class GpuMemoryCategoryTracker final
+	{
+	public:
+
+		void Track(GpuMemoryCategory l_memoryCategory, VkDeviceSize l_sizeInBytes);
+		void Untrack(GpuMemoryCategory l_memoryCategory, VkDeviceSize l_sizeInBytes);
+
+		GpuMemoryCategoryStats GetStats(GpuMemoryCategory l_memoryCategory) const;
+
+		//Sum over every category, what the per category breakdown has to add up to
+		VkDeviceSize GetTotalBytes() const;
+
+	private:
+
+		std::array<GpuMemoryCategoryStats, (size_t)GpuMemoryCategory::m_count> m_stats{};
+	};
+
+
+	struct GpuMemoryHeapBudget
+	{
+		VkDeviceSize m_heapSize{ 0 };
+
+		//Straight from VK_EXT_memory_budget when it is enabled. Otherwise the budget is the heap size
+		//and the usage only covers the memory this allocator got from the heap.
+		VkDeviceSize m_budget{ 0 };
+		VkDeviceSize m_usage{ 0 };
+
+		bool m_deviceLocal{ false };
+	};
+
+
+	struct GpuMemoryAllocation
+	{
+		VkDeviceMemory m_memory{ VK_NULL_HANDLE };
+		VkDeviceSize m_offset{ 0 };
+		VkDeviceSize m_size{ 0 };
+		VkDeviceSize m_alignment{ 1 };
+
+		//Points at m_offset inside a persistently mapped block, nullptr for device local memory
+		void* m_mappedData{ nullptr };
+
+		uint32_t m_memoryTypeIndex{ UINT32_MAX };
+		uint32_t m_poolIndex{ UINT32_MAX };
+		uint32_t m_blockIndex{ UINT32_MAX };
+		uint32_t m_rangeHandle{ UINT32_MAX };
+
+		bool IsValid() const { return VK_NULL_HANDLE != m_memory; }
+		bool IsDedicated() const { return UINT32_MAX == m_poolIndex; }
+	};
+
+
+	struct GpuMemoryStats
+	{
+		uint32_t m_totalNumDeviceMemoryObjects{ 0 };
+		uint32_t m_totalNumBlocks{ 0 };
+		uint32_t m_totalNumSubAllocations{ 0 };
+		uint32_t m_totalNumDedicatedAllocations{ 0 };
+
+		VkDeviceSize m_totalBlockBytes{ 0 };
+		VkDeviceSize m_totalSubAllocatedBytes{ 0 };
+		VkDeviceSize m_totalDedicatedBytes{ 0 };
+		VkDeviceSize m_largestFreeRange{ 0 };
+	};
+
+
+	struct GpuDefragmentationMove
+	{
+		//Index into the allocation list that was handed to PlanDefragmentation()
+		uint32_t m_allocationIndex{ UINT32_MAX };
+		GpuMemoryAllocation m_dstAllocation{};
+	};
+
+
+
+	//Two level segregated fit allocator working purely on offsets of a range [0, capacity).
+	//It never touches Vulkan, so it is used both for the VkDeviceMemory blocks of GpuMemoryAllocator
+	//and for anything else that needs O(1) sub-allocation with coalescing on free.
+	class TlsfRangeAllocator
+	{
+	public:
+
+		//Every offset and size is a multiple of the granule, which also bounds the number of size classes
+		static constexpr VkDeviceSize m_granuleInBytes = 256;
+
+		TlsfRangeAllocator() = default;
+		explicit TlsfRangeAllocator(VkDeviceSize l_capacityInBytes);
+
+		void Reset(VkDeviceSize l_capacityInBytes);
+
+		bool Allocate(VkDeviceSize l_sizeInBytes, VkDeviceSize l_alignment,
+			VkDeviceSize& l_offset, uint32_t& l_rangeHandle);
+		//Places a range at a caller chosen offset, fails if that part of the range is not entirely free
+		bool AllocateAt(VkDeviceSize l_offset, VkDeviceSize l_sizeInBytes, uint32_t& l_rangeHandle);
+		void Free(uint32_t l_rangeHandle);
+
+		VkDeviceSize GetCapacity() const;
+		VkDeviceSize GetUsedBytes() const;
+		VkDeviceSize GetLargestFreeRange() const;
+		uint32_t GetTotalNumAllocations() const;
+		bool IsEmpty() const;
+
+	private:
+
+		static constexpr uint32_t m_slLog2 = 4;
+		static constexpr uint32_t m_slCount = 1U << m_slLog2;
+		static constexpr uint32_t m_flCount = 40;
+		static constexpr uint32_t m_nullRange = UINT32_MAX;
+
+		struct Range
+		{
+			uint64_t m_offsetInGranules{ 0 };
+			uint64_t m_sizeInGranules{ 0 };
+
+			uint32_t m_prevPhysical{ m_nullRange };
+			uint32_t m_nextPhysical{ m_nullRange };
+			uint32_t m_prevFree{ m_nullRange };
+			uint32_t m_nextFree{ m_nullRange };
+
+			bool m_isFree{ false };
+		};
+
+		static void MappingInsert(uint64_t l_sizeInGranules, uint32_t& l_fl, uint32_t& l_sl);
+		static void MappingSearch(uint64_t l_sizeInGranules, uint32_t& l_fl, uint32_t& l_sl);
+
+		uint32_t CreateRange();
+		void ReleaseRange(uint32_t l_rangeHandle);
+
+		void InsertFreeRange(uint32_t l_rangeHandle);
+		void RemoveFreeRange(uint32_t l_rangeHandle);
+		uint32_t FindSuitableFreeRange(uint64_t l_sizeInGranules);
+		uint32_t FindFreeRangeContaining(uint64_t l_offsetInGranules, uint64_t l_sizeInGranules) const;
+
+		//Cuts l_sizeInGranules off the front of the range and returns the handle of the remainder
+		uint32_t SplitRange(uint32_t l_rangeHandle, uint64_t l_sizeInGranules);
+		void MergeWithNext(uint32_t l_rangeHandle);
+
+		std::vector<Range> m_ranges{};
+		std::vector<uint32_t> m_unusedRangeHandles{};
+
+		uint64_t m_flBitmap{ 0 };
+		std::array<uint32_t, m_flCount> m_slBitmaps{};
+		std::array<std::array<uint32_t, m_slCount>, m_flCount> m_freeLists{};
+
+		VkDeviceSize m_capacityInBytes{ 0 };
+		VkDeviceSize m_usedBytes{ 0 };
+		uint32_t m_totalNumAllocations{ 0 };
+	};
+
+
+	//A range that PlanBlockDrain() may move, m_blockIndex is the block it lives in
+	struct TlsfDrainCandidate
+	{
+		uint32_t m_blockIndex{ UINT32_MAX };
+		VkDeviceSize m_sizeInBytes{ 0 };
+		VkDeviceSize m_alignment{ 1 };
+	};
+
+
+	struct TlsfDrainPlacement
+	{
+		//Index into the candidates that were handed to PlanBlockDrain()
+		uint32_t m_candidateIndex{ UINT32_MAX };
+
+		uint32_t m_blockIndex{ UINT32_MAX };
+		VkDeviceSize m_offset{ 0 };
+		uint32_t m_rangeHandle{ UINT32_MAX };
+	};
+
+
+	//Vulkan free core of GpuMemoryAllocator::PlanDefragmentation(). The least occupied non empty block is drained:
+	//every candidate living in it gets a range in one of the other blocks, first fit in block order, and that range
+	//is already reserved on return. Released blocks are nullptr. Pools with fewer than two live blocks are left alone.
+	std::vector<TlsfDrainPlacement> PlanBlockDrain(std::span<TlsfRangeAllocator* const> l_blocks,
+		std::span<const TlsfDrainCandidate> l_candidates);
+
+
+
+
+	//Sub-allocates buffers and images out of large VkDeviceMemory blocks instead of calling
+	//vkAllocateMemory once per resource. Host visible blocks stay mapped for their whole lifetime.
+	//Resources that the driver prefers to be dedicated, or that are too big for a block, get their own allocation.
+	//Every public member function is thread safe.
+	class GpuMemoryAllocator final
+	{
+	public:
+
+		explicit GpuMemoryAllocator(VulkanRenderDevice& l_renderDevice);
+		~GpuMemoryAllocator();
+
+		GpuMemoryAllocator(const GpuMemoryAllocator&) = delete;
+		GpuMemoryAllocator& operator=(const GpuMemoryAllocator&) = delete;
+
+		//l_dedicatedBuffer/l_dedicatedImage are only used when the allocation ends up being dedicated
+		GpuMemoryAllocation Allocate(const VkMemoryRequirements& l_memoryRequirements,
+			VkMemoryPropertyFlags l_memoryProperties, GpuResourceTiling l_tiling,
+			bool l_preferDedicated = false,
+			VkBuffer l_dedicatedBuffer = VK_NULL_HANDLE, VkImage l_dedicatedImage = VK_NULL_HANDLE);
+
+		void Free(GpuMemoryAllocation& l_allocation);
+
+		//Looks for the least occupied block of every pool and tries to move the allocations living in it
+		//into the other blocks of the same pool. The destination ranges are already reserved when this returns;
+		//the caller copies the data, rebinds its resources and frees the source allocations.
+		std::vector<GpuDefragmentationMove> PlanDefragmentation(const std::vector<GpuMemoryAllocation>& l_allocations);
+
+		//Returns the blocks that no longer hold any allocation to the driver
+		uint32_t ReleaseEmptyBlocks();
+
+		GpuMemoryStats GetStats() const;
+		void PrintStats() const;
+
+		std::vector<GpuMemoryHeapBudget> GetHeapBudgets() const;
+		bool IsMemoryBudgetSupported() const;
+
+	private:
+
+		struct MemoryBlock
+		{
+			VkDeviceMemory m_memory{ VK_NULL_HANDLE };
+			void* m_mappedData{ nullptr };
+			TlsfRangeAllocator m_ranges{};
+		};
+
+		struct MemoryPool
+		{
+			uint32_t m_memoryTypeIndex{ UINT32_MAX };
+			VkDeviceSize m_blockSize{ 0 };
+			std::vector<MemoryBlock> m_blocks{};
+		};
+
+		uint32_t FindMemoryTypeIndex(uint32_t l_memoryTypeBits, VkMemoryPropertyFlags l_memoryProperties) const;
+		VkDeviceSize ComputePreferredBlockSize(uint32_t l_memoryTypeIndex) const;
+
+		bool AllocateFromPool(uint32_t l_poolIndex, VkDeviceSize l_size, VkDeviceSize l_alignment,
+			uint32_t l_excludedBlockIndex, bool l_allowNewBlock, GpuMemoryAllocation& l_allocation);
+		bool AllocateFromBlock(uint32_t l_poolIndex, uint32_t l_blockIndex, VkDeviceSize l_size,
+			VkDeviceSize l_alignment, GpuMemoryAllocation& l_allocation);
+
+		//Describes a range that was already reserved in the block
+		void FillBlockAllocation(uint32_t l_poolIndex, uint32_t l_blockIndex, VkDeviceSize l_size,
+			VkDeviceSize l_alignment, VkDeviceSize l_offset, uint32_t l_rangeHandle, GpuMemoryAllocation& l_allocation) const;
+
+		GpuMemoryAllocation AllocateDedicated(uint32_t l_memoryTypeIndex, VkDeviceSize l_size,
+			VkBuffer l_dedicatedBuffer, VkImage l_dedicatedImage);
+
+		VkDeviceMemory AllocateDeviceMemory(uint32_t l_memoryTypeIndex, VkDeviceSize l_size,
+			const void* l_pNext, void** l_mappedData);
+		void FreeDeviceMemory(VkDeviceMemory l_memory, uint32_t l_memoryTypeIndex, VkDeviceSize l_size);
+
+
+		VulkanRenderDevice& m_renderDevice;
+		VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+		VkDeviceSize m_maxMemoryAllocationCount{ 0 };
+
+		mutable std::mutex m_mutex{};
+
+		std::vector<MemoryPool> m_pools{};
+
+		uint32_t m_totalNumDeviceMemoryObjects{ 0 };
+		uint32_t m_totalNumDedicatedAllocations{ 0 };
+		VkDeviceSize m_totalDedicatedBytes{ 0 };
+
+		std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> m_allocatedBytesPerHeap{};
+	};
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+
+
+#include <cinttypes>
+#include <functional>
+
+
+
+namespace RenderCore
+{
+
+	//Index into one of the resource vectors of VulkanResourceManager plus the generation of that slot
+	//at the time the handle was made. A slot's generation changes when the resource in it is released,
+	//so a stale handle is caught on resolve instead of silently aliasing whatever reuses the slot.
+	//The tag only exists to stop a buffer handle from being passed where a texture handle is expected.
+	template<typename Tag>
+	struct GpuResourceHandle
+	{
+		uint32_t m_index = UINT32_MAX;
+		uint32_t m_generation = 0;
+
+		bool IsValid() const { return UINT32_MAX != m_index; }
+
+		bool operator==(const GpuResourceHandle&) const = default;
+	};
+
+
+	struct BufferHandleTag {};
+	struct TextureHandleTag {};
+	struct PipelineHandleTag {};
+
+	using BufferHandle = GpuResourceHandle<BufferHandleTag>;
+	using TextureHandle = GpuResourceHandle<TextureHandleTag>;
+	using PipelineHandle = GpuResourceHandle<PipelineHandleTag>;
+
+}
+
+
+template<typename Tag>
+struct std::hash<RenderCore::GpuResourceHandle<Tag>>
+{
+	size_t operator()(const RenderCore::GpuResourceHandle<Tag>& l_handle) const noexcept
+	{
+		return std::hash<uint64_t>{}((uint64_t)l_handle.m_generation << 32 | l_handle.m_index);
+	}
+};
@@ -141,6 +141,13 @@ namespace RenderCore
 		{
 			IndirectRenderer* lv_indirect = (IndirectRenderer*)m_indirectRenderer->m_renderer;
 			m_totalNumVisibleMeshes = lv_indirect->GetTotalNumVisibleMeshes();
+			m_totalNumVisibleMeshlets = lv_indirect->GetTotalNumVisibleMeshlets();
+
+			const auto& lv_lodStatistics = lv_indirect->GetLodStatistics();
+			for (uint32_t i = 0; i < MeshConverter::lv_maxLODCount; ++i) {
+				m_lodTotalNumInstances[i] = lv_lodStatistics[i].m_totalNumInstances;
+				m_lodTotalNumTriangles[i] = lv_lodStatistics[i].m_totalNumTriangles;
+			}
 			
 		}
 	}
@@ -290,6 +297,16 @@ namespace RenderCore
 
 			ImGui::Text("Frustum culling\n");
 			ImGui::Text("There are %u visible meshes", m_totalNumVisibleMeshes);
+			ImGui::Text("There are %u visible meshlets", m_totalNumVisibleMeshlets);
+			ImGui::Checkbox("Cull meshlets on the CPU", &m_cullMeshletsOnCpu);
+			ImGui::Checkbox("Meshlet backface cone culling", &m_meshletConeCulling);
+
+
+			ImGui::Text("\nLevels of detail\n");
+			ImGui::SliderFloat("LOD error threshold (px)", &m_lodPixelThreshold, 0.25f, 16.f);
+			for (uint32_t i = 0; i < MeshConverter::lv_maxLODCount - 1; ++i) {
+				ImGui::Text("LOD %u: %u meshes, %u triangles", i, m_lodTotalNumInstances[i], m_lodTotalNumTriangles[i]);
+			}
 
 
 			ImGui::Text("\nTiled Deferred Lightning\n");
@@ -322,6 +339,38 @@ namespace RenderCore
 			ImGui::End();
 		}
 
+		{
+			constexpr float lv_bytesToMegaBytes = 1.f / (1024.f * 1024.f);
+
+			ImGui::Begin("GPU memory");
+
+			for (uint32_t i = 0; i < (uint32_t)GpuMemoryCategory::m_count; ++i) {
+				const auto lv_categoryStats = lv_vkResManager.GetMemoryCategoryStats((GpuMemoryCategory)i);
+				ImGui::Text("%-14s %4u allocations %9.2f MB", GpuMemoryCategoryToString((GpuMemoryCategory)i),
+					lv_categoryStats.m_totalNumAllocations, lv_categoryStats.m_totalBytes * lv_bytesToMegaBytes);
+			}
+
+			ImGui::Text(true == lv_vkResManager.IsMemoryBudgetSupported() ? "\nHeaps (VK_EXT_memory_budget)"
+				: "\nHeaps (allocator usage only)");
+
+			const auto lv_heapBudgets = lv_vkResManager.GetMemoryHeapBudgets();
+			for (size_t i = 0; i < lv_heapBudgets.size(); ++i) {
+				const auto& lv_heapBudget = lv_heapBudgets[i];
+				const float lv_usageRatio = (0 == lv_heapBudget.m_budget) ? 0.f
+					: (float)((double)lv_heapBudget.m_usage / (double)lv_heapBudget.m_budget);
+
+				ImGui::Text("Heap %zu%s : %.2f / %.2f MB", i, true == lv_heapBudget.m_deviceLocal ? " (device local)" : "",
+					lv_heapBudget.m_usage * lv_bytesToMegaBytes, lv_heapBudget.m_budget * lv_bytesToMegaBytes);
+				ImGui::ProgressBar(lv_usageRatio);
+			}
+
+			if (true == ImGui::Button("Write memory report")) {
+				lv_vkResManager.WriteMemoryReport("GpuMemoryReport.json");
+			}
+
+			ImGui::End();
+		}
+
 		//if(true == lv_showAnotherWindow)
 		//{
 		//	ImGui::Begin("Another Window", &lv_showAnotherWindow);   // Pass a pointer to our bool variable (the window will have a closing button that will clear the bool when clicked)
@@ -404,6 +453,11 @@ namespace RenderCore
 
 		lv_pointLightCube->SetLightIntensity(m_lightIntensity);
 		lv_deferredLightning->SetPointLightIntensity(m_lightIntensity);
+
+		IndirectRenderer* lv_indirect = (IndirectRenderer*)m_indirectRenderer->m_renderer;
+		lv_indirect->SetMeshletCullingOnCpu(m_cullMeshletsOnCpu);
+		lv_indirect->SetMeshletConeCulling(m_meshletConeCulling);
+		lv_indirect->SetLodPixelThreshold(m_lodPixelThreshold);
 	}
 
 
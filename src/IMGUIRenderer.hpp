@@ -5,6 +5,8 @@
 #include "Renderbase.hpp"
 #include <GLFW/glfw3.h>
 #include "FrameGraph.hpp"
+#include "Mesh.hpp"
+#include <array>
 
 
 
@@ -54,6 +56,12 @@ namespace RenderCore
 		
 		VulkanEngine::FrameGraphNode* m_indirectRenderer;
 		uint32_t m_totalNumVisibleMeshes{};
+		uint32_t m_totalNumVisibleMeshlets{};
+		bool m_cullMeshletsOnCpu{ false };
+		bool m_meshletConeCulling{ true };
+		float m_lodPixelThreshold{ 1.f };
+		std::array<uint32_t, MeshConverter::lv_maxLODCount> m_lodTotalNumInstances{};
+		std::array<uint32_t, MeshConverter::lv_maxLODCount> m_lodTotalNumTriangles{};
 
 		VulkanEngine::FrameGraphNode* m_ssaoRenderer;
 		uint32_t m_ssaoSortedHandle{};
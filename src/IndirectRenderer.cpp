@@ -2,13 +2,16 @@
 
 
 #include "IndirectRenderer.hpp"
+#include <algorithm>
 #include <array>
 #include "ErrorCheck.hpp"
 #include <glm/gtc/type_ptr.hpp>
 #include <format>
 #include <string>
+#include <span>
 #include "CameraStructure.hpp"
 #include "UtilsMath.h"
+#include "MeshCompression.hpp"
 
 
 namespace RenderCore
@@ -32,7 +35,6 @@ namespace RenderCore
 		
 		auto& lv_contextCreator = m_vulkanRenderContext.GetContextCreator();
 		auto& lv_vulkanResourceManager = m_vulkanRenderContext.GetResourceManager();
-		auto lv_totalNumSwapchains = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
 		auto& lv_frameGraph = m_vulkanRenderContext.GetFrameGraph();
 
 		const float lv_ratio = (float)lv_contextCreator.m_vkDev.m_framebufferWidth / (float)lv_contextCreator.m_vkDev.m_framebufferHeight;
@@ -50,46 +52,38 @@ namespace RenderCore
 
 		auto lv_meshHeader = LoadMeshData(l_meshHeaderFile);
 
-		if (0x12345678 != lv_meshHeader.m_magicValue) {
-			printf("Mesh header file is corrupted.\n");
-			exit(EXIT_FAILURE);
-		}
-		m_vertexBufferSize = lv_meshHeader.m_vertexDataSize;
-		m_indexBufferSize = lv_meshHeader.m_lodDataSize;
+		//Constant ids match Indirect.vert and DepthMapLight.vert
+		m_vertexStrideInBytes = lv_meshHeader.m_vertexStrideInBytes;
+		m_vertexFormatConstants.Set(0U, MeshConverter::VertexFormat::m_packed == lv_meshHeader.m_vertexFormat);
+		m_vertexFormatConstants.Set(1U, MeshConverter::PositionEncoding::m_half == lv_meshHeader.m_positionEncoding);
+		m_vertexFormatConstants.Set(2U, (int32_t)lv_meshHeader.m_octahedralBits);
 
 		m_materialBufferSize =(uint32_t) (m_materialLoaderSaver.GetMaterials().size()*sizeof(SceneConverter::Material));
 		
-		for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
-			m_uniformBuffers.push_back(lv_vulkanResourceManager.CreateBuffer(sizeof(IndirectUniformBuffer), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-				std::format("IndirectUniformBuffer {} ", i).c_str()));
-		}
-
 		auto lv_totalNumSwapchainImages = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
 		
 		m_materialBufferHandle = lv_vulkanResourceManager.CreateBufferWithHandle(m_materialBufferSize, 
 					VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
 					VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, " Material-Buffer-Indirect ");
-		lv_vulkanResourceManager.AddGpuResource(" Material-Buffer-Indirect ", m_materialBufferHandle,
-			VulkanResourceManager::VulkanDataType::m_buffer);
-
-		UpdateLocalDeviceBuffers(l_cmdBuffer, m_materialBufferHandle, m_materialLoaderSaver.GetMaterials().data());
+		lv_vulkanResourceManager.AddGpuResource(" Material-Buffer-Indirect ", m_materialBufferHandle);
 
-		VkPhysicalDeviceProperties lv_devProps;
-		vkGetPhysicalDeviceProperties(lv_contextCreator.m_vkDev.m_physicalDevice,
-			&lv_devProps);
-		const uint32_t lv_offsetAlignment = lv_devProps.limits.minStorageBufferOffsetAlignment;
-
-
-		if ((m_vertexBufferSize & (lv_offsetAlignment - 1)) != 0)
+		//Materials store indices into the texture file list, the shader indexes the bindless heap by heap slot
 		{
-			int floats = (lv_offsetAlignment - (m_vertexBufferSize & (lv_offsetAlignment - 1))) / sizeof(float);
-
-			for (int ii = 0; ii < floats; ii++) {
-				m_vertexBuffers.push_back(0);
+			auto lv_materials = m_materialLoaderSaver.GetMaterials();
+			const int lv_totalNumSceneTextures = (int)m_textureHandlesOfScene.size();
+
+			for (auto& l_material : lv_materials) {
+				for (int* l_textureIndex : { &l_material.m_ambientOcclusionMap, &l_material.m_emissiveMap,
+					&l_material.m_albedoMap, &l_material.m_metallicRoughnessMap, &l_material.m_normalMap,
+					&l_material.m_opacityMap, &l_material.m_metallicMap, &l_material.m_roughnessMap }) {
+
+					if (0 <= *l_textureIndex && lv_totalNumSceneTextures > *l_textureIndex) {
+						*l_textureIndex = (int)lv_vulkanResourceManager.GetBindlessTextureSlot(m_textureHandlesOfScene[*l_textureIndex]);
+					}
+				}
 			}
 
-			m_vertexBufferSize = (m_vertexBufferSize + lv_offsetAlignment) & ~(lv_offsetAlignment - 1);
+			UpdateLocalDeviceBuffers(m_materialBufferHandle, lv_materials.data());
 		}
 
 
@@ -103,18 +97,7 @@ namespace RenderCore
 
 
 
-		{
-
-
-			m_vertexDataBufferHandle = m_vulkanRenderContext.GetResourceManager()
-				.CreateBufferWithHandle(m_vertexBufferSize + m_indexBufferSize, 
-					VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-					VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, " Vertex-Buffer-Indirect ");
-
-			m_indicesDataBufferHandle = m_vertexDataBufferHandle;
-		}
-
-		UpdateGeometryBuffers(l_cmdBuffer);
+		UpdateGeometryBuffers();
 
 		{
 			m_transformationsBufferHandles.resize(lv_contextCreator.m_vkDev.m_swapchainImages.size());
@@ -124,7 +107,8 @@ namespace RenderCore
 					.CreateBufferWithHandle(sizeof(glm::mat4) * m_sceneLoaderSaver.GetScene().m_globalTransforms.size(), 
 						VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
 						VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-						VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, " Transformation-matrices-Buffer-Indirect ");
+						VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, " Transformation-matrices-Buffer-Indirect ",
+						GpuMemoryCategory::m_geometry);
 
 				UpdateTransformationsBuffer(i);
 			}
@@ -138,7 +122,7 @@ namespace RenderCore
 
 			m_indirectBufferHandles[i] = m_vulkanRenderContext.GetResourceManager()
 				.CreateBufferWithHandle(sizeof(VkDrawIndirectCommand) * m_totalNumInstances,
-					VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+					VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
 					VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
 					VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
 					std::format("Indirect-Buffer-Shader-Indirect {}", i).c_str());
@@ -150,53 +134,60 @@ namespace RenderCore
 				.CreateBufferWithHandle(m_instanceBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
 					VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
 					VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-					std::format("Instance-Buffer-Indirect {}", i).c_str());
+					std::format("Instance-Buffer-Indirect {}", i).c_str(), GpuMemoryCategory::m_geometry);
 
 			UpdateInstanceBuffer(i);
 
 		}
 
-		GeneratePipelineFromSpirvBinaries(l_spirvFile);
-		SetRenderPassAndFrameBuffer("IndirectGbuffer");
+		CreateMeshletCullingResources();
 
-		SetNodeToAppropriateRenderpass("IndirectGbuffer", this);
+		//Scene textures all come out of LoadTexture2D with the same cached sampler, which the bindless heap bakes in
+		//as an immutable sampler. The shader gets its index in the sampler table as a push constant
+		VkSampler lv_sceneTextureSampler{ VK_NULL_HANDLE };
 
-		auto* lv_node = lv_frameGraph.RetrieveNode("IndirectGbuffer");
+		for (auto& l_textureHandle : m_textureHandlesOfScene) {
 
-		m_attachmentHandles.resize(lv_node->m_inputResourcesHandles.size() * lv_totalNumSwapchainImages);
+			const VkSampler lv_sampler = lv_vulkanResourceManager.RetrieveGpuTexture(l_textureHandle).sampler;
 
-		for (size_t i = 0, j = 0; i < lv_node->m_inputResourcesHandles.size() *lv_totalNumSwapchainImages; i+= lv_node->m_inputResourcesHandles.size(), ++j) {
-			
-			auto lv_formattedArg = std::make_format_args(j);
+			if (VK_NULL_HANDLE != lv_sceneTextureSampler && lv_sceneTextureSampler != lv_sampler) {
+				printf("Scene textures use different samplers, all of them are sampled with the first one.\n");
+				break;
+			}
 
-			std::string lv_formattedString{"GBufferTangent {}"};
-			auto lv_colorMeta = lv_vulkanResourceManager.RetrieveGpuResourceMetaData(std::vformat(lv_formattedString,lv_formattedArg));
+			lv_sceneTextureSampler = lv_sampler;
+		}
+
+		if (VK_NULL_HANDLE != lv_sceneTextureSampler) {
 
-			lv_formattedString = "GBufferPosition {}";
-			auto lv_posMeta = lv_vulkanResourceManager.RetrieveGpuResourceMetaData(std::vformat(lv_formattedString, lv_formattedArg));
+			const uint32_t lv_samplerIndex = lv_vulkanResourceManager.GetBindlessHeap().GetSamplerIndex(lv_sceneTextureSampler);
 
-			lv_formattedString = "GBufferNormal {}";
-			auto lv_normalMeta = lv_vulkanResourceManager.RetrieveGpuResourceMetaData(std::vformat(lv_formattedString, lv_formattedArg));
+			if (UINT32_MAX == lv_samplerIndex) {
+				printf("The scene texture sampler is not one of the immutable samplers of the bindless heap, the first one is used.\n");
+			}
+			else {
+				m_sceneSamplerIndex = lv_samplerIndex;
+			}
+		}
 
-			lv_formattedString = "GBufferAlbedoSpec {}";
-			auto lv_albedoSpecMeta = lv_vulkanResourceManager.RetrieveGpuResourceMetaData(std::vformat(lv_formattedString, lv_formattedArg));
+		GeneratePipelineFromSpirvBinaries(l_spirvFile, true);
+		SetRenderPassAndFrameBuffer("IndirectGbuffer");
 
-			lv_formattedString = "GBufferNormalVertex {}";
-			auto lv_normalVertexMeta = lv_vulkanResourceManager.RetrieveGpuResourceMetaData(std::vformat(lv_formattedString, lv_formattedArg));
+		SetNodeToAppropriateRenderpass("IndirectGbuffer", this);
 
-			lv_formattedString = "GBufferMetallic {}";
-			auto lv_metallicMeta = lv_vulkanResourceManager.RetrieveGpuResourceMetaData(std::vformat(lv_formattedString, lv_formattedArg));
+		auto* lv_node = lv_frameGraph.RetrieveNode("IndirectGbuffer");
 
-			lv_formattedString = "Depth {}";
-			auto lv_depthMeta = lv_vulkanResourceManager.RetrieveGpuResourceMetaData(std::vformat(lv_formattedString, lv_formattedArg));
+		m_attachmentHandles.resize(lv_node->m_inputResourcesHandles.size() * lv_totalNumSwapchainImages);
 
-			m_attachmentHandles[i] = lv_colorMeta.m_resourceHandle;
-			m_attachmentHandles[i+1] = lv_posMeta.m_resourceHandle;
-			m_attachmentHandles[i+2] = lv_normalMeta.m_resourceHandle;
-			m_attachmentHandles[i+3] = lv_albedoSpecMeta.m_resourceHandle;
-			m_attachmentHandles[i+4] = lv_normalVertexMeta.m_resourceHandle;
-			m_attachmentHandles[i + 5] = lv_metallicMeta.m_resourceHandle;
-			m_attachmentHandles[i + 6] = lv_depthMeta.m_resourceHandle;
+		for (size_t i = 0, j = 0; i < lv_node->m_inputResourcesHandles.size() *lv_totalNumSwapchainImages; i+= lv_node->m_inputResourcesHandles.size(), ++j) {
+			
+			m_attachmentHandles[i] = lv_vulkanResourceManager.RetrieveGpuTextureHandle("GBufferTangent", (uint32_t)j);
+			m_attachmentHandles[i+1] = lv_vulkanResourceManager.RetrieveGpuTextureHandle("GBufferPosition", (uint32_t)j);
+			m_attachmentHandles[i+2] = lv_vulkanResourceManager.RetrieveGpuTextureHandle("GBufferNormal", (uint32_t)j);
+			m_attachmentHandles[i+3] = lv_vulkanResourceManager.RetrieveGpuTextureHandle("GBufferAlbedoSpec", (uint32_t)j);
+			m_attachmentHandles[i+4] = lv_vulkanResourceManager.RetrieveGpuTextureHandle("GBufferNormalVertex", (uint32_t)j);
+			m_attachmentHandles[i + 5] = lv_vulkanResourceManager.RetrieveGpuTextureHandle("GBufferMetallic", (uint32_t)j);
+			m_attachmentHandles[i + 6] = lv_vulkanResourceManager.RetrieveGpuTextureHandle("Depth", (uint32_t)j);
 		}
 
 
@@ -208,7 +199,7 @@ namespace RenderCore
 		lv_frameGraph.IncrementNumNodesPerCmdBuffer(0);
 
 		m_pipelineLayout = m_vulkanRenderContext.GetResourceManager()
-			.CreatePipelineLayout(m_descriptorSetLayout, " Pipeline-Layout-Indirect ");
+			.CreatePipelineLayoutWithBindlessHeap(m_descriptorSetLayout, " Pipeline-Layout-Indirect ", sizeof(uint32_t));
 
 		VulkanResourceManager::PipelineInfo lv_pipelineInfo{};
 		lv_pipelineInfo.m_dynamicScissorState = false;
@@ -218,10 +209,11 @@ namespace RenderCore
 		lv_pipelineInfo.m_useDepth = true;
 		lv_pipelineInfo.m_topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
 		lv_pipelineInfo.m_totalNumColorAttach = ((uint32_t)lv_node->m_outputResourcesHandles.size())-1;
+		lv_pipelineInfo.m_specializationConstants = m_vertexFormatConstants;
 
-		m_graphicsPipeline = m_vulkanRenderContext.GetResourceManager()
-			.CreateGraphicsPipeline(m_renderPass, m_pipelineLayout,
-				{ l_vtxShaderFile, l_fragShaderFile }, " Graphics-Pipeline-Indirect ", lv_pipelineInfo);
+		m_vulkanRenderContext.GetResourceManager()
+			.RequestGraphicsPipeline(m_renderPass, m_pipelineLayout,
+				{ l_vtxShaderFile, l_fragShaderFile }, " Graphics-Pipeline-Indirect ", lv_pipelineInfo, m_graphicsPipeline);
 	}
 
 
@@ -320,11 +312,21 @@ namespace RenderCore
 		m_cameraFrustum.m_viewMatrix = l_cameraStructure.m_viewMatrix;
 		getFrustumCorners(lv_mtx, m_cameraFrustum.m_debugViewFrustumCorners);
 		getFrustumPlanes(lv_mtx, m_cameraFrustum.m_debugViewFrustumPlanes);
+
+		if (m_vulkanRenderContext.GetResourceManager().GetGeometryHeap().GetLayoutVersion() != m_geometryLayoutVersion) {
+			UpdateInstanceGeometryOffsets();
+		}
+
+		UpdateInstanceLods(lv_camPosVec3, l_cameraStructure.m_projectionMatrix);
 		UpdateIndirectBuffer(l_currentSwapchainIndex);
+
+		m_meshletCullingView = CreateMeshletCullingView(lv_mtx, lv_camPosVec3, m_meshletConeCulling);
+
 		UpdateInstanceBuffer(l_currentSwapchainIndex);
 		UpdateTransformationsBuffer(l_currentSwapchainIndex);
+		UpdateMeshletCullingBuffers(l_currentSwapchainIndex);
 
-		memcpy(m_uniformBuffers[l_currentSwapchainIndex].ptr, &lv_uniformBuffer, sizeof(IndirectUniformBuffer));
+		m_dynamicUniformOffsets[0] = m_vulkanRenderContext.GetResourceManager().GetUniformArena().Push(lv_uniformBuffer);
 	}
 
 
@@ -344,6 +346,150 @@ namespace RenderCore
 			sizeof(glm::mat4)* m_sceneLoaderSaver.GetScene().m_globalTransforms.size());
 	}
 
+	void IndirectRenderer::UpdateMeshletCullingBuffers(uint32_t l_currentSwapchainIndex)
+	{
+		auto& lv_vulkanResourceManager = m_vulkanRenderContext.GetResourceManager();
+
+		auto& lv_viewBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(m_meshletCullingViewBufferHandles[l_currentSwapchainIndex]);
+		auto& lv_drawBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(m_meshletDrawBufferHandles[l_currentSwapchainIndex]);
+		auto& lv_drawCountBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(m_meshletDrawCountBufferHandles[l_currentSwapchainIndex]);
+		auto& lv_instanceDrawBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(m_indirectBufferHandles[l_currentSwapchainIndex]);
+
+		memcpy(lv_viewBuffer.ptr, &m_meshletCullingView, sizeof(MeshletCullingView));
+
+		uint32_t* lv_drawCount = (uint32_t*)lv_drawCountBuffer.ptr;
+
+		if (false == m_cullMeshletsOnCpu) {
+			//Still holds what the compute pass wrote the last time this image was rendered
+			m_totalNumVisibleMeshlets = std::min(*lv_drawCount, m_maxNumMeshletDraws);
+			return;
+		}
+
+		*lv_drawCount = CullMeshlets(m_meshletCullingView, m_outputInstanceData,
+			std::span<const VkDrawIndirectCommand>{ (const VkDrawIndirectCommand*)lv_instanceDrawBuffer.ptr, m_totalNumInstances },
+			m_meshletRanges, m_meshlets,
+			std::span<VkDrawIndirectCommand>{ (VkDrawIndirectCommand*)lv_drawBuffer.ptr, m_maxNumMeshletDraws });
+
+		m_totalNumVisibleMeshlets = *lv_drawCount;
+	}
+
+	void IndirectRenderer::CreateMeshletCullingResources()
+	{
+		auto& lv_vulkanResourceManager = m_vulkanRenderContext.GetResourceManager();
+		const uint32_t lv_totalNumSwapchainImages = (uint32_t)m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
+
+		//Ranges of LODs a mesh does not have stay empty
+		m_meshletRanges.resize(m_meshes.size() * MeshConverter::lv_maxLODCount);
+
+		for (size_t i = 0; i < m_meshes.size(); ++i) {
+			for (uint32_t j = 0; j < m_meshes[i].m_lodCount; ++j) {
+				m_meshletRanges[i * MeshConverter::lv_maxLODCount + j] = MeshletRange{
+					.m_firstMeshlet = m_meshes[i].m_lodMeshletOffsets[j], .m_totalNumMeshlets = m_meshes[i].CalculateLODNumberOfMeshlets(j) };
+			}
+		}
+
+		m_maxNumMeshletDraws = 0;
+
+		for (const auto& l_instance : m_outputInstanceData) {
+
+			uint32_t lv_maxNumMeshlets{ 0 };
+
+			for (uint32_t j = 0; j < m_meshes[l_instance.m_meshIndex].m_lodCount; ++j) {
+				lv_maxNumMeshlets = std::max(lv_maxNumMeshlets, m_meshes[l_instance.m_meshIndex].CalculateLODNumberOfMeshlets(j));
+			}
+
+			m_maxNumMeshletDraws += lv_maxNumMeshlets;
+		}
+
+		m_meshletBufferHandle = lv_vulkanResourceManager.CreateBufferWithHandle(sizeof(MeshConverter::Meshlet) * m_meshlets.size(),
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, " Meshlet-Buffer-Indirect ", GpuMemoryCategory::m_geometry);
+		UpdateLocalDeviceBuffers(m_meshletBufferHandle, m_meshlets.data());
+
+		m_meshletRangeBufferHandle = lv_vulkanResourceManager.CreateBufferWithHandle(sizeof(MeshletRange) * m_meshletRanges.size(),
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, " Meshlet-Range-Buffer-Indirect ", GpuMemoryCategory::m_geometry);
+		UpdateLocalDeviceBuffers(m_meshletRangeBufferHandle, m_meshletRanges.data());
+
+		m_meshletCullingViewBufferHandles.resize(lv_totalNumSwapchainImages);
+		m_meshletDrawBufferHandles.resize(lv_totalNumSwapchainImages);
+		m_meshletDrawCountBufferHandles.resize(lv_totalNumSwapchainImages);
+
+		//Host visible, so that the CPU path can write the draws in place of the compute pass
+		for (uint32_t i = 0; i < lv_totalNumSwapchainImages; ++i) {
+
+			m_meshletCullingViewBufferHandles[i] = lv_vulkanResourceManager.CreateBufferWithHandle(sizeof(MeshletCullingView),
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+				std::format("Meshlet-Culling-View-Buffer-Indirect {}", i).c_str());
+
+			m_meshletDrawBufferHandles[i] = lv_vulkanResourceManager.CreateBufferWithHandle(
+				sizeof(VkDrawIndirectCommand) * std::max(m_maxNumMeshletDraws, 1U),
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+				std::format("Meshlet-Draw-Buffer-Indirect {}", i).c_str());
+
+			m_meshletDrawCountBufferHandles[i] = lv_vulkanResourceManager.CreateBufferWithHandle(sizeof(uint32_t),
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+				std::format("Meshlet-Draw-Count-Buffer-Indirect {}", i).c_str());
+
+			*(uint32_t*)lv_vulkanResourceManager.RetrieveGpuBuffer(m_meshletDrawCountBufferHandles[i]).ptr = 0U;
+		}
+
+		//Set 0 stays empty, every buffer of the pass is reached through the bindless heap
+		const VkDescriptorSetLayoutCreateInfo lv_emptySetLayoutInfo{ .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+			.pNext = nullptr, .flags = 0, .bindingCount = 0, .pBindings = nullptr };
+		auto& lv_emptySetLayout = lv_vulkanResourceManager.CreateDescriptorSetLayout(lv_emptySetLayoutInfo,
+			" Descriptor-Set-Layout-Meshlet-Culling ");
+
+		m_meshletCullingPipelineLayout = lv_vulkanResourceManager.CreatePipelineLayoutWithBindlessHeap(lv_emptySetLayout,
+			" Pipeline-Layout-Meshlet-Culling ", sizeof(MeshletCullingPushConstants));
+
+		lv_vulkanResourceManager.RequestComputePipeline("Shaders/MeshletCulling.comp", m_meshletCullingPipelineLayout,
+			" Compute-Pipeline-Meshlet-Culling ", m_meshletCullingPipeline);
+
+		printf("Meshlet culling: %u meshlets, at most %u meshlet draws per frame.\n", (uint32_t)m_meshlets.size(), m_maxNumMeshletDraws);
+	}
+
+	void IndirectRenderer::RecordMeshletCulling(VkCommandBuffer l_commandBuffer, uint32_t l_currentSwapchainIndex)
+	{
+		auto& lv_vulkanResourceManager = m_vulkanRenderContext.GetResourceManager();
+		auto& lv_drawCountBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(m_meshletDrawCountBufferHandles[l_currentSwapchainIndex]);
+
+		vkCmdFillBuffer(l_commandBuffer, lv_drawCountBuffer.buffer, 0, sizeof(uint32_t), 0U);
+
+		const VkMemoryBarrier lv_clearBarrier{ .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER, .pNext = nullptr,
+			.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT };
+		vkCmdPipelineBarrier(l_commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			0, 1, &lv_clearBarrier, 0, nullptr, 0, nullptr);
+
+		const MeshletCullingPushConstants lv_pushConstants{
+			.m_meshletBuffer = lv_vulkanResourceManager.GetBindlessBufferSlot(m_meshletBufferHandle),
+			.m_meshletRangeBuffer = lv_vulkanResourceManager.GetBindlessBufferSlot(m_meshletRangeBufferHandle),
+			.m_instanceBuffer = lv_vulkanResourceManager.GetBindlessBufferSlot(m_instanceBuffersGpu[l_currentSwapchainIndex]),
+			.m_instanceDrawBuffer = lv_vulkanResourceManager.GetBindlessBufferSlot(m_indirectBufferHandles[l_currentSwapchainIndex]),
+			.m_viewBuffer = lv_vulkanResourceManager.GetBindlessBufferSlot(m_meshletCullingViewBufferHandles[l_currentSwapchainIndex]),
+			.m_drawBuffer = lv_vulkanResourceManager.GetBindlessBufferSlot(m_meshletDrawBufferHandles[l_currentSwapchainIndex]),
+			.m_drawCountBuffer = lv_vulkanResourceManager.GetBindlessBufferSlot(m_meshletDrawCountBufferHandles[l_currentSwapchainIndex]),
+			.m_maxNumDraws = m_maxNumMeshletDraws };
+
+		vkCmdBindPipeline(l_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_meshletCullingPipeline);
+		lv_vulkanResourceManager.GetBindlessHeap().Bind(l_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_meshletCullingPipelineLayout, 1);
+		vkCmdPushConstants(l_commandBuffer, m_meshletCullingPipelineLayout, VK_SHADER_STAGE_ALL, 0,
+			sizeof(MeshletCullingPushConstants), &lv_pushConstants);
+
+		vkCmdDispatch(l_commandBuffer, m_totalNumInstances, 1, 1);
+
+		//The host reads the draw count back for the statistics once the frame has retired
+		const VkMemoryBarrier lv_drawBarrier{ .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER, .pNext = nullptr,
+			.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_HOST_READ_BIT };
+		vkCmdPipelineBarrier(l_commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &lv_drawBarrier, 0, nullptr, 0, nullptr);
+	}
+
 	void IndirectRenderer::UpdateInstanceBuffer(uint32_t l_currentSwapchainIndex)
 	{
 		auto& lv_instanceBuffer = m_vulkanRenderContext.GetResourceManager()
@@ -354,97 +500,111 @@ namespace RenderCore
 	}
 
 
-	void IndirectRenderer::UpdateLocalDeviceBuffers(VkCommandBuffer l_cmdBuffer,
-		const uint32_t l_bufferHandle, const void* l_dstBufferData)
+	void IndirectRenderer::UpdateLocalDeviceBuffers(const BufferHandle l_bufferHandle, const void* l_dstBufferData)
+	{
+		m_vulkanRenderContext.GetResourceManager().CopyDataToLocalBuffer(l_bufferHandle, l_dstBufferData);
+	}
+
+	void IndirectRenderer::UpdateGeometryBuffers()
 	{
 		using namespace ErrorCheck;
-		auto& lv_contextCreator = m_vulkanRenderContext.GetContextCreator();
-		auto& lv_vulkanResourceManager = m_vulkanRenderContext.GetResourceManager();
 
-		
-		auto& lv_buffer = lv_vulkanResourceManager.RetrieveGpuBuffer(l_bufferHandle);
+		auto& lv_geometryHeap = m_vulkanRenderContext.GetResourceManager().GetGeometryHeap();
 
-		auto& lv_stagingBuffer = lv_vulkanResourceManager.CreateBuffer(lv_buffer.size,
-			VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 
-			VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
-			, " Staging-Buffer-Indirect ");
+		m_meshGeometryHandles.resize(m_meshes.size());
 
-		
-		memcpy(lv_stagingBuffer.ptr, l_dstBufferData, lv_buffer.size);
-		
+		for (size_t i = 0; i < m_meshes.size(); ++i) {
+
+			const auto& lv_mesh = m_meshes[i];
 
-		VkBufferCopy lv_bufferCopy = {};
-		lv_bufferCopy.size = lv_buffer.size;
+			//Every LOD of the file has its own index range in the heap, indices are local to the mesh
+			std::array<std::span<const uint8_t>, MeshConverter::lv_maxLODCount> lv_lodIndices{};
 
-		VkCommandBufferBeginInfo lv_commandBufferBegin = {};
-		lv_commandBufferBegin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-		lv_commandBufferBegin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			for (uint32_t j = 0; j < lv_mesh.m_lodCount; ++j) {
+				lv_lodIndices[j] = std::span<const uint8_t>{ (const uint8_t*)m_indexBuffers.data() + lv_mesh.m_lodOffsets[j],
+					lv_mesh.CalculateLODSize(j) };
+			}
 
-		VULKAN_CHECK(vkBeginCommandBuffer(l_cmdBuffer, &lv_commandBufferBegin));
+			const uint8_t* lv_vertices = m_vertexBuffers.data() + lv_mesh.m_streamOffsets[0];
+			const std::span<const std::span<const uint8_t>> lv_meshLods{ lv_lodIndices.data(), lv_mesh.m_lodCount };
 
-		vkCmdCopyBuffer(l_cmdBuffer, lv_stagingBuffer.buffer,
-			lv_buffer.buffer,
-			1, &lv_bufferCopy);
+			m_meshGeometryHandles[i] = lv_geometryHeap.AddMesh(lv_vertices, lv_mesh.m_vertexCount, m_vertexStrideInBytes, lv_meshLods,
+				lv_mesh.m_indexSizeInBytes);
 
-		vkEndCommandBuffer(l_cmdBuffer);
+			if (false == m_meshGeometryHandles[i].IsValid()) {
+				lv_geometryHeap.Compact();
+				m_meshGeometryHandles[i] = lv_geometryHeap.AddMesh(lv_vertices, lv_mesh.m_vertexCount, m_vertexStrideInBytes, lv_meshLods,
+					lv_mesh.m_indexSizeInBytes);
+			}
 
-		VkSubmitInfo lv_submitInfo = {};
-		lv_submitInfo.commandBufferCount = 1;
-		lv_submitInfo.pCommandBuffers = &l_cmdBuffer;
-		lv_submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			if (false == m_meshGeometryHandles[i].IsValid()) {
+				PRINT_EXIT("\nGeometry heap is too small for the scene, increase its size.\n");
+			}
+		}
 
-		VULKAN_CHECK(vkQueueSubmit(lv_contextCreator.m_vkDev.m_mainQueue1, 1, &lv_submitInfo, nullptr));
+		//The staging ring took its own copy, the heap is the only place the geometry lives in from now on
+		m_vertexBuffers = std::vector<uint8_t>{};
+		m_indexBuffers = std::vector<uint32_t>{};
 
-		vkQueueWaitIdle(lv_contextCreator.m_vkDev.m_mainQueue1);
+		UpdateInstanceGeometryOffsets();
 	}
 
-	void IndirectRenderer::UpdateGeometryBuffers(VkCommandBuffer l_cmdBuffer)
+
+	void IndirectRenderer::UpdateInstanceGeometryOffsets()
 	{
-		using namespace ErrorCheck;
-		auto& lv_contextCreator = m_vulkanRenderContext.GetContextCreator();
-		auto& lv_vulkanResourceManager = m_vulkanRenderContext.GetResourceManager();
-		
+		auto& lv_geometryHeap = m_vulkanRenderContext.GetResourceManager().GetGeometryHeap();
 
-		auto& lv_stagingBuffer = lv_vulkanResourceManager.CreateBuffer(m_vertexBufferSize + m_indexBufferSize,
-			VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT 
-			| VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
-		, " Staging-Buffer-Indirect ");
+		for (auto& l_instanceData : m_outputInstanceData) {
 
+			const auto& lv_heapMesh = lv_geometryHeap.GetMesh(m_meshGeometryHandles[l_instanceData.m_meshIndex]);
 
-		memcpy(lv_stagingBuffer.ptr, m_vertexBuffers.data(), m_vertexBufferSize);
-		vkUnmapMemory(lv_contextCreator.m_vkDev.m_device, lv_stagingBuffer.memory);
-		
+			l_instanceData.m_vertexBufferIndex = lv_heapMesh.m_vertexOffset;
+			l_instanceData.m_indexBufferIndex = lv_heapMesh.m_lodIndexOffsets[l_instanceData.m_lod];
+			l_instanceData.m_indexSizeInBytes = lv_heapMesh.m_indexSizeInBytes;
+		}
 
+		m_geometryLayoutVersion = lv_geometryHeap.GetLayoutVersion();
+	}
 
-		uploadBufferData(lv_contextCreator.m_vkDev, lv_stagingBuffer.memory,
-			m_vertexBufferSize, m_indexBuffers.data(), m_indexBufferSize);
+	void IndirectRenderer::UpdateInstanceLods(const glm::vec3& l_cameraPosition, const glm::mat4& l_projectionMatrix)
+	{
+		auto& lv_vulkanResourceManager = m_vulkanRenderContext.GetResourceManager();
+		auto& lv_geometryHeap = lv_vulkanResourceManager.GetGeometryHeap();
 
+		//An error of one unit at a distance of one unit covers this many pixels of the G-buffer the instances are drawn into
+		const float lv_gbufferHeight = (float)lv_vulkanResourceManager.RetrieveGpuTexture(m_attachmentHandles[1]).height;
+		const float lv_pixelsPerUnit = 0.5f * lv_gbufferHeight * std::abs(l_projectionMatrix[1][1]);
 
-		auto& lv_vertexBuffer = m_vulkanRenderContext.GetResourceManager().RetrieveGpuBuffer(m_vertexDataBufferHandle);
+		//Coarser LODs are only taken well below the threshold, so an instance near the switch distance does not flicker
+		const float lv_coarsenThreshold = 0.75f * m_lodPixelThreshold;
 
-		VkBufferCopy lv_bufferCopy = {};
-		lv_bufferCopy.size = m_vertexBufferSize + m_indexBufferSize;
+		for (auto& l_instanceData : m_outputInstanceData) {
 
-		VkCommandBufferBeginInfo lv_commandBufferBegin = {};
-		lv_commandBufferBegin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-		lv_commandBufferBegin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			const auto& lv_mesh = m_meshes[l_instanceData.m_meshIndex];
 
-		VULKAN_CHECK(vkBeginCommandBuffer(l_cmdBuffer, &lv_commandBufferBegin));
+			//The shaders draw the vertices as they are stored, so the sphere is used without the node transform
+			const glm::vec3 lv_center{ lv_mesh.m_boundingSphere[0], lv_mesh.m_boundingSphere[1], lv_mesh.m_boundingSphere[2] };
+			const float lv_distance = std::max(glm::length(lv_center - l_cameraPosition) - lv_mesh.m_boundingSphere[3], 0.1f);
 
-		vkCmdCopyBuffer(l_cmdBuffer, lv_stagingBuffer.buffer,
-			lv_vertexBuffer.buffer,
-			1, &lv_bufferCopy);
+			auto lv_projectedError = [&](uint32_t l_lod) { return lv_mesh.m_lodErrors[l_lod] * lv_pixelsPerUnit / lv_distance; };
 
-		vkEndCommandBuffer(l_cmdBuffer);
+			uint32_t lv_lod = std::min(l_instanceData.m_lod, lv_mesh.m_lodCount - 1);
 
-		VkSubmitInfo lv_submitInfo = {};
-		lv_submitInfo.commandBufferCount = 1;
-		lv_submitInfo.pCommandBuffers = &l_cmdBuffer;
-		lv_submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			while (0U < lv_lod && lv_projectedError(lv_lod) > m_lodPixelThreshold) {
+				--lv_lod;
+			}
 
-		VULKAN_CHECK(vkQueueSubmit(lv_contextCreator.m_vkDev.m_mainQueue1, 1, &lv_submitInfo, nullptr));
+			while (lv_lod + 1 < lv_mesh.m_lodCount && 0U < lv_mesh.CalculateLODNumberOfIndices(lv_lod + 1) &&
+				lv_projectedError(lv_lod + 1) <= lv_coarsenThreshold) {
+				++lv_lod;
+			}
 
-		vkQueueWaitIdle(lv_contextCreator.m_vkDev.m_mainQueue1);
+			if (lv_lod != l_instanceData.m_lod) {
+				l_instanceData.m_lod = lv_lod;
+				l_instanceData.m_indexBufferIndex = lv_geometryHeap.GetMesh(m_meshGeometryHandles[l_instanceData.m_meshIndex])
+					.m_lodIndexOffsets[lv_lod];
+			}
+		}
 	}
 
 	void IndirectRenderer::UpdateIndirectBuffer(uint32_t l_currentSwapchainIndex)
@@ -453,6 +613,7 @@ namespace RenderCore
 		VkDrawIndirectCommand* lv_drawStructure = (VkDrawIndirectCommand*)lv_indirectBuffer.ptr;
 
 		m_totalNumVisibleMeshes = 0;
+		m_lodStatistics = {};
 
 		for (uint32_t i = 0; i < m_outputInstanceData.size(); ++i) {
 			auto j = m_outputInstanceData[i].m_meshIndex;
@@ -464,6 +625,10 @@ namespace RenderCore
 				m_cameraFrustum.m_debugViewFrustumCorners, m_boundingBoxes[j])) ? 1 : 0;
 
 			m_totalNumVisibleMeshes += lv_drawStructure[i].instanceCount;
+
+			auto& lv_lodStatistics = m_lodStatistics[m_outputInstanceData[i].m_lod];
+			lv_lodStatistics.m_totalNumInstances += lv_drawStructure[i].instanceCount;
+			lv_lodStatistics.m_totalNumTriangles += lv_drawStructure[i].instanceCount * lv_drawStructure[i].vertexCount / 3;
 		}
 
 	}
@@ -471,6 +636,16 @@ namespace RenderCore
 
 
 	uint32_t IndirectRenderer::GetTotalNumVisibleMeshes() const { return m_totalNumVisibleMeshes; }
+	uint32_t IndirectRenderer::GetTotalNumVisibleMeshlets() const { return m_totalNumVisibleMeshlets; }
+
+	void IndirectRenderer::SetMeshletCullingOnCpu(bool l_cullOnCpu) { m_cullMeshletsOnCpu = l_cullOnCpu; }
+	void IndirectRenderer::SetMeshletConeCulling(bool l_coneCulling) { m_meshletConeCulling = l_coneCulling; }
+	void IndirectRenderer::SetLodPixelThreshold(float l_lodPixelThreshold) { m_lodPixelThreshold = l_lodPixelThreshold; }
+
+	const std::array<IndirectRenderer::LodStatistics, MeshConverter::lv_maxLODCount>& IndirectRenderer::GetLodStatistics() const
+	{
+		return m_lodStatistics;
+	}
 
 
 	const std::vector<InstanceData>& IndirectRenderer::GetInstanceData() const
@@ -482,6 +657,11 @@ namespace RenderCore
 		return m_meshes;
 	}
 
+	const SpecializationConstants& IndirectRenderer::GetVertexFormatConstants() const
+	{
+		return m_vertexFormatConstants;
+	}
+
 
 
 	void IndirectRenderer::FillCommandBuffer(
@@ -491,7 +671,8 @@ namespace RenderCore
 
 		auto& lv_vulkanResourceManager = m_vulkanRenderContext.GetResourceManager();
 		auto lv_framebuffer = lv_vulkanResourceManager.RetrieveGpuFramebuffer(m_framebufferHandles[l_currentSwapchainIndex]);
-		auto& lv_indirectBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(m_indirectBufferHandles[l_currentSwapchainIndex]);
+		auto& lv_meshletDrawBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(m_meshletDrawBufferHandles[l_currentSwapchainIndex]);
+		auto& lv_meshletDrawCountBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(m_meshletDrawCountBufferHandles[l_currentSwapchainIndex]);
 
 
 		uint32_t lv_totalNumAttachmentsPerFrameBuffer = 7;
@@ -512,12 +693,12 @@ namespace RenderCore
 			.RetrieveGpuTexture(m_attachmentHandles[lv_totalNumAttachmentsPerFrameBuffer * l_currentSwapchainIndex + 6]);
 
 
-		std::vector<VulkanTexture*> lv_colorOptimLayouts{&lv_tangentAttach, & lv_posColorAttach, & lv_normalColorAttach
+		const std::array<VulkanTexture*, 6> lv_colorOptimLayouts{&lv_tangentAttach, & lv_posColorAttach, & lv_normalColorAttach
 			, & lv_albedoSpecColorAttach, & lv_normalVertexColorAttach, & lv_metallicColorAttach };
-		std::vector<VulkanTexture*> lv_depthOptimLayouts{ &lv_depthAttach };
+		VulkanTexture* lv_depthOptimLayouts = &lv_depthAttach;
 
-		TransitionImageLayoutsCmd(l_commandBuffer, lv_colorOptimLayouts, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-		TransitionImageLayoutsCmd(l_commandBuffer, lv_depthOptimLayouts, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+		TransitionImageLayoutsCmd(l_commandBuffer, lv_colorOptimLayouts.data(), (uint32_t)lv_colorOptimLayouts.size(), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+		TransitionImageLayoutsCmd(l_commandBuffer, &lv_depthOptimLayouts, 1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
 		/*transitionImageLayoutCmd(l_commandBuffer, lv_tangentAttach.image.image, lv_tangentAttach.format,
 			lv_tangentAttach.Layout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
 		transitionImageLayoutCmd(l_commandBuffer, lv_posColorAttach.image.image, lv_posColorAttach.format,
@@ -540,11 +721,18 @@ namespace RenderCore
 		lv_normalVertexColorAttach.Layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 		lv_metallicColorAttach.Layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 		lv_depthAttach.Layout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;*/
+
+		if (false == m_cullMeshletsOnCpu) {
+			RecordMeshletCulling(l_commandBuffer, l_currentSwapchainIndex);
+		}
 		
 
-		BeginRenderPass(m_renderPass, lv_framebuffer, l_commandBuffer, l_currentSwapchainIndex, m_attachmentHandles.size(), 1024, 1024);
-		vkCmdDrawIndirect(l_commandBuffer, lv_indirectBuffer.buffer, 0, m_totalNumInstances,
-			sizeof(VkDrawIndirectCommand));
+		BeginRenderPass(m_renderPass, lv_framebuffer, l_commandBuffer, l_currentSwapchainIndex, lv_totalNumAttachmentsPerFrameBuffer, 1024, 1024);
+		lv_vulkanResourceManager.GetBindlessHeap().Bind(l_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 1);
+		vkCmdPushConstants(l_commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_ALL, 0, sizeof(uint32_t), &m_sceneSamplerIndex);
+		//One draw per surviving meshlet, firstVertex is the start of its index run inside the LOD of the instance
+		vkCmdDrawIndirectCount(l_commandBuffer, lv_meshletDrawBuffer.buffer, 0, lv_meshletDrawCountBuffer.buffer, 0,
+			m_maxNumMeshletDraws, sizeof(VkDrawIndirectCommand));
 		vkCmdEndRenderPass(l_commandBuffer);
 
 		lv_tangentAttach.Layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
@@ -696,162 +884,33 @@ namespace RenderCore
 	
 	void IndirectRenderer::UpdateDescriptorSets()
 	{
-		using namespace ErrorCheck;
-		auto lv_totalNumSwapchains = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
 		auto& lv_vulkanResourceManager = m_vulkanRenderContext.GetResourceManager();
+		auto& lv_geometryHeap = lv_vulkanResourceManager.GetGeometryHeap();
 
-		std::vector<VkDescriptorBufferInfo> lv_bufferInfos{};
-		lv_bufferInfos.resize(lv_totalNumSwapchains * 6);
-
-		std::vector<VkDescriptorImageInfo> lv_imageInfos{};
-		lv_imageInfos.reserve(256);
-
-		std::vector<VkWriteDescriptorSet> lv_writes{};
-		lv_writes.reserve(lv_imageInfos.size() + lv_bufferInfos.size());
-
-		for (uint32_t j = 0; j < (uint32_t)m_textureHandlesOfScene.size(); ++j) {
-			auto& lv_sceneTexture = lv_vulkanResourceManager.RetrieveGpuTexture(m_textureHandlesOfScene[j]);
-
-			lv_imageInfos.push_back(VkDescriptorImageInfo{
-				.sampler = lv_sceneTexture.sampler,
-				.imageView = lv_sceneTexture.image.imageView0,
-				.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
-		}
-
-		auto& lv_vertexBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(m_vertexDataBufferHandle);
-		lv_bufferInfos[0].buffer = lv_vertexBuffer.buffer;
-		lv_bufferInfos[0].offset = 0;
-		lv_bufferInfos[0].range = m_vertexBufferSize;
-
-		auto& lv_indexBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(m_indicesDataBufferHandle);
-		lv_bufferInfos[1].buffer = lv_indexBuffer.buffer;
-		lv_bufferInfos[1].offset = m_vertexBufferSize;
-		lv_bufferInfos[1].range = m_indexBufferSize;
-
+		auto& lv_vertexBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(lv_geometryHeap.GetVertexBufferHandle());
+		auto& lv_indexBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(lv_geometryHeap.GetIndexBufferHandle());
 		auto& lv_materialBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(m_materialBufferHandle);
-		lv_bufferInfos[2].buffer = lv_materialBuffer.buffer;
-		lv_bufferInfos[2].offset = 0;
-		lv_bufferInfos[2].range = lv_materialBuffer.size;
-		
 
-		for (uint32_t i = 0; i < lv_totalNumSwapchains; ++i) {
-
-
-			lv_writes.push_back(VkWriteDescriptorSet{
-				.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-				.pNext = nullptr,
-				.dstSet = m_descriptorSets[i],
-				.dstBinding = 1,
-				.dstArrayElement = 0,
-				.descriptorCount = 1,
-				.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-				.pImageInfo = nullptr,
-				.pBufferInfo = &lv_bufferInfos[0],
-				.pTexelBufferView = nullptr });
-
-
-			
-
-			lv_writes.push_back(VkWriteDescriptorSet{
-				.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-				.pNext = nullptr,
-				.dstSet = m_descriptorSets[i],
-				.dstBinding = 2,
-				.dstArrayElement = 0,
-				.descriptorCount = 1,
-				.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-				.pImageInfo = nullptr,
-				.pBufferInfo = &lv_bufferInfos[1],
-				.pTexelBufferView = nullptr });
-
-			
-
-			lv_writes.push_back(VkWriteDescriptorSet{
-				.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-				.pNext = nullptr,
-				.dstSet = m_descriptorSets[i],
-				.dstBinding = 5,
-				.dstArrayElement = 0,
-				.descriptorCount = 1,
-				.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-				.pImageInfo = nullptr,
-				.pBufferInfo = &lv_bufferInfos[2],
-				.pTexelBufferView = nullptr });
-
-
-			
-
-			lv_writes.push_back(VkWriteDescriptorSet{
-				.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-				.pNext = nullptr,
-				.dstSet = m_descriptorSets[i],
-				.dstBinding = 6,
-				.dstArrayElement = 0,
-				.descriptorCount = (uint32_t)lv_imageInfos.size(),
-				.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-				.pImageInfo = lv_imageInfos.data(),
-				.pBufferInfo = nullptr,
-				.pTexelBufferView = nullptr });
-
-
-			auto& lv_uniformBuffer = (m_uniformBuffers)[i];
-			lv_bufferInfos[3 * i + 3].buffer = lv_uniformBuffer.buffer;
-			lv_bufferInfos[3 * i + 3].offset = 0;
-			lv_bufferInfos[3 * i + 3].range = lv_uniformBuffer.size;
-
-
-			lv_writes.push_back(VkWriteDescriptorSet{
-			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-			.pNext = nullptr,
-			.dstSet = m_descriptorSets[i],
-			.dstBinding = 0,
-			.dstArrayElement = 0,
-			.descriptorCount = 1,
-			.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-			.pImageInfo = nullptr,
-			.pBufferInfo = &lv_bufferInfos[3 * i + 3],
-			.pTexelBufferView = nullptr });
+		const VkDescriptorBufferInfo lv_uniformBufferInfo = lv_vulkanResourceManager.GetUniformArena()
+			.GetDescriptorBufferInfo(sizeof(IndirectUniformBuffer));
+		const VkDescriptorBufferInfo lv_vertexBufferInfo{ lv_vertexBuffer.buffer, 0, lv_vertexBuffer.size };
+		const VkDescriptorBufferInfo lv_indexBufferInfo{ lv_indexBuffer.buffer, 0, lv_indexBuffer.size };
+		const VkDescriptorBufferInfo lv_materialBufferInfo{ lv_materialBuffer.buffer, 0, lv_materialBuffer.size };
 
+		for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
 
 			auto& lv_drawDataBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(m_instanceBuffersGpu[i]);
-			lv_bufferInfos[3 * i + 4].buffer = lv_drawDataBuffer.buffer;
-			lv_bufferInfos[3 * i + 4].offset = 0;
-			lv_bufferInfos[3 * i + 4].range = lv_drawDataBuffer.size;
-
-			lv_writes.push_back(VkWriteDescriptorSet{
-			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-			.pNext = nullptr,
-			.dstSet = m_descriptorSets[i],
-			.dstBinding = 3,
-			.dstArrayElement = 0,
-			.descriptorCount = 1,
-			.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-			.pImageInfo = nullptr,
-			.pBufferInfo = &lv_bufferInfos[3 * i + 4],
-			.pTexelBufferView = nullptr });
-
 			auto& lv_transformationBuffer = lv_vulkanResourceManager.RetrieveGpuBuffer(m_transformationsBufferHandles[i]);
-			lv_bufferInfos[3 * i + 5].buffer = lv_transformationBuffer.buffer;
-			lv_bufferInfos[3 * i + 5].offset = 0;
-			lv_bufferInfos[3 * i + 5].range = lv_transformationBuffer.size;
-
-			lv_writes.push_back(VkWriteDescriptorSet{
-			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-			.pNext = nullptr,
-			.dstSet = m_descriptorSets[i],
-			.dstBinding = 4,
-			.dstArrayElement = 0,
-			.descriptorCount = 1,
-			.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-			.pImageInfo = nullptr,
-			.pBufferInfo = &lv_bufferInfos[3 * i + 5],
-			.pTexelBufferView = nullptr });
 
+			WriteBufferDescriptor(i, 0, lv_uniformBufferInfo);
+			WriteBufferDescriptor(i, 1, lv_vertexBufferInfo);
+			WriteBufferDescriptor(i, 2, lv_indexBufferInfo);
+			WriteBufferDescriptor(i, 3, { lv_drawDataBuffer.buffer, 0, lv_drawDataBuffer.size });
+			WriteBufferDescriptor(i, 4, { lv_transformationBuffer.buffer, 0, lv_transformationBuffer.size });
+			WriteBufferDescriptor(i, 5, lv_materialBufferInfo);
 		}
-		
-		vkUpdateDescriptorSets(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device,
-			lv_writes.size(), lv_writes.data(), 0, nullptr);
 
+		FlushDescriptorWrites();
 	}
 
 	void IndirectRenderer::LoadInstanceData(const char* l_instanceFile)
@@ -885,12 +944,6 @@ namespace RenderCore
 
 
 
-	uint32_t IndirectRenderer::GetVertexBufferSize()
-	{
-		return m_vertexBufferSize;
-	}
-
-
 	MeshConverter::MeshFileHeader IndirectRenderer::LoadMeshData(const char* l_meshFileHeader)
 	{
 		using namespace MeshConverter;
@@ -911,7 +964,12 @@ namespace RenderCore
 			exit(EXIT_FAILURE);
 		}
 
-		m_vertexBuffers.resize(lv_meshFileHeaderInstance.m_vertexDataSize / sizeof(float));
+		if (lv_meshFileMagicValue != lv_meshFileHeaderInstance.m_magicValue) {
+			printf("Mesh header file is corrupted or was written by an older converter, convert the scene again.\n");
+			exit(EXIT_FAILURE);
+		}
+
+		m_vertexBuffers.resize(lv_meshFileHeaderInstance.m_vertexDataSize);
 		m_indexBuffers.resize(lv_meshFileHeaderInstance.m_lodDataSize/sizeof(unsigned int));
 		m_meshes.resize(lv_meshFileHeaderInstance.m_meshCount);
 
@@ -921,6 +979,14 @@ namespace RenderCore
 			exit(EXIT_FAILURE);
 		}
 
+		if (MeshDataCompression::m_meshoptCodecs == lv_meshFileHeaderInstance.m_compression) {
+			LoadCompressedMeshData(lv_meshFileHeader, lv_meshFileHeaderInstance);
+			LoadMeshletData(lv_meshFileHeader, lv_meshFileHeaderInstance);
+			fclose(lv_meshFileHeader);
+
+			return lv_meshFileHeaderInstance;
+		}
+
 		if (lv_meshFileHeaderInstance.m_vertexDataSize !=
 			fread(m_vertexBuffers.data(), 1, lv_meshFileHeaderInstance.m_vertexDataSize, lv_meshFileHeader)) {
 			printf("Failed to read vertex buffer datas from mesh file header.\n");
@@ -933,6 +999,7 @@ namespace RenderCore
 			exit(EXIT_FAILURE);
 		}
 
+		LoadMeshletData(lv_meshFileHeader, lv_meshFileHeaderInstance);
 
 		fclose(lv_meshFileHeader);
 
@@ -940,6 +1007,49 @@ namespace RenderCore
 	}
 
 
+	void IndirectRenderer::LoadCompressedMeshData(FILE* l_meshFile, const MeshConverter::MeshFileHeader& l_meshFileHeader)
+	{
+		using namespace MeshConverter;
+
+		std::vector<CompressedStream> lv_streams(m_meshes.size() * lv_compressedStreamsPerMesh);
+		const size_t lv_streamTableSize = lv_streams.size() * sizeof(CompressedStream);
+
+		if (lv_streamTableSize > l_meshFileHeader.m_compressedDataSize ||
+			lv_streamTableSize != fread(lv_streams.data(), 1, lv_streamTableSize, l_meshFile)) {
+			printf("Failed to read the compressed stream table from mesh file header.\n");
+			exit(EXIT_FAILURE);
+		}
+
+		std::vector<uint8_t> lv_compressedData(l_meshFileHeader.m_compressedDataSize - lv_streamTableSize);
+
+		if (lv_compressedData.size() != fread(lv_compressedData.data(), 1, lv_compressedData.size(), l_meshFile)) {
+			printf("Failed to read compressed mesh data from mesh file header.\n");
+			exit(EXIT_FAILURE);
+		}
+
+		MeshDecodeStats lv_decodeStats{};
+
+		if (false == DecodeMeshData(m_meshes, l_meshFileHeader.m_vertexStrideInBytes, lv_streams, lv_compressedData,
+			m_vertexBuffers, m_indexBuffers, 0U, lv_decodeStats)) {
+			printf("Compressed mesh data of the mesh file header is corrupted.\n");
+			exit(EXIT_FAILURE);
+		}
+
+		PrintDecodeStats(lv_decodeStats);
+	}
+
+
+	void IndirectRenderer::LoadMeshletData(FILE* l_meshFile, const MeshConverter::MeshFileHeader& l_meshFileHeader)
+	{
+		m_meshlets.resize(l_meshFileHeader.m_meshletCount);
+
+		if (m_meshlets.size() != fread(m_meshlets.data(), sizeof(MeshConverter::Meshlet), m_meshlets.size(), l_meshFile)) {
+			printf("Failed to read meshlets from mesh file header.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+
 	MeshConverter::GeometryConverter::BoundingBox IndirectRenderer::LoadBoundingBoxData(const char* l_boundingBoxFile)
 	{
 		FILE* lv_boundingBoxFile = fopen(l_boundingBoxFile, "rb");
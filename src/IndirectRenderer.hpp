@@ -6,6 +6,9 @@
 #include "Renderbase.hpp"
 #include "Mesh.hpp"
 #include "MeshFileHeader.hpp"
+#include "SpecializationConstants.hpp"
+#include "MeshletCulling.hpp"
+#include <array>
 #include <vector>
 #include <glm/glm.hpp>
 #include "GeometryConverter.hpp"
@@ -45,6 +48,19 @@ namespace RenderCore
 
 		};
 
+		//Buffer handle indices of MeshletCulling.comp, which reads and writes everything through the bindless heap
+		struct MeshletCullingPushConstants
+		{
+			uint32_t m_meshletBuffer;
+			uint32_t m_meshletRangeBuffer;
+			uint32_t m_instanceBuffer;
+			uint32_t m_instanceDrawBuffer;
+			uint32_t m_viewBuffer;
+			uint32_t m_drawBuffer;
+			uint32_t m_drawCountBuffer;
+			uint32_t m_maxNumDraws;
+		};
+
 		struct CameraViewFrustum
 		{
 			std::array<glm::vec3, 8> m_debugViewFrustumCorners;
@@ -81,22 +97,51 @@ namespace RenderCore
 			VkCommandBuffer l_commandBuffer,
 			uint32_t l_currentSwapchainIndex) override;
 
-		uint32_t GetVertexBufferSize();
-
 		const std::vector<InstanceData>& GetInstanceData() const;
 		const std::vector<MeshConverter::Mesh>& GetMeshData() const;
 
+		//Vertex layout of the mesh file for the vertex pulling shaders, every pipeline reading the heap needs them
+		const SpecializationConstants& GetVertexFormatConstants() const;
+
 
 		uint32_t GetTotalNumVisibleMeshes() const;
 
+		//Meshlet draws of the last frame that used the current swapchain image
+		uint32_t GetTotalNumVisibleMeshlets() const;
+
+		//The CPU path runs CullMeshlets() instead of the compute pass, for checking the culling without a GPU in the loop
+		void SetMeshletCullingOnCpu(bool l_cullOnCpu);
+
+		//The raster pipeline does not cull back faces, so double sided materials can lose meshlets seen from behind
+		void SetMeshletConeCulling(bool l_coneCulling);
+
+		//Largest error in pixels of the G-buffer a LOD may show before a finer one is picked
+		void SetLodPixelThreshold(float l_lodPixelThreshold);
+
+		//Visible instances and their triangles per LOD of the last UpdateBuffers()
+		struct LodStatistics
+		{
+			uint32_t m_totalNumInstances{ 0 };
+			uint32_t m_totalNumTriangles{ 0 };
+		};
+
+		const std::array<LodStatistics, MeshConverter::lv_maxLODCount>& GetLodStatistics() const;
+
 	protected:
 
-		void UpdateGeometryBuffers(VkCommandBuffer l_cmdBuffer);
+		//Adds every mesh of the file to the geometry heap of the resource manager
+		void UpdateGeometryBuffers();
+
+		//Instance data points into the geometry heap, the offsets have to be re-read after the heap was compacted
+		void UpdateInstanceGeometryOffsets();
+
+		//Picks the LOD of every instance from the projected error of its mesh LODs, with hysteresis against popping
+		void UpdateInstanceLods(const glm::vec3& l_cameraPosition, const glm::mat4& l_projectionMatrix);
 		void UpdateIndirectBuffer(uint32_t l_currentSwapchainIndex);
 		void UpdateInstanceBuffer(uint32_t l_currentSwapchainIndex);
 		void UpdateTransformationsBuffer(uint32_t l_currentSwapchainIndex);
-		void UpdateLocalDeviceBuffers(VkCommandBuffer l_cmdBuffer, 
-			const uint32_t l_bufferHandle, const void* l_bufferDataToTransfer);
+		void UpdateMeshletCullingBuffers(uint32_t l_currentSwapchainIndex);
+		void UpdateLocalDeviceBuffers(const BufferHandle l_bufferHandle, const void* l_bufferDataToTransfer);
 		/*void UpdateLocalDeviceTextures(VkCommandBuffer l_cmdBuffer,
 			const std::vector<VulkanTexture>& l_texturesToTransfer);*/
 
@@ -110,8 +155,16 @@ namespace RenderCore
 
 		void LoadInstanceData(const char* l_instanceFile);
 		MeshConverter::MeshFileHeader LoadMeshData(const char* l_meshFileHeader);
+		//Decodes the meshoptimizer streams that follow the meshes into m_vertexBuffers and m_indexBuffers on all cores
+		void LoadCompressedMeshData(FILE* l_meshFile, const MeshConverter::MeshFileHeader& l_meshFileHeader);
+		void LoadMeshletData(FILE* l_meshFile, const MeshConverter::MeshFileHeader& l_meshFileHeader);
 		MeshConverter::GeometryConverter::BoundingBox LoadBoundingBoxData(const char* l_boundingBoxFile);
 
+		void CreateMeshletCullingResources();
+
+		//Clears the draw count, culls the meshlets of every visible instance and makes the draws visible to the indirect stage
+		void RecordMeshletCulling(VkCommandBuffer l_commandBuffer, uint32_t l_currentSwapchainIndex);
+
 
 
 	private:
@@ -126,30 +179,56 @@ namespace RenderCore
 		std::vector<InstanceData> m_outputInstanceData{};
 		std::vector<MeshConverter::Mesh> m_meshes{};
 		std::vector<uint32_t> m_indexBuffers{};
-		std::vector<float> m_vertexBuffers{};
+		std::vector<uint8_t> m_vertexBuffers{};
+		uint32_t m_vertexStrideInBytes{ 0 };
+		SpecializationConstants m_vertexFormatConstants{};
 		std::vector<MeshConverter::GeometryConverter::BoundingBox> m_boundingBoxes;
 
-		uint32_t m_vertexBufferSize;
-		uint32_t m_indexBufferSize;
 		uint32_t m_totalNumInstances;
 		uint32_t m_instanceBufferSize;
 		uint32_t m_materialBufferSize;
 
 
-		uint32_t m_vertexDataBufferHandle{};
-		uint32_t m_indicesDataBufferHandle{};
-		uint32_t m_materialBufferHandle{};
-		std::vector<uint32_t> m_arrayTexturesHandles{};
+		std::vector<GeometryHandle> m_meshGeometryHandles{};
+		uint32_t m_geometryLayoutVersion{ 0 };
+
+		BufferHandle m_materialBufferHandle{};
+		std::vector<TextureHandle> m_arrayTexturesHandles{};
 
-		std::vector<uint32_t> m_transformationsBufferHandles{};
-		std::vector<uint32_t> m_instanceBuffersGpu{};
-		std::vector<uint32_t> m_indirectBufferHandles{};
+		std::vector<BufferHandle> m_transformationsBufferHandles{};
+		std::vector<BufferHandle> m_instanceBuffersGpu{};
+		std::vector<BufferHandle> m_indirectBufferHandles{};
 
 
 		CameraViewFrustum m_cameraFrustum;
 		uint32_t m_totalNumVisibleMeshes{ 0 };
 
-		std::vector<uint32_t> m_attachmentHandles;
-		std::vector<uint32_t> m_textureHandlesOfScene;
+		std::vector<MeshConverter::Meshlet> m_meshlets{};
+		std::vector<MeshletRange> m_meshletRanges{};
+		BufferHandle m_meshletBufferHandle{};
+		BufferHandle m_meshletRangeBufferHandle{};
+
+		std::vector<BufferHandle> m_meshletCullingViewBufferHandles{};
+		std::vector<BufferHandle> m_meshletDrawBufferHandles{};
+		std::vector<BufferHandle> m_meshletDrawCountBufferHandles{};
+
+		//Enough for the largest LOD of every instance
+		uint32_t m_maxNumMeshletDraws{ 0 };
+		uint32_t m_totalNumVisibleMeshlets{ 0 };
+		bool m_cullMeshletsOnCpu{ false };
+		bool m_meshletConeCulling{ true };
+		MeshletCullingView m_meshletCullingView{};
+
+		float m_lodPixelThreshold{ 1.f };
+		std::array<LodStatistics, MeshConverter::lv_maxLODCount> m_lodStatistics{};
+
+		VkPipelineLayout m_meshletCullingPipelineLayout{ VK_NULL_HANDLE };
+		VkPipeline m_meshletCullingPipeline{ VK_NULL_HANDLE };
+
+		std::vector<TextureHandle> m_attachmentHandles;
+		std::vector<TextureHandle> m_textureHandlesOfScene;
+
+		//Index of the scene texture sampler in the immutable sampler table of the bindless heap, pushed as a constant
+		uint32_t m_sceneSamplerIndex{ 0 };
 	};
 }
\ No newline at end of file
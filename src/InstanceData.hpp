@@ -13,6 +13,13 @@ namespace RenderCore
 		uint32_t m_indexBufferIndex;
 		uint32_t m_vertexBufferIndex;
 		uint32_t m_transformIndex;
-		
+
+		//Copied from the Mesh, undoes the position quantization of packed vertices
+		float m_positionOffset[3];
+		float m_positionScale[3];
+
+		//Copied from the Mesh, 2 when the index offset and the indices are 16 bit
+		uint32_t m_indexSizeInBytes;
+		uint32_t m_padding[3];
 	};
 }
\ No newline at end of file
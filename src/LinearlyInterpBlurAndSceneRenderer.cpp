@@ -101,8 +101,8 @@ namespace RenderCore
 		lv_pipeInfo.m_useDepth = false;
 		lv_pipeInfo.m_totalNumColorAttach = lv_node->m_outputResourcesHandles.size();
 
-		m_graphicsPipeline = lv_vkResManager.CreateGraphicsPipeline(m_renderPass, m_pipelineLayout
-			, { l_vtxShader, l_fragShader }, "GraphicsPiplineLinInterpBlurScene", lv_pipeInfo);
+		lv_vkResManager.RequestGraphicsPipeline(m_renderPass, m_pipelineLayout
+			, { l_vtxShader, l_fragShader }, "GraphicsPiplineLinInterpBlurScene", lv_pipeInfo, m_graphicsPipeline);
 
 
 
@@ -139,56 +139,16 @@ namespace RenderCore
 
 	void LinearlyInterpBlurAndSceneRenderer::UpdateDescriptorSets()
 	{
+		//m_descriptorImageViews holds the two input views of every swapchain image back to back
+		for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
 
-		auto lv_totalNumSwapchains = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
-
-		std::vector<VkDescriptorImageInfo> lv_imageInfo{};
-		lv_imageInfo.resize(2*lv_totalNumSwapchains);
-
-		for (size_t i = 0, j = 0; i < lv_imageInfo.size(); i+=2, ++j) {
-
-			lv_imageInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfo[i].imageView = m_descriptorImageViews[i];
-			lv_imageInfo[i].sampler = m_mipMapInputImages[j]->sampler;
-
-			lv_imageInfo[i + 1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfo[i + 1].imageView = m_descriptorImageViews[i + 1];
-			lv_imageInfo[i + 1].sampler = m_mipMapInputImages[j]->sampler;
-
+			WriteImageDescriptor(i, 0, { m_mipMapInputImages[i]->sampler, m_descriptorImageViews[2 * i],
+				VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+			WriteImageDescriptor(i, 1, { m_mipMapInputImages[i]->sampler, m_descriptorImageViews[2 * i + 1],
+				VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
 		}
 
-		std::vector<VkWriteDescriptorSet> lv_writes{};
-		lv_writes.resize(2 * lv_totalNumSwapchains);
-
-		for (size_t i = 0, j = 0; i < lv_writes.size(); i += 2, ++j) {
-
-			lv_writes[i].descriptorCount = 1;
-			lv_writes[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i].dstArrayElement = 0;
-			lv_writes[i].dstBinding = 0;
-			lv_writes[i].dstSet = m_descriptorSets[j];
-			lv_writes[i].pBufferInfo = nullptr;
-			lv_writes[i].pImageInfo = &lv_imageInfo[i];
-			lv_writes[i].pNext = nullptr;
-			lv_writes[i].pTexelBufferView = nullptr;
-			lv_writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 1].descriptorCount = 1;
-			lv_writes[i + 1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 1].dstArrayElement = 0;
-			lv_writes[i + 1].dstBinding = 1;
-			lv_writes[i + 1].dstSet = m_descriptorSets[j];
-			lv_writes[i + 1].pBufferInfo = nullptr;
-			lv_writes[i + 1].pImageInfo = &lv_imageInfo[i + 1];
-			lv_writes[i + 1].pNext = nullptr;
-			lv_writes[i + 1].pTexelBufferView = nullptr;
-			lv_writes[i + 1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-		}
-
-
-		vkUpdateDescriptorSets(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device, lv_writes.size(), lv_writes.data(), 0, nullptr);
-
+		FlushDescriptorWrites();
 	}
 
 }
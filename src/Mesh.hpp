@@ -8,6 +8,30 @@ namespace MeshConverter
 	constexpr const uint32_t lv_maxLODCount{ 8 };
 	constexpr const uint32_t lv_maxStreamCount{ 8 };
 
+	//Meshlet limits handed to meshopt_buildMeshlets(), 124 triangles keep the meshlet triangle count a multiple of 4
+	constexpr const uint32_t lv_maxMeshletVertices{ 64 };
+	constexpr const uint32_t lv_maxMeshletTriangles{ 124 };
+
+
+	//A cluster of triangles of one LOD. Its indices are a contiguous run of the index range of that LOD,
+	//the bounds are in the space of the vertex positions (see meshopt_computeMeshletBounds()).
+	struct Meshlet final
+	{
+		float m_center[3]{};
+		float m_radius{};
+
+		//Every triangle faces away from an eye with dot(m_center - eye, m_coneAxis) >= m_coneCutoff * length(m_center - eye) + m_radius,
+		//a cutoff of 1 never culls
+		float m_coneAxis[3]{};
+		float m_coneCutoff{ 1.f };
+
+		//Relative to the first index of the LOD
+		uint32_t m_firstIndex{};
+		uint32_t m_totalNumIndices{};
+
+		uint32_t m_padding[2]{};
+	};
+
 	struct Mesh final
 	{
 
@@ -24,6 +48,23 @@ namespace MeshConverter
 
 		uint32_t m_streamElementSizes[lv_maxStreamCount];
 
+		//Packed positions are decoded as m_positionOffset + m_positionScale * quantized position,
+		//fp32 vertices keep the identity
+		float m_positionOffset[3]{ 0.f, 0.f, 0.f };
+		float m_positionScale[3]{ 1.f, 1.f, 1.f };
+
+		//Meshlets of LOD i are [m_lodMeshletOffsets[i], m_lodMeshletOffsets[i + 1]) of the meshlets of the file
+		uint32_t m_lodMeshletOffsets[lv_maxLODCount]{};
+
+		//Geometric error of every LOD against LOD 0 in the units of the vertex positions, LOD 0 is exact
+		float m_lodErrors[lv_maxLODCount]{};
+
+		//Center and radius of a sphere around the vertex positions
+		float m_boundingSphere[4]{};
+
+		//Meshes with at most 65536 vertices store the indices of every LOD as 16 bit, m_lodOffsets stay in bytes
+		uint32_t m_indexSizeInBytes{ sizeof(uint32_t) };
+
 
 
 		inline uint32_t CalculateLODSize(uint32_t l_lodOffsetIndex) const
@@ -35,7 +76,21 @@ namespace MeshConverter
 		inline uint32_t CalculateLODNumberOfIndices(uint32_t l_lodOffsetIndex) const
 		{
 			assert(l_lodOffsetIndex + 1 < lv_maxLODCount);
-			return (m_lodOffsets[l_lodOffsetIndex + 1] - m_lodOffsets[l_lodOffsetIndex])/sizeof(unsigned int);
+			return (m_lodOffsets[l_lodOffsetIndex + 1] - m_lodOffsets[l_lodOffsetIndex])/m_indexSizeInBytes;
+		}
+
+		//Index l_index of LOD l_lod out of index data laid out like the index block of the mesh file
+		inline uint32_t ReadLODIndex(const void* l_indexData, uint32_t l_lod, uint32_t l_index) const
+		{
+			const uint8_t* lv_lodIndices = (const uint8_t*)l_indexData + m_lodOffsets[l_lod];
+
+			return (sizeof(uint16_t) == m_indexSizeInBytes) ? ((const uint16_t*)lv_lodIndices)[l_index] : ((const uint32_t*)lv_lodIndices)[l_index];
+		}
+
+		inline uint32_t CalculateLODNumberOfMeshlets(uint32_t l_lodOffsetIndex) const
+		{
+			assert(l_lodOffsetIndex + 1 < lv_maxLODCount);
+			return (m_lodMeshletOffsets[l_lodOffsetIndex + 1] - m_lodMeshletOffsets[l_lodOffsetIndex]);
 		}
 	};
 }
\ No newline at end of file
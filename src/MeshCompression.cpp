@@ -0,0 +1,202 @@
+
+
+
+
+#include "MeshCompression.hpp"
+#include "meshoptimizer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+
+namespace MeshConverter
+{
+
+	namespace
+	{
+		uint64_t CalculateDecodedStreamSize(const Mesh& l_mesh, uint32_t l_streamIndex, uint32_t l_vertexStrideInBytes)
+		{
+			if (0U == l_streamIndex) {
+				return (uint64_t)l_mesh.m_vertexCount * l_vertexStrideInBytes;
+			}
+
+			return (l_streamIndex - 1U < l_mesh.m_lodCount) ? l_mesh.CalculateLODSize(l_streamIndex - 1U) : 0U;
+		}
+
+		bool DecodeStream(const Mesh& l_mesh, uint32_t l_streamIndex, uint32_t l_vertexStrideInBytes,
+			const CompressedStream& l_stream, std::span<const uint8_t> l_encodedData,
+			std::span<uint8_t> l_vertexData, std::span<uint32_t> l_indexData)
+		{
+			if (0U == l_stream.m_sizeInBytes) {
+				return 0U == CalculateDecodedStreamSize(l_mesh, l_streamIndex, l_vertexStrideInBytes);
+			}
+
+			if ((uint64_t)l_stream.m_offset + l_stream.m_sizeInBytes > l_encodedData.size()) {
+				return false;
+			}
+
+			const unsigned char* lv_source = l_encodedData.data() + l_stream.m_offset;
+
+			if (0U == l_streamIndex) {
+
+				if (l_mesh.m_streamOffsets[0] + (uint64_t)l_mesh.m_vertexCount * l_vertexStrideInBytes > l_vertexData.size()) {
+					return false;
+				}
+
+				return 0 == meshopt_decodeVertexBuffer(l_vertexData.data() + l_mesh.m_streamOffsets[0], l_mesh.m_vertexCount,
+					l_vertexStrideInBytes, lv_source, l_stream.m_sizeInBytes);
+			}
+
+			const uint32_t lv_lod = l_streamIndex - 1U;
+
+			if (l_mesh.m_lodCount <= lv_lod) {
+				return false;
+			}
+
+			const uint32_t lv_totalNumIndices = l_mesh.CalculateLODNumberOfIndices(lv_lod);
+
+			if ((uint64_t)l_mesh.m_lodOffsets[lv_lod] + l_mesh.CalculateLODSize(lv_lod) > l_indexData.size_bytes()) {
+				return false;
+			}
+
+			return 0 == meshopt_decodeIndexBuffer((uint8_t*)l_indexData.data() + l_mesh.m_lodOffsets[lv_lod], lv_totalNumIndices,
+				l_mesh.m_indexSizeInBytes, lv_source, l_stream.m_sizeInBytes);
+		}
+	}
+
+
+
+	std::vector<uint8_t> EncodeMeshData(std::span<const Mesh> l_meshes, std::span<const uint8_t> l_vertexData,
+		uint32_t l_vertexStrideInBytes, std::span<const uint32_t> l_indexData, std::vector<CompressedStream>& l_streams)
+	{
+		std::vector<uint8_t> lv_encodedData{};
+		std::vector<uint32_t> lv_widenedIndices{};
+		l_streams.assign(l_meshes.size() * lv_compressedStreamsPerMesh, CompressedStream{});
+
+		//Grows the block by the worst case of the codec and trims it back to what was written
+		const auto lv_appendStream = [&lv_encodedData](CompressedStream& l_stream, size_t l_boundInBytes, const auto& l_encode)
+			{
+				l_stream.m_offset = (uint32_t)lv_encodedData.size();
+				lv_encodedData.resize(lv_encodedData.size() + l_boundInBytes);
+
+				const size_t lv_sizeInBytes = l_encode(lv_encodedData.data() + l_stream.m_offset, l_boundInBytes);
+
+				lv_encodedData.resize(l_stream.m_offset + lv_sizeInBytes);
+				l_stream.m_sizeInBytes = (uint32_t)lv_sizeInBytes;
+			};
+
+		for (size_t i = 0; i < l_meshes.size(); ++i) {
+
+			const Mesh& lv_mesh = l_meshes[i];
+			CompressedStream* lv_meshStreams = l_streams.data() + i * lv_compressedStreamsPerMesh;
+
+			const uint8_t* lv_vertices = l_vertexData.data() + lv_mesh.m_streamOffsets[0];
+
+			lv_appendStream(lv_meshStreams[0], meshopt_encodeVertexBufferBound(lv_mesh.m_vertexCount, l_vertexStrideInBytes),
+				[&](uint8_t* l_destination, size_t l_sizeInBytes)
+				{
+					return meshopt_encodeVertexBuffer(l_destination, l_sizeInBytes, lv_vertices, lv_mesh.m_vertexCount, l_vertexStrideInBytes);
+				});
+
+			for (uint32_t j = 0; j < lv_mesh.m_lodCount; ++j) {
+
+				const uint32_t lv_totalNumIndices = lv_mesh.CalculateLODNumberOfIndices(j);
+
+				if (0U == lv_totalNumIndices) {
+					continue;
+				}
+
+				//The codec only takes 32 bit indices, the stream decodes to whatever width the mesh stores
+				lv_widenedIndices.resize(lv_totalNumIndices);
+				for (uint32_t k = 0; k < lv_totalNumIndices; ++k) {
+					lv_widenedIndices[k] = lv_mesh.ReadLODIndex(l_indexData.data(), j, k);
+				}
+
+				lv_appendStream(lv_meshStreams[1 + j], meshopt_encodeIndexBufferBound(lv_totalNumIndices, lv_mesh.m_vertexCount),
+					[&](uint8_t* l_destination, size_t l_sizeInBytes)
+					{
+						return meshopt_encodeIndexBuffer(l_destination, l_sizeInBytes, lv_widenedIndices.data(), lv_totalNumIndices);
+					});
+			}
+		}
+
+		return lv_encodedData;
+	}
+
+
+	bool DecodeMeshData(std::span<const Mesh> l_meshes, uint32_t l_vertexStrideInBytes,
+		std::span<const CompressedStream> l_streams, std::span<const uint8_t> l_encodedData,
+		std::span<uint8_t> l_vertexData, std::span<uint32_t> l_indexData, uint32_t l_totalNumThreads,
+		MeshDecodeStats& l_stats)
+	{
+		if (l_meshes.size() * lv_compressedStreamsPerMesh != l_streams.size()) {
+			return false;
+		}
+
+		if (0U == l_totalNumThreads) {
+			l_totalNumThreads = std::max(1U, std::thread::hardware_concurrency());
+		}
+		l_totalNumThreads = std::max(1U, std::min(l_totalNumThreads, (uint32_t)l_streams.size()));
+
+		std::atomic<uint32_t> lv_nextStreamIndex{ 0 };
+		std::atomic<bool> lv_failed{ false };
+
+		//Every stream writes a disjoint range, threads keep taking the next one since mesh sizes vary a lot
+		const auto lv_decodeStreams = [&]()
+			{
+				for (uint32_t i = lv_nextStreamIndex++; i < (uint32_t)l_streams.size(); i = lv_nextStreamIndex++) {
+
+					const Mesh& lv_mesh = l_meshes[i / lv_compressedStreamsPerMesh];
+
+					if (false == DecodeStream(lv_mesh, i % lv_compressedStreamsPerMesh, l_vertexStrideInBytes, l_streams[i],
+						l_encodedData, l_vertexData, l_indexData)) {
+						lv_failed = true;
+					}
+				}
+			};
+
+		const auto lv_start = std::chrono::steady_clock::now();
+
+		std::vector<std::thread> lv_workers{};
+		lv_workers.reserve(l_totalNumThreads - 1);
+
+		for (uint32_t i = 1; i < l_totalNumThreads; ++i) {
+			lv_workers.emplace_back(lv_decodeStreams);
+		}
+
+		lv_decodeStreams();
+
+		for (auto& l_worker : lv_workers) {
+			l_worker.join();
+		}
+
+		l_stats.m_milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lv_start).count();
+		l_stats.m_totalNumThreads = l_totalNumThreads;
+		l_stats.m_encodedBytes = l_encodedData.size();
+		l_stats.m_decodedBytes = 0;
+
+		for (uint32_t i = 0; i < (uint32_t)l_streams.size(); ++i) {
+			l_stats.m_decodedBytes += CalculateDecodedStreamSize(l_meshes[i / lv_compressedStreamsPerMesh],
+				i % lv_compressedStreamsPerMesh, l_vertexStrideInBytes);
+		}
+
+		return false == lv_failed;
+	}
+
+
+	void PrintDecodeStats(const MeshDecodeStats& l_stats)
+	{
+		constexpr double lv_bytesPerMB = 1024. * 1024.;
+
+		const double lv_decodedMB = (double)l_stats.m_decodedBytes / lv_bytesPerMB;
+		const double lv_seconds = l_stats.m_milliseconds / 1000.;
+
+		printf("Decoded %.2f MB of mesh data from %.2f MB (%.2fx) on %u threads in %.2f ms, %.1f MB/s.\n",
+			lv_decodedMB, (double)l_stats.m_encodedBytes / lv_bytesPerMB,
+			(0U == l_stats.m_encodedBytes) ? 1. : (double)l_stats.m_decodedBytes / (double)l_stats.m_encodedBytes,
+			l_stats.m_totalNumThreads, l_stats.m_milliseconds, (0. == lv_seconds) ? 0. : lv_decodedMB / lv_seconds);
+	}
+
+}
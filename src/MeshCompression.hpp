@@ -0,0 +1,51 @@
+#pragma once
+
+
+
+#include "Mesh.hpp"
+#include <cinttypes>
+#include <span>
+#include <vector>
+
+
+
+namespace MeshConverter
+{
+
+	//Where the encoded vertices of a mesh or the encoded indices of one of its LODs sit in the compressed block
+	struct CompressedStream final
+	{
+		uint32_t m_offset{};
+		uint32_t m_sizeInBytes{};
+	};
+
+	//One vertex stream followed by lv_maxLODCount index streams per mesh, LODs the mesh does not have stay empty
+	constexpr const uint32_t lv_compressedStreamsPerMesh{ 1 + lv_maxLODCount };
+
+
+	struct MeshDecodeStats final
+	{
+		uint64_t m_encodedBytes{ 0 };
+		uint64_t m_decodedBytes{ 0 };
+		double m_milliseconds{ 0. };
+		uint32_t m_totalNumThreads{ 0 };
+	};
+
+
+	//Encodes the vertices of every mesh with meshopt_encodeVertexBuffer and the indices of every LOD with
+	//meshopt_encodeIndexBuffer. l_streams receives lv_compressedStreamsPerMesh entries per mesh, in mesh order.
+	//l_indexData is the index block of the mesh file, LODs of meshes with 16 bit indices are packed in it.
+	std::vector<uint8_t> EncodeMeshData(std::span<const Mesh> l_meshes, std::span<const uint8_t> l_vertexData,
+		uint32_t l_vertexStrideInBytes, std::span<const uint32_t> l_indexData, std::vector<CompressedStream>& l_streams);
+
+	//Decodes every stream to the offsets its mesh points at, so the buffers end up exactly as in an uncompressed
+	//file. Streams are handed out to l_totalNumThreads threads (0 uses the hardware concurrency).
+	//Returns false when a stream does not fit its buffer or fails to decode.
+	bool DecodeMeshData(std::span<const Mesh> l_meshes, uint32_t l_vertexStrideInBytes,
+		std::span<const CompressedStream> l_streams, std::span<const uint8_t> l_encodedData,
+		std::span<uint8_t> l_vertexData, std::span<uint32_t> l_indexData, uint32_t l_totalNumThreads,
+		MeshDecodeStats& l_stats);
+
+	void PrintDecodeStats(const MeshDecodeStats& l_stats);
+
+}
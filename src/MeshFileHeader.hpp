@@ -6,14 +6,62 @@
 
 namespace MeshConverter
 {
+	//Bumped whenever the layout of the mesh file changes, older files are rejected on load
+	constexpr const uint32_t lv_meshFileMagicValue{ 0X1234567D };
+
+	constexpr const uint32_t lv_fp32VertexSizeInFloats{ 12 };
+	constexpr const uint32_t lv_packedVertexSizeInWords{ 4 };
+
+
+	//Layout of the vertex data that follows the meshes in the file
+	enum class VertexFormat : uint32_t
+	{
+		//Position, uv, normal and tangent as 12 floats
+		m_fp32 = 0,
+
+		//Quantized into 4 words, see VertexQuantization.hpp
+		m_packed = 1
+	};
+
+	//How packed positions are stored relative to the dequantization data of their Mesh
+	enum class PositionEncoding : uint32_t
+	{
+		m_snorm16 = 0,
+		m_half = 1
+	};
+
+
+	//How the vertex and index data that follows the meshes is stored
+	enum class MeshDataCompression : uint32_t
+	{
+		m_none = 0,
+
+		//Per mesh and per LOD streams of the meshoptimizer codecs, see MeshCompression.hpp
+		m_meshoptCodecs = 1
+	};
+
 
 	struct MeshFileHeader final
 	{
-		uint32_t m_magicValue{0X12345678};
+		uint32_t m_magicValue{ lv_meshFileMagicValue };
 		uint32_t m_meshCount{};
 		uint32_t m_startBlockOffset{};
 		uint32_t m_vertexDataSize{};
 		uint32_t m_lodDataSize{};
+
+		VertexFormat m_vertexFormat{ VertexFormat::m_fp32 };
+		uint32_t m_vertexStrideInBytes{ (uint32_t)(lv_fp32VertexSizeInFloats * sizeof(float)) };
+
+		//Only meaningful for packed vertices
+		PositionEncoding m_positionEncoding{ PositionEncoding::m_snorm16 };
+		uint32_t m_octahedralBits{ 10 };
+
+		//m_vertexDataSize and m_lodDataSize are the decoded sizes, m_compressedDataSize is what is stored in the file
+		MeshDataCompression m_compression{ MeshDataCompression::m_none };
+		uint32_t m_compressedDataSize{};
+
+		//Meshlets of every LOD of every mesh, stored uncompressed after the vertex and index data
+		uint32_t m_meshletCount{};
 	};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,267 @@
+#include "MeshMerging.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <string>
+
+
+namespace MeshConverter
+{
+
+	namespace
+	{
+		void VisitNode(const aiNode* l_node, const aiMatrix4x4& l_transform, std::vector<uint32_t>& l_totalNumReferences,
+			std::vector<aiMatrix4x4>& l_transforms)
+		{
+			for (uint32_t i = 0; i < l_node->mNumMeshes; ++i) {
+				++l_totalNumReferences[l_node->mMeshes[i]];
+				l_transforms[l_node->mMeshes[i]] = l_transform;
+			}
+
+			for (uint32_t i = 0; i < l_node->mNumChildren; ++i) {
+				VisitNode(l_node->mChildren[i], l_transform * l_node->mChildren[i]->mTransformation, l_totalNumReferences, l_transforms);
+			}
+		}
+	}
+
+
+	void MeshMerger::CollectStaticMeshes(const aiScene* l_scene, std::vector<StaticMesh>& l_staticMeshes) const
+	{
+		std::vector<uint32_t> lv_totalNumReferences(l_scene->mNumMeshes, 0U);
+		std::vector<aiMatrix4x4> lv_transforms(l_scene->mNumMeshes);
+
+		//The root transform is left out, the batch nodes hang below the root and inherit it at runtime
+		VisitNode(l_scene->mRootNode, aiMatrix4x4{}, lv_totalNumReferences, lv_transforms);
+
+		for (uint32_t i = 0; i < l_scene->mNumMeshes; ++i) {
+
+			//The renderer draws every mesh as it is stored and ignores the node transforms, so only meshes whose
+			//nodes leave them where they are can be merged and still land on the same pixels
+			if (1U != lv_totalNumReferences[i] || 0U == l_scene->mMeshes[i]->mNumVertices ||
+				false == lv_transforms[i].IsIdentity()) {
+				continue;
+			}
+
+			l_staticMeshes.push_back(StaticMesh{ .m_meshIndex = i });
+		}
+	}
+
+
+	std::unique_ptr<aiMesh> MeshMerger::CreateBatch(const aiScene* l_scene, const std::vector<StaticMesh>& l_meshes) const
+	{
+		uint32_t lv_totalNumVertices{};
+		uint32_t lv_totalNumFaces{};
+
+		for (const auto& l_staticMesh : l_meshes) {
+			const aiMesh* lv_mesh = l_scene->mMeshes[l_staticMesh.m_meshIndex];
+
+			lv_totalNumVertices += lv_mesh->mNumVertices;
+
+			for (uint32_t i = 0; i < lv_mesh->mNumFaces; ++i) {
+				lv_totalNumFaces += (3U == lv_mesh->mFaces[i].mNumIndices) ? 1U : 0U;
+			}
+		}
+
+		auto lv_batch = std::make_unique<aiMesh>();
+
+		const uint32_t lv_materialIndex = l_scene->mMeshes[l_meshes.front().m_meshIndex]->mMaterialIndex;
+		const std::string lv_name = "Batch of " + std::to_string(l_meshes.size()) + " meshes, material " + std::to_string(lv_materialIndex);
+
+		lv_batch->mName = aiString{ lv_name };
+		lv_batch->mMaterialIndex = lv_materialIndex;
+		lv_batch->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+		lv_batch->mNumVertices = lv_totalNumVertices;
+		lv_batch->mNumFaces = lv_totalNumFaces;
+
+		//aiMesh releases its arrays with delete[]
+		lv_batch->mVertices = new aiVector3D[lv_totalNumVertices];
+		lv_batch->mNormals = new aiVector3D[lv_totalNumVertices];
+		lv_batch->mTangents = new aiVector3D[lv_totalNumVertices];
+		lv_batch->mBitangents = new aiVector3D[lv_totalNumVertices];
+		lv_batch->mTextureCoords[0] = new aiVector3D[lv_totalNumVertices];
+		lv_batch->mNumUVComponents[0] = 2;
+		lv_batch->mFaces = new aiFace[lv_totalNumFaces];
+
+		aiVector3D lv_min{ std::numeric_limits<float>::max() };
+		aiVector3D lv_max{ -std::numeric_limits<float>::max() };
+
+		uint32_t lv_firstVertex{};
+		uint32_t lv_nextFace{};
+
+		for (const auto& l_staticMesh : l_meshes) {
+
+			const aiMesh* lv_mesh = l_scene->mMeshes[l_staticMesh.m_meshIndex];
+
+			for (uint32_t i = 0; i < lv_mesh->mNumVertices; ++i) {
+
+				const uint32_t lv_vertex = lv_firstVertex + i;
+				const aiVector3D lv_position = lv_mesh->mVertices[i];
+
+				lv_batch->mVertices[lv_vertex] = lv_position;
+
+				lv_min = aiVector3D{ std::min(lv_min.x, lv_position.x), std::min(lv_min.y, lv_position.y), std::min(lv_min.z, lv_position.z) };
+				lv_max = aiVector3D{ std::max(lv_max.x, lv_position.x), std::max(lv_max.y, lv_position.y), std::max(lv_max.z, lv_position.z) };
+
+				//Missing attributes get the same 1s that GeometryConverter::ConvertMesh() writes for them
+				lv_batch->mTextureCoords[0][lv_vertex] = (true == lv_mesh->HasTextureCoords(0))
+					? lv_mesh->mTextureCoords[0][i] : aiVector3D{ 1.f, 1.f, 0.f };
+
+				lv_batch->mNormals[lv_vertex] = (true == lv_mesh->HasNormals()) ? lv_mesh->mNormals[i] : aiVector3D{ 1.f };
+
+				if (true == lv_mesh->HasTangentsAndBitangents()) {
+					lv_batch->mTangents[lv_vertex] = lv_mesh->mTangents[i];
+					lv_batch->mBitangents[lv_vertex] = lv_mesh->mBitangents[i];
+				}
+				else {
+					lv_batch->mTangents[lv_vertex] = aiVector3D{ 1.f };
+					lv_batch->mBitangents[lv_vertex] = aiVector3D{ 1.f };
+				}
+			}
+
+			//Points and lines are dropped here as well, ConvertMesh() only keeps triangles
+			for (uint32_t i = 0; i < lv_mesh->mNumFaces; ++i) {
+
+				const aiFace& lv_face = lv_mesh->mFaces[i];
+
+				if (3U != lv_face.mNumIndices) {
+					continue;
+				}
+
+				aiFace& lv_batchFace = lv_batch->mFaces[lv_nextFace++];
+				lv_batchFace.mNumIndices = 3;
+				lv_batchFace.mIndices = new unsigned int[3]{ lv_firstVertex + lv_face.mIndices[0],
+					lv_firstVertex + lv_face.mIndices[1], lv_firstVertex + lv_face.mIndices[2] };
+			}
+
+			lv_firstVertex += lv_mesh->mNumVertices;
+		}
+
+		lv_batch->mAABB = aiAABB{ lv_min, lv_max };
+
+		return lv_batch;
+	}
+
+
+	void MeshMerger::MergeScene(const aiScene* l_scene, SceneConverter::SceneConverter& l_sceneConverter,
+		const MeshMergingSettings& l_settings, float l_positionScale, std::vector<const aiMesh*>& l_meshesToConvert)
+	{
+		m_batches.clear();
+		m_totalNumSourceMeshes = l_scene->mNumMeshes;
+		m_totalNumStaticMeshes = 0;
+		m_totalNumMergedMeshes = 0;
+
+		l_meshesToConvert.assign(l_scene->mMeshes, l_scene->mMeshes + l_scene->mNumMeshes);
+		m_totalNumOutputMeshes = (uint32_t)l_meshesToConvert.size();
+
+		if (false == l_settings.m_enabled) {
+			return;
+		}
+
+		std::vector<StaticMesh> lv_staticMeshes{};
+		CollectStaticMeshes(l_scene, lv_staticMeshes);
+		m_totalNumStaticMeshes = (uint32_t)lv_staticMeshes.size();
+
+		//Material first and the cell after it, an ordered map keeps the batches the same from run to run
+		std::map<std::array<int32_t, 4>, std::vector<StaticMesh>> lv_groups{};
+
+		for (const auto& l_staticMesh : lv_staticMeshes) {
+
+			const aiMesh* lv_mesh = l_scene->mMeshes[l_staticMesh.m_meshIndex];
+			std::array<int32_t, 4> lv_key{ (int32_t)lv_mesh->mMaterialIndex, 0, 0, 0 };
+
+			if (0.f < l_settings.m_cellSize) {
+				const aiVector3D lv_center = (lv_mesh->mAABB.mMin + lv_mesh->mAABB.mMax) * 0.5f;
+
+				lv_key[1] = (int32_t)std::floor(lv_center.x * l_positionScale / l_settings.m_cellSize);
+				lv_key[2] = (int32_t)std::floor(lv_center.y * l_positionScale / l_settings.m_cellSize);
+				lv_key[3] = (int32_t)std::floor(lv_center.z * l_positionScale / l_settings.m_cellSize);
+			}
+
+			lv_groups[lv_key].push_back(l_staticMesh);
+		}
+
+		//Groups are cut into batches in mesh order, a batch of one mesh is no batch and that mesh stays as it is
+		std::vector<std::vector<StaticMesh>> lv_batchMeshes{};
+		std::vector<bool> lv_merged(l_scene->mNumMeshes, false);
+
+		for (const auto& l_group : lv_groups) {
+
+			std::vector<StaticMesh> lv_batch{};
+			uint32_t lv_totalNumBatchVertices{};
+
+			const auto lv_closeBatch = [&]()
+				{
+					if (1U < lv_batch.size()) {
+						for (const auto& l_staticMesh : lv_batch) {
+							lv_merged[l_staticMesh.m_meshIndex] = true;
+						}
+
+						lv_batchMeshes.push_back(std::move(lv_batch));
+					}
+
+					lv_batch.clear();
+					lv_totalNumBatchVertices = 0U;
+				};
+
+			for (const auto& l_staticMesh : l_group.second) {
+
+				const uint32_t lv_totalNumMeshVertices = l_scene->mMeshes[l_staticMesh.m_meshIndex]->mNumVertices;
+
+				if (l_settings.m_maxNumVertices < lv_totalNumBatchVertices + lv_totalNumMeshVertices) {
+					lv_closeBatch();
+				}
+
+				lv_batch.push_back(l_staticMesh);
+				lv_totalNumBatchVertices += lv_totalNumMeshVertices;
+			}
+
+			lv_closeBatch();
+		}
+
+		l_meshesToConvert.clear();
+		std::vector<uint32_t> lv_newMeshIndices(l_scene->mNumMeshes, 0U);
+
+		for (uint32_t i = 0; i < l_scene->mNumMeshes; ++i) {
+			if (false == lv_merged[i]) {
+				lv_newMeshIndices[i] = (uint32_t)l_meshesToConvert.size();
+				l_meshesToConvert.push_back(l_scene->mMeshes[i]);
+			}
+		}
+
+		//Nodes of merged meshes keep their place in the hierarchy, they only stop drawing
+		auto& lv_scene = l_sceneConverter.GetScene();
+
+		for (auto lv_nodeMesh = lv_scene.m_meshes.begin(); lv_nodeMesh != lv_scene.m_meshes.end();) {
+			if (true == lv_merged[lv_nodeMesh->second]) {
+				lv_scene.m_materialIDs.erase(lv_nodeMesh->first);
+				lv_nodeMesh = lv_scene.m_meshes.erase(lv_nodeMesh);
+			}
+			else {
+				lv_nodeMesh->second = lv_newMeshIndices[lv_nodeMesh->second];
+				++lv_nodeMesh;
+			}
+		}
+
+		for (const auto& l_meshes : lv_batchMeshes) {
+			m_batches.push_back(CreateBatch(l_scene, l_meshes));
+			m_totalNumMergedMeshes += (uint32_t)l_meshes.size();
+
+			l_sceneConverter.AddMeshNode(0, (uint32_t)l_meshesToConvert.size(), m_batches.back()->mMaterialIndex);
+			l_meshesToConvert.push_back(m_batches.back().get());
+		}
+
+		m_totalNumOutputMeshes = (uint32_t)l_meshesToConvert.size();
+	}
+
+
+	void MeshMerger::PrintReport() const
+	{
+		printf("\nMesh merging: %u of %u meshes are static, %u of them were merged into %u batches.\n",
+			m_totalNumStaticMeshes, m_totalNumSourceMeshes, m_totalNumMergedMeshes, (uint32_t)m_batches.size());
+		printf("Meshes to convert and instances to draw: %u -> %u\n\n", m_totalNumSourceMeshes, m_totalNumOutputMeshes);
+	}
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+
+
+#include "SceneConverter.hpp"
+#include <assimp/scene.h>
+#include <cinttypes>
+#include <memory>
+#include <vector>
+
+
+
+namespace MeshConverter
+{
+
+	struct MeshMergingSettings final
+	{
+		bool m_enabled{ false };
+
+		//Upper bound of the vertices of one merged mesh, 65536 keeps its indices at 16 bits
+		uint32_t m_maxNumVertices{ 65536 };
+
+		//Edge of the grid cells in scaled scene units, only meshes whose centers share a cell are merged.
+		//0 merges by material alone.
+		float m_cellSize{ 0.f };
+	};
+
+
+	//Combines the static meshes of a scene that share a material (and a grid cell) into batches, so that the
+	//renderer draws and culls one instance per batch instead of one per mesh. A mesh is static when exactly one
+	//node references it and the nodes above it, the root left out, add up to the identity. The renderer draws
+	//every mesh untransformed, so batch vertices are copied as they are and the batch gets its own mesh node
+	//under the root. GeometryConverter then converts the batches like any other mesh, so LODs and meshlets are
+	//generated for the merged geometry.
+	class MeshMerger final
+	{
+	public:
+
+		MeshMerger() = default;
+
+		MeshMerger(const MeshMerger&) = delete;
+		MeshMerger& operator=(const MeshMerger&) = delete;
+
+		//Fills l_meshesToConvert with the meshes that were not merged in their original order followed by the batches,
+		//and remaps the mesh nodes of l_sceneConverter to these indices. l_positionScale is the scale GeometryConverter
+		//applies to the positions, the cell size is given after it. The batches live until the next call.
+		void MergeScene(const aiScene* l_scene, SceneConverter::SceneConverter& l_sceneConverter,
+			const MeshMergingSettings& l_settings, float l_positionScale, std::vector<const aiMesh*>& l_meshesToConvert);
+
+		void PrintReport() const;
+
+	private:
+
+		struct StaticMesh final
+		{
+			uint32_t m_meshIndex{};
+		};
+
+		//Collects the meshes that exactly one node references with an identity transform relative to the root
+		void CollectStaticMeshes(const aiScene* l_scene, std::vector<StaticMesh>& l_staticMeshes) const;
+
+		std::unique_ptr<aiMesh> CreateBatch(const aiScene* l_scene, const std::vector<StaticMesh>& l_meshes) const;
+
+
+		std::vector<std::unique_ptr<aiMesh>> m_batches{};
+
+		uint32_t m_totalNumSourceMeshes{ 0 };
+		uint32_t m_totalNumStaticMeshes{ 0 };
+		uint32_t m_totalNumMergedMeshes{ 0 };
+		uint32_t m_totalNumOutputMeshes{ 0 };
+	};
+
+}
@@ -0,0 +1,81 @@
+
+
+
+
+#include "MeshletCulling.hpp"
+#include "UtilsMath.h"
+
+
+
+namespace RenderCore
+{
+
+	MeshletCullingView CreateMeshletCullingView(const glm::mat4& l_viewProjection, const glm::vec3& l_cameraPosition,
+		bool l_enableConeCulling)
+	{
+		MeshletCullingView lv_view{};
+
+		getFrustumPlanes(l_viewProjection, lv_view.m_frustumPlanes);
+
+		//Sphere tests need true distances
+		for (auto& l_plane : lv_view.m_frustumPlanes) {
+			l_plane /= glm::length(glm::vec3{ l_plane });
+		}
+
+		lv_view.m_cameraPosition = glm::vec4{ l_cameraPosition, 1.f };
+		lv_view.m_enableConeCulling = (true == l_enableConeCulling) ? 1U : 0U;
+
+		return lv_view;
+	}
+
+
+	bool IsMeshletVisible(const MeshConverter::Meshlet& l_meshlet, const MeshletCullingView& l_view)
+	{
+		const glm::vec3 lv_center{ l_meshlet.m_center[0], l_meshlet.m_center[1], l_meshlet.m_center[2] };
+
+		for (const auto& l_plane : l_view.m_frustumPlanes) {
+			if (glm::dot(glm::vec3{ l_plane }, lv_center) + l_plane.w < -l_meshlet.m_radius) {
+				return false;
+			}
+		}
+
+		if (0U == l_view.m_enableConeCulling) {
+			return true;
+		}
+
+		const glm::vec3 lv_coneAxis{ l_meshlet.m_coneAxis[0], l_meshlet.m_coneAxis[1], l_meshlet.m_coneAxis[2] };
+		const glm::vec3 lv_cameraToCenter = lv_center - glm::vec3{ l_view.m_cameraPosition };
+
+		return glm::dot(lv_cameraToCenter, lv_coneAxis) < l_meshlet.m_coneCutoff * glm::length(lv_cameraToCenter) + l_meshlet.m_radius;
+	}
+
+
+	uint32_t CullMeshlets(const MeshletCullingView& l_view, std::span<const InstanceData> l_instances,
+		std::span<const VkDrawIndirectCommand> l_instanceDraws, std::span<const MeshletRange> l_meshletRanges,
+		std::span<const MeshConverter::Meshlet> l_meshlets, std::span<VkDrawIndirectCommand> l_draws)
+	{
+		uint32_t lv_totalNumDraws{ 0 };
+
+		for (uint32_t i = 0; i < (uint32_t)l_instances.size(); ++i) {
+
+			if (0U == l_instanceDraws[i].instanceCount) {
+				continue;
+			}
+
+			const auto& lv_range = l_meshletRanges[l_instances[i].m_meshIndex * MeshConverter::lv_maxLODCount + l_instances[i].m_lod];
+
+			for (uint32_t j = lv_range.m_firstMeshlet; j < lv_range.m_firstMeshlet + lv_range.m_totalNumMeshlets; ++j) {
+
+				if (false == IsMeshletVisible(l_meshlets[j], l_view) || l_draws.size() <= lv_totalNumDraws) {
+					continue;
+				}
+
+				l_draws[lv_totalNumDraws++] = VkDrawIndirectCommand{ .vertexCount = l_meshlets[j].m_totalNumIndices,
+					.instanceCount = 1, .firstVertex = l_meshlets[j].m_firstIndex, .firstInstance = i };
+			}
+		}
+
+		return lv_totalNumDraws;
+	}
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+
+
+#include "UtilsVulkan.h"
+#include "InstanceData.hpp"
+#include "Mesh.hpp"
+#include <array>
+#include <cinttypes>
+#include <span>
+#include <glm/glm.hpp>
+
+
+
+namespace RenderCore
+{
+
+	//Per frame input of the meshlet culling, the layout is read word by word by MeshletCulling.comp
+	struct MeshletCullingView
+	{
+		//Normalized, a point p is inside when dot(plane.xyz, p) + plane.w >= 0
+		std::array<glm::vec4, 6> m_frustumPlanes{};
+		glm::vec4 m_cameraPosition{};
+
+		uint32_t m_enableConeCulling{ 1 };
+		uint32_t m_padding[3]{};
+	};
+
+
+	//Meshlets of one LOD of one mesh, the range buffer holds lv_maxLODCount of them per mesh
+	struct MeshletRange
+	{
+		uint32_t m_firstMeshlet{ 0 };
+		uint32_t m_totalNumMeshlets{ 0 };
+	};
+
+
+	MeshletCullingView CreateMeshletCullingView(const glm::mat4& l_viewProjection, const glm::vec3& l_cameraPosition,
+		bool l_enableConeCulling);
+
+	//Bounding sphere against the frustum, then the normal cone against the camera position
+	bool IsMeshletVisible(const MeshConverter::Meshlet& l_meshlet, const MeshletCullingView& l_view);
+
+	//CPU reference of MeshletCulling.comp. Instances whose draw in l_instanceDraws has no instances are skipped,
+	//every surviving meshlet of the LOD of a visible instance becomes one draw of its index run.
+	//Returns the number of draws written to l_draws, the GPU writes the same set in no particular order.
+	uint32_t CullMeshlets(const MeshletCullingView& l_view, std::span<const InstanceData> l_instances,
+		std::span<const VkDrawIndirectCommand> l_instanceDraws, std::span<const MeshletRange> l_meshletRanges,
+		std::span<const MeshConverter::Meshlet> l_meshlets, std::span<VkDrawIndirectCommand> l_draws);
+
+}
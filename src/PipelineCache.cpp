@@ -0,0 +1,228 @@
+
+
+
+
+#include "PipelineCache.hpp"
+#include "ErrorCheck.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+
+namespace RenderCore
+{
+
+	namespace
+	{
+		uint64_t HashBytes(const uint8_t* l_data, size_t l_sizeInBytes)
+		{
+			//FNV-1a, only used to reject truncated or corrupted files
+			uint64_t lv_hash{ 0xcbf29ce484222325ULL };
+
+			for (size_t i = 0; i < l_sizeInBytes; ++i) {
+				lv_hash ^= l_data[i];
+				lv_hash *= 0x100000001b3ULL;
+			}
+
+			return lv_hash;
+		}
+	}
+
+
+	PipelineCache::PipelineCache(VulkanRenderDevice& l_renderDevice, const std::string& l_cacheFilePath)
+		:m_renderDevice(l_renderDevice), m_cacheFilePath(l_cacheFilePath)
+	{
+		using namespace ErrorCheck;
+
+		VkPhysicalDeviceIDProperties lv_idProperties{};
+		lv_idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+
+		VkPhysicalDeviceProperties2 lv_deviceProperties{};
+		lv_deviceProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		lv_deviceProperties.pNext = &lv_idProperties;
+
+		vkGetPhysicalDeviceProperties2(m_renderDevice.m_physicalDevice, &lv_deviceProperties);
+
+		m_deviceProperties = lv_deviceProperties.properties;
+		memcpy(m_deviceUUID, lv_idProperties.deviceUUID, VK_UUID_SIZE);
+
+		std::vector<uint8_t> lv_cacheData{};
+		m_stats.m_loadedFromDisk = LoadCacheData(lv_cacheData);
+		m_stats.m_loadedBytes = lv_cacheData.size();
+
+		VkPipelineCacheCreateInfo lv_cacheCreateInfo{};
+		lv_cacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		lv_cacheCreateInfo.pNext = nullptr;
+		lv_cacheCreateInfo.flags = 0;
+		lv_cacheCreateInfo.initialDataSize = lv_cacheData.size();
+		lv_cacheCreateInfo.pInitialData = (true == lv_cacheData.empty()) ? nullptr : lv_cacheData.data();
+
+		VULKAN_CHECK(vkCreatePipelineCache(m_renderDevice.m_device, &lv_cacheCreateInfo, nullptr, &m_pipelineCache));
+
+		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
+		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(m_pipelineCache);
+		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_PIPELINE_CACHE;
+		lv_objectNameInfo.pNext = nullptr;
+		lv_objectNameInfo.pObjectName = " Pipeline-Cache ";
+		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+
+		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+
+		printf("\nPipeline cache %s: %zu bytes loaded from %s.\n",
+			(true == m_stats.m_loadedFromDisk) ? "warm" : "cold", m_stats.m_loadedBytes, m_cacheFilePath.c_str());
+	}
+
+
+	PipelineCache::~PipelineCache()
+	{
+		vkDestroyPipelineCache(m_renderDevice.m_device, m_pipelineCache, nullptr);
+	}
+
+
+	VkPipelineCache PipelineCache::GetVkPipelineCache() const
+	{
+		return m_pipelineCache;
+	}
+
+
+	PipelineCache::FileHeader PipelineCache::MakeFileHeader() const
+	{
+		FileHeader lv_header{};
+		lv_header.m_magic = m_fileMagic;
+		lv_header.m_fileVersion = m_fileVersion;
+		lv_header.m_vendorID = m_deviceProperties.vendorID;
+		lv_header.m_deviceID = m_deviceProperties.deviceID;
+		lv_header.m_driverVersion = m_deviceProperties.driverVersion;
+		memcpy(lv_header.m_deviceUUID, m_deviceUUID, VK_UUID_SIZE);
+		memcpy(lv_header.m_pipelineCacheUUID, m_deviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+
+		return lv_header;
+	}
+
+
+	bool PipelineCache::LoadCacheData(std::vector<uint8_t>& l_cacheData) const
+	{
+		std::ifstream lv_file{ m_cacheFilePath, std::ios::binary };
+
+		if (false == lv_file.is_open()) {
+			return false;
+		}
+
+		FileHeader lv_header{};
+		lv_file.read(reinterpret_cast<char*>(&lv_header), sizeof(FileHeader));
+
+		if (false == lv_file.good()) {
+			printf("\nPipeline cache file %s is truncated, it is ignored.\n", m_cacheFilePath.c_str());
+			return false;
+		}
+
+		const FileHeader lv_expectedHeader = MakeFileHeader();
+
+		if (lv_expectedHeader.m_magic != lv_header.m_magic || lv_expectedHeader.m_fileVersion != lv_header.m_fileVersion ||
+			lv_expectedHeader.m_vendorID != lv_header.m_vendorID || lv_expectedHeader.m_deviceID != lv_header.m_deviceID ||
+			lv_expectedHeader.m_driverVersion != lv_header.m_driverVersion ||
+			0 != memcmp(lv_expectedHeader.m_deviceUUID, lv_header.m_deviceUUID, VK_UUID_SIZE) ||
+			0 != memcmp(lv_expectedHeader.m_pipelineCacheUUID, lv_header.m_pipelineCacheUUID, VK_UUID_SIZE)) {
+			printf("\nPipeline cache file %s was written by another device or driver, it is ignored.\n", m_cacheFilePath.c_str());
+			return false;
+		}
+
+		l_cacheData.resize(lv_header.m_dataSize);
+		lv_file.read(reinterpret_cast<char*>(l_cacheData.data()), (std::streamsize)l_cacheData.size());
+
+		if (false == lv_file.good() || lv_header.m_dataHash != HashBytes(l_cacheData.data(), l_cacheData.size())) {
+			printf("\nPipeline cache file %s is corrupted, it is ignored.\n", m_cacheFilePath.c_str());
+			l_cacheData.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+
+	bool PipelineCache::Save() const
+	{
+		using namespace ErrorCheck;
+
+		size_t lv_dataSize{ 0 };
+		VULKAN_CHECK(vkGetPipelineCacheData(m_renderDevice.m_device, m_pipelineCache, &lv_dataSize, nullptr));
+
+		std::vector<uint8_t> lv_cacheData(lv_dataSize);
+		VULKAN_CHECK(vkGetPipelineCacheData(m_renderDevice.m_device, m_pipelineCache, &lv_dataSize, lv_cacheData.data()));
+		lv_cacheData.resize(lv_dataSize);
+
+		FileHeader lv_header = MakeFileHeader();
+		lv_header.m_dataSize = lv_cacheData.size();
+		lv_header.m_dataHash = HashBytes(lv_cacheData.data(), lv_cacheData.size());
+
+		const std::string lv_tempFilePath{ m_cacheFilePath + ".tmp" };
+
+		{
+			std::ofstream lv_file{ lv_tempFilePath, std::ios::binary | std::ios::trunc };
+
+			if (false == lv_file.is_open()) {
+				printf("\nFailed to open %s for writing the pipeline cache.\n", lv_tempFilePath.c_str());
+				return false;
+			}
+
+			lv_file.write(reinterpret_cast<const char*>(&lv_header), sizeof(FileHeader));
+			lv_file.write(reinterpret_cast<const char*>(lv_cacheData.data()), (std::streamsize)lv_cacheData.size());
+
+			if (false == lv_file.good()) {
+				printf("\nFailed to write the pipeline cache to %s.\n", lv_tempFilePath.c_str());
+				return false;
+			}
+		}
+
+		std::error_code lv_errorCode{};
+		std::filesystem::rename(lv_tempFilePath, m_cacheFilePath, lv_errorCode);
+
+		if (lv_errorCode) {
+			printf("\nFailed to move the pipeline cache to %s: %s\n", m_cacheFilePath.c_str(), lv_errorCode.message().c_str());
+			return false;
+		}
+
+		printf("\nPipeline cache saved to %s (%zu bytes).\n", m_cacheFilePath.c_str(), lv_cacheData.size());
+
+		return true;
+	}
+
+
+	void PipelineCache::RecordPipelineCreation(const VkPipelineCreationFeedback& l_feedback, double l_creationMilliseconds)
+	{
+		++m_stats.m_totalNumPipelines;
+
+		if (0 == (VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT & l_feedback.flags)) {
+			++m_stats.m_totalNumWithoutFeedback;
+		}
+		else if (0 != (VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT & l_feedback.flags)) {
+			++m_stats.m_totalNumCacheHits;
+		}
+
+		m_stats.m_totalCreationMilliseconds += l_creationMilliseconds;
+		m_stats.m_maxCreationMilliseconds = std::max(m_stats.m_maxCreationMilliseconds, l_creationMilliseconds);
+	}
+
+
+	const PipelineCacheStats& PipelineCache::GetStats() const
+	{
+		return m_stats;
+	}
+
+
+	void PipelineCache::PrintStats() const
+	{
+		const uint32_t lv_totalNumWithFeedback = m_stats.m_totalNumPipelines - m_stats.m_totalNumWithoutFeedback;
+		const double lv_hitRate = (0 == lv_totalNumWithFeedback) ? 0.0 :
+			100.0 * (double)m_stats.m_totalNumCacheHits / (double)lv_totalNumWithFeedback;
+
+		printf("\nPipeline cache: %u pipelines, %u cache hits (%.1f%% of %u with feedback).\n",
+			m_stats.m_totalNumPipelines, m_stats.m_totalNumCacheHits, lv_hitRate, lv_totalNumWithFeedback);
+		printf("Pipeline creation: %.2f ms total, %.2f ms average, %.2f ms worst.\n",
+			m_stats.m_totalCreationMilliseconds,
+			(0 == m_stats.m_totalNumPipelines) ? 0.0 : m_stats.m_totalCreationMilliseconds / (double)m_stats.m_totalNumPipelines,
+			m_stats.m_maxCreationMilliseconds);
+	}
+
+}
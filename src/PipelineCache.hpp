@@ -0,0 +1,88 @@
+#pragma once
+
+
+
+#include "UtilsVulkan.h"
+#include <cinttypes>
+#include <string>
+#include <vector>
+
+
+
+namespace RenderCore
+{
+
+	struct PipelineCacheStats
+	{
+		uint32_t m_totalNumPipelines{ 0 };
+
+		//Pipelines the driver reported as found in the cache (VkPipelineCreationFeedback)
+		uint32_t m_totalNumCacheHits{ 0 };
+		uint32_t m_totalNumWithoutFeedback{ 0 };
+
+		//Wall clock time of the whole creation call, shader module creation included
+		double m_totalCreationMilliseconds{ 0.0 };
+		double m_maxCreationMilliseconds{ 0.0 };
+
+		size_t m_loadedBytes{ 0 };
+		bool m_loadedFromDisk{ false };
+	};
+
+
+	//One VkPipelineCache shared by every pipeline created through VulkanResourceManager.
+	//The cache blob is loaded from disk at startup and only accepted when the file header matches the
+	//vendor, device, device UUID, pipeline cache UUID and driver version of the current physical device.
+	class PipelineCache final
+	{
+	public:
+
+		PipelineCache(VulkanRenderDevice& l_renderDevice, const std::string& l_cacheFilePath);
+		~PipelineCache();
+
+		PipelineCache(const PipelineCache&) = delete;
+		PipelineCache& operator=(const PipelineCache&) = delete;
+
+		VkPipelineCache GetVkPipelineCache() const;
+
+		void RecordPipelineCreation(const VkPipelineCreationFeedback& l_feedback, double l_creationMilliseconds);
+
+		//Writes to a temporary file first so that a crash never leaves a truncated cache behind
+		bool Save() const;
+
+		const PipelineCacheStats& GetStats() const;
+		void PrintStats() const;
+
+	private:
+
+		struct FileHeader
+		{
+			uint32_t m_magic{ 0 };
+			uint32_t m_fileVersion{ 0 };
+			uint32_t m_vendorID{ 0 };
+			uint32_t m_deviceID{ 0 };
+			uint32_t m_driverVersion{ 0 };
+			uint8_t m_deviceUUID[VK_UUID_SIZE]{};
+			uint8_t m_pipelineCacheUUID[VK_UUID_SIZE]{};
+			uint64_t m_dataSize{ 0 };
+			uint64_t m_dataHash{ 0 };
+		};
+
+		static constexpr uint32_t m_fileMagic = 0x4C505643;
+		static constexpr uint32_t m_fileVersion = 1;
+
+		FileHeader MakeFileHeader() const;
+		bool LoadCacheData(std::vector<uint8_t>& l_cacheData) const;
+
+
+		VulkanRenderDevice& m_renderDevice;
+		std::string m_cacheFilePath;
+
+		VkPipelineCache m_pipelineCache{ VK_NULL_HANDLE };
+
+		VkPhysicalDeviceProperties m_deviceProperties{};
+		uint8_t m_deviceUUID[VK_UUID_SIZE]{};
+
+		PipelineCacheStats m_stats{};
+	};
+
+}
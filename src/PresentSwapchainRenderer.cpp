@@ -23,8 +23,6 @@ namespace RenderCore
 
 		m_swapchains.resize(lv_totalNumSwapchains);
 		m_bloomResults.resize(lv_totalNumSwapchains);
-		m_imageInfo.resize(lv_totalNumSwapchains);
-		m_writes.resize(lv_totalNumSwapchains);
 
 		for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
 			m_swapchains[i] = &lv_vkResManager.RetrieveGpuTexture("Swapchain", i);
@@ -51,11 +49,11 @@ namespace RenderCore
 		lv_pipeInfo.m_totalNumColorAttach = lv_node->m_outputResourcesHandles.size();
 
 
-		m_graphicsPipeline = lv_vkResManager.CreateGraphicsPipeline(m_renderPass, m_pipelineLayout
-			, { l_vtxShader, l_fragShader }, "GraphicsPipelineFXAA", lv_pipeInfo);
+		lv_vkResManager.RequestGraphicsPipeline(m_renderPass, m_pipelineLayout
+			, { l_vtxShader, l_fragShader }, "GraphicsPipelineFXAA", lv_pipeInfo, m_graphicsPipeline);
 
-		m_debugTiledDeferredPresentSwapchain = lv_vkResManager.CreateGraphicsPipeline(m_renderPass, m_pipelineLayout
-			, { l_vtxShader, "Shaders/DebugPresentTiledDeferredSwapchain.frag"}, "GraphicsPipelineDebugTiledPresentSwapchain", lv_pipeInfo);
+		lv_vkResManager.RequestGraphicsPipeline(m_renderPass, m_pipelineLayout
+			, { l_vtxShader, "Shaders/DebugPresentTiledDeferredSwapchain.frag"}, "GraphicsPipelineDebugTiledPresentSwapchain", lv_pipeInfo, m_debugTiledDeferredPresentSwapchain, true);
 	}
 
 
@@ -97,7 +95,8 @@ namespace RenderCore
 			vkCmdBindPipeline(l_cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline);
 		}
 		else {
-			vkCmdBindPipeline(l_cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_debugTiledDeferredPresentSwapchain);
+			vkCmdBindPipeline(l_cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+				lv_vkResManager.CreateDeferredPipeline(m_debugTiledDeferredPresentSwapchain));
 		}
 
 		if (0 != m_descriptorSets.size()) {
@@ -122,64 +121,18 @@ namespace RenderCore
 
 	void PresentSwapchainRenderer::UpdateInputDescriptorImages(std::vector<VulkanTexture*>& l_newInputs)
 	{
-		
-		for (size_t i = 0; i < m_imageInfo.size(); i++) {
-
-			m_imageInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			m_imageInfo[i].imageView = l_newInputs[i]->image.imageView0;
-			m_imageInfo[i].sampler = l_newInputs[i]->sampler;
-
-		}
-
-
-		for (size_t i = 0; i < m_writes.size(); ++i) {
-			m_writes[i].descriptorCount = 1;
-			m_writes[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			m_writes[i].dstArrayElement = 0;
-			m_writes[i].dstBinding = 0;
-			m_writes[i].dstSet = m_descriptorSets[i];
-			m_writes[i].pBufferInfo = nullptr;
-			m_writes[i].pImageInfo = &m_imageInfo[i];
-			m_writes[i].pNext = nullptr;
-			m_writes[i].pTexelBufferView = nullptr;
-			m_writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
+			WriteImageDescriptor(i, 0, { l_newInputs[i]->sampler, l_newInputs[i]->image.imageView0,
+				VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
 		}
 
-		vkUpdateDescriptorSets(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device
-			, m_writes.size(), m_writes.data(), 0, nullptr);
-
+		FlushDescriptorWrites();
 	}
 	
 
 	void PresentSwapchainRenderer::UpdateDescriptorSets()
 	{
-		
-		for (size_t i = 0; i < m_imageInfo.size(); i++) {
-
-			m_imageInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			m_imageInfo[i].imageView = m_bloomResults[i]->image.imageView0;
-			m_imageInfo[i].sampler = m_bloomResults[i]->sampler;
-
-		}
-
-	
-
-		for (size_t i = 0; i < m_writes.size(); ++i) {
-			m_writes[i].descriptorCount = 1;
-			m_writes[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			m_writes[i].dstArrayElement = 0;
-			m_writes[i].dstBinding = 0;
-			m_writes[i].dstSet = m_descriptorSets[i];
-			m_writes[i].pBufferInfo = nullptr;
-			m_writes[i].pImageInfo = &m_imageInfo[i];
-			m_writes[i].pNext = nullptr;
-			m_writes[i].pTexelBufferView = nullptr;
-			m_writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		}
-
-		vkUpdateDescriptorSets(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device
-			, m_writes.size(), m_writes.data(), 0, nullptr);
-
+		UpdateInputDescriptorImages(m_bloomResults);
 	}
 
 }
\ No newline at end of file
@@ -39,9 +39,6 @@ namespace RenderCore
 		std::vector<VulkanTexture*> m_swapchains{};
 		std::vector<VulkanTexture*> m_bloomResults{};
 
-		std::vector<VkDescriptorImageInfo> m_imageInfo;
-		std::vector<VkWriteDescriptorSet> m_writes;
-
 
 		VkPipeline m_debugTiledDeferredPresentSwapchain{};
 
@@ -18,6 +18,7 @@ namespace RenderCore
 
 		for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
 			auto& lv_swapchainTexture = lv_vkResManager.RetrieveGpuTexture("Swapchain", i);
+			std::lock_guard lv_lock{ lv_vkResManager.GetMainQueueMutex() };
 			transitionImageLayout(m_vulkanRenderContext.GetContextCreator().m_vkDev
 									, lv_swapchainTexture.image.image, lv_swapchainTexture.format, lv_swapchainTexture.Layout
 									, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
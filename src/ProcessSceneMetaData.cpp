@@ -35,6 +35,40 @@ namespace SceneMetaData
               .m_scale = (float)lv_document[i]["scale"].GetDouble(),
               .m_mergeInstances = lv_document[i]["merge_instances"].GetBool()
             });
+
+            auto& lv_sceneMetaData = m_scenesMetaData.back();
+
+            if (true == lv_document[i].HasMember("quantize_vertices")) {
+                lv_sceneMetaData.m_quantizeVertices = lv_document[i]["quantize_vertices"].GetBool();
+            }
+
+            if (true == lv_document[i].HasMember("quantized_positions")) {
+                lv_sceneMetaData.m_halfPrecisionPositions = (std::string{ "fp16" } == lv_document[i]["quantized_positions"].GetString());
+            }
+
+            if (true == lv_document[i].HasMember("octahedral_bits")) {
+                lv_sceneMetaData.m_octahedralBits = lv_document[i]["octahedral_bits"].GetUint();
+            }
+
+            if (true == lv_document[i].HasMember("compress_mesh")) {
+                lv_sceneMetaData.m_compressMesh = lv_document[i]["compress_mesh"].GetBool();
+            }
+
+            if (true == lv_document[i].HasMember("conversion_threads")) {
+                lv_sceneMetaData.m_conversionThreads = lv_document[i]["conversion_threads"].GetUint();
+            }
+
+            if (true == lv_document[i].HasMember("benchmark_conversion_threads")) {
+                lv_sceneMetaData.m_benchmarkConversionThreads = lv_document[i]["benchmark_conversion_threads"].GetBool();
+            }
+
+            if (true == lv_document[i].HasMember("max_merged_vertices")) {
+                lv_sceneMetaData.m_maxMergedVertices = lv_document[i]["max_merged_vertices"].GetUint();
+            }
+
+            if (true == lv_document[i].HasMember("merge_cell_size")) {
+                lv_sceneMetaData.m_mergeCellSize = (float)lv_document[i]["merge_cell_size"].GetDouble();
+            }
         }
 	}
 }
\ No newline at end of file
@@ -3,10 +3,23 @@
 
 #include "Renderbase.hpp"
 #include "ErrorCheck.hpp"
+#include <chrono>
 #include <format>
 
 namespace RenderCore
 {
+	namespace
+	{
+		bool IsBufferDescriptor(VkDescriptorType l_descriptorType)
+		{
+			return (VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER == l_descriptorType ||
+				VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC == l_descriptorType ||
+				VK_DESCRIPTOR_TYPE_STORAGE_BUFFER == l_descriptorType ||
+				VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC == l_descriptorType);
+		}
+	}
+
+
 	VkDescriptorPool Renderbase::m_descriptorPool = VK_NULL_HANDLE;
 
 	Renderbase::Renderbase(VulkanEngine::VulkanRenderContext& ctx_) : 
@@ -60,7 +73,7 @@ namespace RenderCore
 
 
 	void Renderbase::GeneratePipelineFromSpirvBinaries(
-		const std::string& l_spirvFilePath)
+		const std::string& l_spirvFilePath, bool l_dynamicUniformBuffers)
 	{
 		using namespace ErrorCheck;
 		auto& lv_vkResManager = m_vulkanRenderContext.GetResourceManager();
@@ -69,10 +82,26 @@ namespace RenderCore
 		VulkanEngine::SpirvPipelineGenerator lv_pipelineGenerator(l_spirvFilePath);
 		const auto& lv_vkSetLayoutDatas = lv_pipelineGenerator.GenerateDescriptorSetLayouts();
 
+		auto lv_setLayoutCreateInfo = lv_vkSetLayoutDatas[0].m_setLayoutCreateInfo;
+		auto lv_bindings = lv_vkSetLayoutDatas[0].m_bindings;
+
+		if (true == l_dynamicUniformBuffers) {
+
+			for (auto& l_binding : lv_bindings) {
+				if (VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER == l_binding.descriptorType) {
+					l_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+					m_dynamicUniformOffsets.push_back(0);
+				}
+			}
+
+			lv_setLayoutCreateInfo.pBindings = lv_bindings.data();
+		}
 
-		VULKAN_CHECK(vkCreateDescriptorSetLayout(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device,
-			&lv_vkSetLayoutDatas[0].m_setLayoutCreateInfo, nullptr, &m_descriptorSetLayout));
-		lv_vkResManager.AddVulkanDescriptorSetLayout(m_descriptorSetLayout);
+
+		//Renderers reflecting the same SPIR-V end up with the same layouts
+		std::string lv_descriptorSetLayoutName{ l_spirvFilePath + " descriptorSetLayout" };
+		m_descriptorSetLayout = lv_vkResManager.CreateDescriptorSetLayout(lv_setLayoutCreateInfo,
+			lv_descriptorSetLayoutName.c_str());
 
 
 		for (size_t i = 0; i < lv_totalNumSwapChains; ++i) {
@@ -80,6 +109,35 @@ namespace RenderCore
 				std::format(" descriptorSet {} ", i).c_str()));
 		}
 
+		//Every set is updated from one run of DescriptorSlots, laid out in reflected binding order
+		std::vector<VkDescriptorUpdateTemplateEntry> lv_templateEntries{};
+		m_descriptorBindings = lv_bindings;
+		m_firstDescriptorSlots.clear();
+		m_totalNumDescriptorSlotsPerSet = 0;
+
+		for (auto& l_binding : m_descriptorBindings) {
+
+			VkDescriptorUpdateTemplateEntry lv_entry{};
+			lv_entry.dstBinding = l_binding.binding;
+			lv_entry.dstArrayElement = 0;
+			lv_entry.descriptorCount = l_binding.descriptorCount;
+			lv_entry.descriptorType = l_binding.descriptorType;
+			lv_entry.offset = m_totalNumDescriptorSlotsPerSet * sizeof(DescriptorSlot);
+			lv_entry.stride = sizeof(DescriptorSlot);
+			lv_templateEntries.push_back(lv_entry);
+
+			m_firstDescriptorSlots.push_back(m_totalNumDescriptorSlotsPerSet);
+			m_totalNumDescriptorSlotsPerSet += l_binding.descriptorCount;
+		}
+
+		m_descriptorSlots.assign(m_totalNumDescriptorSlotsPerSet * m_descriptorSets.size(), DescriptorSlot{});
+
+		if (false == lv_templateEntries.empty()) {
+			std::string lv_updateTemplateName{ l_spirvFilePath + " descriptorUpdateTemplate" };
+			m_descriptorUpdateTemplate = lv_vkResManager.CreateDescriptorUpdateTemplate(m_descriptorSetLayout,
+				lv_templateEntries, lv_updateTemplateName.c_str());
+		}
+
 		std::string lv_pipelineLayoutName{l_spirvFilePath + " pipelineLayout"};
 		m_pipelineLayout = lv_vkResManager.CreatePipelineLayout
 		(m_descriptorSetLayout, lv_pipelineLayoutName.c_str());
@@ -95,7 +153,7 @@ namespace RenderCore
 		auto& lv_vulkanResourceManager = l_renderContext.GetResourceManager();
 		auto lv_totalNumSwapchain = l_renderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
 
-		std::array<VkDescriptorPoolSize, 3> lv_poolSizes{};
+		std::array<VkDescriptorPoolSize, 4> lv_poolSizes{};
 		lv_poolSizes[0].descriptorCount = lv_totalNumSwapchain * 64;
 		lv_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
 
@@ -105,6 +163,9 @@ namespace RenderCore
 		lv_poolSizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 		lv_poolSizes[2].descriptorCount = lv_totalNumSwapchain * 256;
 
+		lv_poolSizes[3].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		lv_poolSizes[3].descriptorCount = lv_totalNumSwapchain * 32;
+
 		VkDescriptorPoolCreateInfo lv_poolCreateInfo{};
 		lv_poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 		lv_poolCreateInfo.maxSets = 32 * lv_totalNumSwapchain;
@@ -131,8 +192,8 @@ namespace RenderCore
 			CreatePipelineLayoutWithPush(m_descriptorSetLayout," Pipeline-Layout-Renderbase ",
 				l_vtxConstSize, l_fragConstSize);
 
-		m_graphicsPipeline = m_vulkanRenderContext.GetResourceManager().CreateGraphicsPipeline(m_renderPass,
-			m_pipelineLayout, l_shaders, " Graphics-Pipeline-RenderBase " ,l_pInfo);
+		m_vulkanRenderContext.GetResourceManager().RequestGraphicsPipeline(m_renderPass,
+			m_pipelineLayout, l_shaders, " Graphics-Pipeline-RenderBase " ,l_pInfo, m_graphicsPipeline);
 	}
 
 
@@ -173,8 +234,8 @@ namespace RenderCore
 	void Renderbase::BeginRenderPass(VkRenderPass l_rp, VkFramebuffer l_fb,
 		VkCommandBuffer l_commandBuffer, size_t l_currentImage, size_t l_totalNumClearValues, uint32_t l_width, uint32_t l_height)
 	{
-		std::vector<VkClearValue> lv_clearValues;
-		lv_clearValues.resize(l_totalNumClearValues);
+		VkClearValue* lv_clearValues = m_vulkanRenderContext.GetFrameArena((uint32_t)l_currentImage)
+			.Allocate<VkClearValue>(l_totalNumClearValues);
 
 		if (1 == l_totalNumClearValues) 
 		{
@@ -196,16 +257,156 @@ namespace RenderCore
 
 		m_vulkanRenderContext.BeginRenderPass(l_commandBuffer, l_rp, l_currentImage, rect,
 			l_fb,
-			l_totalNumClearValues,
-			lv_clearValues.data());
+			(uint32_t)l_totalNumClearValues,
+			lv_clearValues);
 
 
 
 		vkCmdBindPipeline(l_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline);
 
 		if (0 != m_descriptorSets.size()) {
-			vkCmdBindDescriptorSets(l_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1,
-				&m_descriptorSets[l_currentImage], 0, nullptr);
+			BindDescriptorSet(l_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, l_currentImage);
 		}
 	}
+
+
+	void Renderbase::BindDescriptorSet(VkCommandBuffer l_commandBuffer, VkPipelineBindPoint l_bindPoint, size_t l_currentImage)
+	{
+		vkCmdBindDescriptorSets(l_commandBuffer, l_bindPoint, m_pipelineLayout, 0, 1,
+			&m_descriptorSets[l_currentImage], (uint32_t)m_dynamicUniformOffsets.size(), m_dynamicUniformOffsets.data());
+	}
+
+
+	DescriptorSlot& Renderbase::GetDescriptorSlot(size_t l_setIndex, uint32_t l_binding, uint32_t l_arrayElement)
+	{
+		using namespace ErrorCheck;
+
+		for (size_t i = 0; i < m_descriptorBindings.size(); ++i) {
+			if (l_binding == m_descriptorBindings[i].binding && l_arrayElement < m_descriptorBindings[i].descriptorCount) {
+				return m_descriptorSlots[l_setIndex * m_totalNumDescriptorSlotsPerSet + m_firstDescriptorSlots[i] + l_arrayElement];
+			}
+		}
+
+		printf("Binding %u, array element %u is not part of the reflected descriptor set layout.\n", l_binding, l_arrayElement);
+		PRINT_EXIT("Descriptor write does not match the layout. Exitting....\n");
+	}
+
+
+	void Renderbase::WriteBufferDescriptor(size_t l_setIndex, uint32_t l_binding, const VkDescriptorBufferInfo& l_bufferInfo,
+		uint32_t l_arrayElement)
+	{
+		GetDescriptorSlot(l_setIndex, l_binding, l_arrayElement).m_bufferInfo = l_bufferInfo;
+	}
+
+
+	void Renderbase::WriteImageDescriptor(size_t l_setIndex, uint32_t l_binding, const VkDescriptorImageInfo& l_imageInfo,
+		uint32_t l_arrayElement)
+	{
+		GetDescriptorSlot(l_setIndex, l_binding, l_arrayElement).m_imageInfo = l_imageInfo;
+	}
+
+
+	void Renderbase::FlushDescriptorWrites()
+	{
+		using namespace ErrorCheck;
+
+		if (VK_NULL_HANDLE == m_descriptorUpdateTemplate) {
+			return;
+		}
+
+		//A template writes every descriptor of the set, so one that was never filled would be written as a null handle
+		for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
+			for (size_t j = 0; j < m_descriptorBindings.size(); ++j) {
+				for (uint32_t h = 0; h < m_descriptorBindings[j].descriptorCount; ++h) {
+
+					const auto& lv_slot = m_descriptorSlots[i * m_totalNumDescriptorSlotsPerSet + m_firstDescriptorSlots[j] + h];
+
+					const bool lv_isBuffer = IsBufferDescriptor(m_descriptorBindings[j].descriptorType);
+
+					if ((true == lv_isBuffer && VK_NULL_HANDLE == lv_slot.m_bufferInfo.buffer) ||
+						(false == lv_isBuffer && VK_NULL_HANDLE == lv_slot.m_imageInfo.imageView)) {
+						printf("Binding %u, array element %u of descriptor set %zu was never written.\n",
+							m_descriptorBindings[j].binding, h, i);
+						PRINT_EXIT("Incomplete descriptor set update. Exitting....\n");
+					}
+				}
+			}
+		}
+
+		const auto lv_startTime = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
+			vkUpdateDescriptorSetWithTemplate(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device, m_descriptorSets[i],
+				m_descriptorUpdateTemplate, &m_descriptorSlots[i * m_totalNumDescriptorSlotsPerSet]);
+		}
+
+		const double lv_updateMilliseconds = std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - lv_startTime).count();
+
+		m_vulkanRenderContext.GetResourceManager().RecordDescriptorUpdate((uint32_t)m_descriptorSets.size(),
+			(uint32_t)m_descriptorSlots.size(), lv_updateMilliseconds);
+	}
+
+
+	DescriptorUpdateTimings Renderbase::BenchmarkDescriptorUpdates(uint32_t l_totalNumRounds)
+	{
+		DescriptorUpdateTimings lv_timings{};
+
+		if (VK_NULL_HANDLE == m_descriptorUpdateTemplate) {
+			return lv_timings;
+		}
+
+		auto lv_device = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device;
+		lv_timings.m_totalNumSetUpdates = l_totalNumRounds * (uint32_t)m_descriptorSets.size();
+
+		auto lv_startTime = std::chrono::steady_clock::now();
+
+		for (uint32_t h = 0; h < l_totalNumRounds; ++h) {
+			for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
+				vkUpdateDescriptorSetWithTemplate(lv_device, m_descriptorSets[i], m_descriptorUpdateTemplate,
+					&m_descriptorSlots[i * m_totalNumDescriptorSlotsPerSet]);
+			}
+		}
+
+		lv_timings.m_templateMilliseconds = std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - lv_startTime).count();
+
+		//The writes are rebuilt every round, renderers filled their VkWriteDescriptorSet arrays on every update as well
+		std::vector<VkWriteDescriptorSet> lv_writes{};
+		lv_writes.reserve(m_descriptorSets.size() * m_descriptorBindings.size());
+
+		lv_startTime = std::chrono::steady_clock::now();
+
+		for (uint32_t h = 0; h < l_totalNumRounds; ++h) {
+
+			lv_writes.clear();
+
+			for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
+				for (size_t j = 0; j < m_descriptorBindings.size(); ++j) {
+
+					const auto& lv_firstSlot = m_descriptorSlots[i * m_totalNumDescriptorSlotsPerSet + m_firstDescriptorSlots[j]];
+					const bool lv_isBuffer = IsBufferDescriptor(m_descriptorBindings[j].descriptorType);
+
+					lv_writes.push_back(VkWriteDescriptorSet{
+						.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+						.pNext = nullptr,
+						.dstSet = m_descriptorSets[i],
+						.dstBinding = m_descriptorBindings[j].binding,
+						.dstArrayElement = 0,
+						.descriptorCount = m_descriptorBindings[j].descriptorCount,
+						.descriptorType = m_descriptorBindings[j].descriptorType,
+						.pImageInfo = (true == lv_isBuffer) ? nullptr : &lv_firstSlot.m_imageInfo,
+						.pBufferInfo = (true == lv_isBuffer) ? &lv_firstSlot.m_bufferInfo : nullptr,
+						.pTexelBufferView = nullptr });
+				}
+			}
+
+			vkUpdateDescriptorSets(lv_device, (uint32_t)lv_writes.size(), lv_writes.data(), 0, nullptr);
+		}
+
+		lv_timings.m_writeMilliseconds = std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - lv_startTime).count();
+
+		return lv_timings;
+	}
 }
\ No newline at end of file
@@ -19,6 +19,23 @@ namespace RenderCore
 
 {
 
+	//Update data of one descriptor, the update template of a renderer reads one slot per descriptor
+	union DescriptorSlot
+	{
+		VkDescriptorImageInfo m_imageInfo;
+		VkDescriptorBufferInfo m_bufferInfo;
+	};
+
+	//Both infos have the same size, so the slots of an arrayed binding also work as its pImageInfo/pBufferInfo array
+	static_assert(sizeof(DescriptorSlot) == sizeof(VkDescriptorImageInfo) && sizeof(DescriptorSlot) == sizeof(VkDescriptorBufferInfo));
+
+	struct DescriptorUpdateTimings
+	{
+		uint32_t m_totalNumSetUpdates{ 0 };
+		double m_templateMilliseconds{ 0. };
+		double m_writeMilliseconds{ 0. };
+	};
+
 	class Renderbase
 	{
 	public:
@@ -56,6 +73,10 @@ namespace RenderCore
 
 		void SetRenderPassAndFrameBuffer(const std::string& l_rendererName);
 
+		//Rewrites every set l_totalNumRounds times through the update template and as many times through
+		//vkUpdateDescriptorSets with the same descriptors. None of the sets may be in use by the GPU.
+		DescriptorUpdateTimings BenchmarkDescriptorUpdates(uint32_t l_totalNumRounds);
+
 
 		virtual ~Renderbase() = default;
 
@@ -65,8 +86,22 @@ namespace RenderCore
 			Renderbase* l_renderpass);
 
 
+		//With l_dynamicUniformBuffers every uniform buffer binding becomes UNIFORM_BUFFER_DYNAMIC and is meant to point
+		//into the uniform frame arena, m_dynamicUniformOffsets then gets one entry per such binding.
 		void GeneratePipelineFromSpirvBinaries(
-			const std::string& l_spirvFilePath);
+			const std::string& l_spirvFilePath, bool l_dynamicUniformBuffers = false);
+
+		//Binds set 0 of the current image together with m_dynamicUniformOffsets
+		void BindDescriptorSet(VkCommandBuffer l_commandBuffer, VkPipelineBindPoint l_bindPoint, size_t l_currentImage);
+
+		//Only fill the update data of set l_setIndex, FlushDescriptorWrites() then writes every set of the renderer
+		//through the update template generated from the reflected layout.
+		//Each descriptor of the layout has to be written before the first flush, array elements included.
+		void WriteBufferDescriptor(size_t l_setIndex, uint32_t l_binding, const VkDescriptorBufferInfo& l_bufferInfo,
+			uint32_t l_arrayElement = 0);
+		void WriteImageDescriptor(size_t l_setIndex, uint32_t l_binding, const VkDescriptorImageInfo& l_imageInfo,
+			uint32_t l_arrayElement = 0);
+		void FlushDescriptorWrites();
 
 
 		//virtual void CreateRenderPass() = 0;
@@ -82,8 +117,22 @@ namespace RenderCore
 		VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE;
 		static VkDescriptorPool m_descriptorPool;
 		std::vector<VkDescriptorSet> m_descriptorSets;
+
+		//Generated by GeneratePipelineFromSpirvBinaries(), every set owns a run of m_totalNumDescriptorSlotsPerSet
+		//slots in m_descriptorSlots and each reflected binding starts at its entry of m_firstDescriptorSlots
+		VkDescriptorUpdateTemplate m_descriptorUpdateTemplate = VK_NULL_HANDLE;
+		std::vector<VkDescriptorSetLayoutBinding> m_descriptorBindings{};
+		std::vector<uint32_t> m_firstDescriptorSlots{};
+		uint32_t m_totalNumDescriptorSlotsPerSet{ 0 };
+		std::vector<DescriptorSlot> m_descriptorSlots{};
+
+		//Offsets into the uniform frame arena in binding order, written by UpdateBuffers() every frame
+		std::vector<uint32_t> m_dynamicUniformOffsets{};
 		std::vector<uint32_t> m_framebufferHandles;
-		std::vector<VulkanBuffer> m_uniformBuffers{};
+
+	private:
+
+		DescriptorSlot& GetDescriptorSlot(size_t l_setIndex, uint32_t l_binding, uint32_t l_arrayElement);
 
 	};
 
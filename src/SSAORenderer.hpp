@@ -54,12 +54,12 @@ namespace RenderCore
 	private:
 
 
-		uint32_t m_gpuOffsetsHandle;
-		uint32_t m_gpuRandomRotationsTextureHandle;
-		uint32_t m_gpuUniformBufferHandle;
+		BufferHandle m_gpuOffsetsHandle;
+		TextureHandle m_gpuRandomRotationsTextureHandle;
 
 
 		UniformBufferMatrices m_uniformCpu;
+		std::vector<VulkanTexture*> m_occlusionTextures;
 
 	};
 
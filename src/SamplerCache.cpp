@@ -0,0 +1,139 @@
+
+
+
+
+#include "SamplerCache.hpp"
+#include "ErrorCheck.hpp"
+#include <bit>
+#include <format>
+
+
+namespace RenderCore
+{
+
+	namespace
+	{
+		void HashCombine(size_t& l_seed, uint64_t l_value)
+		{
+			l_seed ^= std::hash<uint64_t>{}(l_value) + 0x9e3779b97f4a7c15ULL + (l_seed << 6) + (l_seed >> 2);
+		}
+	}
+
+
+	bool SamplerCache::SamplerKey::operator==(const SamplerKey& l_other) const
+	{
+		const auto& lv_a = m_createInfo;
+		const auto& lv_b = l_other.m_createInfo;
+
+		return lv_a.flags == lv_b.flags && lv_a.magFilter == lv_b.magFilter && lv_a.minFilter == lv_b.minFilter &&
+			lv_a.mipmapMode == lv_b.mipmapMode && lv_a.addressModeU == lv_b.addressModeU &&
+			lv_a.addressModeV == lv_b.addressModeV && lv_a.addressModeW == lv_b.addressModeW &&
+			lv_a.mipLodBias == lv_b.mipLodBias && lv_a.anisotropyEnable == lv_b.anisotropyEnable &&
+			lv_a.maxAnisotropy == lv_b.maxAnisotropy && lv_a.compareEnable == lv_b.compareEnable &&
+			lv_a.compareOp == lv_b.compareOp && lv_a.minLod == lv_b.minLod && lv_a.maxLod == lv_b.maxLod &&
+			lv_a.borderColor == lv_b.borderColor && lv_a.unnormalizedCoordinates == lv_b.unnormalizedCoordinates;
+	}
+
+
+	size_t SamplerCache::SamplerKeyHash::operator()(const SamplerKey& l_key) const noexcept
+	{
+		const auto& lv_info = l_key.m_createInfo;
+		size_t lv_seed{ 0 };
+
+		HashCombine(lv_seed, lv_info.flags);
+		HashCombine(lv_seed, (uint64_t)lv_info.magFilter << 32 | lv_info.minFilter);
+		HashCombine(lv_seed, lv_info.mipmapMode);
+		HashCombine(lv_seed, (uint64_t)lv_info.addressModeU << 32 | lv_info.addressModeV);
+		HashCombine(lv_seed, lv_info.addressModeW);
+		HashCombine(lv_seed, std::bit_cast<uint32_t>(lv_info.mipLodBias));
+		HashCombine(lv_seed, (uint64_t)lv_info.anisotropyEnable << 32 | std::bit_cast<uint32_t>(lv_info.maxAnisotropy));
+		HashCombine(lv_seed, (uint64_t)lv_info.compareEnable << 32 | lv_info.compareOp);
+		HashCombine(lv_seed, (uint64_t)std::bit_cast<uint32_t>(lv_info.minLod) << 32 | std::bit_cast<uint32_t>(lv_info.maxLod));
+		HashCombine(lv_seed, (uint64_t)lv_info.borderColor << 32 | lv_info.unnormalizedCoordinates);
+
+		return lv_seed;
+	}
+
+
+	SamplerCache::SamplerCache(VulkanRenderDevice& l_renderDevice)
+		:m_renderDevice(l_renderDevice)
+	{
+		m_samplers.reserve(16);
+		m_ownedSamplers.reserve(16);
+	}
+
+
+	SamplerCache::~SamplerCache()
+	{
+		for (auto& l_sampler : m_samplers) {
+			vkDestroySampler(m_renderDevice.m_device, l_sampler.second, nullptr);
+		}
+	}
+
+
+	VkSampler SamplerCache::Acquire(const VkSamplerCreateInfo& l_samplerCreateInfo)
+	{
+		using namespace ErrorCheck;
+
+		if (nullptr != l_samplerCreateInfo.pNext) {
+			PRINT_EXIT("\nSampler cache does not support pNext chains in VkSamplerCreateInfo.\n");
+		}
+
+		std::lock_guard lv_lock{ m_mutex };
+
+		++m_totalNumRequests;
+
+		SamplerKey lv_key{ .m_createInfo = l_samplerCreateInfo };
+
+		//maxAnisotropy is ignored when anisotropy is off, it should not split otherwise identical samplers
+		if (VK_FALSE == lv_key.m_createInfo.anisotropyEnable) {
+			lv_key.m_createInfo.maxAnisotropy = 1.f;
+		}
+
+		auto lv_result = m_samplers.find(lv_key);
+
+		if (m_samplers.end() != lv_result) {
+			return lv_result->second;
+		}
+
+		VkSampler lv_sampler{ VK_NULL_HANDLE };
+		VULKAN_CHECK(vkCreateSampler(m_renderDevice.m_device, &lv_key.m_createInfo, nullptr, &lv_sampler));
+
+		const std::string lv_samplerName{ std::format("Cached-Sampler {}", m_samplers.size()) };
+
+		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
+		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_sampler);
+		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_SAMPLER;
+		lv_objectNameInfo.pNext = nullptr;
+		lv_objectNameInfo.pObjectName = lv_samplerName.c_str();
+		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+
+		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+
+		m_samplers.emplace(lv_key, lv_sampler);
+		m_ownedSamplers.insert(lv_sampler);
+
+		return lv_sampler;
+	}
+
+
+	bool SamplerCache::Owns(VkSampler l_sampler) const
+	{
+		std::lock_guard lv_lock{ m_mutex };
+		return m_ownedSamplers.end() != m_ownedSamplers.find(l_sampler);
+	}
+
+
+	uint32_t SamplerCache::GetTotalNumSamplers() const
+	{
+		std::lock_guard lv_lock{ m_mutex };
+		return (uint32_t)m_samplers.size();
+	}
+
+	uint32_t SamplerCache::GetTotalNumRequests() const
+	{
+		std::lock_guard lv_lock{ m_mutex };
+		return m_totalNumRequests;
+	}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+
+
+#include "UtilsVulkan.h"
+#include <cinttypes>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+
+
+namespace RenderCore
+{
+
+	//Hands out one shared VkSampler per distinct VkSamplerCreateInfo. The cache owns every sampler it
+	//returns, so textures holding one of them must not destroy it themselves.
+	//pNext chains are not part of the key and are rejected. Acquire() can be called from several threads.
+	class SamplerCache final
+	{
+	public:
+
+		explicit SamplerCache(VulkanRenderDevice& l_renderDevice);
+		~SamplerCache();
+
+		SamplerCache(const SamplerCache&) = delete;
+		SamplerCache& operator=(const SamplerCache&) = delete;
+
+		VkSampler Acquire(const VkSamplerCreateInfo& l_samplerCreateInfo);
+
+		bool Owns(VkSampler l_sampler) const;
+
+		uint32_t GetTotalNumSamplers() const;
+		uint32_t GetTotalNumRequests() const;
+
+	private:
+
+		struct SamplerKey
+		{
+			VkSamplerCreateInfo m_createInfo;
+
+			bool operator==(const SamplerKey& l_other) const;
+		};
+
+		struct SamplerKeyHash
+		{
+			size_t operator()(const SamplerKey& l_key) const noexcept;
+		};
+
+
+		VulkanRenderDevice& m_renderDevice;
+
+		mutable std::mutex m_mutex{};
+		std::unordered_map<SamplerKey, VkSampler, SamplerKeyHash> m_samplers{};
+		std::unordered_set<VkSampler> m_ownedSamplers{};
+
+		uint32_t m_totalNumRequests{ 0 };
+	};
+
+}
@@ -53,6 +53,17 @@ namespace SceneConverter
 	}
 
 
+	uint32_t SceneConverter::AddMeshNode(const int l_parent, const uint32_t l_meshIndex, const uint32_t l_materialID)
+	{
+		auto lv_newNodeIndex = AddNodeToScene(m_scene.m_hierarchies[l_parent].m_level + 1, l_parent);
+
+		m_scene.m_meshes[lv_newNodeIndex] = l_meshIndex;
+		m_scene.m_materialIDs[lv_newNodeIndex] = l_materialID;
+
+		return lv_newNodeIndex;
+	}
+
+
 	void SceneConverter::ConverteAssimpMatrixToGlmMatrix(const aiMatrix4x4& l_assimpMatrix,
 		glm::mat4& l_glmMatrix)
 	{
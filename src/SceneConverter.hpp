@@ -17,6 +17,9 @@ namespace SceneConverter
 
 		Scene& GetScene() { return m_scene; }
 
+		//Appends a child of l_parent that draws l_meshIndex, used for meshes created after the traversal
+		uint32_t AddMeshNode(const int l_parent, const uint32_t l_meshIndex, const uint32_t l_materialID);
+
 	private:
 
 		uint32_t AddNodeToScene(const uint32_t l_level, const int l_parent);
@@ -32,6 +32,24 @@ namespace SceneMetaData
 		std::string m_outputInstanceData;
 
 		float m_scale;
+
+		//Merges the static meshes that share a material into batches of at most m_maxMergedVertices vertices
+		//(see MeshMerging.hpp). Optional cell size in scaled scene units, 0 merges by material alone.
 		bool m_mergeInstances;
+		uint32_t m_maxMergedVertices{ 65536 };
+		float m_mergeCellSize{ 0.f };
+
+		//Optional, packs the vertices into 16 bytes instead of 48 (see VertexQuantization.hpp)
+		bool m_quantizeVertices{ false };
+		bool m_halfPrecisionPositions{ false };
+		uint32_t m_octahedralBits{ 10 };
+
+		//Optional, stores the mesh file with the meshoptimizer vertex and index codecs
+		bool m_compressMesh{ false };
+
+		//Optional, threads converting the meshes (0 uses the hardware concurrency). With the benchmark on,
+		//the meshes are converted once per thread count from 1 to that number and the times are printed.
+		uint32_t m_conversionThreads{ 0 };
+		bool m_benchmarkConversionThreads{ false };
 	};
 }
\ No newline at end of file
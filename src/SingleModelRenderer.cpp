@@ -83,9 +83,9 @@ namespace RenderCore
 		lv_pipelineInfo.m_vertexInputBindingDescription.push_back(lv_vtxBindingDesc1);
 		lv_pipelineInfo.m_vertexInputAttribDescription.push_back(lv_vtxAttribDesc10);
 
-		m_graphicsPipeline = lv_vkResManager.CreateGraphicsPipeline(m_renderPass, m_pipelineLayout,
+		lv_vkResManager.RequestGraphicsPipeline(m_renderPass, m_pipelineLayout,
 			{ l_vtxShader, l_fragShader }, "SingleModelRenderer",
-			lv_pipelineInfo);
+			lv_pipelineInfo, m_graphicsPipeline);
 
 	}
 
@@ -163,50 +163,18 @@ namespace RenderCore
 	void SingleModelRenderer::UpdateDescriptorSets()
 	{
 		auto& lv_vkResManager = m_vulkanRenderContext.GetResourceManager();
-		auto lv_totalNumSwapchains = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
-
-
-		std::array<VkDescriptorBufferInfo, 2> lv_bufferInfo{};
-
-		lv_bufferInfo[0].buffer = lv_vkResManager.RetrieveGpuBuffer(m_uniformBufferGpuHandle).buffer;
-		lv_bufferInfo[0].offset = 0;
-		lv_bufferInfo[0].range = VK_WHOLE_SIZE;
-
-		lv_bufferInfo[1].buffer = lv_vkResManager.RetrieveGpuBuffer(m_lightUniformBufferGpuHandle).buffer;
-		lv_bufferInfo[1].offset = 0;
-		lv_bufferInfo[1].range = VK_WHOLE_SIZE;
-
-		std::vector<VkWriteDescriptorSet> lv_writes{};
-		lv_writes.resize(2*lv_totalNumSwapchains);
-
-		for (size_t i = 0, j = 0; i < lv_writes.size(); i+=2, ++j) {
-			lv_writes[i].descriptorCount = 1;
-			lv_writes[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			lv_writes[i].dstArrayElement = 0;
-			lv_writes[i].dstBinding = 0;
-			lv_writes[i].dstSet = m_descriptorSets[j];
-			lv_writes[i].pBufferInfo = &lv_bufferInfo[0];
-			lv_writes[i].pImageInfo = nullptr;
-			lv_writes[i].pNext = nullptr;
-			lv_writes[i].pTexelBufferView = nullptr;
-			lv_writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-
-			lv_writes[i+1].descriptorCount = 1;
-			lv_writes[i+1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			lv_writes[i+1].dstArrayElement = 0;
-			lv_writes[i+1].dstBinding = 1;
-			lv_writes[i+1].dstSet = m_descriptorSets[j];
-			lv_writes[i+1].pBufferInfo = &lv_bufferInfo[1];
-			lv_writes[i+1].pImageInfo = nullptr;
-			lv_writes[i+1].pNext = nullptr;
-			lv_writes[i+1].pTexelBufferView = nullptr;
-			lv_writes[i+1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		}
 
+		const VkDescriptorBufferInfo lv_uniformBufferInfo{ lv_vkResManager.RetrieveGpuBuffer(m_uniformBufferGpuHandle).buffer,
+			0, VK_WHOLE_SIZE };
+		const VkDescriptorBufferInfo lv_lightUniformBufferInfo{ lv_vkResManager.RetrieveGpuBuffer(m_lightUniformBufferGpuHandle).buffer,
+			0, VK_WHOLE_SIZE };
 
-		vkUpdateDescriptorSets(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device, lv_writes.size(), lv_writes.data(), 0, nullptr );
+		for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
+			WriteBufferDescriptor(i, 0, lv_uniformBufferInfo);
+			WriteBufferDescriptor(i, 1, lv_lightUniformBufferInfo);
+		}
 
+		FlushDescriptorWrites();
 	}
 
 }
\ No newline at end of file
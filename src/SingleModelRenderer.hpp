@@ -50,12 +50,12 @@ namespace RenderCore
 		void SetLightIntensity(const float l_intensity);
 
 	private:
-		uint32_t m_uniformBufferGpuHandle;
-		uint32_t m_lightUniformBufferGpuHandle{};
+		BufferHandle m_uniformBufferGpuHandle;
+		BufferHandle m_lightUniformBufferGpuHandle{};
 		float m_lightIntensity{ 12000.f };
 
-		uint32_t m_vertexBufferGpuHandle;
-		uint32_t m_indexBufferGpuHandle;
+		BufferHandle m_vertexBufferGpuHandle;
+		BufferHandle m_indexBufferGpuHandle;
 		uint32_t m_indexCount;
 		std::vector<VulkanTexture*> m_colorOutputTextures;
 		std::vector<VulkanTexture*> m_depthTextures;
@@ -0,0 +1,111 @@
+
+
+
+
+#include "SpecializationConstants.hpp"
+#include <algorithm>
+#include <cstring>
+
+
+namespace RenderCore
+{
+
+	void SpecializationConstants::Set(uint32_t l_constantID, uint32_t l_value)
+	{
+		SetRawValue(l_constantID, l_value);
+	}
+
+
+	void SpecializationConstants::Set(uint32_t l_constantID, int32_t l_value)
+	{
+		SetRawValue(l_constantID, (uint32_t)l_value);
+	}
+
+
+	void SpecializationConstants::Set(uint32_t l_constantID, float l_value)
+	{
+		uint32_t lv_rawValue{ 0 };
+		memcpy(&lv_rawValue, &l_value, sizeof(float));
+
+		SetRawValue(l_constantID, lv_rawValue);
+	}
+
+
+	void SpecializationConstants::Set(uint32_t l_constantID, bool l_value)
+	{
+		SetRawValue(l_constantID, (true == l_value) ? VK_TRUE : VK_FALSE);
+	}
+
+
+	void SpecializationConstants::Merge(const SpecializationConstants& l_other)
+	{
+		for (size_t i = 0; i < l_other.m_mapEntries.size(); ++i) {
+			SetRawValue(l_other.m_mapEntries[i].constantID, l_other.m_values[i]);
+		}
+	}
+
+
+	bool SpecializationConstants::IsEmpty() const
+	{
+		return m_mapEntries.empty();
+	}
+
+
+	uint32_t SpecializationConstants::GetRawValue(uint32_t l_constantID, uint32_t l_defaultValue) const
+	{
+		for (size_t i = 0; i < m_mapEntries.size(); ++i) {
+			if (l_constantID == m_mapEntries[i].constantID) {
+				return m_values[i];
+			}
+		}
+
+		return l_defaultValue;
+	}
+
+
+	VkSpecializationInfo SpecializationConstants::GetSpecializationInfo() const
+	{
+		VkSpecializationInfo lv_specializationInfo{};
+		lv_specializationInfo.mapEntryCount = (uint32_t)m_mapEntries.size();
+		lv_specializationInfo.pMapEntries = m_mapEntries.data();
+		lv_specializationInfo.dataSize = m_values.size() * sizeof(uint32_t);
+		lv_specializationInfo.pData = m_values.data();
+
+		return lv_specializationInfo;
+	}
+
+
+	const std::vector<VkSpecializationMapEntry>& SpecializationConstants::GetMapEntries() const
+	{
+		return m_mapEntries;
+	}
+
+
+	const std::vector<uint32_t>& SpecializationConstants::GetValues() const
+	{
+		return m_values;
+	}
+
+
+	void SpecializationConstants::SetRawValue(uint32_t l_constantID, uint32_t l_rawValue)
+	{
+		auto lv_result = std::lower_bound(m_mapEntries.begin(), m_mapEntries.end(), l_constantID,
+			[](const VkSpecializationMapEntry& l_entry, uint32_t l_id) { return l_entry.constantID < l_id; });
+
+		const size_t lv_index = (size_t)(lv_result - m_mapEntries.begin());
+
+		if (m_mapEntries.end() != lv_result && l_constantID == lv_result->constantID) {
+			m_values[lv_index] = l_rawValue;
+			return;
+		}
+
+		m_mapEntries.insert(lv_result, VkSpecializationMapEntry{ l_constantID, 0, sizeof(uint32_t) });
+		m_values.insert(m_values.begin() + lv_index, l_rawValue);
+
+		//Values are packed in constant id order
+		for (size_t i = 0; i < m_mapEntries.size(); ++i) {
+			m_mapEntries[i].offset = (uint32_t)(i * sizeof(uint32_t));
+		}
+	}
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+
+
+#include "UtilsVulkan.h"
+#include <cinttypes>
+#include <vector>
+
+
+
+namespace RenderCore
+{
+
+	//Values for the layout(constant_id = N) constants of a shader permutation. Pipelines are cached by these values,
+	//so every distinct set of them gets its own pipeline. Constants that are never set keep the default of the shader.
+	//Every constant is 32 bits wide, bools are written as VkBool32.
+	class SpecializationConstants final
+	{
+	public:
+
+		void Set(uint32_t l_constantID, uint32_t l_value);
+		void Set(uint32_t l_constantID, int32_t l_value);
+		void Set(uint32_t l_constantID, float l_value);
+		void Set(uint32_t l_constantID, bool l_value);
+
+		//Later values win, used to let the frame graph override the defaults of a renderer
+		void Merge(const SpecializationConstants& l_other);
+
+		bool IsEmpty() const;
+
+		//Raw 32 bit value of l_constantID, l_defaultValue when it was never set
+		uint32_t GetRawValue(uint32_t l_constantID, uint32_t l_defaultValue) const;
+
+		//Points into this object, it has to stay alive and unchanged while the pipeline is created
+		VkSpecializationInfo GetSpecializationInfo() const;
+
+		//Sorted by constant id, so that equal permutations compare equal
+		const std::vector<VkSpecializationMapEntry>& GetMapEntries() const;
+		const std::vector<uint32_t>& GetValues() const;
+
+	private:
+
+		void SetRawValue(uint32_t l_constantID, uint32_t l_rawValue);
+
+
+		std::vector<VkSpecializationMapEntry> m_mapEntries{};
+		std::vector<uint32_t> m_values{};
+	};
+
+}
@@ -0,0 +1,366 @@
+
+
+
+
+#include "StagingRingBuffer.hpp"
+#include "ErrorCheck.hpp"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+
+namespace RenderCore
+{
+
+	StagingRingBuffer::StagingRingBuffer(VulkanRenderDevice& l_renderDevice, const VulkanBuffer& l_ringBuffer,
+		uint32_t l_totalNumBatches)
+		:m_renderDevice(l_renderDevice)
+	{
+		using namespace ErrorCheck;
+
+		if (nullptr == l_ringBuffer.ptr) {
+			PRINT_EXIT("\nStaging ring buffer has to be persistently mapped.\n");
+		}
+
+		m_buffer = l_ringBuffer.buffer;
+		m_mappedData = static_cast<uint8_t*>(l_ringBuffer.ptr);
+		m_capacityInBytes = l_ringBuffer.size & ~(m_allocationAlignment - 1);
+		m_maxChunkSizeInBytes = (m_capacityInBytes / 4) & ~(m_allocationAlignment - 1);
+
+		if (0 == m_maxChunkSizeInBytes) {
+			PRINT_EXIT("\nStaging ring buffer is too small.\n");
+		}
+
+		const VkCommandPoolCreateInfo lv_commandPoolCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+			.queueFamilyIndex = m_renderDevice.m_mainFamily
+		};
+
+		VULKAN_CHECK(vkCreateCommandPool(m_renderDevice.m_device, &lv_commandPoolCreateInfo, nullptr, &m_commandPool));
+
+		m_batches.resize(std::max(l_totalNumBatches, 2U));
+
+		for (auto& l_batch : m_batches) {
+
+			const VkCommandBufferAllocateInfo lv_allocateInfo{
+				.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+				.pNext = nullptr,
+				.commandPool = m_commandPool,
+				.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+				.commandBufferCount = 1
+			};
+
+			VULKAN_CHECK(vkAllocateCommandBuffers(m_renderDevice.m_device, &lv_allocateInfo, &l_batch.m_commandBuffer));
+
+			const VkFenceCreateInfo lv_fenceCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+				.pNext = nullptr,
+				.flags = 0
+			};
+
+			VULKAN_CHECK(vkCreateFence(m_renderDevice.m_device, &lv_fenceCreateInfo, nullptr, &l_batch.m_fence));
+		}
+
+
+		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
+		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(m_commandPool);
+		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_COMMAND_POOL;
+		lv_objectNameInfo.pNext = nullptr;
+		lv_objectNameInfo.pObjectName = "StagingRingBufferCommandPool";
+		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+
+		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+	}
+
+
+	StagingRingBuffer::~StagingRingBuffer()
+	{
+		FlushAndWait();
+
+		for (auto& l_batch : m_batches) {
+			vkDestroyFence(m_renderDevice.m_device, l_batch.m_fence, nullptr);
+		}
+
+		vkDestroyCommandPool(m_renderDevice.m_device, m_commandPool, nullptr);
+	}
+
+
+	bool StagingRingBuffer::TryAllocate(VkDeviceSize l_sizeInBytes, VkDeviceSize l_alignment, VkDeviceSize& l_offset)
+	{
+		//The offset inside the ring is what has to be aligned, the capacity is not a multiple of every alignment
+		const uint64_t lv_headOffsetInRing = m_headPosition % m_capacityInBytes;
+		const uint64_t lv_offsetInRing = ((lv_headOffsetInRing + l_alignment - 1) / l_alignment) * l_alignment;
+
+		uint64_t lv_startPosition = m_headPosition + (lv_offsetInRing - lv_headOffsetInRing);
+
+		//A range never wraps around the end of the ring, the leftover bytes at the end are skipped instead
+		if (lv_offsetInRing + l_sizeInBytes > m_capacityInBytes) {
+			lv_startPosition = m_headPosition + (m_capacityInBytes - lv_headOffsetInRing);
+		}
+
+		if (lv_startPosition + l_sizeInBytes - m_tailPosition > m_capacityInBytes) {
+			return false;
+		}
+
+		l_offset = lv_startPosition % m_capacityInBytes;
+		m_headPosition = lv_startPosition + l_sizeInBytes;
+
+		return true;
+	}
+
+
+	VkDeviceSize StagingRingBuffer::Allocate(VkDeviceSize l_sizeInBytes, VkDeviceSize l_alignment)
+	{
+		using namespace ErrorCheck;
+
+		VkDeviceSize lv_offset{};
+
+		while (false == TryAllocate(l_sizeInBytes, l_alignment, lv_offset)) {
+
+			ReclaimCompletedBatches();
+
+			if (true == TryAllocate(l_sizeInBytes, l_alignment, lv_offset)) {
+				break;
+			}
+
+			//The bytes staged by the batch being recorded can only be reclaimed once it is submitted
+			if (true == m_batches[m_currentBatchIndex].m_recording) {
+				Flush();
+				continue;
+			}
+
+			if (false == WaitForOldestBatch()) {
+				PRINT_EXIT("\nStaging ring buffer allocation cannot be satisfied.\n");
+			}
+		}
+
+		return lv_offset;
+	}
+
+
+	void StagingRingBuffer::UploadToBuffer(VkBuffer l_dstBuffer, VkDeviceSize l_dstOffset,
+		const void* l_data, VkDeviceSize l_sizeInBytes)
+	{
+		const uint8_t* lv_srcData = static_cast<const uint8_t*>(l_data);
+
+		for (VkDeviceSize lv_copiedBytes = 0; lv_copiedBytes < l_sizeInBytes;) {
+
+			const VkDeviceSize lv_chunkSize = std::min(l_sizeInBytes - lv_copiedBytes, m_maxChunkSizeInBytes);
+			const VkDeviceSize lv_ringOffset = Allocate(lv_chunkSize);
+
+			memcpy(m_mappedData + lv_ringOffset, lv_srcData + lv_copiedBytes, lv_chunkSize);
+
+			const VkBufferCopy lv_bufferCopy{
+				.srcOffset = lv_ringOffset,
+				.dstOffset = l_dstOffset + lv_copiedBytes,
+				.size = lv_chunkSize
+			};
+
+			vkCmdCopyBuffer(GetCommandBuffer(), m_buffer, l_dstBuffer, 1, &lv_bufferCopy);
+
+			lv_copiedBytes += lv_chunkSize;
+		}
+	}
+
+
+	void StagingRingBuffer::UploadToImage(VkImage l_dstImage, uint32_t l_width, uint32_t l_height,
+		uint32_t l_layerCount, uint32_t l_bytesPerTexel, const void* l_texels)
+	{
+		const uint8_t* lv_srcTexels = static_cast<const uint8_t*>(l_texels);
+
+		const VkDeviceSize lv_alignment = std::lcm(m_allocationAlignment, (VkDeviceSize)l_bytesPerTexel);
+		const VkDeviceSize lv_rowPitch = (VkDeviceSize)l_width * l_bytesPerTexel;
+		const VkDeviceSize lv_layerSize = lv_rowPitch * l_height;
+		const uint32_t lv_maxNumRowsPerChunk = (uint32_t)std::max<VkDeviceSize>(1, m_maxChunkSizeInBytes / lv_rowPitch);
+
+		for (uint32_t lv_layer = 0; lv_layer < l_layerCount; ++lv_layer) {
+			for (uint32_t lv_firstRow = 0; lv_firstRow < l_height;) {
+
+				const uint32_t lv_numRows = std::min(l_height - lv_firstRow, lv_maxNumRowsPerChunk);
+				const VkDeviceSize lv_chunkSize = lv_rowPitch * lv_numRows;
+				const VkDeviceSize lv_ringOffset = Allocate(lv_chunkSize, lv_alignment);
+
+				memcpy(m_mappedData + lv_ringOffset, lv_srcTexels + lv_layerSize * lv_layer + lv_rowPitch * lv_firstRow,
+					lv_chunkSize);
+
+				const VkBufferImageCopy lv_region{
+					.bufferOffset = lv_ringOffset,
+					.bufferRowLength = 0,
+					.bufferImageHeight = 0,
+					.imageSubresource = VkImageSubresourceLayers {
+						.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+						.mipLevel = 0,
+						.baseArrayLayer = lv_layer,
+						.layerCount = 1
+					},
+					.imageOffset = VkOffset3D {.x = 0, .y = (int32_t)lv_firstRow, .z = 0 },
+					.imageExtent = VkExtent3D {.width = l_width, .height = lv_numRows, .depth = 1 }
+				};
+
+				vkCmdCopyBufferToImage(GetCommandBuffer(), m_buffer, l_dstImage,
+					VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &lv_region);
+
+				lv_firstRow += lv_numRows;
+			}
+		}
+	}
+
+
+	VkCommandBuffer StagingRingBuffer::GetCommandBuffer()
+	{
+		using namespace ErrorCheck;
+
+		auto& lv_batch = m_batches[m_currentBatchIndex];
+
+		if (false == lv_batch.m_recording) {
+
+			const VkCommandBufferBeginInfo lv_beginInfo{
+				.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+				.pNext = nullptr,
+				.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+				.pInheritanceInfo = nullptr
+			};
+
+			VULKAN_CHECK(vkBeginCommandBuffer(lv_batch.m_commandBuffer, &lv_beginInfo));
+			lv_batch.m_recording = true;
+		}
+
+		return lv_batch.m_commandBuffer;
+	}
+
+
+	void StagingRingBuffer::Flush()
+	{
+		using namespace ErrorCheck;
+
+		ReclaimCompletedBatches();
+
+		auto& lv_batch = m_batches[m_currentBatchIndex];
+
+		if (false == lv_batch.m_recording) {
+			return;
+		}
+
+		//Later submissions on the queue read the uploaded data from any stage
+		const VkMemoryBarrier lv_memoryBarrier{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+			.pNext = nullptr,
+			.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT
+		};
+
+		vkCmdPipelineBarrier(lv_batch.m_commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			0, 1, &lv_memoryBarrier, 0, nullptr, 0, nullptr);
+
+		VULKAN_CHECK(vkEndCommandBuffer(lv_batch.m_commandBuffer));
+
+		const VkSubmitInfo lv_submitInfo{
+			.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+			.pNext = nullptr,
+			.waitSemaphoreCount = 0,
+			.pWaitSemaphores = nullptr,
+			.pWaitDstStageMask = nullptr,
+			.commandBufferCount = 1,
+			.pCommandBuffers = &lv_batch.m_commandBuffer,
+			.signalSemaphoreCount = 0,
+			.pSignalSemaphores = nullptr
+		};
+
+		VULKAN_CHECK(vkResetFences(m_renderDevice.m_device, 1, &lv_batch.m_fence));
+		VULKAN_CHECK(vkQueueSubmit(m_renderDevice.m_mainQueue1, 1, &lv_submitInfo, lv_batch.m_fence));
+
+		lv_batch.m_endPosition = m_headPosition;
+		lv_batch.m_recording = false;
+		lv_batch.m_inFlight = true;
+		++m_totalNumSubmits;
+
+		m_currentBatchIndex = (m_currentBatchIndex + 1) % (uint32_t)m_batches.size();
+
+		//Batches are reused round robin, so the next one is the oldest and may still be executing
+		if (true == m_batches[m_currentBatchIndex].m_inFlight) {
+			VULKAN_CHECK(vkWaitForFences(m_renderDevice.m_device, 1, &m_batches[m_currentBatchIndex].m_fence, VK_TRUE, UINT64_MAX));
+			RetireBatch(m_currentBatchIndex);
+		}
+	}
+
+
+	void StagingRingBuffer::FlushAndWait()
+	{
+		Flush();
+
+		while (true == WaitForOldestBatch()) {}
+	}
+
+
+	void StagingRingBuffer::ReclaimCompletedBatches()
+	{
+		const uint32_t lv_totalNumBatches = (uint32_t)m_batches.size();
+
+		//In flight batches sit right after the current one in submission order, retire them front to back
+		for (uint32_t i = 1; i < lv_totalNumBatches; ++i) {
+
+			const uint32_t lv_batchIndex = (m_currentBatchIndex + i) % lv_totalNumBatches;
+			auto& lv_batch = m_batches[lv_batchIndex];
+
+			if (false == lv_batch.m_inFlight) {
+				continue;
+			}
+
+			if (VK_SUCCESS != vkGetFenceStatus(m_renderDevice.m_device, lv_batch.m_fence)) {
+				return;
+			}
+
+			RetireBatch(lv_batchIndex);
+		}
+	}
+
+
+	void StagingRingBuffer::RetireBatch(uint32_t l_batchIndex)
+	{
+		auto& lv_batch = m_batches[l_batchIndex];
+
+		lv_batch.m_inFlight = false;
+		m_tailPosition = std::max(m_tailPosition, lv_batch.m_endPosition);
+	}
+
+
+	bool StagingRingBuffer::WaitForOldestBatch()
+	{
+		using namespace ErrorCheck;
+
+		const uint32_t lv_totalNumBatches = (uint32_t)m_batches.size();
+
+		for (uint32_t i = 1; i < lv_totalNumBatches; ++i) {
+
+			const uint32_t lv_batchIndex = (m_currentBatchIndex + i) % lv_totalNumBatches;
+			auto& lv_batch = m_batches[lv_batchIndex];
+
+			if (true == lv_batch.m_inFlight) {
+				VULKAN_CHECK(vkWaitForFences(m_renderDevice.m_device, 1, &lv_batch.m_fence, VK_TRUE, UINT64_MAX));
+				RetireBatch(lv_batchIndex);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+	VkDeviceSize StagingRingBuffer::GetCapacity() const
+	{
+		return m_capacityInBytes;
+	}
+
+	VkDeviceSize StagingRingBuffer::GetUsedBytes() const
+	{
+		return m_headPosition - m_tailPosition;
+	}
+
+	uint64_t StagingRingBuffer::GetTotalNumSubmits() const
+	{
+		return m_totalNumSubmits;
+	}
+
+}
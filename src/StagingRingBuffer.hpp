@@ -0,0 +1,97 @@
+#pragma once
+
+
+
+#include "UtilsVulkan.h"
+#include <cinttypes>
+#include <vector>
+
+
+
+namespace RenderCore
+{
+
+	//Persistently mapped host visible buffer that CPU to GPU uploads are staged through.
+	//Copies are recorded into the command buffer of the current batch and only submitted on Flush(),
+	//so a whole loading phase ends up in a handful of submits. Every submitted batch owns a fence,
+	//and the bytes it staged are handed back to the ring once that fence is signaled.
+	//Not thread safe, all uploads are expected to come from the thread that owns the main queue.
+	class StagingRingBuffer final
+	{
+	public:
+
+		//l_ringBuffer has to be host visible, host coherent, persistently mapped and created with TRANSFER_SRC usage
+		StagingRingBuffer(VulkanRenderDevice& l_renderDevice, const VulkanBuffer& l_ringBuffer, uint32_t l_totalNumBatches);
+		~StagingRingBuffer();
+
+		StagingRingBuffer(const StagingRingBuffer&) = delete;
+		StagingRingBuffer& operator=(const StagingRingBuffer&) = delete;
+
+		//Uploads bigger than a quarter of the ring are split into several copies
+		void UploadToBuffer(VkBuffer l_dstBuffer, VkDeviceSize l_dstOffset, const void* l_data, VkDeviceSize l_sizeInBytes);
+
+		//Copies tightly packed texels into mip 0 of every layer of the image, split by rows when they do not fit.
+		//The image has to be in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL by the time the copies execute.
+		void UploadToImage(VkImage l_dstImage, uint32_t l_width, uint32_t l_height, uint32_t l_layerCount,
+			uint32_t l_bytesPerTexel, const void* l_texels);
+
+		//Command buffer of the current batch, for barriers and blits that must execute in order with the copies.
+		//Fetch it again after each Upload*() call since an upload may have submitted the batch it belonged to.
+		VkCommandBuffer GetCommandBuffer();
+
+		//Submits the current batch without waiting for it and reclaims the batches that have completed
+		void Flush();
+
+		//Submits the current batch and blocks until every batch has completed
+		void FlushAndWait();
+
+		VkDeviceSize GetCapacity() const;
+		VkDeviceSize GetUsedBytes() const;
+		uint64_t GetTotalNumSubmits() const;
+
+	private:
+
+		//Alignment of every staged range, image uploads raise it to a multiple of the texel size since the
+		//bufferOffset of vkCmdCopyBufferToImage has to be a multiple of it (3 bytes for VK_FORMAT_R8G8B8_UNORM)
+		static constexpr VkDeviceSize m_allocationAlignment = 16;
+
+		struct Batch
+		{
+			VkCommandBuffer m_commandBuffer{ VK_NULL_HANDLE };
+			VkFence m_fence{ VK_NULL_HANDLE };
+
+			//Ring position right after the last byte staged by this batch
+			uint64_t m_endPosition{ 0 };
+
+			bool m_recording{ false };
+			bool m_inFlight{ false };
+		};
+
+		//l_alignment does not have to be a power of two
+		bool TryAllocate(VkDeviceSize l_sizeInBytes, VkDeviceSize l_alignment, VkDeviceSize& l_offset);
+		VkDeviceSize Allocate(VkDeviceSize l_sizeInBytes, VkDeviceSize l_alignment = m_allocationAlignment);
+
+		void ReclaimCompletedBatches();
+		void RetireBatch(uint32_t l_batchIndex);
+		bool WaitForOldestBatch();
+
+
+		VulkanRenderDevice& m_renderDevice;
+
+		VkBuffer m_buffer{ VK_NULL_HANDLE };
+		uint8_t* m_mappedData{ nullptr };
+		VkDeviceSize m_capacityInBytes{ 0 };
+		VkDeviceSize m_maxChunkSizeInBytes{ 0 };
+
+		VkCommandPool m_commandPool{ VK_NULL_HANDLE };
+		std::vector<Batch> m_batches{};
+		uint32_t m_currentBatchIndex{ 0 };
+
+		//Both positions only ever grow, the offset inside the ring is position % capacity
+		uint64_t m_headPosition{ 0 };
+		uint64_t m_tailPosition{ 0 };
+
+		uint64_t m_totalNumSubmits{ 0 };
+	};
+
+}
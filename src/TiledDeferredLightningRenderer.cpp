@@ -47,14 +47,7 @@ namespace RenderCore
 			, "TiledLightStorageBufferDeferredRenderpass");
 		auto& lv_lightGpu = lv_vkResManager.RetrieveGpuBuffer(m_lightBufferGpuHandle);
 
-		lv_vkResManager.CopyDataToLocalBuffer(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_mainQueue2,
-			m_vulkanRenderContext.GetContextCreator().m_vkDev.m_mainCommandBuffer1[0]
-			, m_lightBufferGpuHandle, lv_lightData.data());
-
-		m_uniformBufferGpuHandle = lv_vkResManager.CreateBufferWithHandle
-		(sizeof(UniformBuffer), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT
-			, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-			, "TiledUniformBufferDeferredRenderpass");
+		lv_vkResManager.CopyDataToLocalBuffer(m_lightBufferGpuHandle, lv_lightData.data());
 
 		m_debugBuffer = &lv_vkResManager.CreateBuffer(sizeof(float) * 44 * 44, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT
 			, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
@@ -64,18 +57,14 @@ namespace RenderCore
 
 		m_colorOutputTextures.resize(lv_totalNumSwapchains);
 
-		auto lv_depthMapLightMeta = lv_vkResManager.RetrieveGpuResourceMetaData("DepthMapPointLight");
-
-		assert(lv_depthMapLightMeta.m_resourceHandle != std::numeric_limits<uint32_t>::max());
-
-		m_depthMapLightGpuHandle = lv_depthMapLightMeta.m_resourceHandle;
+		m_depthMapLightGpuHandle = lv_vkResManager.RetrieveGpuTextureHandle("DepthMapPointLight");
 
 		for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
 			m_colorOutputTextures[i] = &lv_vkResManager.RetrieveGpuTexture("DeferredLightningColorTexture", i);
 		}
 
 
-		GeneratePipelineFromSpirvBinaries(l_spvPath);
+		GeneratePipelineFromSpirvBinaries(l_spvPath, true);
 		SetNodeToAppropriateRenderpass("TiledDeferredLightning", this);
 		UpdateDescriptorSets();
 
@@ -83,13 +72,50 @@ namespace RenderCore
 		lv_node->m_enabled = false;
 		lv_frameGraph.IncrementNumNodesPerCmdBuffer(2);
 
-		m_computePipeline = lv_vkResManager.CreateComputePipeline
-		(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device
-			, l_computeShader, m_pipelineLayout);
+		//Defaults of the shader permutation, the frame graph node may override the tile size,
+		//the half-Z AABB path and the number of shadow taps
+		SpecializationConstants lv_permutation{};
+		lv_permutation.Set(m_tileWidthConstantID, m_tileWidth);
+		lv_permutation.Set(m_tileHeightConstantID, m_tileHeight);
+		lv_permutation.Set(m_halfZAabbConstantID, true);
+		lv_permutation.Set(m_totalNumShadowSamplesConstantID, 59);
+		lv_permutation.Merge(lv_node->m_specializationConstants);
+
+		//The shaders texelFetch the depth buffer and the G-buffer, so the tile bounds are computed in their extent
+		//and not in the one of the output texture
+		auto& lv_depthGpu = lv_vkResManager.RetrieveGpuTexture("Depth", 0);
+
+		//These follow the light buffer and the shader inputs, so they are never taken from the node
+		const bool lv_halfZAabb = (0U != lv_permutation.GetRawValue(m_halfZAabbConstantID, 1U));
+		lv_permutation.Set(m_totalNumLightsConstantID, m_totalNumLights);
+		lv_permutation.Set(m_totalNumHalfZLightsConstantID, (true == lv_halfZAabb) ? m_totalNumLights : 1U);
+		lv_permutation.Set(m_screenWidthConstantID, lv_depthGpu.width);
+		lv_permutation.Set(m_screenHeightConstantID, lv_depthGpu.height);
+
+		m_tileWidth = lv_permutation.GetRawValue(m_tileWidthConstantID, m_tileWidth);
+		m_tileHeight = lv_permutation.GetRawValue(m_tileHeightConstantID, m_tileHeight);
+
+		VkPhysicalDeviceProperties lv_deviceProperties{};
+		vkGetPhysicalDeviceProperties(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_physicalDevice, &lv_deviceProperties);
+
+		if (0 == m_tileWidth || 0 == m_tileHeight ||
+			m_tileWidth * m_tileHeight > lv_deviceProperties.limits.maxComputeWorkGroupInvocations) {
+			printf("Tile size %ux%u of TiledDeferredLightning is not a valid work group size. Exitting....\n",
+				m_tileWidth, m_tileHeight);
+			exit(-1);
+		}
+
+		//One invocation per input pixel, stores past the output texture are discarded
+		m_totalNumTilesX = (lv_depthGpu.width + m_tileWidth - 1) / m_tileWidth;
+		m_totalNumTilesY = (lv_depthGpu.height + m_tileHeight - 1) / m_tileHeight;
+
+		//The node starts disabled and the debug path is only reachable from the UI,
+		//so both pipelines are created the first time FillCommandBuffer() binds them
+		lv_vkResManager.RequestComputePipeline(l_computeShader, m_pipelineLayout
+			, " Compute-Pipeline-Tiled-Deferred ", m_computePipeline, true, lv_permutation);
 
-		m_debugComputePipeline = lv_vkResManager.CreateComputePipeline
-		(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device
-			,"Shaders/DebugFindingMaxMinDepthOfEachTile.comp.comp", m_pipelineLayout);
+		lv_vkResManager.RequestComputePipeline("Shaders/DebugFindingMaxMinDepthOfEachTile.comp.comp", m_pipelineLayout
+			, " Compute-Pipeline-Debug-Tiled-Deferred ", m_debugComputePipeline, true, lv_permutation);
 
 	}
 
@@ -103,241 +129,39 @@ namespace RenderCore
 	void TiledDeferredLightningRenderer::UpdateDescriptorSets()
 	{
 		auto& lv_vkResManager = m_vulkanRenderContext.GetResourceManager();
-		auto lv_totalNumSwapchains = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
-
-		std::array<VkDescriptorBufferInfo, 3> lv_bufferInfos{};
-		std::vector<VkDescriptorImageInfo> lv_imageInfos{};
-		lv_imageInfos.resize(lv_totalNumSwapchains * 10);
-
 
 		auto& lv_lightBufferGpu = lv_vkResManager.RetrieveGpuBuffer(m_lightBufferGpuHandle);
-		auto& lv_uniformBufferGpu = lv_vkResManager.RetrieveGpuBuffer(m_uniformBufferGpuHandle);
-
-		lv_bufferInfos[0].buffer = lv_lightBufferGpu.buffer;
-		lv_bufferInfos[0].offset = 0;
-		lv_bufferInfos[0].range = VK_WHOLE_SIZE;
-
-		lv_bufferInfos[1].buffer = lv_uniformBufferGpu.buffer;
-		lv_bufferInfos[1].offset = 0;
-		lv_bufferInfos[1].range = VK_WHOLE_SIZE;
-
-		lv_bufferInfos[2].buffer = m_debugBuffer->buffer;
-		lv_bufferInfos[2].offset = 0;
-		lv_bufferInfos[2].range = VK_WHOLE_SIZE;
-
-
-
-		auto lv_depthMapLightCubeMeta = lv_vkResManager.RetrieveGpuResourceMetaData("DepthMapPointLight");
-		assert(std::numeric_limits<uint32_t>::max() != lv_depthMapLightCubeMeta.m_resourceHandle);
-		auto& lv_depthMapLightGpu = lv_vkResManager.RetrieveGpuTexture(lv_depthMapLightCubeMeta.m_resourceHandle);
-		for (size_t i = 0, j = 0; i < lv_imageInfos.size(); i += 10, ++j) {
+		auto& lv_depthMapLightGpu = lv_vkResManager.RetrieveGpuTexture(m_depthMapLightGpuHandle);
 
-			auto& lv_gbufferPosGpu = lv_vkResManager.RetrieveGpuTexture("GBufferPosition", j);
-			auto& lv_gbufferNormalGpu = lv_vkResManager.RetrieveGpuTexture("GBufferNormal", j);
-			auto& lv_gbufferAlbedoSpec = lv_vkResManager.RetrieveGpuTexture("GBufferAlbedoSpec", j);
-			auto& lv_gbufferTangent = lv_vkResManager.RetrieveGpuTexture("GBufferTangent", j);
-			auto& lv_gbufferNormalVertexGpu = lv_vkResManager.RetrieveGpuTexture("GBufferNormalVertex", j);
-			auto& lv_occlusionGpu = lv_vkResManager.RetrieveGpuTexture("BoxBlurTexture", j);
-			auto& lv_gbufferMetallicGpu = lv_vkResManager.RetrieveGpuTexture("GBufferMetallic", j);
-			auto& lv_depth = lv_vkResManager.RetrieveGpuTexture("Depth", j);
+		const VkDescriptorBufferInfo lv_lightBufferInfo{ lv_lightBufferGpu.buffer, 0, VK_WHOLE_SIZE };
+		const VkDescriptorBufferInfo lv_uniformBufferInfo = lv_vkResManager.GetUniformArena()
+			.GetDescriptorBufferInfo(sizeof(UniformBuffer));
+		const VkDescriptorBufferInfo lv_debugBufferInfo{ m_debugBuffer->buffer, 0, VK_WHOLE_SIZE };
 
-			lv_imageInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i].imageView = lv_gbufferPosGpu.image.imageView0;
-			lv_imageInfos[i].sampler = lv_gbufferPosGpu.sampler;
+		//Sampled by bindings 2 to 8 and 10, in binding order
+		const std::array<const char*, 8> lv_sampledTextureNames{ "GBufferPosition", "GBufferNormal", "GBufferAlbedoSpec",
+			"GBufferTangent", "GBufferNormalVertex", "BoxBlurTexture", "GBufferMetallic", "Depth" };
+		const std::array<uint32_t, 8> lv_sampledTextureBindings{ 2, 3, 4, 5, 6, 7, 8, 10 };
 
-			lv_imageInfos[i + 1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 1].imageView = lv_gbufferNormalGpu.image.imageView0;
-			lv_imageInfos[i + 1].sampler = lv_gbufferNormalGpu.sampler;
+		for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
 
-			lv_imageInfos[i + 2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 2].imageView = lv_gbufferAlbedoSpec.image.imageView0;
-			lv_imageInfos[i + 2].sampler = lv_gbufferAlbedoSpec.sampler;
+			WriteBufferDescriptor(i, 0, lv_lightBufferInfo);
+			WriteBufferDescriptor(i, 1, lv_uniformBufferInfo);
 
-			lv_imageInfos[i + 3].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 3].imageView = lv_gbufferTangent.image.imageView0;
-			lv_imageInfos[i + 3].sampler = lv_gbufferTangent.sampler;
-
-			lv_imageInfos[i + 4].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 4].imageView = lv_gbufferNormalVertexGpu.image.imageView0;
-			lv_imageInfos[i + 4].sampler = lv_gbufferNormalVertexGpu.sampler;
-
-			lv_imageInfos[i + 5].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 5].imageView = lv_occlusionGpu.image.imageView0;
-			lv_imageInfos[i + 5].sampler = lv_occlusionGpu.sampler;
-
-			lv_imageInfos[i + 6].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 6].imageView = lv_gbufferMetallicGpu.image.imageView0;
-			lv_imageInfos[i + 6].sampler = lv_gbufferMetallicGpu.sampler;
-
-			lv_imageInfos[i + 7].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 7].imageView = lv_depthMapLightGpu.image.cubemapImageView;
-			lv_imageInfos[i + 7].sampler = lv_depthMapLightGpu.sampler;
-
-			lv_imageInfos[i + 8].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfos[i + 8].imageView = lv_depth.image.imageView0;
-			lv_imageInfos[i + 8].sampler = lv_depth.sampler;
-
-			lv_imageInfos[i + 9].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-			lv_imageInfos[i + 9].imageView = m_colorOutputTextures[j]->image.imageView0;
-			lv_imageInfos[i + 9].sampler = m_colorOutputTextures[j]->sampler;
-
-		}
+			for (size_t j = 0; j < lv_sampledTextureNames.size(); ++j) {
+				auto& lv_texture = lv_vkResManager.RetrieveGpuTexture(lv_sampledTextureNames[j], (uint32_t)i);
+				WriteImageDescriptor(i, lv_sampledTextureBindings[j], { lv_texture.sampler, lv_texture.image.imageView0,
+					VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+			}
 
-		std::vector<VkWriteDescriptorSet> lv_writes;
-		lv_writes.resize(lv_totalNumSwapchains * lv_bufferInfos.size() + lv_imageInfos.size());
-
-
-		for (size_t i = 0, j = 0; i < lv_writes.size(); i += 13, ++j) {
-
-			lv_writes[i].descriptorCount = 1;
-			lv_writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-			lv_writes[i].dstArrayElement = 0;
-			lv_writes[i].dstBinding = 0;
-			lv_writes[i].dstSet = m_descriptorSets[j];
-			lv_writes[i].pBufferInfo = &lv_bufferInfos[0];
-			lv_writes[i].pImageInfo = nullptr;
-			lv_writes[i].pNext = nullptr;
-			lv_writes[i].pTexelBufferView = nullptr;
-			lv_writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 1].descriptorCount = 1;
-			lv_writes[i + 1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			lv_writes[i + 1].dstArrayElement = 0;
-			lv_writes[i + 1].dstBinding = 1;
-			lv_writes[i + 1].dstSet = m_descriptorSets[j];
-			lv_writes[i + 1].pBufferInfo = &lv_bufferInfos[1];
-			lv_writes[i + 1].pImageInfo = nullptr;
-			lv_writes[i + 1].pNext = nullptr;
-			lv_writes[i + 1].pTexelBufferView = nullptr;
-			lv_writes[i + 1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-
-
-			lv_writes[i + 2].descriptorCount = 1;
-			lv_writes[i + 2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 2].dstArrayElement = 0;
-			lv_writes[i + 2].dstBinding = 2;
-			lv_writes[i + 2].dstSet = m_descriptorSets[j];
-			lv_writes[i + 2].pBufferInfo = nullptr;
-			lv_writes[i + 2].pImageInfo = &lv_imageInfos[10 * j];
-			lv_writes[i + 2].pNext = nullptr;
-			lv_writes[i + 2].pTexelBufferView = nullptr;
-			lv_writes[i + 2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 3].descriptorCount = 1;
-			lv_writes[i + 3].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 3].dstArrayElement = 0;
-			lv_writes[i + 3].dstBinding = 3;
-			lv_writes[i + 3].dstSet = m_descriptorSets[j];
-			lv_writes[i + 3].pBufferInfo = nullptr;
-			lv_writes[i + 3].pImageInfo = &lv_imageInfos[10 * j + 1];
-			lv_writes[i + 3].pNext = nullptr;
-			lv_writes[i + 3].pTexelBufferView = nullptr;
-			lv_writes[i + 3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 4].descriptorCount = 1;
-			lv_writes[i + 4].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 4].dstArrayElement = 0;
-			lv_writes[i + 4].dstBinding = 4;
-			lv_writes[i + 4].dstSet = m_descriptorSets[j];
-			lv_writes[i + 4].pBufferInfo = nullptr;
-			lv_writes[i + 4].pImageInfo = &lv_imageInfos[10 * j + 2];
-			lv_writes[i + 4].pNext = nullptr;
-			lv_writes[i + 4].pTexelBufferView = nullptr;
-			lv_writes[i + 4].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 5].descriptorCount = 1;
-			lv_writes[i + 5].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 5].dstArrayElement = 0;
-			lv_writes[i + 5].dstBinding = 5;
-			lv_writes[i + 5].dstSet = m_descriptorSets[j];
-			lv_writes[i + 5].pBufferInfo = nullptr;
-			lv_writes[i + 5].pImageInfo = &lv_imageInfos[10 * j + 3];
-			lv_writes[i + 5].pNext = nullptr;
-			lv_writes[i + 5].pTexelBufferView = nullptr;
-			lv_writes[i + 5].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 6].descriptorCount = 1;
-			lv_writes[i + 6].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 6].dstArrayElement = 0;
-			lv_writes[i + 6].dstBinding = 6;
-			lv_writes[i + 6].dstSet = m_descriptorSets[j];
-			lv_writes[i + 6].pBufferInfo = nullptr;
-			lv_writes[i + 6].pImageInfo = &lv_imageInfos[10 * j + 4];
-			lv_writes[i + 6].pNext = nullptr;
-			lv_writes[i + 6].pTexelBufferView = nullptr;
-			lv_writes[i + 6].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 7].descriptorCount = 1;
-			lv_writes[i + 7].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 7].dstArrayElement = 0;
-			lv_writes[i + 7].dstBinding = 7;
-			lv_writes[i + 7].dstSet = m_descriptorSets[j];
-			lv_writes[i + 7].pBufferInfo = nullptr;
-			lv_writes[i + 7].pImageInfo = &lv_imageInfos[10 * j + 5];
-			lv_writes[i + 7].pNext = nullptr;
-			lv_writes[i + 7].pTexelBufferView = nullptr;
-			lv_writes[i + 7].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 8].descriptorCount = 1;
-			lv_writes[i + 8].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 8].dstArrayElement = 0;
-			lv_writes[i + 8].dstBinding = 8;
-			lv_writes[i + 8].dstSet = m_descriptorSets[j];
-			lv_writes[i + 8].pBufferInfo = nullptr;
-			lv_writes[i + 8].pImageInfo = &lv_imageInfos[10 * j + 6];
-			lv_writes[i + 8].pNext = nullptr;
-			lv_writes[i + 8].pTexelBufferView = nullptr;
-			lv_writes[i + 8].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 9].descriptorCount = 1;
-			lv_writes[i + 9].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 9].dstArrayElement = 0;
-			lv_writes[i + 9].dstBinding = 9;
-			lv_writes[i + 9].dstSet = m_descriptorSets[j];
-			lv_writes[i + 9].pBufferInfo = nullptr;
-			lv_writes[i + 9].pImageInfo = &lv_imageInfos[10 * j + 7];
-			lv_writes[i + 9].pNext = nullptr;
-			lv_writes[i + 9].pTexelBufferView = nullptr;
-			lv_writes[i + 9].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-
-			lv_writes[i + 10].descriptorCount = 1;
-			lv_writes[i + 10].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i + 10].dstArrayElement = 0;
-			lv_writes[i + 10].dstBinding = 10;
-			lv_writes[i + 10].dstSet = m_descriptorSets[j];
-			lv_writes[i + 10].pBufferInfo = nullptr;
-			lv_writes[i + 10].pImageInfo = &lv_imageInfos[10 * j + 8];
-			lv_writes[i + 10].pNext = nullptr;
-			lv_writes[i + 10].pTexelBufferView = nullptr;
-			lv_writes[i + 10].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 11].descriptorCount = 1;
-			lv_writes[i + 11].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-			lv_writes[i + 11].dstArrayElement = 0;
-			lv_writes[i + 11].dstBinding = 11;
-			lv_writes[i + 11].dstSet = m_descriptorSets[j];
-			lv_writes[i + 11].pBufferInfo = nullptr;
-			lv_writes[i + 11].pImageInfo = &lv_imageInfos[10 * j + 9];
-			lv_writes[i + 11].pNext = nullptr;
-			lv_writes[i + 11].pTexelBufferView = nullptr;
-			lv_writes[i + 11].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 12].descriptorCount = 1;
-			lv_writes[i + 12].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-			lv_writes[i + 12].dstArrayElement = 0;
-			lv_writes[i + 12].dstBinding = 12;
-			lv_writes[i + 12].dstSet = m_descriptorSets[j];
-			lv_writes[i + 12].pBufferInfo = &lv_bufferInfos[2];
-			lv_writes[i + 12].pImageInfo = nullptr;
-			lv_writes[i + 12].pNext = nullptr;
-			lv_writes[i + 12].pTexelBufferView = nullptr;
-			lv_writes[i + 12].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			WriteImageDescriptor(i, 9, { lv_depthMapLightGpu.sampler, lv_depthMapLightGpu.image.cubemapImageView,
+				VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+			WriteImageDescriptor(i, 11, { m_colorOutputTextures[i]->sampler, m_colorOutputTextures[i]->image.imageView0,
+				VK_IMAGE_LAYOUT_GENERAL });
+			WriteBufferDescriptor(i, 12, lv_debugBufferInfo);
 		}
 
-		vkUpdateDescriptorSets(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device
-			, lv_writes.size(), lv_writes.data(), 0, nullptr);
+		FlushDescriptorWrites();
 	}
 
 
@@ -352,23 +176,13 @@ namespace RenderCore
 		lv_cameraUniform.m_invProjMatrix = glm::inverse(l_cameraStructure.m_projectionMatrix);
 		lv_cameraUniform.m_projMatrix = l_cameraStructure.m_projectionMatrix;
 
-		auto& lv_uniformBufferGpu = m_vulkanRenderContext.GetResourceManager().RetrieveGpuBuffer(m_uniformBufferGpuHandle);
-		memcpy(lv_uniformBufferGpu.ptr, &lv_cameraUniform, lv_uniformBufferGpu.size);
+		m_dynamicUniformOffsets[0] = m_vulkanRenderContext.GetResourceManager().GetUniformArena().Push(lv_cameraUniform);
 
 	}
 
 	void TiledDeferredLightningRenderer::FillCommandBuffer
 	(VkCommandBuffer l_cmdBuffer, uint32_t l_currentSwapchainIndex)
 	{
-		auto& lv_vkResManager = m_vulkanRenderContext.GetResourceManager();
-
-		auto& lv_gbufferTangentGpu = lv_vkResManager.RetrieveGpuTexture("GBufferTangent", l_currentSwapchainIndex);
-		auto& lv_gbufferPosGpu = lv_vkResManager.RetrieveGpuTexture("GBufferPosition", l_currentSwapchainIndex);
-		auto& lv_gbufferNormalGpu = lv_vkResManager.RetrieveGpuTexture("GBufferNormal", l_currentSwapchainIndex);
-		auto& lv_gbufferAlbedoSpecGpu = lv_vkResManager.RetrieveGpuTexture("GBufferAlbedoSpec", l_currentSwapchainIndex);
-		auto& lv_gbufferNormalVertexGpu = lv_vkResManager.RetrieveGpuTexture("GBufferNormalVertex", l_currentSwapchainIndex);
-		auto& lv_depth = lv_vkResManager.RetrieveGpuTexture("Depth", l_currentSwapchainIndex);
-		auto& lv_metallicGpu = lv_vkResManager.RetrieveGpuTexture("GBufferMetallic", l_currentSwapchainIndex);
 
 
 
@@ -379,20 +193,17 @@ namespace RenderCore
 
 
 
+		auto& lv_vkResManager = m_vulkanRenderContext.GetResourceManager();
+
 		if (true == m_switchToDebug) {
-			vkCmdBindPipeline(l_cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_debugComputePipeline);
+			vkCmdBindPipeline(l_cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, lv_vkResManager.CreateDeferredPipeline(m_debugComputePipeline));
 		}
 		else {
-			vkCmdBindPipeline(l_cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_computePipeline);
+			vkCmdBindPipeline(l_cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, lv_vkResManager.CreateDeferredPipeline(m_computePipeline));
 		}
-		vkCmdBindDescriptorSets(l_cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1,
-			&m_descriptorSets[l_currentSwapchainIndex], 0, nullptr);
-
-		uint32_t lv_width = 1024;
-		uint32_t lv_height = 1024;
-
+		BindDescriptorSet(l_cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, l_currentSwapchainIndex);
 
-		vkCmdDispatch(l_cmdBuffer, (uint32_t)lv_width / (uint32_t)16, (uint32_t)lv_height / (uint32_t)16, 1);
+		vkCmdDispatch(l_cmdBuffer, m_totalNumTilesX, m_totalNumTilesY, 1);
 
 		transitionImageLayoutCmd(l_cmdBuffer, m_colorOutputTextures[l_currentSwapchainIndex]->image.image
 			, m_colorOutputTextures[l_currentSwapchainIndex]->format, VK_IMAGE_LAYOUT_GENERAL
@@ -16,6 +16,16 @@ namespace RenderCore
 
 		static constexpr uint32_t m_totalNumLights{ 232 };
 
+		//constant_id of the specialization constants of FindingMaxMinDepthOfEachTile.comp and its debug variant
+		static constexpr uint32_t m_totalNumLightsConstantID{ 0 };
+		static constexpr uint32_t m_tileWidthConstantID{ 1 };
+		static constexpr uint32_t m_tileHeightConstantID{ 2 };
+		static constexpr uint32_t m_screenWidthConstantID{ 3 };
+		static constexpr uint32_t m_screenHeightConstantID{ 4 };
+		static constexpr uint32_t m_halfZAabbConstantID{ 5 };
+		static constexpr uint32_t m_totalNumShadowSamplesConstantID{ 6 };
+		static constexpr uint32_t m_totalNumHalfZLightsConstantID{ 7 };
+
 		struct Light
 		{
 			glm::vec4 m_positionAndRadius;
@@ -67,15 +77,20 @@ namespace RenderCore
 
 	private:
 
-		uint32_t m_uniformBufferGpuHandle;
-		uint32_t m_lightBufferGpuHandle;
-		uint32_t m_vertexBufferGpuHandle;
-		uint32_t m_indicesBufferGpuHandle;
-		uint32_t m_depthMapLightGpuHandle;
+		BufferHandle m_lightBufferGpuHandle;
+		BufferHandle m_vertexBufferGpuHandle;
+		BufferHandle m_indicesBufferGpuHandle;
+		TextureHandle m_depthMapLightGpuHandle;
 		std::vector<VulkanTexture*> m_colorOutputTextures;
 		VulkanBuffer* m_debugBuffer;
-		VkPipeline m_debugComputePipeline;
+		VkPipeline m_debugComputePipeline{ VK_NULL_HANDLE };
 		bool m_switchToDebug{ false };
+
+		//Work group size and number of work groups of the selected permutation
+		uint32_t m_tileWidth{ 16 };
+		uint32_t m_tileHeight{ 16 };
+		uint32_t m_totalNumTilesX{ 0 };
+		uint32_t m_totalNumTilesY{ 0 };
 	};
 
 
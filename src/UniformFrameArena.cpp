@@ -0,0 +1,75 @@
+
+
+
+
+#include "UniformFrameArena.hpp"
+#include "ErrorCheck.hpp"
+#include <algorithm>
+
+
+namespace RenderCore
+{
+
+	UniformFrameArena::UniformFrameArena(VulkanRenderDevice& l_renderDevice, const VulkanBuffer& l_arenaBuffer,
+		uint32_t l_totalNumFrames)
+	{
+		using namespace ErrorCheck;
+
+		if (nullptr == l_arenaBuffer.ptr) {
+			PRINT_EXIT("\nUniform frame arena has to be persistently mapped.\n");
+		}
+
+		VkPhysicalDeviceProperties lv_deviceProperties{};
+		vkGetPhysicalDeviceProperties(l_renderDevice.m_physicalDevice, &lv_deviceProperties);
+
+		//Dynamic offsets have to be multiples of minUniformBufferOffsetAlignment, which is a power of two
+		m_alignment = std::max(lv_deviceProperties.limits.minUniformBufferOffsetAlignment, (VkDeviceSize)16);
+
+		m_buffer = l_arenaBuffer.buffer;
+		m_mappedData = static_cast<uint8_t*>(l_arenaBuffer.ptr);
+		m_totalNumFrames = std::max(l_totalNumFrames, 1U);
+		m_frameCapacityInBytes = (l_arenaBuffer.size / m_totalNumFrames) & ~(m_alignment - 1);
+
+		if (0 == m_frameCapacityInBytes) {
+			PRINT_EXIT("\nUniform frame arena is too small.\n");
+		}
+	}
+
+
+	void UniformFrameArena::BeginFrame(uint32_t l_frameIndex)
+	{
+		m_frameBeginOffset = (VkDeviceSize)(l_frameIndex % m_totalNumFrames) * m_frameCapacityInBytes;
+		m_usedBytes = 0;
+	}
+
+
+	UniformAllocation UniformFrameArena::Allocate(VkDeviceSize l_sizeInBytes)
+	{
+		using namespace ErrorCheck;
+
+		const VkDeviceSize lv_alignedSize = (l_sizeInBytes + m_alignment - 1) & ~(m_alignment - 1);
+
+		if (m_usedBytes + lv_alignedSize > m_frameCapacityInBytes) {
+			PRINT_EXIT("\nUniform frame arena ran out of memory, increase its size.\n");
+		}
+
+		const VkDeviceSize lv_offset = m_frameBeginOffset + m_usedBytes;
+
+		m_usedBytes += lv_alignedSize;
+		m_peakUsedBytes = std::max(m_peakUsedBytes, m_usedBytes);
+
+		return UniformAllocation{ .m_mappedData = m_mappedData + lv_offset, .m_dynamicOffset = (uint32_t)lv_offset };
+	}
+
+
+	VkDescriptorBufferInfo UniformFrameArena::GetDescriptorBufferInfo(VkDeviceSize l_range) const
+	{
+		return VkDescriptorBufferInfo{ .buffer = m_buffer, .offset = 0, .range = l_range };
+	}
+
+
+	VkDeviceSize UniformFrameArena::GetFrameCapacity() const { return m_frameCapacityInBytes; }
+	VkDeviceSize UniformFrameArena::GetUsedBytes() const { return m_usedBytes; }
+	VkDeviceSize UniformFrameArena::GetPeakUsedBytes() const { return m_peakUsedBytes; }
+
+}
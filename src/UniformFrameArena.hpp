@@ -0,0 +1,72 @@
+#pragma once
+
+
+
+#include "UtilsVulkan.h"
+#include <cinttypes>
+#include <cstring>
+
+
+
+namespace RenderCore
+{
+
+	struct UniformAllocation
+	{
+		void* m_mappedData{ nullptr };
+
+		//Passed to vkCmdBindDescriptorSets for the UNIFORM_BUFFER_DYNAMIC binding the block belongs to
+		uint32_t m_dynamicOffset{ 0 };
+	};
+
+
+	//Persistently mapped host visible buffer that renderers write their per frame uniform blocks into,
+	//instead of owning one small uniform buffer each. The buffer is split into one region per swapchain image,
+	//BeginFrame() rewinds the region of the image about to be recorded and Allocate() carves aligned slices out of it.
+	//Descriptors point at offset 0 of the buffer with the size of the block as range (VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC),
+	//the slice itself is selected by the dynamic offset at bind time. Not thread safe.
+	class UniformFrameArena final
+	{
+	public:
+
+		//l_arenaBuffer has to be host visible, host coherent, persistently mapped and created with UNIFORM_BUFFER usage
+		UniformFrameArena(VulkanRenderDevice& l_renderDevice, const VulkanBuffer& l_arenaBuffer, uint32_t l_totalNumFrames);
+
+		UniformFrameArena(const UniformFrameArena&) = delete;
+		UniformFrameArena& operator=(const UniformFrameArena&) = delete;
+
+		void BeginFrame(uint32_t l_frameIndex);
+
+		UniformAllocation Allocate(VkDeviceSize l_sizeInBytes);
+
+		template<typename T>
+		uint32_t Push(const T& l_uniformBlock)
+		{
+			const UniformAllocation lv_allocation = Allocate(sizeof(T));
+			memcpy(lv_allocation.m_mappedData, &l_uniformBlock, sizeof(T));
+
+			return lv_allocation.m_dynamicOffset;
+		}
+
+		//l_range is the size of the uniform block declared by the shader
+		VkDescriptorBufferInfo GetDescriptorBufferInfo(VkDeviceSize l_range) const;
+
+		VkDeviceSize GetFrameCapacity() const;
+		VkDeviceSize GetUsedBytes() const;
+		VkDeviceSize GetPeakUsedBytes() const;
+
+	private:
+
+		VkBuffer m_buffer{ VK_NULL_HANDLE };
+		uint8_t* m_mappedData{ nullptr };
+
+		VkDeviceSize m_alignment{ 0 };
+		VkDeviceSize m_frameCapacityInBytes{ 0 };
+		uint32_t m_totalNumFrames{ 0 };
+
+		VkDeviceSize m_frameBeginOffset{ 0 };
+		VkDeviceSize m_usedBytes{ 0 };
+		VkDeviceSize m_peakUsedBytes{ 0 };
+	};
+
+}
@@ -31,16 +31,8 @@ namespace RenderCore
 
 		std::string lv_rendererName{ l_rendererName };
 
-		std::string lv_uniformBufferName{ "UniformBuffer" + lv_rendererName };
-
-		m_uniformBufferGpu = &lv_vkResManager.CreateBuffer(sizeof(UniformBuffer), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT
-			, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-			, lv_uniformBufferName.c_str());
-
 		m_uniformCpu.m_radius = 0.005f;
 
-		memcpy(m_uniformBufferGpu->ptr, &m_uniformCpu,  sizeof(UniformBuffer));
-
 
 		for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
 			m_mipMapInputOutputImages[i] = &lv_vkResManager.RetrieveGpuTexture("DeferredLightningColorTexture", i);
@@ -57,13 +49,9 @@ namespace RenderCore
 		}
 
 
-
-		UniformBuffer lv_uniform{};
-		lv_uniform.m_indexMipchain = m_mipLevelToRenderTo;
-		lv_uniform.m_radius = 0.005f;
-		lv_uniform.m_mipchainDimensions = glm::vec4{ m_mipchainDimensions[m_mipLevelToRenderTo + 1].x,m_mipchainDimensions[m_mipLevelToRenderTo + 1].y, 1.f, 1.f };
-
-		memcpy(m_uniformBufferGpu->ptr, &lv_uniform, sizeof(UniformBuffer));
+		//Pushed into the uniform arena as is every frame, the blend samples the next smaller mip
+		m_uniformCpu.m_indexMipchain = m_mipLevelToRenderTo;
+		m_uniformCpu.m_mipchainDimensions = glm::vec4{ m_mipchainDimensions[m_mipLevelToRenderTo + 1].x,m_mipchainDimensions[m_mipLevelToRenderTo + 1].y, 1.f, 1.f };
 
 
 		SetRenderPassAndFrameBuffer(l_rendererName);
@@ -139,7 +127,7 @@ namespace RenderCore
 		}
 
 
-		GeneratePipelineFromSpirvBinaries(l_spvPath);
+		GeneratePipelineFromSpirvBinaries(l_spvPath, true);
 		SetNodeToAppropriateRenderpass(l_rendererName, this);
 		UpdateDescriptorSets();
 
@@ -150,7 +138,9 @@ namespace RenderCore
 
 
 		VulkanResourceManager::PipelineInfo lv_pipeInfo{};
-		lv_pipeInfo.m_dynamicScissorState = false;
+		//Viewport and scissor are set per draw so that every mip level shares one pipeline
+		lv_pipeInfo.m_dynamicScissorState = true;
+		lv_pipeInfo.m_dynamicViewportState = true;
 		lv_pipeInfo.m_enableWireframe = false;
 		lv_pipeInfo.m_height = m_mipchainDimensions[l_mipLevelTtoRenderTo].x;
 		lv_pipeInfo.m_width = m_mipchainDimensions[l_mipLevelTtoRenderTo].y;
@@ -161,8 +151,8 @@ namespace RenderCore
 
 		std::string lv_graphicsPipelineName{ "GraphicsPipeline" + lv_rendererName };
 
-		m_graphicsPipeline = lv_vkResManager.CreateGraphicsPipeline(m_renderPass, m_pipelineLayout
-			, { l_vtxShader, l_fragShader }, lv_graphicsPipelineName.c_str(), lv_pipeInfo);
+		lv_vkResManager.RequestGraphicsPipeline(m_renderPass, m_pipelineLayout
+			, { l_vtxShader, l_fragShader }, lv_graphicsPipelineName.c_str(), lv_pipeInfo, m_graphicsPipeline);
 
 
 
@@ -184,6 +174,15 @@ namespace RenderCore
 
 
 		BeginRenderPass(m_renderPass, lv_framebuffer, l_cmdBuffer, l_currentSwapchainIndex, 1, m_mipchainDimensions[m_mipLevelToRenderTo].x, m_mipchainDimensions[m_mipLevelToRenderTo].y);
+
+		const VkViewport lv_viewport{ .x = 0.f, .y = 0.f
+			, .width = m_mipchainDimensions[m_mipLevelToRenderTo].x, .height = m_mipchainDimensions[m_mipLevelToRenderTo].y
+			, .minDepth = 0.f, .maxDepth = 1.f };
+		const VkRect2D lv_scissor{ .offset = { 0, 0 }
+			, .extent = { (uint32_t)m_mipchainDimensions[m_mipLevelToRenderTo].x, (uint32_t)m_mipchainDimensions[m_mipLevelToRenderTo].y } };
+
+		vkCmdSetViewport(l_cmdBuffer, 0, 1, &lv_viewport);
+		vkCmdSetScissor(l_cmdBuffer, 0, 1, &lv_scissor);
 		vkCmdDraw(l_cmdBuffer, 6, 1, 0, 0);
 		vkCmdEndRenderPass(l_cmdBuffer);
 
@@ -193,8 +192,7 @@ namespace RenderCore
 	void UpsampleBlendRenderer::UpdateBuffers(const uint32_t l_currentSwapchainIndex,
 		const VulkanEngine::CameraStructure& l_cameraStructure)
 	{
-		
-		memcpy(m_uniformBufferGpu->ptr, &m_uniformCpu, sizeof(UniformBuffer));
+		m_dynamicUniformOffsets[0] = m_vulkanRenderContext.GetResourceManager().GetUniformArena().Push(m_uniformCpu);
 	}
 
 
@@ -206,58 +204,16 @@ namespace RenderCore
 
 	void UpsampleBlendRenderer::UpdateDescriptorSets()
 	{
+		const VkDescriptorBufferInfo lv_bufferInfo = m_vulkanRenderContext.GetResourceManager()
+			.GetUniformArena().GetDescriptorBufferInfo(sizeof(UniformBuffer));
 
-		auto lv_totalNumSwapchains = m_vulkanRenderContext.GetContextCreator().m_vkDev.m_swapchainImages.size();
-
-		VkDescriptorBufferInfo lv_bufferInfo{};
-		lv_bufferInfo.buffer = m_uniformBufferGpu->buffer;
-		lv_bufferInfo.offset = 0;
-		lv_bufferInfo.range = VK_WHOLE_SIZE;
-
-
-		std::vector<VkDescriptorImageInfo> lv_imageInfo{};
-		lv_imageInfo.resize(lv_totalNumSwapchains);
-
-		for (size_t i = 0; i < lv_totalNumSwapchains; ++i) {
-
-			lv_imageInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			lv_imageInfo[i].imageView = m_descriptorImageViews[i];
-			lv_imageInfo[i].sampler = m_mipMapInputOutputImages[i]->sampler;
-
+		for (size_t i = 0; i < m_descriptorSets.size(); ++i) {
+			WriteImageDescriptor(i, 0, { m_mipMapInputOutputImages[i]->sampler, m_descriptorImageViews[i],
+				VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+			WriteBufferDescriptor(i, 1, lv_bufferInfo);
 		}
 
-		std::vector<VkWriteDescriptorSet> lv_writes{};
-		lv_writes.resize(2 * lv_totalNumSwapchains);
-
-		for (size_t i = 0, j = 0; i < lv_writes.size(); i += 2, ++j) {
-
-			lv_writes[i].descriptorCount = 1;
-			lv_writes[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			lv_writes[i].dstArrayElement = 0;
-			lv_writes[i].dstBinding = 0;
-			lv_writes[i].dstSet = m_descriptorSets[j];
-			lv_writes[i].pBufferInfo = nullptr;
-			lv_writes[i].pImageInfo = &lv_imageInfo[j];
-			lv_writes[i].pNext = nullptr;
-			lv_writes[i].pTexelBufferView = nullptr;
-			lv_writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-			lv_writes[i + 1].descriptorCount = 1;
-			lv_writes[i + 1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			lv_writes[i + 1].dstArrayElement = 0;
-			lv_writes[i + 1].dstBinding = 1;
-			lv_writes[i + 1].dstSet = m_descriptorSets[j];
-			lv_writes[i + 1].pBufferInfo = &lv_bufferInfo;
-			lv_writes[i + 1].pImageInfo = nullptr;
-			lv_writes[i + 1].pNext = nullptr;
-			lv_writes[i + 1].pTexelBufferView = nullptr;
-			lv_writes[i + 1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-		}
-
-
-		vkUpdateDescriptorSets(m_vulkanRenderContext.GetContextCreator().m_vkDev.m_device, lv_writes.size(), lv_writes.data(), 0, nullptr);
-
+		FlushDescriptorWrites();
 	}
 
 
@@ -58,8 +58,6 @@ namespace RenderCore
 		const uint32_t m_mipLevelToRenderTo;
 
 		UniformBuffer m_uniformCpu{};
-
-		VulkanBuffer* m_uniformBufferGpu;
 	};
 
 
@@ -7,6 +7,7 @@
 #include "glslang/Include/glslang_c_interface.h"
 #include "glslang/Include/ResourceLimits.h"
 #include "glslang/Public/resource_limits_c.h"
+#include "glslang/build_info.h"
 
 #define VK_NO_PROTOTYPES
 #define GLFW_INCLUDE_VULKAN
@@ -31,6 +32,10 @@ using glm::vec2;
 
 #include <cstdio>
 #include <cstdlib>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <thread>
 
 void CHECK(bool check, const char* fileName, int lineNumber)
 {
@@ -227,12 +232,158 @@ static size_t compileShader(glslang_stage_t stage, const char* shaderSource, Sha
 	return shaderModule.SPIRV.size();
 }
 
+static const char* const shaderCacheDirectory = "Shaders/Cache/";
+
+/* Bump whenever compileShader() changes its input settings in a way the hash below does not see */
+static constexpr uint32_t shaderCacheVersion = 1;
+
+static uint64_t hashShaderSource(glslang_stage_t stage, const std::string& shaderSource)
+{
+	/* FNV-1a */
+	uint64_t hash = 0xcbf29ce484222325ULL;
+
+	const auto hashBytes = [&hash](const void* data, size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 0x100000001b3ULL;
+		}
+	};
+
+	const uint32_t compilerFingerprint[] =
+	{
+		shaderCacheVersion,
+		GLSLANG_VERSION_MAJOR, GLSLANG_VERSION_MINOR, GLSLANG_VERSION_PATCH,
+		(uint32_t)GLSLANG_TARGET_VULKAN_1_1, (uint32_t)GLSLANG_TARGET_SPV_1_3,
+		(uint32_t)stage
+	};
+
+	hashBytes(compilerFingerprint, sizeof(compilerFingerprint));
+	hashBytes(shaderSource.data(), shaderSource.size());
+
+	return hash;
+}
+
+static bool loadCachedSPIRV(const std::filesystem::path& cacheFile, ShaderModule& shaderModule)
+{
+	std::ifstream file(cacheFile, std::ios::binary | std::ios::ate);
+
+	if (!file.is_open())
+		return false;
+
+	const std::streamsize size = file.tellg();
+
+	if (size < (std::streamsize)sizeof(uint32_t) || 0 != size % sizeof(uint32_t))
+		return false;
+
+	shaderModule.SPIRV.resize((size_t)size / sizeof(uint32_t));
+
+	file.seekg(0, std::ios::beg);
+	file.read(reinterpret_cast<char*>(shaderModule.SPIRV.data()), size);
+
+	constexpr uint32_t spirvMagicNumber = 0x07230203;
+
+	if (!file.good() || spirvMagicNumber != shaderModule.SPIRV[0])
+	{
+		shaderModule.SPIRV.clear();
+		return false;
+	}
+
+	return true;
+}
+
+static void storeCachedSPIRV(const std::filesystem::path& cacheFile, const ShaderModule& shaderModule)
+{
+	std::error_code errorCode;
+	std::filesystem::create_directories(cacheFile.parent_path(), errorCode);
+
+	/* Written next to the final file and renamed, so a concurrent reader never sees a partial blob.
+	   The temporary name is per thread since pipelines are created in parallel and may share shaders. */
+	std::filesystem::path tempFile = cacheFile;
+	tempFile += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+	{
+		std::ofstream file(tempFile, std::ios::binary | std::ios::trunc);
+
+		if (!file.is_open())
+		{
+			printf("Cannot write shader cache file '%s'\n", tempFile.string().c_str());
+			return;
+		}
+
+		file.write(reinterpret_cast<const char*>(shaderModule.SPIRV.data()),
+			(std::streamsize)(shaderModule.SPIRV.size() * sizeof(uint32_t)));
+	}
+
+	std::filesystem::rename(tempFile, cacheFile, errorCode);
+}
+
 size_t compileShaderFile(const char* file, ShaderModule& shaderModule)
 {
-	if (auto shaderSource = readShaderFile(file); !shaderSource.empty())
-		return compileShader(glslangShaderStageFromFileName(file), shaderSource.c_str(), shaderModule);
+	const std::string shaderSource = readShaderFile(file);
 
-	return 0;
+	if (shaderSource.empty())
+		return 0;
+
+	const glslang_stage_t stage = glslangShaderStageFromFileName(file);
+
+	char cacheFileName[32];
+	snprintf(cacheFileName, sizeof(cacheFileName), "%016llx.spv", (unsigned long long)hashShaderSource(stage, shaderSource));
+
+	const std::filesystem::path cacheFile = std::filesystem::path(shaderCacheDirectory) / cacheFileName;
+
+	if (loadCachedSPIRV(cacheFile, shaderModule))
+		return shaderModule.SPIRV.size();
+
+	printf("Shader cache miss, compiling '%s'\n", file);
+
+	if (compileShader(stage, shaderSource.c_str(), shaderModule) < 1)
+		return 0;
+
+	storeCachedSPIRV(cacheFile, shaderModule);
+
+	return shaderModule.SPIRV.size();
+}
+
+uint32_t precompileShaderDirectory(const char* directory)
+{
+	uint32_t numCompiled = 0;
+	uint32_t numFailed = 0;
+
+	std::error_code errorCode;
+
+	for (const auto& entry : std::filesystem::directory_iterator(directory, errorCode))
+	{
+		if (!entry.is_regular_file())
+			continue;
+
+		const std::string extension = entry.path().extension().string();
+
+		if (".vert" != extension && ".frag" != extension && ".geom" != extension &&
+			".comp" != extension && ".tesc" != extension && ".tese" != extension)
+			continue;
+
+		ShaderModule shaderModule;
+
+		if (compileShaderFile(entry.path().generic_string().c_str(), shaderModule) < 1)
+		{
+			printf("Failed to precompile '%s'\n", entry.path().generic_string().c_str());
+			numFailed++;
+			continue;
+		}
+
+		numCompiled++;
+	}
+
+	if (errorCode)
+		printf("Cannot read shader directory '%s': %s\n", directory, errorCode.message().c_str());
+
+	printf("Shader cache: %u shaders ready, %u failed\n", numCompiled, numFailed);
+
+	return numFailed;
 }
 
 VkResult createShaderModule(VkDevice m_device, ShaderModule* shader, const char* fileName)
@@ -393,7 +544,7 @@ VkResult createDeviceWithCompute(VkPhysicalDevice m_physicalDevice, VkPhysicalDe
 
 VkResult createDevice2(VkPhysicalDevice m_physicalDevice, VkPhysicalDeviceFeatures2 deviceFeatures2, uint32_t m_mainFamily, VkDevice* m_device)
 {
-	const std::vector<const char*> extensions =
+	std::vector<const char*> extensions =
 	{
 		VK_KHR_SWAPCHAIN_EXTENSION_NAME,
 		VK_KHR_MAINTENANCE3_EXTENSION_NAME,
@@ -403,6 +554,10 @@ VkResult createDevice2(VkPhysicalDevice m_physicalDevice, VkPhysicalDeviceFeatur
 		VK_KHR_SHADER_DRAW_PARAMETERS_EXTENSION_NAME
 	};
 
+	if (true == isDeviceExtensionSupported(m_physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+		extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+	}
+
 	const float queuePriority = 1.0f;
 
 	const VkDeviceQueueCreateInfo qci =
@@ -434,7 +589,7 @@ VkResult createDevice2(VkPhysicalDevice m_physicalDevice, VkPhysicalDeviceFeatur
 
 VkResult createDevice2WithCompute(VkPhysicalDevice m_physicalDevice, VkPhysicalDeviceFeatures2 deviceFeatures2, uint32_t m_mainFamily, uint32_t m_computeTransferFamily, VkDevice* m_device)
 {
-	const std::vector<const char*> extensions =
+	std::vector<const char*> extensions =
 	{
 		VK_KHR_SWAPCHAIN_EXTENSION_NAME,
 		VK_KHR_MAINTENANCE3_EXTENSION_NAME,
@@ -446,6 +601,10 @@ VkResult createDevice2WithCompute(VkPhysicalDevice m_physicalDevice, VkPhysicalD
 		VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME,
 	};
 
+	if (true == isDeviceExtensionSupported(m_physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+		extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+	}
+
 	if (m_mainFamily == m_computeTransferFamily)
 		return createDevice2(m_physicalDevice, deviceFeatures2, m_mainFamily, m_device);
 
@@ -739,6 +898,7 @@ bool initVulkanRenderDevice2(VulkanInstance& vk, VulkanRenderDevice& vkDev, uint
 	VK_CHECK(findSuitablePhysicalDevice(vk.instance, selector, &vkDev.m_physicalDevice));
 	vkDev.m_mainFamily = findQueueFamilies(vkDev.m_physicalDevice, VK_QUEUE_GRAPHICS_BIT);
 	VK_CHECK(createDevice2(vkDev.m_physicalDevice, deviceFeatures2, vkDev.m_mainFamily, &vkDev.m_device));
+	vkDev.m_memoryBudgetSupported = isDeviceExtensionSupported(vkDev.m_physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
 
 	vkGetDeviceQueue(vkDev.m_device, vkDev.m_mainFamily, 0, &vkDev.m_mainQueue1);
 	if (vkDev.m_mainQueue1 == nullptr)
@@ -828,6 +988,7 @@ bool initVulkanRenderDevice2WithCompute(VulkanInstance& vk, VulkanRenderDevice&
 //	VK_CHECK(vkGetBestComputeQueue(vkDev.physicalDevice, &vkDev.computeFamily));
 	vkDev.m_computeTransferFamily = findQueueFamilies(vkDev.m_physicalDevice, VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT);
 	VK_CHECK(createDevice2WithCompute(vkDev.m_physicalDevice, deviceFeatures2, vkDev.m_mainFamily, vkDev.m_computeTransferFamily, &vkDev.m_device));
+	vkDev.m_memoryBudgetSupported = isDeviceExtensionSupported(vkDev.m_physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
 
 	vkGetDeviceQueue(vkDev.m_device, vkDev.m_mainFamily, 0, &vkDev.m_mainQueue1);
 	if (vkDev.m_mainQueue1 == nullptr)
@@ -920,26 +1081,35 @@ bool initVulkanRenderDevice3(VulkanInstance& vk, VulkanRenderDevice& vkDev, uint
 {
 	
 
-	VkPhysicalDeviceDescriptorIndexingFeaturesEXT physicalDeviceDescriptorIndexingFeatures = {
-		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT,
+	//Descriptor indexing and timeline semaphores are part of the 1.2 features, which may not be chained next to
+	//their own feature structs
+	VkPhysicalDeviceVulkan12Features lv_vk12Features = {
+		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+
+		/* for the draws written by the meshlet culling pass */
+		.drawIndirectCount = VK_TRUE,
+
+		.descriptorIndexing = VK_TRUE,
 		.shaderSampledImageArrayNonUniformIndexing = VK_TRUE,
+		.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE,
+
+		/* for the bindless descriptor heap */
+		.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE,
+		.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE,
+		.descriptorBindingUpdateUnusedWhilePending = VK_TRUE,
 		.descriptorBindingPartiallyBound = VK_TRUE,
 
 		.descriptorBindingVariableDescriptorCount = VK_TRUE,
 		
 		.runtimeDescriptorArray = VK_TRUE,
-		
-	};
 
-	VkPhysicalDeviceTimelineSemaphoreFeatures lv_timeLineSemaphoreFeature{};
-	lv_timeLineSemaphoreFeature.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
-	lv_timeLineSemaphoreFeature.pNext = &physicalDeviceDescriptorIndexingFeatures;
-	lv_timeLineSemaphoreFeature.timelineSemaphore = VK_TRUE;
+		.timelineSemaphore = VK_TRUE,
+	};
 
 	VkPhysicalDeviceVulkan11Features lv_vk11Features{};
 	lv_vk11Features.shaderDrawParameters = VK_TRUE;
 	lv_vk11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
-	lv_vk11Features.pNext = &lv_timeLineSemaphoreFeature;
+	lv_vk11Features.pNext = &lv_vk12Features;
 
 
 	VkPhysicalDeviceFeatures deviceFeatures = {
@@ -1016,9 +1186,9 @@ void destroyVulkanInstance(VulkanInstance& vk)
 	vkDestroyInstance(vk.instance, nullptr);
 }
 
-bool createTextureSampler(VkDevice m_device, VkSampler* sampler, float l_mipLevels,float l_maxAnistropy ,VkFilter minFilter, VkFilter maxFilter, VkSamplerAddressMode addressMode)
+VkSamplerCreateInfo textureSamplerCreateInfo(float l_mipLevels, float l_maxAnistropy, VkFilter minFilter, VkFilter maxFilter, VkSamplerAddressMode addressMode)
 {
-	const VkSamplerCreateInfo samplerInfo = {
+	return VkSamplerCreateInfo {
 		.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
 		.pNext = nullptr,
 		.flags = 0,
@@ -1038,6 +1208,11 @@ bool createTextureSampler(VkDevice m_device, VkSampler* sampler, float l_mipLeve
 		.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK,
 		.unnormalizedCoordinates = VK_FALSE
 	};
+}
+
+bool createTextureSampler(VkDevice m_device, VkSampler* sampler, float l_mipLevels,float l_maxAnistropy ,VkFilter minFilter, VkFilter maxFilter, VkSamplerAddressMode addressMode)
+{
+	const VkSamplerCreateInfo samplerInfo = textureSamplerCreateInfo(l_mipLevels, l_maxAnistropy, minFilter, maxFilter, addressMode);
 
 	return (vkCreateSampler(m_device, &samplerInfo, nullptr, sampler) == VK_SUCCESS);
 }
@@ -1084,6 +1259,23 @@ bool isDeviceSuitable(VkPhysicalDevice m_device)
 	return isGPU && deviceFeatures.geometryShader;
 }
 
+bool isDeviceExtensionSupported(VkPhysicalDevice m_physicalDevice, const char* l_extensionName)
+{
+	uint32_t extensionCount = 0;
+	VK_CHECK(vkEnumerateDeviceExtensionProperties(m_physicalDevice, nullptr, &extensionCount, nullptr));
+
+	std::vector<VkExtensionProperties> extensions(extensionCount);
+	VK_CHECK(vkEnumerateDeviceExtensionProperties(m_physicalDevice, nullptr, &extensionCount, extensions.data()));
+
+	for (const auto& extension : extensions) {
+		if (0 == strcmp(extension.extensionName, l_extensionName)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 SwapchainSupportDetails querySwapchainSupport(VkPhysicalDevice m_device, VkSurfaceKHR surface)
 {
 	SwapchainSupportDetails details;
@@ -1235,7 +1427,11 @@ bool createGraphicsPipeline(
 	uint32_t numPatchControlPoints,
 	const std::vector<VkVertexInputBindingDescription>& l_vtxInputBindingDescs,
 	const std::vector<VkVertexInputAttributeDescription>& l_vtxInputAttribDescs,
-	bool l_enableWireframe)
+	bool l_enableWireframe,
+	VkPipelineCache l_pipelineCache,
+	const void* l_pipelineCreateInfoNext,
+	bool l_dynamicViewportState,
+	const VkSpecializationInfo* l_specializationInfo)
 {
 	std::vector<ShaderModule> shaderModules;
 	std::vector<VkPipelineShaderStageCreateInfo> shaderStages;
@@ -1251,6 +1447,7 @@ bool createGraphicsPipeline(
 		VkShaderStageFlagBits stage = glslangShaderStageToVulkan(glslangShaderStageFromFileName(file));
 
 		shaderStages[i] = shaderStageInfo(stage, shaderModules[i], "main");
+		shaderStages[i].pSpecializationInfo = l_specializationInfo;
 	}
 
 	const VkPipelineVertexInputStateCreateInfo vertexInputInfo = {
@@ -1340,14 +1537,20 @@ bool createGraphicsPipeline(
 		.maxDepthBounds = 1.0f
 	};
 
-	VkDynamicState dynamicStateElt = VK_DYNAMIC_STATE_SCISSOR;
+	VkDynamicState dynamicStateElts[2];
+	uint32_t numDynamicStates = 0;
+
+	if (dynamicScissorState)
+		dynamicStateElts[numDynamicStates++] = VK_DYNAMIC_STATE_SCISSOR;
+	if (l_dynamicViewportState)
+		dynamicStateElts[numDynamicStates++] = VK_DYNAMIC_STATE_VIEWPORT;
 
 	const VkPipelineDynamicStateCreateInfo dynamicState = {
 		.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
 		.pNext = nullptr,
 		.flags = 0,
-		.dynamicStateCount = 1,
-		.pDynamicStates = &dynamicStateElt
+		.dynamicStateCount = numDynamicStates,
+		.pDynamicStates = dynamicStateElts
 	};
 
 	const VkPipelineTessellationStateCreateInfo tessellationState = {
@@ -1359,6 +1562,7 @@ bool createGraphicsPipeline(
 
 	const VkGraphicsPipelineCreateInfo pipelineInfo = {
 		.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+		.pNext = l_pipelineCreateInfoNext,
 		.stageCount = static_cast<uint32_t>(shaderStages.size()),
 		.pStages = shaderStages.data(),
 		.pVertexInputState = &vertexInputInfo,
@@ -1369,7 +1573,7 @@ bool createGraphicsPipeline(
 		.pMultisampleState = &multisampling,
 		.pDepthStencilState = useDepth ? &depthStencil : nullptr,
 		.pColorBlendState = &colorBlending,
-		.pDynamicState = dynamicScissorState ? &dynamicState : nullptr,
+		.pDynamicState = (0 < numDynamicStates) ? &dynamicState : nullptr,
 		.layout = pipelineLayout,
 		.renderPass = renderPass,
 		.subpass = 0,
@@ -1377,7 +1581,7 @@ bool createGraphicsPipeline(
 		.basePipelineIndex = -1
 	};
 
-	VK_CHECK(vkCreateGraphicsPipelines(vkDev.m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, pipeline));
+	VK_CHECK(vkCreateGraphicsPipelines(vkDev.m_device, l_pipelineCache, 1, &pipelineInfo, nullptr, pipeline));
 
 	for (auto m: shaderModules)
 		vkDestroyShaderModule(vkDev.m_device, m.shaderModule, nullptr);
@@ -2237,20 +2441,33 @@ void GenerateImageMemBarrier(VkImageMemoryBarrier& barrier, VkImage image, VkFor
 
 void TransitionImageLayoutsCmd(VkCommandBuffer l_cmdBuffer, std::vector<VulkanTexture*>& l_images, VkImageLayout l_newLayout, uint32_t layerCount, uint32_t mipLevels, uint32_t l_baseArrayLayer, uint32_t baseMipMap)
 {
-	std::vector<VkImageMemoryBarrier> lv_barriers{};
-	lv_barriers.resize(l_images.size());
+	TransitionImageLayoutsCmd(l_cmdBuffer, l_images.data(), (uint32_t)l_images.size(), l_newLayout, layerCount, mipLevels, l_baseArrayLayer, baseMipMap);
+}
+
+
+void TransitionImageLayoutsCmd(VkCommandBuffer l_cmdBuffer, VulkanTexture* const* l_images, uint32_t l_totalNumImages, VkImageLayout l_newLayout, uint32_t layerCount, uint32_t mipLevels, uint32_t l_baseArrayLayer, uint32_t baseMipMap)
+{
+	//Barriers are recorded in fixed-size batches so that no heap memory is touched while recording a frame
+	constexpr uint32_t lv_maxNumBarriersPerBatch = 16;
+	std::array<VkImageMemoryBarrier, lv_maxNumBarriersPerBatch> lv_barriers{};
 
 	VkPipelineStageFlags lv_sourceStage;
 	VkPipelineStageFlags lv_dstStage;
 
 	DetermineBarrierPipelineStages(lv_sourceStage, lv_dstStage, l_images[0]->Layout, l_newLayout);
 
-	for (size_t i = 0; i < l_images.size(); ++i) {
-		GenerateImageMemBarrier(lv_barriers[i], l_images[i]->image.image, l_images[i]->format, l_images[i]->Layout, l_newLayout, layerCount, mipLevels, l_baseArrayLayer, baseMipMap);
-		l_images[i]->Layout = l_newLayout;
-	}
+	for (uint32_t lv_firstImage = 0; lv_firstImage < l_totalNumImages; lv_firstImage += lv_maxNumBarriersPerBatch) {
+
+		const uint32_t lv_totalNumBarriers = std::min(lv_maxNumBarriersPerBatch, l_totalNumImages - lv_firstImage);
+
+		for (uint32_t i = 0; i < lv_totalNumBarriers; ++i) {
+			auto* lv_image = l_images[lv_firstImage + i];
+			GenerateImageMemBarrier(lv_barriers[i], lv_image->image.image, lv_image->format, lv_image->Layout, l_newLayout, layerCount, mipLevels, l_baseArrayLayer, baseMipMap);
+			lv_image->Layout = l_newLayout;
+		}
 
-	vkCmdPipelineBarrier(l_cmdBuffer, lv_sourceStage, lv_dstStage, 0, 0, nullptr, 0, nullptr, lv_barriers.size(), lv_barriers.data());
+		vkCmdPipelineBarrier(l_cmdBuffer, lv_sourceStage, lv_dstStage, 0, 0, nullptr, 0, nullptr, lv_totalNumBarriers, lv_barriers.data());
+	}
 
 }
 
@@ -3289,11 +3506,12 @@ bool executeComputeShader(VulkanRenderDevice& vkDev,
 	return true;
 }
 
-VkResult createComputePipeline(VkDevice m_device, VkShaderModule computeShader, VkPipelineLayout pipelineLayout, VkPipeline* pipeline)
+VkResult createComputePipeline(VkDevice m_device, VkShaderModule computeShader, VkPipelineLayout pipelineLayout, VkPipeline* pipeline,
+	VkPipelineCache l_pipelineCache, const void* l_pipelineCreateInfoNext, const VkSpecializationInfo* l_specializationInfo)
 {
 	VkComputePipelineCreateInfo computePipelineCreateInfo = {
 		.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
-		.pNext = nullptr,
+		.pNext = l_pipelineCreateInfoNext,
 		.flags = 0,
 		.stage = {  // ShaderStageInfo, just like in graphics pipeline, but with a single COMPUTE stage
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
@@ -3302,16 +3520,14 @@ VkResult createComputePipeline(VkDevice m_device, VkShaderModule computeShader,
 			.stage = VK_SHADER_STAGE_COMPUTE_BIT,
 			.module = computeShader,
 			.pName = "main",
-			/* we don't use specialization */
-			.pSpecializationInfo = nullptr
+			.pSpecializationInfo = l_specializationInfo
 		},
 		.layout = pipelineLayout,
 		.basePipelineHandle = 0,
 		.basePipelineIndex  = 0
 	};
 
-	/* no caching, single pipeline creation*/
-	return vkCreateComputePipelines(m_device, 0, 1, &computePipelineCreateInfo, nullptr, pipeline);
+	return vkCreateComputePipelines(m_device, l_pipelineCache, 1, &computePipelineCreateInfo, nullptr, pipeline);
 }
 
 /* Default DS layout for In/Out buffer pair */
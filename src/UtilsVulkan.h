@@ -64,6 +64,9 @@ struct VulkanRenderDevice final
 	uint64_t m_timelineSemaphoreValue = (uint64_t)0;
 
 	bool m_useCompute = false;
+
+	//VK_EXT_memory_budget is enabled whenever the physical device exposes it
+	bool m_memoryBudgetSupported = false;
 };
 
 // Features we need for our Vulkan context
@@ -164,8 +167,13 @@ bool setupDebugCallbacks(VkInstance instance, VkDebugUtilsMessengerEXT* messenge
 
 VkResult createShaderModule(VkDevice m_device, ShaderModule* shader, const char* fileName);
 
+/* SPIR-V is cached in Shaders/Cache, keyed by a hash of the include-resolved source (defines included),
+   the shader stage, the compile targets and the glslang version. glslang only runs on a cache miss. */
 size_t compileShaderFile(const char* file, ShaderModule& shaderModule);
 
+/* Offline step: compiles every shader stage file of the directory into the SPIR-V cache, returns the number of failures */
+uint32_t precompileShaderDirectory(const char* directory);
+
 inline VkPipelineShaderStageCreateInfo shaderStageInfo(VkShaderStageFlagBits shaderStage, ShaderModule& module, const char* entryPoint)
 {
 	return VkPipelineShaderStageCreateInfo{
@@ -216,6 +224,8 @@ void GenerateImageMemBarrier(VkImageMemoryBarrier& l_memBarrierToFill, VkImage i
 
 
 void TransitionImageLayoutsCmd(VkCommandBuffer l_cmdBuffer, std::vector<VulkanTexture*>& l_images, VkImageLayout l_newLayout, uint32_t layerCount = 1, uint32_t mipLevels = 1, uint32_t l_baseArrayLayer = 0, uint32_t baseMipMap = 0);
+//Same as above, but for image lists that do not live in a std::vector (e.g. allocated from the per-frame arena)
+void TransitionImageLayoutsCmd(VkCommandBuffer l_cmdBuffer, VulkanTexture* const* l_images, uint32_t l_totalNumImages, VkImageLayout l_newLayout, uint32_t layerCount = 1, uint32_t mipLevels = 1, uint32_t l_baseArrayLayer = 0, uint32_t baseMipMap = 0);
 
 VkResult createDevice(VkPhysicalDevice m_physicalDevice, VkPhysicalDeviceFeatures deviceFeatures, uint32_t m_mainFamily, VkDevice* m_device);
 
@@ -225,12 +235,15 @@ size_t createSwapchainImages(VkDevice m_device, VkSwapchainKHR m_swapchain, std:
 
 VkResult createSemaphore(VkDevice m_device, VkSemaphore* outSemaphore);
 
+VkSamplerCreateInfo textureSamplerCreateInfo(float l_mipLevels = 1.f, float l_maxAnistropy = 1, VkFilter minFilter = VK_FILTER_LINEAR, VkFilter maxFilter = VK_FILTER_LINEAR, VkSamplerAddressMode addressMode = VK_SAMPLER_ADDRESS_MODE_REPEAT);
 bool createTextureSampler(VkDevice m_device, VkSampler* sampler, float l_mipLevels = 1.f,float l_maxAnistropy = 1 ,VkFilter minFilter = VK_FILTER_LINEAR, VkFilter maxFilter = VK_FILTER_LINEAR, VkSamplerAddressMode addressMode = VK_SAMPLER_ADDRESS_MODE_REPEAT);
 
 bool createDescriptorPool(VulkanRenderDevice& vkDev, uint32_t uniformBufferCount, uint32_t storageBufferCount, uint32_t samplerCount, VkDescriptorPool* descriptorPool);
 
 bool isDeviceSuitable(VkPhysicalDevice m_device);
 
+bool isDeviceExtensionSupported(VkPhysicalDevice m_physicalDevice, const char* l_extensionName);
+
 SwapchainSupportDetails querySwapchainSupport(VkPhysicalDevice m_device, VkSurfaceKHR surface);
 
 VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats);
@@ -251,6 +264,7 @@ VkFormat findDepthFormat(VkPhysicalDevice m_device);
 
 bool hasStencilComponent(VkFormat format);
 
+/* l_specializationInfo is shared by every stage, constant ids a stage does not declare are ignored by it */
 bool createGraphicsPipeline(
 	VulkanRenderDevice& vkDev,
 	VkRenderPass renderPass, VkPipelineLayout pipelineLayout,
@@ -266,9 +280,15 @@ bool createGraphicsPipeline(
 	uint32_t numPatchControlPoints,
 	const std::vector<VkVertexInputBindingDescription>& l_vtxInputBindingDescs,
 	const std::vector<VkVertexInputAttributeDescription>& l_vtxInputAttribDescs,
-	bool l_enableWireframe);
-
-VkResult createComputePipeline(VkDevice m_device, VkShaderModule computeShader, VkPipelineLayout pipelineLayout, VkPipeline* pipeline);
+	bool l_enableWireframe,
+	VkPipelineCache l_pipelineCache = VK_NULL_HANDLE,
+	const void* l_pipelineCreateInfoNext = nullptr,
+	bool l_dynamicViewportState = false,
+	const VkSpecializationInfo* l_specializationInfo = nullptr);
+
+VkResult createComputePipeline(VkDevice m_device, VkShaderModule computeShader, VkPipelineLayout pipelineLayout, VkPipeline* pipeline,
+	VkPipelineCache l_pipelineCache = VK_NULL_HANDLE, const void* l_pipelineCreateInfoNext = nullptr,
+	const VkSpecializationInfo* l_specializationInfo = nullptr);
 
 bool createSharedBuffer(VulkanRenderDevice& vkDev, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory);
 
@@ -0,0 +1,251 @@
+
+
+
+
+#include "VertexQuantization.hpp"
+#include "meshoptimizer.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+
+namespace MeshConverter
+{
+
+	namespace
+	{
+		//Width of the octahedral fields in word 3, the components themselves may use fewer bits
+		constexpr uint32_t lv_octahedralFieldBits{ 10 };
+
+		glm::vec3 NormalizeOrFallback(const glm::vec3& l_vector)
+		{
+			const float lv_length = glm::length(l_vector);
+			return (0.f < lv_length) ? l_vector / lv_length : glm::vec3{ 0.f, 0.f, 1.f };
+		}
+
+		//Maps the unit sphere onto the [-1, 1] square, the lower hemisphere is folded over the diagonals
+		glm::vec2 EncodeOctahedral(const glm::vec3& l_unitVector)
+		{
+			const glm::vec3 lv_n = l_unitVector / (std::abs(l_unitVector.x) + std::abs(l_unitVector.y) + std::abs(l_unitVector.z));
+
+			if (0.f <= lv_n.z) {
+				return glm::vec2{ lv_n.x, lv_n.y };
+			}
+
+			return glm::vec2{ (1.f - std::abs(lv_n.y)) * ((0.f <= lv_n.x) ? 1.f : -1.f),
+				(1.f - std::abs(lv_n.x)) * ((0.f <= lv_n.y) ? 1.f : -1.f) };
+		}
+
+		glm::vec3 DecodeOctahedral(const glm::vec2& l_octahedral)
+		{
+			glm::vec3 lv_n{ l_octahedral.x, l_octahedral.y, 1.f - std::abs(l_octahedral.x) - std::abs(l_octahedral.y) };
+			const float lv_fold = std::max(-lv_n.z, 0.f);
+
+			lv_n.x += (0.f <= lv_n.x) ? -lv_fold : lv_fold;
+			lv_n.y += (0.f <= lv_n.y) ? -lv_fold : lv_fold;
+
+			return glm::normalize(lv_n);
+		}
+
+		uint32_t PackSnorm(float l_value, uint32_t l_bits)
+		{
+			return (uint32_t)meshopt_quantizeSnorm(l_value, (int)l_bits) & ((1U << l_bits) - 1U);
+		}
+
+		//Sign extends the field like bitfieldExtract() on an int does in the shaders
+		float UnpackSnorm(uint32_t l_word, uint32_t l_offset, uint32_t l_bits)
+		{
+			const int32_t lv_value = (int32_t)(l_word << (32U - l_offset - l_bits)) >> (32U - l_bits);
+			return std::max((float)lv_value / (float)((1 << (l_bits - 1U)) - 1), -1.f);
+		}
+
+		//meshopt_quantizeHalf() flushes denormals, so only zeros, normal numbers, inf and nan show up
+		float HalfToFloat(uint32_t l_half)
+		{
+			const uint32_t lv_exponent = (l_half >> 10) & 0x1FU;
+			const uint32_t lv_mantissa = l_half & 0x3FFU;
+
+			uint32_t lv_bits = (l_half & 0x8000U) << 16;
+
+			if (0x1FU == lv_exponent) {
+				lv_bits |= 0x7F800000U | (lv_mantissa << 13);
+			}
+			else if (0U != lv_exponent) {
+				lv_bits |= ((lv_exponent + 112U) << 23) | (lv_mantissa << 13);
+			}
+
+			float lv_value{};
+			memcpy(&lv_value, &lv_bits, sizeof(float));
+			return lv_value;
+		}
+
+		float AngleInDegrees(const glm::vec3& l_a, const glm::vec3& l_b)
+		{
+			return glm::degrees(std::acos(std::clamp(glm::dot(l_a, l_b), -1.f, 1.f)));
+		}
+	}
+
+
+
+	VertexQuantizer::VertexQuantizer(const VertexQuantizationSettings& l_settings)
+		:m_settings(l_settings)
+	{
+		if (8U > m_settings.m_octahedralBits || lv_octahedralFieldBits < m_settings.m_octahedralBits) {
+			printf("Octahedral normals and tangents have to use 8 to 10 bits, %u was requested.\n", m_settings.m_octahedralBits);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+
+	float VertexQuantizer::CalculatePositionDequantization(std::span<const float> l_vertices, Mesh& l_mesh) const
+	{
+		glm::vec3 lv_min{ std::numeric_limits<float>::max() };
+		glm::vec3 lv_max{ std::numeric_limits<float>::lowest() };
+
+		for (uint32_t i = 0; i < l_mesh.m_vertexCount; ++i) {
+			const glm::vec3 lv_position{ l_vertices[i * lv_fp32VertexSizeInFloats],
+				l_vertices[i * lv_fp32VertexSizeInFloats + 1], l_vertices[i * lv_fp32VertexSizeInFloats + 2] };
+
+			lv_min = glm::min(lv_min, lv_position);
+			lv_max = glm::max(lv_max, lv_position);
+		}
+
+		if (0U == l_mesh.m_vertexCount) {
+			lv_min = lv_max = glm::vec3{ 0.f };
+		}
+
+		const glm::vec3 lv_center = (lv_min + lv_max) * 0.5f;
+		const glm::vec3 lv_halfExtent = (lv_max - lv_min) * 0.5f;
+
+		for (uint32_t i = 0; i < 3; ++i) {
+			l_mesh.m_positionOffset[i] = lv_center[i];
+
+			//Half positions only get re-centered, they keep their own exponent
+			l_mesh.m_positionScale[i] = (PositionEncoding::m_half == m_settings.m_positionEncoding || 0.f >= lv_halfExtent[i])
+				? 1.f : lv_halfExtent[i];
+		}
+
+		return 2.f * std::max({ lv_halfExtent.x, lv_halfExtent.y, lv_halfExtent.z });
+	}
+
+
+	void VertexQuantizer::QuantizeMesh(std::span<const float> l_vertices, Mesh& l_mesh, std::span<uint32_t> l_packedVertices)
+	{
+		const float lv_meshExtent = CalculatePositionDequantization(l_vertices, l_mesh);
+		const uint32_t lv_bits = m_settings.m_octahedralBits;
+
+		std::array<float, lv_fp32VertexSizeInFloats> lv_decodedVertex{};
+
+		for (uint32_t i = 0; i < l_mesh.m_vertexCount; ++i) {
+
+			const float* lv_vertex = l_vertices.data() + i * lv_fp32VertexSizeInFloats;
+			uint32_t* lv_packedVertex = l_packedVertices.data() + i * lv_packedVertexSizeInWords;
+
+			std::array<uint32_t, 3> lv_position{};
+
+			for (uint32_t j = 0; j < 3; ++j) {
+				const float lv_localPosition = (lv_vertex[j] - l_mesh.m_positionOffset[j]) / l_mesh.m_positionScale[j];
+
+				lv_position[j] = (PositionEncoding::m_half == m_settings.m_positionEncoding)
+					? (uint32_t)meshopt_quantizeHalf(lv_localPosition) : PackSnorm(lv_localPosition, 16U);
+			}
+
+			const glm::vec2 lv_normal = EncodeOctahedral(NormalizeOrFallback(glm::vec3{ lv_vertex[5], lv_vertex[6], lv_vertex[7] }));
+			const glm::vec2 lv_tangent = EncodeOctahedral(NormalizeOrFallback(glm::vec3{ lv_vertex[8], lv_vertex[9], lv_vertex[10] }));
+
+			lv_packedVertex[0] = lv_position[0] | (lv_position[1] << 16);
+			lv_packedVertex[1] = lv_position[2] | (PackSnorm(lv_tangent.y, lv_bits) << 16);
+			lv_packedVertex[2] = (uint32_t)meshopt_quantizeHalf(lv_vertex[3]) | ((uint32_t)meshopt_quantizeHalf(lv_vertex[4]) << 16);
+			lv_packedVertex[3] = PackSnorm(lv_normal.x, lv_bits) | (PackSnorm(lv_normal.y, lv_bits) << lv_octahedralFieldBits)
+				| (PackSnorm(lv_tangent.x, lv_bits) << (2U * lv_octahedralFieldBits));
+
+			DecodeVertex(lv_packedVertex, l_mesh, lv_decodedVertex.data());
+			AccumulateError(lv_vertex, lv_decodedVertex.data(), lv_meshExtent);
+		}
+	}
+
+
+	void VertexQuantizer::DecodeVertex(const uint32_t* l_packedVertex, const Mesh& l_mesh, float* l_vertex) const
+	{
+		const uint32_t lv_bits = m_settings.m_octahedralBits;
+		const std::array<uint32_t, 3> lv_position{ l_packedVertex[0] & 0xFFFFU, l_packedVertex[0] >> 16, l_packedVertex[1] & 0xFFFFU };
+
+		for (uint32_t i = 0; i < 3; ++i) {
+			const float lv_localPosition = (PositionEncoding::m_half == m_settings.m_positionEncoding)
+				? HalfToFloat(lv_position[i]) : UnpackSnorm(lv_position[i], 0U, 16U);
+
+			l_vertex[i] = l_mesh.m_positionOffset[i] + l_mesh.m_positionScale[i] * lv_localPosition;
+		}
+
+		l_vertex[3] = HalfToFloat(l_packedVertex[2] & 0xFFFFU);
+		l_vertex[4] = HalfToFloat(l_packedVertex[2] >> 16);
+
+		const glm::vec3 lv_normal = DecodeOctahedral(glm::vec2{ UnpackSnorm(l_packedVertex[3], 0U, lv_bits),
+			UnpackSnorm(l_packedVertex[3], lv_octahedralFieldBits, lv_bits) });
+		const glm::vec3 lv_tangent = DecodeOctahedral(glm::vec2{ UnpackSnorm(l_packedVertex[3], 2U * lv_octahedralFieldBits, lv_bits),
+			UnpackSnorm(l_packedVertex[1], 16U, lv_bits) });
+
+		for (uint32_t i = 0; i < 3; ++i) {
+			l_vertex[5 + i] = lv_normal[i];
+			l_vertex[8 + i] = lv_tangent[i];
+		}
+
+		l_vertex[11] = 1.f;
+	}
+
+
+	void VertexQuantizer::AccumulateError(const float* l_reference, const float* l_decoded, float l_meshExtent)
+	{
+		const float lv_positionError = glm::length(glm::vec3{ l_reference[0], l_reference[1], l_reference[2] }
+			- glm::vec3{ l_decoded[0], l_decoded[1], l_decoded[2] });
+
+		m_sumPositionError += lv_positionError;
+		m_maxPositionError = std::max(m_maxPositionError, lv_positionError);
+
+		if (0.f < l_meshExtent) {
+			m_maxRelativePositionError = std::max(m_maxRelativePositionError, lv_positionError / l_meshExtent);
+		}
+
+		m_maxUVError = std::max({ m_maxUVError, std::abs(l_reference[3] - l_decoded[3]), std::abs(l_reference[4] - l_decoded[4]) });
+
+		const float lv_normalAngle = AngleInDegrees(NormalizeOrFallback(glm::vec3{ l_reference[5], l_reference[6], l_reference[7] }),
+			glm::vec3{ l_decoded[5], l_decoded[6], l_decoded[7] });
+		const float lv_tangentAngle = AngleInDegrees(NormalizeOrFallback(glm::vec3{ l_reference[8], l_reference[9], l_reference[10] }),
+			glm::vec3{ l_decoded[8], l_decoded[9], l_decoded[10] });
+
+		m_sumNormalAngle += lv_normalAngle;
+		m_maxNormalAngle = std::max(m_maxNormalAngle, lv_normalAngle);
+		m_sumTangentAngle += lv_tangentAngle;
+		m_maxTangentAngle = std::max(m_maxTangentAngle, lv_tangentAngle);
+
+		++m_totalNumVertices;
+	}
+
+
+	void VertexQuantizer::PrintErrorReport() const
+	{
+		printf("\nVertex quantization: %u -> %u bytes per vertex, %s positions, %u bit octahedral normals and tangents.\n",
+			(uint32_t)(lv_fp32VertexSizeInFloats * sizeof(float)), (uint32_t)(lv_packedVertexSizeInWords * sizeof(uint32_t)),
+			(PositionEncoding::m_half == m_settings.m_positionEncoding) ? "fp16" : "snorm16", m_settings.m_octahedralBits);
+
+		if (0U == m_totalNumVertices) {
+			printf("No vertices were quantized.\n");
+			return;
+		}
+
+		const double lv_totalNumVertices = (double)m_totalNumVertices;
+
+		printf("Error against the fp32 reference over %llu vertices:\n", (unsigned long long)m_totalNumVertices);
+		printf("  Position: max %f, avg %f, max %f%% of the mesh extent\n", m_maxPositionError,
+			m_sumPositionError / lv_totalNumVertices, m_maxRelativePositionError * 100.f);
+		printf("  UV:       max %f\n", m_maxUVError);
+		printf("  Normal:   max %f, avg %f degrees\n", m_maxNormalAngle, m_sumNormalAngle / lv_totalNumVertices);
+		printf("  Tangent:  max %f, avg %f degrees\n\n", m_maxTangentAngle, m_sumTangentAngle / lv_totalNumVertices);
+	}
+
+}
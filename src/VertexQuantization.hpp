@@ -0,0 +1,77 @@
+#pragma once
+
+
+
+#include "Mesh.hpp"
+#include "MeshFileHeader.hpp"
+#include <cinttypes>
+#include <span>
+
+
+
+namespace MeshConverter
+{
+
+	struct VertexQuantizationSettings final
+	{
+		bool m_enabled{ false };
+		PositionEncoding m_positionEncoding{ PositionEncoding::m_snorm16 };
+
+		//Bits per octahedral component of the normal and the tangent, 8 to 10
+		uint32_t m_octahedralBits{ 10 };
+	};
+
+
+	//Packs the 12 float vertices of GeometryConverter (position, uv, normal, tangent) into 4 words:
+	//  word 0: position.x | position.y << 16
+	//  word 1: position.z | octahedral tangent.y << 16
+	//  word 2: half uv.x | half uv.y << 16
+	//  word 3: octahedral normal.x | normal.y << 10 | tangent.x << 20
+	//Snorm16 positions are relative to the bounds of the mesh and fp16 positions relative to its center, the Mesh
+	//keeps the offset and scale that undo this. Octahedral components are two's complement snorms in 10 bit fields.
+	//The tangent w is dropped, nothing reads it. Indirect.vert and DepthMapLight.vert decode the same layout.
+	//Every packed vertex is decoded again and compared against its fp32 source for PrintErrorReport().
+	class VertexQuantizer final
+	{
+	public:
+
+		explicit VertexQuantizer(const VertexQuantizationSettings& l_settings);
+
+		VertexQuantizer(const VertexQuantizer&) = delete;
+		VertexQuantizer& operator=(const VertexQuantizer&) = delete;
+
+		//Fills the position offset and scale of l_mesh, l_packedVertices has lv_packedVertexSizeInWords per vertex
+		void QuantizeMesh(std::span<const float> l_vertices, Mesh& l_mesh, std::span<uint32_t> l_packedVertices);
+
+		void PrintErrorReport() const;
+
+	private:
+
+		//Returns the largest extent of the mesh, the reference for the relative position error
+		float CalculatePositionDequantization(std::span<const float> l_vertices, Mesh& l_mesh) const;
+
+		//Same math as the vertex pulling shaders, l_vertex receives 12 floats with a tangent w of 1
+		void DecodeVertex(const uint32_t* l_packedVertex, const Mesh& l_mesh, float* l_vertex) const;
+
+		void AccumulateError(const float* l_reference, const float* l_decoded, float l_meshExtent);
+
+
+		VertexQuantizationSettings m_settings{};
+
+		uint64_t m_totalNumVertices{ 0 };
+
+		//Position errors are in scene units and relative to the largest extent of the mesh
+		double m_sumPositionError{ 0. };
+		float m_maxPositionError{ 0.f };
+		float m_maxRelativePositionError{ 0.f };
+
+		float m_maxUVError{ 0.f };
+
+		//Angles in degrees
+		double m_sumNormalAngle{ 0. };
+		float m_maxNormalAngle{ 0.f };
+		double m_sumTangentAngle{ 0. };
+		float m_maxTangentAngle{ 0.f };
+	};
+
+}
@@ -6,6 +6,7 @@
 #include "Renderbase.hpp"
 #include <array>
 #include "CameraStructure.hpp"
+#include "AllocationCounter.hpp"
 
 
 namespace VulkanEngine
@@ -17,6 +18,7 @@ namespace VulkanEngine
 		,m_fullScreenHeight(l_screenHeight)
 		,m_fullScreenWidth(l_screenWidth)
 	{
+		m_frameArenas.resize(m_vulkanContextCreator.m_vkDev.m_swapchainImages.size());
 		m_frameGraph.emplace(l_frameGraphJSONFile, *this);
 
 	}
@@ -43,6 +45,23 @@ namespace VulkanEngine
 		return m_cpuResourceProvider;
 	}
 
+	FrameLinearArena& VulkanRenderContext::GetFrameArena(uint32_t l_currentImageIndex)
+	{
+		return m_frameArenas[l_currentImageIndex];
+	}
+
+
+	void VulkanRenderContext::ReportSteadyStateAllocations(const char* l_stageName,
+		uint64_t l_totalNumAllocationsBefore)
+	{
+		const uint64_t lv_totalNumAllocations = AllocationCounter::GetTotalNumAllocations() - l_totalNumAllocationsBefore;
+
+		if (m_totalNumFramesRecorded > m_frameArenas.size() && 0 != lv_totalNumAllocations) {
+			printf("Steady-state frame %llu: %s performed %llu heap allocations.\n",
+				(unsigned long long)m_totalNumFramesRecorded, l_stageName, (unsigned long long)lv_totalNumAllocations);
+		}
+	}
+
 
 	void VulkanRenderContext::UpdateBuffers(uint32_t l_currentImageIndex,
 		const CameraStructure& l_cameraStructure)
@@ -54,6 +73,11 @@ namespace VulkanEngine
 	void VulkanRenderContext::UpdateRenderers(uint32_t L_currentImageIndex, 
 		const CameraStructure& l_cameraStructure)
 	{
+		const uint64_t lv_totalNumAllocationsBefore = AllocationCounter::GetTotalNumAllocations();
+
+		m_frameArenas[L_currentImageIndex].Reset();
+		m_vulkanResources.GetUniformArena().BeginFrame(L_currentImageIndex);
+		m_vulkanResources.CollectRetiredResources();
 
 		UpdateBuffers(L_currentImageIndex, l_cameraStructure);
 		
@@ -61,6 +85,16 @@ namespace VulkanEngine
 			l_renderers.m_rendererBase.UpdateStorageBuffers(L_currentImageIndex);
 		} 
 
+		//Uploads recorded this frame go out ahead of the frame's own submit on the same queue
+		{
+			std::lock_guard lv_lock{ m_vulkanResources.GetMainQueueMutex() };
+			m_vulkanResources.GetStagingRing().Flush();
+		}
+
+		//Descriptors of everything created since the last frame, before any command buffer of this frame is recorded
+		m_vulkanResources.GetBindlessHeap().FlushPendingWrites();
+
+		ReportSteadyStateAllocations("UpdateRenderers()", lv_totalNumAllocationsBefore);
 	}
 
 
@@ -117,8 +151,13 @@ namespace VulkanEngine
 		//	  m_clearRenderPassUsed = true;
 		//  }
 	 // }
+	  const uint64_t lv_totalNumAllocationsBefore = AllocationCounter::GetTotalNumAllocations();
+
 	  m_frameGraph.value().RenderGraph(l_cmdBuffer, l_currentImageIndex);
 
+	  ReportSteadyStateAllocations("CreateFrame()", lv_totalNumAllocationsBefore);
+	  ++m_totalNumFramesRecorded;
+
 
 	}
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <vector>
 #include <cassert>
 #include "FrameGraph.hpp"
+#include "FrameLinearArena.hpp"
 #include <optional>
 
 namespace VulkanEngine
@@ -43,6 +44,9 @@ namespace VulkanEngine
 
 		VulkanEngine::CpuResourceServiceProvider& GetCpuResourceProvider();
 
+		//Transient per-frame memory. It is rewound at the start of UpdateRenderers() for the given image.
+		FrameLinearArena& GetFrameArena(uint32_t l_currentImageIndex);
+
 		uint32_t GetFullScreenWidth() const;
 		uint32_t GetFullScreenHeight() const;
 
@@ -55,6 +59,8 @@ namespace VulkanEngine
 
 		void UpdateBuffers(uint32_t L_currentImageIndex, const CameraStructure& l_cameraStructure);
 
+		void ReportSteadyStateAllocations(const char* l_stageName, uint64_t l_totalNumAllocationsBefore);
+
 	private:
 
 		bool m_clearRenderPassUsed{ false };
@@ -63,6 +69,11 @@ namespace VulkanEngine
 		RenderCore::VulkanResourceManager m_vulkanResources;
 		VulkanEngine::CpuResourceServiceProvider m_cpuResourceProvider;
 		std::optional<FrameGraph> m_frameGraph;
+		std::vector<FrameLinearArena> m_frameArenas;
+
+		//Frames recorded so far. The first few frames are allowed to allocate (lazy initializations),
+		//the allocation counter only reports after them.
+		uint64_t m_totalNumFramesRecorded{};
 
 		uint32_t m_fullScreenWidth{};
 		uint32_t m_fullScreenHeight{};
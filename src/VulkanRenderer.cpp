@@ -11,7 +11,8 @@
 namespace VulkanEngine
 {
 
-	VulkanRenderer::VulkanRenderer(int l_width, int l_height, const std::string& l_frameGraphPath)
+	VulkanRenderer::VulkanRenderer(int l_width, int l_height, const std::string& l_frameGraphPath, bool l_benchmarkPipelineThreads,
+		bool l_benchmarkDescriptorUpdates)
 		:CameraApp(l_width, l_height, l_frameGraphPath),
 		//m_clearSwapchainDepth(ctx_),
 		m_depthMapLightPlusX(ctx_, "Shaders/DepthMapLight.vert", "Shaders/DepthMapLight.frag", "Shaders/Spirv/DepthMapLight.spv", "DepthMapOmnidirectionalPointLight0", glm::vec3{ -13.f, 18.f, -2.f }, glm::vec3{ -13.f, 18.f, -2.f } + glm::vec3{ 1.f, 0.f, 0.f }, glm::vec3{0.f, -1.f, 0.f}, 0),
@@ -177,6 +178,38 @@ namespace VulkanEngine
 
 
 		m_pointLightCube.Init(vertices, indices, "Shaders/PointLightCube.vert", "Shaders/PointLightCube.frag", "Shaders/Spirv/PointLightCube.spv");
+
+		//Every renderer above only requested its pipelines, they are all compiled and created here at once
+		if (true == l_benchmarkPipelineThreads) {
+			ctx_.GetResourceManager().BenchmarkRequestedPipelines();
+		}
+		ctx_.GetResourceManager().CreateRequestedPipelines();
+		//Pipelines of disabled nodes and debug views are built in the background until something needs them
+		ctx_.GetResourceManager().PrewarmDeferredPipelines();
+
+		//Nothing has been submitted with the descriptor sets yet, so they can still be rewritten
+		if (true == l_benchmarkDescriptorUpdates) {
+			ctx_.GetFrameGraph().BenchmarkDescriptorUpdates(1000);
+		}
+
+		auto& lv_stagingRing = ctx_.GetResourceManager().GetStagingRing();
+		{
+			std::lock_guard lv_lock{ ctx_.GetResourceManager().GetMainQueueMutex() };
+			lv_stagingRing.FlushAndWait();
+		}
+		printf("\nScene uploads went through %llu staging submits.\n", (unsigned long long)lv_stagingRing.GetTotalNumSubmits());
+
+		//Loading is done and nothing has been submitted yet, the moved buffers are picked up by rewriting the descriptor sets
+		if (false == ctx_.GetResourceManager().DefragmentBuffers().empty()) {
+			ctx_.GetFrameGraph().UpdateDescriptorSets();
+		}
+
+		const auto& lv_samplerCache = ctx_.GetResourceManager().GetSamplerCache();
+		printf("\n%u sampler requests were served by %u samplers.\n", lv_samplerCache.GetTotalNumRequests(),
+			lv_samplerCache.GetTotalNumSamplers());
+
+		ctx_.GetResourceManager().PrintObjectCacheStats();
+		ctx_.GetResourceManager().PrintMemoryStats();
 		
 		////ctx_.m_offScreenRenderers.emplace_back(m_interior, true, true);
 		//ctx_.m_offScreenRenderers.emplace_back(m_exterior, true, true);
@@ -33,7 +33,10 @@ namespace VulkanEngine
 	class VulkanRenderer : public CameraApp
 	{
 	public:
-		VulkanRenderer(int l_width, int l_height, const std::string& l_frameGraphPath);
+		//With l_benchmarkPipelineThreads the load time pipelines are built once per thread count before they are created,
+		//with l_benchmarkDescriptorUpdates the descriptor sets of the frame graph are rewritten with and without templates
+		VulkanRenderer(int l_width, int l_height, const std::string& l_frameGraphPath, bool l_benchmarkPipelineThreads = false,
+			bool l_benchmarkDescriptorUpdates = false);
 
 		GLFWwindow* GetWindow();
 	protected:
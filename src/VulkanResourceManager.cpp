@@ -4,20 +4,31 @@
 
 #include "VulkanResourceManager.hpp"
 #include "VulkanEngineCore.hpp"
+#include "stb_image.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <format>
+#include <fstream>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+#include <thread>
 
 
 namespace RenderCore
 {
 
-	VulkanResourceManager::VulkanResourceManager(VulkanRenderDevice& l_renderDevice)
-		:m_renderDevice(l_renderDevice) {
+	VulkanResourceManager::VulkanResourceManager(VulkanRenderDevice& l_renderDevice,
+		VkDeviceSize l_stagingRingSizeInBytes, const std::string& l_pipelineCacheFilePath,
+		VkDeviceSize l_uniformArenaSizeInBytes, VkDeviceSize l_geometryHeapVertexSizeInBytes,
+		VkDeviceSize l_geometryHeapIndexSizeInBytes)
+		:m_renderDevice(l_renderDevice), m_gpuMemoryAllocator(l_renderDevice), m_samplerCache(l_renderDevice),
+		m_bindlessHeap(l_renderDevice, m_samplerCache), m_pipelineCache(l_renderDevice, l_pipelineCacheFilePath) {
 
 		auto lv_totalNumSwapchhains = l_renderDevice.m_swapchainImages.size();
 
-		m_buffers.reserve(64);
-		m_textures.reserve(512);
-
 		m_frameBuffers.reserve(64);
 		m_renderPasses.reserve(64);
 
@@ -27,6 +38,27 @@ namespace RenderCore
 		m_pipelineLayouts.reserve(64);
 		m_Pipelines.reserve(64);
 
+		m_pipelineGenerations.reserve(64);
+		m_pipelineUseCounts.reserve(64);
+
+		m_retiredResources.reserve(64);
+		m_totalNumFramesInFlight = (uint32_t)lv_totalNumSwapchhains;
+
+		auto& lv_stagingRingBuffer = CreateBuffer(l_stagingRingSizeInBytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, "StagingRingBuffer",
+			GpuMemoryCategory::m_staging);
+		m_stagingRingBufferHandle = RetrieveGpuBufferHandle("StagingRingBuffer");
+		m_stagingRing.emplace(l_renderDevice, lv_stagingRingBuffer, (uint32_t)lv_totalNumSwapchhains);
+
+		auto& lv_uniformArenaBuffer = CreateBuffer(l_uniformArenaSizeInBytes, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, "UniformFrameArenaBuffer",
+			GpuMemoryCategory::m_uniforms);
+		m_uniformArenaBufferHandle = RetrieveGpuBufferHandle("UniformFrameArenaBuffer");
+		m_uniformArena.emplace(l_renderDevice, lv_uniformArenaBuffer, (uint32_t)lv_totalNumSwapchhains);
+
+		m_geometryHeap.emplace(l_renderDevice, *this, l_geometryHeapVertexSizeInBytes, l_geometryHeapIndexSizeInBytes,
+			(uint32_t)lv_totalNumSwapchhains);
+
 		for (size_t i = 0; i < lv_totalNumSwapchhains; ++i) {
 
 			VulkanTexture lv_swapchain{};
@@ -38,13 +70,13 @@ namespace RenderCore
 			lv_swapchain.image.image = l_renderDevice.m_swapchainImages[i];
 			lv_swapchain.image.imageView0 = l_renderDevice.m_swapchainImageViews[i];
 
-			m_textures.push_back(lv_swapchain);
+			auto lv_swapchainHandle = PushTexture(lv_swapchain);
 
 
 			std::string lv_formattedString{ "Swapchain {}" };
 			auto lv_formattedArgs = std::make_format_args(i);
 
-			AddGpuResource(std::vformat(lv_formattedString, lv_formattedArgs).c_str(), i, VulkanDataType::m_texture);
+			AddGpuResource(std::vformat(lv_formattedString, lv_formattedArgs).c_str(), lv_swapchainHandle);
 		}
 
 		for (size_t i = 0; i < lv_totalNumSwapchhains; ++i) {
@@ -52,9 +84,10 @@ namespace RenderCore
 			std::string lv_formattedString{ "Depth {}" };
 			auto lv_formattedArgs = std::make_format_args(i);
 
-			auto lv_depthHandle = CreateDepthTextureWithHandle(std::vformat(lv_formattedString, lv_formattedArgs).c_str());
+			auto lv_depthHandle = CreateDepthTextureWithHandle(std::vformat(lv_formattedString, lv_formattedArgs).c_str(),
+				GpuMemoryCategory::m_gbuffer);
 
-			AddGpuResource(std::vformat(lv_formattedString, lv_formattedArgs).c_str(), lv_depthHandle,VulkanDataType::m_texture);
+			AddGpuResource(std::vformat(lv_formattedString, lv_formattedArgs).c_str(), lv_depthHandle);
 		}
 
 
@@ -65,7 +98,7 @@ namespace RenderCore
 	}
 
 	uint32_t VulkanResourceManager::CreateFrameBufferCubemapFace(const RenderPass& l_renderpass,
-		uint32_t l_textureHandle,
+		TextureHandle l_textureHandle,
 		uint32_t l_cubemapLayer,
 		const char* l_nameFramebuffer)
 	{
@@ -73,7 +106,7 @@ namespace RenderCore
 
 		VkFramebuffer lv_frameBufferToCreate{};
 
-		assert(l_textureHandle != std::numeric_limits<uint32_t>::max());
+		assert(true == l_textureHandle.IsValid());
 		assert(0 <= l_cubemapLayer && l_cubemapLayer <= 5);
 
 		auto& lv_cubemapTexture = RetrieveGpuTexture(l_textureHandle);
@@ -148,13 +181,9 @@ namespace RenderCore
 		lv_depthTextureToCreate.depth = 1U;
 
 
-		if (false == createImage(m_renderDevice.m_device, m_renderDevice.m_physicalDevice, lv_depthTextureToCreate.width,
-			lv_depthTextureToCreate.height, lv_depthTextureToCreate.format, VK_IMAGE_TILING_OPTIMAL,
-			VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-			lv_depthTextureToCreate.image.image, lv_depthTextureToCreate.image.imageMemory
-			, VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT)) {
-			PRINT_EXIT("\nFailed to create depth texture.\n");
-		}
+		CreateSubAllocatedImage(lv_depthTextureToCreate.width, lv_depthTextureToCreate.height,
+			lv_depthTextureToCreate.format, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+			VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT, 1, GpuMemoryCategory::m_shadows, lv_depthTextureToCreate.image);
 
 
 		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
@@ -246,26 +275,16 @@ namespace RenderCore
 		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
 
 
-		if (false == createTextureSampler(m_renderDevice.m_device, &lv_depthTextureToCreate.sampler ,1.f
-										, 1.f, VK_FILTER_LINEAR, VK_FILTER_LINEAR
-										, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER)) {
-			PRINT_EXIT("\nFailed to create image sampler for depth texture.\n");
-		}
-
-
-		std::string lv_samplerName{ l_textureName + "-sampler " };
-		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_depthTextureToCreate.sampler);
-		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_SAMPLER;
-		lv_objectNameInfo.pNext = nullptr;
-		lv_objectNameInfo.pObjectName = lv_samplerName.c_str();
-		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
-
+		lv_depthTextureToCreate.sampler = m_samplerCache.Acquire(textureSamplerCreateInfo(VK_LOD_CLAMP_NONE,
+			1.f, VK_FILTER_LINEAR, VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER));
 
-		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
 
+		{
+			std::lock_guard lv_lock{ m_mainQueueMutex };
 
-		transitionImageLayout(m_renderDevice, lv_depthTextureToCreate.image.image, lv_depthTextureToCreate.format,
-			VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 6);
+			transitionImageLayout(m_renderDevice, lv_depthTextureToCreate.image.image, lv_depthTextureToCreate.format,
+				VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 6);
+		}
 
 		lv_depthTextureToCreate.Layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
@@ -277,86 +296,168 @@ namespace RenderCore
 		lv_depthTextureToCreate.l_cubemapFace5Layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
 
-		m_textures.push_back(lv_depthTextureToCreate);
+		auto lv_textureHandle = PushTexture(lv_depthTextureToCreate);
 
-		GpuResourceMetaData lv_textureMetaData{};
-		lv_textureMetaData.m_resourceHandle = (uint32_t)m_textures.size() - 1;
-		lv_textureMetaData.m_vkDataType = VulkanDataType::m_texture;
+		AddGpuResource(l_textureName.c_str(), lv_textureHandle);
 
-		m_gpuResourcesHandles.emplace(std::string{ l_textureName }, lv_textureMetaData);
+		return m_textures[lv_textureHandle.m_index];
 
-		return m_textures[m_textures.size() - 1];
+	}
+
+
+	void VulkanResourceManager::CopyDataToLocalBuffer(const BufferHandle l_bufferHandle, const void* l_bufferData)
+	{
+		auto& lv_buffer = RetrieveGpuBuffer(l_bufferHandle);
 
+		std::lock_guard lv_lock{ m_mainQueueMutex };
+		m_stagingRing->UploadToBuffer(lv_buffer.buffer, 0, l_bufferData, lv_buffer.size);
 	}
 
 
-	void VulkanResourceManager::CopyDataToLocalBuffer(VkQueue l_queue, VkCommandBuffer l_cmdBuffer,
-		const uint32_t l_bufferHandle, const void* l_bufferData)
+	void VulkanResourceManager::UploadTexture2D(VulkanTexture& l_texture, const void* l_texels, VkImageLayout l_finalLayout)
 	{
-		using namespace ErrorCheck;
+		std::lock_guard lv_lock{ m_mainQueueMutex };
+
+		transitionImageLayoutCmd(m_stagingRing->GetCommandBuffer(), l_texture.image.image, l_texture.format,
+			l_texture.Layout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+		m_stagingRing->UploadToImage(l_texture.image.image, l_texture.width, l_texture.height, 1,
+			bytesPerTexFormat(l_texture.format), l_texels);
 
+		transitionImageLayoutCmd(m_stagingRing->GetCommandBuffer(), l_texture.image.image, l_texture.format,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, l_finalLayout);
+
+		l_texture.Layout = l_finalLayout;
+	}
+
+
+	void VulkanResourceManager::CopyDataToLocalBuffer(const BufferHandle l_bufferHandle, VkDeviceSize l_dstOffset,
+		const void* l_data, VkDeviceSize l_sizeInBytes)
+	{
+		using namespace ErrorCheck;
 
 		auto& lv_buffer = RetrieveGpuBuffer(l_bufferHandle);
 
-		auto& lv_stagingBuffer = CreateBuffer(lv_buffer.size,
-			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
-			, "TemporaryStagingBufferForDataCopy ");
+		if (l_dstOffset + l_sizeInBytes > lv_buffer.size) {
+			PRINT_EXIT("\nUpload goes past the end of the buffer.\n");
+		}
+
+		std::lock_guard lv_lock{ m_mainQueueMutex };
+		m_stagingRing->UploadToBuffer(lv_buffer.buffer, l_dstOffset, l_data, l_sizeInBytes);
+	}
+
+
+	void VulkanResourceManager::CopyBufferRegionsAndWait(const BufferHandle l_srcBufferHandle,
+		const BufferHandle l_dstBufferHandle, const std::vector<VkBufferCopy>& l_regions)
+	{
+		using namespace ErrorCheck;
+
+		if (true == l_regions.empty()) {
+			return;
+		}
+
+		const VkBuffer lv_srcBuffer = RetrieveGpuBuffer(l_srcBufferHandle).buffer;
+		const VkBuffer lv_dstBuffer = RetrieveGpuBuffer(l_dstBufferHandle).buffer;
+
+		std::lock_guard lv_lock{ m_mainQueueMutex };
+
+		//Pending uploads may still target the source regions
+		m_stagingRing->FlushAndWait();
+		VULKAN_CHECK(vkDeviceWaitIdle(m_renderDevice.m_device));
+
+		VkCommandBuffer lv_commandBuffer = beginSingleTimeCommands(m_renderDevice);
+
+		//Earlier submits wrote the source, later draws read the destination
+		const VkMemoryBarrier lv_beforeCopyBarrier{ .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER, .pNext = nullptr,
+			.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT };
+		vkCmdPipelineBarrier(lv_commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0, 1, &lv_beforeCopyBarrier, 0, nullptr, 0, nullptr);
+
+		vkCmdCopyBuffer(lv_commandBuffer, lv_srcBuffer, lv_dstBuffer, (uint32_t)l_regions.size(), l_regions.data());
+
+		const VkMemoryBarrier lv_afterCopyBarrier{ .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER, .pNext = nullptr,
+			.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT };
+		vkCmdPipelineBarrier(lv_commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			0, 1, &lv_afterCopyBarrier, 0, nullptr, 0, nullptr);
+
+		endSingleTimeCommands(m_renderDevice, lv_commandBuffer);
+	}
 
 
-		memcpy(lv_stagingBuffer.ptr, l_bufferData, lv_buffer.size);
+	GeometryHeap& VulkanResourceManager::GetGeometryHeap()
+	{
+		return *m_geometryHeap;
+	}
+
+
+	StagingRingBuffer& VulkanResourceManager::GetStagingRing()
+	{
+		return *m_stagingRing;
+	}
+
+
+	std::mutex& VulkanResourceManager::GetMainQueueMutex()
+	{
+		return m_mainQueueMutex;
+	}
+
+
+	UniformFrameArena& VulkanResourceManager::GetUniformArena()
+	{
+		return *m_uniformArena;
+	}
 
 
-		VkBufferCopy lv_bufferCopy = {};
-		lv_bufferCopy.size = lv_buffer.size;
+	VkSampler VulkanResourceManager::AcquireSampler(const VkSamplerCreateInfo& l_samplerCreateInfo)
+	{
+		return m_samplerCache.Acquire(l_samplerCreateInfo);
+	}
 
-		VkCommandBufferBeginInfo lv_commandBufferBegin = {};
-		lv_commandBufferBegin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-		lv_commandBufferBegin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	const SamplerCache& VulkanResourceManager::GetSamplerCache() const
+	{
+		return m_samplerCache;
+	}
 
-		VULKAN_CHECK(vkBeginCommandBuffer(l_cmdBuffer, &lv_commandBufferBegin));
+	BindlessDescriptorHeap& VulkanResourceManager::GetBindlessHeap()
+	{
+		return m_bindlessHeap;
+	}
 
-		vkCmdCopyBuffer(l_cmdBuffer, lv_stagingBuffer.buffer,
-			lv_buffer.buffer,
-			1, &lv_bufferCopy);
 
-		vkEndCommandBuffer(l_cmdBuffer);
+	uint32_t VulkanResourceManager::GetBindlessTextureSlot(const TextureHandle l_handle)
+	{
+		RetrieveGpuTexture(l_handle);
+		return m_bindlessHeap.GetTextureSlot(l_handle.m_index);
+	}
 
-		VkSubmitInfo lv_submitInfo = {};
-		lv_submitInfo.commandBufferCount = 1;
-		lv_submitInfo.pCommandBuffers = &l_cmdBuffer;
-		lv_submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-		VULKAN_CHECK(vkQueueSubmit(l_queue, 1, &lv_submitInfo, nullptr));
+	uint32_t VulkanResourceManager::GetBindlessBufferSlot(const BufferHandle l_handle)
+	{
+		RetrieveGpuBuffer(l_handle);
+		return m_bindlessHeap.GetStorageBufferSlot(l_handle.m_index);
+	}
 
-		vkQueueWaitIdle(l_queue);
+	const PipelineCache& VulkanResourceManager::GetPipelineCache() const
+	{
+		return m_pipelineCache;
 	}
 
 
 	VulkanBuffer& VulkanResourceManager::CreateSharedBuffer(VkDeviceSize l_size, VkBufferUsageFlags l_usage,
 		VkMemoryPropertyFlags l_memoryProperties,
-		const char* l_nameBuffer)
+		const char* l_nameBuffer, std::optional<GpuMemoryCategory> l_memoryCategory)
 	{
 		using namespace ErrorCheck;
 
 		VulkanBuffer lv_bufferToCreate{};
 		
-		if (false == createSharedBuffer(m_renderDevice, l_size,
-			l_usage, l_memoryProperties, lv_bufferToCreate.buffer, lv_bufferToCreate.memory)) {
-			PRINT_EXIT(".\nFailed to create shared vulkan buffer memory.\n");
-		}
-
-		lv_bufferToCreate.size = l_size;
-
-		if (true == (0 != (VK_MEMORY_PROPERTY_HOST_COHERENT_BIT & l_memoryProperties))
-			&&
-			(0 != (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT & l_memoryProperties))) {
-			VULKAN_CHECK(vkMapMemory(m_renderDevice.m_device,
-				lv_bufferToCreate.memory, 0, l_size, 0, &lv_bufferToCreate.ptr));
-		}
+		CreateSubAllocatedBuffer(l_size, l_usage, l_memoryProperties, true,
+			l_memoryCategory.value_or(DeduceBufferMemoryCategory(l_usage)), lv_bufferToCreate);
 
 
-		m_buffers.push_back(lv_bufferToCreate);
+		auto lv_bufferHandle = PushBuffer(lv_bufferToCreate);
 
 		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
 		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_bufferToCreate.buffer);
@@ -367,7 +468,7 @@ namespace RenderCore
 
 		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
 
-		return m_buffers[m_buffers.size()-1];
+		return m_buffers[lv_bufferHandle.m_index];
 	}
 
 
@@ -376,48 +477,48 @@ namespace RenderCore
 
 
 	VkPipeline VulkanResourceManager::CreateComputePipeline(VkDevice m_device, const char* l_computeShaderFilePath
-		,VkPipelineLayout pipelineLayout)
+		,VkPipelineLayout pipelineLayout, const SpecializationConstants& l_specializationConstants)
 	{
-		using namespace ErrorCheck;
-
-		VkPipeline lv_computePipeline;
+		++m_objectCacheStats.m_totalNumPipelineRequests;
 
-		ShaderModule lv_computeShaderModule;
-		VULKAN_CHECK(createShaderModule(m_device, &lv_computeShaderModule , l_computeShaderFilePath));
+		const CreateInfoKey lv_key = MakeComputePipelineKey(l_computeShaderFilePath, pipelineLayout, l_specializationConstants);
 
-		VULKAN_CHECK(createComputePipeline(m_device, lv_computeShaderModule.shaderModule, pipelineLayout,&lv_computePipeline));
+		if (const auto lv_cachedSlot = AcquireCachedPipeline(lv_key); true == lv_cachedSlot.has_value()) {
+			return m_Pipelines[lv_cachedSlot.value()];
+		}
 
-		m_Pipelines.push_back(lv_computePipeline);
+		const auto lv_pipelineHandle = RegisterBuiltPipeline(BuildComputePipeline(l_computeShaderFilePath, pipelineLayout,
+			l_specializationConstants, m_pipelineCache.GetVkPipelineCache()),
+			nullptr, lv_key);
 
-		return lv_computePipeline;
+		return m_Pipelines[lv_pipelineHandle.m_index];
 	}
 
 
 
 
 	VulkanBuffer& VulkanResourceManager::CreateBuffer(VkDeviceSize l_size, VkBufferUsageFlags l_usage,
-		VkMemoryPropertyFlags l_memoryProperties, const char* l_nameBuffer)
+		VkMemoryPropertyFlags l_memoryProperties, const char* l_nameBuffer,
+		std::optional<GpuMemoryCategory> l_memoryCategory)
 	{
-		using namespace ErrorCheck;
+		return m_buffers[CreateBufferWithHandle(l_size, l_usage, l_memoryProperties, l_nameBuffer,
+			l_memoryCategory).m_index];
+	}
 
-		VulkanBuffer lv_bufferToCreate{};
 
-		if (false == createBuffer(m_renderDevice.m_device, m_renderDevice.m_physicalDevice, l_size,
-			l_usage, l_memoryProperties, lv_bufferToCreate.buffer, lv_bufferToCreate.memory)) {
-			PRINT_EXIT(".\nFailed to create vulkan buffer.\n");
-		}
+	BufferHandle VulkanResourceManager::CreateBufferWithHandle(VkDeviceSize l_size, VkBufferUsageFlags l_usage,
+		VkMemoryPropertyFlags l_memoryProperties, const char* l_nameBuffer,
+		std::optional<GpuMemoryCategory> l_memoryCategory)
+	{
+		using namespace ErrorCheck;
 
-		lv_bufferToCreate.size = l_size;
+		VulkanBuffer lv_bufferToCreate{};
 
-		if (true == (0 != (VK_MEMORY_PROPERTY_HOST_COHERENT_BIT & l_memoryProperties))
-			&&
-			(0 != (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT & l_memoryProperties))) {
-			VULKAN_CHECK(vkMapMemory(m_renderDevice.m_device,
-				lv_bufferToCreate.memory, 0, l_size, 0, &lv_bufferToCreate.ptr));
-		}
+		CreateSubAllocatedBuffer(l_size, l_usage, l_memoryProperties, false,
+			l_memoryCategory.value_or(DeduceBufferMemoryCategory(l_usage)), lv_bufferToCreate);
 
 
-		m_buffers.push_back(lv_bufferToCreate);
+		auto lv_bufferHandle = PushBuffer(lv_bufferToCreate);
 
 
 		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
@@ -429,14 +530,9 @@ namespace RenderCore
 
 		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device,&lv_objectNameInfo));
 
-		std::string lv_temp{ l_nameBuffer };
-		GpuResourceMetaData lv_metaData{};
-		lv_metaData.m_resourceHandle = m_buffers.size() - 1;
-		lv_metaData.m_vkDataType = VulkanDataType::m_buffer;
-
-		m_gpuResourcesHandles.emplace(std::move(lv_temp), lv_metaData);
+		AddGpuResource(l_nameBuffer, lv_bufferHandle);
 
-		return m_buffers[m_buffers.size()-1];
+		return lv_bufferHandle;
 	}
 
 
@@ -449,7 +545,22 @@ namespace RenderCore
 		uint32_t l_mipLevels,
 		VkFilter l_minFilter,
 		VkFilter l_maxFilter,
-		VkSamplerAddressMode l_addressMode)
+		VkSamplerAddressMode l_addressMode,
+		GpuMemoryCategory l_memoryCategory)
+	{
+		return m_textures[CreateTexture(l_maxAnistropy, l_nameTexture.c_str(), l_colorFormat, l_width, l_height, l_mipLevels,
+			l_minFilter, l_maxFilter, l_addressMode, l_memoryCategory).m_index];
+	}
+
+
+	TextureHandle VulkanResourceManager::CreateTexture(float l_maxAnistropy, const char* l_nameTexture,
+		VkFormat l_colorFormat,
+		uint32_t l_width, uint32_t l_height,
+		uint32_t l_mipLevels,
+		VkFilter l_minFilter,
+		VkFilter l_maxFilter,
+		VkSamplerAddressMode l_addressMode,
+		GpuMemoryCategory l_memoryCategory)
 	{
 		using namespace ErrorCheck;
 
@@ -459,17 +570,15 @@ namespace RenderCore
 		lv_textureToCreate.width = l_width;
 		lv_textureToCreate.depth = 1U;
 
-		if (false == createOffscreenImage(m_renderDevice, lv_textureToCreate.image.image,
-			lv_textureToCreate.image.imageMemory, lv_textureToCreate.width, lv_textureToCreate.height,
-			l_colorFormat, 1, 0, l_mipLevels)) {
-			PRINT_EXIT(".\nFailed to create attachment for an offscreen framebuffer.\n");
-		}
+		CreateSubAllocatedImage(lv_textureToCreate.width, lv_textureToCreate.height, l_colorFormat,
+			VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+			| VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT, 0, l_mipLevels, l_memoryCategory, lv_textureToCreate.image);
 
 		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
 		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_textureToCreate.image.image);
 		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_IMAGE;
 		lv_objectNameInfo.pNext = nullptr;
-		lv_objectNameInfo.pObjectName = l_nameTexture.c_str();
+		lv_objectNameInfo.pObjectName = l_nameTexture;
 		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
 
 
@@ -482,7 +591,7 @@ namespace RenderCore
 		}
 
 
-		std::string lv_imageViewName{ l_nameTexture + "-view " };
+		std::string lv_imageViewName{ std::string{ l_nameTexture } + "-view " };
 		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo1{};
 		lv_objectNameInfo1.objectHandle = reinterpret_cast<uint64_t>(lv_textureToCreate.image.imageView0);
 		lv_objectNameInfo1.objectType = VK_OBJECT_TYPE_IMAGE_VIEW;
@@ -493,49 +602,37 @@ namespace RenderCore
 
 		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo1));
 
-		if (false == createTextureSampler(m_renderDevice.m_device, &lv_textureToCreate.sampler, (float)l_mipLevels,l_maxAnistropy,l_minFilter,
-			l_maxFilter, l_addressMode)) {
-			PRINT_EXIT(".\nFailed to create sampler for offscreen attachment.\n");
-		}
-
-
-		std::string lv_samplerName{ l_nameTexture + "-sampler " };
-		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo2{};
-		lv_objectNameInfo2.objectHandle = reinterpret_cast<uint64_t>(lv_textureToCreate.sampler);
-		lv_objectNameInfo2.objectType = VK_OBJECT_TYPE_SAMPLER;
-		lv_objectNameInfo2.pNext = nullptr;
-		lv_objectNameInfo2.pObjectName = lv_samplerName.c_str();
-		lv_objectNameInfo2.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
-
-
-
-		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo2));
+		lv_textureToCreate.sampler = m_samplerCache.Acquire(textureSamplerCreateInfo(VK_LOD_CLAMP_NONE,
+			l_maxAnistropy, l_minFilter, l_maxFilter, l_addressMode));
 
 
 
-		transitionImageLayout(m_renderDevice, lv_textureToCreate.image.image, l_colorFormat, VK_IMAGE_LAYOUT_UNDEFINED,
-			VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,1, 1,0);
+		{
+			std::lock_guard lv_lock{ m_mainQueueMutex };
 
-		if (1 < l_mipLevels) {
 			transitionImageLayout(m_renderDevice, lv_textureToCreate.image.image, l_colorFormat, VK_IMAGE_LAYOUT_UNDEFINED,
-				VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, l_mipLevels-1, 1);
+				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,1, 1,0);
+
+			if (1 < l_mipLevels) {
+				transitionImageLayout(m_renderDevice, lv_textureToCreate.image.image, l_colorFormat, VK_IMAGE_LAYOUT_UNDEFINED,
+					VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, l_mipLevels-1, 1);
+			}
 		}
 
 		lv_textureToCreate.Layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
-		m_textures.push_back(lv_textureToCreate);
-
-
-
+		return PushTexture(lv_textureToCreate);
+	}
 
-		return m_textures[m_textures.size() - 1];
 
+	VulkanTexture& VulkanResourceManager::LoadTexture2D(const std::string& l_textureFileName)
+	{
+		return m_textures[LoadTexture2DWithHandle(l_textureFileName).m_index];
 	}
 
 
-	VulkanTexture& VulkanResourceManager::LoadTexture2D(const std::string& l_textureFileName)
+	TextureHandle VulkanResourceManager::LoadTexture2DWithHandle(const std::string& l_textureFileName)
 	{
-		
 		using namespace ErrorCheck;
 
 		VulkanTexture lv_textureToCreate{};
@@ -553,14 +650,22 @@ namespace RenderCore
 
 		printf("\nAttempting to load : %s\n", l_textureFileName.c_str());
 
-		if (false == createTextureImage(m_renderDevice, l_textureFileName.c_str(),
-			lv_textureToCreate.image.image, lv_textureToCreate.image.imageMemory,
-			&lv_textureToCreate.width, &lv_textureToCreate.height, &lv_mipLevel)) {
+		int lv_texWidth{}, lv_texHeight{}, lv_texChannels{};
+		stbi_uc* lv_pixels = stbi_load(l_textureFileName.c_str(), &lv_texWidth, &lv_texHeight, &lv_texChannels, STBI_rgb_alpha);
 
+		if (nullptr == lv_pixels) {
+			printf("Failed to load [%s] texture\nReason: %s\n", l_textureFileName.c_str(), stbi_failure_reason());
 			PRINT_EXIT("\nFailed to create texture image from texture file name.\n");
-
 		}
 
+		lv_textureToCreate.width = (uint32_t)lv_texWidth;
+		lv_textureToCreate.height = (uint32_t)lv_texHeight;
+		lv_mipLevel = (uint32_t)std::floorf(std::log2(std::max(lv_texWidth, lv_texHeight)) + 1);
+
+		CreateSubAllocatedImage(lv_textureToCreate.width, lv_textureToCreate.height, VK_FORMAT_R8G8B8A8_UNORM,
+			VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+			0, lv_mipLevel, GpuMemoryCategory::m_textures, lv_textureToCreate.image);
+
 		if (std::numeric_limits<uint32_t>::max() == lv_mipLevel) {
 			PRINT_EXIT("\nFailed to retrieve the mipmap level from loading texture.\n");
 
@@ -571,91 +676,83 @@ namespace RenderCore
 			PRINT_EXIT("\nFailed to create image view for the loaded 2D texture file.\n");
 		}
 
-		if (false == createTextureSampler(m_renderDevice.m_device, &lv_textureToCreate.sampler, (float)lv_mipLevel)) {
-			PRINT_EXIT("\nFailed to create sampler for loaded 2D texture.\n");
-		}
-
-		transitionImageLayout(m_renderDevice, lv_textureToCreate.image.image, VK_FORMAT_R8G8B8A8_UNORM,
-			VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,1, 1, 0);
-
-		
-		transitionImageLayout(m_renderDevice, lv_textureToCreate.image.image, VK_FORMAT_R8G8B8A8_UNORM,
-			VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, lv_mipLevel - 1, 1);
-
+		//maxLod is left unclamped since the view already limits sampling to the mips of each texture,
+		//which lets every loaded texture share a single sampler
+		lv_textureToCreate.sampler = m_samplerCache.Acquire(textureSamplerCreateInfo(VK_LOD_CLAMP_NONE));
 
 		lv_textureToCreate.format = VK_FORMAT_R8G8B8A8_UNORM;
 		lv_textureToCreate.depth = 1U;
 
-		int32_t lv_srcMipmapWidth = (int32_t)lv_textureToCreate.width;
-		int32_t lv_srcMipmapHeight = (int32_t)lv_textureToCreate.height;
-
-		//Downsample from mip chain n-1 to n
-		for (uint32_t i = 1; i < lv_mipLevel; ++i) {
+		//The upload and the whole mip chain are recorded into the staging ring, so loading a scene's worth of
+		//textures ends up in a few batched submits instead of several blocking submits per texture.
+		//Decoding stays outside the lock, only the recording is serialized between loader threads.
+		const VkImage lv_image = lv_textureToCreate.image.image;
 
-			VkImageBlit lv_imageBlit{};
+		{
+			std::lock_guard lv_lock{ m_mainQueueMutex };
 
-			lv_imageBlit.srcOffsets[0] = {0,0,0};
-			lv_imageBlit.srcOffsets[1] = {lv_srcMipmapWidth, lv_srcMipmapHeight, 1};
-			lv_imageBlit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			lv_imageBlit.srcSubresource.baseArrayLayer = 0;
-			lv_imageBlit.srcSubresource.layerCount = 1;
-			lv_imageBlit.srcSubresource.mipLevel = i - 1;
+			transitionImageLayoutCmd(m_stagingRing->GetCommandBuffer(), lv_image, lv_textureToCreate.format,
+				VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, lv_mipLevel, 0, 0);
 
-			lv_srcMipmapWidth = lv_srcMipmapWidth == 1 ? 1 : lv_srcMipmapWidth / 2;
-			lv_srcMipmapHeight = lv_srcMipmapHeight == 1 ? 1 : lv_srcMipmapHeight / 2;
-			lv_imageBlit.dstOffsets[0] = { 0,0,0 };
-			lv_imageBlit.dstOffsets[1] = {lv_srcMipmapWidth, lv_srcMipmapHeight, 1};
-			lv_imageBlit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			lv_imageBlit.dstSubresource.baseArrayLayer = 0;
-			lv_imageBlit.dstSubresource.layerCount = 1;
-			lv_imageBlit.dstSubresource.mipLevel = i;
+			m_stagingRing->UploadToImage(lv_image, lv_textureToCreate.width, lv_textureToCreate.height, 1,
+				bytesPerTexFormat(lv_textureToCreate.format), lv_pixels);
 
-			VkCommandBuffer commandBuffer = beginSingleTimeCommands(m_renderDevice);
-			vkCmdBlitImage(commandBuffer, lv_textureToCreate.image.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-						  , lv_textureToCreate.image.image,VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,1, &lv_imageBlit, VK_FILTER_LINEAR);
-			endSingleTimeCommands(m_renderDevice, commandBuffer);
+			stbi_image_free(lv_pixels);
 
+			transitionImageLayoutCmd(m_stagingRing->GetCommandBuffer(), lv_image, lv_textureToCreate.format,
+				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 1, 1, 0, 0);
 
-			transitionImageLayout(m_renderDevice, lv_textureToCreate.image.image
-				, lv_textureToCreate.format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-				, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 1, 1, i);
+			int32_t lv_srcMipmapWidth = (int32_t)lv_textureToCreate.width;
+			int32_t lv_srcMipmapHeight = (int32_t)lv_textureToCreate.height;
 
-		}
+			//Downsample from mip chain n-1 to n
+			for (uint32_t i = 1; i < lv_mipLevel; ++i) {
 
-		transitionImageLayout(m_renderDevice, lv_textureToCreate.image.image
-			, lv_textureToCreate.format, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-			, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, lv_mipLevel, 0);
+				VkImageBlit lv_imageBlit{};
 
+				lv_imageBlit.srcOffsets[0] = {0,0,0};
+				lv_imageBlit.srcOffsets[1] = {lv_srcMipmapWidth, lv_srcMipmapHeight, 1};
+				lv_imageBlit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				lv_imageBlit.srcSubresource.baseArrayLayer = 0;
+				lv_imageBlit.srcSubresource.layerCount = 1;
+				lv_imageBlit.srcSubresource.mipLevel = i - 1;
 
-		
-		lv_textureToCreate.Layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				lv_srcMipmapWidth = lv_srcMipmapWidth == 1 ? 1 : lv_srcMipmapWidth / 2;
+				lv_srcMipmapHeight = lv_srcMipmapHeight == 1 ? 1 : lv_srcMipmapHeight / 2;
+				lv_imageBlit.dstOffsets[0] = { 0,0,0 };
+				lv_imageBlit.dstOffsets[1] = {lv_srcMipmapWidth, lv_srcMipmapHeight, 1};
+				lv_imageBlit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				lv_imageBlit.dstSubresource.baseArrayLayer = 0;
+				lv_imageBlit.dstSubresource.layerCount = 1;
+				lv_imageBlit.dstSubresource.mipLevel = i;
 
-		m_textures.push_back(lv_textureToCreate);
+				VkCommandBuffer lv_commandBuffer = m_stagingRing->GetCommandBuffer();
 
-		return m_textures[m_textures.size() - 1];
-	}
+				vkCmdBlitImage(lv_commandBuffer, lv_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+							  , lv_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &lv_imageBlit, VK_FILTER_LINEAR);
 
+				transitionImageLayoutCmd(lv_commandBuffer, lv_image, lv_textureToCreate.format,
+					VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 1, 1, 0, i);
 
-	uint32_t VulkanResourceManager::LoadTexture2DWithHandle(const std::string& l_textureFileName)
-	{
-		LoadTexture2D(l_textureFileName);
+			}
 
-		return (uint32_t)m_textures.size() - 1;
-	}
+			transitionImageLayoutCmd(m_stagingRing->GetCommandBuffer(), lv_image, lv_textureToCreate.format,
+				VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1, lv_mipLevel, 0, 0);
+		}
 
 
-	uint32_t VulkanResourceManager::CreateBufferWithHandle(VkDeviceSize l_size, VkBufferUsageFlags l_usage,
-		VkMemoryPropertyFlags l_memoryProperties, const char* l_nameBuffer)
-	{
-		CreateBuffer(l_size, l_usage, l_memoryProperties, l_nameBuffer);
+		
+		lv_textureToCreate.Layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-		return (uint32_t)m_buffers.size() - 1;
+		return PushTexture(lv_textureToCreate);
 	}
 
 
 
 
-	VulkanTexture& VulkanResourceManager::CreateDepthTextureForOffscreenFrameBuffer(const std::string& l_nameDepthTexture)
+
+	VulkanTexture& VulkanResourceManager::CreateDepthTextureForOffscreenFrameBuffer(const std::string& l_nameDepthTexture,
+		GpuMemoryCategory l_memoryCategory)
 	{
 		using namespace ErrorCheck;
 
@@ -666,12 +763,9 @@ namespace RenderCore
 		lv_depthTextureToCreate.depth = 1U;
 
 
-		if (false == createImage(m_renderDevice.m_device, m_renderDevice.m_physicalDevice, lv_depthTextureToCreate.width,
-			lv_depthTextureToCreate.height, lv_depthTextureToCreate.format, VK_IMAGE_TILING_OPTIMAL, 
-			VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-			lv_depthTextureToCreate.image.image, lv_depthTextureToCreate.image.imageMemory)) {
-			PRINT_EXIT("\nFailed to create depth texture.\n");
-		}
+		CreateSubAllocatedImage(lv_depthTextureToCreate.width, lv_depthTextureToCreate.height,
+			lv_depthTextureToCreate.format, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+			0, 1, l_memoryCategory, lv_depthTextureToCreate.image);
 
 
 		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
@@ -702,45 +796,24 @@ namespace RenderCore
 
 
 
-		if (false == createTextureSampler(m_renderDevice.m_device, &lv_depthTextureToCreate.sampler)) {
-			PRINT_EXIT("\nFailed to create image sampler for depth texture.\n");
-		}
-
-		std::string lv_samplerName{ l_nameDepthTexture + "-sampler " };
-		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo2{};
-		lv_objectNameInfo2.objectHandle = reinterpret_cast<uint64_t>(lv_depthTextureToCreate.sampler);
-		lv_objectNameInfo2.objectType = VK_OBJECT_TYPE_SAMPLER;
-		lv_objectNameInfo2.pNext = nullptr;
-		lv_objectNameInfo2.pObjectName = lv_samplerName.c_str();
-		lv_objectNameInfo2.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+		lv_depthTextureToCreate.sampler = m_samplerCache.Acquire(textureSamplerCreateInfo(VK_LOD_CLAMP_NONE));
 
-		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo2));
 
 
+		{
+			std::lock_guard lv_lock{ m_mainQueueMutex };
 
-		transitionImageLayout(m_renderDevice, lv_depthTextureToCreate.image.image, lv_depthTextureToCreate.format,
-			VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+			transitionImageLayout(m_renderDevice, lv_depthTextureToCreate.image.image, lv_depthTextureToCreate.format,
+				VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+		}
 
-		m_textures.push_back(lv_depthTextureToCreate);
+		auto lv_textureHandle = PushTexture(lv_depthTextureToCreate);
 
-		return m_textures[m_textures.size() - 1];
+		return m_textures[lv_textureHandle.m_index];
 	}
 
 
 
-	uint32_t VulkanResourceManager::CreateTexture(float l_maxAnistropy ,const char* l_nameTexture,
-		VkFormat l_colorFormat,
-		uint32_t l_width , uint32_t l_height,
-		uint32_t l_mipLevels,
-		VkFilter l_minFilter,
-		VkFilter l_maxFilter,
-		VkSamplerAddressMode l_addressMode)
-	{
-		CreateTextureForOffscreenFrameBuffer(l_maxAnistropy,l_nameTexture, l_colorFormat, l_width, l_height, l_mipLevels,l_minFilter, l_maxFilter, l_addressMode);
-
-		return (uint32_t)m_textures.size()-1;
-	}
-
 
 
 	VulkanBuffer& VulkanResourceManager::RetrieveGpuBuffer
@@ -756,7 +829,7 @@ namespace RenderCore
 			exit(-1);
 		}
 
-		auto& lv_bufferGpu = RetrieveGpuBuffer(lv_bufferMeta.m_resourceHandle);
+		auto& lv_bufferGpu = m_buffers[lv_bufferMeta.m_resourceHandle];
 
 		return lv_bufferGpu;
 	}
@@ -775,7 +848,7 @@ namespace RenderCore
 			exit(-1);
 		}
 
-		auto& lv_textureGpu = RetrieveGpuTexture(lv_textureMeta.m_resourceHandle);
+		auto& lv_textureGpu = m_textures[lv_textureMeta.m_resourceHandle];
 
 		return lv_textureGpu;
 	}
@@ -851,7 +924,7 @@ namespace RenderCore
 			exit(-1);
 		}
 
-		auto lv_pipelineGpu = RetrieveGpuPipeline(lv_pipelineMeta.m_resourceHandle);
+		auto lv_pipelineGpu = m_Pipelines.at(lv_pipelineMeta.m_resourceHandle);
 
 		return lv_pipelineGpu;
 	}
@@ -899,13 +972,83 @@ namespace RenderCore
 
 
 
-	VulkanBuffer& VulkanResourceManager::RetrieveGpuBuffer(const uint32_t l_handle)
+	BufferHandle VulkanResourceManager::RetrieveGpuBufferHandle(const std::string& l_nameBuffer)
+	{
+		auto lv_bufferMeta = RetrieveGpuResourceMetaData(l_nameBuffer);
+
+		if (VulkanDataType::m_buffer != lv_bufferMeta.m_vkDataType) {
+			printf("Gpu buffer %s was not found. Exitting....", l_nameBuffer.c_str());
+			exit(-1);
+		}
+
+		return BufferHandle{ .m_index = lv_bufferMeta.m_resourceHandle,
+			.m_generation = m_buffers.GetGeneration(lv_bufferMeta.m_resourceHandle) };
+	}
+
+	BufferHandle VulkanResourceManager::RetrieveGpuBufferHandle
+	(const std::string& l_bufferBaseName, const uint32_t l_index)
+	{
+		auto lv_formatedArg = std::make_format_args(l_index);
+		std::string lv_formattedString{ l_bufferBaseName + " {}" };
+
+		return RetrieveGpuBufferHandle(std::vformat(lv_formattedString, lv_formatedArg));
+	}
+
+	TextureHandle VulkanResourceManager::RetrieveGpuTextureHandle(const std::string& l_nameTexture)
+	{
+		auto lv_textureMeta = RetrieveGpuResourceMetaData(l_nameTexture);
+
+		if (VulkanDataType::m_texture != lv_textureMeta.m_vkDataType) {
+			printf("Gpu texture %s was not found. Exitting....", l_nameTexture.c_str());
+			exit(-1);
+		}
+
+		return TextureHandle{ .m_index = lv_textureMeta.m_resourceHandle,
+			.m_generation = m_textures.GetGeneration(lv_textureMeta.m_resourceHandle) };
+	}
+
+	TextureHandle VulkanResourceManager::RetrieveGpuTextureHandle
+	(const std::string& l_textureBaseName, const uint32_t l_index)
+	{
+		auto lv_formatedArg = std::make_format_args(l_index);
+		std::string lv_formattedString{ l_textureBaseName + " {}" };
+
+		return RetrieveGpuTextureHandle(std::vformat(lv_formattedString, lv_formatedArg));
+	}
+
+
+
+
+	VulkanBuffer& VulkanResourceManager::RetrieveGpuBuffer(const BufferHandle l_handle)
+	{
+		using namespace ErrorCheck;
+
+		if (false == m_buffers.IsValid(l_handle.m_index, l_handle.m_generation)) {
+			PRINT_EXIT("\nStale or invalid buffer handle.\n");
+		}
+
+		return m_buffers[l_handle.m_index];
+	}
+	VulkanTexture& VulkanResourceManager::RetrieveGpuTexture(const TextureHandle l_handle)
 	{
-		return m_buffers.at(l_handle);
+		using namespace ErrorCheck;
+
+		if (false == m_textures.IsValid(l_handle.m_index, l_handle.m_generation)) {
+			PRINT_EXIT("\nStale or invalid texture handle.\n");
+		}
+
+		return m_textures[l_handle.m_index];
 	}
-	VulkanTexture& VulkanResourceManager::RetrieveGpuTexture(const uint32_t l_handle)
+	VkPipeline	VulkanResourceManager::RetrieveGpuPipeline(const PipelineHandle l_handle)
 	{
-		return m_textures.at(l_handle);
+		using namespace ErrorCheck;
+
+		if (l_handle.m_index >= (uint32_t)m_Pipelines.size() ||
+			l_handle.m_generation != m_pipelineGenerations[l_handle.m_index]) {
+			PRINT_EXIT("\nStale or invalid pipeline handle.\n");
+		}
+
+		return m_Pipelines[l_handle.m_index];
 	}
 	VkFramebuffer VulkanResourceManager::RetrieveGpuFramebuffer(const uint32_t l_handle)
 	{
@@ -919,10 +1062,6 @@ namespace RenderCore
 	{
 		return m_pipelineLayouts.at(l_handle);
 	}
-	VkPipeline	VulkanResourceManager::RetrieveGpuPipeline(const uint32_t l_handle)
-	{
-		return m_Pipelines.at(l_handle);
-	}
 	VkDescriptorSetLayout VulkanResourceManager::RetrieveGpuDescriptorSetLayout(const uint32_t l_handle)
 	{
 		return m_descriptorSetLayouts.at(l_handle);
@@ -932,7 +1071,15 @@ namespace RenderCore
 		return m_descriptorPools.at(l_handle);
 	}
 
-	VulkanTexture& VulkanResourceManager::CreateDepthTexture(const std::string& l_nameDepthTexture)
+	VulkanTexture& VulkanResourceManager::CreateDepthTexture(const std::string& l_nameDepthTexture,
+		GpuMemoryCategory l_memoryCategory)
+	{
+		return m_textures[CreateDepthTextureWithHandle(l_nameDepthTexture, l_memoryCategory).m_index];
+	}
+
+
+	TextureHandle VulkanResourceManager::CreateDepthTextureWithHandle(const std::string& l_nameDepthTexture,
+		GpuMemoryCategory l_memoryCategory)
 	{
 		using namespace ErrorCheck;
 
@@ -943,12 +1090,9 @@ namespace RenderCore
 		lv_depthTextureToCreate.depth = 1U;
 
 
-		if (false == createImage(m_renderDevice.m_device, m_renderDevice.m_physicalDevice, lv_depthTextureToCreate.width,
-			lv_depthTextureToCreate.height, lv_depthTextureToCreate.format, VK_IMAGE_TILING_OPTIMAL,
-			VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-			lv_depthTextureToCreate.image.image, lv_depthTextureToCreate.image.imageMemory)) {
-			PRINT_EXIT("\nFailed to create depth texture.\n");
-		}
+		CreateSubAllocatedImage(lv_depthTextureToCreate.width, lv_depthTextureToCreate.height,
+			lv_depthTextureToCreate.format, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+			0, 1, l_memoryCategory, lv_depthTextureToCreate.image);
 
 
 		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
@@ -979,40 +1123,18 @@ namespace RenderCore
 		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
 
 
-		if (false == createTextureSampler(m_renderDevice.m_device, &lv_depthTextureToCreate.sampler)) {
-			PRINT_EXIT("\nFailed to create image sampler for depth texture.\n");
-		}
-
-
-		std::string lv_samplerName{ l_nameDepthTexture + "-sampler " };
-		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_depthTextureToCreate.sampler);
-		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_SAMPLER;
-		lv_objectNameInfo.pNext = nullptr;
-		lv_objectNameInfo.pObjectName = lv_samplerName.c_str();
-		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
-
-
-		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+		lv_depthTextureToCreate.sampler = m_samplerCache.Acquire(textureSamplerCreateInfo(VK_LOD_CLAMP_NONE));
 
+		{
+			std::lock_guard lv_lock{ m_mainQueueMutex };
 
-		transitionImageLayout(m_renderDevice, lv_depthTextureToCreate.image.image, lv_depthTextureToCreate.format,
-			VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+			transitionImageLayout(m_renderDevice, lv_depthTextureToCreate.image.image, lv_depthTextureToCreate.format,
+				VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+		}
 
 		lv_depthTextureToCreate.Layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
-		m_textures.push_back(lv_depthTextureToCreate);
-
-		return m_textures[m_textures.size() - 1];
-	}
-
-
-
-
-	uint32_t VulkanResourceManager::CreateDepthTextureWithHandle(const std::string& l_nameTexture)
-	{
-		CreateDepthTexture(l_nameTexture);
-
-		return (uint32_t)m_textures.size() - 1;
+		return PushTexture(lv_depthTextureToCreate);
 	}
 
 
@@ -1071,15 +1193,35 @@ namespace RenderCore
 
 
 
+	VulkanResourceManager::ResourceNameShard& VulkanResourceManager::GetResourceNameShard(const std::string& l_nameResource)
+	{
+		return m_gpuResourcesHandles[std::hash<std::string>{}(l_nameResource) % m_totalNumResourceNameShards];
+	}
+
+
 	void VulkanResourceManager::AddGpuResource(const char* l_nameResource, 
 		uint32_t l_resourceHandle, VulkanDataType l_vkDataType)
 	{
 		std::string lv_nameResource{ l_nameResource };
 		GpuResourceMetaData lv_metaData{.m_vkDataType = l_vkDataType, .m_resourceHandle = l_resourceHandle};
-		m_gpuResourcesHandles.insert(std::make_pair<std::string, GpuResourceMetaData>
+
+		auto& lv_shard = GetResourceNameShard(lv_nameResource);
+
+		std::unique_lock lv_lock{ lv_shard.m_mutex };
+		lv_shard.m_handles.insert(std::make_pair<std::string, GpuResourceMetaData>
 			(std::move(lv_nameResource), std::move(lv_metaData)));
 	}
 
+	void VulkanResourceManager::AddGpuResource(const char* l_nameResource, BufferHandle l_bufferHandle)
+	{
+		AddGpuResource(l_nameResource, l_bufferHandle.m_index, VulkanDataType::m_buffer);
+	}
+
+	void VulkanResourceManager::AddGpuResource(const char* l_nameResource, TextureHandle l_textureHandle)
+	{
+		AddGpuResource(l_nameResource, l_textureHandle.m_index, VulkanDataType::m_texture);
+	}
+
 
 	VulkanResourceManager::GpuResourceMetaData 
 		VulkanResourceManager::RetrieveGpuResourceMetaData(const std::string& l_nameResource)
@@ -1088,8 +1230,11 @@ namespace RenderCore
 		lv_resourceMetaData.m_resourceHandle = UINT32_MAX;
 		lv_resourceMetaData.m_vkDataType = VulkanDataType::m_invalid;
 
-		if (auto lv_result = m_gpuResourcesHandles.find(l_nameResource);
-			m_gpuResourcesHandles.cend() != lv_result) {
+		auto& lv_shard = GetResourceNameShard(l_nameResource);
+		std::shared_lock lv_lock{ lv_shard.m_mutex };
+
+		if (auto lv_result = lv_shard.m_handles.find(l_nameResource);
+			lv_shard.m_handles.cend() != lv_result) {
 
 			return lv_result->second;
 
@@ -1129,15 +1274,13 @@ namespace RenderCore
 	}
 
 
-	uint32_t VulkanResourceManager::AddVulkanBuffer(const VulkanBuffer& l_buffer)
+	BufferHandle VulkanResourceManager::AddVulkanBuffer(const VulkanBuffer& l_buffer)
 	{
-		m_buffers.push_back(l_buffer);
-		return (uint32_t)m_buffers.size()-1;
+		return PushBuffer(l_buffer);
 	}
-	uint32_t VulkanResourceManager::AddVulkanTexture(const VulkanTexture& l_texture)
+	TextureHandle VulkanResourceManager::AddVulkanTexture(const VulkanTexture& l_texture)
 	{
-		m_textures.push_back(l_texture);
-		return (uint32_t)m_textures.size()-1;
+		return PushTexture(l_texture);
 	}
 	uint32_t VulkanResourceManager::AddVulkanFramebuffer(VkFramebuffer l_framebuffer)
 	{
@@ -1149,15 +1292,49 @@ namespace RenderCore
 		m_renderPasses.push_back(l_renderpass);
 		return(uint32_t)m_renderPasses.size()-1;
 	}
+	uint32_t VulkanResourceManager::AddVulkanRenderpass(VkRenderPass l_renderpass,
+		const VkRenderPassCreateInfo& l_renderpassCreateInfo)
+	{
+		//Render pass compatibility: load/store ops and layouts do not matter, formats, sample counts and references do
+		CreateInfoKey lv_key{};
+
+		lv_key.Add(l_renderpassCreateInfo.attachmentCount);
+		for (uint32_t i = 0; i < l_renderpassCreateInfo.attachmentCount; ++i) {
+			const auto& lv_attachment = l_renderpassCreateInfo.pAttachments[i];
+			lv_key.Add((uint64_t)lv_attachment.format << 32 | lv_attachment.samples);
+		}
+
+		const auto lv_addReferences = [&lv_key](const VkAttachmentReference* l_references, uint32_t l_totalNumReferences)
+			{
+				lv_key.Add(l_totalNumReferences);
+				for (uint32_t i = 0; i < l_totalNumReferences; ++i) {
+					lv_key.Add(l_references[i].attachment);
+				}
+			};
+
+		lv_key.Add(l_renderpassCreateInfo.subpassCount);
+		for (uint32_t i = 0; i < l_renderpassCreateInfo.subpassCount; ++i) {
+			const auto& lv_subpass = l_renderpassCreateInfo.pSubpasses[i];
+
+			lv_key.Add(lv_subpass.pipelineBindPoint);
+			lv_addReferences(lv_subpass.pInputAttachments, lv_subpass.inputAttachmentCount);
+			lv_addReferences(lv_subpass.pColorAttachments, lv_subpass.colorAttachmentCount);
+			lv_addReferences(lv_subpass.pResolveAttachments, (nullptr == lv_subpass.pResolveAttachments) ? 0 : lv_subpass.colorAttachmentCount);
+			lv_addReferences(lv_subpass.pDepthStencilAttachment, (nullptr == lv_subpass.pDepthStencilAttachment) ? 0 : 1);
+		}
+
+		m_renderPassCompatibilityKeys[l_renderpass] = std::move(lv_key);
+
+		return AddVulkanRenderpass(l_renderpass);
+	}
 	uint32_t VulkanResourceManager::AddVulkanPipelineLayout(VkPipelineLayout l_pipelineLayout)
 	{
 		m_pipelineLayouts.push_back(l_pipelineLayout);
 		return(uint32_t)m_pipelineLayouts.size()-1;
 	}
-	uint32_t VulkanResourceManager::AddVulkanPipeline(VkPipeline l_pipeline)
+	PipelineHandle VulkanResourceManager::AddVulkanPipeline(VkPipeline l_pipeline)
 	{
-		m_Pipelines.push_back(l_pipeline);
-		return(uint32_t)m_Pipelines.size()-1;
+		return PushPipeline(l_pipeline);
 	}
 	uint32_t VulkanResourceManager::AddVulkanDescriptorSetLayout(VkDescriptorSetLayout l_dsSetLayout)
 	{
@@ -1171,10 +1348,72 @@ namespace RenderCore
 	}
 
 
-	VulkanResourceManager::RenderPass VulkanResourceManager::CreateRenderPass(const std::vector<VulkanTexture>& l_textures,
-		const char* l_nameRenderpass,
-		const RenderPassCreateInfo l_ci,
-		bool l_useDepth)
+	BufferHandle VulkanResourceManager::PushBuffer(const VulkanBuffer& l_buffer)
+	{
+		const auto lv_slot = m_buffers.Push(l_buffer);
+		WriteBindlessBuffer(lv_slot.m_index);
+
+		return BufferHandle{ .m_index = lv_slot.m_index, .m_generation = lv_slot.m_generation };
+	}
+	TextureHandle VulkanResourceManager::PushTexture(const VulkanTexture& l_texture)
+	{
+		const auto lv_slot = m_textures.Push(l_texture);
+		WriteBindlessTexture(lv_slot.m_index);
+
+		return TextureHandle{ .m_index = lv_slot.m_index, .m_generation = lv_slot.m_generation };
+	}
+	PipelineHandle VulkanResourceManager::PushPipeline(VkPipeline l_pipeline)
+	{
+		if (false == m_freePipelineSlots.empty()) {
+			const uint32_t lv_index = m_freePipelineSlots.back();
+			m_freePipelineSlots.pop_back();
+
+			m_Pipelines[lv_index] = l_pipeline;
+			m_pipelineUseCounts[lv_index] = 1U;
+			return PipelineHandle{ .m_index = lv_index, .m_generation = m_pipelineGenerations[lv_index] };
+		}
+
+		m_Pipelines.push_back(l_pipeline);
+		m_pipelineGenerations.push_back(1U);
+		m_pipelineUseCounts.push_back(1U);
+
+		return PipelineHandle{ .m_index = (uint32_t)m_Pipelines.size() - 1, .m_generation = m_pipelineGenerations.back() };
+	}
+
+
+	void VulkanResourceManager::WriteBindlessTexture(uint32_t l_textureIndex)
+	{
+		const auto& lv_texture = m_textures[l_textureIndex];
+
+		//Swapchain images and storage only images have no sampler and are never read through the heap
+		if (VK_NULL_HANDLE == lv_texture.sampler || VK_NULL_HANDLE == lv_texture.image.imageView0) {
+			return;
+		}
+
+		m_bindlessHeap.WriteTexture(l_textureIndex, lv_texture.image.imageView0, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	}
+	void VulkanResourceManager::WriteBindlessBuffer(uint32_t l_bufferIndex)
+	{
+		const auto& lv_buffer = m_buffers[l_bufferIndex];
+
+		{
+			std::lock_guard lv_lock{ m_allocationMutex };
+			auto lv_result = m_bufferAllocations.find(lv_buffer.buffer);
+
+			if (m_bufferAllocations.end() == lv_result ||
+				0 == (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT & lv_result->second.m_usage)) {
+				return;
+			}
+		}
+
+		m_bindlessHeap.WriteStorageBuffer(l_bufferIndex, lv_buffer.buffer);
+	}
+
+
+	VulkanResourceManager::RenderPass VulkanResourceManager::CreateRenderPass(const std::vector<VulkanTexture>& l_textures,
+		const char* l_nameRenderpass,
+		const RenderPassCreateInfo l_ci,
+		bool l_useDepth)
 	{
 		using namespace ErrorCheck;
 
@@ -1319,44 +1558,102 @@ namespace RenderCore
 		const char* l_namePipelineLayout,
 		uint32_t l_vtxConstSize, uint32_t l_fragConstSize)
 	{
-		using namespace ErrorCheck;
-
-		VkPipelineLayout lv_pipelineLayout;
-		if (!createPipelineLayoutWithConstants(m_renderDevice.m_device, l_descriptorSetLayout,
-			&lv_pipelineLayout, l_vtxConstSize, l_fragConstSize))
-		{
-			PRINT_EXIT("\nCannot create pipeline layout with push constants.\n");
-		}
-
-
-		m_pipelineLayouts.push_back(lv_pipelineLayout);
-
-		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
-		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_pipelineLayout);
-		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_PIPELINE_LAYOUT;
-		lv_objectNameInfo.pNext = nullptr;
-		lv_objectNameInfo.pObjectName = l_namePipelineLayout;
-		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+		const std::array<VkPushConstantRange, 2> lv_pushConstantRanges{ {
+			{.stageFlags = VK_SHADER_STAGE_VERTEX_BIT, .offset = 0, .size = l_vtxConstSize },
+			{.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT, .offset = l_vtxConstSize, .size = l_fragConstSize } } };
+
+		const uint32_t lv_totalNumPushConstantRanges = (uint32_t)(0 < l_vtxConstSize) + (uint32_t)(0 < l_fragConstSize);
+
+		const VkPipelineLayoutCreateInfo lv_pipelineLayoutCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.setLayoutCount = 1,
+			.pSetLayouts = &l_descriptorSetLayout,
+			.pushConstantRangeCount = lv_totalNumPushConstantRanges,
+			.pPushConstantRanges = (0 == lv_totalNumPushConstantRanges) ? nullptr :
+				(0 < l_vtxConstSize) ? &lv_pushConstantRanges[0] : &lv_pushConstantRanges[1]
+		};
+
+		return CreateCachedPipelineLayout(lv_pipelineLayoutCreateInfo, l_namePipelineLayout);
+	}
 
 
-		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+	VkPipelineLayout& VulkanResourceManager::CreatePipelineLayout(VkDescriptorSetLayout l_descriptorSetLayout,
+		const char* l_namePipelineLayout)
+	{
+		const uint32_t lv_totalNumSetLayouts = (VK_NULL_HANDLE == l_descriptorSetLayout) ? 0U : 1U;
+
+		const VkPipelineLayoutCreateInfo lv_pipelineLayoutCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.setLayoutCount = lv_totalNumSetLayouts,
+			.pSetLayouts = (0 == lv_totalNumSetLayouts) ? nullptr : &l_descriptorSetLayout,
+			.pushConstantRangeCount = 0,
+			.pPushConstantRanges = nullptr
+		};
+
+		return CreateCachedPipelineLayout(lv_pipelineLayoutCreateInfo, l_namePipelineLayout);
+	}
 
 
-		return m_pipelineLayouts[m_pipelineLayouts.size() - 1];
+	VkPipelineLayout& VulkanResourceManager::CreatePipelineLayoutWithBindlessHeap(VkDescriptorSetLayout l_descriptorSetLayout,
+		const char* l_namePipelineLayout, uint32_t l_pushConstSize)
+	{
+		const std::array<VkDescriptorSetLayout, 2> lv_setLayouts{ l_descriptorSetLayout, m_bindlessHeap.GetDescriptorSetLayout() };
+
+		const VkPushConstantRange lv_pushConstantRange{
+			.stageFlags = VK_SHADER_STAGE_ALL,
+			.offset = 0,
+			.size = l_pushConstSize
+		};
+
+		const VkPipelineLayoutCreateInfo lv_pipelineLayoutCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.setLayoutCount = (uint32_t)lv_setLayouts.size(),
+			.pSetLayouts = lv_setLayouts.data(),
+			.pushConstantRangeCount = (0 == l_pushConstSize) ? 0U : 1U,
+			.pPushConstantRanges = (0 == l_pushConstSize) ? nullptr : &lv_pushConstantRange
+		};
+
+		return CreateCachedPipelineLayout(lv_pipelineLayoutCreateInfo, l_namePipelineLayout);
 	}
 
 
-	VkPipelineLayout& VulkanResourceManager::CreatePipelineLayout(VkDescriptorSetLayout l_descriptorSetLayout,
+	VkPipelineLayout& VulkanResourceManager::CreateCachedPipelineLayout(const VkPipelineLayoutCreateInfo& l_pipelineLayoutCreateInfo,
 		const char* l_namePipelineLayout)
 	{
 		using namespace ErrorCheck;
 
-		VkPipelineLayout lv_pipelineLayout;
-		if (!createPipelineLayout(m_renderDevice.m_device, l_descriptorSetLayout, &lv_pipelineLayout))
-		{
-			PRINT_EXIT("\nCannot create pipeline layout.\n");
+		++m_objectCacheStats.m_totalNumPipelineLayoutRequests;
+
+		CreateInfoKey lv_key{};
+		lv_key.Add(l_pipelineLayoutCreateInfo.flags);
+
+		lv_key.Add(l_pipelineLayoutCreateInfo.setLayoutCount);
+		for (uint32_t i = 0; i < l_pipelineLayoutCreateInfo.setLayoutCount; ++i) {
+			lv_key.Add(reinterpret_cast<uint64_t>(l_pipelineLayoutCreateInfo.pSetLayouts[i]));
+		}
+
+		lv_key.Add(l_pipelineLayoutCreateInfo.pushConstantRangeCount);
+		for (uint32_t i = 0; i < l_pipelineLayoutCreateInfo.pushConstantRangeCount; ++i) {
+			const auto& lv_range = l_pipelineLayoutCreateInfo.pPushConstantRanges[i];
+			lv_key.Add((uint64_t)lv_range.stageFlags << 32 | lv_range.offset);
+			lv_key.Add(lv_range.size);
 		}
 
+		const auto lv_result = m_pipelineLayoutCache.find(lv_key);
+
+		if (m_pipelineLayoutCache.end() != lv_result) {
+			return m_pipelineLayouts[lv_result->second];
+		}
+
+		VkPipelineLayout lv_pipelineLayout;
+		VULKAN_CHECK(vkCreatePipelineLayout(m_renderDevice.m_device, &l_pipelineLayoutCreateInfo, nullptr, &lv_pipelineLayout));
+
 		m_pipelineLayouts.push_back(lv_pipelineLayout);
 
 		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
@@ -1369,6 +1666,8 @@ namespace RenderCore
 
 		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
 
+		m_pipelineLayoutCache.emplace(std::move(lv_key), (uint32_t)m_pipelineLayouts.size() - 1);
+		++m_objectCacheStats.m_totalNumPipelineLayoutsCreated;
 
 		return m_pipelineLayouts[m_pipelineLayouts.size() - 1];
 	}
@@ -1380,241 +1679,907 @@ namespace RenderCore
 		const char* l_namePipeline,
 		const PipelineInfo& l_pipelineParams)
 	{
-		using namespace ErrorCheck;
+		++m_objectCacheStats.m_totalNumPipelineRequests;
 
-		VkPipeline lv_graphicsPipeline{};
+		const CreateInfoKey lv_key = MakeGraphicsPipelineKey(l_renderPass, l_pipelineLayout, l_shaderFiles, l_pipelineParams);
 
-		if (false == createGraphicsPipeline(m_renderDevice, l_renderPass, l_pipelineLayout,
-			l_shaderFiles, &lv_graphicsPipeline, l_pipelineParams.m_totalNumColorAttach, l_pipelineParams.m_topology, l_pipelineParams.m_useDepth,
-			l_pipelineParams.m_useBlending, l_pipelineParams.m_dynamicScissorState, l_pipelineParams.m_width,
-			l_pipelineParams.m_height,0,
-			l_pipelineParams.m_vertexInputBindingDescription,
-			l_pipelineParams.m_vertexInputAttribDescription,
-			l_pipelineParams.m_enableWireframe)) {
-			PRINT_EXIT("\nFailed to create graphics pipeline.\n");
+		if (const auto lv_cachedSlot = AcquireCachedPipeline(lv_key); true == lv_cachedSlot.has_value()) {
+			return m_Pipelines[lv_cachedSlot.value()];
 		}
 
-		m_Pipelines.push_back(lv_graphicsPipeline);
+		const auto lv_pipelineHandle = RegisterBuiltPipeline(
+			BuildGraphicsPipeline(l_renderPass, l_pipelineLayout, l_shaderFiles, l_pipelineParams,
+				m_pipelineCache.GetVkPipelineCache()), l_namePipeline, lv_key);
 
+		return m_Pipelines[lv_pipelineHandle.m_index];
+	}
 
-		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
-		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_graphicsPipeline);
-		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_PIPELINE;
-		lv_objectNameInfo.pNext = nullptr;
-		lv_objectNameInfo.pObjectName = l_namePipeline;
-		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
 
+	void VulkanResourceManager::RequestGraphicsPipeline(VkRenderPass l_renderPass, VkPipelineLayout l_pipelineLayout,
+		const std::vector<const char*>& l_shaderFiles,
+		const char* l_namePipeline,
+		const PipelineInfo& l_pipelineParams,
+		VkPipeline& l_pipelineToFill,
+		bool l_deferUntilFirstUse)
+	{
+		++m_objectCacheStats.m_totalNumPipelineRequests;
 
-		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+		CreateInfoKey lv_key = MakeGraphicsPipelineKey(l_renderPass, l_pipelineLayout, l_shaderFiles, l_pipelineParams);
 
+		if (true == ShareRequestedPipeline(lv_key, l_pipelineToFill, l_deferUntilFirstUse)) {
+			return;
+		}
 
-		return m_Pipelines[m_Pipelines.size() - 1];
+		PipelineRequest lv_request{};
+		lv_request.m_bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		lv_request.m_renderPass = l_renderPass;
+		lv_request.m_pipelineLayout = l_pipelineLayout;
+		lv_request.m_shaderFiles.assign(l_shaderFiles.begin(), l_shaderFiles.end());
+		lv_request.m_name = l_namePipeline;
+		lv_request.m_pipelineInfo = l_pipelineParams;
+		lv_request.m_key = std::move(lv_key);
+		lv_request.m_pipelinesToFill.push_back(&l_pipelineToFill);
 
-	}
+		if (true == l_deferUntilFirstUse) {
+			m_deferredPipelineRequests.push_back(std::move(lv_request));
+			return;
+		}
 
+		m_pipelineRequests.push_back(std::move(lv_request));
+	}
 
 
-	uint32_t VulkanResourceManager::CreateFrameBuffer(const RenderPass& l_renderpass,
-		const std::vector<uint32_t>& l_textureHandles,
-		const char* l_nameFramebuffer)
+	void VulkanResourceManager::RequestComputePipeline(const char* l_computeShaderFilePath, VkPipelineLayout l_pipelineLayout,
+		const char* l_namePipeline, VkPipeline& l_pipelineToFill, bool l_deferUntilFirstUse,
+		const SpecializationConstants& l_specializationConstants)
 	{
+		++m_objectCacheStats.m_totalNumPipelineRequests;
 
-		std::vector<VulkanTexture> lv_textures{};
-		lv_textures.resize(l_textureHandles.size());
+		CreateInfoKey lv_key = MakeComputePipelineKey(l_computeShaderFilePath, l_pipelineLayout, l_specializationConstants);
 
-		for (uint32_t i = 0; i < l_textureHandles.size(); ++i) {
-			lv_textures[i] = RetrieveGpuTexture(l_textureHandles[i]);
+		if (true == ShareRequestedPipeline(lv_key, l_pipelineToFill, l_deferUntilFirstUse)) {
+			return;
 		}
 
-		CreateFrameBuffer(l_renderpass, lv_textures, l_nameFramebuffer);
+		PipelineRequest lv_request{};
+		lv_request.m_bindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+		lv_request.m_pipelineLayout = l_pipelineLayout;
+		lv_request.m_shaderFiles.push_back(l_computeShaderFilePath);
+		lv_request.m_name = l_namePipeline;
+		lv_request.m_pipelineInfo.m_specializationConstants = l_specializationConstants;
+		lv_request.m_key = std::move(lv_key);
+		lv_request.m_pipelinesToFill.push_back(&l_pipelineToFill);
 
-		return (uint32_t)m_frameBuffers.size() - 1;
+		if (true == l_deferUntilFirstUse) {
+			m_deferredPipelineRequests.push_back(std::move(lv_request));
+			return;
+		}
+
+		m_pipelineRequests.push_back(std::move(lv_request));
 	}
 
 
-	VkDescriptorSetLayout& VulkanResourceManager::CreateDescriptorSetLayout(
-		const DescriptorSetResources& l_dsResources, const char* l_nameDsSetLayout)
+	bool VulkanResourceManager::ShareRequestedPipeline(const CreateInfoKey& l_key, VkPipeline& l_pipelineToFill,
+		bool l_deferUntilFirstUse)
 	{
-		using namespace ErrorCheck;
-
-		VkDescriptorSetLayout lv_dsLayout{};
-		std::vector<VkDescriptorBindingFlagsEXT> lv_dsBindingFlagsEXT{};
-		std::vector<VkDescriptorSetLayoutBinding> lv_bindings{};
-
-		uint32_t lv_bindingNumber{};
-
-		for (auto& l_buffer : l_dsResources.m_buffers) {
-			lv_dsBindingFlagsEXT.push_back(0U);
-			lv_bindings.push_back(descriptorSetLayoutBinding(lv_bindingNumber++, l_buffer.m_descriptorInfo.m_type,
-				l_buffer.m_descriptorInfo.m_shaderStageFlags));
-		}
+		//CreateDeferredPipeline() tells created pipelines apart by their handle
+		l_pipelineToFill = VK_NULL_HANDLE;
 
-		for (auto& l_texture : l_dsResources.m_textures) {
-			lv_dsBindingFlagsEXT.push_back(0U);
-			lv_bindings.push_back(descriptorSetLayoutBinding(lv_bindingNumber++, l_texture.m_descriptorInfo.m_type,
-				l_texture.m_descriptorInfo.m_shaderStageFlags));
+		if (const auto lv_cachedSlot = AcquireCachedPipeline(l_key); true == lv_cachedSlot.has_value()) {
+			l_pipelineToFill = m_Pipelines[lv_cachedSlot.value()];
+			return true;
 		}
 
-		for (auto& l_textureArray : l_dsResources.m_textureArrays) {
-			lv_bindings.push_back(descriptorSetLayoutBinding(lv_bindingNumber++, l_textureArray.m_descriptorInfo.m_type,
-				l_textureArray.m_descriptorInfo.m_shaderStageFlags, (uint32_t)l_textureArray.m_textures.size()));
+		for (auto& l_request : m_pipelineRequests) {
+			if (l_request.m_key == l_key) {
+				l_request.m_pipelinesToFill.push_back(&l_pipelineToFill);
+				return true;
+			}
 		}
 
-		VkDescriptorSetLayoutBindingFlagsCreateInfoEXT lv_dsBindingFlagsCreateInfoEXT{};
-		lv_dsBindingFlagsCreateInfoEXT.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
-		lv_dsBindingFlagsCreateInfoEXT.pBindingFlags = lv_dsBindingFlagsEXT.data();
-		lv_dsBindingFlagsCreateInfoEXT.bindingCount = (uint32_t)lv_dsBindingFlagsEXT.size();
-
-		VkDescriptorSetLayoutCreateInfo lv_dsLayoutCreateInfo{};
-		lv_dsLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-		lv_dsLayoutCreateInfo.bindingCount = (uint32_t)lv_bindings.size();
-		lv_dsLayoutCreateInfo.pBindings = lv_bindings.data();
-		lv_dsLayoutCreateInfo.pNext = &lv_dsBindingFlagsCreateInfoEXT;
-		
-		VULKAN_CHECK(vkCreateDescriptorSetLayout(m_renderDevice.m_device, &lv_dsLayoutCreateInfo, nullptr,&lv_dsLayout));
-
-		m_descriptorSetLayouts.push_back(lv_dsLayout);
-
-		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
-		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_dsLayout);
-		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT;
-		lv_objectNameInfo.pNext = nullptr;
-		lv_objectNameInfo.pObjectName = l_nameDsSetLayout;
-		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+		WaitForPrewarmedPipelines();
 
+		for (auto& l_request : m_deferredPipelineRequests) {
+			if (l_request.m_key == l_key) {
+				l_request.m_pipelinesToFill.push_back(&l_pipelineToFill);
 
-		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+				if (false == l_deferUntilFirstUse) {
+					CreateDeferredPipeline(l_pipelineToFill);
+				}
+				return true;
+			}
+		}
 
-		
-		return m_descriptorSetLayouts[m_descriptorSetLayouts.size() - 1];
+		return false;
 	}
 
 
-	VkDescriptorPool& VulkanResourceManager::CreateDescriptorPool(const DescriptorSetResources& l_dsResources,
-		uint32_t l_totalNumDescriptorSets, const char* l_dsPool)
+	std::optional<uint32_t> VulkanResourceManager::AcquireCachedPipeline(const CreateInfoKey& l_key)
 	{
+		const auto lv_result = m_pipelineObjectCache.find(l_key);
 
-		using namespace ErrorCheck;
+		if (m_pipelineObjectCache.end() == lv_result) {
+			return std::nullopt;
+		}
 
-		VkDescriptorPool lv_dsPool{};
+		++m_pipelineUseCounts[lv_result->second];
 
-		std::vector<VkDescriptorPoolSize> lv_dsPoolSizes{};
+		return lv_result->second;
+	}
 
-		uint32_t lv_totalNumUniformBufferArrays{};
-		uint32_t lv_totalNumStorageArrays{};
-		uint32_t lv_totalNumTextures{};
 
-		
-		lv_totalNumTextures = (uint32_t)l_dsResources.m_textures.size();
+	VulkanResourceManager::CreateInfoKey VulkanResourceManager::MakeGraphicsPipelineKey(VkRenderPass l_renderPass,
+		VkPipelineLayout l_pipelineLayout,
+		const std::vector<const char*>& l_shaderFiles,
+		const PipelineInfo& l_pipelineParams) const
+	{
+		CreateInfoKey lv_key{};
+		lv_key.Add(VK_PIPELINE_BIND_POINT_GRAPHICS);
 
-		for (auto& l_textureArray : l_dsResources.m_textureArrays) {
-			lv_totalNumTextures += (uint32_t)l_textureArray.m_textures.size();
+		const auto lv_renderPassKey = m_renderPassCompatibilityKeys.find(l_renderPass);
+
+		if (m_renderPassCompatibilityKeys.end() != lv_renderPassKey) {
+			lv_key.Add(lv_renderPassKey->second.m_words.size());
+			lv_key.m_words.insert(lv_key.m_words.end(), lv_renderPassKey->second.m_words.begin(),
+				lv_renderPassKey->second.m_words.end());
 		}
-		
-		for (auto& l_buffer : l_dsResources.m_buffers) {
-			if (VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER == l_buffer.m_descriptorInfo.m_type) {
-				++lv_totalNumUniformBufferArrays;
-				continue;
-			}
-			if (VK_DESCRIPTOR_TYPE_STORAGE_BUFFER == l_buffer.m_descriptorInfo.m_type) {
-				++lv_totalNumStorageArrays;
-			}
+		else {
+			lv_key.Add(0);
+			lv_key.Add(reinterpret_cast<uint64_t>(l_renderPass));
 		}
 
-		if (0 != lv_totalNumUniformBufferArrays) {
-			lv_dsPoolSizes.push_back(VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-				.descriptorCount = l_totalNumDescriptorSets*lv_totalNumUniformBufferArrays});
-		}
+		lv_key.Add(reinterpret_cast<uint64_t>(l_pipelineLayout));
 
-		if (0 != lv_totalNumStorageArrays) {
-			lv_dsPoolSizes.push_back(VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-				.descriptorCount = l_totalNumDescriptorSets*lv_totalNumStorageArrays});
+		//Shaders are keyed by path, a file does not change while the application runs
+		lv_key.Add(l_shaderFiles.size());
+		for (auto* l_shaderFile : l_shaderFiles) {
+			lv_key.Add(std::string{ l_shaderFile });
 		}
 
-		if (0 != lv_totalNumTextures) {
-			lv_dsPoolSizes.push_back(VkDescriptorPoolSize{ .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-				.descriptorCount = lv_totalNumTextures * l_totalNumDescriptorSets });
+		const bool lv_sizeIsDynamic = (true == l_pipelineParams.m_dynamicViewportState && true == l_pipelineParams.m_dynamicScissorState);
+
+		lv_key.Add((true == lv_sizeIsDynamic) ? 0 : (uint64_t)l_pipelineParams.m_width << 32 | l_pipelineParams.m_height);
+		lv_key.Add((uint64_t)l_pipelineParams.m_topology << 32 | l_pipelineParams.m_totalNumColorAttach);
+		lv_key.Add((uint64_t)l_pipelineParams.m_useDepth | (uint64_t)l_pipelineParams.m_useBlending << 1 |
+			(uint64_t)l_pipelineParams.m_dynamicScissorState << 2 | (uint64_t)l_pipelineParams.m_dynamicViewportState << 3 |
+			(uint64_t)l_pipelineParams.m_enableWireframe << 4);
+
+		lv_key.Add(l_pipelineParams.m_vertexInputBindingDescription.size());
+		for (const auto& l_binding : l_pipelineParams.m_vertexInputBindingDescription) {
+			lv_key.Add((uint64_t)l_binding.binding << 32 | l_binding.stride);
+			lv_key.Add(l_binding.inputRate);
 		}
 
-		VkDescriptorPoolCreateInfo lv_dsPoolCreateInfo{};
-		lv_dsPoolCreateInfo.maxSets = l_totalNumDescriptorSets;
-		lv_dsPoolCreateInfo.poolSizeCount = (uint32_t)lv_dsPoolSizes.size();
-		lv_dsPoolCreateInfo.pPoolSizes = lv_dsPoolSizes.data();
-		lv_dsPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-		
-		
-		VULKAN_CHECK(vkCreateDescriptorPool(m_renderDevice.m_device, &lv_dsPoolCreateInfo, nullptr, &lv_dsPool));
+		lv_key.Add(l_pipelineParams.m_vertexInputAttribDescription.size());
+		for (const auto& l_attribute : l_pipelineParams.m_vertexInputAttribDescription) {
+			lv_key.Add((uint64_t)l_attribute.location << 32 | l_attribute.binding);
+			lv_key.Add((uint64_t)l_attribute.format << 32 | l_attribute.offset);
+		}
 
-		m_descriptorPools.push_back(lv_dsPool);
+		lv_key.Add(l_pipelineParams.m_specializationConstants);
 
+		return lv_key;
+	}
 
-		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
-		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_dsPool);
-		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_DESCRIPTOR_POOL;
-		lv_objectNameInfo.pNext = nullptr;
-		lv_objectNameInfo.pObjectName = l_dsPool;
-		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
 
+	VulkanResourceManager::CreateInfoKey VulkanResourceManager::MakeComputePipelineKey(const char* l_computeShaderFilePath,
+		VkPipelineLayout l_pipelineLayout, const SpecializationConstants& l_specializationConstants) const
+	{
+		CreateInfoKey lv_key{};
+		lv_key.Add(VK_PIPELINE_BIND_POINT_COMPUTE);
+		lv_key.Add(reinterpret_cast<uint64_t>(l_pipelineLayout));
+		lv_key.Add(std::string{ l_computeShaderFilePath });
+		lv_key.Add(l_specializationConstants);
 
-		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+		return lv_key;
+	}
 
 
-		return m_descriptorPools[m_descriptorPools.size() - 1];
- 	}
+	void VulkanResourceManager::CreateInfoKey::Add(uint64_t l_word)
+	{
+		m_words.push_back(l_word);
+	}
 
 
-	VkDescriptorSet VulkanResourceManager::CreateDescriptorSet(VkDescriptorPool l_dsPool, VkDescriptorSetLayout l_dsLayout,
-		const char* l_dsSet)
+	void VulkanResourceManager::CreateInfoKey::Add(const std::string& l_string)
 	{
-		using namespace ErrorCheck;
+		m_words.push_back(l_string.size());
 
-		VkDescriptorSet lv_ds{};
+		for (size_t i = 0; i < l_string.size(); i += sizeof(uint64_t)) {
+			uint64_t lv_word{ 0 };
+			memcpy(&lv_word, l_string.data() + i, std::min(sizeof(uint64_t), l_string.size() - i));
+			m_words.push_back(lv_word);
+		}
+	}
 
-		VkDescriptorSetAllocateInfo lv_dsAllocateInfo{};
-		lv_dsAllocateInfo.descriptorPool = l_dsPool;
-		lv_dsAllocateInfo.descriptorSetCount = 1;
-		lv_dsAllocateInfo.pSetLayouts = &l_dsLayout;
-		lv_dsAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
 
-		VULKAN_CHECK(vkAllocateDescriptorSets(m_renderDevice.m_device, &lv_dsAllocateInfo, &lv_ds));
+	void VulkanResourceManager::CreateInfoKey::Add(const SpecializationConstants& l_specializationConstants)
+	{
+		const auto& lv_mapEntries = l_specializationConstants.GetMapEntries();
+		const auto& lv_values = l_specializationConstants.GetValues();
 
-		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
-		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_ds);
-		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_DESCRIPTOR_SET;
-		lv_objectNameInfo.pNext = nullptr;
-		lv_objectNameInfo.pObjectName = l_dsSet;
-		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+		m_words.push_back(lv_mapEntries.size());
 
+		for (size_t i = 0; i < lv_mapEntries.size(); ++i) {
+			m_words.push_back((uint64_t)lv_mapEntries[i].constantID << 32 | lv_values[i]);
+		}
+	}
 
-		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
-		
 
+	size_t VulkanResourceManager::CreateInfoKeyHash::operator()(const CreateInfoKey& l_key) const noexcept
+	{
+		size_t lv_seed{ 0 };
 
-		return lv_ds;
+		for (const uint64_t l_word : l_key.m_words) {
+			lv_seed ^= std::hash<uint64_t>{}(l_word) + 0x9e3779b97f4a7c15ULL + (lv_seed << 6) + (lv_seed >> 2);
+		}
 
-		
+		return lv_seed;
 	}
 
 
-	void VulkanResourceManager::UpdateDescriptorSet(const DescriptorSetResources& l_dsResources, 
-		VkDescriptorSet l_ds)
+	uint32_t VulkanResourceManager::GetTotalNumRequestedPipelines() const
 	{
-		using namespace ErrorCheck;
-
-		uint32_t lv_bindingNumber{};
-		std::vector<VkWriteDescriptorSet> lv_writeDSVector{};
-		std::vector<VkDescriptorBufferInfo> lv_dsBufferInfoVector{ l_dsResources.m_buffers.size() };
-		std::vector<VkDescriptorImageInfo> lv_textureImageInfoVector{ l_dsResources.m_textures.size() };
-		std::vector<VkDescriptorImageInfo> lv_textureArrayImageInfoVector{};
+		return (uint32_t)m_pipelineRequests.size();
+	}
 
 
-		for (uint32_t i = 0; i < l_dsResources.m_buffers.size(); ++i) {
+	uint32_t VulkanResourceManager::GetTotalNumDeferredPipelines() const
+	{
+		return (uint32_t)m_deferredPipelineRequests.size();
+	}
 
-			lv_dsBufferInfoVector[i] = VkDescriptorBufferInfo{.buffer = l_dsResources.m_buffers[i].m_buffer.buffer
-			,.offset = l_dsResources.m_buffers[i].m_offset, .range = l_dsResources.m_buffers[i].m_size};
 
-			lv_writeDSVector.push_back(bufferWriteDescriptorSet(l_ds, &lv_dsBufferInfoVector[i], lv_bindingNumber++,
-				l_dsResources.m_buffers[i].m_descriptorInfo.m_type));
+	void VulkanResourceManager::CreateRequestedPipelines(uint32_t l_totalNumThreads)
+	{
+		if (true == m_pipelineRequests.empty()) {
+			return;
+		}
+
+		if (0 == l_totalNumThreads) {
+			l_totalNumThreads = std::max(1U, std::thread::hardware_concurrency());
+		}
+		l_totalNumThreads = std::min(l_totalNumThreads, (uint32_t)m_pipelineRequests.size());
+
+		std::vector<BuiltPipeline> lv_builtPipelines{};
+		const double lv_wallMilliseconds = BuildRequestedPipelinesOnThreads(l_totalNumThreads,
+			m_pipelineCache.GetVkPipelineCache(), lv_builtPipelines);
+
+		for (size_t i = 0; i < m_pipelineRequests.size(); ++i) {
+			const auto& lv_request = m_pipelineRequests[i];
+
+			const auto lv_pipelineHandle = RegisterBuiltPipeline(lv_builtPipelines[i], lv_request.m_name.c_str(), lv_request.m_key);
+			m_pipelineUseCounts[lv_pipelineHandle.m_index] = (uint32_t)lv_request.m_pipelinesToFill.size();
+
+			for (auto* l_pipelineToFill : lv_request.m_pipelinesToFill) {
+				*l_pipelineToFill = lv_builtPipelines[i].m_pipeline;
+			}
+		}
+
+		//Per thread count speedups come from BenchmarkRequestedPipelines(), summed creation times measured under
+		//contention say nothing about what a serial run would cost
+		printf("\n%zu pipelines created on %u threads in %.2f ms, %zu deferred until first use.\n",
+			m_pipelineRequests.size(), l_totalNumThreads, lv_wallMilliseconds, m_deferredPipelineRequests.size());
+
+		m_pipelineRequests.clear();
+	}
+
+
+	void VulkanResourceManager::BenchmarkRequestedPipelines(uint32_t l_maxNumThreads)
+	{
+		using namespace ErrorCheck;
+
+		if (true == m_pipelineRequests.empty()) {
+			return;
+		}
+
+		if (0 == l_maxNumThreads) {
+			l_maxNumThreads = std::max(1U, std::thread::hardware_concurrency());
+		}
+		l_maxNumThreads = std::min(l_maxNumThreads, (uint32_t)m_pipelineRequests.size());
+
+		std::vector<double> lv_milliseconds(l_maxNumThreads);
+		std::vector<BuiltPipeline> lv_builtPipelines{};
+
+		const VkPipelineCacheCreateInfo lv_emptyCacheCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.initialDataSize = 0,
+			.pInitialData = nullptr
+		};
+
+		for (uint32_t i = 1; i <= l_maxNumThreads; ++i) {
+
+			//A cache shared between the runs would turn every run after the first one into cache hits
+			VkPipelineCache lv_emptyPipelineCache{ VK_NULL_HANDLE };
+			VULKAN_CHECK(vkCreatePipelineCache(m_renderDevice.m_device, &lv_emptyCacheCreateInfo, nullptr, &lv_emptyPipelineCache));
+
+			lv_milliseconds[i - 1] = BuildRequestedPipelinesOnThreads(i, lv_emptyPipelineCache, lv_builtPipelines);
+
+			for (const auto& l_builtPipeline : lv_builtPipelines) {
+				vkDestroyPipeline(m_renderDevice.m_device, l_builtPipeline.m_pipeline, nullptr);
+			}
+
+			vkDestroyPipelineCache(m_renderDevice.m_device, lv_emptyPipelineCache, nullptr);
+		}
+
+		printf("\nCreation times of %zu pipelines (drivers may still keep their own shader caches):\n", m_pipelineRequests.size());
+		for (uint32_t i = 1; i <= l_maxNumThreads; ++i) {
+			printf("  %2u threads: %10.2f ms (%.2fx)\n", i, lv_milliseconds[i - 1], lv_milliseconds[0] / lv_milliseconds[i - 1]);
+		}
+	}
+
+
+	double VulkanResourceManager::BuildRequestedPipelinesOnThreads(uint32_t l_totalNumThreads, VkPipelineCache l_vkPipelineCache,
+		std::vector<BuiltPipeline>& l_builtPipelines) const
+	{
+		l_builtPipelines.assign(m_pipelineRequests.size(), BuiltPipeline{});
+		std::atomic<uint32_t> lv_nextRequestIndex{ 0 };
+
+		//Every thread keeps taking the next request, so one slow shader compile does not hold back a whole share
+		const auto lv_buildRequestedPipelines = [this, l_vkPipelineCache, &l_builtPipelines, &lv_nextRequestIndex]()
+			{
+				for (uint32_t i = lv_nextRequestIndex++; i < (uint32_t)m_pipelineRequests.size(); i = lv_nextRequestIndex++) {
+					l_builtPipelines[i] = BuildRequestedPipeline(m_pipelineRequests[i], l_vkPipelineCache);
+				}
+			};
+
+		const auto lv_start = std::chrono::steady_clock::now();
+
+		std::vector<std::thread> lv_workers{};
+		lv_workers.reserve(l_totalNumThreads - 1);
+
+		for (uint32_t i = 1; i < l_totalNumThreads; ++i) {
+			lv_workers.emplace_back(lv_buildRequestedPipelines);
+		}
+
+		lv_buildRequestedPipelines();
+
+		for (auto& l_worker : lv_workers) {
+			l_worker.join();
+		}
+
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lv_start).count();
+	}
+
+
+	VkPipeline VulkanResourceManager::CreateDeferredPipeline(VkPipeline& l_pipelineToFill)
+	{
+		using namespace ErrorCheck;
+
+		if (VK_NULL_HANDLE != l_pipelineToFill) {
+			return l_pipelineToFill;
+		}
+
+		WaitForPrewarmedPipelines();
+
+		const auto lv_request = std::find_if(m_deferredPipelineRequests.begin(), m_deferredPipelineRequests.end(),
+			[&l_pipelineToFill](const PipelineRequest& l_request)
+			{
+				return l_request.m_pipelinesToFill.end() !=
+					std::find(l_request.m_pipelinesToFill.begin(), l_request.m_pipelinesToFill.end(), &l_pipelineToFill);
+			});
+
+		if (m_deferredPipelineRequests.end() == lv_request) {
+			PRINT_EXIT("\nCreateDeferredPipeline() was called on a pipeline that has no deferred request.\n");
+		}
+
+		const size_t lv_requestIndex = (size_t)(lv_request - m_deferredPipelineRequests.begin());
+
+		BuiltPipeline lv_builtPipeline{};
+		const bool lv_prewarmed = (lv_requestIndex < m_prewarmedPipelines.size() &&
+			VK_NULL_HANDLE != m_prewarmedPipelines[lv_requestIndex].m_pipeline);
+
+		if (true == lv_prewarmed) {
+			lv_builtPipeline = m_prewarmedPipelines[lv_requestIndex];
+		}
+		else {
+			lv_builtPipeline = BuildRequestedPipeline(*lv_request);
+		}
+
+		const auto lv_pipelineHandle = RegisterBuiltPipeline(lv_builtPipeline, lv_request->m_name.c_str(), lv_request->m_key);
+		m_pipelineUseCounts[lv_pipelineHandle.m_index] = (uint32_t)lv_request->m_pipelinesToFill.size();
+
+		for (auto* l_pipelineToFill : lv_request->m_pipelinesToFill) {
+			*l_pipelineToFill = lv_builtPipeline.m_pipeline;
+		}
+
+		printf("\nDeferred pipeline %s created on first use (%.2f ms, %s).\n", lv_request->m_name.c_str(),
+			lv_builtPipeline.m_creationMilliseconds, (true == lv_prewarmed) ? "prewarmed" : "built now");
+
+		m_deferredPipelineRequests.erase(lv_request);
+		if (lv_requestIndex < m_prewarmedPipelines.size()) {
+			m_prewarmedPipelines.erase(m_prewarmedPipelines.begin() + lv_requestIndex);
+		}
+
+		return l_pipelineToFill;
+	}
+
+
+	void VulkanResourceManager::PrewarmDeferredPipelines()
+	{
+		WaitForPrewarmedPipelines();
+
+		if (true == m_deferredPipelineRequests.empty()) {
+			return;
+		}
+
+		m_prewarmedPipelines.resize(m_deferredPipelineRequests.size());
+
+		m_prewarmThread = std::thread([this]()
+			{
+				for (size_t i = 0; i < m_deferredPipelineRequests.size(); ++i) {
+					if (VK_NULL_HANDLE == m_prewarmedPipelines[i].m_pipeline) {
+						m_prewarmedPipelines[i] = BuildRequestedPipeline(m_deferredPipelineRequests[i]);
+					}
+				}
+			});
+	}
+
+
+	void VulkanResourceManager::WaitForPrewarmedPipelines()
+	{
+		if (true == m_prewarmThread.joinable()) {
+			m_prewarmThread.join();
+		}
+	}
+
+
+	VulkanResourceManager::BuiltPipeline VulkanResourceManager::BuildGraphicsPipeline(VkRenderPass l_renderPass,
+		VkPipelineLayout l_pipelineLayout,
+		const std::vector<const char*>& l_shaderFiles,
+		const PipelineInfo& l_pipelineParams,
+		VkPipelineCache l_vkPipelineCache) const
+	{
+		using namespace ErrorCheck;
+
+		BuiltPipeline lv_builtPipeline{};
+
+		const VkPipelineCreationFeedbackCreateInfo lv_creationFeedbackInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+			.pNext = nullptr,
+			.pPipelineCreationFeedback = &lv_builtPipeline.m_creationFeedback,
+			.pipelineStageCreationFeedbackCount = 0,
+			.pPipelineStageCreationFeedbacks = nullptr
+		};
+
+		const VkSpecializationInfo lv_specializationInfo = l_pipelineParams.m_specializationConstants.GetSpecializationInfo();
+
+		const auto lv_start = std::chrono::steady_clock::now();
+
+		if (false == createGraphicsPipeline(m_renderDevice, l_renderPass, l_pipelineLayout,
+			l_shaderFiles, &lv_builtPipeline.m_pipeline, l_pipelineParams.m_totalNumColorAttach, l_pipelineParams.m_topology, l_pipelineParams.m_useDepth,
+			l_pipelineParams.m_useBlending, l_pipelineParams.m_dynamicScissorState, l_pipelineParams.m_width,
+			l_pipelineParams.m_height,0,
+			l_pipelineParams.m_vertexInputBindingDescription,
+			l_pipelineParams.m_vertexInputAttribDescription,
+			l_pipelineParams.m_enableWireframe,
+			l_vkPipelineCache, &lv_creationFeedbackInfo,
+			l_pipelineParams.m_dynamicViewportState,
+			(true == l_pipelineParams.m_specializationConstants.IsEmpty()) ? nullptr : &lv_specializationInfo)) {
+			PRINT_EXIT("\nFailed to create graphics pipeline.\n");
+		}
+
+		lv_builtPipeline.m_creationMilliseconds =
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lv_start).count();
+
+		return lv_builtPipeline;
+	}
+
+
+	VulkanResourceManager::BuiltPipeline VulkanResourceManager::BuildComputePipeline(const char* l_computeShaderFilePath,
+		VkPipelineLayout l_pipelineLayout, const SpecializationConstants& l_specializationConstants,
+		VkPipelineCache l_vkPipelineCache) const
+	{
+		using namespace ErrorCheck;
+
+		BuiltPipeline lv_builtPipeline{};
+
+		const VkPipelineCreationFeedbackCreateInfo lv_creationFeedbackInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+			.pNext = nullptr,
+			.pPipelineCreationFeedback = &lv_builtPipeline.m_creationFeedback,
+			.pipelineStageCreationFeedbackCount = 0,
+			.pPipelineStageCreationFeedbacks = nullptr
+		};
+
+		const auto lv_start = std::chrono::steady_clock::now();
+
+		ShaderModule lv_computeShaderModule;
+		VULKAN_CHECK(createShaderModule(m_renderDevice.m_device, &lv_computeShaderModule, l_computeShaderFilePath));
+
+		const VkSpecializationInfo lv_specializationInfo = l_specializationConstants.GetSpecializationInfo();
+
+		VULKAN_CHECK(createComputePipeline(m_renderDevice.m_device, lv_computeShaderModule.shaderModule, l_pipelineLayout,
+			&lv_builtPipeline.m_pipeline, l_vkPipelineCache, &lv_creationFeedbackInfo,
+			(true == l_specializationConstants.IsEmpty()) ? nullptr : &lv_specializationInfo));
+
+		vkDestroyShaderModule(m_renderDevice.m_device, lv_computeShaderModule.shaderModule, nullptr);
+
+		lv_builtPipeline.m_creationMilliseconds =
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lv_start).count();
+
+		return lv_builtPipeline;
+	}
+
+
+	VulkanResourceManager::BuiltPipeline VulkanResourceManager::BuildRequestedPipeline(const PipelineRequest& l_request) const
+	{
+		return BuildRequestedPipeline(l_request, m_pipelineCache.GetVkPipelineCache());
+	}
+
+
+	VulkanResourceManager::BuiltPipeline VulkanResourceManager::BuildRequestedPipeline(const PipelineRequest& l_request,
+		VkPipelineCache l_vkPipelineCache) const
+	{
+		if (VK_PIPELINE_BIND_POINT_COMPUTE == l_request.m_bindPoint) {
+			return BuildComputePipeline(l_request.m_shaderFiles[0].c_str(), l_request.m_pipelineLayout,
+				l_request.m_pipelineInfo.m_specializationConstants, l_vkPipelineCache);
+		}
+
+		std::vector<const char*> lv_shaderFiles{};
+		lv_shaderFiles.reserve(l_request.m_shaderFiles.size());
+
+		for (const auto& l_shaderFile : l_request.m_shaderFiles) {
+			lv_shaderFiles.push_back(l_shaderFile.c_str());
+		}
+
+		return BuildGraphicsPipeline(l_request.m_renderPass, l_request.m_pipelineLayout,
+			lv_shaderFiles, l_request.m_pipelineInfo, l_vkPipelineCache);
+	}
+
+
+	PipelineHandle VulkanResourceManager::RegisterBuiltPipeline(const BuiltPipeline& l_builtPipeline, const char* l_namePipeline,
+		const CreateInfoKey& l_key)
+	{
+		using namespace ErrorCheck;
+
+		m_pipelineCache.RecordPipelineCreation(l_builtPipeline.m_creationFeedback, l_builtPipeline.m_creationMilliseconds);
+
+		auto lv_pipelineHandle = PushPipeline(l_builtPipeline.m_pipeline);
+
+		if (nullptr != l_namePipeline) {
+			VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
+			lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(l_builtPipeline.m_pipeline);
+			lv_objectNameInfo.objectType = VK_OBJECT_TYPE_PIPELINE;
+			lv_objectNameInfo.pNext = nullptr;
+			lv_objectNameInfo.pObjectName = l_namePipeline;
+			lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+
+			VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+		}
+
+		m_pipelineObjectCache.emplace(l_key, lv_pipelineHandle.m_index);
+		++m_objectCacheStats.m_totalNumPipelinesCreated;
+
+		return lv_pipelineHandle;
+	}
+
+
+
+	uint32_t VulkanResourceManager::CreateFrameBuffer(const RenderPass& l_renderpass,
+		const std::vector<TextureHandle>& l_textureHandles,
+		const char* l_nameFramebuffer)
+	{
+
+		std::vector<VulkanTexture> lv_textures{};
+		lv_textures.resize(l_textureHandles.size());
+
+		for (uint32_t i = 0; i < l_textureHandles.size(); ++i) {
+			lv_textures[i] = RetrieveGpuTexture(l_textureHandles[i]);
+		}
+
+		CreateFrameBuffer(l_renderpass, lv_textures, l_nameFramebuffer);
+
+		return (uint32_t)m_frameBuffers.size() - 1;
+	}
+
+
+	VkDescriptorSetLayout& VulkanResourceManager::CreateDescriptorSetLayout(
+		const DescriptorSetResources& l_dsResources, const char* l_nameDsSetLayout)
+	{
+		std::vector<VkDescriptorBindingFlagsEXT> lv_dsBindingFlagsEXT{};
+		std::vector<VkDescriptorSetLayoutBinding> lv_bindings{};
+
+		uint32_t lv_bindingNumber{};
+
+		for (auto& l_buffer : l_dsResources.m_buffers) {
+			lv_dsBindingFlagsEXT.push_back(0U);
+			lv_bindings.push_back(descriptorSetLayoutBinding(lv_bindingNumber++, l_buffer.m_descriptorInfo.m_type,
+				l_buffer.m_descriptorInfo.m_shaderStageFlags));
+		}
+
+		for (auto& l_texture : l_dsResources.m_textures) {
+			lv_dsBindingFlagsEXT.push_back(0U);
+			lv_bindings.push_back(descriptorSetLayoutBinding(lv_bindingNumber++, l_texture.m_descriptorInfo.m_type,
+				l_texture.m_descriptorInfo.m_shaderStageFlags));
+		}
+
+		for (auto& l_textureArray : l_dsResources.m_textureArrays) {
+			lv_bindings.push_back(descriptorSetLayoutBinding(lv_bindingNumber++, l_textureArray.m_descriptorInfo.m_type,
+				l_textureArray.m_descriptorInfo.m_shaderStageFlags, (uint32_t)l_textureArray.m_textures.size()));
+		}
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfoEXT lv_dsBindingFlagsCreateInfoEXT{};
+		lv_dsBindingFlagsCreateInfoEXT.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+		lv_dsBindingFlagsCreateInfoEXT.pBindingFlags = lv_dsBindingFlagsEXT.data();
+		lv_dsBindingFlagsCreateInfoEXT.bindingCount = (uint32_t)lv_dsBindingFlagsEXT.size();
+
+		VkDescriptorSetLayoutCreateInfo lv_dsLayoutCreateInfo{};
+		lv_dsLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		lv_dsLayoutCreateInfo.bindingCount = (uint32_t)lv_bindings.size();
+		lv_dsLayoutCreateInfo.pBindings = lv_bindings.data();
+		lv_dsLayoutCreateInfo.pNext = &lv_dsBindingFlagsCreateInfoEXT;
+
+		return CreateDescriptorSetLayout(lv_dsLayoutCreateInfo, l_nameDsSetLayout);
+	}
+
+
+	VkDescriptorSetLayout& VulkanResourceManager::CreateDescriptorSetLayout(
+		const VkDescriptorSetLayoutCreateInfo& l_dsLayoutCreateInfo, const char* l_nameDsSetLayout)
+	{
+		using namespace ErrorCheck;
+
+		++m_objectCacheStats.m_totalNumDescriptorSetLayoutRequests;
+
+		CreateInfoKey lv_key{};
+		lv_key.Add(l_dsLayoutCreateInfo.flags);
+
+		lv_key.Add(l_dsLayoutCreateInfo.bindingCount);
+		for (uint32_t i = 0; i < l_dsLayoutCreateInfo.bindingCount; ++i) {
+			const auto& lv_binding = l_dsLayoutCreateInfo.pBindings[i];
+			lv_key.Add((uint64_t)lv_binding.binding << 32 | lv_binding.descriptorType);
+			lv_key.Add((uint64_t)lv_binding.descriptorCount << 32 | lv_binding.stageFlags);
+
+			const bool lv_hasImmutableSamplers = (nullptr != lv_binding.pImmutableSamplers &&
+				(VK_DESCRIPTOR_TYPE_SAMPLER == lv_binding.descriptorType || VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER == lv_binding.descriptorType));
+
+			lv_key.Add((uint64_t)lv_hasImmutableSamplers);
+			for (uint32_t j = 0; true == lv_hasImmutableSamplers && j < lv_binding.descriptorCount; ++j) {
+				lv_key.Add(reinterpret_cast<uint64_t>(lv_binding.pImmutableSamplers[j]));
+			}
+		}
+
+		for (auto* lv_next = static_cast<const VkBaseInStructure*>(l_dsLayoutCreateInfo.pNext); nullptr != lv_next; lv_next = lv_next->pNext) {
+
+			if (VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO != lv_next->sType) {
+				PRINT_EXIT("\nDescriptor set layout cache only supports VkDescriptorSetLayoutBindingFlagsCreateInfo in the pNext chain.\n");
+			}
+
+			const auto* lv_bindingFlags = reinterpret_cast<const VkDescriptorSetLayoutBindingFlagsCreateInfo*>(lv_next);
+
+			lv_key.Add(lv_bindingFlags->bindingCount);
+			for (uint32_t i = 0; i < lv_bindingFlags->bindingCount; ++i) {
+				lv_key.Add(lv_bindingFlags->pBindingFlags[i]);
+			}
+		}
+
+		const auto lv_result = m_descriptorSetLayoutCache.find(lv_key);
+
+		if (m_descriptorSetLayoutCache.end() != lv_result) {
+			return m_descriptorSetLayouts[lv_result->second];
+		}
+
+		VkDescriptorSetLayout lv_dsLayout{};
+		VULKAN_CHECK(vkCreateDescriptorSetLayout(m_renderDevice.m_device, &l_dsLayoutCreateInfo, nullptr,&lv_dsLayout));
+
+		m_descriptorSetLayouts.push_back(lv_dsLayout);
+
+		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
+		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_dsLayout);
+		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT;
+		lv_objectNameInfo.pNext = nullptr;
+		lv_objectNameInfo.pObjectName = l_nameDsSetLayout;
+		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+
+
+		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+
+		m_descriptorSetLayoutCache.emplace(std::move(lv_key), (uint32_t)m_descriptorSetLayouts.size() - 1);
+		++m_objectCacheStats.m_totalNumDescriptorSetLayoutsCreated;
+		
+		return m_descriptorSetLayouts[m_descriptorSetLayouts.size() - 1];
+	}
+
+
+	const VulkanResourceManager::ObjectCacheStats& VulkanResourceManager::GetObjectCacheStats() const
+	{
+		return m_objectCacheStats;
+	}
+
+
+	void VulkanResourceManager::PrintObjectCacheStats() const
+	{
+		printf("\nObject cache: %u descriptor set layouts for %u requests, %u pipeline layouts for %u requests, %u pipelines for %u requests.\n",
+			m_objectCacheStats.m_totalNumDescriptorSetLayoutsCreated, m_objectCacheStats.m_totalNumDescriptorSetLayoutRequests,
+			m_objectCacheStats.m_totalNumPipelineLayoutsCreated, m_objectCacheStats.m_totalNumPipelineLayoutRequests,
+			m_objectCacheStats.m_totalNumPipelinesCreated, m_objectCacheStats.m_totalNumPipelineRequests);
+		printf("Descriptor updates: %u sets with %u descriptors written through %u update templates in %.3f ms.\n",
+			m_descriptorUpdateStats.m_totalNumSetsUpdated, m_descriptorUpdateStats.m_totalNumDescriptorsWritten,
+			m_descriptorUpdateStats.m_totalNumTemplates, m_descriptorUpdateStats.m_totalUpdateMilliseconds);
+	}
+
+
+	VkDescriptorUpdateTemplate VulkanResourceManager::CreateDescriptorUpdateTemplate(VkDescriptorSetLayout l_dsLayout,
+		const std::vector<VkDescriptorUpdateTemplateEntry>& l_entries, const char* l_nameTemplate)
+	{
+		using namespace ErrorCheck;
+
+		const auto lv_result = m_descriptorUpdateTemplates.find(l_dsLayout);
+
+		if (m_descriptorUpdateTemplates.end() != lv_result) {
+			return lv_result->second;
+		}
+
+		VkDescriptorUpdateTemplateCreateInfo lv_templateCreateInfo{};
+		lv_templateCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+		lv_templateCreateInfo.pNext = nullptr;
+		lv_templateCreateInfo.flags = 0;
+		lv_templateCreateInfo.descriptorUpdateEntryCount = (uint32_t)l_entries.size();
+		lv_templateCreateInfo.pDescriptorUpdateEntries = l_entries.data();
+		lv_templateCreateInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+		lv_templateCreateInfo.descriptorSetLayout = l_dsLayout;
+
+		VkDescriptorUpdateTemplate lv_updateTemplate{ VK_NULL_HANDLE };
+		VULKAN_CHECK(vkCreateDescriptorUpdateTemplate(m_renderDevice.m_device, &lv_templateCreateInfo, nullptr, &lv_updateTemplate));
+
+		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
+		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_updateTemplate);
+		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE;
+		lv_objectNameInfo.pNext = nullptr;
+		lv_objectNameInfo.pObjectName = l_nameTemplate;
+		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+
+		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+
+		m_descriptorUpdateTemplates.emplace(l_dsLayout, lv_updateTemplate);
+		++m_descriptorUpdateStats.m_totalNumTemplates;
+
+		return lv_updateTemplate;
+	}
+
+
+	void VulkanResourceManager::RecordDescriptorUpdate(uint32_t l_totalNumSets, uint32_t l_totalNumDescriptors,
+		double l_updateMilliseconds)
+	{
+		m_descriptorUpdateStats.m_totalNumSetsUpdated += l_totalNumSets;
+		m_descriptorUpdateStats.m_totalNumDescriptorsWritten += l_totalNumDescriptors;
+		m_descriptorUpdateStats.m_totalUpdateMilliseconds += l_updateMilliseconds;
+	}
+
+
+	const VulkanResourceManager::DescriptorUpdateStats& VulkanResourceManager::GetDescriptorUpdateStats() const
+	{
+		return m_descriptorUpdateStats;
+	}
+
+
+	VkDescriptorPool& VulkanResourceManager::CreateDescriptorPool(const DescriptorSetResources& l_dsResources,
+		uint32_t l_totalNumDescriptorSets, const char* l_dsPool)
+	{
+
+		using namespace ErrorCheck;
+
+		VkDescriptorPool lv_dsPool{};
+
+		std::vector<VkDescriptorPoolSize> lv_dsPoolSizes{};
+
+		uint32_t lv_totalNumUniformBufferArrays{};
+		uint32_t lv_totalNumStorageArrays{};
+		uint32_t lv_totalNumTextures{};
+
+		
+		lv_totalNumTextures = (uint32_t)l_dsResources.m_textures.size();
+
+		for (auto& l_textureArray : l_dsResources.m_textureArrays) {
+			lv_totalNumTextures += (uint32_t)l_textureArray.m_textures.size();
+		}
+		
+		for (auto& l_buffer : l_dsResources.m_buffers) {
+			if (VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER == l_buffer.m_descriptorInfo.m_type) {
+				++lv_totalNumUniformBufferArrays;
+				continue;
+			}
+			if (VK_DESCRIPTOR_TYPE_STORAGE_BUFFER == l_buffer.m_descriptorInfo.m_type) {
+				++lv_totalNumStorageArrays;
+			}
+		}
+
+		if (0 != lv_totalNumUniformBufferArrays) {
+			lv_dsPoolSizes.push_back(VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+				.descriptorCount = l_totalNumDescriptorSets*lv_totalNumUniformBufferArrays});
+		}
+
+		if (0 != lv_totalNumStorageArrays) {
+			lv_dsPoolSizes.push_back(VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+				.descriptorCount = l_totalNumDescriptorSets*lv_totalNumStorageArrays});
+		}
+
+		if (0 != lv_totalNumTextures) {
+			lv_dsPoolSizes.push_back(VkDescriptorPoolSize{ .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+				.descriptorCount = lv_totalNumTextures * l_totalNumDescriptorSets });
+		}
+
+		VkDescriptorPoolCreateInfo lv_dsPoolCreateInfo{};
+		lv_dsPoolCreateInfo.maxSets = l_totalNumDescriptorSets;
+		lv_dsPoolCreateInfo.poolSizeCount = (uint32_t)lv_dsPoolSizes.size();
+		lv_dsPoolCreateInfo.pPoolSizes = lv_dsPoolSizes.data();
+		lv_dsPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		
+		
+		VULKAN_CHECK(vkCreateDescriptorPool(m_renderDevice.m_device, &lv_dsPoolCreateInfo, nullptr, &lv_dsPool));
+
+		m_descriptorPools.push_back(lv_dsPool);
+
+
+		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
+		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_dsPool);
+		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_DESCRIPTOR_POOL;
+		lv_objectNameInfo.pNext = nullptr;
+		lv_objectNameInfo.pObjectName = l_dsPool;
+		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+
+
+		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+
+
+		return m_descriptorPools[m_descriptorPools.size() - 1];
+ 	}
+
+
+	VkDescriptorSet VulkanResourceManager::CreateDescriptorSet(VkDescriptorPool l_dsPool, VkDescriptorSetLayout l_dsLayout,
+		const char* l_dsSet)
+	{
+		using namespace ErrorCheck;
+
+		VkDescriptorSet lv_ds{};
+
+		VkDescriptorSetAllocateInfo lv_dsAllocateInfo{};
+		lv_dsAllocateInfo.descriptorPool = l_dsPool;
+		lv_dsAllocateInfo.descriptorSetCount = 1;
+		lv_dsAllocateInfo.pSetLayouts = &l_dsLayout;
+		lv_dsAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+
+		VULKAN_CHECK(vkAllocateDescriptorSets(m_renderDevice.m_device, &lv_dsAllocateInfo, &lv_ds));
+
+		VkDebugUtilsObjectNameInfoEXT lv_objectNameInfo{};
+		lv_objectNameInfo.objectHandle = reinterpret_cast<uint64_t>(lv_ds);
+		lv_objectNameInfo.objectType = VK_OBJECT_TYPE_DESCRIPTOR_SET;
+		lv_objectNameInfo.pNext = nullptr;
+		lv_objectNameInfo.pObjectName = l_dsSet;
+		lv_objectNameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+
+
+		VULKAN_CHECK(vkSetDebugUtilsObjectNameEXT(m_renderDevice.m_device, &lv_objectNameInfo));
+		
+
+
+		return lv_ds;
+
+		
+	}
+
+
+	void VulkanResourceManager::UpdateDescriptorSet(const DescriptorSetResources& l_dsResources, 
+		VkDescriptorSet l_ds)
+	{
+		using namespace ErrorCheck;
+
+		uint32_t lv_bindingNumber{};
+		std::vector<VkWriteDescriptorSet> lv_writeDSVector{};
+		std::vector<VkDescriptorBufferInfo> lv_dsBufferInfoVector{ l_dsResources.m_buffers.size() };
+		std::vector<VkDescriptorImageInfo> lv_textureImageInfoVector{ l_dsResources.m_textures.size() };
+		std::vector<VkDescriptorImageInfo> lv_textureArrayImageInfoVector{};
+
+
+		for (uint32_t i = 0; i < l_dsResources.m_buffers.size(); ++i) {
+
+			lv_dsBufferInfoVector[i] = VkDescriptorBufferInfo{.buffer = l_dsResources.m_buffers[i].m_buffer.buffer
+			,.offset = l_dsResources.m_buffers[i].m_offset, .range = l_dsResources.m_buffers[i].m_size};
+
+			lv_writeDSVector.push_back(bufferWriteDescriptorSet(l_ds, &lv_dsBufferInfoVector[i], lv_bindingNumber++,
+				l_dsResources.m_buffers[i].m_descriptorInfo.m_type));
 
 		}
 
@@ -1663,26 +2628,650 @@ namespace RenderCore
 
 
 
-	VulkanResourceManager::~VulkanResourceManager()
+	void VulkanResourceManager::CreateSubAllocatedBuffer(VkDeviceSize l_size, VkBufferUsageFlags l_usage,
+		VkMemoryPropertyFlags l_memoryProperties, bool l_shareBetweenQueues,
+		GpuMemoryCategory l_memoryCategory, VulkanBuffer& l_buffer)
 	{
-		auto lv_totalNumSwapchains = m_renderDevice.m_swapchainImages.size();
-		for (auto& l_buffer : m_buffers) {
-			
-			if (nullptr != l_buffer.ptr) {
-				vkUnmapMemory(m_renderDevice.m_device, l_buffer.memory);
-			}
-			vkFreeMemory(m_renderDevice.m_device, l_buffer.memory, nullptr);
-			vkDestroyBuffer(m_renderDevice.m_device, l_buffer.buffer, nullptr);
+		using namespace ErrorCheck;
+
+		const uint32_t lv_totalNumQueueFamilies = (uint32_t)m_renderDevice.m_deviceQueueIndices.size();
+		const bool lv_concurrent = (true == l_shareBetweenQueues) && (1 < lv_totalNumQueueFamilies);
+
+		//Transfer usage keeps every buffer relocatable by DefragmentBuffers()
+		const VkBufferUsageFlags lv_usage = l_usage | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+		const VkBufferCreateInfo lv_bufferCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.size = l_size,
+			.usage = lv_usage,
+			.sharingMode = (true == lv_concurrent) ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+			.queueFamilyIndexCount = (true == lv_concurrent) ? lv_totalNumQueueFamilies : 0,
+			.pQueueFamilyIndices = (true == lv_concurrent) ? m_renderDevice.m_deviceQueueIndices.data() : nullptr
+		};
+
+		VULKAN_CHECK(vkCreateBuffer(m_renderDevice.m_device, &lv_bufferCreateInfo, nullptr, &l_buffer.buffer));
+
+		VkMemoryDedicatedRequirements lv_dedicatedRequirements{ .sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS };
+		VkMemoryRequirements2 lv_memoryRequirements{ .sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2,
+			.pNext = &lv_dedicatedRequirements };
+		const VkBufferMemoryRequirementsInfo2 lv_requirementsInfo{ .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2,
+			.pNext = nullptr, .buffer = l_buffer.buffer };
+
+		vkGetBufferMemoryRequirements2(m_renderDevice.m_device, &lv_requirementsInfo, &lv_memoryRequirements);
+
+		const bool lv_preferDedicated = (VK_TRUE == lv_dedicatedRequirements.prefersDedicatedAllocation) ||
+			(VK_TRUE == lv_dedicatedRequirements.requiresDedicatedAllocation);
+
+		auto lv_allocation = m_gpuMemoryAllocator.Allocate(lv_memoryRequirements.memoryRequirements, l_memoryProperties,
+			GpuResourceTiling::m_linear, lv_preferDedicated, l_buffer.buffer, VK_NULL_HANDLE);
+
+		VULKAN_CHECK(vkBindBufferMemory(m_renderDevice.m_device, l_buffer.buffer, lv_allocation.m_memory, lv_allocation.m_offset));
+
+		l_buffer.size = l_size;
+		l_buffer.memory = lv_allocation.m_memory;
+		l_buffer.ptr = nullptr;
+
+		//Host visible blocks are persistently mapped, so there is nothing left to map here
+		if (true == (0 != (VK_MEMORY_PROPERTY_HOST_COHERENT_BIT & l_memoryProperties))
+			&&
+			(0 != (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT & l_memoryProperties))) {
+			l_buffer.ptr = lv_allocation.m_mappedData;
+		}
+
+		std::lock_guard lv_lock{ m_allocationMutex };
+
+		m_bufferAllocations.emplace(l_buffer.buffer, SubAllocatedBuffer{ .m_allocation = lv_allocation,
+			.m_usage = lv_usage, .m_memoryCategory = l_memoryCategory, .m_sharedBetweenQueues = lv_concurrent });
+
+		m_memoryCategoryTracker.Track(l_memoryCategory, lv_allocation.m_size);
+	}
+
+
+	void VulkanResourceManager::CreateSubAllocatedImage(uint32_t l_width, uint32_t l_height, VkFormat l_format,
+		VkImageUsageFlags l_usage, VkImageCreateFlags l_flags, uint32_t l_mipLevels,
+		GpuMemoryCategory l_memoryCategory, VulkanImage& l_image)
+	{
+		using namespace ErrorCheck;
+
+		//Full screen (or bigger) render targets get their own VkDeviceMemory so that they never pin a whole block
+		constexpr uint64_t lv_dedicatedRenderTargetTexels = 1024ULL * 1024ULL;
+
+		const VkImageCreateInfo lv_imageCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = l_flags,
+			.imageType = VK_IMAGE_TYPE_2D,
+			.format = l_format,
+			.extent = VkExtent3D {.width = l_width, .height = l_height, .depth = 1 },
+			.mipLevels = l_mipLevels,
+			.arrayLayers = (uint32_t)((l_flags == VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT) ? 6 : 1),
+			.samples = VK_SAMPLE_COUNT_1_BIT,
+			.tiling = VK_IMAGE_TILING_OPTIMAL,
+			.usage = l_usage,
+			.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+			.queueFamilyIndexCount = 0,
+			.pQueueFamilyIndices = nullptr,
+			.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+		};
+
+		VULKAN_CHECK(vkCreateImage(m_renderDevice.m_device, &lv_imageCreateInfo, nullptr, &l_image.image));
+
+		VkMemoryDedicatedRequirements lv_dedicatedRequirements{ .sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS };
+		VkMemoryRequirements2 lv_memoryRequirements{ .sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2,
+			.pNext = &lv_dedicatedRequirements };
+		const VkImageMemoryRequirementsInfo2 lv_requirementsInfo{ .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2,
+			.pNext = nullptr, .image = l_image.image };
+
+		vkGetImageMemoryRequirements2(m_renderDevice.m_device, &lv_requirementsInfo, &lv_memoryRequirements);
+
+		const bool lv_isLargeRenderTarget =
+			(0 != (l_usage & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT))) &&
+			((uint64_t)l_width * (uint64_t)l_height >= lv_dedicatedRenderTargetTexels);
+
+		const bool lv_preferDedicated = (true == lv_isLargeRenderTarget) ||
+			(VK_TRUE == lv_dedicatedRequirements.prefersDedicatedAllocation) ||
+			(VK_TRUE == lv_dedicatedRequirements.requiresDedicatedAllocation);
+
+		auto lv_allocation = m_gpuMemoryAllocator.Allocate(lv_memoryRequirements.memoryRequirements,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, GpuResourceTiling::m_optimal, lv_preferDedicated,
+			VK_NULL_HANDLE, l_image.image);
+
+		VULKAN_CHECK(vkBindImageMemory(m_renderDevice.m_device, l_image.image, lv_allocation.m_memory, lv_allocation.m_offset));
+
+		l_image.imageMemory = lv_allocation.m_memory;
+
+		std::lock_guard lv_lock{ m_allocationMutex };
+
+		m_imageAllocations.emplace(l_image.image, SubAllocatedImage{ .m_allocation = lv_allocation,
+			.m_memoryCategory = l_memoryCategory });
+
+		m_memoryCategoryTracker.Track(l_memoryCategory, lv_allocation.m_size);
+	}
+
+
+	GpuMemoryStats VulkanResourceManager::GetMemoryStats() const
+	{
+		return m_gpuMemoryAllocator.GetStats();
+	}
+
+
+	void VulkanResourceManager::PrintMemoryStats() const
+	{
+		constexpr double lv_bytesToMegaBytes = 1.0 / (1024.0 * 1024.0);
+
+		printf("\nBuffers : %u, textures : %u\n", m_buffers.GetSize(), m_textures.GetSize());
+		m_gpuMemoryAllocator.PrintStats();
+
+		for (uint32_t i = 0; i < (uint32_t)GpuMemoryCategory::m_count; ++i) {
+			const auto lv_categoryStats = GetMemoryCategoryStats((GpuMemoryCategory)i);
+			printf("%-14s : %u allocations, %.2f MB (peak %.2f MB)\n", GpuMemoryCategoryToString((GpuMemoryCategory)i),
+				lv_categoryStats.m_totalNumAllocations, lv_categoryStats.m_totalBytes * lv_bytesToMegaBytes,
+				lv_categoryStats.m_peakBytes * lv_bytesToMegaBytes);
+		}
+	}
+
+
+	GpuMemoryCategoryStats VulkanResourceManager::GetMemoryCategoryStats(GpuMemoryCategory l_memoryCategory) const
+	{
+		std::lock_guard lv_lock{ m_allocationMutex };
+		return m_memoryCategoryTracker.GetStats(l_memoryCategory);
+	}
+
+
+	std::vector<GpuMemoryHeapBudget> VulkanResourceManager::GetMemoryHeapBudgets() const
+	{
+		return m_gpuMemoryAllocator.GetHeapBudgets();
+	}
+
+
+	bool VulkanResourceManager::IsMemoryBudgetSupported() const
+	{
+		return m_gpuMemoryAllocator.IsMemoryBudgetSupported();
+	}
+
+
+	bool VulkanResourceManager::WriteMemoryReport(const std::string& l_jsonFilePath) const
+	{
+		rapidjson::StringBuffer lv_stringBuffer{};
+		rapidjson::PrettyWriter<rapidjson::StringBuffer> lv_writer(lv_stringBuffer);
+
+		const auto lv_allocatorStats = m_gpuMemoryAllocator.GetStats();
+
+		lv_writer.StartObject();
+
+		lv_writer.Key("MemoryBudgetSupported");
+		lv_writer.Bool(IsMemoryBudgetSupported());
+
+		lv_writer.Key("Categories");
+		lv_writer.StartArray();
+		for (uint32_t i = 0; i < (uint32_t)GpuMemoryCategory::m_count; ++i) {
+			const auto lv_categoryStats = GetMemoryCategoryStats((GpuMemoryCategory)i);
+
+			lv_writer.StartObject();
+			lv_writer.Key("Name");
+			lv_writer.String(GpuMemoryCategoryToString((GpuMemoryCategory)i));
+			lv_writer.Key("Allocations");
+			lv_writer.Uint(lv_categoryStats.m_totalNumAllocations);
+			lv_writer.Key("Bytes");
+			lv_writer.Uint64(lv_categoryStats.m_totalBytes);
+			lv_writer.Key("PeakBytes");
+			lv_writer.Uint64(lv_categoryStats.m_peakBytes);
+			lv_writer.EndObject();
+		}
+		lv_writer.EndArray();
+
+		lv_writer.Key("Heaps");
+		lv_writer.StartArray();
+		for (const auto& l_heapBudget : GetMemoryHeapBudgets()) {
+			lv_writer.StartObject();
+			lv_writer.Key("DeviceLocal");
+			lv_writer.Bool(l_heapBudget.m_deviceLocal);
+			lv_writer.Key("Size");
+			lv_writer.Uint64(l_heapBudget.m_heapSize);
+			lv_writer.Key("Budget");
+			lv_writer.Uint64(l_heapBudget.m_budget);
+			lv_writer.Key("Usage");
+			lv_writer.Uint64(l_heapBudget.m_usage);
+			lv_writer.EndObject();
+		}
+		lv_writer.EndArray();
+
+		lv_writer.Key("Allocator");
+		lv_writer.StartObject();
+		lv_writer.Key("DeviceMemoryObjects");
+		lv_writer.Uint(lv_allocatorStats.m_totalNumDeviceMemoryObjects);
+		lv_writer.Key("Blocks");
+		lv_writer.Uint(lv_allocatorStats.m_totalNumBlocks);
+		lv_writer.Key("BlockBytes");
+		lv_writer.Uint64(lv_allocatorStats.m_totalBlockBytes);
+		lv_writer.Key("SubAllocations");
+		lv_writer.Uint(lv_allocatorStats.m_totalNumSubAllocations);
+		lv_writer.Key("SubAllocatedBytes");
+		lv_writer.Uint64(lv_allocatorStats.m_totalSubAllocatedBytes);
+		lv_writer.Key("DedicatedAllocations");
+		lv_writer.Uint(lv_allocatorStats.m_totalNumDedicatedAllocations);
+		lv_writer.Key("DedicatedBytes");
+		lv_writer.Uint64(lv_allocatorStats.m_totalDedicatedBytes);
+		lv_writer.EndObject();
+
+		lv_writer.EndObject();
+
+		std::ofstream lv_reportFile(l_jsonFilePath, std::ios::out | std::ios::trunc);
+
+		if (false == lv_reportFile.is_open()) {
+			printf("\nFailed to open %s for writing the memory report.\n", l_jsonFilePath.c_str());
+			return false;
+		}
+
+		lv_reportFile << lv_stringBuffer.GetString();
+
+		return true;
+	}
+
+
+	GpuMemoryCategory VulkanResourceManager::DeduceBufferMemoryCategory(VkBufferUsageFlags l_usage)
+	{
+		if (0 != (l_usage & (VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT))) {
+			return GpuMemoryCategory::m_uniforms;
+		}
+
+		if (0 != (l_usage & (VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+			VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT))) {
+			return GpuMemoryCategory::m_geometry;
 		}
 
-		for (auto& l_texture : m_textures) {
+		if (VK_BUFFER_USAGE_TRANSFER_SRC_BIT == l_usage) {
+			return GpuMemoryCategory::m_staging;
+		}
+
+		return GpuMemoryCategory::m_other;
+	}
+
+
+	std::vector<BufferHandle> VulkanResourceManager::DefragmentBuffers()
+	{
+		using namespace ErrorCheck;
+
+		std::vector<uint32_t> lv_bufferHandles{};
+		std::vector<GpuMemoryAllocation> lv_allocations{};
+
+		//Destroyed buffers give their ranges back first, so the moves can fill them
+		FlushRetiredResources();
+
+		std::lock_guard lv_lock{ m_mainQueueMutex };
+
+		//Pending copies may still target buffers that are about to move
+		m_stagingRing->FlushAndWait();
+
+		//Held until the old buffers are gone, so no release or creation sees the allocation map half rewritten
+		std::lock_guard lv_allocationLock{ m_allocationMutex };
 
+		for (uint32_t i = 0; i < m_buffers.GetSize(); ++i) {
 
-			if (0 == lv_totalNumSwapchains) {
-				destroyVulkanTexture(m_renderDevice.m_device, l_texture);
+			//The ring and the uniform arena keep their own copy of the VkBuffer, so they have to stay where they are
+			if (m_stagingRingBufferHandle.m_index == i || m_uniformArenaBufferHandle.m_index == i) {
 				continue;
 			}
-			--lv_totalNumSwapchains;
+
+			auto lv_allocationResult = m_bufferAllocations.find(m_buffers[i].buffer);
+
+			if (m_bufferAllocations.end() != lv_allocationResult &&
+				false == lv_allocationResult->second.m_allocation.IsDedicated()) {
+				lv_bufferHandles.push_back(i);
+				lv_allocations.push_back(lv_allocationResult->second.m_allocation);
+			}
+		}
+
+		const auto lv_moves = m_gpuMemoryAllocator.PlanDefragmentation(lv_allocations);
+
+		std::vector<BufferHandle> lv_movedBufferHandles{};
+
+		if (true == lv_moves.empty()) {
+			return lv_movedBufferHandles;
+		}
+
+		VULKAN_CHECK(vkDeviceWaitIdle(m_renderDevice.m_device));
+
+		std::vector<VulkanBuffer> lv_oldBuffers{};
+		lv_oldBuffers.reserve(lv_moves.size());
+
+		VkCommandBuffer lv_commandBuffer = beginSingleTimeCommands(m_renderDevice);
+
+		for (const auto& l_move : lv_moves) {
+
+			const uint32_t lv_bufferHandle = lv_bufferHandles[l_move.m_allocationIndex];
+			auto& lv_buffer = m_buffers[lv_bufferHandle];
+			auto lv_subAllocatedBuffer = m_bufferAllocations.at(lv_buffer.buffer);
+
+			const uint32_t lv_totalNumQueueFamilies = (uint32_t)m_renderDevice.m_deviceQueueIndices.size();
+			const VkBufferCreateInfo lv_bufferCreateInfo{
+				.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+				.pNext = nullptr,
+				.flags = 0,
+				.size = lv_buffer.size,
+				.usage = lv_subAllocatedBuffer.m_usage,
+				.sharingMode = (true == lv_subAllocatedBuffer.m_sharedBetweenQueues) ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+				.queueFamilyIndexCount = (true == lv_subAllocatedBuffer.m_sharedBetweenQueues) ? lv_totalNumQueueFamilies : 0,
+				.pQueueFamilyIndices = (true == lv_subAllocatedBuffer.m_sharedBetweenQueues) ? m_renderDevice.m_deviceQueueIndices.data() : nullptr
+			};
+
+			VulkanBuffer lv_newBuffer{};
+			VULKAN_CHECK(vkCreateBuffer(m_renderDevice.m_device, &lv_bufferCreateInfo, nullptr, &lv_newBuffer.buffer));
+			VULKAN_CHECK(vkBindBufferMemory(m_renderDevice.m_device, lv_newBuffer.buffer,
+				l_move.m_dstAllocation.m_memory, l_move.m_dstAllocation.m_offset));
+
+			lv_newBuffer.size = lv_buffer.size;
+			lv_newBuffer.memory = l_move.m_dstAllocation.m_memory;
+			lv_newBuffer.ptr = (nullptr != lv_buffer.ptr) ? l_move.m_dstAllocation.m_mappedData : nullptr;
+
+			const VkBufferCopy lv_bufferCopy{ .srcOffset = 0, .dstOffset = 0, .size = lv_buffer.size };
+			vkCmdCopyBuffer(lv_commandBuffer, lv_buffer.buffer, lv_newBuffer.buffer, 1, &lv_bufferCopy);
+
+			lv_oldBuffers.push_back(lv_buffer);
+
+			m_bufferAllocations.erase(lv_buffer.buffer);
+			lv_subAllocatedBuffer.m_allocation = l_move.m_dstAllocation;
+			m_bufferAllocations.emplace(lv_newBuffer.buffer, lv_subAllocatedBuffer);
+
+			lv_buffer = lv_newBuffer;
+
+			//WriteBindlessBuffer() would take the allocation lock again
+			if (0 != (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT & lv_subAllocatedBuffer.m_usage)) {
+				m_bindlessHeap.WriteStorageBuffer(lv_bufferHandle, lv_buffer.buffer);
+			}
+			lv_movedBufferHandles.push_back(BufferHandle{ .m_index = lv_bufferHandle,
+				.m_generation = m_buffers.GetGeneration(lv_bufferHandle) });
+		}
+
+		endSingleTimeCommands(m_renderDevice, lv_commandBuffer);
+
+		for (uint32_t i = 0; i < (uint32_t)lv_moves.size(); ++i) {
+			vkDestroyBuffer(m_renderDevice.m_device, lv_oldBuffers[i].buffer, nullptr);
+
+			auto lv_oldAllocation = lv_allocations[lv_moves[i].m_allocationIndex];
+			m_gpuMemoryAllocator.Free(lv_oldAllocation);
+		}
+
+		const uint32_t lv_totalNumReleasedBlocks = m_gpuMemoryAllocator.ReleaseEmptyBlocks();
+
+		printf("\nDefragmentation moved %zu buffers and released %u memory blocks.\n",
+			lv_movedBufferHandles.size(), lv_totalNumReleasedBlocks);
+
+		return lv_movedBufferHandles;
+	}
+
+
+
+	void VulkanResourceManager::DestroyBuffer(const BufferHandle l_handle)
+	{
+		using namespace ErrorCheck;
+
+		auto& lv_buffer = RetrieveGpuBuffer(l_handle);
+
+		if (m_stagingRingBufferHandle == l_handle) {
+			PRINT_EXIT("\nThe staging ring buffer cannot be destroyed at runtime.\n");
+		}
+
+		if (m_uniformArenaBufferHandle == l_handle) {
+			PRINT_EXIT("\nThe uniform frame arena buffer cannot be destroyed at runtime.\n");
+		}
+
+		if (m_geometryHeap->GetVertexBufferHandle() == l_handle || m_geometryHeap->GetIndexBufferHandle() == l_handle) {
+			PRINT_EXIT("\nThe geometry heap buffers cannot be destroyed at runtime.\n");
+		}
+
+		m_retiredResources.push_back(RetiredResource{ .m_vkDataType = VulkanDataType::m_buffer,
+			.m_frameNumber = m_frameNumber, .m_buffer = lv_buffer,
+			.m_bindlessSlot = m_bindlessHeap.DetachStorageBuffer(l_handle.m_index) });
+
+		m_buffers.Release(l_handle.m_index);
+
+		ForgetResourceNames(VulkanDataType::m_buffer, l_handle.m_index);
+	}
+
+
+	void VulkanResourceManager::DestroyTexture(const TextureHandle l_handle)
+	{
+		using namespace ErrorCheck;
+
+		auto& lv_texture = RetrieveGpuTexture(l_handle);
+
+		//The first slots hold the swapchain images, which belong to the swapchain
+		if (l_handle.m_index < (uint32_t)m_renderDevice.m_swapchainImages.size()) {
+			PRINT_EXIT("\nSwapchain images cannot be destroyed through the resource manager.\n");
+		}
+
+		m_retiredResources.push_back(RetiredResource{ .m_vkDataType = VulkanDataType::m_texture,
+			.m_frameNumber = m_frameNumber, .m_texture = lv_texture,
+			.m_bindlessSlot = m_bindlessHeap.DetachTexture(l_handle.m_index) });
+
+		m_textures.Release(l_handle.m_index);
+
+		ForgetResourceNames(VulkanDataType::m_texture, l_handle.m_index);
+	}
+
+
+	void VulkanResourceManager::DestroyPipeline(const PipelineHandle l_handle)
+	{
+		const VkPipeline lv_pipeline = RetrieveGpuPipeline(l_handle);
+
+		//Other requests still share it
+		if (1U < m_pipelineUseCounts[l_handle.m_index]) {
+			--m_pipelineUseCounts[l_handle.m_index];
+			return;
+		}
+
+		std::erase_if(m_pipelineObjectCache, [&l_handle](const auto& l_entry) { return l_handle.m_index == l_entry.second; });
+
+		m_retiredResources.push_back(RetiredResource{ .m_vkDataType = VulkanDataType::m_pipeline,
+			.m_frameNumber = m_frameNumber, .m_pipeline = lv_pipeline });
+
+		m_Pipelines[l_handle.m_index] = VK_NULL_HANDLE;
+		++m_pipelineGenerations[l_handle.m_index];
+		m_freePipelineSlots.push_back(l_handle.m_index);
+
+		ForgetResourceNames(VulkanDataType::m_pipeline, l_handle.m_index);
+	}
+
+
+	void VulkanResourceManager::DestroyFramebuffer(const uint32_t l_handle)
+	{
+		using namespace ErrorCheck;
+
+		if (l_handle >= (uint32_t)m_frameBuffers.size() || VK_NULL_HANDLE == m_frameBuffers[l_handle]) {
+			PRINT_EXIT("\nInvalid framebuffer handle.\n");
+		}
+
+		m_retiredResources.push_back(RetiredResource{ .m_vkDataType = VulkanDataType::m_framebuffer,
+			.m_frameNumber = m_frameNumber, .m_framebuffer = m_frameBuffers[l_handle] });
+
+		//Framebuffer handles carry no generation, so their slots are never handed out again
+		m_frameBuffers[l_handle] = VK_NULL_HANDLE;
+
+		ForgetResourceNames(VulkanDataType::m_framebuffer, l_handle);
+	}
+
+
+	void VulkanResourceManager::CollectRetiredResources()
+	{
+		++m_frameNumber;
+		m_geometryHeap->CollectRetiredRanges();
+
+		std::erase_if(m_retiredResources, [this](RetiredResource& l_retiredResource)
+			{
+				if (l_retiredResource.m_frameNumber + m_totalNumFramesInFlight > m_frameNumber) {
+					return false;
+				}
+
+				ReleaseRetiredResource(l_retiredResource);
+				return true;
+			});
+	}
+
+
+	void VulkanResourceManager::FlushRetiredResources()
+	{
+		using namespace ErrorCheck;
+
+		if (true == m_retiredResources.empty()) {
+			return;
+		}
+
+		{
+			std::lock_guard lv_lock{ m_mainQueueMutex };
+			VULKAN_CHECK(vkDeviceWaitIdle(m_renderDevice.m_device));
+		}
+
+		for (auto& l_retiredResource : m_retiredResources) {
+			ReleaseRetiredResource(l_retiredResource);
+		}
+
+		m_retiredResources.clear();
+	}
+
+
+	uint32_t VulkanResourceManager::GetTotalNumPendingDestructions() const
+	{
+		return (uint32_t)m_retiredResources.size();
+	}
+
+
+	void VulkanResourceManager::ReleaseRetiredResource(RetiredResource& l_retiredResource)
+	{
+		switch (l_retiredResource.m_vkDataType) {
+
+		case VulkanDataType::m_buffer:
+			ReleaseBuffer(l_retiredResource.m_buffer);
+			if (UINT32_MAX != l_retiredResource.m_bindlessSlot) {
+				m_bindlessHeap.FreeStorageBufferSlot(l_retiredResource.m_bindlessSlot);
+			}
+			break;
+		case VulkanDataType::m_texture:
+			ReleaseTexture(l_retiredResource.m_texture);
+			if (UINT32_MAX != l_retiredResource.m_bindlessSlot) {
+				m_bindlessHeap.FreeTextureSlot(l_retiredResource.m_bindlessSlot);
+			}
+			break;
+		case VulkanDataType::m_framebuffer:
+			vkDestroyFramebuffer(m_renderDevice.m_device, l_retiredResource.m_framebuffer, nullptr);
+			break;
+		case VulkanDataType::m_pipeline:
+			vkDestroyPipeline(m_renderDevice.m_device, l_retiredResource.m_pipeline, nullptr);
+			break;
+		default:
+			break;
+		}
+	}
+
+
+	void VulkanResourceManager::ReleaseBuffer(VulkanBuffer& l_buffer)
+	{
+		if (VK_NULL_HANDLE == l_buffer.buffer) {
+			return;
+		}
+
+		std::unique_lock lv_lock{ m_allocationMutex };
+		auto lv_allocationResult = m_bufferAllocations.find(l_buffer.buffer);
+
+		if (m_bufferAllocations.end() != lv_allocationResult) {
+			vkDestroyBuffer(m_renderDevice.m_device, l_buffer.buffer, nullptr);
+			m_memoryCategoryTracker.Untrack(lv_allocationResult->second.m_memoryCategory, lv_allocationResult->second.m_allocation.m_size);
+			m_gpuMemoryAllocator.Free(lv_allocationResult->second.m_allocation);
+			m_bufferAllocations.erase(lv_allocationResult);
+			return;
+		}
+
+		lv_lock.unlock();
+
+		if (nullptr != l_buffer.ptr) {
+			vkUnmapMemory(m_renderDevice.m_device, l_buffer.memory);
+		}
+		vkFreeMemory(m_renderDevice.m_device, l_buffer.memory, nullptr);
+		vkDestroyBuffer(m_renderDevice.m_device, l_buffer.buffer, nullptr);
+	}
+
+
+	void VulkanResourceManager::ReleaseTexture(VulkanTexture& l_texture)
+	{
+		if (VK_NULL_HANDLE == l_texture.image.image) {
+			return;
+		}
+
+		//Shared samplers are released by the sampler cache
+		if (true == m_samplerCache.Owns(l_texture.sampler)) {
+			l_texture.sampler = VK_NULL_HANDLE;
+		}
+
+		//destroyVulkanTexture() only knows about the first view
+		vkDestroyImageView(m_renderDevice.m_device, l_texture.image.imageView1, nullptr);
+		vkDestroyImageView(m_renderDevice.m_device, l_texture.image.imageView2, nullptr);
+		vkDestroyImageView(m_renderDevice.m_device, l_texture.image.imageView3, nullptr);
+		vkDestroyImageView(m_renderDevice.m_device, l_texture.image.imageView4, nullptr);
+		vkDestroyImageView(m_renderDevice.m_device, l_texture.image.imageView5, nullptr);
+		vkDestroyImageView(m_renderDevice.m_device, l_texture.image.cubemapImageView, nullptr);
+
+		std::unique_lock lv_lock{ m_allocationMutex };
+		auto lv_allocationResult = m_imageAllocations.find(l_texture.image.image);
+
+		if (m_imageAllocations.end() != lv_allocationResult) {
+			//The memory belongs to the allocator, destroyVulkanTexture() must not free it
+			l_texture.image.imageMemory = VK_NULL_HANDLE;
+			destroyVulkanTexture(m_renderDevice.m_device, l_texture);
+			m_memoryCategoryTracker.Untrack(lv_allocationResult->second.m_memoryCategory, lv_allocationResult->second.m_allocation.m_size);
+			m_gpuMemoryAllocator.Free(lv_allocationResult->second.m_allocation);
+			m_imageAllocations.erase(lv_allocationResult);
+			return;
+		}
+
+		lv_lock.unlock();
+
+		destroyVulkanTexture(m_renderDevice.m_device, l_texture);
+	}
+
+
+	void VulkanResourceManager::ForgetResourceNames(VulkanDataType l_vkDataType, uint32_t l_index)
+	{
+		for (auto& l_shard : m_gpuResourcesHandles) {
+
+			std::unique_lock lv_lock{ l_shard.m_mutex };
+			std::erase_if(l_shard.m_handles, [l_vkDataType, l_index](const auto& l_entry)
+				{
+					return l_vkDataType == l_entry.second.m_vkDataType && l_index == l_entry.second.m_resourceHandle;
+				});
+		}
+	}
+
+
+
+	VulkanResourceManager::~VulkanResourceManager()
+	{
+		//Prewarmed pipelines that were never used are not registered, they are destroyed here
+		WaitForPrewarmedPipelines();
+		for (auto& l_prewarmedPipeline : m_prewarmedPipelines) {
+			vkDestroyPipeline(m_renderDevice.m_device, l_prewarmedPipeline.m_pipeline, nullptr);
+		}
+
+		m_pipelineCache.PrintStats();
+		m_pipelineCache.Save();
+
+		printf("\nUniform frame arena: %llu of %llu bytes per frame used at peak.\n",
+			(unsigned long long)m_uniformArena->GetPeakUsedBytes(), (unsigned long long)m_uniformArena->GetFrameCapacity());
+
+		m_geometryHeap->PrintStats();
+
+		m_stagingRing.reset();
+
+		FlushRetiredResources();
+
+		for (uint32_t i = 0; i < m_buffers.GetSize(); ++i) {
+			ReleaseBuffer(m_buffers[i]);
+		}
+
+		//The first slots hold the swapchain images, which belong to the swapchain
+		for (uint32_t i = (uint32_t)m_renderDevice.m_swapchainImages.size(); i < m_textures.GetSize(); ++i) {
+			ReleaseTexture(m_textures[i]);
 		}
 
 		for (auto& l_frameBuffer : m_frameBuffers) {
@@ -1705,6 +3294,10 @@ namespace RenderCore
 			vkDestroyDescriptorPool(m_renderDevice.m_device, l_descriptorPool, nullptr);
 		}
 
+		for (auto& l_updateTemplate : m_descriptorUpdateTemplates) {
+			vkDestroyDescriptorUpdateTemplate(m_renderDevice.m_device, l_updateTemplate.second, nullptr);
+		}
+
 		for (auto& l_descriptorSetLayout : m_descriptorSetLayouts) {
 			vkDestroyDescriptorSetLayout(m_renderDevice.m_device, l_descriptorSetLayout, nullptr);
 		}
@@ -3,10 +3,25 @@
 
 
 #include "UtilsVulkan.h"
+#include "GpuMemoryAllocator.hpp"
+#include "GpuResourceHandles.hpp"
+#include "StagingRingBuffer.hpp"
+#include "UniformFrameArena.hpp"
+#include "GeometryHeap.hpp"
+#include "SamplerCache.hpp"
+#include "BindlessDescriptorHeap.hpp"
+#include "PipelineCache.hpp"
+#include "SpecializationConstants.hpp"
+#include "ConcurrentSlotArray.hpp"
 #include <vector>
 #include <string>
 #include <glm/glm.hpp>
 #include <unordered_map>
+#include <optional>
+#include <array>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
 #include "ErrorCheck.hpp"
 
 
@@ -55,12 +70,18 @@ namespace RenderCore
 			bool m_useDepth = true;
 			bool m_useBlending = true;
 			bool m_dynamicScissorState = false;
+			//Together with a dynamic scissor the size no longer belongs to the pipeline, so renderers that only
+			//differ in their target size share one pipeline. They have to set both with vkCmdSet*.
+			bool m_dynamicViewportState = false;
 			bool m_enableWireframe = false;
 
 			std::vector<VkVertexInputBindingDescription> m_vertexInputBindingDescription{};
 			std::vector<VkVertexInputAttributeDescription> m_vertexInputAttribDescription{};
 
 			uint32_t m_totalNumColorAttach = 0;
+
+			//Shader permutation, applied to every stage of the pipeline
+			SpecializationConstants m_specializationConstants{};
 		};
 
 
@@ -142,29 +163,97 @@ namespace RenderCore
 		};
 
 
+		//Every request counts, the created totals are the number of distinct create infos
+		struct ObjectCacheStats
+		{
+			uint32_t m_totalNumDescriptorSetLayoutRequests{ 0 };
+			uint32_t m_totalNumDescriptorSetLayoutsCreated{ 0 };
+			uint32_t m_totalNumPipelineLayoutRequests{ 0 };
+			uint32_t m_totalNumPipelineLayoutsCreated{ 0 };
+			uint32_t m_totalNumPipelineRequests{ 0 };
+			uint32_t m_totalNumPipelinesCreated{ 0 };
+		};
+
+
+		//CPU time of the template based descriptor updates, descriptors count every array element
+		struct DescriptorUpdateStats
+		{
+			uint32_t m_totalNumTemplates{ 0 };
+			uint32_t m_totalNumSetsUpdated{ 0 };
+			uint32_t m_totalNumDescriptorsWritten{ 0 };
+			double m_totalUpdateMilliseconds{ 0.0 };
+		};
+
+
 		
 
 	public:
 
-		explicit VulkanResourceManager(VulkanRenderDevice& l_renderDevice);
+		explicit VulkanResourceManager(VulkanRenderDevice& l_renderDevice,
+			VkDeviceSize l_stagingRingSizeInBytes = 64U * 1024U * 1024U,
+			const std::string& l_pipelineCacheFilePath = "PipelineCache.bin",
+			VkDeviceSize l_uniformArenaSizeInBytes = 1U * 1024U * 1024U,
+			VkDeviceSize l_geometryHeapVertexSizeInBytes = 128U * 1024U * 1024U,
+			VkDeviceSize l_geometryHeapIndexSizeInBytes = 64U * 1024U * 1024U);
 
+		//Creating buffers and textures, uploading into them, registering their names and looking them up is thread safe,
+		//so assets can be loaded from worker threads. Render passes, framebuffers, pipelines and descriptor sets are
+		//still created on the main thread, and destruction and DefragmentBuffers() must not overlap with loading.
+
+		//Buffers without an explicit memory category are classified from their usage, see DeduceBufferMemoryCategory()
 		VulkanBuffer& CreateSharedBuffer(VkDeviceSize l_size, VkBufferUsageFlags l_usage, 
-			VkMemoryPropertyFlags l_memoryProperties, const char* l_nameBuffer);
+			VkMemoryPropertyFlags l_memoryProperties, const char* l_nameBuffer,
+			std::optional<GpuMemoryCategory> l_memoryCategory = std::nullopt);
 		
 		VulkanBuffer& CreateBuffer(VkDeviceSize l_size, VkBufferUsageFlags l_usage,
-			VkMemoryPropertyFlags l_memoryProperties, const char* l_nameBuffer);
+			VkMemoryPropertyFlags l_memoryProperties, const char* l_nameBuffer,
+			std::optional<GpuMemoryCategory> l_memoryCategory = std::nullopt);
+
+
+
+
+		//Both only record the copies into the staging ring, nothing reaches the GPU before the ring is flushed
+		void CopyDataToLocalBuffer(const BufferHandle l_bufferHandle, const void* l_bufferData);
+		void CopyDataToLocalBuffer(const BufferHandle l_bufferHandle, VkDeviceSize l_dstOffset,
+			const void* l_data, VkDeviceSize l_sizeInBytes);
+		void UploadTexture2D(VulkanTexture& l_texture, const void* l_texels, VkImageLayout l_finalLayout);
 
+		StagingRingBuffer& GetStagingRing();
 
+		//Loader threads submit on m_mainQueue1 as well, so every use of that queue has to hold this mutex:
+		//staging ring flushes, single time commands, the frame's submit and present, and vkDeviceWaitIdle
+		std::mutex& GetMainQueueMutex();
 
+		//Flushes the staging ring, waits for the device to go idle and copies the regions right away
+		void CopyBufferRegionsAndWait(const BufferHandle l_srcBufferHandle, const BufferHandle l_dstBufferHandle,
+			const std::vector<VkBufferCopy>& l_regions);
 
-		void CopyDataToLocalBuffer(VkQueue l_queue, VkCommandBuffer l_cmdBuffer,
-			const uint32_t l_bufferHandle, const void* l_bufferData);
+		//Vertex and index ranges of streamable meshes, see GeometryHeap
+		GeometryHeap& GetGeometryHeap();
+
+		//Per frame uniform blocks of the renderers, rewound for the current image by VulkanRenderContext::UpdateRenderers()
+		UniformFrameArena& GetUniformArena();
+
+		//Samplers are shared between textures, see SamplerCache
+		VkSampler AcquireSampler(const VkSamplerCreateInfo& l_samplerCreateInfo);
+		const SamplerCache& GetSamplerCache() const;
+
+		//Every sampled texture and storage buffer gets a slot in the heap, see BindlessDescriptorHeap
+		BindlessDescriptorHeap& GetBindlessHeap();
+
+		//What shaders index the bindless heap with, UINT32_MAX for resources that are not in the heap
+		uint32_t GetBindlessTextureSlot(const TextureHandle l_handle);
+		uint32_t GetBindlessBufferSlot(const BufferHandle l_handle);
+
+		//Every graphics and compute pipeline goes through the same on-disk cache, it is saved when the manager is destroyed
+		const PipelineCache& GetPipelineCache() const;
 
 		VkPipeline CreateComputePipeline(VkDevice m_device, const char* l_computeShaderFilePath
-			,VkPipelineLayout pipelineLayout);
+			,VkPipelineLayout pipelineLayout, const SpecializationConstants& l_specializationConstants = {});
 
-		uint32_t CreateBufferWithHandle(VkDeviceSize l_size, VkBufferUsageFlags l_usage,
-			VkMemoryPropertyFlags l_memoryProperties, const char* l_nameBuffer);
+		BufferHandle CreateBufferWithHandle(VkDeviceSize l_size, VkBufferUsageFlags l_usage,
+			VkMemoryPropertyFlags l_memoryProperties, const char* l_nameBuffer,
+			std::optional<GpuMemoryCategory> l_memoryCategory = std::nullopt);
 
 		VulkanTexture& CreateTextureForOffscreenFrameBuffer(float l_maxAnistropy ,const std::string& l_nameTexture,
 			VkFormat l_colorFormat = VK_FORMAT_B8G8R8A8_UNORM,
@@ -172,17 +261,19 @@ namespace RenderCore
 			uint32_t l_mipLevels = 1U,
 			VkFilter l_minFilter = VK_FILTER_LINEAR,
 			VkFilter l_maxFilter = VK_FILTER_LINEAR,
-			VkSamplerAddressMode l_addressMode = VK_SAMPLER_ADDRESS_MODE_REPEAT);
+			VkSamplerAddressMode l_addressMode = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+			GpuMemoryCategory l_memoryCategory = GpuMemoryCategory::m_renderTargets);
 
 
 		//Same as CreateTextureForOffscreenFrameBuffer() except this one returns the handle
-		uint32_t CreateTexture(float l_maxAnistropy ,const char* l_nameTexture,
+		TextureHandle CreateTexture(float l_maxAnistropy ,const char* l_nameTexture,
 			VkFormat l_colorFormat = VK_FORMAT_B8G8R8A8_UNORM,
 			uint32_t l_width = 704, uint32_t l_height = 704,
 			uint32_t l_mipLevels = 1U,
 			VkFilter l_minFilter = VK_FILTER_LINEAR,
 			VkFilter l_maxFilter = VK_FILTER_LINEAR,
-			VkSamplerAddressMode l_addressMode = VK_SAMPLER_ADDRESS_MODE_REPEAT);
+			VkSamplerAddressMode l_addressMode = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+			GpuMemoryCategory l_memoryCategory = GpuMemoryCategory::m_renderTargets);
 
 
 		VulkanTexture& LoadTexture2D(const std::string& l_textureFileName);
@@ -190,17 +281,20 @@ namespace RenderCore
 
 
 
-		uint32_t LoadTexture2DWithHandle(const std::string& l_textureFileName);
+		TextureHandle LoadTexture2DWithHandle(const std::string& l_textureFileName);
 
-		VulkanTexture& CreateDepthTextureForOffscreenFrameBuffer(const std::string& l_nameDepthTexture);
+		VulkanTexture& CreateDepthTextureForOffscreenFrameBuffer(const std::string& l_nameDepthTexture,
+			GpuMemoryCategory l_memoryCategory = GpuMemoryCategory::m_renderTargets);
 
-		VulkanTexture& CreateDepthTexture(const std::string& l_nameDepthTexture);
+		VulkanTexture& CreateDepthTexture(const std::string& l_nameDepthTexture,
+			GpuMemoryCategory l_memoryCategory = GpuMemoryCategory::m_renderTargets);
 
 		VulkanTexture& CreateDepthCubeMapTexture(const std::string& l_textureName, uint32_t l_height
 												, uint32_t l_width);
 
 
-		uint32_t CreateDepthTextureWithHandle(const std::string& l_nameTexture);
+		TextureHandle CreateDepthTextureWithHandle(const std::string& l_nameTexture,
+			GpuMemoryCategory l_memoryCategory = GpuMemoryCategory::m_renderTargets);
 
 
 		VkFramebuffer& CreateFrameBuffer(const RenderPass& l_renderpass, 
@@ -211,13 +305,13 @@ namespace RenderCore
 
 
 		uint32_t CreateFrameBufferCubemapFace(const RenderPass& l_renderpass,
-			uint32_t l_textureHandle,
+			TextureHandle l_textureHandle,
 			uint32_t l_cubemapLayer,
 			const char* l_nameFramebuffer);
 
 
 		uint32_t CreateFrameBuffer(const RenderPass& l_renderpass,
-			const std::vector<uint32_t>& l_textureHandles,
+			const std::vector<TextureHandle>& l_textureHandles,
 			const char* l_nameFramebuffer);
 
 
@@ -254,17 +348,68 @@ namespace RenderCore
 		VkPipelineLayout& CreatePipelineLayout(VkDescriptorSetLayout l_descriptorSetLayout,
 			const char* l_namePipelineLayout);
 
+		//Set 0 is the renderer's own layout and set 1 the bindless heap.
+		//The push constant range is visible to all stages and carries the bindless indices of the draw.
+		VkPipelineLayout& CreatePipelineLayoutWithBindlessHeap(VkDescriptorSetLayout l_descriptorSetLayout,
+			const char* l_namePipelineLayout, uint32_t l_pushConstSize = 0);
+
 
 		VkPipeline& CreateGraphicsPipeline(VkRenderPass l_renderPass, VkPipelineLayout l_pipelineLayout,
 			const std::vector<const char*>& l_shaderFiles,
 			const char* l_nameGraphicsPipeline,
 			const PipelineInfo& l_pipelineParams);
 
+		//Load time pipelines are only described here and created together by CreateRequestedPipelines().
+		//l_pipelineToFill receives the pipeline then, so it has to outlive the request (renderers pass their members).
+		//Deferred requests are left out of CreateRequestedPipelines(), l_pipelineToFill stays VK_NULL_HANDLE until
+		//CreateDeferredPipeline() is called on it, which renderers do when their node or debug path is first used.
+		void RequestGraphicsPipeline(VkRenderPass l_renderPass, VkPipelineLayout l_pipelineLayout,
+			const std::vector<const char*>& l_shaderFiles,
+			const char* l_nameGraphicsPipeline,
+			const PipelineInfo& l_pipelineParams,
+			VkPipeline& l_pipelineToFill,
+			bool l_deferUntilFirstUse = false);
+
+		//Requests of the same shader with different specialization constants are different pipelines
+		void RequestComputePipeline(const char* l_computeShaderFilePath, VkPipelineLayout l_pipelineLayout,
+			const char* l_nameComputePipeline, VkPipeline& l_pipelineToFill,
+			bool l_deferUntilFirstUse = false,
+			const SpecializationConstants& l_specializationConstants = {});
+
+		//Compiles the shaders and creates every requested pipeline on l_totalNumThreads threads, the calling one included
+		//(0 means one per hardware thread). The pipelines are registered and named on the calling thread once all are built.
+		void CreateRequestedPipelines(uint32_t l_totalNumThreads = 0);
+
+		//Builds every requested pipeline once per thread count from 1 to l_maxNumThreads (0 means the hardware concurrency)
+		//and prints the wall time of each run. Every run starts from an empty VkPipelineCache and its pipelines are
+		//destroyed again, so the requests stay pending for CreateRequestedPipelines().
+		void BenchmarkRequestedPipelines(uint32_t l_maxNumThreads = 0);
+
+		//Returns l_pipelineToFill right away once it is created, otherwise creates the deferred request it belongs to.
+		//Cheap enough to be called every time a command buffer is filled.
+		VkPipeline CreateDeferredPipeline(VkPipeline& l_pipelineToFill);
+
+		//Builds the deferred pipelines on one background thread, so their first use usually only has to register them.
+		//The thread only warms the driver side, nothing is registered or handed out before CreateDeferredPipeline().
+		void PrewarmDeferredPipelines();
+
+		uint32_t GetTotalNumRequestedPipelines() const;
+		uint32_t GetTotalNumDeferredPipelines() const;
 
 
+
+		//Descriptor set layouts, pipeline layouts and pipelines are deduplicated on their create infos.
+		//A request identical to an earlier one gets the earlier object back, named after the first request.
 		VkDescriptorSetLayout& CreateDescriptorSetLayout(const DescriptorSetResources& l_dsResources,
 			const char* l_nameDsLayout);
 
+		//Only VkDescriptorSetLayoutBindingFlagsCreateInfo is accepted in the pNext chain
+		VkDescriptorSetLayout& CreateDescriptorSetLayout(const VkDescriptorSetLayoutCreateInfo& l_dsLayoutCreateInfo,
+			const char* l_nameDsLayout);
+
+		const ObjectCacheStats& GetObjectCacheStats() const;
+		void PrintObjectCacheStats() const;
+
 		VkDescriptorPool& CreateDescriptorPool(const DescriptorSetResources& l_dsResources, 
 			uint32_t l_totalNumDescriptorSets,
 			const char* l_nameDsPool);
@@ -272,20 +417,37 @@ namespace RenderCore
 		VkDescriptorSet CreateDescriptorSet(VkDescriptorPool l_dsPool, VkDescriptorSetLayout l_dsLayout,
 			const char* l_dsSet);
 
+		//One template per descriptor set layout, since layouts are deduplicated every later request for the same
+		//layout gets the first template back and has to lay out its update data the same way.
+		VkDescriptorUpdateTemplate CreateDescriptorUpdateTemplate(VkDescriptorSetLayout l_dsLayout,
+			const std::vector<VkDescriptorUpdateTemplateEntry>& l_entries, const char* l_nameTemplate);
+
+		void RecordDescriptorUpdate(uint32_t l_totalNumSets, uint32_t l_totalNumDescriptors, double l_updateMilliseconds);
+		const DescriptorUpdateStats& GetDescriptorUpdateStats() const;
+
 
 		void UpdateDescriptorSet(const DescriptorSetResources& l_dsResources, VkDescriptorSet l_ds);
 
 		void AddGpuResource(const char* l_nameResource, uint32_t l_resourceHandle, VulkanDataType l_vkDataType);
+		void AddGpuResource(const char* l_nameResource, BufferHandle l_bufferHandle);
+		void AddGpuResource(const char* l_nameResource, TextureHandle l_textureHandle);
 
+		//Name lookups hash a string, so they are meant for load time only.
+		//Resolve the returned handles with the Retrieve*(handle) overloads in per-frame code.
 		GpuResourceMetaData RetrieveGpuResourceMetaData(const std::string& l_nameResource);
 		void* RetrieveGpuResource(const GpuResourceMetaData& l_resourceMetaData);
 
-		VulkanBuffer& RetrieveGpuBuffer(const uint32_t l_handle);
-		VulkanTexture& RetrieveGpuTexture(const uint32_t l_handle);
+		BufferHandle RetrieveGpuBufferHandle(const std::string& l_nameBuffer);
+		BufferHandle RetrieveGpuBufferHandle(const std::string& l_bufferBaseName, const uint32_t l_index);
+		TextureHandle RetrieveGpuTextureHandle(const std::string& l_nameTexture);
+		TextureHandle RetrieveGpuTextureHandle(const std::string& l_textureBaseName, const uint32_t l_index);
+
+		VulkanBuffer& RetrieveGpuBuffer(const BufferHandle l_handle);
+		VulkanTexture& RetrieveGpuTexture(const TextureHandle l_handle);
+		VkPipeline	RetrieveGpuPipeline(const PipelineHandle l_handle);
 		VkFramebuffer RetrieveGpuFramebuffer(const uint32_t l_handle);
 		VkRenderPass RetrieveGpuRenderpass(const uint32_t l_handle);
 		VkPipelineLayout RetrieveGpuPipelineLayout(const uint32_t l_handle);
-		VkPipeline	RetrieveGpuPipeline(const uint32_t l_handle);
 		VkDescriptorSetLayout RetrieveGpuDescriptorSetLayout(const uint32_t l_handle);
 		VkDescriptorPool RetrieveGpuDescriptorPool(const uint32_t l_handle);
 
@@ -307,36 +469,278 @@ namespace RenderCore
 		(const std::string& l_descriptorPoolBaseName, const uint32_t l_index);
 
 
-		uint32_t AddVulkanBuffer(const VulkanBuffer& l_buffer);
-		uint32_t AddVulkanTexture(const VulkanTexture& l_texture);
+		BufferHandle AddVulkanBuffer(const VulkanBuffer& l_buffer);
+		TextureHandle AddVulkanTexture(const VulkanTexture& l_texture);
 		uint32_t AddVulkanFramebuffer(VkFramebuffer l_framebuffer);
 		uint32_t AddVulkanRenderpass(VkRenderPass l_renderpass);
+
+		//Also remembers what makes the render pass compatible with others (attachment formats, sample counts and
+		//references), so that pipelines requested for compatible render passes are shared
+		uint32_t AddVulkanRenderpass(VkRenderPass l_renderpass, const VkRenderPassCreateInfo& l_renderpassCreateInfo);
 		uint32_t AddVulkanPipelineLayout(VkPipelineLayout l_pipelineLayout);
-		uint32_t AddVulkanPipeline(VkPipeline l_pipeline);
+		PipelineHandle AddVulkanPipeline(VkPipeline l_pipeline);
 		uint32_t AddVulkanDescriptorSetLayout(VkDescriptorSetLayout l_dsSetLayout);
 		uint32_t AddVulkanDescriptorPool(VkDescriptorPool l_dsPool);
 
 
+		//Runtime destruction. The slot of the handle gets a new generation right away so that stale handles are caught,
+		//and its name is forgotten. The Vulkan objects and their memory are only released once every frame in flight
+		//that might still reference them has retired. Buffer, texture and pipeline slots are reused afterwards.
+		void DestroyBuffer(const BufferHandle l_handle);
+		void DestroyTexture(const TextureHandle l_handle);
+		void DestroyPipeline(const PipelineHandle l_handle);
+		void DestroyFramebuffer(const uint32_t l_handle);
+
+		//Called once at the start of every frame, releases what the frames in flight can no longer reference
+		void CollectRetiredResources();
+
+		//Waits for the device to go idle and releases everything that is pending (resize, hot reload, shutdown)
+		void FlushRetiredResources();
+
+		uint32_t GetTotalNumPendingDestructions() const;
+
+
+		GpuMemoryStats GetMemoryStats() const;
+		void PrintMemoryStats() const;
+
+		//Exact totals of the buffers and images that currently live in allocator memory, counted in
+		//allocation sizes (VkMemoryRequirements::size), so they only change when a resource is created or released
+		GpuMemoryCategoryStats GetMemoryCategoryStats(GpuMemoryCategory l_memoryCategory) const;
+		std::vector<GpuMemoryHeapBudget> GetMemoryHeapBudgets() const;
+		bool IsMemoryBudgetSupported() const;
 
+		//Dumps the category totals, the heap budgets and the allocator stats as json
+		bool WriteMemoryReport(const std::string& l_jsonFilePath) const;
+
+		static GpuMemoryCategory DeduceBufferMemoryCategory(VkBufferUsageFlags l_usage);
+
+		//Moves the buffers of the least occupied memory block of each pool into the other blocks and releases
+		//the blocks that end up empty. Only runs at a sync point where nothing is loading or in flight, the
+		//bindless slots are rewritten here, but the moved buffers get new VkBuffer handles, so every other
+		//descriptor set has to be rewritten by the caller when the returned list is not empty.
+		std::vector<BufferHandle> DefragmentBuffers();
 
 
 		~VulkanResourceManager();
 
 	private:
 
-		std::vector<VulkanBuffer> m_buffers{};
-		std::vector<VulkanTexture> m_textures{};
+		struct SubAllocatedBuffer
+		{
+			GpuMemoryAllocation m_allocation;
+			VkBufferUsageFlags m_usage;
+			GpuMemoryCategory m_memoryCategory;
+			bool m_sharedBetweenQueues;
+		};
+
+		struct SubAllocatedImage
+		{
+			GpuMemoryAllocation m_allocation;
+			GpuMemoryCategory m_memoryCategory;
+		};
+
+		void CreateSubAllocatedBuffer(VkDeviceSize l_size, VkBufferUsageFlags l_usage,
+			VkMemoryPropertyFlags l_memoryProperties, bool l_shareBetweenQueues,
+			GpuMemoryCategory l_memoryCategory, VulkanBuffer& l_buffer);
+
+		void CreateSubAllocatedImage(uint32_t l_width, uint32_t l_height, VkFormat l_format,
+			VkImageUsageFlags l_usage, VkImageCreateFlags l_flags, uint32_t l_mipLevels,
+			GpuMemoryCategory l_memoryCategory, VulkanImage& l_image);
+
+
+
+		struct RetiredResource
+		{
+			VulkanDataType m_vkDataType{ VulkanDataType::m_invalid };
+
+			//Frame number at the time of destruction
+			uint64_t m_frameNumber{ 0 };
+
+			VulkanBuffer m_buffer{};
+			VulkanTexture m_texture{};
+			VkFramebuffer m_framebuffer{ VK_NULL_HANDLE };
+			VkPipeline m_pipeline{ VK_NULL_HANDLE };
+
+			//Slot of the buffer or texture in the bindless heap, it is only freed together with the resource
+			uint32_t m_bindlessSlot{ UINT32_MAX };
+		};
+
+		//Every buffer, texture and pipeline goes through these so that its slot gets a generation
+		BufferHandle PushBuffer(const VulkanBuffer& l_buffer);
+		TextureHandle PushTexture(const VulkanTexture& l_texture);
+		PipelineHandle PushPipeline(VkPipeline l_pipeline);
+
+		//Flattened create info. Keys are compared word by word, so a hash collision never merges two objects.
+		struct CreateInfoKey
+		{
+			std::vector<uint64_t> m_words{};
+
+			void Add(uint64_t l_word);
+			void Add(const std::string& l_string);
+			void Add(const SpecializationConstants& l_specializationConstants);
+
+			bool operator==(const CreateInfoKey& l_other) const = default;
+		};
+
+		struct CreateInfoKeyHash
+		{
+			size_t operator()(const CreateInfoKey& l_key) const noexcept;
+		};
+
+		//Render passes registered without a create info are only compatible with themselves
+		CreateInfoKey MakeGraphicsPipelineKey(VkRenderPass l_renderPass, VkPipelineLayout l_pipelineLayout,
+			const std::vector<const char*>& l_shaderFiles, const PipelineInfo& l_pipelineParams) const;
+		CreateInfoKey MakeComputePipelineKey(const char* l_computeShaderFilePath, VkPipelineLayout l_pipelineLayout,
+			const SpecializationConstants& l_specializationConstants) const;
+
+		//Returns the slot of an already created pipeline with the same key and counts one more user of it
+		std::optional<uint32_t> AcquireCachedPipeline(const CreateInfoKey& l_key);
+
+		//True when l_pipelineToFill got a created pipeline or was attached to an identical pending request.
+		//A non deferred request sharing a deferred one creates it right away.
+		bool ShareRequestedPipeline(const CreateInfoKey& l_key, VkPipeline& l_pipelineToFill, bool l_deferUntilFirstUse);
+
+		VkPipelineLayout& CreateCachedPipelineLayout(const VkPipelineLayoutCreateInfo& l_pipelineLayoutCreateInfo,
+			const char* l_namePipelineLayout);
+
+		struct PipelineRequest
+		{
+			VkPipelineBindPoint m_bindPoint{ VK_PIPELINE_BIND_POINT_GRAPHICS };
+			VkRenderPass m_renderPass{ VK_NULL_HANDLE };
+			VkPipelineLayout m_pipelineLayout{ VK_NULL_HANDLE };
+
+			//Copied, the callers often pass temporaries
+			std::vector<std::string> m_shaderFiles{};
+			std::string m_name{};
+
+			//Compute requests only use its specialization constants
+			PipelineInfo m_pipelineInfo{};
+
+			CreateInfoKey m_key{};
+
+			//Identical requests are merged, every one of them gets the same pipeline
+			std::vector<VkPipeline*> m_pipelinesToFill{};
+		};
+
+		struct BuiltPipeline
+		{
+			VkPipeline m_pipeline{ VK_NULL_HANDLE };
+			VkPipelineCreationFeedback m_creationFeedback{};
+			double m_creationMilliseconds{ 0.0 };
+		};
+
+		//Only the device and the VkPipelineCache are touched, both are synchronized by the driver,
+		//so these can run on the worker threads of CreateRequestedPipelines()
+		BuiltPipeline BuildGraphicsPipeline(VkRenderPass l_renderPass, VkPipelineLayout l_pipelineLayout,
+			const std::vector<const char*>& l_shaderFiles, const PipelineInfo& l_pipelineParams,
+			VkPipelineCache l_vkPipelineCache) const;
+		BuiltPipeline BuildComputePipeline(const char* l_computeShaderFilePath, VkPipelineLayout l_pipelineLayout,
+			const SpecializationConstants& l_specializationConstants, VkPipelineCache l_vkPipelineCache) const;
+		BuiltPipeline BuildRequestedPipeline(const PipelineRequest& l_request) const;
+		BuiltPipeline BuildRequestedPipeline(const PipelineRequest& l_request, VkPipelineCache l_vkPipelineCache) const;
+
+		//Builds every entry of m_pipelineRequests into l_builtPipelines on l_totalNumThreads threads, the calling one
+		//included, and returns the wall time in milliseconds
+		double BuildRequestedPipelinesOnThreads(uint32_t l_totalNumThreads, VkPipelineCache l_vkPipelineCache,
+			std::vector<BuiltPipeline>& l_builtPipelines) const;
+
+		//Has to be called before m_deferredPipelineRequests or m_prewarmedPipelines are touched
+		void WaitForPrewarmedPipelines();
+
+		//Records the creation stats, gives the pipeline a slot, names it and adds it to the pipeline cache, not thread safe
+		PipelineHandle RegisterBuiltPipeline(const BuiltPipeline& l_builtPipeline, const char* l_namePipeline,
+			const CreateInfoKey& l_key);
+
+		//Only textures that have a sampler and buffers created with storage usage end up in the bindless heap
+		void WriteBindlessTexture(uint32_t l_textureIndex);
+		void WriteBindlessBuffer(uint32_t l_bufferIndex);
+
+		void ReleaseBuffer(VulkanBuffer& l_buffer);
+		void ReleaseTexture(VulkanTexture& l_texture);
+		void ReleaseRetiredResource(RetiredResource& l_retiredResource);
+
+		void ForgetResourceNames(VulkanDataType l_vkDataType, uint32_t l_index);
+
+
+		//Buffers and textures can be created from worker threads, elements never move once pushed
+		ConcurrentSlotArray<VulkanBuffer> m_buffers{};
+		ConcurrentSlotArray<VulkanTexture> m_textures{};
 		std::vector<VkFramebuffer> m_frameBuffers{};
 		std::vector<VkRenderPass> m_renderPasses{};
 		std::vector<VkPipelineLayout> m_pipelineLayouts{};
 		std::vector<VkPipeline> m_Pipelines{};
 		std::vector<VkDescriptorSetLayout> m_descriptorSetLayouts{};
 		std::vector<VkDescriptorPool> m_descriptorPools{};
+		std::unordered_map<VkDescriptorSetLayout, VkDescriptorUpdateTemplate> m_descriptorUpdateTemplates{};
+
+		//Current generation of every slot of m_Pipelines, buffers and textures keep theirs in the slot arrays
+		std::vector<uint32_t> m_pipelineGenerations{};
+
+		//Pipeline slots whose pipelines were destroyed, handed out again by PushPipeline()
+		std::vector<uint32_t> m_freePipelineSlots{};
+
+		std::vector<PipelineRequest> m_pipelineRequests{};
+		std::vector<PipelineRequest> m_deferredPipelineRequests{};
+
+		//Indexed like m_deferredPipelineRequests, requests added after the last prewarm have no entry.
+		//VK_NULL_HANDLE where the prewarm thread has not built the pipeline.
+		std::vector<BuiltPipeline> m_prewarmedPipelines{};
+		std::thread m_prewarmThread{};
+
+		//Create info key to the index in m_descriptorSetLayouts, m_pipelineLayouts and the slot in m_Pipelines
+		std::unordered_map<CreateInfoKey, uint32_t, CreateInfoKeyHash> m_descriptorSetLayoutCache{};
+		std::unordered_map<CreateInfoKey, uint32_t, CreateInfoKeyHash> m_pipelineLayoutCache{};
+		std::unordered_map<CreateInfoKey, uint32_t, CreateInfoKeyHash> m_pipelineObjectCache{};
+		std::unordered_map<VkRenderPass, CreateInfoKey> m_renderPassCompatibilityKeys{};
+
+		//Number of requests sharing each slot of m_Pipelines, DestroyPipeline() only retires the last one
+		std::vector<uint32_t> m_pipelineUseCounts{};
 
-		std::unordered_map<std::string, GpuResourceMetaData> m_gpuResourcesHandles;
+		ObjectCacheStats m_objectCacheStats{};
+		DescriptorUpdateStats m_descriptorUpdateStats{};
+
+		std::vector<RetiredResource> m_retiredResources{};
+		uint64_t m_frameNumber{ 0 };
+		uint32_t m_totalNumFramesInFlight{ 0 };
+
+		//Names are spread over shards by hash so that loader threads registering resources rarely wait on each other
+		static constexpr uint32_t m_totalNumResourceNameShards = 16;
+
+		struct ResourceNameShard
+		{
+			mutable std::shared_mutex m_mutex{};
+			std::unordered_map<std::string, GpuResourceMetaData> m_handles{};
+		};
+
+		ResourceNameShard& GetResourceNameShard(const std::string& l_nameResource);
+
+		std::array<ResourceNameShard, m_totalNumResourceNameShards> m_gpuResourcesHandles{};
 
 		VulkanRenderDevice& m_renderDevice;
 
+		GpuMemoryAllocator m_gpuMemoryAllocator;
+
+		//Guards m_bufferAllocations, m_imageAllocations and m_memoryCategoryTracker
+		mutable std::mutex m_allocationMutex{};
+		std::unordered_map<VkBuffer, SubAllocatedBuffer> m_bufferAllocations{};
+		std::unordered_map<VkImage, SubAllocatedImage> m_imageAllocations{};
+
+		GpuMemoryCategoryTracker m_memoryCategoryTracker{};
+
+		SamplerCache m_samplerCache;
+		BindlessDescriptorHeap m_bindlessHeap;
+		PipelineCache m_pipelineCache;
+
+		BufferHandle m_stagingRingBufferHandle{};
+		std::optional<StagingRingBuffer> m_stagingRing{};
+
+		//Serializes recording into the staging ring and every use of m_mainQueue1, see GetMainQueueMutex()
+		std::mutex m_mainQueueMutex{};
+
+		BufferHandle m_uniformArenaBufferHandle{};
+		std::optional<UniformFrameArena> m_uniformArena{};
+
+		std::optional<GeometryHeap> m_geometryHeap{};
 
 	};
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "MaterialLoaderAndSaver.hpp"
 #include <fstream>
 #include <filesystem>
+#include <cstring>
 
 #include "VulkanRenderer.hpp"
 
@@ -26,8 +27,22 @@ void ConvertScene()
 	for (uint32_t i = 0; i < lv_sceneMetaDatas.size(); ++i) {
 
 		auto& l_sceneMetaData = lv_sceneMetaDatas[i];
+
+		MeshConverter::VertexQuantizationSettings lv_vertexQuantization{};
+		lv_vertexQuantization.m_enabled = l_sceneMetaData.m_quantizeVertices;
+		lv_vertexQuantization.m_positionEncoding = (true == l_sceneMetaData.m_halfPrecisionPositions)
+			? MeshConverter::PositionEncoding::m_half : MeshConverter::PositionEncoding::m_snorm16;
+		lv_vertexQuantization.m_octahedralBits = l_sceneMetaData.m_octahedralBits;
+
+		MeshConverter::MeshMergingSettings lv_meshMerging{};
+		lv_meshMerging.m_enabled = l_sceneMetaData.m_mergeInstances;
+		lv_meshMerging.m_maxNumVertices = l_sceneMetaData.m_maxMergedVertices;
+		lv_meshMerging.m_cellSize = l_sceneMetaData.m_mergeCellSize;
+
 		lv_geometryConverter.ConvertScene(l_sceneMetaData.m_assimpSceneFileName, l_sceneMetaData.m_outputMesh,
-			l_sceneMetaData.m_outputBoxes, l_sceneMetaData.m_outputInstanceData, true, true, true);
+			l_sceneMetaData.m_outputBoxes, l_sceneMetaData.m_outputInstanceData, true, true, true, lv_vertexQuantization,
+			l_sceneMetaData.m_compressMesh, l_sceneMetaData.m_conversionThreads, l_sceneMetaData.m_benchmarkConversionThreads,
+			lv_meshMerging);
 
 		SceneLoaderAndSaver::SceneLoaderAndSaver lv_sceneLoaderAndSaver(l_sceneMetaData.m_outputScene, lv_geometryConverter.GetScene());
 		lv_sceneLoaderAndSaver.SaveScene(lv_sceneLoaderAndSaver.GetCachedScene());
@@ -56,9 +71,18 @@ void ConvertScene()
 }
 
 
-int main()
+int main(int argc, char** argv)
 {
 
+	//Offline step, fills the SPIR-V cache so that a later launch never runs glslang
+	if (1 < argc && 0 == strcmp(argv[1], "--precompile-shaders")) {
+		glslang_initialize_process();
+		const uint32_t lv_totalNumFailures = precompileShaderDirectory("Shaders/");
+		glslang_finalize_process();
+
+		return (0 == lv_totalNumFailures) ? 0 : 1;
+	}
+
 	std::string lv_path = "Assets/";
 	int lv_fileCount = 0;
 
@@ -76,8 +100,17 @@ int main()
 	}
 
 
+	bool lv_benchmarkPipelineThreads{ false };
+	bool lv_benchmarkDescriptorUpdates{ false };
+
+	for (int i = 1; i < argc; ++i) {
+		lv_benchmarkPipelineThreads = lv_benchmarkPipelineThreads || (0 == strcmp(argv[i], "--benchmark-pipeline-threads"));
+		lv_benchmarkDescriptorUpdates = lv_benchmarkDescriptorUpdates || (0 == strcmp(argv[i], "--benchmark-descriptor-updates"));
+	}
+
 	VulkanEngine::VulkanRenderer lv_renderer(VulkanEngine::InitialValues::lv_initialWidthScreen,
-		VulkanEngine::InitialValues::lv_intitalHeightScreen, VulkanEngine::InitialValues::lv_frameGraphJSONPath);
+		VulkanEngine::InitialValues::lv_intitalHeightScreen, VulkanEngine::InitialValues::lv_frameGraphJSONPath,
+		lv_benchmarkPipelineThreads, lv_benchmarkDescriptorUpdates);
 
 	lv_renderer.mainLoop();
 